@@ -180,6 +180,13 @@ class MS_API Model {
   /// \return Status.
   Status RunStep(const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
 
+  /// \brief Release the key/value cache of the finished sequence of the KVCacheAttention ops in this process.
+  ///
+  /// \param[in] seq_id The sequence id fed to the KVCacheAttention ops.
+  ///
+  /// \return Status.
+  Status ReleaseKVCacheSequence(int seq_id);
+
   /// \brief Inference model with preprocess in model.
   ///
   /// \param[in] inputs A vector where model inputs are arranged in sequence.
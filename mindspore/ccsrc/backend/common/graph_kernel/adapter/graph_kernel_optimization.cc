@@ -60,6 +60,7 @@
 #include "backend/common/graph_kernel/parallel_optimizer.h"
 #include "backend/common/graph_kernel/core/graph_kernel_utils.h"
 #include "backend/common/graph_kernel/compact_tensor_liveness.h"
+#include "backend/common/graph_kernel/interpreter_kernel_filter.h"
 #ifdef ENABLE_AKG
 #include "backend/common/graph_kernel/graph_kernel_build.h"
 #endif
@@ -227,9 +228,12 @@ PassManagerPtr GraphKernelOptimizer::Build() const {
   pm->Add(std::make_shared<ExtendOutputForUpdateState>(), OptLevel_1);
   // Reduce fake output memory.
   pm->Add(std::make_shared<ReduceFakeOutMem>(), OptLevel_1);
+  // The fused nodes are run by the builtin interpreter instead of compiling, inline the nodes it can not run.
+  auto use_interpreter = is_cpu && GraphKernelFlags::GetInstance().kernel_generator == kKernelGeneratorInterpreter;
+  pm->Add(std::make_shared<InterpreterKernelFilter>(), OptLevel_1, use_interpreter);
   // Compile graph kernel nodes, and inline nodes if compile failed.
 #ifdef ENABLE_AKG
-  pm->Add(std::make_shared<GraphKernelBuild>(), OptLevel_1);
+  pm->Add(std::make_shared<GraphKernelBuild>(), OptLevel_1, !use_interpreter);
 #endif
   pm->Add(std::make_shared<GetitemTuple>(), OptLevel_1);
   pm->Add(std::make_shared<MergeOutputForUpdateState>(), OptLevel_1);
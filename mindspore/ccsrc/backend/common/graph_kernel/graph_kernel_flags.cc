@@ -238,9 +238,11 @@ void GraphKernelFlags::CheckSupport() const {
     MS_EXCEPTION_IF_NULL(context);
     auto is_cpu = (context->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kCPUDevice);
     if (is_cpu) {
-      MS_LOG(WARNING)
-        << "Graph Kernel Fusion is not supported without LLVM on cpu platform, and it will be turned off now.";
-      const_cast<GraphKernelFlags *>(this)->opt_level = OptLevel_0;
+      if (kernel_generator != kKernelGeneratorInterpreter) {
+        MS_LOG(INFO) << "Graph Kernel Fusion can not compile kernels without LLVM on cpu platform, the fused kernels "
+                     << "will be run by the builtin interpreter.";
+        const_cast<GraphKernelFlags *>(this)->kernel_generator = kKernelGeneratorInterpreter;
+      }
       return;
     }
 #endif
@@ -37,6 +37,9 @@ constexpr unsigned int OpLevel_2 = 2;
 constexpr unsigned int OpLevel_MAX = 3;
 constexpr unsigned int default_cpu_refer_tread_num = 8;
 
+// The builtin kernel generator on cpu, which runs the fused graph by interpreting instead of compiling.
+constexpr auto kKernelGeneratorInterpreter = "INTERPRETER";
+
 class BACKEND_EXPORT GraphKernelFlags {
  public:
   static const GraphKernelFlags &GetInstance();
@@ -205,7 +208,8 @@ class BACKEND_EXPORT GraphKernelFlags {
 
   /**
    * Kernel Generator.
-   * The generator used to compile kernels.
+   * The generator used to compile kernels. "AKG" and "MLIR" compile the fused graph to binary, while "INTERPRETER" runs
+   * the fused graph by the builtin cpu interpreter, which is used on cpu when the LLVM is not available.
    */
   std::string kernel_generator{"AKG"};
 
@@ -0,0 +1,122 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/common/graph_kernel/interpreter_kernel_filter.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include "backend/common/graph_kernel/core/graph_kernel_utils.h"
+#include "backend/common/graph_kernel/model/op_node.h"
+#include "include/common/utils/anfalgo.h"
+
+namespace mindspore::graphkernel {
+namespace {
+// Keep the same with the ops registered in the cpu interpreter kernel.
+const std::set<std::string> kInterpreterOps = {
+  // elemwise
+  "Abs", "Neg", "Exp", "Log", "Sqrt", "Rsqrt", "Reciprocal", "Tanh", "Sigmoid", "Add", "Sub", "Mul", "RealDiv", "Div",
+  "Maximum", "Minimum",
+  // broadcast
+  "BroadcastTo",
+  // reduce
+  "ReduceSum", "ReduceMax", "ReduceMin",
+  // reshape
+  "Reshape"};
+
+bool IsStaticFloat32(const inner::NodePtr &node) {
+  return node->type == kNumberTypeFloat32 &&
+         std::all_of(node->shape.begin(), node->shape.end(), [](int64_t dim) { return dim > 0; });
+}
+
+// Put each node into a single group and inline all of them.
+class InlineSplitSchemer : public CommonSplitSchemer {
+ public:
+  InlineSplitSchemer() = default;
+  ~InlineSplitSchemer() override = default;
+  bool Split(const FuncGraphPtr &func_graph) override {
+    MS_EXCEPTION_IF_NULL(func_graph);
+    auto nodes = TopoSort(func_graph->get_return());
+    for (const auto &node : nodes) {
+      if (node == nullptr || !node->isa<CNode>() || !AnfUtils::IsRealKernel(node)) {
+        continue;
+      }
+      (void)AddGroup(AnfNodePtrList{node}, true);
+    }
+    if (split_plan_.empty()) {
+      return false;
+    }
+    GroupReturnNode(func_graph);
+    return true;
+  }
+};
+}  // namespace
+
+bool InterpreterSupported(const inner::LiteGraphPtr &lite_graph) {
+  MS_EXCEPTION_IF_NULL(lite_graph);
+  if (!std::all_of(lite_graph->inputs().begin(), lite_graph->inputs().end(), IsStaticFloat32)) {
+    return false;
+  }
+  for (const auto &op : lite_graph->ops()) {
+    auto prim_op = std::static_pointer_cast<inner::PrimOp>(op);
+    if (kInterpreterOps.count(prim_op->op()) == 0 || !IsStaticFloat32(op)) {
+      MS_LOG(DEBUG) << "The op " << prim_op->op() << " in " << lite_graph->name()
+                    << " is not supported by the interpreter.";
+      return false;
+    }
+    if (std::any_of(op->inputs().begin(), op->inputs().end(),
+                    [](const inner::NodePtr &input) { return !IsStaticFloat32(input); })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+SplitSchemerPtr InterpreterKernelFilter::GetSplitSchema(const std::string &) {
+  return std::make_shared<InlineSplitSchemer>();
+}
+
+bool InterpreterKernelFilter::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto mng = func_graph->manager();
+  if (mng == nullptr) {
+    mng = Manage(func_graph, true);
+    func_graph->set_manager(mng);
+  }
+  auto todos = TopoSort(func_graph->get_return());
+  bool changed = false;
+  // Inline the nodes in reversed topo order, since the nodes behind the processing node may be modified.
+  for (auto iter = todos.crbegin(); iter != todos.crend(); ++iter) {
+    auto node = (*iter)->cast<CNodePtr>();
+    if (node == nullptr || !AnfUtils::IsGraphKernel(node)) {
+      continue;
+    }
+    auto sub_graph = common::AnfAlgo::GetCNodeFuncGraphPtr(node);
+    MS_EXCEPTION_IF_NULL(sub_graph);
+    if (InterpreterSupported(GkUtils::AnfGraph2LiteGraph(sub_graph))) {
+      continue;
+    }
+    MS_LOG(INFO) << "Inline the graph kernel node " << node->fullname_with_scope()
+                 << " since it can not be run by the interpreter.";
+    changed = TrySplit(node) || changed;
+  }
+  if (changed) {
+    mng->RemoveRoots();
+    mng->KeepRoots({func_graph});
+  }
+  return changed;
+}
+}  // namespace mindspore::graphkernel
@@ -0,0 +1,39 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_GRAPH_KERNEL_INTERPRETER_KERNEL_FILTER_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_GRAPH_KERNEL_INTERPRETER_KERNEL_FILTER_H_
+
+#include <memory>
+#include <string>
+#include "include/backend/visible.h"
+#include "backend/common/graph_kernel/core/graph_kernel_splitter.h"
+#include "backend/common/graph_kernel/model/lite_graph.h"
+
+namespace mindspore::graphkernel {
+// Whether the fused graph can be run by the builtin cpu interpreter. The interpreter supports the float32 elemwise,
+// broadcast, reduce and reshape ops with static shape.
+BACKEND_EXPORT bool InterpreterSupported(const inner::LiteGraphPtr &lite_graph);
+
+// Inline the graph kernel nodes which can not be run by the builtin cpu interpreter.
+class InterpreterKernelFilter : public GraphKernelSplitter {
+ public:
+  InterpreterKernelFilter() = default;
+  ~InterpreterKernelFilter() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+  SplitSchemerPtr GetSplitSchema(const std::string &processor) override;
+};
+}  // namespace mindspore::graphkernel
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_GRAPH_KERNEL_INTERPRETER_KERNEL_FILTER_H_
@@ -15,6 +15,7 @@
  */
 
 #include "backend/common/optimizer/dynamic_shape/dynamic_shape_helper.h"
+#include "backend/common/optimizer/dynamic_shape/infer_resize_cache.h"
 
 #include <memory>
 #include <stack>
@@ -31,6 +32,7 @@
 #include "kernel/common_utils.h"
 #include "utils/ms_context.h"
 #include "abstract/ops/primitive_infer_map.h"
+#include "profiler/device/profiling.h"
 #include "mindspore/ccsrc/plugin/device/cpu/kernel/pyexecute/py_execute_cpu_kernel.h"
 
 namespace mindspore {
@@ -331,10 +333,26 @@ void InferShape(const CNodePtr &cnode, std::map<uint32_t, tensor::TensorPtr> *de
   }
 
   if (!has_py_execute_data && !IsPrimitiveCNode(cnode, prim::kPrimPyExecute)) {
+    // Skip the infer if the input shapes and depended values have been inferred before.
+    const auto &infer_resize_cache = cnode->user_data<InferResizeCache>();
+    std::string cache_key;
+    if (infer_resize_cache != nullptr) {
+      cache_key = InferResizeCache::GenerateKey(args_spec_list, *depend_tensor_map);
+      if (infer_resize_cache->FetchInferResult(cache_key, cnode)) {
+        return;
+      }
+    }
     // Pynative mode is rely on the origin abstract of cnode, so cannot modify the abstract inplace, clone from old
     // abstract instead.
     opt::CppInferShape(primitive, args_spec_list, cnode);
+    if (infer_resize_cache != nullptr) {
+      infer_resize_cache->SaveInferResult(cache_key, cnode);
+    }
   } else {
+    const auto &infer_resize_cache = cnode->user_data<InferResizeCache>();
+    if (infer_resize_cache != nullptr) {
+      infer_resize_cache->ClearCurrentKey();
+    }
     if (cpp_infer_py_handler_ == nullptr) {
       // If run without Python.
       MS_LOG(WARNING) << "\'cpp_infer_py_handler_\' should not be null.";
@@ -378,6 +396,7 @@ AnfNodePtr GenInferNode(const AnfNodePtr &node) {
   MS_EXCEPTION_IF_NULL(node);
   auto cnode = node->cast<CNodePtr>();
   MS_EXCEPTION_IF_NULL(cnode);
+  CreateInferResizeCache(cnode);
   auto infer_node = AnfUtils::NewInferActorNode([cnode](void *args) { InferOp(cnode, args); }, cnode);
   infer_node->set_kernel_info(std::make_shared<device::KernelInfo>());
   return infer_node;
@@ -391,6 +410,12 @@ AnfNodePtr GenInitNode(const AnfNodePtr &node) {
   auto kernel_mod = AnfAlgo::GetKernelMod(cnode);
   MS_EXCEPTION_IF_NULL(kernel_mod);
   AnfUtils::CustomActorCallback actor_func = [kernel_mod, cnode](void *) {
+    // The kernel mod keeps the state of the latest resize, no need resize again for the same inputs.
+    const auto &infer_resize_cache = cnode->user_data<InferResizeCache>();
+    if (infer_resize_cache != nullptr && infer_resize_cache->IsResized()) {
+      profiler::ProfilerManager::GetInstance()->RecordResizeSkipped();
+      return;
+    }
     auto args = cnode->user_data<kernel::KernelArgs>();
     if (args == nullptr) {
       args = std::make_shared<kernel::KernelArgs>();
@@ -399,6 +424,9 @@ AnfNodePtr GenInitNode(const AnfNodePtr &node) {
         static_cast<int>(kernel::KRET_RESIZE_FAILED)) {
       MS_LOG(EXCEPTION) << "Node " << cnode->fullname_with_scope() << " Resize failed.";
     }
+    if (infer_resize_cache != nullptr) {
+      infer_resize_cache->SetResized();
+    }
   };
 
   auto init_node = AnfUtils::NewInitActorNode(actor_func, cnode);
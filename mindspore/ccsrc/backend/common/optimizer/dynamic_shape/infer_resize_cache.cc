@@ -0,0 +1,110 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/common/optimizer/dynamic_shape/infer_resize_cache.h"
+
+#include <string>
+#include "include/backend/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "include/common/utils/utils.h"
+#include "profiler/device/profiling.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace opt::dynamic_shape {
+namespace {
+constexpr size_t kInferResizeCacheCapacity = 64;
+constexpr char kDisableInferResizeCacheEnv[] = "MS_DEV_DISABLE_INFER_RESIZE_CACHE";
+}  // namespace
+
+std::string InferResizeCache::GenerateKey(const AbstractBasePtrList &args_spec_list,
+                                          const std::map<uint32_t, tensor::TensorPtr> &depend_tensor_map) {
+  std::string key;
+  for (const auto &abs : args_spec_list) {
+    MS_EXCEPTION_IF_NULL(abs);
+    const auto &shape = abs->BuildShape();
+    const auto &type = abs->BuildType();
+    MS_EXCEPTION_IF_NULL(shape);
+    MS_EXCEPTION_IF_NULL(type);
+    (void)key.append(shape->ToString()).append(type->ToString()).append("_");
+  }
+
+  // The infer result of the value depended kernel is decided by the input values too.
+  for (const auto &depend_tensor : depend_tensor_map) {
+    (void)key.append(std::to_string(depend_tensor.first)).append(":");
+    const auto &tensor = depend_tensor.second;
+    if (tensor == nullptr || tensor->data_c() == nullptr) {
+      continue;
+    }
+    (void)key.append(static_cast<const char *>(tensor->data_c()), tensor->Size());
+  }
+  return key;
+}
+
+bool InferResizeCache::FetchInferResult(const std::string &key, const CNodePtr &cnode) {
+  MS_EXCEPTION_IF_NULL(cnode);
+  current_key_ = key;
+  const auto &iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    profiler::ProfilerManager::GetInstance()->RecordInferCacheAccess(false);
+    return false;
+  }
+
+  lru_keys_.splice(lru_keys_.begin(), lru_keys_, iter->second.second);
+  MS_EXCEPTION_IF_NULL(iter->second.first);
+  // The abstract of node may be updated after launch, so the cached abstract can't be shared with the node.
+  cnode->set_abstract(iter->second.first->Clone());
+  profiler::ProfilerManager::GetInstance()->RecordInferCacheAccess(true);
+  return true;
+}
+
+void InferResizeCache::SaveInferResult(const std::string &key, const CNodePtr &cnode) {
+  MS_EXCEPTION_IF_NULL(cnode);
+  MS_EXCEPTION_IF_NULL(cnode->abstract());
+  if (entries_.count(key) > 0) {
+    return;
+  }
+
+  if (entries_.size() >= capacity_) {
+    const auto &evicted_key = lru_keys_.back();
+    // The state of kernel mod doesn't correspond to any key after the resized key is evicted.
+    if (evicted_key == resized_key_) {
+      resized_key_.clear();
+    }
+    (void)entries_.erase(evicted_key);
+    lru_keys_.pop_back();
+  }
+  lru_keys_.push_front(key);
+  entries_[key] = std::make_pair(cnode->abstract()->Clone(), lru_keys_.begin());
+}
+
+void CreateInferResizeCache(const CNodePtr &cnode) {
+  MS_EXCEPTION_IF_NULL(cnode);
+  if (common::GetEnv(kDisableInferResizeCacheEnv) == "1") {
+    return;
+  }
+
+  // The output shape of these kernels is decided after launch and the PyExecute infer is decided by the python object,
+  // so they can't be memoized.
+  auto kernel_mod = AnfAlgo::GetKernelMod(cnode);
+  if (kernel_mod == nullptr || kernel_mod->IsNeedRetrieveOutputShape() ||
+      IsPrimitiveCNode(cnode, prim::kPrimPyExecute) || common::AnfAlgo::IsDynamicSequence(cnode)) {
+    return;
+  }
+  cnode->set_user_data<InferResizeCache>(std::make_shared<InferResizeCache>(kInferResizeCacheCapacity));
+}
+}  // namespace opt::dynamic_shape
+}  // namespace mindspore
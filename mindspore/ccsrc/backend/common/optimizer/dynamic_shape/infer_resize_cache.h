@@ -0,0 +1,77 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_COMMON_OPTIMIZER_DYNAMIC_SHAPE_INFER_RESIZE_CACHE_H
+#define MINDSPORE_CCSRC_BACKEND_COMMON_OPTIMIZER_DYNAMIC_SHAPE_INFER_RESIZE_CACHE_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "utils/hash_map.h"
+#include "ir/anf.h"
+#include "ir/tensor.h"
+#include "abstract/abstract_value.h"
+
+namespace mindspore::opt::dynamic_shape {
+// The memoization of the infer shape and resize results of one dynamic shape kernel. The key is built from the input
+// shapes, types and the values of the depended inputs, so the steps with the recurring shapes (such as the bucketed
+// sequence lengths) can reuse the output abstract instead of running the infer again. The kernel mod only holds the
+// state of the latest resize, so the resize is skipped when the latest resize has been done with the same key.
+class InferResizeCache {
+ public:
+  explicit InferResizeCache(size_t capacity) : capacity_(capacity) {}
+  ~InferResizeCache() = default;
+
+  // Generate the cache key by the input abstracts and the depended input values.
+  static std::string GenerateKey(const AbstractBasePtrList &args_spec_list,
+                                 const std::map<uint32_t, tensor::TensorPtr> &depend_tensor_map);
+
+  // Set the cached output abstract to the node and return true if the key is hit.
+  bool FetchInferResult(const std::string &key, const CNodePtr &cnode);
+  // Save the output abstract of the node after the infer.
+  void SaveInferResult(const std::string &key, const CNodePtr &cnode);
+
+  // Whether the kernel mod has been resized by the key of the latest infer.
+  bool IsResized() const { return !current_key_.empty() && (current_key_ == resized_key_); }
+  void SetResized() { resized_key_ = current_key_; }
+  // The infer which is not memoized (e.g. fed by PyExecute) may change the shape, so the latest infer has no key and
+  // the kernel mod has to be resized.
+  void ClearCurrentKey() { current_key_.clear(); }
+
+  // cppcheck-suppress unusedStructMember
+  constexpr static char key[] = "InferResizeCache";
+
+ private:
+  // The max number of entries, the least recently used entry will be evicted when exceeding.
+  size_t capacity_;
+  // The least recently used order of the keys, the front is the most recently used.
+  std::list<std::string> lru_keys_;
+  mindspore::HashMap<std::string, std::pair<AbstractBasePtr, std::list<std::string>::iterator>> entries_;
+  // The key of the latest infer.
+  std::string current_key_;
+  // The key which the state of kernel mod corresponds to.
+  std::string resized_key_;
+};
+using InferResizeCachePtr = std::shared_ptr<InferResizeCache>;
+
+// Create the infer and resize cache for the node if it is supported and enabled, which is disabled by the environment
+// variable 'MS_DEV_DISABLE_INFER_RESIZE_CACHE=1'.
+void CreateInferResizeCache(const CNodePtr &cnode);
+}  // namespace mindspore::opt::dynamic_shape
+#endif  // MINDSPORE_CCSRC_BACKEND_COMMON_OPTIMIZER_DYNAMIC_SHAPE_INFER_RESIZE_CACHE_H
@@ -952,9 +952,9 @@ void MindRTBackend::DispatchOpTask(bool single_op_cache_hit, VectorRef *outputs,
   } else {
     promise.set_value(true);
   }
-  op_executor.PushOpRunTask(std::make_shared<pynative::BackendOpRunTask>(
+  op_executor.PushOpRunTask(
     run_op_context, [this](const std::shared_ptr<pynative::OpTaskContext> &ctx) { OpRunCallback(ctx); },
-    std::move(future)));
+    std::move(future));
 
   op_executor.Register([this]() { BatchBuildCallback(); });
   if (op_executor.BuildQueueFull()) {
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <cstring>
+#include <map>
 #include <string>
 #include <vector>
 #include "distributed/cluster/actor_route_table_proxy.h"
@@ -27,7 +29,7 @@ bool ActorRouteTableProxy::RegisterRoute(const std::string &actor_id, const topo
 
   bool success = false;
   while (!success) {
-    success = cgn_->PutMetadata(actor_id, actor_addr.SerializeAsString(), false);
+    success = cgn_->PutMetadata(kActorRoutePrefix + actor_id, actor_addr.SerializeAsString(), false);
     if (!success) {
       MS_LOG(WARNING) << "Retry to register the address for actor: " << actor_id;
       (void)sleep(kInterval);
@@ -39,34 +41,61 @@ bool ActorRouteTableProxy::RegisterRoute(const std::string &actor_id, const topo
 
 topology::ActorAddress ActorRouteTableProxy::LookupRoute(const std::string &actor_id) const {
   MS_EXCEPTION_IF_NULL(cgn_);
-  // Whether this lookup operation is successful.
-  bool lookup_success = false;
   // Lookup last timestamp before timeout.
   auto timeout_ts = CURRENT_TIMESTAMP_MILLI + lookup_timeout_;
-  topology::ActorAddress lookup_route_rsp_msg;
 
-  do {
-    auto route = cgn_->GetMetadata(actor_id);
-    if (route.length() == 0) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(kLookupInterval));
-    } else {
-      (void)lookup_route_rsp_msg.ParseFromArray(route.c_str(), SizeToInt(route.size()));
-      lookup_success = true;
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      bool expired = CURRENT_TIMESTAMP_MILLI - route_fetch_time_ > std::chrono::milliseconds(kRouteCacheExpiration);
+      if (expired) {
+        (void)FetchRoutes();
+      }
+      auto iter = route_cache_.find(actor_id);
+      if (iter != route_cache_.end()) {
+        return iter->second;
+      }
+      if (!expired && FetchRoutes()) {
+        iter = route_cache_.find(actor_id);
+        if (iter != route_cache_.end()) {
+          return iter->second;
+        }
+      }
     }
-
-    // An actor route could not be registered yet because another process could be launched slow.
-    // If the response actor id is empty, this means the adderess is not registered yet.
-    if (lookup_route_rsp_msg.actor_id().empty()) {
-      MS_LOG(WARNING) << "Retry to get the address of actor " << actor_id;
+    if (CURRENT_TIMESTAMP_MILLI > timeout_ts) {
+      break;
     }
-  } while (!lookup_success && CURRENT_TIMESTAMP_MILLI <= timeout_ts);
+    // An actor route could not be registered yet because another process could be launched slow.
+    MS_LOG(WARNING) << "Retry to get the address of actor " << actor_id;
+    std::this_thread::sleep_for(std::chrono::milliseconds(kLookupInterval));
+  }
 
-  if (!lookup_success) {
-    MS_LOG(EXCEPTION) << "Failed to lookup actor address for " << actor_id
-                      << ".\nMaybe the distributed graph is not properly partitioned or training process is not "
-                         "launched with correct number. Please check python code or launching script.";
+  MS_LOG(EXCEPTION) << "Failed to lookup actor address for " << actor_id
+                    << ".\nMaybe the distributed graph is not properly partitioned or training process is not "
+                       "launched with correct number. Please check python code or launching script.";
+}
+
+bool ActorRouteTableProxy::FetchRoutes() const {
+  std::map<std::string, std::string> routes;
+  std::vector<std::string> deleted_routes;
+  uint64_t new_version = route_version_;
+  if (!cgn_->GetMetadataDelta(kActorRoutePrefix, route_version_, &routes, &deleted_routes, &new_version)) {
+    return false;
+  }
+  const size_t prefix_len = strlen(kActorRoutePrefix);
+  for (const auto &route : routes) {
+    topology::ActorAddress actor_address;
+    (void)actor_address.ParseFromArray(route.second.c_str(), SizeToInt(route.second.size()));
+    route_cache_[route.first.substr(prefix_len)] = actor_address;
   }
-  return lookup_route_rsp_msg;
+  for (const auto &route : deleted_routes) {
+    (void)route_cache_.erase(route.substr(prefix_len));
+  }
+  MS_LOG(DEBUG) << "Fetched " << routes.size() << " actor routes changed and " << deleted_routes.size()
+                << " actor routes deleted from version " << route_version_ << " to version " << new_version;
+  route_version_ = new_version;
+  route_fetch_time_ = CURRENT_TIMESTAMP_MILLI;
+  return true;
 }
 }  // namespace cluster
 }  // namespace distributed
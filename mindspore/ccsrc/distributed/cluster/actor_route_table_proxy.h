@@ -17,6 +17,8 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_CLUSTER_ACTOR_ROUTE_TABLE_PROXY_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_CLUSTER_ACTOR_ROUTE_TABLE_PROXY_H_
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <memory>
 #include <chrono>
@@ -33,6 +35,14 @@ constexpr uint32_t kDefaultLookupTimeout = 300000;
 // The time in milliseconds between two lookup operations.
 constexpr uint32_t kLookupInterval = 3000;
 
+// The time in milliseconds the cached routes are used without fetching the changes from scheduler, so that the deleted
+// or re-registered routes are dropped or updated in time.
+constexpr uint32_t kRouteCacheExpiration = 1000;
+
+// The prefix of the metadata names of actor routes in the meta server, so that all the routes registered since the
+// last lookup could be fetched at once.
+constexpr char kActorRoutePrefix[] = "actor_route:";
+
 // Actor route table proxy for nodes like workers and server. This class helps update actor route table in scheduler
 // across the network.
 class ActorRouteTableProxy {
@@ -45,15 +55,26 @@ class ActorRouteTableProxy {
   // Register actor address to the route table stored in scheduler.
   bool RegisterRoute(const std::string &actor_id, const topology::ActorAddress &actor_addr);
 
-  // Get the actor address for the specified actor_id from the route table stored in scheduler.
+  // Get the actor address for the specified actor_id from the route table stored in scheduler. The routes are cached
+  // and only the routes changed since the last lookup are fetched from scheduler if the route is not cached or the
+  // cache is expired.
   topology::ActorAddress LookupRoute(const std::string &actor_id) const;
 
  private:
+  // Fetch the routes changed since the last fetching into the cache, the caller should hold `cache_mutex_`.
+  bool FetchRoutes() const;
+
   // The cgn variable helps proxy to communicate with meta server.
   std::shared_ptr<topology::ComputeGraphNode> cgn_;
 
   // The timeout window for lookup route operation because time of route lookup_timeout of each process is different.
   std::chrono::milliseconds lookup_timeout_;
+
+  // The cached routes, the metadata version of the meta server they are fetched at and the time they are fetched.
+  mutable std::map<std::string, topology::ActorAddress> route_cache_;
+  mutable uint64_t route_version_{0};
+  mutable std::chrono::milliseconds route_fetch_time_{0};
+  mutable std::mutex cache_mutex_;
 };
 
 using ActorRouteTableProxyPtr = std::shared_ptr<ActorRouteTableProxy>;
@@ -79,7 +79,8 @@ enum class MessageName {
   kDeleteMetadata,
   kGetHostNames,
   kValidMetadata,
-  kInvalidMetadata
+  kInvalidMetadata,
+  kReadMetadataDelta
 };
 
 // The retry and interval configuration used for the macro `EXECUTE_WITH_RETRY`.
@@ -415,6 +415,42 @@ bool ComputeGraphNode::DeleteMetadata(const std::string &name, uint32_t timeout)
   }
 }
 
+bool ComputeGraphNode::GetMetadataDelta(const std::string &prefix, uint64_t version,
+                                        std::map<std::string, std::string> *metadata,
+                                        std::vector<std::string> *deleted_names, uint64_t *new_version,
+                                        uint32_t timeout) {
+  MS_ERROR_IF_NULL_W_RET_VAL(metadata, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(deleted_names, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(new_version, false);
+  MetadataDeltaMessage delta;
+  delta.set_prefix(prefix);
+  delta.set_version(version);
+
+  auto message =
+    CreateMessage(meta_server_addr_.GetUrl(), std::to_string(static_cast<int>(MessageName::kReadMetadataDelta)),
+                  delta.SerializeAsString());
+  MS_EXCEPTION_IF_NULL(message);
+
+  MS_EXCEPTION_IF_NULL(tcp_client_);
+  auto retval = tcp_client_->ReceiveSync(std::move(message), timeout);
+  if (retval == rpc::NULL_MSG) {
+    return false;
+  }
+  if (retval->name != std::to_string(static_cast<int>(MessageName::kValidMetadata))) {
+    delete retval;
+    return false;
+  }
+  MetadataDeltaRespMessage resp_msg;
+  (void)resp_msg.ParseFromArray(retval->body.c_str(), SizeToInt(retval->body.length()));
+  delete retval;
+  for (const auto &entry : resp_msg.entries()) {
+    (*metadata)[entry.name()] = entry.value();
+  }
+  (void)deleted_names->insert(deleted_names->end(), resp_msg.deleted_names().begin(), resp_msg.deleted_names().end());
+  *new_version = resp_msg.version();
+  return true;
+}
+
 // The transaction of the exchange process is as follows:
 // step 1: RANK[0]       - Start the exchange process (set EXCHANGE_META_${name} flag);
 // step 2: RANK[1-(N-1)] - Start the exchange process (check EXCHANGE_META_${name} flag);
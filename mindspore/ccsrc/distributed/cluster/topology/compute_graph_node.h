@@ -58,6 +58,12 @@ class BACKEND_EXPORT ComputeGraphNode : public NodeBase {
 
   bool DeleteMetadata(const std::string &name, uint32_t timeout = 5);
 
+  // Read the metadata whose name starts with `prefix` and which is written or deleted after `version` from the meta
+  // server node, and get the latest version of the metadata as `new_version`, which is used as `version` of the next
+  // reading to get only the changes.
+  bool GetMetadataDelta(const std::string &prefix, uint64_t version, std::map<std::string, std::string> *metadata,
+                        std::vector<std::string> *deleted_names, uint64_t *new_version, uint32_t timeout = 5);
+
   // Exchange metadata(name:value) between all the compute graph nodes.
   // The transaction of the exchange process is guaranteed.
   bool ExchangeMetadata(const std::string &biz, const size_t &rank_size, const std::vector<std::string> &names_prefix,
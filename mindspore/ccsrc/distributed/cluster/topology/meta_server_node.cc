@@ -127,6 +127,8 @@ bool MetaServerNode::InitTCPServer() {
     std::bind(&MetaServerNode::ProcessDeleteMetadata, this, std::placeholders::_1);
   system_msg_handlers_[MessageName::kGetHostNames] =
     std::bind(&MetaServerNode::ProcessGetHostNames, this, std::placeholders::_1);
+  system_msg_handlers_[MessageName::kReadMetadataDelta] =
+    std::bind(&MetaServerNode::ProcessReadMetadataDelta, this, std::placeholders::_1);
   return true;
 }
 
@@ -188,6 +190,7 @@ MessageBase *const MetaServerNode::ProcessRegister(MessageBase *const message) {
     node_info->state = NodeState::kRegistered;
     (void)time(&(node_info->last_update));
     nodes_[node_id] = node_info;
+    AddHeartbeatNode(node_id);
     MS_LOG(INFO) << "The new node: " << node_id << "(role: " << role << ")"
                  << " is registered successfully.";
     (void)TransitionToInitialized();
@@ -227,7 +230,7 @@ MessageBase *const MetaServerNode::ProcessUnregister(MessageBase *const message)
 
   if (topo_state_ != TopoState::kInitialized) {
     MS_LOG(ERROR) << "Unable to process unreg message from node " << node_id << " because the state of the topology is "
-                  << topo_state_;
+                  << topo_state_.load();
     auto response = CreateMessage(meta_server_addr_.GetUrl(), MessageName::kUninitTopo,
                                   std::to_string(static_cast<int>(MessageName::kUninitTopo)));
     MS_EXCEPTION_IF_NULL(response);
@@ -243,6 +246,7 @@ MessageBase *const MetaServerNode::ProcessUnregister(MessageBase *const message)
     return response.release();
   }
   (void)nodes_.erase(node_id);
+  RemoveHeartbeatNode(node_id);
   if (nodes_.size() == 0) {
     topo_state_ = TopoState::kFinished;
   }
@@ -258,28 +262,28 @@ MessageBase *const MetaServerNode::ProcessHeartbeat(MessageBase *const message)
   const std::string &body = message->Body();
   (void)heartbeat.ParseFromArray(body.c_str(), SizeToInt(body.length()));
 
-  // Update the state(timestamp) of this node.
+  // Update the state(timestamp) of this node. Only the shard of this node is locked here, and the timestamp is applied
+  // to the node state by the topo monitor thread later.
   const auto &node_id = heartbeat.node_id();
-  std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
-  if (nodes_.find(node_id) != nodes_.end()) {
-    auto &node = nodes_[node_id];
-    MS_ERROR_IF_NULL_W_RET_VAL(node, rpc::NULL_MSG);
-    (void)time(&(node->last_update));
-    node->state = NodeState::kRegistered;
-
-    HeartbeatRespMessage resp_msg;
-    resp_msg.set_success(static_cast<bool>(MessageName::kSuccess));
-    resp_msg.set_topo_state(static_cast<uint32_t>(topo_state_));
-    resp_msg.set_nodes_num(SizeToUint(total_node_num_));
-    resp_msg.set_abnormal_nodes_num(SizeToUint(abnormal_node_num_));
-    auto content = resp_msg.SerializeAsString();
-    auto response = CreateMessage(meta_server_addr_.GetUrl(), MessageName::kSuccess, content);
-    MS_EXCEPTION_IF_NULL(response);
-    return response.release();
-  } else {
-    MS_LOG(ERROR) << "Invalid node: " << node_id << ".";
-    return rpc::NULL_MSG;
+  auto &shard = GetHeartbeatShard(node_id);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.nodes.count(node_id) == 0) {
+      MS_LOG(ERROR) << "Invalid node: " << node_id << ".";
+      return rpc::NULL_MSG;
+    }
+    (void)time(&(shard.pending_heartbeats[node_id]));
   }
+
+  HeartbeatRespMessage resp_msg;
+  resp_msg.set_success(static_cast<bool>(MessageName::kSuccess));
+  resp_msg.set_topo_state(static_cast<uint32_t>(topo_state_.load()));
+  resp_msg.set_nodes_num(SizeToUint(total_node_num_));
+  resp_msg.set_abnormal_nodes_num(SizeToUint(abnormal_node_num_));
+  auto content = resp_msg.SerializeAsString();
+  auto response = CreateMessage(meta_server_addr_.GetUrl(), MessageName::kSuccess, content);
+  MS_EXCEPTION_IF_NULL(response);
+  return response.release();
 }
 
 MessageBase *const MetaServerNode::ProcessWriteMetadata(MessageBase *const message) {
@@ -291,8 +295,9 @@ MessageBase *const MetaServerNode::ProcessWriteMetadata(MessageBase *const messa
     MS_LOG(ERROR) << "Empty metadata name.";
     return rpc::NULL_MSG;
   }
-  std::shared_lock<std::shared_mutex> lock(meta_mutex_);
+  std::unique_lock<std::shared_mutex> lock(meta_mutex_);
   metadata_[meta_msg.name()] = meta_msg.value();
+  UpdateMetadataVersion(meta_msg.name());
   return rpc::NULL_MSG;
 }
 
@@ -324,7 +329,7 @@ MessageBase *const MetaServerNode::ProcessDeleteMetadata(MessageBase *const mess
   MetadataMessage meta_msg;
   (void)meta_msg.ParseFromArray(body.c_str(), SizeToInt(body.length()));
 
-  std::shared_lock<std::shared_mutex> lock(meta_mutex_);
+  std::unique_lock<std::shared_mutex> lock(meta_mutex_);
   MessageName result;
   std::unique_ptr<MessageBase> response;
 
@@ -333,12 +338,55 @@ MessageBase *const MetaServerNode::ProcessDeleteMetadata(MessageBase *const mess
   } else {
     result = MessageName::kValidMetadata;
     (void)metadata_.erase(meta_msg.name());
+    UpdateMetadataVersion(meta_msg.name());
   }
   response = CreateMessage(meta_server_addr_.GetUrl(), result, meta_msg.SerializeAsString());
   MS_EXCEPTION_IF_NULL(response);
   return response.release();
 }
 
+MessageBase *const MetaServerNode::ProcessReadMetadataDelta(MessageBase *const message) {
+  MS_ERROR_IF_NULL_W_RET_VAL(message, rpc::NULL_MSG);
+  const std::string &body = message->Body();
+  MetadataDeltaMessage delta_msg;
+  (void)delta_msg.ParseFromArray(body.c_str(), SizeToInt(body.length()));
+  const auto &prefix = delta_msg.prefix();
+
+  MetadataDeltaRespMessage resp_msg;
+  std::shared_lock<std::shared_mutex> lock(meta_mutex_);
+  for (auto iter = versioned_metadata_.upper_bound(delta_msg.version()); iter != versioned_metadata_.end(); ++iter) {
+    const auto &name = iter->second;
+    if (name.compare(0, prefix.length(), prefix) != 0) {
+      continue;
+    }
+    auto meta_iter = metadata_.find(name);
+    if (meta_iter == metadata_.end()) {
+      resp_msg.add_deleted_names(name);
+      continue;
+    }
+    auto entry = resp_msg.add_entries();
+    MS_EXCEPTION_IF_NULL(entry);
+    entry->set_name(name);
+    entry->set_value(meta_iter->second);
+  }
+  resp_msg.set_version(metadata_version_);
+  auto response =
+    CreateMessage(meta_server_addr_.GetUrl(), MessageName::kValidMetadata, resp_msg.SerializeAsString());
+  MS_EXCEPTION_IF_NULL(response);
+  return response.release();
+}
+
+void MetaServerNode::UpdateMetadataVersion(const std::string &name) {
+  auto iter = metadata_versions_.find(name);
+  if (iter != metadata_versions_.end()) {
+    (void)versioned_metadata_.erase(iter->second);
+    (void)metadata_versions_.erase(iter);
+  }
+  ++metadata_version_;
+  metadata_versions_[name] = metadata_version_;
+  versioned_metadata_[metadata_version_] = name;
+}
+
 MessageBase *const MetaServerNode::ProcessGetHostNames(MessageBase *const message) {
   MS_ERROR_IF_NULL_W_RET_VAL(message, rpc::NULL_MSG);
   // Convert result to the message.
@@ -389,7 +437,8 @@ MessageBase *const MetaServerNode::ProcessGetHostNames(MessageBase *const messag
 void MetaServerNode::UpdateTopoState() {
   try {
     while (enable_monitor_) {
-      nodes_mutex_.lock();
+      std::unique_lock<std::shared_mutex> lock(nodes_mutex_);
+      ApplyHeartbeats();
 
       // Update the state of topology.
       if (topo_state_ == TopoState::kInitializing) {
@@ -434,17 +483,51 @@ void MetaServerNode::UpdateTopoState() {
         MS_LOG(EXCEPTION) << "The total number of timed out node is " << abnormal_node_num_;
       }
 
-      nodes_mutex_.unlock();
+      lock.unlock();
 
       static const size_t interval = 3;
       (void)sleep(interval);
     }
   } catch (const std::exception &e) {
-    nodes_mutex_.unlock();
     MsException::Instance().SetException();
   }
 }
 
+MetaServerNode::HeartbeatShard &MetaServerNode::GetHeartbeatShard(const std::string &node_id) {
+  return heartbeat_shards_[std::hash<std::string>()(node_id) % kHeartbeatShardNum];
+}
+
+void MetaServerNode::AddHeartbeatNode(const std::string &node_id) {
+  auto &shard = GetHeartbeatShard(node_id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  (void)shard.nodes.insert(node_id);
+}
+
+void MetaServerNode::RemoveHeartbeatNode(const std::string &node_id) {
+  auto &shard = GetHeartbeatShard(node_id);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  (void)shard.nodes.erase(node_id);
+  (void)shard.pending_heartbeats.erase(node_id);
+}
+
+void MetaServerNode::ApplyHeartbeats() {
+  for (auto &shard : heartbeat_shards_) {
+    std::unordered_map<std::string, time_t> heartbeats;
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      heartbeats.swap(shard.pending_heartbeats);
+    }
+    for (const auto &heartbeat : heartbeats) {
+      auto iter = nodes_.find(heartbeat.first);
+      if (iter == nodes_.end() || iter->second == nullptr) {
+        continue;
+      }
+      iter->second->last_update = heartbeat.second;
+      iter->second->state = NodeState::kRegistered;
+    }
+  }
+}
+
 bool MetaServerNode::TransitionToInitialized() {
   if (nodes_.size() == total_node_num_) {
     // Persist the cluster metadata into storage through configuration.
@@ -534,6 +617,7 @@ bool MetaServerNode::Recovery() {
       node_info->rank_id = iter.value().at(kRankId);
       node_info->state = NodeState::kRegistered;
       nodes_[node_id] = node_info;
+      AddHeartbeatNode(node_id);
     }
 
     if (nodes_.size() == total_node_num_) {
@@ -20,9 +20,12 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <array>
+#include <mutex>
 #include <thread>
 #include <shared_mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include "distributed/rpc/tcp/tcp_server.h"
 #include "distributed/recovery/configuration.h"
 #include "distributed/cluster/topology/node_base.h"
@@ -46,6 +49,10 @@ enum class NodeState {
   kTimeout
 };
 
+// The number of the shards of the compute graph nodes for heartbeat processing. The heartbeats of the nodes in
+// different shards are processed without contention.
+constexpr size_t kHeartbeatShardNum = 64;
+
 // Record the state of the compute graph node.
 struct NodeInfo {
   explicit NodeInfo(const std::string &id) { node_id = id; }
@@ -117,12 +124,36 @@ class MetaServerNode : public NodeBase {
   MessageBase *const ProcessReadMetadata(MessageBase *const message);
   MessageBase *const ProcessDeleteMetadata(MessageBase *const message);
 
+  // Process the request for the metadata whose name starts with the given prefix and which is written after the given
+  // version, so that the compute graph nodes could cache the metadata and fetch only the changes.
+  MessageBase *const ProcessReadMetadataDelta(MessageBase *const message);
+
   // Gather all the hostname of registered compute graph nodes.
   MessageBase *const ProcessGetHostNames(MessageBase *const message);
 
   // Maintain the state which is type of `TopoState` of this cluster topology.
   void UpdateTopoState();
 
+  // The compute graph nodes of one shard and their heartbeats not applied to `nodes_` yet.
+  struct HeartbeatShard {
+    std::mutex mutex;
+    std::unordered_set<std::string> nodes;
+    // The node id and the timestamp of its latest heartbeat.
+    std::unordered_map<std::string, time_t> pending_heartbeats;
+  };
+  HeartbeatShard &GetHeartbeatShard(const std::string &node_id);
+
+  // Add or remove the node to process its heartbeats.
+  void AddHeartbeatNode(const std::string &node_id);
+  void RemoveHeartbeatNode(const std::string &node_id);
+
+  // Apply the pending heartbeats of all the shards to `nodes_` in batch, the caller should hold `nodes_mutex_`.
+  void ApplyHeartbeats();
+
+  // Record the new version of the written or deleted metadata, the caller should hold `meta_mutex_` exclusively. The
+  // deleted metadata is kept in the index, so that the readers of the delta could drop it from their caches.
+  void UpdateMetadataVersion(const std::string &name);
+
   // Try to transition the state of cluster to be initialized.
   bool TransitionToInitialized();
 
@@ -161,7 +192,7 @@ class MetaServerNode : public NodeBase {
   size_t total_node_num_;
 
   // The total number of abnormal(eg. timeout) compute graph nodes.
-  size_t abnormal_node_num_;
+  std::atomic<size_t> abnormal_node_num_;
 
   // The monitor thread for update the topo state.
   std::thread topo_monitor_;
@@ -174,6 +205,16 @@ class MetaServerNode : public NodeBase {
 
   mutable std::shared_mutex meta_mutex_;
 
+  // The version is increased by each metadata writing. The names of the metadata are indexed by their latest versions
+  // to find the changes after a version quickly.
+  uint64_t metadata_version_{0};
+  std::map<std::string, uint64_t> metadata_versions_;
+  std::map<uint64_t, std::string> versioned_metadata_;
+
+  // The heartbeats are recorded in the shards and applied to `nodes_` by the topo monitor thread in batch, so that
+  // heartbeats of thousands of nodes don't contend for `nodes_mutex_` with registration.
+  std::array<HeartbeatShard, kHeartbeatShardNum> heartbeat_shards_;
+
   uint64_t node_timeout_;
 
   // A key-value pairs metadata config used for failover recovery if enabled.
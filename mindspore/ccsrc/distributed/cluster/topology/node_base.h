@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_DISTRIBUTED_CLUSTER_TOPOLOGY_NODE_BASE_H_
 #define MINDSPORE_CCSRC_DISTRIBUTED_CLUSTER_TOPOLOGY_NODE_BASE_H_
 
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <memory>
@@ -82,8 +83,8 @@ class BACKEND_EXPORT NodeBase {
   // The start time of this meta server node.
   std::chrono::high_resolution_clock::time_point start_time_;
 
-  // The state of the topology consisting of compute graph nodes.
-  TopoState topo_state_;
+  // The state of the topology consisting of compute graph nodes, which is read by the message handlers without locks.
+  std::atomic<TopoState> topo_state_;
 };
 }  // namespace topology
 }  // namespace cluster
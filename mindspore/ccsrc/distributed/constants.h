@@ -22,6 +22,7 @@
 #include <chrono>
 #include <string>
 #include <vector>
+#include <utility>
 #include <functional>
 
 #include "actor/log.h"
@@ -137,6 +138,32 @@ using MemAllocateCallback = std::function<void *(size_t size)>;
  * @return {bool}: Whether the memory is successfully released.
  */
 using MemFreeCallback = std::function<bool(void *data)>;
+
+// The address and the size of a piece of memory.
+using MemSegment = std::pair<void *, size_t>;
+
+/**
+ * @description: The callback function type for receiving the data from the peer into the existing memory segments
+ * instead of the memory allocated by MemAllocateCallback, so that the data needs no copying after it's received.
+ * @param {size_t} size: Size of the data to be received.
+ * @param {std::vector<MemSegment>} *segments: The memory segments in order whose total size is the data size.
+ * @return {bool}: Whether the data could be received into the segments. If not, MemAllocateCallback is used.
+ */
+using MemScatterCallback = std::function<bool(size_t size, std::vector<MemSegment> *segments)>;
+
+// The max number of the memory segments of one message, which is limited by the iovec number of sendmsg and recvmsg.
+constexpr size_t kMaxMemSegmentNum = 512;
+
+// The message whose body is the memory segments sent or received in order without being copied into one piece of
+// memory. The data of the message is passed to MemFreeCallback after it's sent, and the size is the total size of the
+// segments.
+class ScatterMessage : public MessageBase {
+ public:
+  ScatterMessage() = default;
+  ~ScatterMessage() override = default;
+
+  std::vector<MemSegment> segments;
+};
 }  // namespace distributed
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_DISTRIBUTED_CONSTANTS_H_
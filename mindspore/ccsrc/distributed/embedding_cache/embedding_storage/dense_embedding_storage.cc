@@ -47,6 +47,7 @@ void DenseEmbeddingStorage<KeyType, ValueType, Allocator>::Finalize() {
 template <typename KeyType, typename ValueType, typename Allocator>
 bool DenseEmbeddingStorage<KeyType, ValueType, Allocator>::Get(const ConstDataWithLen &keys,
                                                                const DataWithLen &values) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
   const KeyType *keys_data = reinterpret_cast<const KeyType *>(keys.data_);
   ValueType *values_data = reinterpret_cast<ValueType *>(values.data_);
   size_t key_num = keys.data_len_ / sizeof(KeyType);
@@ -86,6 +87,8 @@ bool DenseEmbeddingStorage<KeyType, ValueType, Allocator>::Get(const ConstDataWi
   }
 
   if (cache_miss_cnt == 0) {
+    this->FreeMemory(indices_in_cache);
+    this->FreeMemory(cache_miss_offsets);
     return true;
   }
 
@@ -105,6 +108,7 @@ bool DenseEmbeddingStorage<KeyType, ValueType, Allocator>::Get(const ConstDataWi
 template <typename KeyType, typename ValueType, typename Allocator>
 bool DenseEmbeddingStorage<KeyType, ValueType, Allocator>::Put(const ConstDataWithLen &keys,
                                                                const ConstDataWithLen &values) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
   const KeyType *keys_data = reinterpret_cast<const KeyType *>(keys.data_);
   const ValueType *values_data = reinterpret_cast<const ValueType *>(values.data_);
   size_t key_num = keys.data_len_ / sizeof(KeyType);
@@ -145,6 +149,8 @@ bool DenseEmbeddingStorage<KeyType, ValueType, Allocator>::Put(const ConstDataWi
   }
 
   if (cache_miss_cnt == 0) {
+    this->FreeMemory(indices_in_cache);
+    this->FreeMemory(cache_miss_offsets);
     return true;
   }
 
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_EMBEDDING_STORAGE_EMBEDDING_STORAGE_H_
 
 #include <memory>
+#include <mutex>
 
 #include "distributed/embedding_cache/embedding_storage/abstract_embedding_storage.h"
 #include "distributed/embedding_cache/allocator.h"
@@ -123,6 +124,13 @@ class BACKEND_EXPORT EmbeddingStorage : public AbstractEmbeddingStorage {
 
   // The common allocator used to alloacte host memory.
   AllocatorType alloc_;
+
+  // The lookup and update kernels on the server may access the embedding storage concurrently, and the host cache and
+  // the persistent storage are not thread safe, so the 'Get' and 'Put' operations are serialized by this mutex.
+  // The lock is not striped by key hash: the LRU order, the eviction and the free cache slots are shared by all keys,
+  // so striping would need a sharded cache. Each 'Get' or 'Put' handles the whole batch of one kernel launch, so the
+  // lock is taken once per launch rather than once per key.
+  std::mutex mutex_;
 };
 }  // namespace storage
 }  // namespace distributed
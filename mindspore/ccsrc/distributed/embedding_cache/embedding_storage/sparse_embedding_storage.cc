@@ -41,6 +41,7 @@ void SparseEmbeddingStorage<KeyType, ValueType, Allocator>::Finalize() {
 template <typename KeyType, typename ValueType, typename Allocator>
 bool SparseEmbeddingStorage<KeyType, ValueType, Allocator>::Get(const ConstDataWithLen &keys,
                                                                 const DataWithLen &values) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
   const KeyType *keys_data = reinterpret_cast<const KeyType *>(keys.data_);
   ValueType *values_data = reinterpret_cast<ValueType *>(values.data_);
   size_t key_num = keys.data_len_ / sizeof(KeyType);
@@ -71,6 +72,8 @@ bool SparseEmbeddingStorage<KeyType, ValueType, Allocator>::Get(const ConstDataW
   }
 
   if (cache_miss_cnt == 0) {
+    this->FreeMemory(cache_hit);
+    this->FreeMemory(cache_miss_offsets);
     return true;
   }
 
@@ -90,6 +93,7 @@ bool SparseEmbeddingStorage<KeyType, ValueType, Allocator>::Get(const ConstDataW
 template <typename KeyType, typename ValueType, typename Allocator>
 bool SparseEmbeddingStorage<KeyType, ValueType, Allocator>::Put(const ConstDataWithLen &keys,
                                                                 const ConstDataWithLen &values) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
   const KeyType *keys_data = reinterpret_cast<const KeyType *>(keys.data_);
   const ValueType *values_data = reinterpret_cast<const ValueType *>(values.data_);
   size_t key_num = keys.data_len_ / sizeof(KeyType);
@@ -120,6 +124,8 @@ bool SparseEmbeddingStorage<KeyType, ValueType, Allocator>::Put(const ConstDataW
   }
 
   if (cache_miss_cnt == 0) {
+    this->FreeMemory(cache_hit);
+    this->FreeMemory(cache_miss_offsets);
     return true;
   }
 
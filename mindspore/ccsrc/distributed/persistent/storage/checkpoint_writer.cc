@@ -0,0 +1,405 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/persistent/storage/checkpoint_writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "utils/file_utils.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+#include "include/common/thread_pool.h"
+#include "distributed/persistent/storage/constants.h"
+#include "distributed/persistent/storage/file_io_utils.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+CheckpointWriter::CheckpointWriter(const std::map<std::string, std::string> &storage_config) {
+  auto file_path_iter = storage_config.find(kFileStoragePath);
+  if (file_path_iter != storage_config.end()) {
+    file_path_ = file_path_iter->second;
+  }
+
+  auto block_length_iter = storage_config.find(kMaxBlockLength);
+  if (block_length_iter != storage_config.end() && !(block_length_iter->second).empty()) {
+    max_block_length_ = std::stoul(block_length_iter->second);
+  } else {
+    max_block_length_ = kDefaultCheckpointBlockLength;
+  }
+
+  auto thread_num_iter = storage_config.find(kWriterThreadNum);
+  if (thread_num_iter != storage_config.end() && !(thread_num_iter->second).empty()) {
+    thread_num_ = std::stoul(thread_num_iter->second);
+  } else {
+    thread_num_ = kDefaultCheckpointWriterThreadNum;
+  }
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  if (write_thread_.joinable()) {
+    write_thread_.join();
+  }
+}
+
+void CheckpointWriter::Initialize() {
+  if (file_path_.empty()) {
+    MS_LOG(EXCEPTION) << "The file storage path of the checkpoint is empty.";
+  }
+  MS_EXCEPTION_IF_ZERO("max_block_length_", max_block_length_);
+  MS_EXCEPTION_IF_ZERO("thread_num_", thread_num_);
+  FileIOUtils::CreateDirRecursive(file_path_);
+
+  // Continue the versions of the committed checkpoint, so that its block files are never overwritten.
+  std::string meta_file_name = file_path_ + "/" + kCheckpointMetaFileName;
+  if (FileIOUtils::IsFileOrDirExist(meta_file_name)) {
+    BlockMeta committed_meta(meta_file_name);
+    if (committed_meta.Initialize() && committed_meta.Exists(kCheckpointVersion) &&
+        committed_meta.Exists(kBlockVersions)) {
+      version_ = committed_meta.Get<size_t>(kCheckpointVersion);
+      committed_versions_ = committed_meta.Get<std::vector<std::vector<size_t>>>(kBlockVersions);
+    }
+  }
+
+  // The temporary meta left by a crashed save is discarded.
+  std::string tmp_meta_file_name = meta_file_name + kTmpFileSuffix;
+  (void)std::remove(tmp_meta_file_name.c_str());
+  checkpoint_meta_ = std::make_shared<BlockMeta>(tmp_meta_file_name);
+  if (!checkpoint_meta_->Initialize()) {
+    MS_LOG(EXCEPTION) << "Initialize checkpoint meta failed, file name [" << tmp_meta_file_name << "]";
+  }
+}
+
+void CheckpointWriter::Finalize() {
+  (void)Wait();
+  staged_tensors_.clear();
+  checkpoint_meta_ = nullptr;
+}
+
+size_t CheckpointWriter::Save(int64_t step, const std::vector<CheckpointInput> &inputs, bool incremental) {
+  MS_EXCEPTION_IF_NULL(checkpoint_meta_);
+  // The staging buffer is still being written by the last save, and the blocks failed to write need to be rewritten.
+  bool last_success = Wait();
+  bool reset = ResetStagedTensors(inputs);
+  bool force = !incremental || !last_success || reset;
+
+  std::vector<std::pair<size_t, size_t>> blocks;
+  for (size_t tensor_index = 0; tensor_index < inputs.size(); ++tensor_index) {
+    const auto &input = inputs[tensor_index].second;
+    if (input.data_len_ != 0) {
+      MS_EXCEPTION_IF_NULL(input.data_);
+    }
+    for (size_t block_index = 0; block_index < staged_tensors_[tensor_index].dirty.size(); ++block_index) {
+      (void)blocks.emplace_back(tensor_index, block_index);
+    }
+  }
+
+  // Copy the blocks in parallel, it's the only time the training is blocked by the checkpoint.
+  size_t stage_thread_num = std::max<size_t>(common::ThreadPool::GetInstance().GetSyncRunThreadNum(), 1);
+  std::vector<common::Task> tasks;
+  for (size_t thread_index = 0; thread_index < std::min(stage_thread_num, blocks.size()); ++thread_index) {
+    (void)tasks.emplace_back([this, &inputs, &blocks, thread_index, stage_thread_num, force]() {
+      for (size_t i = thread_index; i < blocks.size(); i += stage_thread_num) {
+        const auto &block = blocks[i];
+        StageBlock(block.first, block.second, inputs[block.first].second.data_, force);
+      }
+      return common::SUCCESS;
+    });
+  }
+  if (!common::ThreadPool::GetInstance().SyncRun(tasks)) {
+    MS_LOG(EXCEPTION) << "Copying the tensors to the staging buffer of the checkpoint failed.";
+  }
+
+  size_t dirty_block_num = 0;
+  for (const auto &staged_tensor : staged_tensors_) {
+    dirty_block_num += LongToSize(std::count(staged_tensor.dirty.begin(), staged_tensor.dirty.end(), 1));
+  }
+  MS_LOG(INFO) << "Save the checkpoint of step " << step << ", the number of the blocks to write is "
+               << dirty_block_num << ", the total number of the blocks is " << blocks.size();
+  write_thread_ = std::thread(&CheckpointWriter::WriteDirtyBlocks, this, step);
+  return dirty_block_num;
+}
+
+bool CheckpointWriter::Wait() {
+  if (write_thread_.joinable()) {
+    write_thread_.join();
+  }
+  return write_success_;
+}
+
+bool CheckpointWriter::Load(const std::vector<CheckpointOutput> &outputs, int64_t *step) {
+  MS_ERROR_IF_NULL_W_RET_VAL(step, false);
+  (void)Wait();
+
+  std::string meta_file_name = file_path_ + "/" + kCheckpointMetaFileName;
+  if (!FileIOUtils::IsFileOrDirExist(meta_file_name)) {
+    MS_LOG(ERROR) << "The checkpoint meta file [" << meta_file_name << "] is not exist.";
+    return false;
+  }
+  BlockMeta meta(meta_file_name);
+  if (!meta.Initialize() || !meta.Exists(kCheckpointComplete) || !meta.Get<bool>(kCheckpointComplete) ||
+      !meta.Exists(kBlockVersions)) {
+    MS_LOG(ERROR) << "The checkpoint in [" << file_path_ << "] is incomplete.";
+    return false;
+  }
+  auto names = meta.Get<std::vector<std::string>>(kTensorNames);
+  auto sizes = meta.Get<std::vector<size_t>>(kTensorSizes);
+  auto versions = meta.Get<std::vector<std::vector<size_t>>>(kBlockVersions);
+  auto block_length = meta.Get<size_t>(kMaxBlockLength);
+  MS_EXCEPTION_IF_ZERO("block_length", block_length);
+
+  for (const auto &output : outputs) {
+    auto iter = std::find(names.begin(), names.end(), output.first);
+    if (iter == names.end()) {
+      MS_LOG(ERROR) << "The tensor [" << output.first << "] is not in the checkpoint.";
+      return false;
+    }
+    size_t tensor_index = LongToSize(iter - names.begin());
+    size_t size = sizes.at(tensor_index);
+    if (output.second.data_len_ != size) {
+      MS_LOG(ERROR) << "The size of the tensor [" << output.first << "] is " << output.second.data_len_
+                    << ", but the size in the checkpoint is " << size;
+      return false;
+    }
+    size_t block_num = (size + block_length - 1) / block_length;
+    const auto &block_versions = versions.at(tensor_index);
+    if (block_versions.size() != block_num) {
+      MS_LOG(ERROR) << "The number of the block versions of the tensor [" << output.first << "] is "
+                    << block_versions.size() << ", but the number of the blocks is " << block_num;
+      return false;
+    }
+    for (size_t block_index = 0; block_index < block_num; ++block_index) {
+      size_t version = block_versions[block_index];
+      std::string block_meta_file_name = BlockMetaFileName(tensor_index, block_index, version);
+      auto block_meta = std::make_shared<BlockMeta>(block_meta_file_name);
+      if (!block_meta->Initialize()) {
+        MS_LOG(ERROR) << "Initialize block meta failed, file name [" << block_meta_file_name << "]";
+        return false;
+      }
+      Block block(BlockFileName(tensor_index, block_index, version));
+      block.set_block_meta(block_meta);
+      if (!block.CheckSha256Seq()) {
+        return false;
+      }
+      size_t offset = block_meta->Get<size_t>(kOffset);
+      size_t field_size = block_meta->Get<size_t>(kFieldsLength);
+      if (offset + field_size > size) {
+        MS_LOG(ERROR) << "The block [" << block.block_file_name() << "] is out of the range of the tensor.";
+        return false;
+      }
+      void *data_ptr = reinterpret_cast<char *>(output.second.data_) + offset;
+      if (!FileIOUtils::Read(block.block_file_name(), {{data_ptr, field_size}})) {
+        MS_LOG(ERROR) << "Read block file failed, file name [" << block.block_file_name() << "]";
+        return false;
+      }
+    }
+  }
+  *step = meta.Get<int64_t>(kCheckpointStep);
+  return true;
+}
+
+bool CheckpointWriter::ResetStagedTensors(const std::vector<CheckpointInput> &inputs) {
+  bool same_tensors = staged_tensors_.size() == inputs.size() &&
+                      std::equal(inputs.begin(), inputs.end(), staged_tensors_.begin(),
+                                 [](const CheckpointInput &input, const StagedTensor &staged_tensor) {
+                                   return input.first == staged_tensor.name &&
+                                          input.second.data_len_ == staged_tensor.buffer.size();
+                                 });
+  if (same_tensors) {
+    return false;
+  }
+
+  staged_tensors_.clear();
+  staged_tensors_.resize(inputs.size());
+  std::vector<std::string> names;
+  std::vector<size_t> sizes;
+  for (size_t tensor_index = 0; tensor_index < inputs.size(); ++tensor_index) {
+    const auto &input = inputs[tensor_index];
+    auto &staged_tensor = staged_tensors_[tensor_index];
+    staged_tensor.name = input.first;
+    staged_tensor.buffer.resize(input.second.data_len_);
+    FileIOUtils::CreateDir(file_path_ + "/" + kTensorDirPrefix + std::to_string(tensor_index));
+
+    size_t block_num = (input.second.data_len_ + max_block_length_ - 1) / max_block_length_;
+    staged_tensor.dirty.assign(block_num, 0);
+    staged_tensor.versions.assign(block_num, 0);
+    (void)names.emplace_back(input.first);
+    (void)sizes.emplace_back(input.second.data_len_);
+  }
+
+  checkpoint_meta_->Insert(kTensorNames, names);
+  checkpoint_meta_->Insert(kTensorSizes, sizes);
+  checkpoint_meta_->Insert(kMaxBlockLength, max_block_length_);
+  return true;
+}
+
+void CheckpointWriter::StageBlock(size_t tensor_index, size_t block_index, const void *data, bool force) {
+  auto &staged_tensor = staged_tensors_[tensor_index];
+  size_t offset = block_index * max_block_length_;
+  size_t length = std::min(max_block_length_, staged_tensor.buffer.size() - offset);
+  const void *src = reinterpret_cast<const uint8_t *>(data) + offset;
+  void *dst = staged_tensor.buffer.data() + offset;
+  // The staging buffer keeps the data of the last save, so only the changed blocks are copied and written.
+  if (!force && memcmp(dst, src, length) == 0) {
+    staged_tensor.dirty[block_index] = 0;
+    return;
+  }
+  (void)memcpy(dst, src, length);
+  staged_tensor.dirty[block_index] = 1;
+}
+
+void CheckpointWriter::WriteDirtyBlocks(int64_t step) {
+  std::vector<std::pair<size_t, size_t>> dirty_blocks;
+  for (size_t tensor_index = 0; tensor_index < staged_tensors_.size(); ++tensor_index) {
+    const auto &dirty = staged_tensors_[tensor_index].dirty;
+    for (size_t block_index = 0; block_index < dirty.size(); ++block_index) {
+      if (dirty[block_index] != 0) {
+        (void)dirty_blocks.emplace_back(tensor_index, block_index);
+      }
+    }
+  }
+
+  // The dirty blocks are written to the files of a new version, the committed checkpoint is untouched until the
+  // checkpoint meta is replaced.
+  size_t version = ++version_;
+  std::atomic<size_t> next_block(0);
+  std::atomic<bool> success(true);
+  auto write_func = [this, &dirty_blocks, &next_block, &success, version]() {
+    for (size_t i = next_block++; i < dirty_blocks.size(); i = next_block++) {
+      if (!WriteBlock(dirty_blocks[i].first, dirty_blocks[i].second, version)) {
+        success = false;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < std::min(thread_num_, dirty_blocks.size()); ++i) {
+    (void)threads.emplace_back(write_func);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  write_success_ = success.load() && CommitCheckpointMeta(step, version);
+  if (!write_success_) {
+    // The files of the failed save are never referred to by the checkpoint meta.
+    for (const auto &block : dirty_blocks) {
+      RemoveBlock(block.first, block.second, version);
+    }
+    MS_LOG(ERROR) << "Save the checkpoint of step " << step << " failed.";
+    return;
+  }
+  MS_LOG(INFO) << "Save the checkpoint of step " << step << " successfully, the number of the written blocks is "
+               << dirty_blocks.size();
+}
+
+bool CheckpointWriter::WriteBlock(size_t tensor_index, size_t block_index, size_t version) {
+  const auto &staged_tensor = staged_tensors_[tensor_index];
+  size_t offset = block_index * max_block_length_;
+  size_t length = std::min(max_block_length_, staged_tensor.buffer.size() - offset);
+  Block block(BlockFileName(tensor_index, block_index, version));
+  std::string block_meta_file_name = BlockMetaFileName(tensor_index, block_index, version);
+  try {
+    if (!FileIOUtils::Write(block.block_file_name(), {{staged_tensor.buffer.data() + offset, length}})) {
+      MS_LOG(ERROR) << "Write to block file[" << block.block_file_name() << "] failed.";
+      return false;
+    }
+    ChangeFileMode(block.block_file_name(), S_IRUSR | S_IWUSR);
+
+    // The block meta left by a crashed save of the same version is discarded.
+    (void)std::remove(block_meta_file_name.c_str());
+    auto block_meta_ptr = std::make_shared<BlockMeta>(block_meta_file_name);
+    if (!block_meta_ptr->Initialize()) {
+      MS_LOG(ERROR) << "Initialize block meta failed, file name [" << block_meta_file_name << "]";
+      return false;
+    }
+    block_meta_ptr->Insert(kOffset, offset);
+    block_meta_ptr->Insert(kFieldsLength, length);
+    block.set_block_meta(block_meta_ptr);
+    block.GenSha256Seq();
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "Write to block file[" << block.block_file_name() << "] failed: " << e.what();
+    return false;
+  }
+  return true;
+}
+
+bool CheckpointWriter::CommitCheckpointMeta(int64_t step, size_t version) {
+  std::vector<std::vector<size_t>> versions;
+  for (const auto &staged_tensor : staged_tensors_) {
+    auto &block_versions = versions.emplace_back(staged_tensor.versions);
+    for (size_t block_index = 0; block_index < block_versions.size(); ++block_index) {
+      if (staged_tensor.dirty[block_index] != 0) {
+        block_versions[block_index] = version;
+      }
+    }
+  }
+  checkpoint_meta_->Insert(kBlockVersions, versions);
+  checkpoint_meta_->Insert(kCheckpointVersion, version);
+  checkpoint_meta_->Insert(kCheckpointStep, step);
+  checkpoint_meta_->Insert(kCheckpointComplete, true);
+
+  // The rename is atomic, so the checkpoint meta is either the last one or the new one whatever happens.
+  std::string meta_file_name = file_path_ + "/" + kCheckpointMetaFileName;
+  std::string tmp_meta_file_name = meta_file_name + kTmpFileSuffix;
+  if (std::rename(tmp_meta_file_name.c_str(), meta_file_name.c_str()) != 0) {
+    MS_LOG(ERROR) << "Rename the checkpoint meta file [" << tmp_meta_file_name << "] to [" << meta_file_name
+                  << "] failed, errno: " << errno;
+    return false;
+  }
+
+  for (size_t tensor_index = 0; tensor_index < committed_versions_.size(); ++tensor_index) {
+    const auto &old_versions = committed_versions_[tensor_index];
+    for (size_t block_index = 0; block_index < old_versions.size(); ++block_index) {
+      size_t old_version = old_versions[block_index];
+      bool superseded = tensor_index >= versions.size() || block_index >= versions[tensor_index].size() ||
+                        versions[tensor_index][block_index] != old_version;
+      if (old_version != 0 && superseded) {
+        RemoveBlock(tensor_index, block_index, old_version);
+      }
+    }
+  }
+  for (size_t tensor_index = 0; tensor_index < staged_tensors_.size(); ++tensor_index) {
+    staged_tensors_[tensor_index].versions = versions[tensor_index];
+  }
+  committed_versions_ = std::move(versions);
+  return true;
+}
+
+void CheckpointWriter::RemoveBlock(size_t tensor_index, size_t block_index, size_t version) const {
+  for (const auto &file_name :
+       {BlockFileName(tensor_index, block_index, version), BlockMetaFileName(tensor_index, block_index, version)}) {
+    if (FileIOUtils::IsFileOrDirExist(file_name) && std::remove(file_name.c_str()) != 0) {
+      MS_LOG(WARNING) << "Remove the block file [" << file_name << "] failed, errno: " << errno;
+    }
+  }
+}
+
+std::string CheckpointWriter::BlockFileName(size_t tensor_index, size_t block_index, size_t version) const {
+  return file_path_ + "/" + kTensorDirPrefix + std::to_string(tensor_index) + "/" + kBlockFilePrefix +
+         std::to_string(block_index) + kBlockVersionPrefix + std::to_string(version);
+}
+
+std::string CheckpointWriter::BlockMetaFileName(size_t tensor_index, size_t block_index, size_t version) const {
+  return file_path_ + "/" + kTensorDirPrefix + std::to_string(tensor_index) + "/" + kBlockMetaFilePrefix +
+         std::to_string(block_index) + kBlockVersionPrefix + std::to_string(version) + kJsonSuffix;
+}
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
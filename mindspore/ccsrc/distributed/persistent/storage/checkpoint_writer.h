@@ -0,0 +1,135 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_CHECKPOINT_WRITER_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_CHECKPOINT_WRITER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <utility>
+
+#include "distributed/persistent/storage/storage.h"
+#include "distributed/persistent/storage/block.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+// The default maximum block length of the checkpoint: 16MB.
+constexpr size_t kDefaultCheckpointBlockLength = 16 << 20;
+// The default number of the threads writing the block files in parallel.
+constexpr size_t kDefaultCheckpointWriterThreadNum = 4;
+
+// The tensor to save or load with its name, the name is used to match the tensor when loading.
+using CheckpointInput = std::pair<std::string, ConstDataWithLen>;
+using CheckpointOutput = std::pair<std::string, DataWithLen>;
+
+// CheckpointWriter saves the tensors to the block files in the background so that the training is blocked only by
+// copying the tensors to the host staging buffer. The directory 'file_storage_path' is composed of:
+// 1. 'tensor_<i>/block_<j>_v<k>' and 'tensor_<i>/block_meta_<j>_v<k>.json': the block j of the tensor i written by
+// the save of version k, and its offset, length and sha256.
+// 2. 'checkpoint_meta.json': the step, the names and sizes of the tensors, and the version of every block.
+// Only the blocks changed since the last save are copied and written for the incremental checkpoint. They are written
+// to the files of a new version instead of in place, and 'checkpoint_meta.json' is replaced by renaming a temporary
+// file after all of them are written, so a crash during saving always leaves the last checkpoint loadable. The files
+// of the old versions are removed after the replacement.
+class CheckpointWriter {
+ public:
+  explicit CheckpointWriter(const std::map<std::string, std::string> &storage_config);
+  ~CheckpointWriter();
+
+  // Create the storage directory.
+  void Initialize();
+
+  // Wait for the background writing and release the staging buffer.
+  void Finalize();
+
+  // Copy the blocks of the tensors changed since the last save to the staging buffer, then write them to the block
+  // files in the background and return immediately. All the blocks are copied and written if 'incremental' is false
+  // or the tensors are different from the last save. It waits for the last writing to finish at first.
+  // Return the number of the blocks to write.
+  size_t Save(int64_t step, const std::vector<CheckpointInput> &inputs, bool incremental = true);
+
+  // Wait for the background writing to finish, return whether all the blocks are written successfully.
+  bool Wait();
+
+  // Read the checkpoint in 'file_storage_path' into the outputs by the tensor names after checking sha256 of every
+  // block, and get the step of the checkpoint. Return false if the checkpoint is incomplete or tampered.
+  bool Load(const std::vector<CheckpointOutput> &outputs, int64_t *step);
+
+ private:
+  // The host staging copy of a tensor and its block files.
+  struct StagedTensor {
+    std::string name;
+    std::vector<uint8_t> buffer;
+    // Whether each block is changed, which is set by multiple threads so it's not std::vector<bool>.
+    std::vector<uint8_t> dirty;
+    // The version of the block files written successfully, 0 if the block is never written.
+    std::vector<size_t> versions;
+  };
+
+  // Build the staged tensors and their blocks for the inputs of the different names or sizes from the last save.
+  bool ResetStagedTensors(const std::vector<CheckpointInput> &inputs);
+
+  // Copy one block of the input to the staging buffer if it's changed or 'force' is true.
+  void StageBlock(size_t tensor_index, size_t block_index, const void *data, bool force);
+
+  // Write the dirty blocks to the files of a new version with the writer threads, then commit the checkpoint meta.
+  void WriteDirtyBlocks(int64_t step);
+
+  // Write one block and its meta to the files of the version.
+  bool WriteBlock(size_t tensor_index, size_t block_index, size_t version);
+
+  // Replace the checkpoint meta with the temporary one atomically, then remove the block files of the old versions.
+  bool CommitCheckpointMeta(int64_t step, size_t version);
+
+  // Remove the files of the block of the version.
+  void RemoveBlock(size_t tensor_index, size_t block_index, size_t version) const;
+
+  std::string BlockFileName(size_t tensor_index, size_t block_index, size_t version) const;
+  std::string BlockMetaFileName(size_t tensor_index, size_t block_index, size_t version) const;
+
+  // Folder path to save the checkpoint.
+  std::string file_path_;
+
+  // Maximum size of each block file.
+  size_t max_block_length_;
+
+  // The number of the threads writing the block files.
+  size_t thread_num_;
+
+  std::vector<StagedTensor> staged_tensors_;
+
+  // The temporary meta of the whole checkpoint, which replaces 'checkpoint_meta.json' when the save is committed.
+  std::shared_ptr<BlockMeta> checkpoint_meta_;
+
+  // The version of the last save, every save writes the dirty blocks to the files of a new version.
+  size_t version_{0};
+
+  // The block versions of the committed checkpoint, whose files are removed once they are superseded.
+  std::vector<std::vector<size_t>> committed_versions_;
+
+  // The thread writing the dirty blocks of the last save and whether it succeeds.
+  std::thread write_thread_;
+  bool write_success_{true};
+};
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_CHECKPOINT_WRITER_H_
@@ -40,6 +40,19 @@ constexpr char kFileStoragePath[] = "file_storage_path";
 constexpr char kMaxBlockLength[] = "max_block_length";
 
 constexpr char kElementSize[] = "element_size";
+
+// Checkpoint related.
+constexpr char kWriterThreadNum[] = "writer_thread_num";
+constexpr char kCheckpointMetaFileName[] = "checkpoint_meta.json";
+constexpr char kTensorDirPrefix[] = "tensor_";
+constexpr char kCheckpointStep[] = "step";
+constexpr char kCheckpointComplete[] = "complete";
+constexpr char kTensorNames[] = "tensor_names";
+constexpr char kTensorSizes[] = "tensor_sizes";
+constexpr char kCheckpointVersion[] = "version";
+constexpr char kBlockVersions[] = "block_versions";
+constexpr char kBlockVersionPrefix[] = "_v";
+constexpr char kTmpFileSuffix[] = ".tmp";
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
@@ -17,7 +17,9 @@
 #include "distributed/rpc/tcp/connection.h"
 
 #include <memory>
+#include <numeric>
 #include <utility>
+#include <vector>
 
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
 #include "distributed/rpc/tcp/ssl_socket_operation.h"
@@ -153,7 +155,8 @@ Connection::Connection()
   recv_kernel_msg.msg_flags = 0;
   recv_kernel_msg.msg_name = nullptr;
   recv_kernel_msg.msg_namelen = 0;
-  recv_kernel_msg.msg_iov = recv_io_vec;
+  recv_io_vec.resize(RECV_MSG_IO_VEC_LEN);
+  recv_kernel_msg.msg_iov = recv_io_vec.data();
   recv_kernel_msg.msg_iovlen = RECV_MSG_IO_VEC_LEN;
 
   // Initialize the send message header.
@@ -173,7 +176,8 @@ Connection::Connection()
   send_kernel_msg.msg_flags = 0;
   send_kernel_msg.msg_name = nullptr;
   send_kernel_msg.msg_namelen = 0;
-  send_kernel_msg.msg_iov = send_io_vec;
+  send_io_vec.resize(SEND_MSG_IO_VEC_LEN);
+  send_kernel_msg.msg_iov = send_io_vec.data();
   send_kernel_msg.msg_iovlen = SEND_MSG_IO_VEC_LEN;
 }
 
@@ -281,6 +285,10 @@ int Connection::ReceiveMessage() {
     return 0;
   }
 
+  if (recv_event_loop != nullptr) {
+    recv_event_loop->metrics()->RecordRecv(GetMessageBaseRealDataSize(recv_message));
+  }
+
   // Call msg handler if set
   if (message_handler) {
     auto result = message_handler(recv_message);
@@ -359,8 +367,10 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
     return;
   }
   if (msg->type == MessageBase::Type::KMSG) {
-    // The total len of array variable `send_io_vec` is `SEND_MSG_IO_VEC_LEN` whose value is 5 currently.
+    // The len of `send_io_vec` is `SEND_MSG_IO_VEC_LEN` whose value is 5 currently, unless the body of the
+    // ScatterMessage takes more than one iovec.
     size_t index = 0;
+    send_io_vec.resize(SEND_MSG_IO_VEC_LEN);
     if (!isHttpKmsg) {
       send_to = msg->to;
       send_from = msg->from;
@@ -378,12 +388,23 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       send_io_vec[index].iov_base = const_cast<char *>(send_from.data());
       send_io_vec[index].iov_len = send_from.size();
       ++index;
-      send_io_vec[index].iov_base = GetMessageBaseRealData(msg);
       // The real size of the data body.
       size_t real_data_size = GetMessageBaseRealDataSize(msg);
-      send_io_vec[index].iov_len = real_data_size;
-      ++index;
-      send_kernel_msg.msg_iov = send_io_vec;
+      auto scatter_msg = dynamic_cast<ScatterMessage *>(msg);
+      if (scatter_msg != nullptr && !scatter_msg->segments.empty()) {
+        // The segments are sent in order as one body, so the peer can't tell it from the body in one piece of memory.
+        send_io_vec.resize(index + scatter_msg->segments.size());
+        for (const auto &segment : scatter_msg->segments) {
+          send_io_vec[index].iov_base = segment.first;
+          send_io_vec[index].iov_len = segment.second;
+          ++index;
+        }
+      } else {
+        send_io_vec[index].iov_base = GetMessageBaseRealData(msg);
+        send_io_vec[index].iov_len = real_data_size;
+        ++index;
+      }
+      send_kernel_msg.msg_iov = send_io_vec.data();
       send_kernel_msg.msg_iovlen = index;
       total_send_len =
         UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + real_data_size;
@@ -409,7 +430,7 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
     size_t real_data_size = GetMessageBaseRealDataSize(msg);
     send_io_vec[index].iov_len = real_data_size;
     ++index;
-    send_kernel_msg.msg_iov = send_io_vec;
+    send_kernel_msg.msg_iov = send_io_vec.data();
     send_kernel_msg.msg_iovlen = index;
     total_send_len = UlongToUint(real_data_size);
     send_message = msg;
@@ -432,18 +453,31 @@ void Connection::FillRecvMessage() {
     return;
   }
 
-  // The total len of array variable `recv_io_vec` is `RECV_MSG_IO_VEC_LEN` whose value is 4 currently.
-  int i = 0;
+  // The len of `recv_io_vec` is `RECV_MSG_IO_VEC_LEN` whose value is 4 currently, unless the body is received into
+  // more than one memory segment.
+  size_t i = 0;
+  recv_io_vec.resize(RECV_MSG_IO_VEC_LEN);
+
+  // Try receiving the body into the memory segments given by the receiver first, which saves copying it afterwards.
+  std::vector<MemSegment> segments;
+  bool scatter = scatter_cb_ && scatter_cb_(recvBodyLen, &segments) && !segments.empty() &&
+                 segments.size() <= kMaxMemSegmentNum &&
+                 std::accumulate(segments.begin(), segments.end(), size_t(0),
+                                 [](size_t size, const MemSegment &segment) { return size + segment.second; }) ==
+                   recvBodyLen;
 
   // This new message will be assigned to `recv_message` later.
-  MessageBase *msg = new (std::nothrow) MessageBase();
+  MessageBase *msg = scatter ? new (std::nothrow) ScatterMessage() : new (std::nothrow) MessageBase();
   MS_EXCEPTION_IF_NULL(msg);
 
   msg->name.resize(recvNameLen);
   recv_to.resize(recvToLen);
   recv_from.resize(recvFromLen);
 
-  if (allocate_cb_) {
+  if (scatter) {
+    msg->data = segments[0].first;
+    msg->size = recvBodyLen;
+  } else if (allocate_cb_) {
     void *allocated_mem = allocate_cb_(recvBodyLen);
     msg->data = allocated_mem;
     msg->size = recvBodyLen;
@@ -460,14 +494,24 @@ void Connection::FillRecvMessage() {
   recv_io_vec[i].iov_base = const_cast<char *>(recv_from.data());
   recv_io_vec[i].iov_len = recv_from.size();
   ++i;
-  recv_io_vec[i].iov_base = GetMessageBaseRealData(msg);
   // The real size of the data body.
   size_t real_data_size = GetMessageBaseRealDataSize(msg);
-  recv_io_vec[i].iov_len = real_data_size;
-  ++i;
+  if (scatter) {
+    recv_io_vec.resize(i + segments.size());
+    for (const auto &segment : segments) {
+      recv_io_vec[i].iov_base = segment.first;
+      recv_io_vec[i].iov_len = segment.second;
+      ++i;
+    }
+    static_cast<ScatterMessage *>(msg)->segments = std::move(segments);
+  } else {
+    recv_io_vec[i].iov_base = GetMessageBaseRealData(msg);
+    recv_io_vec[i].iov_len = real_data_size;
+    ++i;
+  }
 
-  recv_kernel_msg.msg_iov = recv_io_vec;
-  recv_kernel_msg.msg_iovlen = IntToSize(i);
+  recv_kernel_msg.msg_iov = recv_io_vec.data();
+  recv_kernel_msg.msg_iovlen = i;
   total_recv_len = msg->name.size() + recv_to.size() + recv_from.size() + real_data_size;
 
   // There is no need to delete recv_message first because the recv_message has already been returned to the caller and
@@ -19,6 +19,7 @@
 
 #include <queue>
 #include <string>
+#include <vector>
 #include <mutex>
 #include <memory>
 
@@ -40,6 +41,9 @@ struct SendMetrics {
     if (size > max_msg_size) {
       max_msg_size = size;
     }
+    if (loop_metrics != nullptr) {
+      loop_metrics->RecordSend(size);
+    }
   }
 
   // Records the latest error message.
@@ -62,7 +66,7 @@ struct SendMetrics {
     last_send_msg_name = "";
   }
 
-  // The total number of bytes sent already.
+  // The total number of messages sent already.
   size_t accum_msg_count{0};
 
   // The max message body size sent in bytes.
@@ -72,6 +76,9 @@ struct SendMetrics {
   std::string last_succ_msg_name;
   std::string last_fail_msg_name;
   std::string last_send_msg_name;
+
+  // The metrics of the send event loop of the connection, which are not reset with the connection.
+  LoopMetrics *loop_metrics{nullptr};
 };
 
 /*
@@ -119,6 +126,13 @@ struct Connection {
    */
   void SetAllocateCallback(const MemAllocateCallback &allocate_cb) { allocate_cb_ = allocate_cb; }
 
+  /**
+   * @description: Set callback to receive the message into the existing memory segments for this connection.
+   * @param {MemScatterCallback} &scatter_cb: The callback which returns the segments the message body is received to.
+   * @return {void}
+   */
+  void SetScatterCallback(const MemScatterCallback &scatter_cb) { scatter_cb_ = scatter_cb; }
+
   /**
    * @description: Set callback to free message for this connection.
    * @param {MemFreeCallback} &free_cb: The callback which frees the real memory after message is sent to peer.
@@ -207,8 +221,9 @@ struct Connection {
   struct msghdr send_kernel_msg;
   struct msghdr recv_kernel_msg;
 
-  struct iovec recv_io_vec[RECV_MSG_IO_VEC_LEN];
-  struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN];
+  // The body of the ScatterMessage takes one iovec for each memory segment, so the lengths are variable.
+  std::vector<struct iovec> recv_io_vec;
+  std::vector<struct iovec> send_io_vec;
 
   ParseType recv_message_type{kTcpMsg};
 
@@ -232,6 +247,9 @@ struct Connection {
   // The method used to allocate memory when server receiving message from the remote.
   MemAllocateCallback allocate_cb_;
 
+  // The method used to receive the message into the existing memory, which is tried before allocate_cb_.
+  MemScatterCallback scatter_cb_;
+
   // The method used to free the memory after client sending data to the remote.
   MemFreeCallback free_cb_;
 
@@ -124,6 +124,7 @@ void ConnectionPool::DeleteConnInfo(Connection *conn) {
   if (conn == nullptr) {
     return;
   }
+  std::lock_guard<std::mutex> lock(conn_infos_mutex_);
   int fd = conn->socket_fd;
   // If run in double link pattern, link fd and send fd must be the same, send Exit message bind on this fd
   if (double_link_) {
@@ -143,6 +144,7 @@ void ConnectionPool::DeleteConnInfo(Connection *conn) {
 }
 
 void ConnectionPool::DeleteAllConnInfos() {
+  std::lock_guard<std::mutex> lock(conn_infos_mutex_);
   auto iter = conn_infos_.begin();
   while (iter != conn_infos_.end()) {
     auto conn_infos = iter->second;
@@ -179,6 +181,7 @@ ConnectionInfo *ConnectionPool::FindConnInfo(int fd, const std::string &dst_url)
 }
 
 void ConnectionPool::AddConnInfo(int fd, const std::string &dst_url, DeleteCallBack callback) {
+  std::lock_guard<std::mutex> lock(conn_infos_mutex_);
   ConnectionInfo *linker = FindConnInfo(fd, dst_url);
   if (linker != nullptr) {
     return;
@@ -197,6 +200,7 @@ void ConnectionPool::AddConnInfo(int fd, const std::string &dst_url, DeleteCallB
 }
 
 bool ConnectionPool::ReverseConnInfo(int fromFd, int toFd) {
+  std::lock_guard<std::mutex> lock(conn_infos_mutex_);
   auto iter = conn_infos_.find(fromFd);
   if (iter == conn_infos_.end()) {
     return false;
@@ -96,6 +96,9 @@ class ConnectionPool {
   // This mutex is used for protecting the modification of connections.
   std::mutex mutex_;
 
+  // The connections on different event loops add and delete the connection infos concurrently.
+  std::mutex conn_infos_mutex_;
+
   friend class TCPComm;
 };
 }  // namespace rpc
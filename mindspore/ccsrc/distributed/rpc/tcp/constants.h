@@ -75,6 +75,17 @@ static const int SOCKET_KEEPCOUNT = 3;
 static const char RPC_MAGICID[] = "RPC0";
 static const char TCP_RECV_EVLOOP_THREADNAME[] = "RECV_EVENT_LOOP";
 static const char TCP_SEND_EVLOOP_THREADNAME[] = "SEND_EVENT_LOOP";
+// The name prefixes of the event loops other than the first one, the names are limited to 15 characters.
+static const char TCP_RECV_EVLOOP_THREADNAME_PREFIX[] = "RECV_EVLOOP_";
+static const char TCP_SEND_EVLOOP_THREADNAME_PREFIX[] = "SEND_EVLOOP_";
+
+// The number of the recv and send event loop pairs of one TCPComm. The connections are spread over the pairs by their
+// remote addresses, the default is one pair for all the connections.
+constexpr char kEnvRpcEventLoopNum[] = "MS_RPC_EVENT_LOOP_NUM";
+constexpr size_t kMaxRpcEventLoopNum = 64;
+// The cpu cores to pin the event loop threads to, e.g. "0,1,2,3". The threads take the cores in turn, recv loop before
+// send loop of each pair. The threads are not pinned if it's not set.
+constexpr char kEnvRpcEventLoopCores[] = "MS_RPC_EVENT_LOOP_CORES";
 
 constexpr int RPC_OK = 0;
 constexpr int RPC_ERROR = -1;
@@ -21,6 +21,7 @@
 #include <netinet/tcp.h>
 #include <sys/eventfd.h>
 #include <sys/socket.h>
+#include <sched.h>
 #include <securec.h>
 #include <unistd.h>
 #include <utility>
@@ -35,6 +36,53 @@
 namespace mindspore {
 namespace distributed {
 namespace rpc {
+namespace {
+// The max number of tasks executed in one wakeup, so that the socket events are not starved by a burst of tasks.
+constexpr size_t kMaxTaskNumPerWakeup = 256;
+
+void WakeUp(int event_fd) {
+  uint64_t one = 1;
+  ssize_t retval = write(event_fd, &one, sizeof(one));
+  if (retval <= 0 || retval != sizeof(one)) {
+    MS_LOG(WARNING) << "Failed to write queue Event fd: " << event_fd << ",errno:" << errno;
+  }
+}
+}  // namespace
+
+TaskQueue::TaskQueue() : head_(new Node()), tail_(head_.load()) {}
+
+TaskQueue::~TaskQueue() {
+  while (tail_ != nullptr) {
+    auto next = tail_->next.load(std::memory_order_relaxed);
+    delete tail_;
+    tail_ = next;
+  }
+}
+
+size_t TaskQueue::Push(std::function<void()> &&task) {
+  // Count the task before linking it, so the size never falls below zero when the consumer pops it at once.
+  auto result = size_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  auto node = new Node();
+  node->task = std::move(task);
+  auto prev = head_.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node, std::memory_order_release);
+  return result;
+}
+
+bool TaskQueue::Pop(std::function<void()> *task) {
+  auto next = tail_->next.load(std::memory_order_acquire);
+  if (next == nullptr) {
+    return false;
+  }
+  // The popped node becomes the new stub.
+  *task = std::move(next->task);
+  next->task = nullptr;
+  delete tail_;
+  tail_ = next;
+  (void)size_.fetch_sub(1, std::memory_order_acq_rel);
+  return true;
+}
+
 int EventLoopRun(EventLoop *evloop, int timeout) {
   if (evloop == nullptr) {
     return RPC_ERROR;
@@ -103,17 +151,19 @@ void QueueReadyCallback(int fd, uint32_t events, void *arg) {
   uint64_t count;
   ssize_t retval = read(evloop->task_queue_event_fd_, &count, sizeof(count));
   if (retval > 0 && retval == sizeof(count)) {
-    // take out functions from the queue
-    std::queue<std::function<void()>> q;
-
-    evloop->task_queue_mutex_.lock();
-    evloop->task_queue_.swap(q);
-    evloop->task_queue_mutex_.unlock();
+    // take out functions from the queue and invoke them
+    std::function<void()> task;
+    size_t task_num = 0;
+    while (task_num < kMaxTaskNumPerWakeup && evloop->task_queue_.Pop(&task)) {
+      task();
+      ++task_num;
+    }
+    (void)evloop->metrics_.task_count.fetch_add(task_num, std::memory_order_relaxed);
 
-    // invoke functions in the queue
-    while (!q.empty()) {
-      q.front()();
-      q.pop();
+    // The tasks left or being added wake the loop up again, the adding thread doesn't wake it if the queue is not
+    // empty when adding.
+    if (evloop->task_queue_.size() > 0) {
+      WakeUp(evloop->task_queue_event_fd_);
     }
   }
 }
@@ -134,33 +184,18 @@ void EventLoop::ReleaseResource() {
 }
 
 size_t EventLoop::AddTask(std::function<int()> &&task) {
-  // put func to the queue
-  task_queue_mutex_.lock();
-  (void)task_queue_.emplace(std::move(task));
-
-  // return the queue size to send's caller.
-  auto result = task_queue_.size();
-  task_queue_mutex_.unlock();
-
+  // put func to the queue and return the queue size to send's caller.
+  auto result = task_queue_.Push(std::move(task));
   if (result == 1) {
     // wakeup event loop
-    uint64_t one = 1;
-    ssize_t retval = write(task_queue_event_fd_, &one, sizeof(one));
-    if (retval <= 0 || retval != sizeof(one)) {
-      MS_LOG(WARNING) << "Failed to write queue Event fd: " << task_queue_event_fd_ << ",errno:" << errno;
-    }
+    WakeUp(task_queue_event_fd_);
   }
   return result;
 }
 
-size_t EventLoop::RemainingTaskNum() {
-  task_queue_mutex_.lock();
-  auto task_num = task_queue_.size();
-  task_queue_mutex_.unlock();
-  return task_num;
-}
+size_t EventLoop::RemainingTaskNum() { return task_queue_.size(); }
 
-bool EventLoop::Initialize(const std::string &threadName) {
+bool EventLoop::Initialize(const std::string &threadName, int cpu_core) {
   int retval = InitResource();
   if (retval != RPC_OK) {
     return false;
@@ -175,12 +210,21 @@ bool EventLoop::Initialize(const std::string &threadName) {
 
   // wait EvloopRun
   (void)sem_wait(&sem_id_);
-#if __GLIBC__ >= 2 && __GLIBC_MINOR__ >= 12
-  std::string name = threadName;
-
-  if (name.empty()) {
-    name = "EventLoopThread";
+  name_ = threadName.empty() ? "EventLoopThread" : threadName;
+  if (cpu_core >= 0) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_core, &cpu_set);
+    retval = pthread_setaffinity_np(loop_thread_, sizeof(cpu_set), &cpu_set);
+    if (retval != 0) {
+      MS_LOG(WARNING) << "Failed to pin the event loop " << name_ << " to the cpu core " << cpu_core
+                      << ", retval: " << retval;
+    } else {
+      MS_LOG(INFO) << "Pin the event loop " << name_ << " to the cpu core " << cpu_core;
+    }
   }
+#if __GLIBC__ >= 2 && __GLIBC_MINOR__ >= 12
+  const std::string &name = name_;
   retval = pthread_setname_np(loop_thread_, name.c_str());
   if (retval != 0) {
     MS_LOG(INFO) << "Set pthread name fail name:" << name.c_str() << ",retval:" << retval;
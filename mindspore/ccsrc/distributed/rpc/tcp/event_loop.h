@@ -20,10 +20,10 @@
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
 #include <semaphore.h>
+#include <atomic>
 #include <functional>
 #include <list>
 #include <mutex>
-#include <queue>
 #include <map>
 #include <string>
 
@@ -51,6 +51,58 @@ typedef struct {
   EventHandler handler;
 } Event;
 
+/*
+ * The lock-free queue of tasks, which are added by multiple threads and executed by the event loop thread only.
+ */
+class TaskQueue {
+ public:
+  TaskQueue();
+  TaskQueue(const TaskQueue &) = delete;
+  TaskQueue &operator=(const TaskQueue &) = delete;
+  ~TaskQueue();
+
+  // Add the task and return the queue size after adding, which is 1 if the queue was empty.
+  size_t Push(std::function<void()> &&task);
+
+  // Take out the earliest task, return false if the queue is empty or the task being added is not linked yet.
+  // Only the event loop thread calls this method.
+  bool Pop(std::function<void()> *task);
+
+  size_t size() const { return size_.load(std::memory_order_acquire); }
+
+ private:
+  struct Node {
+    std::function<void()> task;
+    std::atomic<Node *> next{nullptr};
+  };
+
+  // The producers link the new node after the head, the consumer pops the node after the tail which is a stub.
+  std::atomic<Node *> head_;
+  Node *tail_;
+  std::atomic<size_t> size_{0};
+};
+
+/*
+ * The metrics of the messages through the connections of one event loop. They are accumulated by the SendMetrics
+ * and the receiving of the connections, and may be read by other threads.
+ */
+struct LoopMetrics {
+  void RecordSend(size_t size) {
+    (void)send_msg_count.fetch_add(1, std::memory_order_relaxed);
+    (void)send_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+  void RecordRecv(size_t size) {
+    (void)recv_msg_count.fetch_add(1, std::memory_order_relaxed);
+    (void)recv_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  std::atomic<size_t> task_count{0};
+  std::atomic<size_t> send_msg_count{0};
+  std::atomic<size_t> send_bytes{0};
+  std::atomic<size_t> recv_msg_count{0};
+  std::atomic<size_t> recv_bytes{0};
+};
+
 /*
  * The class EventLoop monitors a certain file descriptor created by eventfd function call,
  * and triggers tasks when any event occurred on the file descriptor.
@@ -62,7 +114,8 @@ class EventLoop {
   EventLoop &operator=(const EventLoop &) = delete;
   ~EventLoop() = default;
 
-  bool Initialize(const std::string &threadName);
+  // The loop thread is pinned to the cpu core if it is not negative.
+  bool Initialize(const std::string &threadName, int cpu_core = -1);
   void Finalize();
 
   // Add task (eg. send message, reconnect etc.) to task queue of the event loop.
@@ -79,6 +132,9 @@ class EventLoop {
   int UpdateEpollEvent(int fd, uint32_t events);
   int DeleteEpollEvent(int fd);
 
+  LoopMetrics *metrics() { return &metrics_; }
+  const std::string &name() const { return name_; }
+
  private:
   void AddEvent(Event *event);
 
@@ -108,7 +164,6 @@ class EventLoop {
   bool is_stop_;
 
   sem_t sem_id_;
-  std::mutex task_queue_mutex_;
 
   // The loop thread.
   pthread_t loop_thread_;
@@ -118,7 +173,10 @@ class EventLoop {
 
   // Queue tasks like send message, reconnect, collect metrics, etc.
   // This tasks will be triggered by task_queue_event_fd_.
-  std::queue<std::function<void()>> task_queue_;
+  TaskQueue task_queue_;
+
+  std::string name_;
+  LoopMetrics metrics_;
 
   // Events on the socket.
   std::mutex event_lock_;
@@ -16,17 +16,59 @@
 
 #include "distributed/rpc/tcp/tcp_comm.h"
 
+#include <cstdlib>
 #include <mutex>
+#include <sstream>
 #include <utility>
 #include <memory>
 
 #include "actor/aid.h"
+#include "utils/ms_utils.h"
+#include "utils/convert_utils_base.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
 
 namespace mindspore {
 namespace distributed {
 namespace rpc {
+namespace {
+EventLoop *NewEventLoop(const std::string &name, int cpu_core) {
+  EventLoop *event_loop = new (std::nothrow) EventLoop();
+  if (event_loop == nullptr) {
+    MS_LOG(ERROR) << "Failed to create the event loop " << name;
+    return nullptr;
+  }
+  if (!event_loop->Initialize(name, cpu_core)) {
+    MS_LOG(ERROR) << "Failed to init the event loop " << name;
+    delete event_loop;
+    return nullptr;
+  }
+  return event_loop;
+}
+
+void LogEventLoopMetrics(EventLoop *event_loop) {
+  auto metrics = event_loop->metrics();
+  MS_LOG(INFO) << "The event loop " << event_loop->name() << " ran " << metrics->task_count << " tasks, sent "
+               << metrics->send_msg_count << " messages of " << metrics->send_bytes << " bytes and received "
+               << metrics->recv_msg_count << " messages of " << metrics->recv_bytes << " bytes.";
+}
+
+// Parse the non-negative integers separated by commas, return false if any of them is invalid.
+bool ParseEnvNumbers(const std::string &env_value, std::vector<int64_t> *numbers) {
+  std::stringstream stream(env_value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    char *end = nullptr;
+    auto number = std::strtoll(item.c_str(), &end, 10);
+    if (item.empty() || end != item.c_str() + item.size() || number < 0) {
+      return false;
+    }
+    numbers->push_back(number);
+  }
+  return true;
+}
+}  // namespace
+
 void DoDisconnect(int fd, Connection *conn, uint32_t error, int soError) {
   if (conn == nullptr) {
     return;
@@ -76,7 +118,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
   if (tcpmgr == nullptr || tcpmgr->conn_pool_ == nullptr) {
     return;
   }
-  if (tcpmgr->recv_event_loop_ == nullptr) {
+  if (tcpmgr->recv_event_loops_.empty()) {
     MS_LOG(ERROR) << "EventLoop is null, server fd: " << server << ", events: " << events;
     return;
   }
@@ -118,10 +160,8 @@ void OnAccept(int server, uint32_t events, void *arg) {
   conn->peer = conn->destination;
 
   conn->is_remote = true;
-  conn->recv_event_loop = tcpmgr->recv_event_loop_;
-  conn->send_event_loop = tcpmgr->send_event_loop_;
-
-  conn->conn_mutex = tcpmgr->conn_mutex_;
+  // Hand the connection off to the event loop pair of the remote address.
+  tcpmgr->BindEventLoops(conn, tcpmgr->EventLoopIndex(conn->destination));
   conn->message_handler = tcpmgr->message_handler_;
 
   conn->event_callback = std::bind(&TCPComm::EventCallBack, tcpmgr, std::placeholders::_1);
@@ -129,6 +169,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
   conn->read_callback = std::bind(&TCPComm::ReadCallBack, tcpmgr, std::placeholders::_1);
 
   conn->SetAllocateCallback(tcpmgr->allocate_cb());
+  conn->SetScatterCallback(tcpmgr->scatter_cb());
 
   int retval = conn->Initialize();
   if (retval != RPC_OK) {
@@ -143,6 +184,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
     conn = nullptr;
     return;
   }
+  std::lock_guard<std::mutex> lock(*conn->conn_mutex);
   tcpmgr->conn_pool_->AddConnection(conn);
 }
 
@@ -151,42 +193,93 @@ void TCPComm::SetMessageHandler(const MessageHandler &handler) { message_handler
 bool TCPComm::Initialize() {
   conn_pool_ = std::make_shared<ConnectionPool>();
   MS_EXCEPTION_IF_NULL(conn_pool_);
+  return CreateEventLoops();
+}
 
-  conn_mutex_ = std::make_shared<std::mutex>();
-  MS_EXCEPTION_IF_NULL(conn_mutex_);
-
-  recv_event_loop_ = new (std::nothrow) EventLoop();
-  if (recv_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create recv evLoop.";
-    return false;
+bool TCPComm::CreateEventLoops() {
+  size_t loop_num = 1;
+  auto loop_num_env = common::GetEnv(kEnvRpcEventLoopNum);
+  if (!loop_num_env.empty()) {
+    std::vector<int64_t> numbers;
+    if (!ParseEnvNumbers(loop_num_env, &numbers) || numbers.size() != 1 || numbers[0] == 0 ||
+        LongToSize(numbers[0]) > kMaxRpcEventLoopNum) {
+      MS_LOG(ERROR) << "The " << kEnvRpcEventLoopNum << " should be an integer in [1, " << kMaxRpcEventLoopNum
+                    << "], but got " << loop_num_env;
+      return false;
+    }
+    loop_num = LongToSize(numbers[0]);
   }
-
-  bool ok = recv_event_loop_->Initialize(TCP_RECV_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init recv evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
+  std::vector<int64_t> cores;
+  auto cores_env = common::GetEnv(kEnvRpcEventLoopCores);
+  if (!ParseEnvNumbers(cores_env, &cores)) {
+    MS_LOG(ERROR) << "The " << kEnvRpcEventLoopCores << " should be the cpu core ids separated by commas, but got "
+                  << cores_env;
     return false;
   }
 
-  send_event_loop_ = new (std::nothrow) EventLoop();
-  if (send_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create send evLoop.";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    return false;
+  for (size_t i = 0; i < loop_num; ++i) {
+    auto recv_name =
+      i == 0 ? std::string(TCP_RECV_EVLOOP_THREADNAME) : TCP_RECV_EVLOOP_THREADNAME_PREFIX + std::to_string(i);
+    auto send_name =
+      i == 0 ? std::string(TCP_SEND_EVLOOP_THREADNAME) : TCP_SEND_EVLOOP_THREADNAME_PREFIX + std::to_string(i);
+    // The recv loop takes the core before the send loop of the pair.
+    int recv_core = cores.empty() ? -1 : LongToInt(cores[(i + i) % cores.size()]);
+    int send_core = cores.empty() ? -1 : LongToInt(cores[(i + i + 1) % cores.size()]);
+
+    auto recv_event_loop = NewEventLoop(recv_name, recv_core);
+    if (recv_event_loop == nullptr) {
+      ReleaseEventLoops();
+      return false;
+    }
+    recv_event_loops_.push_back(recv_event_loop);
+    auto send_event_loop = NewEventLoop(send_name, send_core);
+    if (send_event_loop == nullptr) {
+      ReleaseEventLoops();
+      return false;
+    }
+    send_event_loops_.push_back(send_event_loop);
+    conn_mutexes_.push_back(std::make_shared<std::mutex>());
   }
-  ok = send_event_loop_->Initialize(TCP_SEND_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init send evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
-    return false;
+  MS_LOG(INFO) << "Create " << recv_event_loops_.size() << " pairs of recv and send event loops.";
+  return true;
+}
+
+void TCPComm::ReleaseEventLoops() {
+  for (auto &send_event_loop : send_event_loops_) {
+    MS_LOG(INFO) << "Delete send event loop " << send_event_loop->name();
+    send_event_loop->Finalize();
+    LogEventLoopMetrics(send_event_loop);
+    delete send_event_loop;
+    send_event_loop = nullptr;
+  }
+  send_event_loops_.clear();
+
+  for (auto &recv_event_loop : recv_event_loops_) {
+    MS_LOG(INFO) << "Delete recv event loop " << recv_event_loop->name();
+    recv_event_loop->Finalize();
+    LogEventLoopMetrics(recv_event_loop);
+    delete recv_event_loop;
+    recv_event_loop = nullptr;
+  }
+  recv_event_loops_.clear();
+  conn_mutexes_.clear();
+}
+
+size_t TCPComm::EventLoopIndex(const std::string &url) const {
+  if (recv_event_loops_.empty()) {
+    MS_LOG(EXCEPTION) << "The event loops are not created, please initialize the tcp comm first.";
   }
+  // The connection to the same url is always on the same event loop pair, so the messages to it keep the order.
+  return std::hash<std::string>()(url) % recv_event_loops_.size();
+}
 
-  return true;
+void TCPComm::BindEventLoops(Connection *conn, size_t index) {
+  conn->recv_event_loop = recv_event_loops_[index];
+  conn->send_event_loop = send_event_loops_[index];
+  conn->conn_mutex = conn_mutexes_[index];
+  if (conn->send_metrics != nullptr) {
+    conn->send_metrics->loop_metrics = conn->send_event_loop->metrics();
+  }
 }
 
 bool TCPComm::StartServerSocket(const std::string &url, const MemAllocateCallback &allocate_cb) {
@@ -206,7 +299,7 @@ bool TCPComm::StartServerSocket(const std::string &url, const MemAllocateCallbac
   }
 
   // Register read event callback for server socket
-  int retval = recv_event_loop_->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
+  int retval = recv_event_loops_.front()->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
                                                  reinterpret_cast<void *>(this));
   if (retval != RPC_OK) {
     MS_LOG(ERROR) << "Failed to add server event, url: " << url.c_str();
@@ -251,7 +344,8 @@ void TCPComm::EventCallBack(void *connection) {
     (void)conn->Flush();
     conn->conn_mutex->unlock();
   } else if (conn->state == ConnectionState::kDisconnecting) {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> lock(*conn_mutex);
     conn_pool_->DeleteConnection(conn->destination);
   }
 }
@@ -307,6 +401,9 @@ int TCPComm::DoConnect(Connection *conn, const struct sockaddr *sa, socklen_t sa
     if (conn->send_metrics == nullptr) {
       return RPC_ERROR;
     }
+    if (conn->send_event_loop != nullptr) {
+      conn->send_metrics->loop_metrics = conn->send_event_loop->metrics();
+    }
   }
 
   // Add the socket of this connection to epoll.
@@ -332,8 +429,9 @@ bool TCPComm::Send(MessageBase *msg, size_t *const send_bytes, bool sync) {
   if (msg == nullptr) {
     return false;
   }
-  auto task = [msg, send_bytes, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+  auto index = EventLoopIndex(msg->to.Url());
+  auto task = [msg, send_bytes, index, this] {
+    std::lock_guard<std::mutex> lock(*conn_mutexes_[index]);
     // Search connection by the target address
     std::string destination = msg->to.Url();
     Connection *conn = conn_pool_->FindConnection(destination);
@@ -380,7 +478,7 @@ bool TCPComm::Send(MessageBase *msg, size_t *const send_bytes, bool sync) {
   if (sync) {
     return task();
   } else {
-    send_event_loop_->AddTask(task);
+    send_event_loops_[index]->AddTask(task);
     return true;
   }
 }
@@ -397,13 +495,13 @@ bool TCPComm::Flush(const std::string &dst_url) {
 }
 
 bool TCPComm::Connect(const std::string &dst_url, const MemFreeCallback &free_cb) {
-  MS_EXCEPTION_IF_NULL(conn_mutex_);
   MS_EXCEPTION_IF_NULL(conn_pool_);
   if (!free_cb) {
     MS_LOG(EXCEPTION) << "The message callback is empty.";
   }
 
-  std::lock_guard<std::mutex> lock(*conn_mutex_);
+  auto index = EventLoopIndex(dst_url);
+  std::lock_guard<std::mutex> lock(*conn_mutexes_[index]);
 
   // Search connection by the target address
   Connection *conn = conn_pool_->FindConnection(dst_url);
@@ -416,9 +514,7 @@ bool TCPComm::Connect(const std::string &dst_url, const MemFreeCallback &free_cb
       return false;
     }
     conn->enable_ssl = enable_ssl_;
-    conn->recv_event_loop = this->recv_event_loop_;
-    conn->send_event_loop = this->send_event_loop_;
-    conn->conn_mutex = conn_mutex_;
+    BindEventLoops(conn, index);
     conn->message_handler = message_handler_;
     conn->InitSocketOperation();
 
@@ -481,23 +577,25 @@ bool TCPComm::IsConnected(const std::string &dst_url) {
 }
 
 bool TCPComm::Disconnect(const std::string &dst_url) {
-  MS_EXCEPTION_IF_NULL(conn_mutex_);
   MS_EXCEPTION_IF_NULL(conn_pool_);
-  MS_EXCEPTION_IF_NULL(recv_event_loop_);
-  MS_EXCEPTION_IF_NULL(send_event_loop_);
+  auto index = EventLoopIndex(dst_url);
+  auto recv_event_loop = recv_event_loops_[index];
+  auto send_event_loop = send_event_loops_[index];
+  MS_EXCEPTION_IF_NULL(recv_event_loop);
+  MS_EXCEPTION_IF_NULL(send_event_loop);
 
   unsigned int interval = 100000;
   size_t retry = 30;
-  while (recv_event_loop_->RemainingTaskNum() != 0 && send_event_loop_->RemainingTaskNum() != 0 && retry > 0) {
+  while (recv_event_loop->RemainingTaskNum() != 0 && send_event_loop->RemainingTaskNum() != 0 && retry > 0) {
     (void)usleep(interval);
     retry--;
   }
-  if (recv_event_loop_->RemainingTaskNum() > 0 || send_event_loop_->RemainingTaskNum() > 0) {
+  if (recv_event_loop->RemainingTaskNum() > 0 || send_event_loop->RemainingTaskNum() > 0) {
     MS_LOG(ERROR) << "Failed to disconnect from url " << dst_url
                   << ", because there are still pending tasks to be executed, please try later.";
     return false;
   }
-  std::lock_guard<std::mutex> lock(*conn_mutex_);
+  std::lock_guard<std::mutex> lock(*conn_mutexes_[index]);
   auto conn = conn_pool_->FindConnection(dst_url);
   if (conn != nullptr) {
     std::lock_guard<std::mutex> conn_lock(conn->conn_owned_mutex_);
@@ -515,28 +613,14 @@ Connection *TCPComm::CreateDefaultConn(const std::string &to) {
   conn->enable_ssl = enable_ssl_;
   conn->source = url_.data();
   conn->destination = to;
-  conn->recv_event_loop = this->recv_event_loop_;
-  conn->send_event_loop = this->send_event_loop_;
-  conn->conn_mutex = conn_mutex_;
+  BindEventLoops(conn, EventLoopIndex(to));
   conn->message_handler = message_handler_;
   conn->InitSocketOperation();
   return conn;
 }
 
 void TCPComm::Finalize() {
-  if (send_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete send event loop";
-    send_event_loop_->Finalize();
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
-  }
-
-  if (recv_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete recv event loop";
-    recv_event_loop_->Finalize();
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-  }
+  ReleaseEventLoops();
 
   if (server_fd_ > 0) {
     if (close(server_fd_) != 0) {
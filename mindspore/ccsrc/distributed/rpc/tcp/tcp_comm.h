@@ -20,6 +20,7 @@
 #include <string>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/connection.h"
@@ -38,13 +39,12 @@ void ConnectedEventHandler(int fd, uint32_t events, void *context);
 
 class TCPComm {
  public:
-  explicit TCPComm(bool enable_ssl = false)
-      : server_fd_(-1), recv_event_loop_(nullptr), send_event_loop_(nullptr), enable_ssl_(enable_ssl) {}
+  explicit TCPComm(bool enable_ssl = false) : server_fd_(-1), enable_ssl_(enable_ssl) {}
   TCPComm(const TCPComm &) = delete;
   TCPComm &operator=(const TCPComm &) = delete;
   ~TCPComm() = default;
 
-  // Init the event loop for reading and writing.
+  // Init the event loops for reading and writing.
   bool Initialize();
 
   // Destroy all the resources.
@@ -81,10 +81,24 @@ class TCPComm {
    */
   const MemAllocateCallback &allocate_cb() const { return allocate_cb_; }
 
+  // Set the method used to receive the message into the existing memory, it should be set before the remote connects.
+  void set_scatter_cb(const MemScatterCallback &scatter_cb) { scatter_cb_ = scatter_cb; }
+  const MemScatterCallback &scatter_cb() const { return scatter_cb_; }
+
  private:
   // Build the connection.
   Connection *CreateDefaultConn(const std::string &to);
 
+  // Create the pairs of recv and send event loops, the number is set by kEnvRpcEventLoopNum.
+  bool CreateEventLoops();
+  void ReleaseEventLoops();
+
+  // The index of the event loop pair of the connection to the remote url.
+  size_t EventLoopIndex(const std::string &url) const;
+
+  // Attach the connection to the event loop pair of the index and the mutex of the pair.
+  void BindEventLoops(Connection *conn, size_t index);
+
   // Send a message.
   static void SendExitMsg(const std::string &from, const std::string &to);
 
@@ -112,19 +126,23 @@ class TCPComm {
   // User defined handler for Handling received messages.
   MessageHandler message_handler_;
 
-  // All the connections share the same read and write event loop objects.
-  EventLoop *recv_event_loop_;
-  EventLoop *send_event_loop_;
+  // The connections are spread over the pairs of read and write event loops by their remote urls. The server socket
+  // is on the first recv event loop, which hands the accepted connections off to their own event loops.
+  std::vector<EventLoop *> recv_event_loops_;
+  std::vector<EventLoop *> send_event_loops_;
 
   // The connection pool used to store new connections.
   std::shared_ptr<ConnectionPool> conn_pool_;
 
-  // The mutex for connection operations.
-  std::shared_ptr<std::mutex> conn_mutex_;
+  // The mutexes for connection operations, one for the connections of each event loop pair.
+  std::vector<std::shared_ptr<std::mutex>> conn_mutexes_;
 
   // The method used to allocate memory when tcp servers of this TcpComm receive message from the remote.
   MemAllocateCallback allocate_cb_;
 
+  // The method used to receive the message into the existing memory, which is tried before allocate_cb_.
+  MemScatterCallback scatter_cb_;
+
   bool enable_ssl_;
 
   friend void OnAccept(int server, uint32_t events, void *arg);
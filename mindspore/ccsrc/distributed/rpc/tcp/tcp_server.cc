@@ -35,6 +35,11 @@ void TCPServer::Finalize() {
 
 void TCPServer::SetMessageHandler(const MessageHandler &handler, uint32_t) { tcp_comm_->SetMessageHandler(handler); }
 
+void TCPServer::SetScatterCallback(const MemScatterCallback &scatter_cb) {
+  MS_EXCEPTION_IF_NULL(tcp_comm_);
+  tcp_comm_->set_scatter_cb(scatter_cb);
+}
+
 std::string TCPServer::GetIP() const { return ip_; }
 
 uint32_t TCPServer::GetPort() const { return port_; }
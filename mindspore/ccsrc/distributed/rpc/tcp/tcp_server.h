@@ -45,6 +45,9 @@ class BACKEND_EXPORT TCPServer : public RPCServerBase {
   // Set the message processing handler.
   void SetMessageHandler(const MessageHandler &handler, uint32_t func_id = 0) override;
 
+  // Set the callback to receive the message into the existing memory segments, see MemScatterCallback.
+  void SetScatterCallback(const MemScatterCallback &scatter_cb);
+
   // Return the IP and port binded by this server.
   std::string GetIP() const override;
   uint32_t GetPort() const override;
@@ -0,0 +1,202 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "frontend/parallel/graph_util/pipeline_schedule.h"
+#include <algorithm>
+#include <map>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+constexpr size_t kTaskTypeNum = 2;
+
+const std::map<std::string, PipelineScheduleType> &ScheduleTypes() {
+  static const std::map<std::string, PipelineScheduleType> kScheduleTypes = {{"1f1b", PipelineScheduleType::k1F1B},
+                                                                             {"gpipe", PipelineScheduleType::kGPipe}};
+  return kScheduleTypes;
+}
+
+// Warm up with the forward tasks, which are needed by the next stages before the first backward task, and then run
+// one forward task and one backward task in turn.
+std::vector<PipelineTask> Generate1F1BSchedule(int64_t stage_num, int64_t stage_id, int64_t micro_num) {
+  auto warmup_num = std::min(stage_num - stage_id - 1, micro_num);
+  std::vector<PipelineTask> schedule;
+  int64_t forward_num = 0;
+  int64_t backward_num = 0;
+  for (; forward_num < warmup_num; ++forward_num) {
+    schedule.push_back({PipelineTaskType::kForward, forward_num});
+  }
+  for (; forward_num < micro_num; ++forward_num, ++backward_num) {
+    schedule.push_back({PipelineTaskType::kForward, forward_num});
+    schedule.push_back({PipelineTaskType::kBackward, backward_num});
+  }
+  for (; backward_num < micro_num; ++backward_num) {
+    schedule.push_back({PipelineTaskType::kBackward, backward_num});
+  }
+  return schedule;
+}
+
+std::vector<PipelineTask> GenerateGPipeSchedule(int64_t micro_num) {
+  std::vector<PipelineTask> schedule;
+  for (int64_t micro = 0; micro < micro_num; ++micro) {
+    schedule.push_back({PipelineTaskType::kForward, micro});
+  }
+  for (int64_t micro = 0; micro < micro_num; ++micro) {
+    schedule.push_back({PipelineTaskType::kBackward, micro});
+  }
+  return schedule;
+}
+
+// Simulate the tasks of the stages with the task cost, a task begins when both the stage and its dependency task are
+// ready. The forward task depends on the forward task of the previous stage, and the backward task depends on the
+// backward task of the next stage, or the forward task of the same micro on the last stage.
+class ScheduleSimulator {
+ public:
+  ScheduleSimulator(int64_t stage_num, int64_t micro_num, const PipelineTaskCost &cost)
+      : stage_num_(stage_num),
+        micro_num_(micro_num),
+        cost_(cost),
+        finish_time_(kTaskTypeNum * LongToSize(stage_num * micro_num), -1),
+        stage_time_(LongToSize(stage_num), 0),
+        busy_time_(LongToSize(stage_num), 0) {}
+  ~ScheduleSimulator() = default;
+
+  // Return the finish time of the dependency task, or a negative value if the dependency task is not run yet.
+  double DependencyFinishTime(const PipelineTask &task, size_t stage) const {
+    auto stage_id = SizeToLong(stage);
+    if (task.type == PipelineTaskType::kForward) {
+      return stage_id == 0 ? 0 : finish_time_[TimeIndex(task.type, stage_id - 1, task.micro)];
+    }
+    return stage_id == stage_num_ - 1 ? finish_time_[TimeIndex(PipelineTaskType::kForward, stage_id, task.micro)]
+                                      : finish_time_[TimeIndex(task.type, stage_id + 1, task.micro)];
+  }
+
+  // Run the task whose dependency task has been run.
+  void Run(const PipelineTask &task, size_t stage) {
+    auto duration = task.type == PipelineTaskType::kForward ? cost_.forward : cost_.backward;
+    stage_time_[stage] = std::max(stage_time_[stage], DependencyFinishTime(task, stage)) + duration;
+    busy_time_[stage] += duration;
+    finish_time_[TimeIndex(task.type, SizeToLong(stage), task.micro)] = stage_time_[stage];
+  }
+
+  PipelineBubbleInfo GetBubbleInfo() const {
+    PipelineBubbleInfo bubble_info;
+    bubble_info.makespan = *std::max_element(stage_time_.begin(), stage_time_.end());
+    double total_idle_time = 0;
+    for (size_t stage = 0; stage < stage_time_.size(); ++stage) {
+      (void)bubble_info.stage_idle_time.emplace_back(bubble_info.makespan - busy_time_[stage]);
+      total_idle_time += bubble_info.stage_idle_time.back();
+    }
+    if (bubble_info.makespan > 0) {
+      bubble_info.bubble_fraction = total_idle_time / (bubble_info.makespan * stage_num_);
+    }
+    return bubble_info;
+  }
+
+ private:
+  size_t TimeIndex(PipelineTaskType type, int64_t stage_id, int64_t micro) const {
+    return LongToSize((static_cast<int64_t>(type) * stage_num_ + stage_id) * micro_num_ + micro);
+  }
+
+  int64_t stage_num_;
+  int64_t micro_num_;
+  PipelineTaskCost cost_;
+  // The finish time of the tasks indexed by the task type, the stage and the micro.
+  std::vector<double> finish_time_;
+  std::vector<double> stage_time_;
+  std::vector<double> busy_time_;
+};
+
+void CheckScheduleArgs(int64_t stage_num, int64_t micro_num) {
+  if (stage_num <= 0 || micro_num <= 0) {
+    MS_LOG(EXCEPTION) << "The stage num " << stage_num << " and micro num " << micro_num
+                      << " of the pipeline schedule should be positive.";
+  }
+}
+}  // namespace
+
+PipelineScheduleType GetPipelineScheduleType() {
+  auto schedule_name = common::GetEnv(kPipelineScheduleEnv);
+  if (schedule_name.empty()) {
+    return PipelineScheduleType::k1F1B;
+  }
+  auto iter = ScheduleTypes().find(schedule_name);
+  if (iter == ScheduleTypes().end()) {
+    MS_LOG(EXCEPTION) << "The pipeline schedule '" << schedule_name << "' set by the environment variable "
+                      << kPipelineScheduleEnv << " is invalid, it should be one of '1f1b' and 'gpipe'.";
+  }
+  return iter->second;
+}
+
+std::string PipelineScheduleName(PipelineScheduleType type) {
+  for (const auto &iter : ScheduleTypes()) {
+    if (iter.second == type) {
+      return iter.first;
+    }
+  }
+  return "unknown";
+}
+
+std::vector<PipelineTask> GeneratePipelineSchedule(PipelineScheduleType type, int64_t stage_num, int64_t stage_id,
+                                                   int64_t micro_num) {
+  CheckScheduleArgs(stage_num, micro_num);
+  if (stage_id < 0 || stage_id >= stage_num) {
+    MS_LOG(EXCEPTION) << "The stage id " << stage_id << " should be in [0, " << stage_num << ").";
+  }
+  if (type == PipelineScheduleType::kGPipe) {
+    return GenerateGPipeSchedule(micro_num);
+  }
+  return Generate1F1BSchedule(stage_num, stage_id, micro_num);
+}
+
+PipelineBubbleInfo EstimatePipelineBubble(PipelineScheduleType type, int64_t stage_num, int64_t micro_num,
+                                          const PipelineTaskCost &cost) {
+  CheckScheduleArgs(stage_num, micro_num);
+  ScheduleSimulator simulator(stage_num, micro_num, cost);
+  auto stage_size = LongToSize(stage_num);
+  std::vector<std::vector<PipelineTask>> schedules(stage_size);
+  std::vector<size_t> next_task_index(stage_size, 0);
+  size_t remaining_task_num = 0;
+  for (size_t stage = 0; stage < stage_size; ++stage) {
+    schedules[stage] = GeneratePipelineSchedule(type, stage_num, SizeToLong(stage), micro_num);
+    remaining_task_num += schedules[stage].size();
+  }
+  // Each stage runs the tasks in the schedule order until a task whose dependency task is not run yet.
+  while (remaining_task_num > 0) {
+    bool has_progress = false;
+    for (size_t stage = 0; stage < stage_size; ++stage) {
+      for (; next_task_index[stage] < schedules[stage].size(); ++next_task_index[stage]) {
+        const auto &task = schedules[stage][next_task_index[stage]];
+        if (simulator.DependencyFinishTime(task, stage) < 0) {
+          break;
+        }
+        simulator.Run(task, stage);
+        --remaining_task_num;
+        has_progress = true;
+      }
+    }
+    if (!has_progress) {
+      MS_LOG(EXCEPTION) << "The pipeline schedule " << PipelineScheduleName(type) << " is deadlocked.";
+    }
+  }
+  return simulator.GetBubbleInfo();
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_GRAPH_UTIL_PIPELINE_SCHEDULE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_GRAPH_UTIL_PIPELINE_SCHEDULE_H_
+
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+constexpr char kPipelineScheduleEnv[] = "MS_PIPELINE_SCHEDULE";
+
+enum class PipelineScheduleType { k1F1B = 0, kGPipe };
+
+enum class PipelineTaskType { kForward = 0, kBackward };
+
+// One task in the schedule of a stage.
+struct PipelineTask {
+  PipelineTaskType type;
+  int64_t micro;
+};
+
+// The cost of the tasks of a stage.
+struct PipelineTaskCost {
+  double forward{1};
+  double backward{2};
+};
+
+struct PipelineBubbleInfo {
+  // The time from the first task beginning to the last task ending of all the stages.
+  double makespan{0};
+  // The time each stage waits for the other stages in the makespan.
+  std::vector<double> stage_idle_time;
+  // The total idle time of the stages divided by the total time of the stages.
+  double bubble_fraction{0};
+};
+
+// Get the schedule type from the environment variable 'MS_PIPELINE_SCHEDULE', whose value is one of '1f1b'(default)
+// and 'gpipe'.
+PipelineScheduleType GetPipelineScheduleType();
+std::string PipelineScheduleName(PipelineScheduleType type);
+
+// Generate the task order of the stage.
+std::vector<PipelineTask> GeneratePipelineSchedule(PipelineScheduleType type, int64_t stage_num, int64_t stage_id,
+                                                   int64_t micro_num);
+
+// Estimate the idle time of each stage by simulating the schedule with the task cost, the communication time is
+// ignored.
+PipelineBubbleInfo EstimatePipelineBubble(PipelineScheduleType type, int64_t stage_num, int64_t micro_num,
+                                          const PipelineTaskCost &cost = PipelineTaskCost());
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_GRAPH_UTIL_PIPELINE_SCHEDULE_H_
@@ -29,6 +29,7 @@
 #include "frontend/parallel/step_parallel.h"
 #include "frontend/parallel/step_parallel_utils.h"
 #include "frontend/parallel/graph_util/node_info.h"
+#include "frontend/parallel/graph_util/pipeline_schedule.h"
 #include "utils/parallel_node_check.h"
 
 namespace mindspore {
@@ -48,6 +49,28 @@ std::string TagForSendRecDepend(const AnfNodePtr &prior_node, const AnfNodePtr &
   }
   return std::string(SEND_REC_DEPEND);
 }
+
+// The estimation is only logged, so it never fails the compiling.
+void LogPipelineBubble(PipelineScheduleType schedule_type, int64_t micro_num) {
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  auto stage_num = g_device_manager->stage_num();
+  auto stage_id = g_device_manager->stage_id();
+  if (micro_num <= 0 || stage_id < 0 || stage_id >= stage_num) {
+    MS_LOG(INFO) << "Skip estimating the pipeline bubble of stage " << stage_id << " with stage num " << stage_num
+                 << " and micro num " << micro_num;
+    return;
+  }
+  try {
+    auto bubble_info = EstimatePipelineBubble(schedule_type, stage_num, micro_num);
+    MS_LOG(INFO) << "The estimated bubble of the pipeline schedule " << PipelineScheduleName(schedule_type)
+                 << " with stage num " << stage_num << " and micro num " << micro_num << ": the idle time of stage "
+                 << stage_id << " is " << bubble_info.stage_idle_time[LongToSize(stage_id)] << " of the makespan "
+                 << bubble_info.makespan << " in the forward time unit, the bubble fraction is "
+                 << bubble_info.bubble_fraction;
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Estimate the pipeline bubble failed: " << e.what();
+  }
+}
 }  // namespace
 AnfNodePtr FindAccuGrad(const CNodePtr &cnode) {
   auto pre_node = cnode->input(1);
@@ -458,6 +481,28 @@ void ReorderForBackward(const PipelinePair &forward_start_pair, const PipelinePa
   }
 }
 
+void ReorderForGPipe(const PipelinePair &forward_start_pair, const PipelinePair &forward_end_pair,
+                     const PipelinePair &backward_start_pair, const PipelinePair &backward_end_pair,
+                     const PipelinePair &forward_end_before_pair, const FuncGraphPtr &root) {
+  MS_EXCEPTION_IF_NULL(root);
+  auto manager = root->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  // All the micros run forward in turn, and then run backward in turn.
+  for (size_t i = 1; i < forward_start_pair.first.size(); ++i) {
+    auto prior_node = forward_end_pair.second[i - 1];
+    auto post_node = forward_start_pair.first[i];
+    InsertDepend(prior_node, post_node, manager, root);
+  }
+  auto prior_node1 = forward_end_before_pair.second.back();
+  auto post_node1 = backward_start_pair.first.front();
+  InsertDepend(prior_node1, post_node1, manager, root, TagForSendRecDepend(prior_node1, post_node1));
+  for (size_t j = 1; j < backward_start_pair.first.size(); ++j) {
+    auto prior_node2 = backward_end_pair.second[j - 1];
+    auto post_node2 = backward_start_pair.first[j];
+    InsertDepend(prior_node2, post_node2, manager, root, TagForSendRecDepend(prior_node2, post_node2));
+  }
+}
+
 void ReorderForParams(const PipelinePair &backward_params_pair, const PipelinePair &forward_params_pair,
                       const PipelinePair &backward_end_pair, const PipelinePair &forward_start_pair,
                       const FuncGraphPtr &root) {
@@ -815,10 +860,18 @@ void Reorder(const FuncGraphPtr &root) {
       break;
     }
   }
-  ReorderForForward(forward_start_pair.first, forward_end_pair.second, root);
-  ReorderForBackward(forward_start_pair, forward_end_pair, backward_start_pair, backward_end_pair,
-                     forward_end_before_pair, root);
+  auto schedule_type = GetPipelineScheduleType();
+  if (schedule_type == PipelineScheduleType::kGPipe) {
+    ReorderForGPipe(forward_start_pair, forward_end_pair, backward_start_pair, backward_end_pair,
+                    forward_end_before_pair, root);
+  } else {
+    ReorderForForward(forward_start_pair.first, forward_end_pair.second, root);
+    ReorderForBackward(forward_start_pair, forward_end_pair, backward_start_pair, backward_end_pair,
+                       forward_end_before_pair, root);
+  }
   ReorderForParams(backward_params_pair, forward_params_pair, backward_end_pair, forward_start_pair, root);
+  // The micros are numbered from 0 to micro_max.
+  LogPipelineBubble(schedule_type, micro_max + 1);
 }
 
 void ReorderForPredict(const FuncGraphPtr &root, const FuncGraphManagerPtr &manager) {
@@ -40,6 +40,9 @@ void ReorderForForward(const std::vector<AnfNodePtr> &forward_start, const std::
 void ReorderForBackward(const PipelinePair &forward_start_pair, const PipelinePair &forward_end_pair,
                         const PipelinePair &backward_start_pair, const PipelinePair &backward_end_pair,
                         const PipelinePair &forward_end_before_pair, const FuncGraphPtr &root);
+void ReorderForGPipe(const PipelinePair &forward_start_pair, const PipelinePair &forward_end_pair,
+                     const PipelinePair &backward_start_pair, const PipelinePair &backward_end_pair,
+                     const PipelinePair &forward_end_before_pair, const FuncGraphPtr &root);
 void ReorderForParams(const PipelinePair &backward_params_pair, const PipelinePair &forward_params_pair,
                       const PipelinePair &backward_end_pair, const PipelinePair &forward_start_pair,
                       const FuncGraphPtr &root);
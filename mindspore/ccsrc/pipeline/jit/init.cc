@@ -91,7 +91,10 @@ void RegProfiler(const py::module *m) {
 void RegProfilerManager(const py::module *m) {
   (void)py::class_<ProfilerManager, std::shared_ptr<ProfilerManager>>(*m, "ProfilerManager")
     .def_static("get_instance", &ProfilerManager::GetInstance, "ProfilerManager get_instance.")
-    .def("dynamic_status", &ProfilerManager::GetNetDynamicShapeStatus, "dynamic_status");
+    .def("dynamic_status", &ProfilerManager::GetNetDynamicShapeStatus, "dynamic_status")
+    .def("infer_cache_hit_count", &ProfilerManager::GetInferCacheHitCount, "infer_cache_hit_count")
+    .def("infer_cache_miss_count", &ProfilerManager::GetInferCacheMissCount, "infer_cache_miss_count")
+    .def("resize_skipped_count", &ProfilerManager::GetResizeSkippedCount, "resize_skipped_count");
 }
 }  // namespace profiler
 }  // namespace mindspore
@@ -247,9 +247,8 @@ void ForwardExecutor::RunOpForwardAsyncImpl(const FrontendOpRunInfoPtr &op_run_i
 
 void ForwardExecutor::RunOpForwardAsync(const FrontendOpRunInfoPtr &op_run_info) {
   Init();
-  auto forward_task = std::make_shared<ForwardTask>(
+  forward_queue_->Emplace<ForwardTask>(
     [this](const FrontendOpRunInfoPtr &op_run_info) { RunOpForwardAsyncImpl(op_run_info); }, op_run_info);
-  forward_queue_->Push(forward_task);
 }
 
 void ForwardExecutor::RunOpForward(const FrontendOpRunInfoPtr &op_run_info) {
@@ -628,8 +628,7 @@ void GradExecutor::NewGraphImpl(const InputArgsInfoPtr &input_args_info) {
 
 void GradExecutor::AsyncNewGraphImpl(const InputArgsInfoPtr &input_args_info) {
   const auto fn = [this, input_args_info]() { this->NewGraphImpl(input_args_info); };
-  auto task = std::make_shared<BpropTask>(fn);
-  async_executor_->Push(task);
+  async_executor_->Emplace<BpropTask>(fn);
 }
 
 bool GradExecutor::GetTopCellDynamicFlag(const InputArgsInfoPtr &input_args_info,
@@ -827,8 +826,7 @@ void GradExecutor::EndGraphImpl(const InputArgsInfoPtr &input_args_info) {
 
 void GradExecutor::AsyncEndGraphImpl(const InputArgsInfoPtr &input_args_info) {
   const auto fn = [this, input_args_info]() { this->EndGraphImpl(input_args_info); };
-  auto task = std::make_shared<BpropTask>(fn);
-  async_executor_->Push(task);
+  async_executor_->Emplace<BpropTask>(fn);
 }
 
 void GradExecutor::DoGradForCustomBprop(const InputArgsInfoPtr &input_args_info, const std::string &out_id) const {
@@ -1728,8 +1726,7 @@ void GradExecutor::ProcessOpGradInfo(const FrontendOpRunInfoPtr &op_run_info) co
 
 void GradExecutor::AsyncProcessOpGradInfo(const FrontendOpRunInfoPtr &op_run_info) const {
   const auto fn = [this, op_run_info]() { this->ProcessOpGradInfo(op_run_info); };
-  auto task = std::make_shared<BpropTask>(fn);
-  async_executor_->Push(task);
+  async_executor_->Emplace<BpropTask>(fn);
 }
 
 void GradExecutor::SaveOutputNodeMap(const std::string &obj_id, const FrontendOpRunInfoPtr &op_run_info,
@@ -1831,8 +1828,7 @@ void GradExecutor::GradPynativeOp(const autograd::AutoGradCellImplPtr &auto_grad
 void GradExecutor::AsyncGradPynativeOp(const autograd::AutoGradCellImplPtr &auto_grad_cell_ptr,
                                        const autograd::GradParamPtr &grad_param) const {
   const auto fn = [this, auto_grad_cell_ptr, grad_param]() { this->GradPynativeOp(auto_grad_cell_ptr, grad_param); };
-  auto task = std::make_shared<BpropTask>(fn);
-  async_executor_->Push(task);
+  async_executor_->Emplace<BpropTask>(fn);
 }
 
 void GradExecutor::AsyncUpdateOutputNodeOfTopCell(const AnfNodePtr &output_node, const ValuePtr &cloned_value) const {
@@ -1840,8 +1836,7 @@ void GradExecutor::AsyncUpdateOutputNodeOfTopCell(const AnfNodePtr &output_node,
   const auto fn = [auto_grad_cell_ptr, output_node, cloned_value]() {
     auto_grad_cell_ptr->UpdateOutputNodeOfTopCell(output_node, cloned_value);
   };
-  auto task = std::make_shared<BpropTask>(fn);
-  async_executor_->Push(task);
+  async_executor_->Emplace<BpropTask>(fn);
 }
 
 void GradExecutor::UpdateForwardTensorInfoInBpropGraph(const std::string &op_info, const ValuePtr &v) const {
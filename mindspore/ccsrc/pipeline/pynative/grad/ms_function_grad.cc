@@ -373,8 +373,7 @@ void MsFunction::AsyncKPynativeWithFProp(const GradExecutor *grad_executor,
       MS_LOG(EXCEPTION) << "Failed to make adjoint for ms_function cnode";
     }
   };
-  auto task = std::make_shared<BpropTask>(fn);
-  grad_executor->async_executor()->Push(task);
+  grad_executor->async_executor()->Emplace<BpropTask>(fn);
 }
 
 void MsFunction::AsyncGradMsFunctionInner(const FrontendOpRunInfoPtr &op_run_info, const GradExecutor *grad_executor,
@@ -383,8 +382,7 @@ void MsFunction::AsyncGradMsFunctionInner(const FrontendOpRunInfoPtr &op_run_inf
   const auto fn = [this, op_run_info, grad_executor, added_out_v, ms_func_graph, grad_graph]() {
     this->GradMsFunctionInner(op_run_info, grad_executor, added_out_v, ms_func_graph, grad_graph);
   };
-  auto task = std::make_shared<BpropTask>(fn);
-  grad_executor->async_executor()->Push(task);
+  grad_executor->async_executor()->Emplace<BpropTask>(fn);
 }
 
 void MsFunction::GradMsFunctionInner(const FrontendOpRunInfoPtr &op_run_info, const GradExecutor *grad_executor,
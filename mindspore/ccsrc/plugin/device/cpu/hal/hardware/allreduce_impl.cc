@@ -16,15 +16,53 @@
 
 #include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <functional>
 #include <memory>
+#include <numeric>
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 namespace {
 constexpr size_t kWaitTimeout = 30;
+// The ring passes a chunk in segments of at most so many bytes, so a segment is reduced while the next is received.
+constexpr size_t kPipelineSegmentSize = 1 << 20;
+
+// The cost of a link, passing a message of n bytes takes latency + n * byte_time microseconds.
+struct LinkCost {
+  double latency;
+  double byte_time;
+};
+// The tcp between the hosts, about 10Gb/s, and the shared memory inside the host.
+constexpr LinkCost kTcpLinkCost = {50.0, 1.0e-3};
+constexpr LinkCost kShmLinkCost = {2.0, 1.0e-4};
+// The microseconds of reducing one byte of float32 by SIMD.
+constexpr double kReduceByteTime = 1.0e-4;
+
+// The time of ReduceBroadcastAllReduce, the rank 0 receives, reduces and sends the whole data rank_num - 1 times.
+double ReduceBroadcastTime(double size, size_t rank_num, const LinkCost &link) {
+  auto peer_num = static_cast<double>(rank_num - 1);
+  return 2 * link.latency + peer_num * size * (2 * link.byte_time + kReduceByteTime);
+}
+
+// The time of the pipelined ring AllReduce. A step passes one chunk in segments, the reduction of a segment hides
+// behind the transfer of the next one, so only the slower of them counts except for the last segment.
+double RingTime(double size, size_t rank_num, const LinkCost &link) {
+  if (rank_num <= 1) {
+    return 0;
+  }
+  double chunk = size / rank_num;
+  double segment_num = std::max(std::ceil(chunk / kPipelineSegmentSize), 1.0);
+  double segment = chunk / segment_num;
+  double reduce_step = segment_num * link.latency + chunk * std::max(link.byte_time, kReduceByteTime) +
+                       segment * std::min(link.byte_time, kReduceByteTime);
+  double gather_step = segment_num * link.latency + chunk * link.byte_time;
+  return static_cast<double>(rank_num - 1) * (reduce_step + gather_step);
+}
 }  // namespace
 
 bool AllReduceLauncher::Initialize() {
@@ -43,10 +81,58 @@ bool AllReduceLauncher::Initialize() {
 
   node_role_ = cluster_ctx->node_role();
   rank_size_ = static_cast<size_t>(cluster_ctx->node_num(cluster_ctx->node_role()));
+  world_ranks_.resize(rank_size_);
+  std::iota(world_ranks_.begin(), world_ranks_.end(), 0);
   return true;
 }
 
+void AllReduceLauncher::EnableHierarchy(const std::shared_ptr<ShmCollectiveOpsImpl> &local_ops,
+                                        const std::vector<uint32_t> &local_ranks,
+                                        const std::vector<uint32_t> &cross_ranks) {
+  MS_EXCEPTION_IF_NULL(local_ops);
+  if (local_ranks.size() * cross_ranks.size() != rank_size_ ||
+      std::find(local_ranks.begin(), local_ranks.end(), rank_id_) == local_ranks.end() ||
+      std::find(cross_ranks.begin(), cross_ranks.end(), rank_id_) == cross_ranks.end()) {
+    MS_LOG(EXCEPTION) << "The local ranks " << local_ranks << " and the cross ranks " << cross_ranks
+                      << " do not match the rank " << rank_id_ << " of " << rank_size_ << " ranks.";
+  }
+  local_ops_ = local_ops;
+  local_group_ranks_.resize(local_ranks.size());
+  std::iota(local_group_ranks_.begin(), local_group_ranks_.end(), 0);
+  local_rank_id_ = static_cast<size_t>(std::find(local_ranks.begin(), local_ranks.end(), rank_id_) -
+                                       local_ranks.begin());
+  cross_ranks_ = cross_ranks;
+  MS_LOG(INFO) << "Enable the hierarchical AllReduce of " << cross_ranks_.size() << " hosts with "
+               << local_ranks.size() << " processes each, the local ranks: " << local_ranks
+               << ", the cross ranks: " << cross_ranks_;
+}
+
+AllReduceAlgorithm AllReduceLauncher::SelectAlgorithm(size_t data_size) const {
+  // The ring needs a chunk for every rank.
+  if (data_size / sizeof(float) < rank_size_) {
+    return AllReduceAlgorithm::kReduceBroadcast;
+  }
+  auto size = static_cast<double>(data_size);
+  auto algorithm = AllReduceAlgorithm::kReduceBroadcast;
+  double min_time = ReduceBroadcastTime(size, rank_size_, kTcpLinkCost);
+  double ring_time = RingTime(size, rank_size_, kTcpLinkCost);
+  if (ring_time < min_time) {
+    algorithm = AllReduceAlgorithm::kRing;
+    min_time = ring_time;
+  }
+  if (local_ops_ != nullptr) {
+    size_t local_size = local_group_ranks_.size();
+    double hierarchical_time =
+      RingTime(size, local_size, kShmLinkCost) + RingTime(size / local_size, cross_ranks_.size(), kTcpLinkCost);
+    if (hierarchical_time < min_time) {
+      algorithm = AllReduceAlgorithm::kHierarchical;
+    }
+  }
+  return algorithm;
+}
+
 bool AllReduceLauncher::Finalize() {
+  local_ops_ = nullptr;
   MS_EXCEPTION_IF_NULL(abs_node_);
   if (!abs_node_->Finish()) {
     MS_LOG(WARNING) << "Failed to finish the cpu collective node.";
@@ -58,122 +144,247 @@ bool AllReduceLauncher::Finalize() {
   return true;
 }
 
-bool AllReduceLauncher::Execute(const void *input_data, void *const output_data, size_t data_size) const {
+bool AllReduceLauncher::Execute(const void *input_data, void *const output_data, size_t data_size,
+                                CompressionType wire_type) const {
   MS_EXCEPTION_IF_NULL(input_data);
   MS_EXCEPTION_IF_NULL(output_data);
   // If node is scheduler, don't need to participate in the reduction.
   if (node_role_ == distributed::kEnvRoleOfScheduler) {
     return true;
   }
-  size_t data_num = data_size / sizeof(float);
-  if (data_num < rank_size_) {
+  auto algorithm = SelectAlgorithm(data_size);
+  if (algorithm == AllReduceAlgorithm::kReduceBroadcast) {
     MS_LOG(DEBUG) << "AllReduceLauncher executes ReduceBroadcastAllReduce algorithm on the rank " << rank_id_;
     return ReduceBroadcastAllReduce(input_data, output_data, data_size);
   }
-  // If the data number is not less than the node number, the RingAllReduce algorithm is used.
+  if (algorithm == AllReduceAlgorithm::kHierarchical) {
+    MS_LOG(DEBUG) << "AllReduceLauncher executes HierarchicalAllReduce algorithm on the rank " << rank_id_;
+    return HierarchicalAllReduce(input_data, output_data, data_size, wire_type);
+  }
   MS_LOG(DEBUG) << "AllReduceLauncher executes RingAllReduce algorithm on the rank " << rank_id_;
-  return RingAllReduce(input_data, output_data, data_size);
+  return RingAllReduce(input_data, output_data, data_size, wire_type);
 }
 
-bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const {
+bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output_data, size_t data_size,
+                                      CompressionType wire_type) const {
   int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
   if (memcpy_ret != EOK) {
     MS_LOG(ERROR) << "RingAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
     return false;
   }
   MS_EXCEPTION_IF_CHECK_FAIL((rank_size_ != 0), "The rank size is zero.");
+  return PipelinedRingAllReduce(reinterpret_cast<float *>(output_data), data_size / sizeof(float), world_ranks_,
+                                wire_type);
+}
+
+bool AllReduceLauncher::HierarchicalAllReduce(const void *input_data, void *const output_data, size_t data_size,
+                                              CompressionType wire_type) const {
+  int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
+  if (memcpy_ret != EOK) {
+    MS_LOG(ERROR) << "HierarchicalAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(local_ops_);
+  auto *output_buff = reinterpret_cast<float *>(output_data);
   size_t data_num = data_size / sizeof(float);
-  size_t chunk_size = data_num / rank_size_;
-  size_t remainder_size = data_num % rank_size_;
-  std::vector<size_t> chunk_sizes(rank_size_, chunk_size);
-  // The rest of the data should be assigned to each chunk.
-  for (size_t i = 0; i < remainder_size; i++) {
-    chunk_sizes[i]++;
+  // Step 1: ReduceScatter inside the host, this process reduces the chunk of its local rank from this host.
+  if (!local_ops_->ReduceScatterInPlace<float>(output_buff, data_num, local_group_ranks_)) {
+    MS_LOG(ERROR) << "HierarchicalAllReduce failed to reduce scatter inside the host on the rank " << rank_id_;
+    return false;
   }
-  // Store offsets to get every data chunk's address.
-  std::vector<size_t> chunk_offset;
-  for (size_t i = 0; i < rank_size_; i++) {
-    size_t ofs =
-      std::accumulate(chunk_sizes.begin(), chunk_sizes.begin() + SizeToLong(i), size_t(0), std::plus<size_t>());
-    chunk_offset.push_back(ofs);
+  // Step 2: AllReduce the chunk across the hosts, only one of the local size chunks goes through the network.
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(data_num, local_group_ranks_.size(), &chunk_offsets, &chunk_sizes);
+  if (!PipelinedRingAllReduce(output_buff + chunk_offsets[local_rank_id_], chunk_sizes[local_rank_id_], cross_ranks_,
+                              wire_type)) {
+    MS_LOG(ERROR) << "HierarchicalAllReduce failed to reduce across the hosts on the rank " << rank_id_;
+    return false;
   }
+  // Step 3: AllGather the reduced chunks inside the host.
+  if (!local_ops_->AllGatherInPlace<float>(output_buff, data_num, local_group_ranks_)) {
+    MS_LOG(ERROR) << "HierarchicalAllReduce failed to all gather inside the host on the rank " << rank_id_;
+    return false;
+  }
+  return true;
+}
 
-  auto *output_buff = reinterpret_cast<float *>(output_data);
-  uint32_t send_to_rank = SizeToUint((rank_id_ + 1) % rank_size_);
-  uint32_t rec_from_rank = SizeToUint((rank_id_ - 1 + rank_size_) % rank_size_);
-  MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", rank_size_:" << rank_size_ << ", rank_id_:" << rank_id_
-                << ", chunk_size:" << chunk_size << ", remainder_size:" << remainder_size
-                << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
-                << ", rec_from_rank:" << rec_from_rank;
-
-  // Ring ReduceScatter.
-  MS_LOG(DEBUG) << "Start Ring ReduceScatter.";
+bool AllReduceLauncher::SparseAllReduce(const std::vector<uint32_t> &indices, const std::vector<float> &values,
+                                        float *output, size_t data_num) const {
+  MS_EXCEPTION_IF_NULL(output);
   MS_EXCEPTION_IF_NULL(abs_node_);
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    // Step 1: Async send data to next rank.
-    size_t send_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    // Step 2: Async receive data to next rank and wait until it's done.
-    size_t rec_chunk_index = (rank_id_ - i - 1 + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring ReduceScatter send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
-
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
+  if (indices.size() != values.size()) {
+    MS_LOG(ERROR) << "The number of the indices " << indices.size() << " and the values " << values.size()
+                  << " of SparseAllReduce are not equal.";
+    return false;
+  }
+  // The message is the number of the elements, the indices and the values, which are all 4 bytes.
+  auto element_num = SizeToUint(indices.size());
+  std::vector<uint32_t> message(1 + 2 * indices.size());
+  message[0] = element_num;
+  (void)std::copy(indices.begin(), indices.end(), message.begin() + 1);
+  if (!values.empty()) {
+    auto memcpy_ret = memcpy_s(message.data() + 1 + indices.size(), values.size() * sizeof(float), values.data(),
+                               values.size() * sizeof(float));
+    if (memcpy_ret != EOK) {
+      MS_LOG(ERROR) << "SparseAllReduce memcpy_s values error, errorno(" << memcpy_ret << ")";
+      return false;
+    }
+  }
+  size_t message_size = message.size() * sizeof(uint32_t);
+  std::vector<uint64_t> send_req_ids;
+  for (auto rank : world_ranks_) {
+    if (rank != rank_id_) {
+      CollectiveTrafficStats::GetInstance().Record(data_num * sizeof(float), message_size);
+      send_req_ids.push_back(
+        abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, rank, message.data(), message_size));
+    }
+  }
+  std::vector<std::shared_ptr<std::vector<unsigned char>>> rec_messages(rank_size_);
+  for (auto rank : world_ranks_) {
+    if (rank == rank_id_) {
+      continue;
+    }
+    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rank, &rec_messages[rank]);
     if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait receiving [" << rec_req_id.first << "," << rec_req_id.second
-                    << "] failed.";
+      MS_LOG(ERROR) << "SparseAllReduce wait receiving " << rec_req_id << " failed.";
       return false;
     }
-    // Step 3: Reduce the data, so we can overlap the time cost of send.
-    MS_EXCEPTION_IF_NULL(rec_ptr);
-    const auto *tmp_data = reinterpret_cast<float *>(rec_ptr->data());
-    for (size_t j = 0; j < chunk_sizes[rec_chunk_index]; j++) {
-      rec_chunk[j] += tmp_data[j];
+    MS_EXCEPTION_IF_NULL(rec_messages[rank]);
+  }
+
+  std::fill(output, output + data_num, 0.0f);
+  for (auto rank : world_ranks_) {
+    const uint32_t *rec_message = message.data();
+    size_t rec_size = message_size;
+    if (rank != rank_id_) {
+      rec_message = reinterpret_cast<const uint32_t *>(rec_messages[rank]->data());
+      rec_size = rec_messages[rank]->size();
+    }
+    if (rec_size < sizeof(uint32_t) || rec_size != (1 + 2 * static_cast<size_t>(rec_message[0])) * sizeof(uint32_t)) {
+      MS_LOG(ERROR) << "SparseAllReduce received an invalid message of " << rec_size << " bytes from rank " << rank;
+      return false;
+    }
+    size_t rec_num = rec_message[0];
+    const uint32_t *rec_indices = rec_message + 1;
+    const auto *rec_values = reinterpret_cast<const float *>(rec_indices + rec_num);
+    for (size_t i = 0; i < rec_num; i++) {
+      if (rec_indices[i] >= data_num) {
+        MS_LOG(ERROR) << "SparseAllReduce received the index " << rec_indices[i] << " out of range " << data_num
+                      << " from rank " << rank;
+        return false;
+      }
+      output[rec_indices[i]] += rec_values[i];
     }
-    // Step 4: Wait until send is done.
+  }
+  for (auto send_req_id : send_req_ids) {
     if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring ReduceScatter wait sending " << send_req_id << " failed.";
+      MS_LOG(ERROR) << "SparseAllReduce wait sending " << send_req_id << " failed.";
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End Ring ReduceScatter.";
+  return true;
+}
 
-  // Ring AllGather.
-  MS_LOG(DEBUG) << "Start Ring AllGather.";
-  for (size_t i = 0; i < rank_size_ - 1; i++) {
-    size_t send_chunk_index = (rank_id_ - i + 1 + rank_size_) % rank_size_;
-    float *send_chunk = output_buff + chunk_offset[send_chunk_index];
-    auto send_req_id = abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_chunk,
-                                                      chunk_sizes[send_chunk_index] * sizeof(float));
-    size_t rec_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
-    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
-    MS_LOG(DEBUG) << "Ring AllGather send_to_rank:" << send_to_rank << ", rec_from_rank:" << rec_from_rank
-                  << ", send data_num:" << chunk_sizes[send_chunk_index]
-                  << ", rec data_num:" << chunk_sizes[rec_chunk_index] << ", iteration:" << i;
+bool AllReduceLauncher::PipelinedRingAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ring_ranks,
+                                               CompressionType wire_type) const {
+  MS_EXCEPTION_IF_NULL(buff);
+  MS_EXCEPTION_IF_NULL(abs_node_);
+  size_t ring_size = ring_ranks.size();
+  auto iter = std::find(ring_ranks.begin(), ring_ranks.end(), rank_id_);
+  MS_EXCEPTION_IF_CHECK_FAIL(iter != ring_ranks.end(), "The rank is not in the ring.");
+  if (ring_size == 1) {
+    return true;
+  }
+  auto ring_rank = static_cast<size_t>(iter - ring_ranks.begin());
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(data_num, ring_size, &chunk_offsets, &chunk_sizes);
+  // The sender and the receiver split a chunk into the same segments.
+  std::vector<std::vector<size_t>> segment_offsets(ring_size);
+  std::vector<std::vector<size_t>> segment_sizes(ring_size);
+  for (size_t i = 0; i < ring_size; i++) {
+    size_t segment_num = std::max<size_t>(UP_DIV(chunk_sizes[i] * sizeof(float), kPipelineSegmentSize), 1);
+    SplitChunks(chunk_sizes[i], segment_num, &segment_offsets[i], &segment_sizes[i]);
+    for (auto &offset : segment_offsets[i]) {
+      offset += chunk_offsets[i];
+    }
+  }
+  uint32_t send_to_rank = ring_ranks[(ring_rank + 1) % ring_size];
+  uint32_t rec_from_rank = ring_ranks[(ring_rank + ring_size - 1) % ring_size];
+  MS_LOG(DEBUG) << "AllReduce data_num:" << data_num << ", ring_size:" << ring_size << ", rank_id_:" << rank_id_
+                << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
+                << ", rec_from_rank:" << rec_from_rank;
 
-    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
-    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
-    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "Ring AllGather wait receiving " << rec_req_id << " failed.";
-      return false;
+  // The segment in half precision on the wire, the tcp client copies the data so the buffer is reused.
+  bool half = wire_type == CompressionType::kFp16 || wire_type == CompressionType::kBf16;
+  size_t wire_element_size = half ? kHalfElementSize : sizeof(float);
+  std::vector<uint16_t> wire_buff;
+  auto send_segment = [&](float *segment, size_t segment_size, bool round) {
+    const void *data = segment;
+    if (half) {
+      wire_buff.resize(segment_size);
+      EncodeHalf(wire_type, segment, segment_size, wire_buff.data());
+      data = wire_buff.data();
+      // The owner of the reduced chunk rounds it like the receivers, so all the processes get the same result.
+      if (round) {
+        DecodeHalf(wire_type, wire_buff.data(), segment_size, segment, false);
+      }
     }
-    MS_EXCEPTION_IF_NULL(rec_ptr);
-    memcpy_ret = memcpy_s(rec_chunk, chunk_sizes[rec_chunk_index] * sizeof(float), rec_ptr->data(), rec_ptr->size());
-    if (memcpy_ret != 0) {
-      MS_LOG(ERROR) << "Ring AllGather memcpy_s received data error, errorno(" << memcpy_ret << ")";
-      return false;
+    CollectiveTrafficStats::GetInstance().Record(segment_size * sizeof(float), segment_size * wire_element_size);
+    return abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, data,
+                                          segment_size * wire_element_size);
+  };
+
+  // The step i sends the chunk ring_rank - i and receives the chunk ring_rank - i - 1, which is sent in the next step.
+  // The first ring_size - 1 steps reduce the received chunk (ReduceScatter) and the others overwrite it (AllGather).
+  // A received segment is sent on at once, so the segments of a chunk flow around the ring one after another.
+  std::vector<uint64_t> send_req_ids;
+  for (size_t k = 0; k < segment_sizes[ring_rank].size(); k++) {
+    send_req_ids.push_back(
+      send_segment(buff + segment_offsets[ring_rank][k], segment_sizes[ring_rank][k], false));
+  }
+  size_t step_num = 2 * (ring_size - 1);
+  for (size_t i = 0; i < step_num; i++) {
+    size_t rec_chunk_index = (ring_rank + 2 * ring_size - i - 1) % ring_size;
+    for (size_t k = 0; k < segment_sizes[rec_chunk_index].size(); k++) {
+      float *segment = buff + segment_offsets[rec_chunk_index][k];
+      size_t segment_size = segment_sizes[rec_chunk_index][k];
+      std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+      auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
+      if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
+        MS_LOG(ERROR) << "Ring AllReduce wait receiving " << rec_req_id << " failed in step " << i;
+        return false;
+      }
+      MS_EXCEPTION_IF_NULL(rec_ptr);
+      if (rec_ptr->size() != segment_size * wire_element_size) {
+        MS_LOG(ERROR) << "Ring AllReduce received " << rec_ptr->size() << " bytes in step " << i << ", but "
+                      << segment_size * wire_element_size << " bytes are expected.";
+        return false;
+      }
+      if (half) {
+        DecodeHalf(wire_type, reinterpret_cast<const uint16_t *>(rec_ptr->data()), segment_size, segment,
+                   i < ring_size - 1);
+      } else if (i < ring_size - 1) {
+        (void)ElementAdd(segment, reinterpret_cast<const float *>(rec_ptr->data()), segment, SizeToInt(segment_size));
+      } else {
+        auto memcpy_ret = memcpy_s(segment, segment_size * sizeof(float), rec_ptr->data(), rec_ptr->size());
+        if (memcpy_ret != EOK) {
+          MS_LOG(ERROR) << "Ring AllGather memcpy_s received data error, errorno(" << memcpy_ret << ")";
+          return false;
+        }
+      }
+      if (i + 1 < step_num) {
+        send_req_ids.push_back(send_segment(segment, segment_size, i + 1 == ring_size - 1));
+      }
     }
+  }
+  for (auto send_req_id : send_req_ids) {
     if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
-      MS_LOG(ERROR) << "RingAllReduce wait sending " << send_req_id << " failed.";
+      MS_LOG(ERROR) << "Ring AllReduce wait sending " << send_req_id << " failed.";
       return false;
     }
   }
-  MS_LOG(DEBUG) << "End Ring AllGather.";
   return true;
 }
 
@@ -208,6 +419,7 @@ bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *c
     }
   } else {
     MS_LOG(DEBUG) << "Reduce send data to rank 0 process.";
+    CollectiveTrafficStats::GetInstance().Record(data_num * sizeof(float), data_num * sizeof(float));
     auto send_req_id =
       abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, 0, input_data, data_num * sizeof(float));
     if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
@@ -222,6 +434,7 @@ bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *c
   if (rank_id_ == 0) {
     for (uint32_t i = 1; i < rank_size_; i++) {
       MS_LOG(DEBUG) << "Broadcast data to process " << i;
+      CollectiveTrafficStats::GetInstance().Record(data_num * sizeof(float), data_num * sizeof(float));
       auto send_req_id =
         abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, i, output_buff, data_num * sizeof(float));
       if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
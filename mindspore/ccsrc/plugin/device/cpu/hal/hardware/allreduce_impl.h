@@ -19,12 +19,25 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include "distributed/cluster/cluster_context.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_shm_transport.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_compression.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// The AllReduce algorithms, the launcher selects the fastest one for the data size by the cost model.
+enum class AllReduceAlgorithm {
+  // Reduce to the rank 0 and broadcast from it, for the small data whose time is dominated by the latency.
+  kReduceBroadcast,
+  // Ring over all the ranks.
+  kRing,
+  // ReduceScatter inside the host through shared memory, ring across the hosts, then AllGather inside the host.
+  kHierarchical
+};
+
 class AllReduceLauncher {
  public:
   AllReduceLauncher(const AllReduceLauncher &) = delete;
@@ -35,18 +48,52 @@ class AllReduceLauncher {
   bool Initialize();
   bool Finalize();
 
-  bool Execute(const void *input_data, void *const output_data, size_t data_size) const;
+  // The wire type fp16 or bf16 halves the bytes through the network, the data is still accumulated in float32. The
+  // small data is latency bound and passed in float32 anyway.
+  bool Execute(const void *input_data, void *const output_data, size_t data_size,
+               CompressionType wire_type = CompressionType::kNone) const;
+
+  // AllReduce the sparse data of all the processes into the dense output of data_num elements. The sum is in the order
+  // of the ranks, so all the processes get the same result.
+  bool SparseAllReduce(const std::vector<uint32_t> &indices, const std::vector<float> &values, float *output,
+                       size_t data_num) const;
 
   const std::shared_ptr<ps::core::CollectiveNode> &collective_node() const;
 
+  // Enable the hierarchical algorithm. The local ops reduce the data among the processes on this host, whose global
+  // ranks are local_ranks. The cross ranks are the global ranks with the same local rank as this process on every
+  // host, in the order of the hosts. All the hosts must have the same number of processes.
+  void EnableHierarchy(const std::shared_ptr<ShmCollectiveOpsImpl> &local_ops, const std::vector<uint32_t> &local_ranks,
+                       const std::vector<uint32_t> &cross_ranks);
+
+  // Select the algorithm of the least estimated time for data_size bytes.
+  AllReduceAlgorithm SelectAlgorithm(size_t data_size) const;
+
  private:
   size_t rank_id_{0};
   size_t rank_size_{0};
   std::string node_role_{distributed::kEnvRoleOfWorker};
   std::shared_ptr<ps::core::CollectiveNode> abs_node_{nullptr};
 
-  bool RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+  // The global ranks of all the processes, the ring of the flat algorithm.
+  std::vector<uint32_t> world_ranks_;
+  // The shared memory ops among the processes on this host and their transport ranks, which are the indexes of the
+  // processes on this host. The local ops are null if the hierarchical algorithm is not enabled.
+  std::shared_ptr<ShmCollectiveOpsImpl> local_ops_{nullptr};
+  std::vector<uint32_t> local_group_ranks_;
+  size_t local_rank_id_{0};
+  std::vector<uint32_t> cross_ranks_;
+
+  bool RingAllReduce(const void *input_data, void *const output_data, size_t data_size,
+                     CompressionType wire_type) const;
   bool ReduceBroadcastAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+  bool HierarchicalAllReduce(const void *input_data, void *const output_data, size_t data_size,
+                             CompressionType wire_type) const;
+
+  // Ring AllReduce in place among the ring ranks. The chunks are passed in segments and a received segment is reduced
+  // and sent on at once, so the reduction of one segment overlaps with the transfer of the others.
+  bool PipelinedRingAllReduce(float *buff, size_t data_num, const std::vector<uint32_t> &ring_ranks,
+                              CompressionType wire_type) const;
 };
 }  // namespace cpu
 }  // namespace device
@@ -23,6 +23,7 @@
 #include "plugin/device/cpu/optimizer/print_value_type.h"
 #include "plugin/device/cpu/hal/hardware/cpu_somas.h"
 #include "plugin/device/cpu/hal/device/cpu_hash_table_util.h"
+#include "plugin/device/cpu/kernel/interpreter/interpreter_cpu_kernel_mod.h"
 #ifdef ENABLE_AKG
 #include "plugin/device/cpu/kernel/akg/akg_cpu_kernel_build.h"
 #endif
@@ -366,6 +367,12 @@ void CPUKernelExecutor::CreateKernel(const std::vector<CNodePtr> &nodes) const {
       continue;
     }
     if (session::AnfRuntimeAlgorithm::GetKernelType(node) == KernelType::AKG_KERNEL) {
+      if (graphkernel::GraphKernelFlags::GetInstance().kernel_generator == graphkernel::kKernelGeneratorInterpreter) {
+        auto interpreter_kernel = std::make_shared<kernel::InterpreterCpuKernelMod>();
+        interpreter_kernel->Build(node);
+        AnfAlgo::SetKernelMod(interpreter_kernel, node.get());
+        continue;
+      }
       if (!bin_map->initialized()) {
         bin_map->Initialize();
       }
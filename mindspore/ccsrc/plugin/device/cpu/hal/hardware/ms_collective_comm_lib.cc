@@ -16,6 +16,13 @@
 
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <numeric>
+
 #include "distributed/constants.h"
 #include "distributed/recovery/recovery_context.h"
 #include "runtime/collective/collective_communication_lib.h"
@@ -30,6 +37,41 @@ using distributed::recovery::RecoveryContext;
 constexpr char kGroupInfoPrefix[] = "group_info_";
 constexpr char kGroupName[] = "group_name";
 constexpr char kUniqueId[] = "unique_id";
+constexpr char kShmNameKey[] = "shm_collective_name";
+constexpr char kShmReadyKeyPrefix[] = "shm_collective_ready_";
+
+namespace {
+// Query the metadata put by the other process, retry until it is put.
+std::string WaitForMetadata(const std::shared_ptr<distributed::cluster::topology::ComputeGraphNode> &cgn,
+                            const std::string &key) {
+  const size_t interval = 1;
+  size_t retry = RecoveryContext::GetInstance()->enable_recovery() ? SIZE_MAX : kMSCollectiveRetryTime;
+  while (--retry > 0) {
+    auto value = cgn->GetMetadata(key);
+    if (!value.empty()) {
+      return value;
+    }
+    (void)sleep(interval);
+  }
+  return "";
+}
+
+size_t ShmRingSize() {
+  auto env = common::GetEnv(kEnvShmRingSize);
+  if (env.empty()) {
+    return kDefaultShmRingSize;
+  }
+  constexpr size_t kAlignment = 8;
+  auto ring_size = static_cast<size_t>(std::strtoull(env.c_str(), nullptr, 0));
+  if (ring_size == 0 || ring_size % kAlignment != 0) {
+    MS_LOG(WARNING) << "The " << kEnvShmRingSize << " " << env << " should be a positive multiple of " << kAlignment
+                    << ", use the default " << kDefaultShmRingSize;
+    return kDefaultShmRingSize;
+  }
+  return ring_size;
+}
+}  // namespace
+
 MsCollectiveCommLib::MsCollectiveCommLib() {
   // Generate the global group name with node role.
   global_group_name_ = kMCCLGlobalGroupName;
@@ -55,18 +97,118 @@ bool MsCollectiveCommLib::Initialize(uint32_t global_rank, uint32_t global_rank_
   global_rank_id_ = global_rank;
   global_rank_size_ = global_rank_size;
   local_rank_id_ = local_rank_id;
+  InitShmCollective();
   initialized_ = true;
   finalized_ = false;
   return true;
 }
 
 bool MsCollectiveCommLib::Finalize() {
+  shm_ops_.reset();
+  const auto &traffic_stats = CollectiveTrafficStats::GetInstance();
+  MS_LOG(INFO) << "The collective communication passed " << traffic_stats.wire_bytes() << " bytes of "
+               << traffic_stats.raw_bytes() << " bytes of data through the network.";
   if (launcher_ != nullptr) {
     return launcher_->Finalize();
   }
   return true;
 }
 
+void MsCollectiveCommLib::InitShmCollective() {
+  if (common::GetEnv(kEnvDisableShmCollective) == "1" || cgn_ == nullptr || global_rank_size_ <= 1 ||
+      cgn_->role() == distributed::kEnvRoleOfScheduler) {
+    return;
+  }
+  std::vector<size_t> host_hash_names(global_rank_size_, 0);
+  if (!AllGatherHostHashName(0, &host_hash_names)) {
+    MS_LOG(INFO) << "Failed to get the hosts of the processes, the collective communication goes through tcp.";
+    return;
+  }
+  // The global ranks on every host, the hosts are in the order of their first ranks.
+  std::vector<std::vector<uint32_t>> host_ranks;
+  std::map<size_t, size_t> host_indexes;
+  for (uint32_t rank = 0; rank < global_rank_size_; rank++) {
+    auto iter = host_indexes.emplace(host_hash_names[rank], host_ranks.size()).first;
+    if (iter->second == host_ranks.size()) {
+      host_ranks.emplace_back();
+    }
+    host_ranks[iter->second].push_back(rank);
+  }
+  // The hierarchical AllReduce needs the same number of processes on every host, the decision is the same on all the
+  // processes since they see the same hosts.
+  const auto &local_ranks = host_ranks[host_indexes[host_hash_names[global_rank_id_]]];
+  size_t local_size = local_ranks.size();
+  if (local_size <= 1 || std::any_of(host_ranks.begin(), host_ranks.end(), [local_size](const auto &ranks) {
+        return ranks.size() != local_size;
+      })) {
+    MS_LOG(INFO) << "The processes are not evenly placed on the hosts, the collective communication goes through tcp.";
+    return;
+  }
+  auto local_rank = static_cast<uint32_t>(std::find(local_ranks.begin(), local_ranks.end(), global_rank_id_) -
+                                          local_ranks.begin());
+
+  // The first rank on the host names the shared memory of this job on the host.
+  std::string node_role_prefix = cgn_->role() + "_";
+  std::string name_key = node_role_prefix + kShmNameKey + "_" + std::to_string(local_ranks[0]);
+  std::string name;
+  if (local_rank == 0) {
+    name = "/mccl_" + std::to_string(getpid()) + "_" +
+           std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    if (!cgn_->PutMetadata(name_key, name)) {
+      MS_LOG(WARNING) << "Failed to put the shared memory name of this job.";
+    }
+  }
+  name = WaitForMetadata(cgn_, name_key);
+  if (name.empty()) {
+    MS_LOG(WARNING) << "Failed to get the shared memory name, the collective communication goes through tcp.";
+    return;
+  }
+  auto transport = std::make_shared<ShmTransport>(name, local_rank, SizeToUint(local_size), ShmRingSize());
+  bool success = transport->Initialize();
+
+  // All the processes must agree on the transport, otherwise some of them wait for the others over tcp.
+  std::string ready_key_prefix = node_role_prefix + kShmReadyKeyPrefix;
+  if (!cgn_->PutMetadata(ready_key_prefix + std::to_string(global_rank_id_), success ? "1" : "0")) {
+    MS_LOG(EXCEPTION) << "Failed to put the shared memory state of rank " << global_rank_id_;
+  }
+  for (uint32_t rank = 0; rank < global_rank_size_; rank++) {
+    auto ready = WaitForMetadata(cgn_, ready_key_prefix + std::to_string(rank));
+    if (ready.empty()) {
+      MS_LOG(EXCEPTION) << "Failed to get the shared memory state of rank " << rank;
+    }
+    success = success && ready == "1";
+  }
+  if (!success) {
+    MS_LOG(WARNING) << "Failed to initialize the shared memory transport on some rank, the collective communication "
+                       "goes through tcp.";
+    return;
+  }
+  auto shm_ops = std::make_shared<ShmCollectiveOpsImpl>(transport);
+  if (host_ranks.size() == 1) {
+    shm_ops_ = shm_ops;
+    MS_LOG(INFO) << "All the " << global_rank_size_ << " processes are on this host, the collective communication "
+                 << "goes through shared memory.";
+    return;
+  }
+  // The processes of the same local rank on every host form the ring across the hosts.
+  std::vector<uint32_t> cross_ranks;
+  (void)std::transform(host_ranks.begin(), host_ranks.end(), std::back_inserter(cross_ranks),
+                       [local_rank](const std::vector<uint32_t> &ranks) { return ranks[local_rank]; });
+  launcher_->EnableHierarchy(shm_ops, local_ranks, cross_ranks);
+  MS_LOG(INFO) << "The " << global_rank_size_ << " processes are on " << host_ranks.size()
+               << " hosts, AllReduce goes through shared memory inside the host and tcp across the hosts.";
+}
+
+std::vector<uint32_t> MsCollectiveCommLib::GroupRanks(const std::string &group_name) {
+  auto iter = groups_.find(group_name);
+  if (iter != groups_.end() && iter->second != nullptr) {
+    return iter->second->group_ranks();
+  }
+  std::vector<uint32_t> group_ranks(global_rank_size_);
+  std::iota(group_ranks.begin(), group_ranks.end(), 0);
+  return group_ranks;
+}
+
 bool MsCollectiveCommLib::CreateCommunicationGroup(const std::string &group_name,
                                                    const std::vector<uint32_t> &group_ranks, uint32_t local_group_rank,
                                                    uint32_t local_group_size) {
@@ -222,14 +364,95 @@ bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size
   if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
     MS_LOG(EXCEPTION) << "AllReduce only support reduce sum.";
   }
+  // The send count of AllReduce is in bytes.
+  if (shm_ops_ != nullptr) {
+    return shm_ops_->AllReduce<float>(send_buff, recv_buff, send_count / sizeof(float), GroupRanks(group_name));
+  }
   bool ret = launcher_->Execute(send_buff, recv_buff, send_count);
   return ret;
 }
 
+bool MsCollectiveCommLib::CompressedAllReduce(const void *send_buff, void *recv_buff, size_t count,
+                                              const CompressionConfig &config, ErrorFeedbackSparsifier *sparsifier,
+                                              const std::string &group_name) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(launcher_);
+  // The shared memory is not bandwidth bound, the data is passed in float32.
+  if (config.type == CompressionType::kNone || shm_ops_ != nullptr) {
+    return AllReduce(send_buff, recv_buff, count * sizeof(float), TypeId::kNumberTypeFloat32,
+                     CollectiveOpReduceType::Reduce_Sum, group_name);
+  }
+  if (group_name != kMCCLGlobalGroupName) {
+    MS_LOG(EXCEPTION) << "The compressed AllReduce only support " << kMCCLGlobalGroupName << ", but got "
+                      << group_name;
+  }
+  if (config.IsHalf()) {
+    return launcher_->Execute(send_buff, recv_buff, count * sizeof(float), config.type);
+  }
+  CHECK_IF_NULL(sparsifier);
+  std::vector<uint32_t> indices;
+  std::vector<float> values;
+  sparsifier->Sparsify(static_cast<const float *>(send_buff), count, config, &indices, &values);
+  MS_LOG(DEBUG) << "The " << CompressionTypeName(config.type) << " compression selects " << indices.size() << " of "
+                << count << " elements.";
+  return launcher_->SparseAllReduce(indices, values, static_cast<float *>(recv_buff), count);
+}
+
+bool MsCollectiveCommLib::ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
+                                        CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  if (data_type != TypeId::kNumberTypeFloat32) {
+    MS_LOG(EXCEPTION) << "ReduceScatter only support float32.";
+  }
+  if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
+    MS_LOG(EXCEPTION) << "ReduceScatter only support reduce sum.";
+  }
+  if (shm_ops_ != nullptr) {
+    return shm_ops_->ReduceScatter<float>(send_buff, recv_buff, recv_count, GroupRanks(group_name));
+  }
+  // Without the shared memory, the whole input is reduced by the AllReduce through tcp, and this rank keeps its chunk.
+  CHECK_IF_NULL(launcher_);
+  if (group_name != kMCCLGlobalGroupName) {
+    MS_LOG(ERROR) << "ReduceScatter through tcp only support " << kMCCLGlobalGroupName << ", but got " << group_name;
+    return false;
+  }
+  std::vector<float> reduced(recv_count * global_rank_size_);
+  if (!launcher_->Execute(send_buff, reduced.data(), reduced.size() * sizeof(float))) {
+    MS_LOG(ERROR) << "ReduceScatter through tcp failed.";
+    return false;
+  }
+  auto ret = memcpy_s(recv_buff, recv_count * sizeof(float), reduced.data() + global_rank_id_ * recv_count,
+                      recv_count * sizeof(float));
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "The memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  return true;
+}
+
 bool MsCollectiveCommLib::AllGather(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
-                                    const std::string &, void *) {
+                                    const std::string &group_name, void *) {
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
+  if (shm_ops_ != nullptr) {
+    auto group_ranks = GroupRanks(group_name);
+    switch (data_type) {
+      case TypeId::kNumberTypeInt8:
+        return shm_ops_->AllGather<char>(send_buff, recv_buff, send_count, group_ranks);
+      case TypeId::kNumberTypeInt32:
+      case TypeId::kNumberTypeInt:
+        return shm_ops_->AllGather<int32_t>(send_buff, recv_buff, send_count, group_ranks);
+      case TypeId::kNumberTypeUInt64:
+        return shm_ops_->AllGather<uint64_t>(send_buff, recv_buff, send_count, group_ranks);
+      case TypeId::kNumberTypeFloat32:
+      case TypeId::kNumberTypeFloat:
+        return shm_ops_->AllGather<float>(send_buff, recv_buff, send_count, group_ranks);
+      default:
+        return false;
+    }
+  }
   CHECK_IF_NULL(node_);
 
   switch (data_type) {
@@ -261,6 +484,24 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
 
   auto group = groups_[group_name];
   CHECK_IF_NULL(group);
+  if (shm_ops_ != nullptr) {
+    switch (data_type) {
+      case TypeId::kNumberTypeInt8:
+        return shm_ops_->Broadcast<char>(send_buff, recv_buff, send_count, root_rank, group->group_ranks());
+      case TypeId::kNumberTypeInt32:
+        [[fallthrough]];
+      case TypeId::kNumberTypeInt:
+        return shm_ops_->Broadcast<int32_t>(send_buff, recv_buff, send_count, root_rank, group->group_ranks());
+      case TypeId::kNumberTypeUInt64:
+        return shm_ops_->Broadcast<uint64_t>(send_buff, recv_buff, send_count, root_rank, group->group_ranks());
+      case TypeId::kNumberTypeFloat32:
+        [[fallthrough]];
+      case TypeId::kNumberTypeFloat:
+        return shm_ops_->Broadcast<float>(send_buff, recv_buff, send_count, root_rank, group->group_ranks());
+      default:
+        return false;
+    }
+  }
   CommunicationGroupInfo group_info = {};
   group_info.size = group->group_size();
   group_info.global_rank = global_rank_id_;
@@ -26,6 +26,8 @@
 #include "ps/core/collective_ops_impl.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
 #include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_shm_transport.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_compression.h"
 #include "distributed/cluster/topology/compute_graph_node.h"
 
 namespace mindspore {
@@ -72,9 +74,13 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
                  const std::string &group_name, void *stream = nullptr) override;
 
   bool ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
-                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override {
-    return true;
-  }
+                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
+
+  // AllReduce the float32 data of count elements with the compression on the wire. The sparsifier keeps the error
+  // feedback of the sparse compression, it is owned by the caller, e.g. the kernel of one parameter. Only the global
+  // group is supported, and the data is passed without compression through the shared memory.
+  bool CompressedAllReduce(const void *send_buff, void *recv_buff, size_t count, const CompressionConfig &config,
+                           ErrorFeedbackSparsifier *sparsifier, const std::string &group_name);
 
  private:
   MsCollectiveCommLib();
@@ -86,6 +92,13 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
   // Query unique id from scheduler.
   bool QueryUniqueID(const std::string &group_name, size_t root_info_size, void *root_info) const;
 
+  // Pass the collective data through shared memory instead of tcp if all the processes are on this host. If they are
+  // evenly placed on several hosts, the AllReduce launcher reduces inside the host through shared memory.
+  void InitShmCollective();
+
+  // The global ranks of the group in the order of group ranks.
+  std::vector<uint32_t> GroupRanks(const std::string &group_name);
+
   std::shared_ptr<ps::core::CollectiveNode> node_;
 
   // This compute graph node is maintained by the clusster context and used for metadata synchronization.
@@ -93,6 +106,9 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
 
   std::unique_ptr<AllReduceLauncher> launcher_;
 
+  // The collective communication over shared memory, it is null if the processes are not on one host.
+  std::shared_ptr<ShmCollectiveOpsImpl> shm_ops_;
+
   // Indicates whether the collective node has to synchronize the addresses of all the collective nodes.
   bool synchronized_{true};
 };
@@ -0,0 +1,197 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/ms_collective_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr char kCompressionNone[] = "none";
+constexpr char kCompressionFp16[] = "fp16";
+constexpr char kCompressionBf16[] = "bf16";
+constexpr char kCompressionTopK[] = "topk";
+constexpr char kCompressionThreshold[] = "threshold";
+constexpr uint32_t kBf16Shift = 16;
+constexpr uint32_t kBf16RoundingBias = 0x7fff;
+constexpr uint32_t kBf16QuietNanBit = 0x40;
+
+// Round to the nearest even, keep a nan a nan.
+uint16_t Float32ToBf16(float value) {
+  uint32_t bits = 0;
+  (void)memcpy(&bits, &value, sizeof(bits));
+  if (std::isnan(value)) {
+    return static_cast<uint16_t>((bits >> kBf16Shift) | kBf16QuietNanBit);
+  }
+  bits += kBf16RoundingBias + ((bits >> kBf16Shift) & 1);
+  return static_cast<uint16_t>(bits >> kBf16Shift);
+}
+
+float Bf16ToFloat32(uint16_t value) {
+  uint32_t bits = static_cast<uint32_t>(value) << kBf16Shift;
+  float result = 0;
+  (void)memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+bool ParseValue(const std::string &value_str, float *value) {
+  char *end = nullptr;
+  *value = std::strtof(value_str.c_str(), &end);
+  return !value_str.empty() && end == value_str.c_str() + value_str.size() && std::isfinite(*value);
+}
+}  // namespace
+
+bool ParseCompressionConfig(const std::string &spec, CompressionConfig *config) {
+  MS_ERROR_IF_NULL_W_RET_VAL(config, false);
+  auto pos = spec.find('=');
+  auto name = spec.substr(0, pos);
+  auto value_str = pos == std::string::npos ? "" : spec.substr(pos + 1);
+  CompressionConfig result;
+  if (name == kCompressionNone || name == kCompressionFp16 || name == kCompressionBf16) {
+    if (pos != std::string::npos) {
+      MS_LOG(ERROR) << "The compression " << name << " takes no value, but got " << spec;
+      return false;
+    }
+    result.type = name == kCompressionFp16   ? CompressionType::kFp16
+                  : name == kCompressionBf16 ? CompressionType::kBf16
+                                             : CompressionType::kNone;
+  } else if (name == kCompressionTopK) {
+    result.type = CompressionType::kTopK;
+    if (!ParseValue(value_str, &result.ratio) || result.ratio <= 0 || result.ratio > 1) {
+      MS_LOG(ERROR) << "The ratio of topk compression should be in (0, 1], but got " << spec;
+      return false;
+    }
+  } else if (name == kCompressionThreshold) {
+    result.type = CompressionType::kThreshold;
+    if (!ParseValue(value_str, &result.threshold) || result.threshold <= 0) {
+      MS_LOG(ERROR) << "The threshold of threshold compression should be positive, but got " << spec;
+      return false;
+    }
+  } else {
+    MS_LOG(ERROR) << "Unknown compression " << spec << ", it should be one of none, fp16, bf16, topk=<ratio> and "
+                  << "threshold=<value>.";
+    return false;
+  }
+  *config = result;
+  return true;
+}
+
+CompressionConfig GlobalCompressionConfig() {
+  CompressionConfig config;
+  auto env = common::GetEnv(kEnvCollectiveCompression);
+  if (!env.empty() && !ParseCompressionConfig(env, &config)) {
+    MS_LOG(EXCEPTION) << "Invalid " << kEnvCollectiveCompression << ": " << env;
+  }
+  return config;
+}
+
+std::string CompressionTypeName(CompressionType type) {
+  switch (type) {
+    case CompressionType::kFp16:
+      return kCompressionFp16;
+    case CompressionType::kBf16:
+      return kCompressionBf16;
+    case CompressionType::kTopK:
+      return kCompressionTopK;
+    case CompressionType::kThreshold:
+      return kCompressionThreshold;
+    default:
+      return kCompressionNone;
+  }
+}
+
+void EncodeHalf(CompressionType type, const float *input, size_t count, uint16_t *output) {
+  if (type == CompressionType::kBf16) {
+    for (size_t i = 0; i < count; i++) {
+      output[i] = Float32ToBf16(input[i]);
+    }
+    return;
+  }
+  static_assert(sizeof(float16) == kHalfElementSize, "The size of float16 should be 2 bytes.");
+  auto fp16_output = reinterpret_cast<float16 *>(output);
+  for (size_t i = 0; i < count; i++) {
+    fp16_output[i] = float16(input[i]);
+  }
+}
+
+void DecodeHalf(CompressionType type, const uint16_t *input, size_t count, float *output, bool accumulate) {
+  if (type == CompressionType::kBf16) {
+    for (size_t i = 0; i < count; i++) {
+      output[i] = accumulate ? output[i] + Bf16ToFloat32(input[i]) : Bf16ToFloat32(input[i]);
+    }
+    return;
+  }
+  auto fp16_input = reinterpret_cast<const float16 *>(input);
+  for (size_t i = 0; i < count; i++) {
+    auto value = static_cast<float>(fp16_input[i]);
+    output[i] = accumulate ? output[i] + value : value;
+  }
+}
+
+void ErrorFeedbackSparsifier::Sparsify(const float *gradients, size_t count, const CompressionConfig &config,
+                                       std::vector<uint32_t> *indices, std::vector<float> *values) {
+  MS_EXCEPTION_IF_NULL(gradients);
+  MS_EXCEPTION_IF_NULL(indices);
+  MS_EXCEPTION_IF_NULL(values);
+  if (residual_.size() != count) {
+    residual_.assign(count, 0.0f);
+  }
+  accumulation_.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    accumulation_[i] = gradients[i] + residual_[i];
+  }
+  indices->clear();
+  values->clear();
+  if (config.type == CompressionType::kTopK) {
+    auto k = std::min(count, std::max<size_t>(static_cast<size_t>(std::ceil(config.ratio * count)), 1));
+    order_.resize(count);
+    std::iota(order_.begin(), order_.end(), 0);
+    auto greater_magnitude = [this](uint32_t left, uint32_t right) {
+      return std::fabs(accumulation_[left]) > std::fabs(accumulation_[right]);
+    };
+    std::nth_element(order_.begin(), order_.begin() + k - 1, order_.end(), greater_magnitude);
+    indices->assign(order_.begin(), order_.begin() + k);
+    // The ascending indices are friendly to the cache of the receiver.
+    std::sort(indices->begin(), indices->end());
+  } else if (config.type == CompressionType::kThreshold) {
+    for (size_t i = 0; i < count; i++) {
+      if (std::fabs(accumulation_[i]) >= config.threshold) {
+        indices->push_back(static_cast<uint32_t>(i));
+      }
+    }
+  } else {
+    MS_LOG(EXCEPTION) << "The compression " << CompressionTypeName(config.type) << " is not sparse.";
+  }
+  residual_.swap(accumulation_);
+  values->reserve(indices->size());
+  for (auto index : *indices) {
+    values->push_back(residual_[index]);
+    residual_[index] = 0.0f;
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
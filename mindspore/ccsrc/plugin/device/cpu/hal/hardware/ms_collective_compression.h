@@ -0,0 +1,119 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_COMPRESSION_H_
+#define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_COMPRESSION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The compression of AllReduce, e.g. "fp16" or "topk=0.01", see ParseCompressionConfig for the options. It is one
+// setting for the global group, as the AllReduce on CPU only supports the global group. The compression is skipped and
+// the data is passed in float32 when the ranks are on one host and reduced through the shared memory.
+constexpr char kEnvCollectiveCompression[] = "MS_CPU_COLLECTIVE_COMPRESSION";
+// The string attribute of the AllReduce primitive to set the compression of one parameter, which overrides the
+// environment variable.
+constexpr char kAttrCollectiveCompression[] = "compression";
+
+enum class CompressionType {
+  kNone,
+  // The data is passed in half precision and accumulated in float32.
+  kFp16,
+  kBf16,
+  // Only the elements of the largest magnitude, or of the magnitude not less than the threshold, are passed. The rest
+  // are kept as the error feedback and added to the next gradients.
+  kTopK,
+  kThreshold
+};
+
+struct CompressionConfig {
+  CompressionType type{CompressionType::kNone};
+  // The ratio of the elements passed by kTopK.
+  float ratio{0.0f};
+  // The min magnitude of the elements passed by kThreshold.
+  float threshold{0.0f};
+
+  bool IsHalf() const { return type == CompressionType::kFp16 || type == CompressionType::kBf16; }
+  bool IsSparse() const { return type == CompressionType::kTopK || type == CompressionType::kThreshold; }
+};
+
+// Parse the compression of "none", "fp16", "bf16", "topk=<ratio in (0, 1]>" or "threshold=<positive value>".
+bool ParseCompressionConfig(const std::string &spec, CompressionConfig *config);
+
+// The compression set by the environment variable kEnvCollectiveCompression.
+CompressionConfig GlobalCompressionConfig();
+
+std::string CompressionTypeName(CompressionType type);
+
+// The bytes of one element on the wire in the half precision type.
+constexpr size_t kHalfElementSize = 2;
+
+// Convert the float32 data to the half precision type on the wire.
+void EncodeHalf(CompressionType type, const float *input, size_t count, uint16_t *output);
+
+// Convert the half precision data on the wire to float32, add it to the output if accumulate is true.
+void DecodeHalf(CompressionType type, const uint16_t *input, size_t count, float *output, bool accumulate);
+
+// ErrorFeedbackSparsifier selects the elements to pass of the gradients of one parameter. The elements not selected are
+// kept in the residual and added to the gradients of the next step, so no update is lost but delayed.
+class ErrorFeedbackSparsifier {
+ public:
+  ErrorFeedbackSparsifier() = default;
+  ~ErrorFeedbackSparsifier() = default;
+
+  // Add the residual to the gradients, select the elements by the config and keep the others in the residual.
+  void Sparsify(const float *gradients, size_t count, const CompressionConfig &config, std::vector<uint32_t> *indices,
+                std::vector<float> *values);
+
+  const std::vector<float> &residual() const { return residual_; }
+
+ private:
+  std::vector<float> residual_;
+  std::vector<float> accumulation_;
+  std::vector<uint32_t> order_;
+};
+
+// The bytes of the collective data through the network, raw bytes are the size of the float32 data before compression.
+class CollectiveTrafficStats {
+ public:
+  static CollectiveTrafficStats &GetInstance() {
+    static CollectiveTrafficStats instance;
+    return instance;
+  }
+
+  void Record(size_t raw_bytes, size_t wire_bytes) {
+    raw_bytes_ += raw_bytes;
+    wire_bytes_ += wire_bytes;
+  }
+  size_t raw_bytes() const { return raw_bytes_.load(); }
+  size_t wire_bytes() const { return wire_bytes_.load(); }
+
+ private:
+  CollectiveTrafficStats() = default;
+  ~CollectiveTrafficStats() = default;
+
+  std::atomic<size_t> raw_bytes_{0};
+  std::atomic<size_t> wire_bytes_{0};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_COMPRESSION_H_
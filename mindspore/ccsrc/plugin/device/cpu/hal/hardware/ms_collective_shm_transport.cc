@@ -0,0 +1,593 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/ms_collective_shm_transport.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+#include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr uint64_t kShmSegmentMagic = 0x4d53534d52494e47;  // "MSSMRING"
+// The messages are padded to this alignment in the ring, so the elements are never split by the ring end.
+constexpr size_t kShmAlignment = 8;
+// Spin so many rounds without progress before yielding the cpu.
+constexpr size_t kShmSpinCount = 1 << 12;
+constexpr size_t kShmTimeoutCheckMask = (1 << 10) - 1;
+constexpr auto kShmAttachInterval = std::chrono::milliseconds(1);
+
+size_t AlignUp(size_t size) { return (size + kShmAlignment - 1) / kShmAlignment * kShmAlignment; }
+}  // namespace
+
+void SplitChunks(size_t count, size_t chunk_num, std::vector<size_t> *chunk_offsets, std::vector<size_t> *chunk_sizes) {
+  chunk_sizes->assign(chunk_num, count / chunk_num);
+  for (size_t i = 0; i < count % chunk_num; i++) {
+    (*chunk_sizes)[i]++;
+  }
+  chunk_offsets->assign(chunk_num, 0);
+  for (size_t i = 1; i < chunk_num; i++) {
+    (*chunk_offsets)[i] = (*chunk_offsets)[i - 1] + (*chunk_sizes)[i - 1];
+  }
+}
+
+ShmTransport::ShmTransport(const std::string &name, uint32_t rank_id, uint32_t rank_size, size_t ring_size)
+    : name_(name), rank_id_(rank_id), rank_size_(rank_size), ring_size_(ring_size) {}
+
+ShmTransport::~ShmTransport() { Finalize(); }
+
+std::string ShmTransport::SegmentName(uint32_t rank) const { return name_ + "_" + std::to_string(rank); }
+
+size_t ShmTransport::SegmentSize() const {
+  return sizeof(SegmentHeader) + rank_size_ * (sizeof(ShmRingHeader) + ring_size_);
+}
+
+ShmRingHeader *ShmTransport::Ring(uint32_t segment_rank, uint32_t sender_rank) const {
+  auto ring = segments_[segment_rank] + sizeof(SegmentHeader) + sender_rank * (sizeof(ShmRingHeader) + ring_size_);
+  return reinterpret_cast<ShmRingHeader *>(ring);
+}
+
+bool ShmTransport::Initialize(uint32_t timeout) {
+  if (rank_size_ == 0 || rank_id_ >= rank_size_ || ring_size_ == 0 || ring_size_ % kShmAlignment != 0) {
+    MS_LOG(ERROR) << "Invalid shared memory transport, rank id: " << rank_id_ << ", rank size: " << rank_size_
+                  << ", ring size: " << ring_size_;
+    return false;
+  }
+  if (name_.empty() || name_[0] != '/') {
+    MS_LOG(ERROR) << "The shared memory name " << name_ << " should start with '/'.";
+    return false;
+  }
+  segments_.assign(rank_size_, nullptr);
+  if (!CreateSegment()) {
+    Finalize();
+    return false;
+  }
+  for (uint32_t rank = 0; rank < rank_size_; rank++) {
+    if (rank != rank_id_ && !AttachSegment(rank, timeout)) {
+      Finalize();
+      return false;
+    }
+  }
+  if (!WaitForAttached(timeout)) {
+    Finalize();
+    return false;
+  }
+  // All the peers have mapped the segment, the name is not needed any more.
+  (void)shm_unlink(SegmentName(rank_id_).c_str());
+  unlinked_ = true;
+  MS_LOG(INFO) << "The shared memory transport of rank " << rank_id_ << " is initialized, rank size: " << rank_size_
+               << ", ring size: " << ring_size_;
+  return true;
+}
+
+bool ShmTransport::CreateSegment() {
+  auto name = SegmentName(rank_id_);
+  auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Failed to create the shared memory " << name << ", errno: " << errno;
+    return false;
+  }
+  unlinked_ = false;
+  auto size = SegmentSize();
+  // Reserve the pages now, a sparse segment larger than /dev/shm would raise SIGBUS on the first touch of a missing
+  // page. The caller falls back to tcp if there is no space.
+  auto ret = posix_fallocate(fd, 0, SizeToLong(size));
+  if (ret != 0) {
+    if (ret == ENOSPC) {
+      MS_LOG(WARNING) << "There is no space for the shared memory " << name << " of " << size
+                      << " bytes, please enlarge /dev/shm.";
+    } else {
+      MS_LOG(ERROR) << "Failed to allocate the shared memory " << name << " of " << size << " bytes, errno: " << ret;
+    }
+    (void)close(fd);
+    return false;
+  }
+  auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Failed to map the shared memory " << name << ", errno: " << errno;
+    return false;
+  }
+  segments_[rank_id_] = static_cast<uint8_t *>(addr);
+  auto header = reinterpret_cast<SegmentHeader *>(addr);
+  header->attached_num.store(0, std::memory_order_relaxed);
+  for (uint32_t rank = 0; rank < rank_size_; rank++) {
+    auto ring = Ring(rank_id_, rank);
+    ring->head.store(0, std::memory_order_relaxed);
+    ring->tail.store(0, std::memory_order_relaxed);
+  }
+  // The peers use the segment only after they see the magic.
+  header->magic.store(kShmSegmentMagic, std::memory_order_release);
+  return true;
+}
+
+bool ShmTransport::AttachSegment(uint32_t rank, uint32_t timeout) {
+  auto name = SegmentName(rank);
+  auto size = SegmentSize();
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout);
+  while (segments_[rank] == nullptr) {
+    auto fd = shm_open(name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+    struct stat file_stat = {};
+    // The segment may be created but not resized by the peer yet.
+    if (fd >= 0 && fstat(fd, &file_stat) == 0 && LongToSize(file_stat.st_size) == size) {
+      auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      (void)close(fd);
+      if (addr == MAP_FAILED) {
+        MS_LOG(ERROR) << "Failed to map the shared memory " << name << ", errno: " << errno;
+        return false;
+      }
+      segments_[rank] = static_cast<uint8_t *>(addr);
+      break;
+    }
+    if (fd >= 0) {
+      (void)close(fd);
+    }
+    if (std::chrono::steady_clock::now() > deadline) {
+      MS_LOG(ERROR) << "Timed out waiting for the shared memory " << name << " of rank " << rank;
+      return false;
+    }
+    std::this_thread::sleep_for(kShmAttachInterval);
+  }
+  auto header = reinterpret_cast<SegmentHeader *>(segments_[rank]);
+  while (header->magic.load(std::memory_order_acquire) != kShmSegmentMagic) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      MS_LOG(ERROR) << "Timed out waiting for the shared memory " << name << " of rank " << rank << " to be ready.";
+      return false;
+    }
+    std::this_thread::sleep_for(kShmAttachInterval);
+  }
+  (void)header->attached_num.fetch_add(1, std::memory_order_acq_rel);
+  return true;
+}
+
+bool ShmTransport::WaitForAttached(uint32_t timeout) {
+  auto header = reinterpret_cast<SegmentHeader *>(segments_[rank_id_]);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout);
+  while (header->attached_num.load(std::memory_order_acquire) < rank_size_ - 1) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      MS_LOG(ERROR) << "Timed out waiting for the peers to map the shared memory of rank " << rank_id_
+                    << ", mapped peer number: " << header->attached_num.load() << ", rank size: " << rank_size_;
+      return false;
+    }
+    std::this_thread::sleep_for(kShmAttachInterval);
+  }
+  timeout_ = timeout;
+  return true;
+}
+
+void ShmTransport::Finalize() {
+  for (auto &segment : segments_) {
+    if (segment != nullptr) {
+      (void)munmap(segment, SegmentSize());
+      segment = nullptr;
+    }
+  }
+  segments_.clear();
+  if (!unlinked_) {
+    (void)shm_unlink(SegmentName(rank_id_).c_str());
+    unlinked_ = true;
+  }
+}
+
+bool ShmTransport::SendRecv(uint32_t dst_rank, const void *send_buff, size_t send_size, uint32_t src_rank,
+                            size_t recv_size, const ConsumeFunc &consume) {
+  if (segments_.empty() || dst_rank >= rank_size_ || src_rank >= rank_size_) {
+    MS_LOG(ERROR) << "Invalid shared memory send to rank " << dst_rank << " and receive from rank " << src_rank
+                  << ", the transport is initialized: " << !segments_.empty();
+    return false;
+  }
+  if ((send_size > 0 && (send_buff == nullptr || dst_rank == rank_id_)) ||
+      (recv_size > 0 && (!consume || src_rank == rank_id_))) {
+    MS_LOG(ERROR) << "Invalid shared memory send to rank " << dst_rank << " or receive from rank " << src_rank;
+    return false;
+  }
+  // The ring from this rank in the segment of dst rank, and the ring from src rank in the segment of this rank.
+  ShmRingHeader *send_ring = send_size > 0 ? Ring(dst_rank, rank_id_) : nullptr;
+  ShmRingHeader *recv_ring = recv_size > 0 ? Ring(rank_id_, src_rank) : nullptr;
+  auto send_data = static_cast<const uint8_t *>(send_buff);
+  size_t send_total = AlignUp(send_size);
+  size_t recv_total = AlignUp(recv_size);
+  size_t sent = 0;
+  size_t received = 0;
+  uint64_t send_head = send_ring != nullptr ? send_ring->head.load(std::memory_order_relaxed) : 0;
+  uint64_t recv_tail = recv_ring != nullptr ? recv_ring->tail.load(std::memory_order_relaxed) : 0;
+  size_t idle = 0;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_);
+  while (sent < send_total || received < recv_total) {
+    bool progress = false;
+    if (sent < send_total) {
+      size_t space = ring_size_ - static_cast<size_t>(send_head - send_ring->tail.load(std::memory_order_acquire));
+      size_t size = std::min(space, send_total - sent);
+      auto ring_data = reinterpret_cast<uint8_t *>(send_ring + 1);
+      // At most two pieces if the data wraps around the ring end, the padding is not copied.
+      for (size_t copied = 0; copied < size;) {
+        size_t pos = static_cast<size_t>((send_head + copied) % ring_size_);
+        size_t piece = std::min(size - copied, ring_size_ - pos);
+        size_t offset = sent + copied;
+        if (offset < send_size) {
+          auto ret =
+            memcpy_s(ring_data + pos, ring_size_ - pos, send_data + offset, std::min(piece, send_size - offset));
+          if (ret != EOK) {
+            MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+            return false;
+          }
+        }
+        copied += piece;
+      }
+      if (size > 0) {
+        send_head += size;
+        sent += size;
+        send_ring->head.store(send_head, std::memory_order_release);
+        progress = true;
+      }
+    }
+    if (received < recv_total) {
+      size_t available = static_cast<size_t>(recv_ring->head.load(std::memory_order_acquire) - recv_tail);
+      size_t size = std::min(available, recv_total - received);
+      auto ring_data = reinterpret_cast<const uint8_t *>(recv_ring + 1);
+      for (size_t consumed = 0; consumed < size;) {
+        size_t pos = static_cast<size_t>((recv_tail + consumed) % ring_size_);
+        size_t piece = std::min(size - consumed, ring_size_ - pos);
+        size_t offset = received + consumed;
+        if (offset < recv_size) {
+          consume(offset, ring_data + pos, std::min(piece, recv_size - offset));
+        }
+        consumed += piece;
+      }
+      if (size > 0) {
+        recv_tail += size;
+        received += size;
+        recv_ring->tail.store(recv_tail, std::memory_order_release);
+        progress = true;
+      }
+    }
+    if (progress) {
+      idle = 0;
+      continue;
+    }
+    if (++idle < kShmSpinCount) {
+      continue;
+    }
+    std::this_thread::yield();
+    if ((idle & kShmTimeoutCheckMask) == 0 && std::chrono::steady_clock::now() > deadline) {
+      MS_LOG(ERROR) << "Timed out sending to rank " << dst_rank << " and receiving from rank " << src_rank
+                    << " through shared memory, sent bytes: " << sent << "/" << send_total
+                    << ", received bytes: " << received << "/" << recv_total;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ShmTransport::Send(uint32_t dst_rank, const void *send_buff, size_t send_size) {
+  return SendRecv(dst_rank, send_buff, send_size, dst_rank, 0, nullptr);
+}
+
+bool ShmTransport::Recv(uint32_t src_rank, void *recv_buff, size_t recv_size) {
+  MS_ERROR_IF_NULL_W_RET_VAL(recv_buff, false);
+  bool copy_success = true;
+  auto copy = [recv_buff, recv_size, &copy_success](size_t offset, const void *data, size_t size) {
+    auto ret = memcpy_s(static_cast<uint8_t *>(recv_buff) + offset, recv_size - offset, data, size);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      copy_success = false;
+    }
+  };
+  return SendRecv(src_rank, nullptr, 0, src_rank, recv_size, copy) && copy_success;
+}
+
+uint32_t ShmCollectiveOpsImpl::GroupRank(const std::vector<uint32_t> &group_ranks) const {
+  auto iter = std::find(group_ranks.begin(), group_ranks.end(), transport_->rank_id());
+  return static_cast<uint32_t>(iter - group_ranks.begin());
+}
+
+template <typename T>
+bool ShmCollectiveOpsImpl::RingReduceScatter(T *buff, const std::vector<size_t> &chunk_offsets,
+                                             const std::vector<size_t> &chunk_sizes,
+                                             const std::vector<uint32_t> &group_ranks, uint32_t group_rank) {
+  size_t group_size = group_ranks.size();
+  uint32_t send_to_rank = group_ranks[(group_rank + 1) % group_size];
+  uint32_t recv_from_rank = group_ranks[(group_rank + group_size - 1) % group_size];
+  for (size_t i = 0; i < group_size - 1; i++) {
+    // The chunk received in the last step is reduced, send it on.
+    size_t send_chunk_index = (group_rank + 2 * group_size - i - 1) % group_size;
+    size_t recv_chunk_index = (group_rank + 2 * group_size - i - 2) % group_size;
+    T *recv_chunk = buff + chunk_offsets[recv_chunk_index];
+    auto reduce = [recv_chunk](size_t offset, const void *data, size_t size) {
+      T *output = recv_chunk + offset / sizeof(T);
+      const T *input = static_cast<const T *>(data);
+      for (size_t j = 0; j < size / sizeof(T); j++) {
+        output[j] += input[j];
+      }
+    };
+    if (!transport_->SendRecv(send_to_rank, buff + chunk_offsets[send_chunk_index],
+                              chunk_sizes[send_chunk_index] * sizeof(T), recv_from_rank,
+                              chunk_sizes[recv_chunk_index] * sizeof(T), reduce)) {
+      MS_LOG(ERROR) << "Ring ReduceScatter through shared memory failed in iteration " << i;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool ShmCollectiveOpsImpl::RingAllGather(T *buff, const std::vector<size_t> &chunk_offsets,
+                                         const std::vector<size_t> &chunk_sizes,
+                                         const std::vector<uint32_t> &group_ranks, uint32_t group_rank) {
+  size_t group_size = group_ranks.size();
+  uint32_t send_to_rank = group_ranks[(group_rank + 1) % group_size];
+  uint32_t recv_from_rank = group_ranks[(group_rank + group_size - 1) % group_size];
+  for (size_t i = 0; i < group_size - 1; i++) {
+    size_t send_chunk_index = (group_rank + group_size - i) % group_size;
+    size_t recv_chunk_index = (group_rank + 2 * group_size - i - 1) % group_size;
+    T *recv_chunk = buff + chunk_offsets[recv_chunk_index];
+    size_t recv_size = chunk_sizes[recv_chunk_index] * sizeof(T);
+    bool copy_success = true;
+    auto copy = [recv_chunk, recv_size, &copy_success](size_t offset, const void *data, size_t size) {
+      auto ret = memcpy_s(reinterpret_cast<uint8_t *>(recv_chunk) + offset, recv_size - offset, data, size);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+        copy_success = false;
+      }
+    };
+    if (!transport_->SendRecv(send_to_rank, buff + chunk_offsets[send_chunk_index],
+                              chunk_sizes[send_chunk_index] * sizeof(T), recv_from_rank, recv_size, copy) ||
+        !copy_success) {
+      MS_LOG(ERROR) << "Ring AllGather through shared memory failed in iteration " << i;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool ShmCollectiveOpsImpl::AllReduce(const void *sendbuff, void *recvbuff, size_t count,
+                                     const std::vector<uint32_t> &group_ranks) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(transport_, false);
+  auto group_rank = GroupRank(group_ranks);
+  if (group_rank == group_ranks.size()) {
+    MS_LOG(ERROR) << "Rank " << transport_->rank_id() << " is not in the group.";
+    return false;
+  }
+  if (recvbuff != sendbuff) {
+    auto ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  if (group_ranks.size() == 1) {
+    return true;
+  }
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(count, group_ranks.size(), &chunk_offsets, &chunk_sizes);
+  auto buff = static_cast<T *>(recvbuff);
+  return RingReduceScatter(buff, chunk_offsets, chunk_sizes, group_ranks, group_rank) &&
+         RingAllGather(buff, chunk_offsets, chunk_sizes, group_ranks, group_rank);
+}
+
+template <typename T>
+bool ShmCollectiveOpsImpl::ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                         const std::vector<uint32_t> &group_ranks) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(transport_, false);
+  auto group_rank = GroupRank(group_ranks);
+  if (group_rank == group_ranks.size()) {
+    MS_LOG(ERROR) << "Rank " << transport_->rank_id() << " is not in the group.";
+    return false;
+  }
+  // The input is reduced in a copy, so it is kept for the caller.
+  auto input = static_cast<const T *>(sendbuff);
+  std::vector<T> buff(input, input + recv_count * group_ranks.size());
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(buff.size(), group_ranks.size(), &chunk_offsets, &chunk_sizes);
+  if (group_ranks.size() > 1 && !RingReduceScatter(buff.data(), chunk_offsets, chunk_sizes, group_ranks, group_rank)) {
+    return false;
+  }
+  auto ret =
+    memcpy_s(recvbuff, recv_count * sizeof(T), buff.data() + chunk_offsets[group_rank], recv_count * sizeof(T));
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool ShmCollectiveOpsImpl::ReduceScatterInPlace(T *buff, size_t count, const std::vector<uint32_t> &group_ranks) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(transport_, false);
+  auto group_rank = GroupRank(group_ranks);
+  if (group_rank == group_ranks.size()) {
+    MS_LOG(ERROR) << "Rank " << transport_->rank_id() << " is not in the group.";
+    return false;
+  }
+  if (group_ranks.size() == 1) {
+    return true;
+  }
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(count, group_ranks.size(), &chunk_offsets, &chunk_sizes);
+  return RingReduceScatter(buff, chunk_offsets, chunk_sizes, group_ranks, group_rank);
+}
+
+template <typename T>
+bool ShmCollectiveOpsImpl::AllGatherInPlace(T *buff, size_t count, const std::vector<uint32_t> &group_ranks) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(transport_, false);
+  auto group_rank = GroupRank(group_ranks);
+  if (group_rank == group_ranks.size()) {
+    MS_LOG(ERROR) << "Rank " << transport_->rank_id() << " is not in the group.";
+    return false;
+  }
+  if (group_ranks.size() == 1) {
+    return true;
+  }
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(count, group_ranks.size(), &chunk_offsets, &chunk_sizes);
+  return RingAllGather(buff, chunk_offsets, chunk_sizes, group_ranks, group_rank);
+}
+
+template <typename T>
+bool ShmCollectiveOpsImpl::AllGather(const void *sendbuff, void *recvbuff, size_t send_count,
+                                     const std::vector<uint32_t> &group_ranks) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(transport_, false);
+  auto group_rank = GroupRank(group_ranks);
+  if (group_rank == group_ranks.size()) {
+    MS_LOG(ERROR) << "Rank " << transport_->rank_id() << " is not in the group.";
+    return false;
+  }
+  auto buff = static_cast<T *>(recvbuff);
+  auto ret = memcpy_s(buff + group_rank * send_count, send_count * sizeof(T), sendbuff, send_count * sizeof(T));
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  if (group_ranks.size() == 1) {
+    return true;
+  }
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(send_count * group_ranks.size(), group_ranks.size(), &chunk_offsets, &chunk_sizes);
+  return RingAllGather(buff, chunk_offsets, chunk_sizes, group_ranks, group_rank);
+}
+
+template <typename T>
+bool ShmCollectiveOpsImpl::Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                     const std::vector<uint32_t> &group_ranks) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(transport_, false);
+  auto group_rank = GroupRank(group_ranks);
+  size_t group_size = group_ranks.size();
+  if (group_rank == group_size || root >= group_size) {
+    MS_LOG(ERROR) << "Rank " << transport_->rank_id() << " or the root " << root << " is not in the group.";
+    return false;
+  }
+  size_t size = count * sizeof(T);
+  if (group_rank == root && recvbuff != sendbuff) {
+    auto ret = memcpy_s(recvbuff, size, sendbuff, size);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  if (group_size == 1) {
+    return true;
+  }
+  // The data is passed along the chain from the root in segments, so the ranks forward one segment while receiving
+  // the next one.
+  size_t segment = std::max(transport_->ring_size() / 2 / kShmAlignment * kShmAlignment, kShmAlignment);
+  uint32_t send_to_rank = group_ranks[(group_rank + 1) % group_size];
+  uint32_t recv_from_rank = group_ranks[(group_rank + group_size - 1) % group_size];
+  bool forward = (group_rank + 1) % group_size != root;
+  auto input = static_cast<const uint8_t *>(sendbuff);
+  auto output = static_cast<uint8_t *>(recvbuff);
+  for (size_t offset = 0; offset < size; offset += segment) {
+    size_t segment_size = std::min(segment, size - offset);
+    if (group_rank == root) {
+      if (!transport_->Send(send_to_rank, input + offset, segment_size)) {
+        MS_LOG(ERROR) << "Broadcast through shared memory failed to send to rank " << send_to_rank;
+        return false;
+      }
+      continue;
+    }
+    if (!transport_->Recv(recv_from_rank, output + offset, segment_size)) {
+      MS_LOG(ERROR) << "Broadcast through shared memory failed to receive from rank " << recv_from_rank;
+      return false;
+    }
+    if (forward && !transport_->Send(send_to_rank, output + offset, segment_size)) {
+      MS_LOG(ERROR) << "Broadcast through shared memory failed to send to rank " << send_to_rank;
+      return false;
+    }
+  }
+  return true;
+}
+
+template bool ShmCollectiveOpsImpl::AllReduce<float>(const void *sendbuff, void *recvbuff, size_t count,
+                                                     const std::vector<uint32_t> &group_ranks);
+template bool ShmCollectiveOpsImpl::ReduceScatter<float>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                         const std::vector<uint32_t> &group_ranks);
+
+template bool ShmCollectiveOpsImpl::ReduceScatterInPlace<float>(float *buff, size_t count,
+                                                                const std::vector<uint32_t> &group_ranks);
+template bool ShmCollectiveOpsImpl::AllGatherInPlace<float>(float *buff, size_t count,
+                                                            const std::vector<uint32_t> &group_ranks);
+
+template bool ShmCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count,
+                                                     const std::vector<uint32_t> &group_ranks);
+template bool ShmCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count,
+                                                        const std::vector<uint32_t> &group_ranks);
+template bool ShmCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count,
+                                                   const std::vector<uint32_t> &group_ranks);
+template bool ShmCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count,
+                                                    const std::vector<uint32_t> &group_ranks);
+
+template bool ShmCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count,
+                                                     uint32_t root, const std::vector<uint32_t> &group_ranks);
+template bool ShmCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                        uint32_t root, const std::vector<uint32_t> &group_ranks);
+template bool ShmCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                   const std::vector<uint32_t> &group_ranks);
+template bool ShmCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                    const std::vector<uint32_t> &group_ranks);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_SHM_TRANSPORT_H_
+#define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_SHM_TRANSPORT_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Set this environment variable to 1 to send the collective data through tcp even if the ranks are on one host.
+constexpr char kEnvDisableShmCollective[] = "MS_DISABLE_SHM_COLLECTIVE";
+// Set this environment variable to the bytes of the ring buffer of every rank pair.
+constexpr char kEnvShmRingSize[] = "MS_SHM_RING_SIZE";
+constexpr size_t kDefaultShmRingSize = 1 << 22;
+// The timeout in seconds of waiting for the peer, same as the collective communication over tcp.
+constexpr uint32_t kShmCollectiveTimeout = 30;
+
+// Split count elements into chunk_num chunks, the first ones get the remainder.
+void SplitChunks(size_t count, size_t chunk_num, std::vector<size_t> *chunk_offsets, std::vector<size_t> *chunk_sizes);
+
+// The ring buffer from one sender to one receiver. Only the sender writes head and only the receiver writes tail,
+// so the ring is lock-free. Both are the total bytes passed, the data is at their offset modulo the ring size.
+struct ShmRingHeader {
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+};
+
+// ShmTransport passes the collective data between the processes on one host through shared memory, which is much
+// faster than the loopback tcp. Every rank creates one segment holding the rings from all the other ranks to it and
+// maps the segments of the other ranks to send to them. The segment name is removed once all the peers have mapped it,
+// so nothing is left in /dev/shm after the process exits.
+class ShmTransport {
+ public:
+  // The consumer of the received bytes, which are the message bytes [offset, offset + size). A piece starts at a
+  // multiple of 8 bytes and the ring is 8 bytes aligned, so an element of at most 8 bytes is never split.
+  using ConsumeFunc = std::function<void(size_t offset, const void *data, size_t size)>;
+
+  // The segment names are "name_<rank>", the name must start with '/' and be unique for the job.
+  ShmTransport(const std::string &name, uint32_t rank_id, uint32_t rank_size, size_t ring_size = kDefaultShmRingSize);
+  ~ShmTransport();
+
+  // Create the segment of this rank and map the segments of the other ranks, wait at most timeout seconds for them.
+  bool Initialize(uint32_t timeout = kShmCollectiveTimeout);
+  void Finalize();
+
+  // Send send_size bytes to dst_rank and receive recv_size bytes from src_rank at the same time, the ranks of a ring
+  // don't block each other if the data is larger than the ring. Either size can be 0.
+  bool SendRecv(uint32_t dst_rank, const void *send_buff, size_t send_size, uint32_t src_rank, size_t recv_size,
+                const ConsumeFunc &consume);
+  bool Send(uint32_t dst_rank, const void *send_buff, size_t send_size);
+  bool Recv(uint32_t src_rank, void *recv_buff, size_t recv_size);
+
+  uint32_t rank_id() const { return rank_id_; }
+  uint32_t rank_size() const { return rank_size_; }
+  size_t ring_size() const { return ring_size_; }
+
+ private:
+  // The header of a segment, followed by the rings from every rank.
+  struct SegmentHeader {
+    alignas(64) std::atomic<uint64_t> magic;
+    alignas(64) std::atomic<uint32_t> attached_num;
+  };
+
+  std::string SegmentName(uint32_t rank) const;
+  size_t SegmentSize() const;
+  ShmRingHeader *Ring(uint32_t segment_rank, uint32_t sender_rank) const;
+  bool CreateSegment();
+  bool AttachSegment(uint32_t rank, uint32_t timeout);
+  bool WaitForAttached(uint32_t timeout);
+
+  std::string name_;
+  uint32_t rank_id_;
+  uint32_t rank_size_;
+  size_t ring_size_;
+  // The mapped segment of every rank.
+  std::vector<uint8_t *> segments_;
+  bool unlinked_{true};
+  uint32_t timeout_{kShmCollectiveTimeout};
+};
+
+// ShmCollectiveOpsImpl implements the collective communication over the ShmTransport. AllReduce and ReduceScatter use
+// the ring algorithm which reduces the received chunk right out of the shared ring without copy, Broadcast pipelines
+// the data along a chain of the ranks. The group is the global ranks of the processes in the order of group ranks.
+class ShmCollectiveOpsImpl {
+ public:
+  explicit ShmCollectiveOpsImpl(const std::shared_ptr<ShmTransport> &transport) : transport_(transport) {}
+  ~ShmCollectiveOpsImpl() = default;
+
+  template <typename T>
+  bool AllReduce(const void *sendbuff, void *recvbuff, size_t count, const std::vector<uint32_t> &group_ranks);
+
+  template <typename T>
+  bool AllGather(const void *sendbuff, void *recvbuff, size_t send_count, const std::vector<uint32_t> &group_ranks);
+
+  // The parameter "root" is the group rank of the root process.
+  template <typename T>
+  bool Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                 const std::vector<uint32_t> &group_ranks);
+
+  template <typename T>
+  bool ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count, const std::vector<uint32_t> &group_ranks);
+
+  // The two halves of AllReduce in place, the hierarchical AllReduce reduces the chunks across the hosts between them.
+  // The buff is split into group size chunks by SplitChunks, the group rank r reduces and owns the chunk r.
+  template <typename T>
+  bool ReduceScatterInPlace(T *buff, size_t count, const std::vector<uint32_t> &group_ranks);
+  template <typename T>
+  bool AllGatherInPlace(T *buff, size_t count, const std::vector<uint32_t> &group_ranks);
+
+ private:
+  ShmCollectiveOpsImpl(const ShmCollectiveOpsImpl &) = delete;
+  ShmCollectiveOpsImpl &operator=(const ShmCollectiveOpsImpl &) = delete;
+
+  // Return the group rank of this process, or group size if it is not in the group.
+  uint32_t GroupRank(const std::vector<uint32_t> &group_ranks) const;
+
+  // After this, the group rank r has the reduced chunk r.
+  template <typename T>
+  bool RingReduceScatter(T *buff, const std::vector<size_t> &chunk_offsets, const std::vector<size_t> &chunk_sizes,
+                         const std::vector<uint32_t> &group_ranks, uint32_t group_rank);
+
+  // Before this, the group rank r has the chunk r.
+  template <typename T>
+  bool RingAllGather(T *buff, const std::vector<size_t> &chunk_offsets, const std::vector<size_t> &chunk_sizes,
+                     const std::vector<uint32_t> &group_ranks, uint32_t group_rank);
+
+  std::shared_ptr<ShmTransport> transport_;
+
+  // The mutex to ensure that collective communication is threadsafe.
+  std::mutex mtx_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_MS_COLLECTIVE_SHM_TRANSPORT_H_
@@ -56,6 +56,15 @@ bool AllReduceCPUKernelMod::Init(const BaseOperatorPtr &base_operator, const std
   if (reduce_op != kSupportedReduceOp) {
     MS_LOG(EXCEPTION) << kernel_name_ << " only support reduce sum on CPU, but got " << reduce_op;
   }
+  auto compression = prim->GetAttr(device::cpu::kAttrCollectiveCompression);
+  if (compression != nullptr) {
+    auto compression_spec = GetValue<std::string>(compression);
+    if (!device::cpu::ParseCompressionConfig(compression_spec, &compression_)) {
+      MS_LOG(EXCEPTION) << kernel_name_ << " got invalid compression " << compression_spec;
+    }
+  } else {
+    compression_ = device::cpu::GlobalCompressionConfig();
+  }
 #else
   MS_LOG(EXCEPTION) << "The CPU kernel allreduce is only supported on linux platform.";
 #endif
@@ -79,8 +88,15 @@ bool AllReduceCPUKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs
   for (size_t i = 0; i < inputs.size(); ++i) {
     data_size += inputs[i]->size;
   }
-  bool ret = MsCollectiveCommLib::GetInstance().AllReduce(inputs[0]->addr, outputs[0]->addr, data_size,
-                                                          kNumberTypeFloat32, Reduce_Sum, kMCCLGlobalGroupName);
+  bool ret = false;
+  if (compression_.type != device::cpu::CompressionType::kNone) {
+    ret = MsCollectiveCommLib::GetInstance().CompressedAllReduce(inputs[0]->addr, outputs[0]->addr,
+                                                                 data_size / sizeof(float), compression_, &sparsifier_,
+                                                                 kMCCLGlobalGroupName);
+  } else {
+    ret = MsCollectiveCommLib::GetInstance().AllReduce(inputs[0]->addr, outputs[0]->addr, data_size,
+                                                       kNumberTypeFloat32, Reduce_Sum, kMCCLGlobalGroupName);
+  }
   if (!ret) {
     MS_LOG(ERROR) << "AllReduceCPUKernelMod launch failed.";
   }
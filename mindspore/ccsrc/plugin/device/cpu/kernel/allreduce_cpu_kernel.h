@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_compression.h"
 #include "plugin/factory/ms_factory.h"
 
 namespace mindspore {
@@ -37,6 +38,11 @@ class AllReduceCPUKernelMod : public NativeCpuKernelMod {
               const std::vector<AddressPtr> &outputs) override;
 
   std::vector<KernelAttr> GetOpSupport() override;
+
+ private:
+  device::cpu::CompressionConfig compression_;
+  // The error feedback of the sparse compression of this parameter.
+  device::cpu::ErrorFeedbackSparsifier sparsifier_;
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -0,0 +1,520 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/kernel/interpreter/fused_graph_interpreter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "backend/common/graph_kernel/model/op_node.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "nnacl/fp32/arithmetic_fp32.h"
+#include "nnacl/fp32/arithmetic_self_fp32.h"
+#include "nnacl/fp32/exp_fp32.h"
+
+namespace mindspore {
+namespace kernel {
+namespace inner = graphkernel::inner;
+namespace {
+// The element number of one block, the block buffers of a stage are expected to stay in the cache.
+constexpr size_t kBlockSize = 1024;
+constexpr char kReshape[] = "Reshape";
+constexpr char kBroadcastTo[] = "BroadcastTo";
+constexpr char kAttrAxis[] = "axis";
+
+ShapeVector NormShape(const ShapeVector &shape) { return shape.empty() ? ShapeVector{1} : shape; }
+
+size_t ShapeSize(const ShapeVector &shape) {
+  return LongToSize(std::accumulate(shape.begin(), shape.end(), int64_t(1), std::multiplies<int64_t>()));
+}
+
+// The strides of the tensor broadcast to the loop shape.
+ShapeVector BroadcastStrides(const ShapeVector &shape, const ShapeVector &loop_shape) {
+  auto src_shape = NormShape(shape);
+  while (src_shape.size() > loop_shape.size() && src_shape.front() == 1) {
+    (void)src_shape.erase(src_shape.begin());
+  }
+  if (src_shape.size() > loop_shape.size()) {
+    MS_LOG(EXCEPTION) << "Can not broadcast shape " << shape << " to " << loop_shape;
+  }
+  ShapeVector strides(loop_shape.size(), 0);
+  int64_t stride = 1;
+  for (size_t i = 1; i <= src_shape.size(); ++i) {
+    auto src_dim = src_shape[src_shape.size() - i];
+    auto loop_dim_index = loop_shape.size() - i;
+    if (src_dim == loop_shape[loop_dim_index]) {
+      strides[loop_dim_index] = stride;
+    } else if (src_dim != 1) {
+      MS_LOG(EXCEPTION) << "Can not broadcast shape " << shape << " to " << loop_shape;
+    }
+    stride *= src_dim;
+  }
+  return strides;
+}
+
+// The strides of the reduce output in the loop dims, the empty axis means reducing all the dims.
+ShapeVector ReduceStrides(const ShapeVector &loop_shape, const ValuePtr &axis_value) {
+  MS_EXCEPTION_IF_NULL(axis_value);
+  std::vector<int64_t> axis;
+  if (axis_value->isa<ValueSequence>()) {
+    axis = GetValue<std::vector<int64_t>>(axis_value);
+  } else {
+    axis.push_back(GetValue<int64_t>(axis_value));
+  }
+  auto rank = SizeToLong(loop_shape.size());
+  std::set<int64_t> reduce_axis;
+  for (auto a : axis) {
+    (void)reduce_axis.insert(a < 0 ? a + rank : a);
+  }
+  ShapeVector strides(loop_shape.size(), 0);
+  int64_t stride = 1;
+  for (int64_t i = rank - 1; i >= 0; --i) {
+    if (!reduce_axis.empty() && reduce_axis.count(i) == 0) {
+      strides[LongToSize(i)] = stride;
+      stride *= loop_shape[LongToSize(i)];
+    }
+  }
+  return strides;
+}
+
+// Visit the elements [start, start + count) of the loop shape by the runs along the last dim. The func is called with
+// the buffer offset of the first element in the run, the position of it in the block and the run length.
+template <typename Func>
+void ForEachRun(const ShapeVector &loop_shape, const ShapeVector &strides, size_t start, size_t count,
+                const Func &func) {
+  const size_t last = loop_shape.size() - 1;
+  ShapeVector coords(loop_shape.size(), 0);
+  int64_t offset = 0;
+  auto rest = SizeToLong(start);
+  for (size_t i = loop_shape.size(); i > 0; --i) {
+    coords[i - 1] = rest % loop_shape[i - 1];
+    rest /= loop_shape[i - 1];
+    offset += coords[i - 1] * strides[i - 1];
+  }
+  size_t pos = 0;
+  while (pos < count) {
+    auto len = std::min(count - pos, LongToSize(loop_shape[last] - coords[last]));
+    func(offset, pos, len);
+    pos += len;
+    offset += SizeToLong(len) * strides[last];
+    coords[last] += SizeToLong(len);
+    for (size_t i = last; i > 0 && coords[i] == loop_shape[i]; --i) {
+      offset -= coords[i] * strides[i];
+      coords[i] = 0;
+      coords[i - 1] += 1;
+      offset += strides[i - 1];
+    }
+  }
+}
+
+template <typename Op>
+void ReduceBlock(const ShapeVector &loop_shape, const ShapeVector &strides, size_t start, size_t count,
+                 const float *input, float *output, const Op &op) {
+  const auto inner_stride = strides.back();
+  ForEachRun(loop_shape, strides, start, count, [&](int64_t offset, size_t pos, size_t len) {
+    if (inner_stride == 0) {
+      auto acc = output[offset];
+      for (size_t i = 0; i < len; ++i) {
+        acc = op(acc, input[pos + i]);
+      }
+      output[offset] = acc;
+      return;
+    }
+    for (size_t i = 0; i < len; ++i) {
+      auto &out = output[offset + SizeToLong(i) * inner_stride];
+      out = op(out, input[pos + i]);
+    }
+  });
+}
+
+void Identity(const float *input, float *output, int size) {
+  (void)memcpy(output, input, IntToSize(size) * sizeof(float));
+}
+
+// The nnacl functions stop at the first input out of the domain and their simd parts don't check the domain, so the
+// block with such inputs is computed by the scalar function, which writes NaN or inf the same as the single op kernels.
+template <int (*SimdFunc)(const float *, float *, int), float (*ScalarFunc)(float), bool (*InDomain)(float)>
+void UnaryWithDomainCheck(const float *input, float *output, int size) {
+  if (std::all_of(input, input + size, InDomain)) {
+    (void)SimdFunc(input, output, size);
+    return;
+  }
+  (void)std::transform(input, input + size, output, ScalarFunc);
+}
+
+bool IsPositive(float x) { return x > 0; }
+bool IsNonNegative(float x) { return x >= 0; }
+bool IsNonZero(float x) { return x < 0 || x > 0; }
+float ScalarLog(float x) { return std::log(x); }
+float ScalarSqrt(float x) { return std::sqrt(x); }
+float ScalarRsqrt(float x) { return 1.0f / std::sqrt(x); }
+float ScalarReciprocal(float x) { return 1.0f / x; }
+
+// Keep the same with the ops supported by graphkernel::InterpreterSupported.
+const std::map<std::string, void (*)(const float *, float *, int)> &UnaryFuncs() {
+  static const std::map<std::string, void (*)(const float *, float *, int)> funcs = {
+    {"Abs", [](const float *in, float *out, int size) { (void)ElementAbs(in, out, size); }},
+    {"Neg", [](const float *in, float *out, int size) { (void)ElementNegative(in, out, size); }},
+    {"Exp", [](const float *in, float *out, int size) { ExpFp32(in, out, size); }},
+    {"Log", UnaryWithDomainCheck<ElementLog, ScalarLog, IsPositive>},
+    {"Sqrt", UnaryWithDomainCheck<ElementSqrt, ScalarSqrt, IsNonNegative>},
+    {"Rsqrt", UnaryWithDomainCheck<ElementRsqrt, ScalarRsqrt, IsPositive>},
+    {"Reciprocal", UnaryWithDomainCheck<ElementReciprocal, ScalarReciprocal, IsNonZero>},
+    {"Tanh", [](const float *in, float *out, int size) { (void)Tanh(in, size, out); }},
+    {"Sigmoid", [](const float *in, float *out, int size) { (void)Sigmoid(in, size, out); }},
+  };
+  return funcs;
+}
+
+const std::map<std::string, void (*)(const float *, const float *, float *, int)> &BinaryFuncs() {
+  static const std::map<std::string, void (*)(const float *, const float *, float *, int)> funcs = {
+    {"Add", [](const float *in0, const float *in1, float *out, int size) { (void)ElementAdd(in0, in1, out, size); }},
+    {"Sub", [](const float *in0, const float *in1, float *out, int size) { (void)ElementSub(in0, in1, out, size); }},
+    {"Mul", [](const float *in0, const float *in1, float *out, int size) { (void)ElementMul(in0, in1, out, size); }},
+    {"RealDiv",
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementDiv(in0, in1, out, size); }},
+    {"Div", [](const float *in0, const float *in1, float *out, int size) { (void)ElementDiv(in0, in1, out, size); }},
+    {"Maximum",
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementMaximum(in0, in1, out, size); }},
+    {"Minimum",
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementMinimum(in0, in1, out, size); }},
+  };
+  return funcs;
+}
+
+const std::map<std::string, std::pair<int, float>> &ReduceTypes() {
+  static const std::map<std::string, std::pair<int, float>> types = {
+    {"ReduceSum", {0, 0.0f}},
+    {"ReduceMax", {1, -std::numeric_limits<float>::infinity()}},
+    {"ReduceMin", {2, std::numeric_limits<float>::infinity()}},
+  };
+  return types;
+}
+}  // namespace
+
+struct FusedGraphInterpreter::ValueInfo {
+  // The stage computing the value, -1 for the inputs and constants.
+  int stage{-1};
+  // The value is computed in block, otherwise it's materialized in memory.
+  bool in_block{false};
+  // The materialized value can be used since this stage.
+  int ready_stage{0};
+  // The value computed in block should be written to memory.
+  bool need_store{false};
+  bool has_buffer{false};
+  Buffer buffer;
+  // The value shares the memory with the alias, such as the output of reshape.
+  inner::Node *alias{nullptr};
+};
+
+void FusedGraphInterpreter::Compile(const inner::LiteGraphPtr &lite_graph) {
+  MS_EXCEPTION_IF_NULL(lite_graph);
+  stages_.clear();
+  const_tensors_.clear();
+  reduce_inits_.clear();
+  output_copies_.clear();
+  input_size_list_.clear();
+  output_size_list_.clear();
+  workspace_size_list_.clear();
+
+  // The references of unordered_map elements keep valid after inserting.
+  std::unordered_map<inner::Node *, ValueInfo> values;
+  const auto &inputs = lite_graph->inputs();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    auto &info = values[inputs[i].get()];
+    info.has_buffer = true;
+    info.buffer = {BufferType::kInput, i};
+    input_size_list_.push_back(inputs[i]->tensor_size(true));
+  }
+  auto get_value = [&values, this](const inner::NodePtr &node) -> ValueInfo & {
+    auto iter = values.find(node.get());
+    if (iter != values.end()) {
+      return iter->second;
+    }
+    if (node->NodeType() != inner::NType::Value) {
+      MS_LOG(EXCEPTION) << "The node " << node->debug_name() << " is not visited before its users.";
+    }
+    auto &info = values[node.get()];
+    info.has_buffer = true;
+    info.buffer = {BufferType::kConst, const_tensors_.size()};
+    const_tensors_.push_back(std::static_pointer_cast<inner::ConstTensorNode>(node)->data());
+    return info;
+  };
+
+  // Divide the ops into stages. The op joins the current stage when it has the same loop shape and all of its
+  // materialized inputs are ready, the values computed in block by the previous stages are stored to memory.
+  const auto &ops = lite_graph->ops();
+  int cur_stage = -1;
+  for (const auto &op : ops) {
+    const auto &op_name = std::static_pointer_cast<inner::PrimOp>(op)->op();
+    auto &info = values[op.get()];
+    if (op_name == kReshape) {
+      auto &input_info = get_value(op->input(0));
+      input_info.need_store = input_info.need_store || input_info.in_block;
+      info.alias = input_info.alias != nullptr ? input_info.alias : op->input(0).get();
+      info.ready_stage = input_info.in_block ? input_info.stage + 1 : input_info.ready_stage;
+      continue;
+    }
+    bool is_reduce = ReduceTypes().count(op_name) != 0;
+    auto loop_shape = NormShape(is_reduce ? op->input(0)->shape : op->shape);
+    bool join = cur_stage >= 0 && loop_shape == stages_.back().loop_shape &&
+                std::all_of(op->inputs().begin(), op->inputs().end(), [&get_value, cur_stage](const auto &input) {
+                  const auto &input_info = get_value(input);
+                  return input_info.in_block || input_info.ready_stage <= cur_stage;
+                });
+    if (!join) {
+      ++cur_stage;
+      Stage stage;
+      stage.loop_shape = loop_shape;
+      stage.loop_size = ShapeSize(loop_shape);
+      stages_.push_back(std::move(stage));
+    }
+    for (const auto &input : op->inputs()) {
+      auto &input_info = get_value(input);
+      input_info.need_store = input_info.need_store || (input_info.in_block && input_info.stage != cur_stage);
+    }
+    info.stage = cur_stage;
+    info.in_block = !is_reduce;
+    info.ready_stage = is_reduce ? cur_stage + 1 : cur_stage;
+    info.need_store = is_reduce;
+  }
+
+  // The values computed by the stages are written to the outputs directly, others are copied at last.
+  std::vector<std::pair<inner::Node *, size_t>> copies;
+  const auto &outputs = lite_graph->GetOutputs();
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    output_size_list_.push_back(outputs[i]->tensor_size(true));
+    auto &info = get_value(outputs[i]);
+    if (info.stage >= 0 && !info.has_buffer) {
+      info.need_store = true;
+      info.has_buffer = true;
+      info.buffer = {BufferType::kOutput, i};
+    } else {
+      (void)copies.emplace_back(outputs[i].get(), i);
+    }
+  }
+  for (const auto &op : ops) {
+    auto &info = values[op.get()];
+    if (info.need_store && !info.has_buffer) {
+      info.has_buffer = true;
+      info.buffer = {BufferType::kWorkspace, workspace_size_list_.size()};
+      workspace_size_list_.push_back(op->tensor_size(true));
+    }
+  }
+  auto buffer_of = [&values](inner::Node *node) {
+    const auto &info = values[node];
+    const auto &buffer_info = info.alias != nullptr ? values[info.alias] : info;
+    if (!buffer_info.has_buffer) {
+      MS_LOG(EXCEPTION) << "The node " << node->debug_name() << " is not materialized.";
+    }
+    return buffer_info.buffer;
+  };
+  for (const auto &[node, index] : copies) {
+    (void)output_copies_.emplace_back(OutputCopy{buffer_of(node), index});
+  }
+
+  // Generate the instructions of the stages.
+  std::vector<std::unordered_map<inner::Node *, size_t>> stage_regs(stages_.size());
+  for (const auto &op : ops) {
+    const auto &info = values[op.get()];
+    if (info.stage < 0) {
+      continue;
+    }
+    auto &stage = stages_[IntToSize(info.stage)];
+    auto &regs = stage_regs[IntToSize(info.stage)];
+    auto input_reg = [&stage, &regs, &buffer_of](const inner::NodePtr &input) {
+      auto iter = regs.find(input.get());
+      if (iter != regs.end()) {
+        return iter->second;
+      }
+      Instr load;
+      load.type = InstrType::kLoad;
+      load.out = stage.reg_num++;
+      load.src = buffer_of(input.get());
+      load.strides = BroadcastStrides(input->shape, stage.loop_shape);
+      load.contiguous = ShapeSize(input->shape) == stage.loop_size;
+      stage.instrs.push_back(load);
+      regs[input.get()] = load.out;
+      return load.out;
+    };
+
+    const auto &op_name = std::static_pointer_cast<inner::PrimOp>(op)->op();
+    Instr instr;
+    instr.store = info.need_store;
+    if (info.need_store) {
+      instr.dst = info.buffer;
+    }
+    auto reduce_iter = ReduceTypes().find(op_name);
+    if (reduce_iter != ReduceTypes().end()) {
+      auto axis_iter = op->attrs().find(kAttrAxis);
+      if (axis_iter == op->attrs().end()) {
+        MS_LOG(EXCEPTION) << "The attr axis of op " << op->debug_name() << " does not exist.";
+      }
+      instr.type = InstrType::kReduce;
+      instr.in0 = input_reg(op->input(0));
+      instr.reduce = static_cast<ReduceType>(reduce_iter->second.first);
+      instr.strides = ReduceStrides(stage.loop_shape, axis_iter->second);
+      stage.instrs.push_back(instr);
+      stage.has_reduce = true;
+      (void)reduce_inits_.emplace_back(ReduceInit{info.buffer, reduce_iter->second.second, ShapeSize(op->shape)});
+      continue;
+    }
+    if (op_name == kBroadcastTo) {
+      auto in_reg = input_reg(op->input(0));
+      if (!info.need_store) {
+        regs[op.get()] = in_reg;
+        continue;
+      }
+      instr.type = InstrType::kUnary;
+      instr.unary = Identity;
+      instr.in0 = in_reg;
+    } else if (auto unary_iter = UnaryFuncs().find(op_name); unary_iter != UnaryFuncs().end()) {
+      instr.type = InstrType::kUnary;
+      instr.unary = unary_iter->second;
+      instr.in0 = input_reg(op->input(0));
+    } else if (auto binary_iter = BinaryFuncs().find(op_name); binary_iter != BinaryFuncs().end()) {
+      instr.type = InstrType::kBinary;
+      instr.binary = binary_iter->second;
+      instr.in0 = input_reg(op->input(0));
+      instr.in1 = input_reg(op->input(1));
+    } else {
+      MS_LOG(EXCEPTION) << "The op " << op_name << " is not supported by the interpreter.";
+    }
+    instr.out = stage.reg_num++;
+    stage.instrs.push_back(instr);
+    regs[op.get()] = instr.out;
+  }
+  MS_LOG(INFO) << "Compile the fused graph " << lite_graph->name() << " to " << stages_.size() << " stages with "
+               << workspace_size_list_.size() << " workspaces.";
+}
+
+float *FusedGraphInterpreter::GetAddr(const Buffer &buffer, const std::vector<float *> &inputs,
+                                      const std::vector<float *> &workspaces,
+                                      const std::vector<float *> &outputs) const {
+  switch (buffer.type) {
+    case BufferType::kInput:
+      return inputs[buffer.index];
+    case BufferType::kOutput:
+      return outputs[buffer.index];
+    case BufferType::kWorkspace:
+      return workspaces[buffer.index];
+    case BufferType::kConst:
+      return static_cast<float *>(const_tensors_[buffer.index]->data_c());
+    default:
+      MS_LOG(EXCEPTION) << "Invalid buffer type " << static_cast<int>(buffer.type);
+  }
+}
+
+void FusedGraphInterpreter::RunStage(const Stage &stage, size_t begin, size_t end, const std::vector<float *> &inputs,
+                                     const std::vector<float *> &workspaces,
+                                     const std::vector<float *> &outputs) const {
+  std::vector<float> scratch(stage.reg_num * kBlockSize);
+  std::vector<const float *> regs(stage.reg_num, nullptr);
+  for (size_t block = begin; block < end; ++block) {
+    const size_t start = block * kBlockSize;
+    const size_t count = std::min(kBlockSize, stage.loop_size - start);
+    for (const auto &instr : stage.instrs) {
+      float *result = scratch.data() + instr.out * kBlockSize;
+      if (instr.store) {
+        result = GetAddr(instr.dst, inputs, workspaces, outputs) + start;
+      }
+      switch (instr.type) {
+        case InstrType::kLoad: {
+          const float *src = GetAddr(instr.src, inputs, workspaces, outputs);
+          if (instr.contiguous) {
+            // Read the source in place.
+            regs[instr.out] = src + start;
+            continue;
+          }
+          const auto inner_stride = instr.strides.back();
+          ForEachRun(stage.loop_shape, instr.strides, start, count, [&](int64_t offset, size_t pos, size_t len) {
+            if (inner_stride == 0) {
+              std::fill(result + pos, result + pos + len, src[offset]);
+            } else if (inner_stride == 1) {
+              (void)memcpy(result + pos, src + offset, len * sizeof(float));
+            } else {
+              for (size_t i = 0; i < len; ++i) {
+                result[pos + i] = src[offset + SizeToLong(i) * inner_stride];
+              }
+            }
+          });
+          break;
+        }
+        case InstrType::kUnary:
+          instr.unary(regs[instr.in0], result, SizeToInt(count));
+          break;
+        case InstrType::kBinary:
+          instr.binary(regs[instr.in0], regs[instr.in1], result, SizeToInt(count));
+          break;
+        case InstrType::kReduce: {
+          float *output = GetAddr(instr.dst, inputs, workspaces, outputs);
+          if (instr.reduce == ReduceType::kSum) {
+            ReduceBlock(stage.loop_shape, instr.strides, start, count, regs[instr.in0], output,
+                        [](float a, float b) { return a + b; });
+          } else if (instr.reduce == ReduceType::kMax) {
+            ReduceBlock(stage.loop_shape, instr.strides, start, count, regs[instr.in0], output,
+                        [](float a, float b) { return std::max(a, b); });
+          } else {
+            ReduceBlock(stage.loop_shape, instr.strides, start, count, regs[instr.in0], output,
+                        [](float a, float b) { return std::min(a, b); });
+          }
+          continue;
+        }
+        default:
+          MS_LOG(EXCEPTION) << "Invalid instruction type " << static_cast<int>(instr.type);
+      }
+      regs[instr.out] = result;
+    }
+  }
+}
+
+void FusedGraphInterpreter::Run(const std::vector<float *> &inputs, const std::vector<float *> &workspaces,
+                                const std::vector<float *> &outputs) const {
+  for (const auto &init : reduce_inits_) {
+    auto addr = GetAddr(init.dst, inputs, workspaces, outputs);
+    std::fill(addr, addr + init.size, init.value);
+  }
+  for (const auto &stage : stages_) {
+    auto block_num = (stage.loop_size + kBlockSize - 1) / kBlockSize;
+    // The reduce accumulates to the shared output, so the stage with reduce is run in one thread.
+    if (stage.has_reduce || block_num == 1) {
+      RunStage(stage, 0, block_num, inputs, workspaces, outputs);
+      continue;
+    }
+    auto task = [this, &stage, &inputs, &workspaces, &outputs](size_t start, size_t end) {
+      RunStage(stage, start, end, inputs, workspaces, outputs);
+    };
+    ParallelLaunch(task, block_num, 1.0f);
+  }
+  for (const auto &copy : output_copies_) {
+    auto src = GetAddr(copy.src, inputs, workspaces, outputs);
+    auto dst = outputs[copy.output_index];
+    if (src != dst) {
+      (void)memcpy(dst, src, output_size_list_[copy.output_index]);
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
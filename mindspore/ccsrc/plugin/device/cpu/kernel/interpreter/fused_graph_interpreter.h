@@ -0,0 +1,117 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_INTERPRETER_FUSED_GRAPH_INTERPRETER_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_INTERPRETER_FUSED_GRAPH_INTERPRETER_H_
+
+#include <memory>
+#include <vector>
+#include "ir/tensor.h"
+#include "utils/shape_utils.h"
+#include "backend/common/graph_kernel/model/lite_graph.h"
+
+namespace mindspore {
+namespace kernel {
+// Run the fused graph of graph kernel on cpu without compiling it. The ops are divided into stages, the ops in one
+// stage have the same loop shape and are evaluated block by block with the nnacl simd functions. So the intermediates
+// of a stage only live in the cache-sized block buffers, and only the tensors used by the later stages or the graph
+// outputs are written to memory. A stage ends at the reduce op, whose output can only be used after the whole stage.
+class FusedGraphInterpreter {
+ public:
+  FusedGraphInterpreter() = default;
+  ~FusedGraphInterpreter() = default;
+
+  // Build the stages of the fused graph, the graph should be checked by graphkernel::InterpreterSupported.
+  void Compile(const graphkernel::inner::LiteGraphPtr &lite_graph);
+  void Run(const std::vector<float *> &inputs, const std::vector<float *> &workspaces,
+           const std::vector<float *> &outputs) const;
+
+  const std::vector<size_t> &input_size_list() const { return input_size_list_; }
+  const std::vector<size_t> &output_size_list() const { return output_size_list_; }
+  const std::vector<size_t> &workspace_size_list() const { return workspace_size_list_; }
+  size_t stage_num() const { return stages_.size(); }
+
+ private:
+  using UnaryFunc = void (*)(const float *, float *, int);
+  using BinaryFunc = void (*)(const float *, const float *, float *, int);
+  enum class BufferType { kInput, kOutput, kWorkspace, kConst };
+  enum class InstrType { kLoad, kUnary, kBinary, kReduce };
+  enum class ReduceType { kSum, kMax, kMin };
+
+  struct Buffer {
+    BufferType type{BufferType::kWorkspace};
+    size_t index{0};
+  };
+
+  struct Instr {
+    InstrType type{InstrType::kLoad};
+    // The register of result, the reduce op has no result register.
+    size_t out{0};
+    size_t in0{0};
+    size_t in1{0};
+    UnaryFunc unary{nullptr};
+    BinaryFunc binary{nullptr};
+    ReduceType reduce{ReduceType::kSum};
+    // The source of load.
+    Buffer src;
+    // The target of reduce, or the memory to store the result.
+    Buffer dst;
+    bool store{false};
+    // The strides of the load source or the reduce target in the loop dims, 0 for the broadcast or reduced dims.
+    ShapeVector strides;
+    // The load source has the same shape with the loop.
+    bool contiguous{false};
+  };
+
+  struct Stage {
+    ShapeVector loop_shape;
+    size_t loop_size{0};
+    size_t reg_num{0};
+    std::vector<Instr> instrs;
+    bool has_reduce{false};
+  };
+
+  struct ReduceInit {
+    Buffer dst;
+    float value{0};
+    size_t size{0};
+  };
+
+  struct OutputCopy {
+    Buffer src;
+    size_t output_index{0};
+  };
+
+  struct ValueInfo;
+
+  void RunStage(const Stage &stage, size_t begin, size_t end, const std::vector<float *> &inputs,
+                const std::vector<float *> &workspaces, const std::vector<float *> &outputs) const;
+  float *GetAddr(const Buffer &buffer, const std::vector<float *> &inputs, const std::vector<float *> &workspaces,
+                 const std::vector<float *> &outputs) const;
+
+  std::vector<Stage> stages_;
+  std::vector<tensor::TensorPtr> const_tensors_;
+  // The reduce targets are initialized before running.
+  std::vector<ReduceInit> reduce_inits_;
+  // The outputs which are not computed by the stages directly, such as the reshaped input, are copied at last.
+  std::vector<OutputCopy> output_copies_;
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_INTERPRETER_FUSED_GRAPH_INTERPRETER_H_
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/kernel/interpreter/interpreter_cpu_kernel_mod.h"
+
+#include <algorithm>
+#include "include/common/utils/anfalgo.h"
+#include "backend/common/graph_kernel/core/graph_kernel_utils.h"
+#include "backend/common/graph_kernel/interpreter_kernel_filter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+std::vector<float *> GetAddrs(const std::vector<AddressPtr> &addresses) {
+  std::vector<float *> addrs;
+  addrs.reserve(addresses.size());
+  (void)std::transform(addresses.begin(), addresses.end(), std::back_inserter(addrs), [](const AddressPtr &address) {
+    MS_EXCEPTION_IF_NULL(address);
+    return static_cast<float *>(address->addr);
+  });
+  return addrs;
+}
+}  // namespace
+
+void InterpreterCpuKernelMod::Build(const AnfNodePtr &anf_node) {
+  MS_EXCEPTION_IF_NULL(anf_node);
+  auto sub_graph = common::AnfAlgo::GetCNodeFuncGraphPtr(anf_node);
+  MS_EXCEPTION_IF_NULL(sub_graph);
+  auto lite_graph = graphkernel::GkUtils::AnfGraph2LiteGraph(sub_graph);
+  if (!graphkernel::InterpreterSupported(lite_graph)) {
+    MS_LOG(EXCEPTION) << "The graph kernel node " << anf_node->fullname_with_scope()
+                      << " can not be run by the interpreter.";
+  }
+  kernel_name_ = lite_graph->name();
+  interpreter_.Compile(lite_graph);
+  SetInputSizeList(interpreter_.input_size_list());
+  SetOutputSizeList(interpreter_.output_size_list());
+  SetWorkspaceSizeList(interpreter_.workspace_size_list());
+}
+
+bool InterpreterCpuKernelMod::Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+                                     const std::vector<AddressPtr> &outputs, void *) {
+  if (inputs.size() != input_size_list_.size() || workspace.size() != workspace_size_list_.size() ||
+      outputs.size() != output_size_list_.size()) {
+    MS_LOG(ERROR) << "For " << kernel_name_ << ", the number of inputs, workspaces and outputs should be "
+                  << input_size_list_.size() << ", " << workspace_size_list_.size() << " and "
+                  << output_size_list_.size() << ", but got " << inputs.size() << ", " << workspace.size() << " and "
+                  << outputs.size();
+    return false;
+  }
+  interpreter_.Run(GetAddrs(inputs), GetAddrs(workspace), GetAddrs(outputs));
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,49 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_INTERPRETER_INTERPRETER_CPU_KERNEL_MOD_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_INTERPRETER_INTERPRETER_CPU_KERNEL_MOD_H_
+#include <memory>
+#include <vector>
+#include "kernel/kernel.h"
+#include "kernel/common_utils.h"
+#include "plugin/device/cpu/kernel/cpu_kernel_mod.h"
+#include "plugin/device/cpu/kernel/interpreter/fused_graph_interpreter.h"
+
+namespace mindspore {
+namespace kernel {
+// The kernel mod of the graph kernel node on cpu, which runs the fused graph by the interpreter instead of the binary
+// compiled by AKG.
+class InterpreterCpuKernelMod : public CpuKernelMod {
+ public:
+  InterpreterCpuKernelMod() = default;
+  ~InterpreterCpuKernelMod() override = default;
+
+  // Compile the fused graph of the graph kernel node.
+  void Build(const AnfNodePtr &anf_node);
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs, void *) override;
+
+  std::vector<KernelAttr> GetOpSupport() override { return {}; }
+
+ private:
+  FusedGraphInterpreter interpreter_;
+};
+using InterpreterCpuKernelModPtr = std::shared_ptr<InterpreterCpuKernelMod>;
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_INTERPRETER_INTERPRETER_CPU_KERNEL_MOD_H_
@@ -44,4 +44,27 @@ typedef struct RelativePositionAttentionParameter {
   int bias_tile_;  // tile for bias pack
 } RelativePositionAttentionParameter;
 
+typedef struct FlashAttentionParameter {
+  // Primitive parameter
+  OpParameter op_parameter_;
+  float scale_;         // scale of the logits before the mask is added
+  bool causal_;         // query of row i only attends to the key of column j <= i + k_seq - q_seq
+  bool key_transpose_;  // key is in shape of [batch, head_size, k_seq] instead of [batch, k_seq, head_size]
+  // args for compute
+  int batch_;            // product of the batch and head dims of query/key/value
+  int q_seq_;            // length of sequence of query
+  int k_seq_;            // length of sequence of key/value
+  int head_size_;        // size of head of query/key
+  int v_head_size_;      // size of head of value
+  int mask_row_stride_;  // 0 if the mask is broadcast along the query, else k_seq
+} FlashAttentionParameter;
+
+typedef struct KVCacheAttentionParameter {
+  // Primitive parameter
+  OpParameter op_parameter_;
+  float scale_;           // scale of the logits
+  int max_pages_;         // max number of pages of the cache shared by all the sequences, 0 for the 1GB model cap
+  char cache_name_[100];  // the sessions of the same cache name share the caches, empty to use the session only
+} KVCacheAttentionParameter;
+
 #endif  // MINDSPORE_NNACL_ATTENTION_PARAMETER_H_
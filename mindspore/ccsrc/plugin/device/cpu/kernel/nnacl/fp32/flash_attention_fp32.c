@@ -0,0 +1,185 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32/flash_attention_fp32.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include "nnacl/flash_attention_fp32_simd.h"
+
+// y[i] += sum(a[d] * b[d * stride + i]) for d in [0, depth) and i in [0, size).
+static void Gemv(const float *a, const float *b, int stride, float *y, int depth, int size) {
+  int index = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionGemv, index, a, b, stride, y, depth, size);
+  for (; index < size; index++) {
+    const float *b_col = b + index;
+    float sum = y[index];
+    for (int d = 0; d < depth; d++, b_col += stride) {
+      sum += a[d] * b_col[0];
+    }
+    y[index] = sum;
+  }
+}
+
+static void Scale(const float *src, float alpha, float *dst, int size) {
+  int index = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionScale, index, src, alpha, dst, size);
+  for (; index < size; index++) {
+    dst[index] = src[index] * alpha;
+  }
+}
+
+// Transpose the key block to [head_size, size], so the logits of one row are accumulated by the vectors of the keys
+// instead of the horizontal sums of the dot products.
+static void PackKeyBlock(const float *k, float *k_block, int col_start, int size, int head_size) {
+  const float *k_row = k + col_start * head_size;
+  for (int j = 0; j < size; j++, k_row += head_size) {
+    for (int d = 0; d < head_size; d++) {
+      k_block[d * FLASH_ATTENTION_COL_BLOCK + j] = k_row[d];
+    }
+  }
+}
+
+// Scale the logits and add the mask, return the max of the logits.
+static float ScaleMaskGetMax(float *logits, const float *mask, float scale, int size) {
+  int index = 0;
+  float max = -FLT_MAX;
+  if (mask == NULL) {
+    SIMD_RUN_NO_SCALAR(FlashAttentionScaleGetMax, index, logits, scale, &max, size);
+    for (; index < size; index++) {
+      logits[index] *= scale;
+      max = MSMAX(max, logits[index]);
+    }
+    return max;
+  }
+  SIMD_RUN_NO_SCALAR(FlashAttentionScaleMaskGetMax, index, logits, mask, scale, &max, size);
+  for (; index < size; index++) {
+    logits[index] = logits[index] * scale + mask[index];
+    max = MSMAX(max, logits[index]);
+  }
+  return max;
+}
+
+// logits = exp(logits - max), return the sum of them.
+static float ExpSum(float *logits, float max, int size) {
+  int index = 0;
+  float sum = 0.0f;
+  SIMD_RUN_NO_SCALAR(FlashAttentionExpSum, index, logits, max, &sum, size);
+  for (; index < size; index++) {
+    logits[index] = simd_exp32_f32(logits[index] - max);
+    sum += logits[index];
+  }
+  return sum;
+}
+
+int FlashAttentionWorkspaceSize(const FlashAttentionParameter *param) {
+  // accumulators of the output, max and sum of the rows, logits and packed key of one block.
+  return FLASH_ATTENTION_ROW_BLOCK * (param->v_head_size_ + C2NUM) +
+         FLASH_ATTENTION_COL_BLOCK * (param->head_size_ + 1);
+}
+
+// The key/value blocks are read from the pages if k_pages is not NULL, else from the contiguous k and v.
+static void FlashAttentionImpl(const float *q, const float *k, const float *v, const float *const *k_pages,
+                               const float *const *v_pages, const float *mask, float *out, float *workspace,
+                               const FlashAttentionParameter *param, int row_start, int row_end) {
+  int v_head_size = param->v_head_size_;
+  // The causal query of row i attends to the keys before column i + diagonal.
+  int diagonal = param->k_seq_ - param->q_seq_ + 1;
+  float *acc = workspace;
+  float *row_max = acc + FLASH_ATTENTION_ROW_BLOCK * v_head_size;
+  float *row_sum = row_max + FLASH_ATTENTION_ROW_BLOCK;
+  float *logits = row_sum + FLASH_ATTENTION_ROW_BLOCK;
+  float *k_block = logits + FLASH_ATTENTION_COL_BLOCK;
+
+  for (int r0 = row_start; r0 < row_end; r0 += FLASH_ATTENTION_ROW_BLOCK) {
+    int r1 = MSMIN(r0 + FLASH_ATTENTION_ROW_BLOCK, row_end);
+    memset(acc, 0, (r1 - r0) * v_head_size * sizeof(float));
+    for (int i = 0; i < r1 - r0; i++) {
+      row_max[i] = -FLT_MAX;
+      row_sum[i] = 0.0f;
+    }
+    // The key blocks after the diagonal of the last row are skipped.
+    int col_end = param->causal_ ? MSMIN(param->k_seq_, r1 - 1 + diagonal) : param->k_seq_;
+    for (int c0 = 0; c0 < col_end; c0 += FLASH_ATTENTION_COL_BLOCK) {
+      int c1 = MSMIN(c0 + FLASH_ATTENTION_COL_BLOCK, col_end);
+      const float *k_col = k_block;
+      const float *v_block = NULL;
+      int k_stride = FLASH_ATTENTION_COL_BLOCK;
+      if (k_pages != NULL) {
+        // The key of the page has been transposed when it is appended.
+        k_col = k_pages[c0 / FLASH_ATTENTION_COL_BLOCK];
+        v_block = v_pages[c0 / FLASH_ATTENTION_COL_BLOCK];
+      } else {
+        v_block = v + c0 * v_head_size;
+        if (param->key_transpose_) {
+          k_col = k + c0;
+          k_stride = param->k_seq_;
+        } else {
+          PackKeyBlock(k, k_block, c0, c1 - c0, param->head_size_);
+        }
+      }
+      for (int r = r0; r < r1; r++) {
+        int size = (param->causal_ ? MSMIN(c1, r + diagonal) : c1) - c0;
+        if (size <= 0) {
+          continue;
+        }
+        memset(logits, 0, size * sizeof(float));
+        Gemv(q + r * param->head_size_, k_col, k_stride, logits, param->head_size_, size);
+        const float *mask_row = mask == NULL ? NULL : mask + r * param->mask_row_stride_ + c0;
+        float block_max = ScaleMaskGetMax(logits, mask_row, param->scale_, size);
+        int i = r - r0;
+        float new_max = MSMAX(row_max[i], block_max);
+        // Rescale the sum and the output accumulated with the previous max.
+        float correction = simd_exp32_f32(row_max[i] - new_max);
+        row_max[i] = new_max;
+        row_sum[i] = row_sum[i] * correction + ExpSum(logits, new_max, size);
+        float *acc_row = acc + i * v_head_size;
+        if (correction != 1.0f) {
+          Scale(acc_row, correction, acc_row, v_head_size);
+        }
+        Gemv(logits, v_block, v_head_size, acc_row, size, v_head_size);
+      }
+    }
+    for (int r = r0; r < r1; r++) {
+      int i = r - r0;
+      float inv_sum = row_sum[i] > 0.0f ? 1.0f / row_sum[i] : 0.0f;
+      Scale(acc + i * v_head_size, inv_sum, out + r * v_head_size, v_head_size);
+    }
+  }
+}
+
+void FlashAttention(const float *q, const float *k, const float *v, const float *mask, float *out, float *workspace,
+                    const FlashAttentionParameter *param, int row_start, int row_end) {
+  FlashAttentionImpl(q, k, v, NULL, NULL, mask, out, workspace, param, row_start, row_end);
+}
+
+void FlashAttentionPaged(const float *q, const float *const *k_pages, const float *const *v_pages, float *out,
+                         float *workspace, const FlashAttentionParameter *param, int row_start, int row_end) {
+  FlashAttentionImpl(q, NULL, NULL, k_pages, v_pages, NULL, out, workspace, param, row_start, row_end);
+}
+
+void FlashAttentionAppendKV(const float *k, const float *v, float *const *k_pages, float *const *v_pages, int start,
+                            int tokens, int head_size, int v_head_size) {
+  for (int t = 0; t < tokens; t++) {
+    int page = (start + t) / FLASH_ATTENTION_COL_BLOCK;
+    int slot = (start + t) % FLASH_ATTENTION_COL_BLOCK;
+    const float *k_row = k + t * head_size;
+    float *k_page = k_pages[page];
+    for (int d = 0; d < head_size; d++) {
+      k_page[d * FLASH_ATTENTION_COL_BLOCK + slot] = k_row[d];
+    }
+    memcpy(v_pages[page] + slot * v_head_size, v + t * v_head_size, v_head_size * sizeof(float));
+  }
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
+#define MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
+
+#include "nnacl/op_base.h"
+#include "nnacl/attention_parameter.h"
+
+// The query rows computed together, the key/value block is reused by these rows while it is in the cache.
+#define FLASH_ATTENTION_ROW_BLOCK 16
+// The keys whose logits are computed together.
+#define FLASH_ATTENTION_COL_BLOCK 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// The number of floats of the workspace used by one call of FlashAttention.
+int FlashAttentionWorkspaceSize(const FlashAttentionParameter *param);
+
+// out = softmax(scale * q * k^T + mask) * v for the query rows [row_start, row_end) of one batch. The logits are
+// computed block by block and merged by the online softmax, so the logits of the whole sequence are never stored.
+// q: [q_seq, head_size], k: [k_seq, head_size] or [head_size, k_seq], v: [k_seq, v_head_size],
+// mask: NULL or [q_seq or 1, k_seq] whose row stride is mask_row_stride_, out: [q_seq, v_head_size].
+void FlashAttention(const float *q, const float *k, const float *v, const float *mask, float *out, float *workspace,
+                    const FlashAttentionParameter *param, int row_start, int row_end);
+
+// The same as FlashAttention without mask, but the key and value are read from the pages of the kv cache. The page p
+// holds the tokens [p * FLASH_ATTENTION_COL_BLOCK, (p + 1) * FLASH_ATTENTION_COL_BLOCK) of one batch,
+// k_pages[p]: [head_size, FLASH_ATTENTION_COL_BLOCK], v_pages[p]: [FLASH_ATTENTION_COL_BLOCK, v_head_size].
+void FlashAttentionPaged(const float *q, const float *const *k_pages, const float *const *v_pages, float *out,
+                         float *workspace, const FlashAttentionParameter *param, int row_start, int row_end);
+
+// Write the key [tokens, head_size] and value [tokens, v_head_size] of one batch to the pages from the position start,
+// the key is transposed to the layout read by FlashAttentionPaged.
+void FlashAttentionAppendKV(const float *k, const float *v, float *const *k_pages, float *const *v_pages, int start,
+                            int tokens, int head_size, int v_head_size);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
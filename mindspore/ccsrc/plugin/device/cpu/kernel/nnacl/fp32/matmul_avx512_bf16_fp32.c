@@ -0,0 +1,196 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32/matmul_avx512_bf16_fp32.h"
+#include <immintrin.h>
+#include <string.h>
+
+#define BF16_PAIR 2
+#define BF16_SHIFT 16
+#define BF16_ROUND_BIAS 0x7FFF
+#define BF16_QUIET_NAN 0x40
+#define FP32_ABS_MASK 0x7FFFFFFF
+#define FP32_INF 0x7F800000
+#define BF16_PAIR_STRIDE (MATMUL_BF16_COL_TILE * BF16_PAIR)  // bf16 elements of one pair of the deep in the tile
+#define BF16_HALF_STRIDE (C16NUM * BF16_PAIR)
+
+static inline uint16_t Fp32ToBf16Scalar(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if ((bits & FP32_ABS_MASK) > FP32_INF) {
+    return (uint16_t)((bits >> BF16_SHIFT) | BF16_QUIET_NAN);
+  }
+  bits += BF16_ROUND_BIAS + ((bits >> BF16_SHIFT) & 1);
+  return (uint16_t)(bits >> BF16_SHIFT);
+}
+
+void Fp32ToBf16(const float *src, uint16_t *dst, int size) {
+  int i = 0;
+  for (; i <= size - C16NUM; i += C16NUM) {
+    __m256bh value = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+    _mm256_storeu_si256((__m256i *)(dst + i), (__m256i)value);
+  }
+  for (; i < size; i++) {
+    dst[i] = Fp32ToBf16Scalar(src[i]);
+  }
+}
+
+void PackMatmulInputBf16(const float *src, uint16_t *dst, int row, int deep) {
+  int deep_align = UP_ROUND(deep, BF16_PAIR);
+  for (int r = 0; r < row; r++) {
+    Fp32ToBf16(src + r * deep, dst + r * deep_align, deep);
+    if (deep_align != deep) {
+      dst[r * deep_align + deep] = 0;
+    }
+  }
+}
+
+void PackMatmulWeightBf16(const float *src, uint16_t *dst, int deep, int col, bool transpose) {
+  int deep_pair = UP_DIV(deep, BF16_PAIR);
+  int col_tile_num = UP_DIV(col, MATMUL_BF16_COL_TILE);
+  for (int t = 0; t < col_tile_num; t++) {
+    uint16_t *dst_tile = dst + (size_t)t * deep_pair * BF16_PAIR_STRIDE;
+    for (int k = 0; k < deep_pair; k++) {
+      uint16_t *dst_pair = dst_tile + k * BF16_PAIR_STRIDE;
+      for (int j = 0; j < MATMUL_BF16_COL_TILE; j++) {
+        int c = t * MATMUL_BF16_COL_TILE + j;
+        for (int p = 0; p < BF16_PAIR; p++) {
+          int d = k * BF16_PAIR + p;
+          if (c >= col || d >= deep) {
+            dst_pair[j * BF16_PAIR + p] = 0;
+            continue;
+          }
+          float value = transpose ? src[(size_t)c * deep + d] : src[(size_t)d * col + c];
+          dst_pair[j * BF16_PAIR + p] = Fp32ToBf16Scalar(value);
+        }
+      }
+    }
+  }
+}
+
+static inline __mmask16 Bf16ColMask(int col) {
+  return col >= C16NUM ? 0xFFFF : (col <= 0 ? 0 : (__mmask16)((1u << col) - 1));
+}
+
+// the pair of bf16 in the deep of one row is broadcast to all the lanes.
+static inline __m512bh Bf16BroadcastPair(const uint16_t *a) {
+  int32_t pair;
+  memcpy(&pair, a, sizeof(pair));
+  return (__m512bh)_mm512_set1_epi32(pair);
+}
+
+static inline void Bf16StoreRow(__m512 acc0, __m512 acc1, const float *bias, float *c, int col, ActType act_type) {
+  __mmask16 mask0 = Bf16ColMask(col);
+  __mmask16 mask1 = Bf16ColMask(col - C16NUM);
+  if (bias != NULL) {
+    acc0 = _mm512_add_ps(acc0, _mm512_maskz_loadu_ps(mask0, bias));
+    acc1 = _mm512_add_ps(acc1, _mm512_maskz_loadu_ps(mask1, bias + C16NUM));
+  }
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    acc0 = _mm512_max_ps(acc0, _mm512_setzero_ps());
+    acc1 = _mm512_max_ps(acc1, _mm512_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    acc0 = _mm512_min_ps(acc0, _mm512_set1_ps(C6NUM));
+    acc1 = _mm512_min_ps(acc1, _mm512_set1_ps(C6NUM));
+  }
+  _mm512_mask_storeu_ps(c, mask0, acc0);
+  _mm512_mask_storeu_ps(c + C16NUM, mask1, acc1);
+}
+
+#define BF16_DP_ROW(r)                                                      \
+  a_pair = Bf16BroadcastPair(a + (r) * (size_t)a_stride + k * BF16_PAIR);  \
+  acc##r##0 = _mm512_dpbf16_ps(acc##r##0, a_pair, b0);                      \
+  acc##r##1 = _mm512_dpbf16_ps(acc##r##1, a_pair, b1);
+
+#define BF16_STORE_ROW(r) \
+  Bf16StoreRow(acc##r##0, acc##r##1, bias, c + (r) * (size_t)c_stride, col, act_type);
+
+// 8 rows * 32 columns, the 16 accumulators are kept in the registers over the deep.
+static void MatmulBf16Row8(const uint16_t *a, int a_stride, const uint16_t *b, const float *bias, float *c,
+                           int c_stride, int deep_pair, int col, ActType act_type) {
+  __m512 acc00 = _mm512_setzero_ps(), acc01 = _mm512_setzero_ps(), acc10 = _mm512_setzero_ps();
+  __m512 acc11 = _mm512_setzero_ps(), acc20 = _mm512_setzero_ps(), acc21 = _mm512_setzero_ps();
+  __m512 acc30 = _mm512_setzero_ps(), acc31 = _mm512_setzero_ps(), acc40 = _mm512_setzero_ps();
+  __m512 acc41 = _mm512_setzero_ps(), acc50 = _mm512_setzero_ps(), acc51 = _mm512_setzero_ps();
+  __m512 acc60 = _mm512_setzero_ps(), acc61 = _mm512_setzero_ps(), acc70 = _mm512_setzero_ps();
+  __m512 acc71 = _mm512_setzero_ps();
+  __m512bh a_pair;
+  for (int k = 0; k < deep_pair; k++) {
+    const uint16_t *b_pair = b + k * BF16_PAIR_STRIDE;
+    __m512bh b0 = (__m512bh)_mm512_loadu_si512(b_pair);
+    __m512bh b1 = (__m512bh)_mm512_loadu_si512(b_pair + BF16_HALF_STRIDE);
+    BF16_DP_ROW(0)
+    BF16_DP_ROW(1)
+    BF16_DP_ROW(2)
+    BF16_DP_ROW(3)
+    BF16_DP_ROW(4)
+    BF16_DP_ROW(5)
+    BF16_DP_ROW(6)
+    BF16_DP_ROW(7)
+  }
+  BF16_STORE_ROW(0)
+  BF16_STORE_ROW(1)
+  BF16_STORE_ROW(2)
+  BF16_STORE_ROW(3)
+  BF16_STORE_ROW(4)
+  BF16_STORE_ROW(5)
+  BF16_STORE_ROW(6)
+  BF16_STORE_ROW(7)
+}
+
+// 1 row * 32 columns, the deep is unrolled by 2 pairs to hide the latency of vdpbf16ps.
+static void MatmulBf16Row1(const uint16_t *a, const uint16_t *b, const float *bias, float *c, int deep_pair, int col,
+                           ActType act_type) {
+  __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+  __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+  int k = 0;
+  for (; k < deep_pair - 1; k += C2NUM) {
+    const uint16_t *b_pair = b + k * BF16_PAIR_STRIDE;
+    __m512bh a_pair0 = Bf16BroadcastPair(a + k * BF16_PAIR);
+    __m512bh a_pair1 = Bf16BroadcastPair(a + (k + 1) * BF16_PAIR);
+    acc0 = _mm512_dpbf16_ps(acc0, a_pair0, (__m512bh)_mm512_loadu_si512(b_pair));
+    acc1 = _mm512_dpbf16_ps(acc1, a_pair0, (__m512bh)_mm512_loadu_si512(b_pair + BF16_HALF_STRIDE));
+    acc2 = _mm512_dpbf16_ps(acc2, a_pair1, (__m512bh)_mm512_loadu_si512(b_pair + BF16_PAIR_STRIDE));
+    acc3 = _mm512_dpbf16_ps(acc3, a_pair1, (__m512bh)_mm512_loadu_si512(b_pair + BF16_PAIR_STRIDE + BF16_HALF_STRIDE));
+  }
+  if (k < deep_pair) {
+    const uint16_t *b_pair = b + k * BF16_PAIR_STRIDE;
+    __m512bh a_pair0 = Bf16BroadcastPair(a + k * BF16_PAIR);
+    acc0 = _mm512_dpbf16_ps(acc0, a_pair0, (__m512bh)_mm512_loadu_si512(b_pair));
+    acc1 = _mm512_dpbf16_ps(acc1, a_pair0, (__m512bh)_mm512_loadu_si512(b_pair + BF16_HALF_STRIDE));
+  }
+  Bf16StoreRow(_mm512_add_ps(acc0, acc2), _mm512_add_ps(acc1, acc3), bias, c, col, act_type);
+}
+
+void MatmulBf16Fp32(const uint16_t *a, const uint16_t *b, const float *bias, float *c, int row, int deep, int col,
+                    int col_start, int col_end, ActType act_type) {
+  int deep_pair = UP_DIV(deep, BF16_PAIR);
+  int a_stride = deep_pair * BF16_PAIR;
+  for (int cs = col_start; cs < col_end; cs += MATMUL_BF16_COL_TILE) {
+    const uint16_t *b_tile = b + (size_t)(cs / MATMUL_BF16_COL_TILE) * deep_pair * BF16_PAIR_STRIDE;
+    const float *bias_tile = bias == NULL ? NULL : bias + cs;
+    int cur_col = MSMIN(col_end - cs, MATMUL_BF16_COL_TILE);
+    int r = 0;
+    for (; r <= row - MATMUL_BF16_ROW_TILE; r += MATMUL_BF16_ROW_TILE) {
+      MatmulBf16Row8(a + (size_t)r * a_stride, a_stride, b_tile, bias_tile, c + (size_t)r * col + cs, col, deep_pair,
+                     cur_col, act_type);
+    }
+    for (; r < row; r++) {
+      MatmulBf16Row1(a + (size_t)r * a_stride, b_tile, bias_tile, c + (size_t)r * col + cs, deep_pair, cur_col,
+                     act_type);
+    }
+  }
+}
@@ -0,0 +1,47 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP32_MATMUL_AVX512_BF16_FP32_H_
+#define MINDSPORE_NNACL_FP32_MATMUL_AVX512_BF16_FP32_H_
+
+#include "nnacl/op_base.h"
+
+#define MATMUL_BF16_ROW_TILE 8
+#define MATMUL_BF16_COL_TILE 32
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* avx512 bf16, the operands are rounded to bf16 (round to nearest even) and accumulated in fp32 by vdpbf16ps */
+
+/* fp32 => bf16, the bf16 data is kept in uint16_t since there is no bf16 type in c */
+void Fp32ToBf16(const float *src, uint16_t *dst, int size);
+
+/* (fp32)row-major [row, deep] => (bf16)row-major [row, deep_align2], the padded element of the odd deep is zero */
+void PackMatmulInputBf16(const float *src, uint16_t *dst, int row, int deep);
+
+/* (fp32)[deep, col], or [col, deep] if transpose => (bf16)[col_align32 / 32][deep_align2 / 2][32][2], the pairs along
+ * the deep are adjacent which is the operand layout of vdpbf16ps */
+void PackMatmulWeightBf16(const float *src, uint16_t *dst, int deep, int col, bool transpose);
+
+/* (bf16)row-major * (bf16)col32-major => (fp32)row-major, computes the columns of [col_start, col_end), col_start is
+ * a multiple of MATMUL_BF16_COL_TILE and the bias is of col elements or NULL */
+void MatmulBf16Fp32(const uint16_t *a, const uint16_t *b, const float *bias, float *c, int row, int deep, int col,
+                    int col_start, int col_end, ActType act_type);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_MATMUL_AVX512_BF16_FP32_H_
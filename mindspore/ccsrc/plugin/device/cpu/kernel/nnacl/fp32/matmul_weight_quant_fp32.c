@@ -0,0 +1,307 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32/matmul_weight_quant_fp32.h"
+#include <string.h>
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#define WEIGHT_QUANT_ROW_TILE 4
+#define WEIGHT_QUANT_INT4_MASK 0xF
+
+void PackWeightQuantInt8(const int8_t *src, int8_t *dst, int deep, int col, bool transpose) {
+  int tile_size = deep * WEIGHT_QUANT_COL_TILE;
+  memset(dst, 0, UP_DIV(col, WEIGHT_QUANT_COL_TILE) * tile_size);
+  for (int c = 0; c < col; c++) {
+    int8_t *dst_col = dst + (c / WEIGHT_QUANT_COL_TILE) * tile_size + c % WEIGHT_QUANT_COL_TILE;
+    for (int d = 0; d < deep; d++) {
+      dst_col[d * WEIGHT_QUANT_COL_TILE] = transpose ? src[c * deep + d] : src[d * col + c];
+    }
+  }
+}
+
+void PackWeightQuantInt4(const int8_t *src, int8_t *dst, int deep, int col, bool transpose) {
+  int tile_size = deep * C8NUM;
+  memset(dst, 0, UP_DIV(col, WEIGHT_QUANT_COL_TILE) * tile_size);
+  for (int c = 0; c < col; c++) {
+    int index = c % WEIGHT_QUANT_COL_TILE;
+    int shift = index < C8NUM ? 0 : WEIGHT_QUANT_INT4_BIT;
+    uint8_t *dst_col = (uint8_t *)dst + (c / WEIGHT_QUANT_COL_TILE) * tile_size + index % C8NUM;
+    for (int d = 0; d < deep; d++) {
+      uint8_t value = (uint8_t)(transpose ? src[c * deep + d] : src[d * col + c]) & WEIGHT_QUANT_INT4_MASK;
+      dst_col[d * C8NUM] |= (uint8_t)(value << shift);
+    }
+  }
+}
+
+#if defined(ENABLE_AVX)
+static inline void WeightQuantLoadAvx(const int8_t *b, int bit_num, __m256 *w0, __m256 *w1) {
+  if (bit_num == WEIGHT_QUANT_INT4_BIT) {
+    // shift the nibble to the top of the int32 and shift it back arithmetically to extend the sign.
+    __m256i packed = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)b));
+    *w0 = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(packed, 28), 28));
+    *w1 = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(packed, 24), 28));
+  } else {
+    *w0 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)b)));
+    *w1 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(b + C8NUM))));
+  }
+}
+
+static void WeightQuantRow4Avx(const float *a, const int8_t *b, const float *scales, const float *offsets, float *out,
+                               int deep, int group_size, int bit_num) {
+  int b_step = bit_num == WEIGHT_QUANT_INT4_BIT ? C8NUM : C16NUM;
+  const float *a0 = a;
+  const float *a1 = a + deep;
+  const float *a2 = a + C2NUM * deep;
+  const float *a3 = a + C3NUM * deep;
+  __m256 acc00 = _mm256_setzero_ps();
+  __m256 acc01 = _mm256_setzero_ps();
+  __m256 acc10 = _mm256_setzero_ps();
+  __m256 acc11 = _mm256_setzero_ps();
+  __m256 acc20 = _mm256_setzero_ps();
+  __m256 acc21 = _mm256_setzero_ps();
+  __m256 acc30 = _mm256_setzero_ps();
+  __m256 acc31 = _mm256_setzero_ps();
+  for (int d_start = 0; d_start < deep; d_start += group_size) {
+    int d_end = MSMIN(d_start + group_size, deep);
+    __m256 s0 = _mm256_loadu_ps(scales);
+    __m256 s1 = _mm256_loadu_ps(scales + C8NUM);
+    __m256 o0 = _mm256_loadu_ps(offsets);
+    __m256 o1 = _mm256_loadu_ps(offsets + C8NUM);
+    scales += WEIGHT_QUANT_COL_TILE;
+    offsets += WEIGHT_QUANT_COL_TILE;
+    for (int d = d_start; d < d_end; d++, b += b_step) {
+      __m256 w0;
+      __m256 w1;
+      WeightQuantLoadAvx(b, bit_num, &w0, &w1);
+      w0 = _mm256_fmadd_ps(w0, s0, o0);
+      w1 = _mm256_fmadd_ps(w1, s1, o1);
+      __m256 av = _mm256_broadcast_ss(a0 + d);
+      acc00 = _mm256_fmadd_ps(av, w0, acc00);
+      acc01 = _mm256_fmadd_ps(av, w1, acc01);
+      av = _mm256_broadcast_ss(a1 + d);
+      acc10 = _mm256_fmadd_ps(av, w0, acc10);
+      acc11 = _mm256_fmadd_ps(av, w1, acc11);
+      av = _mm256_broadcast_ss(a2 + d);
+      acc20 = _mm256_fmadd_ps(av, w0, acc20);
+      acc21 = _mm256_fmadd_ps(av, w1, acc21);
+      av = _mm256_broadcast_ss(a3 + d);
+      acc30 = _mm256_fmadd_ps(av, w0, acc30);
+      acc31 = _mm256_fmadd_ps(av, w1, acc31);
+    }
+  }
+  _mm256_storeu_ps(out, acc00);
+  _mm256_storeu_ps(out + C8NUM, acc01);
+  _mm256_storeu_ps(out + C16NUM, acc10);
+  _mm256_storeu_ps(out + C24NUM, acc11);
+  _mm256_storeu_ps(out + C32NUM, acc20);
+  _mm256_storeu_ps(out + C40NUM, acc21);
+  _mm256_storeu_ps(out + C48NUM, acc30);
+  _mm256_storeu_ps(out + C56NUM, acc31);
+}
+
+// Two steps of deep are interleaved to hide the latency of the accumulation, which bounds the gemv of decoding.
+static void WeightQuantRow1Avx(const float *a, const int8_t *b, const float *scales, const float *offsets, float *out,
+                               int deep, int group_size, int bit_num) {
+  int b_step = bit_num == WEIGHT_QUANT_INT4_BIT ? C8NUM : C16NUM;
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  __m256 acc2 = _mm256_setzero_ps();
+  __m256 acc3 = _mm256_setzero_ps();
+  for (int d_start = 0; d_start < deep; d_start += group_size) {
+    int d_end = MSMIN(d_start + group_size, deep);
+    __m256 s0 = _mm256_loadu_ps(scales);
+    __m256 s1 = _mm256_loadu_ps(scales + C8NUM);
+    __m256 o0 = _mm256_loadu_ps(offsets);
+    __m256 o1 = _mm256_loadu_ps(offsets + C8NUM);
+    scales += WEIGHT_QUANT_COL_TILE;
+    offsets += WEIGHT_QUANT_COL_TILE;
+    int d = d_start;
+    for (; d < d_end - 1; d += C2NUM, b += C2NUM * b_step) {
+      __m256 w0;
+      __m256 w1;
+      __m256 w2;
+      __m256 w3;
+      WeightQuantLoadAvx(b, bit_num, &w0, &w1);
+      WeightQuantLoadAvx(b + b_step, bit_num, &w2, &w3);
+      __m256 av0 = _mm256_broadcast_ss(a + d);
+      __m256 av1 = _mm256_broadcast_ss(a + d + 1);
+      acc0 = _mm256_fmadd_ps(av0, _mm256_fmadd_ps(w0, s0, o0), acc0);
+      acc1 = _mm256_fmadd_ps(av0, _mm256_fmadd_ps(w1, s1, o1), acc1);
+      acc2 = _mm256_fmadd_ps(av1, _mm256_fmadd_ps(w2, s0, o0), acc2);
+      acc3 = _mm256_fmadd_ps(av1, _mm256_fmadd_ps(w3, s1, o1), acc3);
+    }
+    if (d < d_end) {
+      __m256 w0;
+      __m256 w1;
+      WeightQuantLoadAvx(b, bit_num, &w0, &w1);
+      __m256 av = _mm256_broadcast_ss(a + d);
+      acc0 = _mm256_fmadd_ps(av, _mm256_fmadd_ps(w0, s0, o0), acc0);
+      acc1 = _mm256_fmadd_ps(av, _mm256_fmadd_ps(w1, s1, o1), acc1);
+      b += b_step;
+    }
+  }
+  _mm256_storeu_ps(out, _mm256_add_ps(acc0, acc2));
+  _mm256_storeu_ps(out + C8NUM, _mm256_add_ps(acc1, acc3));
+}
+#elif defined(ENABLE_ARM)
+static inline void WeightQuantLoadNeon(const int8_t *b, int bit_num, float32x4_t *w) {
+  int8x16_t quant;
+  if (bit_num == WEIGHT_QUANT_INT4_BIT) {
+    int8x8_t packed = vld1_s8(b);
+    quant = vcombine_s8(vshr_n_s8(vshl_n_s8(packed, WEIGHT_QUANT_INT4_BIT), WEIGHT_QUANT_INT4_BIT),
+                        vshr_n_s8(packed, WEIGHT_QUANT_INT4_BIT));
+  } else {
+    quant = vld1q_s8(b);
+  }
+  int16x8_t low = vmovl_s8(vget_low_s8(quant));
+  int16x8_t high = vmovl_s8(vget_high_s8(quant));
+  w[0] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(low)));
+  w[1] = vcvtq_f32_s32(vmovl_s16(vget_high_s16(low)));
+  w[C2NUM] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(high)));
+  w[C3NUM] = vcvtq_f32_s32(vmovl_s16(vget_high_s16(high)));
+}
+
+static void WeightQuantRowNeon(const float *a, const int8_t *b, const float *scales, const float *offsets, float *out,
+                               int row_num, int deep, int group_size, int bit_num) {
+  int b_step = bit_num == WEIGHT_QUANT_INT4_BIT ? C8NUM : C16NUM;
+  float32x4_t acc[WEIGHT_QUANT_ROW_TILE][C4NUM];
+  for (int r = 0; r < WEIGHT_QUANT_ROW_TILE; r++) {
+    for (int i = 0; i < C4NUM; i++) {
+      acc[r][i] = vdupq_n_f32(0.0f);
+    }
+  }
+  for (int d_start = 0; d_start < deep; d_start += group_size) {
+    int d_end = MSMIN(d_start + group_size, deep);
+    float32x4_t scale[C4NUM];
+    float32x4_t offset[C4NUM];
+    for (int i = 0; i < C4NUM; i++) {
+      scale[i] = vld1q_f32(scales + i * C4NUM);
+      offset[i] = vld1q_f32(offsets + i * C4NUM);
+    }
+    scales += WEIGHT_QUANT_COL_TILE;
+    offsets += WEIGHT_QUANT_COL_TILE;
+    for (int d = d_start; d < d_end; d++, b += b_step) {
+      float32x4_t w[C4NUM];
+      WeightQuantLoadNeon(b, bit_num, w);
+      for (int i = 0; i < C4NUM; i++) {
+        w[i] = MS_MLAQ_F32(offset[i], w[i], scale[i]);
+      }
+      for (int r = 0; r < row_num; r++) {
+        float32x4_t av = vdupq_n_f32(a[r * deep + d]);
+        for (int i = 0; i < C4NUM; i++) {
+          acc[r][i] = MS_MLAQ_F32(acc[r][i], av, w[i]);
+        }
+      }
+    }
+  }
+  for (int r = 0; r < row_num; r++) {
+    for (int i = 0; i < C4NUM; i++) {
+      vst1q_f32(out + r * WEIGHT_QUANT_COL_TILE + i * C4NUM, acc[r][i]);
+    }
+  }
+}
+#else
+static void WeightQuantRowC(const float *a, const int8_t *b, const float *scales, const float *offsets, float *out,
+                            int row_num, int deep, int group_size, int bit_num) {
+  int b_step = bit_num == WEIGHT_QUANT_INT4_BIT ? C8NUM : C16NUM;
+  float w[WEIGHT_QUANT_COL_TILE];
+  memset(out, 0, row_num * WEIGHT_QUANT_COL_TILE * sizeof(float));
+  for (int d_start = 0; d_start < deep; d_start += group_size) {
+    int d_end = MSMIN(d_start + group_size, deep);
+    for (int d = d_start; d < d_end; d++, b += b_step) {
+      for (int i = 0; i < WEIGHT_QUANT_COL_TILE; i++) {
+        int quant;
+        if (bit_num == WEIGHT_QUANT_INT4_BIT) {
+          int nibble = ((uint8_t)b[i % C8NUM] >> (i < C8NUM ? 0 : WEIGHT_QUANT_INT4_BIT)) & WEIGHT_QUANT_INT4_MASK;
+          quant = nibble >= C8NUM ? nibble - C16NUM : nibble;
+        } else {
+          quant = b[i];
+        }
+        w[i] = quant * scales[i] + offsets[i];
+      }
+      for (int r = 0; r < row_num; r++) {
+        float av = a[r * deep + d];
+        for (int i = 0; i < WEIGHT_QUANT_COL_TILE; i++) {
+          out[r * WEIGHT_QUANT_COL_TILE + i] += av * w[i];
+        }
+      }
+    }
+    scales += WEIGHT_QUANT_COL_TILE;
+    offsets += WEIGHT_QUANT_COL_TILE;
+  }
+}
+#endif
+
+static void WeightQuantStore(const float *out, const float *bias, float *c, int row_num, int col, int cur_col,
+                             ActType act_type) {
+  for (int r = 0; r < row_num; r++) {
+    const float *src = out + r * WEIGHT_QUANT_COL_TILE;
+    float *dst = c + r * col;
+    for (int i = 0; i < cur_col; i++) {
+      float value = src[i];
+      if (bias != NULL) {
+        value += bias[i];
+      }
+      if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+        value = MSMAX(0.0f, value);
+      }
+      if (act_type == ActType_Relu6) {
+        value = MSMIN(6.0f, value);
+      }
+      dst[i] = value;
+    }
+  }
+}
+
+void MatmulWeightQuantFp32(const float *a, const int8_t *b, const float *scales, const float *offsets,
+                           const float *bias, float *c, int row, int deep, int col, int group_size, int bit_num,
+                           int col_start, int col_end, ActType act_type) {
+  int group_num = UP_DIV(deep, group_size);
+  int b_tile_size = deep * (bit_num == WEIGHT_QUANT_INT4_BIT ? C8NUM : C16NUM);
+  float out[WEIGHT_QUANT_ROW_TILE * WEIGHT_QUANT_COL_TILE];
+  for (int col_index = col_start; col_index < col_end; col_index += WEIGHT_QUANT_COL_TILE) {
+    int tile_index = col_index / WEIGHT_QUANT_COL_TILE;
+    int cur_col = MSMIN(col_end - col_index, WEIGHT_QUANT_COL_TILE);
+    const int8_t *b_tile = b + tile_index * b_tile_size;
+    const float *scale_tile = scales + tile_index * group_num * WEIGHT_QUANT_COL_TILE;
+    const float *offset_tile = offsets + tile_index * group_num * WEIGHT_QUANT_COL_TILE;
+    const float *bias_tile = bias == NULL ? NULL : bias + col_index;
+    // The weight tile stays in the cache while the rows go over it.
+    for (int r = 0; r < row;) {
+      int row_num = row - r >= WEIGHT_QUANT_ROW_TILE ? WEIGHT_QUANT_ROW_TILE : 1;
+      const float *a_row = a + r * deep;
+#if defined(ENABLE_AVX)
+      if (row_num == WEIGHT_QUANT_ROW_TILE) {
+        WeightQuantRow4Avx(a_row, b_tile, scale_tile, offset_tile, out, deep, group_size, bit_num);
+      } else {
+        WeightQuantRow1Avx(a_row, b_tile, scale_tile, offset_tile, out, deep, group_size, bit_num);
+      }
+#elif defined(ENABLE_ARM)
+      WeightQuantRowNeon(a_row, b_tile, scale_tile, offset_tile, out, row_num, deep, group_size, bit_num);
+#else
+      WeightQuantRowC(a_row, b_tile, scale_tile, offset_tile, out, row_num, deep, group_size, bit_num);
+#endif
+      WeightQuantStore(out, bias_tile, c + r * col + col_index, row_num, col, cur_col, act_type);
+      r += row_num;
+    }
+  }
+}
@@ -0,0 +1,43 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
+#define MINDSPORE_NNACL_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
+
+#include "nnacl/op_base.h"
+
+// The columns of the weight are packed in tiles of 16, each tile is in shape of [deep, 16] and holds one byte per
+// element for int8 and one nibble per element for int4 (the low nibble is the column j of the tile and the high nibble
+// is the column j + 8). The scales and offsets are in shape of [col_tile_num, group_num, 16] and the dequantized
+// weight is quant * scale + offset, where offset is -zero_point * scale.
+#define WEIGHT_QUANT_COL_TILE 16
+#define WEIGHT_QUANT_INT4_BIT 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// Pack the weight of [col, deep] if transpose else [deep, col], the values should be in [-8, 7] for int4.
+void PackWeightQuantInt8(const int8_t *src, int8_t *dst, int deep, int col, bool transpose);
+void PackWeightQuantInt4(const int8_t *src, int8_t *dst, int deep, int col, bool transpose);
+
+// c[row, col] = act(a[row, deep] * dequant(b) + bias) for the columns in [col_start, col_end), col_start is a multiple
+// of the col tile and the weight is quantized per group of group_size along deep.
+void MatmulWeightQuantFp32(const float *a, const int8_t *b, const float *scales, const float *offsets,
+                           const float *bias, float *c, int row, int deep, int col, int group_size, int bit_num,
+                           int col_start, int col_end, ActType act_type);
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
@@ -0,0 +1,183 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32_sparse/matmul_sparse_fp32.h"
+#include <immintrin.h>
+
+#define SPARSE_AVX512_ROW_GROUP 8
+
+static inline void BlockSparseStoreAvx512(__m512 acc, const float *bias, float *c, int cur_col, ActType act_type) {
+  if (bias != NULL) {
+    acc = _mm512_add_ps(acc, _mm512_loadu_ps(bias));
+  }
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    acc = _mm512_max_ps(acc, _mm512_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    acc = _mm512_min_ps(acc, _mm512_set1_ps(C6NUM));
+  }
+  _mm512_mask_storeu_ps(c, (__mmask16)((1u << cur_col) - 1), acc);
+}
+
+// SPARSE_AVX512_ROW_GROUP rows * 16 columns of a tile.
+static void BlockSparseRow8Avx512(const float *a, int deep, const float *values, const int *block_deep,
+                                  int block_start, int block_end, const float *bias, float *c, int col, int cur_col,
+                                  ActType act_type) {
+  __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps(), acc2 = _mm512_setzero_ps();
+  __m512 acc3 = _mm512_setzero_ps(), acc4 = _mm512_setzero_ps(), acc5 = _mm512_setzero_ps();
+  __m512 acc6 = _mm512_setzero_ps(), acc7 = _mm512_setzero_ps();
+  for (int i = block_start; i < block_end; i++) {
+    const float *a_col = a + block_deep[i];
+    __m512 b = _mm512_loadu_ps(values + (size_t)i * SPARSE_COL_TILE);
+    acc0 = _mm512_fmadd_ps(_mm512_set1_ps(a_col[0]), b, acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_set1_ps(a_col[deep]), b, acc1);
+    acc2 = _mm512_fmadd_ps(_mm512_set1_ps(a_col[C2NUM * deep]), b, acc2);
+    acc3 = _mm512_fmadd_ps(_mm512_set1_ps(a_col[C3NUM * deep]), b, acc3);
+    acc4 = _mm512_fmadd_ps(_mm512_set1_ps(a_col[C4NUM * deep]), b, acc4);
+    acc5 = _mm512_fmadd_ps(_mm512_set1_ps(a_col[C5NUM * deep]), b, acc5);
+    acc6 = _mm512_fmadd_ps(_mm512_set1_ps(a_col[C6NUM * deep]), b, acc6);
+    acc7 = _mm512_fmadd_ps(_mm512_set1_ps(a_col[C7NUM * deep]), b, acc7);
+  }
+  BlockSparseStoreAvx512(acc0, bias, c, cur_col, act_type);
+  BlockSparseStoreAvx512(acc1, bias, c + col, cur_col, act_type);
+  BlockSparseStoreAvx512(acc2, bias, c + C2NUM * col, cur_col, act_type);
+  BlockSparseStoreAvx512(acc3, bias, c + C3NUM * col, cur_col, act_type);
+  BlockSparseStoreAvx512(acc4, bias, c + C4NUM * col, cur_col, act_type);
+  BlockSparseStoreAvx512(acc5, bias, c + C5NUM * col, cur_col, act_type);
+  BlockSparseStoreAvx512(acc6, bias, c + C6NUM * col, cur_col, act_type);
+  BlockSparseStoreAvx512(acc7, bias, c + C7NUM * col, cur_col, act_type);
+}
+
+static void BlockSparseRow1Avx512(const float *a, const float *values, const int *block_deep, int block_start,
+                                  int block_end, const float *bias, float *c, int cur_col, ActType act_type) {
+  __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+  __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+  int i = block_start;
+  for (; i < block_end - C3NUM; i += C4NUM) {
+    const float *block = values + (size_t)i * SPARSE_COL_TILE;
+    acc0 = _mm512_fmadd_ps(_mm512_set1_ps(a[block_deep[i]]), _mm512_loadu_ps(block), acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_set1_ps(a[block_deep[i + 1]]), _mm512_loadu_ps(block + C16NUM), acc1);
+    acc2 = _mm512_fmadd_ps(_mm512_set1_ps(a[block_deep[i + C2NUM]]), _mm512_loadu_ps(block + C32NUM), acc2);
+    acc3 = _mm512_fmadd_ps(_mm512_set1_ps(a[block_deep[i + C3NUM]]), _mm512_loadu_ps(block + C48NUM), acc3);
+  }
+  for (; i < block_end; i++) {
+    acc0 = _mm512_fmadd_ps(_mm512_set1_ps(a[block_deep[i]]), _mm512_loadu_ps(values + (size_t)i * SPARSE_COL_TILE),
+                           acc0);
+  }
+  acc0 = _mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3));
+  BlockSparseStoreAvx512(acc0, bias, c, cur_col, act_type);
+}
+
+void MatmulBlockSparseAvx512Fp32(const float *a, const float *values, const int *block_deep, const int *tile_offset,
+                                 const float *bias, float *c, int row, int deep, int col, int col_start, int col_end,
+                                 ActType act_type) {
+  for (int cs = col_start; cs < col_end; cs += SPARSE_COL_TILE) {
+    int t = cs / SPARSE_COL_TILE;
+    int cur_col = MSMIN(col_end - cs, SPARSE_COL_TILE);
+    const float *cur_bias = bias == NULL ? NULL : bias + cs;
+    int r = 0;
+    for (; r <= row - SPARSE_AVX512_ROW_GROUP; r += SPARSE_AVX512_ROW_GROUP) {
+      BlockSparseRow8Avx512(a + (size_t)r * deep, deep, values, block_deep, tile_offset[t], tile_offset[t + 1],
+                            cur_bias, c + (size_t)r * col + cs, col, cur_col, act_type);
+    }
+    for (; r < row; r++) {
+      BlockSparseRow1Avx512(a + (size_t)r * deep, values, block_deep, tile_offset[t], tile_offset[t + 1], cur_bias,
+                            c + (size_t)r * col + cs, cur_col, act_type);
+    }
+  }
+}
+
+// 16 rows of the col16-major input * 1 column, the lanes are the rows.
+static void CscSparseTileAvx512(const float *a_pack, const float *values, const int *deep_index, int start, int end,
+                                float bias, float *c, __m512i c_offset, ActType act_type) {
+  __m512 acc0 = _mm512_set1_ps(bias), acc1 = _mm512_setzero_ps();
+  __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+  int i = start;
+  for (; i < end - C3NUM; i += C4NUM) {
+    acc0 = _mm512_fmadd_ps(_mm512_set1_ps(values[i]), _mm512_loadu_ps(a_pack + deep_index[i] * SPARSE_ROW_TILE),
+                           acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_set1_ps(values[i + 1]),
+                           _mm512_loadu_ps(a_pack + deep_index[i + 1] * SPARSE_ROW_TILE), acc1);
+    acc2 = _mm512_fmadd_ps(_mm512_set1_ps(values[i + C2NUM]),
+                           _mm512_loadu_ps(a_pack + deep_index[i + C2NUM] * SPARSE_ROW_TILE), acc2);
+    acc3 = _mm512_fmadd_ps(_mm512_set1_ps(values[i + C3NUM]),
+                           _mm512_loadu_ps(a_pack + deep_index[i + C3NUM] * SPARSE_ROW_TILE), acc3);
+  }
+  for (; i < end; i++) {
+    acc0 = _mm512_fmadd_ps(_mm512_set1_ps(values[i]), _mm512_loadu_ps(a_pack + deep_index[i] * SPARSE_ROW_TILE),
+                           acc0);
+  }
+  acc0 = _mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3));
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    acc0 = _mm512_max_ps(acc0, _mm512_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    acc0 = _mm512_min_ps(acc0, _mm512_set1_ps(C6NUM));
+  }
+  _mm512_i32scatter_ps(c, c_offset, acc0, sizeof(float));
+}
+
+void MatmulCscSparseAvx512Fp32(const float *a, const float *a_pack, const float *values, const int *deep_index,
+                               const int *col_offset, const float *bias, float *c, int row, int deep, int col,
+                               int col_start, int col_end, ActType act_type) {
+  int row_tile_end = row / SPARSE_ROW_TILE * SPARSE_ROW_TILE;
+  // the offsets of the 16 rows of a column in c.
+  __m512i c_offset = _mm512_mullo_epi32(_mm512_set1_epi32(col), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+                                                                                    12, 13, 14, 15));
+  for (int j = col_start; j < col_end; j++) {
+    float cur_bias = bias == NULL ? 0.0f : bias[j];
+    for (int r = 0; r < row_tile_end; r += SPARSE_ROW_TILE) {
+      CscSparseTileAvx512(a_pack + (size_t)r * deep, values, deep_index, col_offset[j], col_offset[j + 1], cur_bias,
+                          c + (size_t)r * col + j, c_offset, act_type);
+    }
+  }
+  // the input of the rest rows is gathered by the row index of the non-zero.
+  for (int r = row_tile_end; r < row; r++) {
+    const float *cur_a = a + (size_t)r * deep;
+    float *cur_c = c + (size_t)r * col;
+    for (int j = col_start; j < col_end; j++) {
+      __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+      int i = col_offset[j];
+      int end = col_offset[j + 1];
+      for (; i <= end - C32NUM; i += C32NUM) {
+        __m512 a0 = _mm512_i32gather_ps(_mm512_loadu_si512(deep_index + i), cur_a, sizeof(float));
+        __m512 a1 = _mm512_i32gather_ps(_mm512_loadu_si512(deep_index + i + C16NUM), cur_a, sizeof(float));
+        acc0 = _mm512_fmadd_ps(a0, _mm512_loadu_ps(values + i), acc0);
+        acc1 = _mm512_fmadd_ps(a1, _mm512_loadu_ps(values + i + C16NUM), acc1);
+      }
+      if (i < end) {
+        __mmask16 mask = (__mmask16)((1u << MSMIN(end - i, C16NUM)) - 1);
+        __m512 a0 = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, _mm512_maskz_loadu_epi32(mask, deep_index + i),
+                                             cur_a, sizeof(float));
+        acc0 = _mm512_fmadd_ps(a0, _mm512_maskz_loadu_ps(mask, values + i), acc0);
+        i += C16NUM;
+      }
+      if (i < end) {
+        __mmask16 mask = (__mmask16)((1u << (end - i)) - 1);
+        __m512 a1 = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, _mm512_maskz_loadu_epi32(mask, deep_index + i),
+                                             cur_a, sizeof(float));
+        acc1 = _mm512_fmadd_ps(a1, _mm512_maskz_loadu_ps(mask, values + i), acc1);
+      }
+      float value = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1)) + (bias == NULL ? 0.0f : bias[j]);
+      if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+        value = MSMAX(value, 0.0f);
+      }
+      if (act_type == ActType_Relu6) {
+        value = MSMIN(value, C6NUM);
+      }
+      cur_c[j] = value;
+    }
+  }
+}
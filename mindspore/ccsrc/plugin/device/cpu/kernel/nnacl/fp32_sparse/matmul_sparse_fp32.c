@@ -0,0 +1,342 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32_sparse/matmul_sparse_fp32.h"
+#ifdef ENABLE_AVX
+#include <immintrin.h>
+#endif
+
+#define SPARSE_ROW_GROUP 4  // rows sharing the loads of the weight in the kernels of the row-major input
+
+static inline float SparseWeightAt(const float *weight, int deep, int col, bool transpose, int d, int c) {
+  return transpose ? weight[(size_t)c * deep + d] : weight[(size_t)d * col + c];
+}
+
+void SparseWeightCount(const float *weight, int deep, int col, bool transpose, int *nnz, int *block_nnz) {
+  *nnz = 0;
+  *block_nnz = 0;
+  for (int cs = 0; cs < col; cs += SPARSE_COL_TILE) {
+    int cur_col = MSMIN(col - cs, SPARSE_COL_TILE);
+    for (int d = 0; d < deep; d++) {
+      int block_count = 0;
+      for (int j = 0; j < cur_col; j++) {
+        block_count += SparseWeightAt(weight, deep, col, transpose, d, cs + j) != 0.0f ? 1 : 0;
+      }
+      *nnz += block_count;
+      *block_nnz += block_count > 0 ? 1 : 0;
+    }
+  }
+}
+
+void PackBlockSparseWeight(const float *weight, int deep, int col, bool transpose, float *values, int *block_deep,
+                           int *tile_offset) {
+  int block_index = 0;
+  int tile_num = UP_DIV(col, SPARSE_COL_TILE);
+  for (int t = 0; t < tile_num; t++) {
+    tile_offset[t] = block_index;
+    int cs = t * SPARSE_COL_TILE;
+    int cur_col = MSMIN(col - cs, SPARSE_COL_TILE);
+    for (int d = 0; d < deep; d++) {
+      float *block = values + (size_t)block_index * SPARSE_COL_TILE;
+      bool has_value = false;
+      for (int j = 0; j < SPARSE_COL_TILE; j++) {
+        block[j] = j < cur_col ? SparseWeightAt(weight, deep, col, transpose, d, cs + j) : 0.0f;
+        has_value = has_value || block[j] != 0.0f;
+      }
+      if (has_value) {
+        block_deep[block_index++] = d;
+      }
+    }
+  }
+  tile_offset[tile_num] = block_index;
+}
+
+void PackCscSparseWeight(const float *weight, int deep, int col, bool transpose, float *values, int *deep_index,
+                         int *col_offset) {
+  int index = 0;
+  for (int c = 0; c < col; c++) {
+    col_offset[c] = index;
+    for (int d = 0; d < deep; d++) {
+      float value = SparseWeightAt(weight, deep, col, transpose, d, c);
+      if (value != 0.0f) {
+        values[index] = value;
+        deep_index[index++] = d;
+      }
+    }
+  }
+  col_offset[col] = index;
+}
+
+static inline float SparseAct(float value, ActType act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = MSMAX(value, 0.0f);
+  }
+  if (act_type == ActType_Relu6) {
+    value = MSMIN(value, C6NUM);
+  }
+  return value;
+}
+
+#ifndef ENABLE_AVX
+static void BlockSparseRowC(const float *a, const float *values, const int *block_deep, int block_start,
+                            int block_end, const float *bias, float *c, int cur_col, ActType act_type) {
+  float acc[SPARSE_COL_TILE] = {0};
+  for (int i = block_start; i < block_end; i++) {
+    float a_val = a[block_deep[i]];
+    const float *block = values + (size_t)i * SPARSE_COL_TILE;
+    for (int j = 0; j < SPARSE_COL_TILE; j++) {
+      acc[j] += a_val * block[j];
+    }
+  }
+  for (int j = 0; j < cur_col; j++) {
+    c[j] = SparseAct(acc[j] + (bias == NULL ? 0.0f : bias[j]), act_type);
+  }
+}
+#else
+static inline void BlockSparseStoreAvx(__m256 acc0, __m256 acc1, const float *bias, float *c, int cur_col,
+                                       ActType act_type) {
+  if (bias != NULL) {
+    acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(bias));
+    acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(bias + C8NUM));
+  }
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    acc0 = _mm256_max_ps(acc0, _mm256_setzero_ps());
+    acc1 = _mm256_max_ps(acc1, _mm256_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    acc0 = _mm256_min_ps(acc0, _mm256_set1_ps(C6NUM));
+    acc1 = _mm256_min_ps(acc1, _mm256_set1_ps(C6NUM));
+  }
+  if (cur_col == SPARSE_COL_TILE) {
+    _mm256_storeu_ps(c, acc0);
+    _mm256_storeu_ps(c + C8NUM, acc1);
+    return;
+  }
+  float out[SPARSE_COL_TILE];
+  _mm256_storeu_ps(out, acc0);
+  _mm256_storeu_ps(out + C8NUM, acc1);
+  for (int j = 0; j < cur_col; j++) {
+    c[j] = out[j];
+  }
+}
+#endif
+
+// SPARSE_ROW_GROUP rows * 16 columns of a tile.
+static void BlockSparseRow4(const float *a, int deep, const float *values, const int *block_deep, int block_start,
+                            int block_end, const float *bias, float *c, int col, int cur_col, ActType act_type) {
+#ifdef ENABLE_AVX
+  __m256 acc00 = _mm256_setzero_ps(), acc01 = _mm256_setzero_ps(), acc10 = _mm256_setzero_ps();
+  __m256 acc11 = _mm256_setzero_ps(), acc20 = _mm256_setzero_ps(), acc21 = _mm256_setzero_ps();
+  __m256 acc30 = _mm256_setzero_ps(), acc31 = _mm256_setzero_ps();
+  for (int i = block_start; i < block_end; i++) {
+    const float *a_col = a + block_deep[i];
+    const float *block = values + (size_t)i * SPARSE_COL_TILE;
+    __m256 b0 = _mm256_loadu_ps(block);
+    __m256 b1 = _mm256_loadu_ps(block + C8NUM);
+    __m256 a0 = _mm256_broadcast_ss(a_col);
+    __m256 a1 = _mm256_broadcast_ss(a_col + deep);
+    __m256 a2 = _mm256_broadcast_ss(a_col + C2NUM * deep);
+    __m256 a3 = _mm256_broadcast_ss(a_col + C3NUM * deep);
+    acc00 = _mm256_fmadd_ps(a0, b0, acc00);
+    acc01 = _mm256_fmadd_ps(a0, b1, acc01);
+    acc10 = _mm256_fmadd_ps(a1, b0, acc10);
+    acc11 = _mm256_fmadd_ps(a1, b1, acc11);
+    acc20 = _mm256_fmadd_ps(a2, b0, acc20);
+    acc21 = _mm256_fmadd_ps(a2, b1, acc21);
+    acc30 = _mm256_fmadd_ps(a3, b0, acc30);
+    acc31 = _mm256_fmadd_ps(a3, b1, acc31);
+  }
+  BlockSparseStoreAvx(acc00, acc01, bias, c, cur_col, act_type);
+  BlockSparseStoreAvx(acc10, acc11, bias, c + col, cur_col, act_type);
+  BlockSparseStoreAvx(acc20, acc21, bias, c + C2NUM * col, cur_col, act_type);
+  BlockSparseStoreAvx(acc30, acc31, bias, c + C3NUM * col, cur_col, act_type);
+#else
+  for (int r = 0; r < SPARSE_ROW_GROUP; r++) {
+    BlockSparseRowC(a + r * deep, values, block_deep, block_start, block_end, bias, c + r * col, cur_col, act_type);
+  }
+#endif
+}
+
+static void BlockSparseRow1(const float *a, const float *values, const int *block_deep, int block_start,
+                            int block_end, const float *bias, float *c, int cur_col, ActType act_type) {
+#ifdef ENABLE_AVX
+  __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+  __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+  int i = block_start;
+  for (; i < block_end - 1; i += C2NUM) {
+    const float *block = values + (size_t)i * SPARSE_COL_TILE;
+    __m256 a0 = _mm256_broadcast_ss(a + block_deep[i]);
+    __m256 a1 = _mm256_broadcast_ss(a + block_deep[i + 1]);
+    acc0 = _mm256_fmadd_ps(a0, _mm256_loadu_ps(block), acc0);
+    acc1 = _mm256_fmadd_ps(a0, _mm256_loadu_ps(block + C8NUM), acc1);
+    acc2 = _mm256_fmadd_ps(a1, _mm256_loadu_ps(block + C16NUM), acc2);
+    acc3 = _mm256_fmadd_ps(a1, _mm256_loadu_ps(block + C24NUM), acc3);
+  }
+  if (i < block_end) {
+    const float *block = values + (size_t)i * SPARSE_COL_TILE;
+    __m256 a0 = _mm256_broadcast_ss(a + block_deep[i]);
+    acc0 = _mm256_fmadd_ps(a0, _mm256_loadu_ps(block), acc0);
+    acc1 = _mm256_fmadd_ps(a0, _mm256_loadu_ps(block + C8NUM), acc1);
+  }
+  BlockSparseStoreAvx(_mm256_add_ps(acc0, acc2), _mm256_add_ps(acc1, acc3), bias, c, cur_col, act_type);
+#else
+  BlockSparseRowC(a, values, block_deep, block_start, block_end, bias, c, cur_col, act_type);
+#endif
+}
+
+void MatmulBlockSparseFp32(const float *a, const float *values, const int *block_deep, const int *tile_offset,
+                           const float *bias, float *c, int row, int deep, int col, int col_start, int col_end,
+                           ActType act_type) {
+  for (int cs = col_start; cs < col_end; cs += SPARSE_COL_TILE) {
+    int t = cs / SPARSE_COL_TILE;
+    int cur_col = MSMIN(col_end - cs, SPARSE_COL_TILE);
+    const float *cur_bias = bias == NULL ? NULL : bias + cs;
+    int r = 0;
+    for (; r <= row - SPARSE_ROW_GROUP; r += SPARSE_ROW_GROUP) {
+      BlockSparseRow4(a + (size_t)r * deep, deep, values, block_deep, tile_offset[t], tile_offset[t + 1], cur_bias,
+                      c + (size_t)r * col + cs, col, cur_col, act_type);
+    }
+    for (; r < row; r++) {
+      BlockSparseRow1(a + (size_t)r * deep, values, block_deep, tile_offset[t], tile_offset[t + 1], cur_bias,
+                      c + (size_t)r * col + cs, cur_col, act_type);
+    }
+  }
+}
+
+// 16 rows of the col16-major input * 1 column, the lanes are the rows.
+static void CscSparseTile(const float *a_pack, const float *values, const int *deep_index, int start, int end,
+                          float bias, float *c, int col, ActType act_type) {
+  float out[SPARSE_ROW_TILE];
+#ifdef ENABLE_AVX
+  // 4 non-zero are unrolled to hide the latency of the fma.
+  __m256 acc0 = _mm256_set1_ps(bias), acc1 = _mm256_set1_ps(bias);
+  __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps(), acc4 = _mm256_setzero_ps();
+  __m256 acc5 = _mm256_setzero_ps(), acc6 = _mm256_setzero_ps(), acc7 = _mm256_setzero_ps();
+  int i = start;
+  for (; i < end - C3NUM; i += C4NUM) {
+    const float *a0 = a_pack + deep_index[i] * SPARSE_ROW_TILE;
+    const float *a1 = a_pack + deep_index[i + 1] * SPARSE_ROW_TILE;
+    const float *a2 = a_pack + deep_index[i + C2NUM] * SPARSE_ROW_TILE;
+    const float *a3 = a_pack + deep_index[i + C3NUM] * SPARSE_ROW_TILE;
+    __m256 w0 = _mm256_broadcast_ss(values + i);
+    __m256 w1 = _mm256_broadcast_ss(values + i + 1);
+    __m256 w2 = _mm256_broadcast_ss(values + i + C2NUM);
+    __m256 w3 = _mm256_broadcast_ss(values + i + C3NUM);
+    acc0 = _mm256_fmadd_ps(w0, _mm256_loadu_ps(a0), acc0);
+    acc1 = _mm256_fmadd_ps(w0, _mm256_loadu_ps(a0 + C8NUM), acc1);
+    acc2 = _mm256_fmadd_ps(w1, _mm256_loadu_ps(a1), acc2);
+    acc3 = _mm256_fmadd_ps(w1, _mm256_loadu_ps(a1 + C8NUM), acc3);
+    acc4 = _mm256_fmadd_ps(w2, _mm256_loadu_ps(a2), acc4);
+    acc5 = _mm256_fmadd_ps(w2, _mm256_loadu_ps(a2 + C8NUM), acc5);
+    acc6 = _mm256_fmadd_ps(w3, _mm256_loadu_ps(a3), acc6);
+    acc7 = _mm256_fmadd_ps(w3, _mm256_loadu_ps(a3 + C8NUM), acc7);
+  }
+  for (; i < end; i++) {
+    const float *a0 = a_pack + deep_index[i] * SPARSE_ROW_TILE;
+    __m256 w0 = _mm256_broadcast_ss(values + i);
+    acc0 = _mm256_fmadd_ps(w0, _mm256_loadu_ps(a0), acc0);
+    acc1 = _mm256_fmadd_ps(w0, _mm256_loadu_ps(a0 + C8NUM), acc1);
+  }
+  acc0 = _mm256_add_ps(_mm256_add_ps(acc0, acc2), _mm256_add_ps(acc4, acc6));
+  acc1 = _mm256_add_ps(_mm256_add_ps(acc1, acc3), _mm256_add_ps(acc5, acc7));
+  _mm256_storeu_ps(out, acc0);
+  _mm256_storeu_ps(out + C8NUM, acc1);
+#else
+  for (int r = 0; r < SPARSE_ROW_TILE; r++) {
+    out[r] = bias;
+  }
+  for (int i = start; i < end; i++) {
+    const float *a0 = a_pack + deep_index[i] * SPARSE_ROW_TILE;
+    for (int r = 0; r < SPARSE_ROW_TILE; r++) {
+      out[r] += values[i] * a0[r];
+    }
+  }
+#endif
+  for (int r = 0; r < SPARSE_ROW_TILE; r++) {
+    c[r * col] = SparseAct(out[r], act_type);
+  }
+}
+
+// SPARSE_ROW_GROUP rows of the row-major input * 1 column, the loads of the weight are shared by the rows.
+static void CscSparseRow4(const float *a, int deep, const float *values, const int *deep_index, int start, int end,
+                          float bias, float *c, int col, ActType act_type) {
+  float acc0 = bias, acc1 = bias, acc2 = bias, acc3 = bias;
+  for (int i = start; i < end; i++) {
+    const float *a_col = a + deep_index[i];
+    float w = values[i];
+    acc0 += w * a_col[0];
+    acc1 += w * a_col[deep];
+    acc2 += w * a_col[C2NUM * deep];
+    acc3 += w * a_col[C3NUM * deep];
+  }
+  c[0] = SparseAct(acc0, act_type);
+  c[col] = SparseAct(acc1, act_type);
+  c[C2NUM * col] = SparseAct(acc2, act_type);
+  c[C3NUM * col] = SparseAct(acc3, act_type);
+}
+
+static void CscSparseRow1(const float *a, const float *values, const int *deep_index, int start, int end, float bias,
+                          float *c, ActType act_type) {
+  float acc0 = bias, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+  int i = start;
+#ifdef ENABLE_AVX
+  // the input is gathered by the row index of 16 non-zero at a time.
+  __m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+  for (; i <= end - C16NUM; i += C16NUM) {
+    __m256 a0 = _mm256_i32gather_ps(a, _mm256_loadu_si256((const __m256i *)(deep_index + i)), sizeof(float));
+    __m256 a1 = _mm256_i32gather_ps(a, _mm256_loadu_si256((const __m256i *)(deep_index + i + C8NUM)), sizeof(float));
+    sum0 = _mm256_fmadd_ps(a0, _mm256_loadu_ps(values + i), sum0);
+    sum1 = _mm256_fmadd_ps(a1, _mm256_loadu_ps(values + i + C8NUM), sum1);
+  }
+  float sum[C8NUM];
+  _mm256_storeu_ps(sum, _mm256_add_ps(sum0, sum1));
+  for (int k = 0; k < C8NUM; k++) {
+    acc1 += sum[k];
+  }
+#endif
+  for (; i < end - C3NUM; i += C4NUM) {
+    acc0 += values[i] * a[deep_index[i]];
+    acc1 += values[i + 1] * a[deep_index[i + 1]];
+    acc2 += values[i + C2NUM] * a[deep_index[i + C2NUM]];
+    acc3 += values[i + C3NUM] * a[deep_index[i + C3NUM]];
+  }
+  for (; i < end; i++) {
+    acc0 += values[i] * a[deep_index[i]];
+  }
+  c[0] = SparseAct((acc0 + acc1) + (acc2 + acc3), act_type);
+}
+
+void MatmulCscSparseFp32(const float *a, const float *a_pack, const float *values, const int *deep_index,
+                         const int *col_offset, const float *bias, float *c, int row, int deep, int col, int col_start,
+                         int col_end, ActType act_type) {
+  int row_tile_end = row / SPARSE_ROW_TILE * SPARSE_ROW_TILE;
+  for (int j = col_start; j < col_end; j++) {
+    float cur_bias = bias == NULL ? 0.0f : bias[j];
+    int start = col_offset[j];
+    int end = col_offset[j + 1];
+    int r = 0;
+    for (; r < row_tile_end; r += SPARSE_ROW_TILE) {
+      CscSparseTile(a_pack + (size_t)r * deep, values, deep_index, start, end, cur_bias, c + (size_t)r * col + j, col,
+                    act_type);
+    }
+    for (; r <= row - SPARSE_ROW_GROUP; r += SPARSE_ROW_GROUP) {
+      CscSparseRow4(a + (size_t)r * deep, deep, values, deep_index, start, end, cur_bias, c + (size_t)r * col + j, col,
+                    act_type);
+    }
+    for (; r < row; r++) {
+      CscSparseRow1(a + (size_t)r * deep, values, deep_index, start, end, cur_bias, c + (size_t)r * col + j, act_type);
+    }
+  }
+}
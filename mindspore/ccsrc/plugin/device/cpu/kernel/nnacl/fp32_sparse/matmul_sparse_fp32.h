@@ -0,0 +1,64 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_FP32_H_
+#define MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_FP32_H_
+
+#include "nnacl/op_base.h"
+
+// Two compressed layouts of the constant weight of [deep, col]:
+// block sparse: the columns are split in tiles of 16, only the [1, 16] blocks of a tile with non-zero are kept, the
+//   blocks of tile t are in [tile_offset[t], tile_offset[t + 1]), the block i is the row block_deep[i] of the tile.
+// csc: the non-zero of column j are in [col_offset[j], col_offset[j + 1]), the element i is in row deep_index[i].
+//   The N:M pruned weight is stored in csc with the same number of non-zero in every column.
+#define SPARSE_COL_TILE 16
+#define SPARSE_ROW_TILE 16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// The count of the non-zero elements and the non-zero [1, 16] blocks of the weight of [col, deep] if transpose.
+void SparseWeightCount(const float *weight, int deep, int col, bool transpose, int *nnz, int *block_nnz);
+
+void PackBlockSparseWeight(const float *weight, int deep, int col, bool transpose, float *values, int *block_deep,
+                           int *tile_offset);
+void PackCscSparseWeight(const float *weight, int deep, int col, bool transpose, float *values, int *deep_index,
+                         int *col_offset);
+
+// c[row, col] = act(a[row, deep] * weight + bias) for the columns in [col_start, col_end), col_start is a multiple of
+// SPARSE_COL_TILE, bias is NULL or padded with zero to the multiple of SPARSE_COL_TILE.
+void MatmulBlockSparseFp32(const float *a, const float *values, const int *block_deep, const int *tile_offset,
+                           const float *bias, float *c, int row, int deep, int col, int col_start, int col_end,
+                           ActType act_type);
+#ifdef ENABLE_AVX512
+void MatmulBlockSparseAvx512Fp32(const float *a, const float *values, const int *block_deep, const int *tile_offset,
+                                 const float *bias, float *c, int row, int deep, int col, int col_start, int col_end,
+                                 ActType act_type);
+#endif
+
+// The same as above with the weight in csc, a_pack is a in col16-major (RowMajor2Col16Major) for the rows of the full
+// row tiles, the rest rows are read from a.
+void MatmulCscSparseFp32(const float *a, const float *a_pack, const float *values, const int *deep_index,
+                         const int *col_offset, const float *bias, float *c, int row, int deep, int col, int col_start,
+                         int col_end, ActType act_type);
+#ifdef ENABLE_AVX512
+void MatmulCscSparseAvx512Fp32(const float *a, const float *a_pack, const float *values, const int *deep_index,
+                               const int *col_offset, const float *bias, float *c, int row, int deep, int col,
+                               int col_start, int col_end, ActType act_type);
+#endif
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_FP32_H_
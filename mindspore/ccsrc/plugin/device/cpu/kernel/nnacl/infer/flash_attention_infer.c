@@ -0,0 +1,43 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/infer/flash_attention_infer.h"
+#include "nnacl/infer/infer_register.h"
+
+int FlashAttentionInferShape(const TensorC *const *inputs, size_t inputs_size, TensorC **outputs, size_t outputs_size,
+                             OpParameter *parameter) {
+  int check_ret = CheckAugmentWithMinSize(inputs, inputs_size, outputs, outputs_size, parameter, C3NUM, C1NUM);
+  if (check_ret != NNACL_OK) {
+    return check_ret;
+  }
+  const TensorC *query = inputs[FIRST_INPUT];
+  const TensorC *value = inputs[THIRD_INPUT];
+  TensorC *output = outputs[FIRST_INPUT];
+  SetDataTypeFormat(output, query);
+  if (!InferFlag(inputs, inputs_size)) {
+    return NNACL_INFER_INVALID;
+  }
+  // query: [..., q_seq, head_size], value: [..., k_seq, v_head_size], output: [..., q_seq, v_head_size].
+  // The value of KVCacheAttention is the value of the new tokens, whose last dim is the same as the cached value.
+  if (query->shape_size_ < C2NUM || query->shape_size_ != value->shape_size_) {
+    return NNACL_INPUT_TENSOR_ERROR;
+  }
+  SetShapeTensor(output, query);
+  output->shape_[output->shape_size_ - 1] = value->shape_[value->shape_size_ - 1];
+  return NNACL_OK;
+}
+
+REG_INFER(FlashAttention, PrimType_Inner_FlashAttention, FlashAttentionInferShape)
+REG_INFER(KVCacheAttention, PrimType_Inner_KVCacheAttention, FlashAttentionInferShape)
@@ -71,6 +71,7 @@
 #include "nnacl/infer/fft_imag_infer.h"
 #include "nnacl/infer/fft_real_infer.h"
 #include "nnacl/infer/fill_infer.h"
+#include "nnacl/infer/flash_attention_infer.h"
 #include "nnacl/infer/flatten_grad_infer.h"
 #include "nnacl/infer/flatten_infer.h"
 #include "nnacl/infer/full_connection_infer.h"
@@ -408,6 +409,8 @@ void RegAllInferFunc5() {
   g_inner_op_infer_func[PrimType_Inner_EncoderLayer - PrimType_InnerOpMin] = EncoderLayerInferShape;
 
 #endif
+  g_inner_op_infer_func[PrimType_Inner_FlashAttention - PrimType_InnerOpMin] = FlashAttentionInferShape;
+  g_inner_op_infer_func[PrimType_Inner_KVCacheAttention - PrimType_InnerOpMin] = FlashAttentionInferShape;
   g_inner_op_infer_func[PrimType_Inner_ToFormat - PrimType_InnerOpMin] = NULL;
 }
 
@@ -0,0 +1,300 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/int8/matmul_vnni_int8.h"
+#include <immintrin.h>
+
+/*
+ * vpdpbusd multiplies the unsigned bytes of one operand by the signed bytes of the other one, so the int8 lhs is turned
+ * into uint8 by flipping the sign bit: sum((a + 128) * b) = sum(a * b) + 128 * sum(b). The compensation 128 * sum(b)
+ * of each column is subtracted from the accumulator before the requantization.
+ */
+#define VNNI_SIGN_FLIP ((int32_t)0x80808080)
+#define VNNI_DP_COL_BLOCK 4  // zmm of 16 columns per micro kernel of the 4x16 packed rhs
+#define VNNI_R_COL_BLOCK 2   // zmm of 16 columns per micro kernel of the 8x4 packed rhs
+#define VNNI_DP_COL_UNIT (VNNI_DP_COL_BLOCK * C16NUM)
+#define VNNI_R_COL_UNIT (VNNI_R_COL_BLOCK * C16NUM)
+#define VNNI_MAX_SHIFT 31
+
+static inline __mmask16 VnniColMask(size_t col) { return col >= C16NUM ? 0xFFFF : (__mmask16)((1u << col) - 1); }
+
+static inline __m512i VnniBroadcastA(const int8_t *a) {
+  return _mm512_set1_epi32(*(const int32_t *)a ^ VNNI_SIGN_FLIP);
+}
+
+// the same as MultiplyByQuantizedMultiplier, right_shift is not positive.
+static inline __m512i VnniMultiplyByQuantizedMultiplier(__m512i value, __m512i multiplier, __m512i left_shift,
+                                                        __m512i right_shift) {
+  const __m512i int_min = _mm512_set1_epi32(INT32_MIN);
+  const __m512i one = _mm512_set1_epi32(1);
+  __m512i x = _mm512_sllv_epi32(value, left_shift);
+
+  // SaturatingRoundingDoublingHighMul: (x * multiplier + 2^30) >> 31 in 64 bits for both signs of the product.
+  const __m512i nudge = _mm512_set1_epi64(1ll << 30);
+  __m512i even = _mm512_srai_epi64(_mm512_add_epi64(_mm512_mul_epi32(x, multiplier), nudge), 31);
+  __m512i odd = _mm512_srai_epi64(
+    _mm512_add_epi64(_mm512_mul_epi32(_mm512_srli_epi64(x, 32), _mm512_srli_epi64(multiplier, 32)), nudge), 31);
+  __m512i high = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+  __mmask16 overflow = _mm512_cmpeq_epi32_mask(x, int_min) & _mm512_cmpeq_epi32_mask(multiplier, int_min);
+  high = _mm512_mask_mov_epi32(high, overflow, _mm512_set1_epi32(INT32_MAX));
+
+  // RoundingDivideByPOT
+  __m512i exponent =
+    _mm512_min_epi32(_mm512_sub_epi32(_mm512_setzero_si512(), right_shift), _mm512_set1_epi32(VNNI_MAX_SHIFT));
+  __m512i mask = _mm512_sub_epi32(_mm512_sllv_epi32(one, exponent), one);
+  __m512i remainder = _mm512_and_si512(high, mask);
+  __m512i threshold = _mm512_sub_epi32(_mm512_srli_epi32(mask, 1), _mm512_srai_epi32(high, 31));
+  __m512i result = _mm512_srav_epi32(high, exponent);
+  return _mm512_mask_add_epi32(result, _mm512_cmpgt_epi32_mask(remainder, threshold), result, one);
+}
+
+static inline __m512i VnniLoadQuantArg(const int32_t *arg, size_t per_channel, __mmask16 mask) {
+  return per_channel ? _mm512_maskz_loadu_epi32(mask, arg) : _mm512_set1_epi32(arg[0]);
+}
+
+static inline void VnniRequantStore(__m512i value, const int32_t *left_shift, const int32_t *right_shift,
+                                    const int32_t *multiplier, size_t per_channel, int32_t output_zp, int32_t mini,
+                                    int32_t maxi, __mmask16 mask, int8_t *dst) {
+  __m512i out = VnniMultiplyByQuantizedMultiplier(value, VnniLoadQuantArg(multiplier, per_channel, mask),
+                                                  VnniLoadQuantArg(left_shift, per_channel, mask),
+                                                  VnniLoadQuantArg(right_shift, per_channel, mask));
+  out = _mm512_add_epi32(out, _mm512_set1_epi32(output_zp));
+  out = _mm512_max_epi32(_mm512_min_epi32(out, _mm512_set1_epi32(maxi)), _mm512_set1_epi32(mini));
+  _mm512_mask_cvtepi32_storeu_epi8(dst, mask, out);
+}
+
+#define VNNI_DP_ROW(i)                                                         \
+  a_val = VnniBroadcastA(a + (i) * C4NUM);                                     \
+  acc##i##0 = _mm512_dpbusd_epi32(acc##i##0, a_val, weight0);                  \
+  acc##i##1 = _mm512_dpbusd_epi32(acc##i##1, a_val, weight1);                  \
+  acc##i##2 = _mm512_dpbusd_epi32(acc##i##2, a_val, weight2);                  \
+  acc##i##3 = _mm512_dpbusd_epi32(acc##i##3, a_val, weight3);
+
+#define VNNI_DP_STORE_ROW(i)                                                   \
+  _mm512_storeu_si512(dst + ((i) * VNNI_DP_COL_BLOCK) * C16NUM, acc##i##0);     \
+  _mm512_storeu_si512(dst + ((i) * VNNI_DP_COL_BLOCK + 1) * C16NUM, acc##i##1); \
+  _mm512_storeu_si512(dst + ((i) * VNNI_DP_COL_BLOCK + 2) * C16NUM, acc##i##2); \
+  _mm512_storeu_si512(dst + ((i) * VNNI_DP_COL_BLOCK + 3) * C16NUM, acc##i##3);
+
+// 4 rows x 64 columns of the row4x4-major lhs and row4x16-major rhs, the columns beyond the rhs reuse its last block.
+static inline void MatMulVnni4x64Kernel(const int8_t *a, const int8_t *b, size_t deep_4, int col_block, int32_t *dst,
+                                        int32_t *comp) {
+  size_t block_stride = deep_4 * C16NUM;
+  const int8_t *b0 = b;
+  const int8_t *b1 = b + MSMIN(1, col_block - 1) * block_stride;
+  const int8_t *b2 = b + MSMIN(2, col_block - 1) * block_stride;
+  const int8_t *b3 = b + MSMIN(3, col_block - 1) * block_stride;
+  const __m512i sign = _mm512_set1_epi32(VNNI_SIGN_FLIP);
+  __m512i acc00 = _mm512_setzero_si512(), acc01 = acc00, acc02 = acc00, acc03 = acc00;
+  __m512i acc10 = acc00, acc11 = acc00, acc12 = acc00, acc13 = acc00;
+  __m512i acc20 = acc00, acc21 = acc00, acc22 = acc00, acc23 = acc00;
+  __m512i acc30 = acc00, acc31 = acc00, acc32 = acc00, acc33 = acc00;
+  __m512i comp0 = acc00, comp1 = acc00, comp2 = acc00, comp3 = acc00;
+  __m512i a_val;
+  for (size_t offset = 0; offset < block_stride; offset += C64NUM, a += C16NUM) {
+    __m512i weight0 = _mm512_loadu_si512(b0 + offset);
+    __m512i weight1 = _mm512_loadu_si512(b1 + offset);
+    __m512i weight2 = _mm512_loadu_si512(b2 + offset);
+    __m512i weight3 = _mm512_loadu_si512(b3 + offset);
+    if (comp != NULL) {
+      comp0 = _mm512_dpbusd_epi32(comp0, sign, weight0);
+      comp1 = _mm512_dpbusd_epi32(comp1, sign, weight1);
+      comp2 = _mm512_dpbusd_epi32(comp2, sign, weight2);
+      comp3 = _mm512_dpbusd_epi32(comp3, sign, weight3);
+    }
+    VNNI_DP_ROW(0)
+    VNNI_DP_ROW(1)
+    VNNI_DP_ROW(2)
+    VNNI_DP_ROW(3)
+  }
+  VNNI_DP_STORE_ROW(0)
+  VNNI_DP_STORE_ROW(1)
+  VNNI_DP_STORE_ROW(2)
+  VNNI_DP_STORE_ROW(3)
+  if (comp != NULL) {
+    _mm512_storeu_si512(comp, comp0);
+    _mm512_storeu_si512(comp + C16NUM, comp1);
+    _mm512_storeu_si512(comp + C32NUM, comp2);
+    _mm512_storeu_si512(comp + C48NUM, comp3);
+  }
+}
+
+void MatMulDpInt8Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                      size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                      const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                      int32_t maxi, size_t per_channel, const int32_t *filter_zp) {
+  int32_t acc[C4NUM * VNNI_DP_COL_UNIT];
+  int32_t comp[VNNI_DP_COL_UNIT];
+  for (size_t c = 0; c < col; c += VNNI_DP_COL_UNIT) {
+    size_t cur_col = MSMIN(VNNI_DP_COL_UNIT, col - c);
+    int col_block = UP_DIV(cur_col, C16NUM);
+    for (size_t r = 0; r < row; r += C4NUM) {
+      // the compensation only depends on the columns, so it is accumulated with the first rows.
+      MatMulVnni4x64Kernel(a + r * deep_4, b + c * deep_4, deep_4, col_block, acc, r == 0 ? comp : NULL);
+      size_t cur_row = MSMIN(C4NUM, row - r);
+      for (size_t i = 0; i < cur_row; ++i) {
+        __m512i row_sum = _mm512_set1_epi32(input_sum[r + i]);
+        for (int j = 0; j < col_block; ++j) {
+          size_t cur_c = c + j * C16NUM;
+          __mmask16 mask = VnniColMask(col - cur_c);
+          __m512i value = _mm512_sub_epi32(_mm512_loadu_si512(acc + (i * VNNI_DP_COL_BLOCK + j) * C16NUM),
+                                           _mm512_loadu_si512(comp + j * C16NUM));
+          __m512i sum = per_channel ? _mm512_mullo_epi32(row_sum, _mm512_maskz_loadu_epi32(mask, filter_zp + cur_c))
+                                    : row_sum;
+          value = _mm512_add_epi32(_mm512_sub_epi32(value, sum), _mm512_maskz_loadu_epi32(mask, bias + cur_c));
+          size_t arg_offset = per_channel ? cur_c : 0;
+          VnniRequantStore(value, left_shift + arg_offset, right_shift + arg_offset, multiplier + arg_offset,
+                           per_channel, output_zp, mini, maxi, mask, dst + (r + i) * stride + cur_c);
+        }
+      }
+    }
+  }
+}
+
+#define VNNI_R_ROW(i)                                           \
+  a_val = VnniBroadcastA(a + (i) * C4NUM);                      \
+  acc##i##0 = _mm512_dpbusd_epi32(acc##i##0, a_val, weight0);   \
+  acc##i##1 = _mm512_dpbusd_epi32(acc##i##1, a_val, weight1);
+
+#define VNNI_R_STORE_ROW(i)                                                  \
+  _mm512_storeu_si512(dst + ((i) * VNNI_R_COL_BLOCK) * C16NUM, acc##i##0);    \
+  _mm512_storeu_si512(dst + ((i) * VNNI_R_COL_BLOCK + 1) * C16NUM, acc##i##1);
+
+static inline __m512i VnniLoadTwoBlocks(const int8_t *low, const int8_t *high) {
+  return _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256((const __m256i *)low)),
+                            _mm256_loadu_si256((const __m256i *)high), 1);
+}
+
+// 8 rows x 32 columns of the row8x4-major lhs and row4x8-major rhs, one zmm holds two blocks of 8 columns.
+static inline void MatMulVnni8x32Kernel(const int8_t *a, const int8_t *b, size_t deep_4, int col8_block,
+                                        int32_t *dst, int32_t *comp) {
+  size_t block_stride = deep_4 * C8NUM;
+  const int8_t *b0 = b;
+  const int8_t *b1 = b + MSMIN(1, col8_block - 1) * block_stride;
+  const int8_t *b2 = b + MSMIN(2, col8_block - 1) * block_stride;
+  const int8_t *b3 = b + MSMIN(3, col8_block - 1) * block_stride;
+  const __m512i sign = _mm512_set1_epi32(VNNI_SIGN_FLIP);
+  __m512i acc00 = _mm512_setzero_si512(), acc01 = acc00, acc10 = acc00, acc11 = acc00;
+  __m512i acc20 = acc00, acc21 = acc00, acc30 = acc00, acc31 = acc00;
+  __m512i acc40 = acc00, acc41 = acc00, acc50 = acc00, acc51 = acc00;
+  __m512i acc60 = acc00, acc61 = acc00, acc70 = acc00, acc71 = acc00;
+  __m512i comp0 = acc00, comp1 = acc00;
+  __m512i a_val;
+  for (size_t offset = 0; offset < block_stride; offset += C32NUM, a += C32NUM) {
+    __m512i weight0 = VnniLoadTwoBlocks(b0 + offset, b1 + offset);
+    __m512i weight1 = VnniLoadTwoBlocks(b2 + offset, b3 + offset);
+    comp0 = _mm512_dpbusd_epi32(comp0, sign, weight0);
+    comp1 = _mm512_dpbusd_epi32(comp1, sign, weight1);
+    VNNI_R_ROW(0)
+    VNNI_R_ROW(1)
+    VNNI_R_ROW(2)
+    VNNI_R_ROW(3)
+    VNNI_R_ROW(4)
+    VNNI_R_ROW(5)
+    VNNI_R_ROW(6)
+    VNNI_R_ROW(7)
+  }
+  VNNI_R_STORE_ROW(0)
+  VNNI_R_STORE_ROW(1)
+  VNNI_R_STORE_ROW(2)
+  VNNI_R_STORE_ROW(3)
+  VNNI_R_STORE_ROW(4)
+  VNNI_R_STORE_ROW(5)
+  VNNI_R_STORE_ROW(6)
+  VNNI_R_STORE_ROW(7)
+  _mm512_storeu_si512(comp, comp0);
+  _mm512_storeu_si512(comp + C16NUM, comp1);
+}
+
+void MatMulRInt8Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                     size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                     const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                     int32_t maxi, size_t per_channel) {
+  int32_t acc[C8NUM * VNNI_R_COL_UNIT];
+  int32_t comp[VNNI_R_COL_UNIT];
+  size_t row8 = UP_ROUND(row, C8NUM);
+  for (size_t c = 0; c < col; c += VNNI_R_COL_UNIT) {
+    size_t cur_col = MSMIN(VNNI_R_COL_UNIT, col - c);
+    int col_block = UP_DIV(cur_col, C16NUM);
+    for (size_t r = 0; r < row; r += C8NUM) {
+      MatMulVnni8x32Kernel(a + r * deep_4, b + c * deep_4, deep_4, UP_DIV(cur_col, C8NUM), acc, comp);
+      size_t cur_row = MSMIN(C8NUM, row - r);
+      for (size_t i = 0; i < cur_row; ++i) {
+        for (int j = 0; j < col_block; ++j) {
+          size_t cur_c = c + j * C16NUM;
+          __mmask16 mask = VnniColMask(col - cur_c);
+          __m512i value = _mm512_sub_epi32(_mm512_loadu_si512(acc + (i * VNNI_R_COL_BLOCK + j) * C16NUM),
+                                           _mm512_loadu_si512(comp + j * C16NUM));
+          __m512i sum;
+          if (per_channel) {
+            // the sums of the input are in the layout of [col / 8, row8, 8]
+            const int32_t *sum_ptr = input_sum + cur_c * row8 + (r + i) * C8NUM;
+            __m256i sum_low = _mm256_maskz_loadu_epi32((__mmask8)mask, sum_ptr);
+            __m256i sum_high = _mm256_maskz_loadu_epi32((__mmask8)(mask >> C8NUM), sum_ptr + row8 * C8NUM);
+            sum = _mm512_inserti64x4(_mm512_castsi256_si512(sum_low), sum_high, 1);
+          } else {
+            sum = _mm512_set1_epi32(input_sum[r + i]);
+          }
+          value = _mm512_add_epi32(_mm512_sub_epi32(value, sum), _mm512_maskz_loadu_epi32(mask, bias + cur_c));
+          size_t arg_offset = per_channel ? cur_c : 0;
+          VnniRequantStore(value, left_shift + arg_offset, right_shift + arg_offset, multiplier + arg_offset,
+                           per_channel, output_zp, mini, maxi, mask, dst + (r + i) * stride + cur_c);
+        }
+      }
+    }
+  }
+}
+
+void DynamicMatmulVnni4x4x16AIWI(const int8_t *a, const int8_t *b, float *out, size_t deep4, const float *multi_scales,
+                                 const float *bias, size_t row, size_t col, size_t stride, const int32_t *a_sums,
+                                 const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum, int64_t act_type) {
+  int32_t acc[C4NUM * VNNI_DP_COL_UNIT];
+  int32_t comp[VNNI_DP_COL_UNIT];
+  __m512i a_zp_val = _mm512_set1_epi32((int32_t)a_zp);
+  __m512i zp_sum = _mm512_set1_epi32((int32_t)(a_zp * b_zp_sum));
+  __m512 zero = _mm512_setzero_ps();
+  __m512 six = _mm512_set1_ps(C6NUM);
+  for (size_t c = 0; c < col; c += VNNI_DP_COL_UNIT) {
+    size_t cur_col = MSMIN(VNNI_DP_COL_UNIT, col - c);
+    int col_block = UP_DIV(cur_col, C16NUM);
+    for (size_t r = 0; r < row; r += C4NUM) {
+      MatMulVnni4x64Kernel(a + r * deep4, b + c * deep4, deep4, col_block, acc, r == 0 ? comp : NULL);
+      size_t cur_row = MSMIN(C4NUM, row - r);
+      for (size_t i = 0; i < cur_row; ++i) {
+        __m512i row_sum = _mm512_set1_epi32(a_sums[r + i]);
+        float *cur_out = out + (r + i) * stride / sizeof(float);
+        for (int j = 0; j < col_block; ++j) {
+          size_t cur_c = c + j * C16NUM;
+          __mmask16 mask = VnniColMask(col - cur_c);
+          __m512i value = _mm512_sub_epi32(_mm512_loadu_si512(acc + (i * VNNI_DP_COL_BLOCK + j) * C16NUM),
+                                           _mm512_loadu_si512(comp + j * C16NUM));
+          value = _mm512_sub_epi32(value, row_sum);
+          value = _mm512_sub_epi32(value, _mm512_mullo_epi32(_mm512_maskz_loadu_epi32(mask, b_sums + cur_c), a_zp_val));
+          value = _mm512_add_epi32(value, zp_sum);
+          __m512 res = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, multi_scales + cur_c), _mm512_cvtepi32_ps(value));
+          if (bias != NULL) {
+            res = _mm512_add_ps(res, _mm512_maskz_loadu_ps(mask, bias + cur_c));
+          }
+          if (act_type == ActType_Relu) {
+            res = _mm512_max_ps(res, zero);
+          } else if (act_type == ActType_Relu6) {
+            res = _mm512_min_ps(_mm512_max_ps(res, zero), six);
+          }
+          _mm512_mask_storeu_ps(cur_out + cur_c, mask, res);
+        }
+      }
+    }
+  }
+}
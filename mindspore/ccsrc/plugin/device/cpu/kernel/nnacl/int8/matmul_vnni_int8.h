@@ -0,0 +1,45 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_INT8_MATMUL_VNNI_INT8_H_
+#define MINDSPORE_NNACL_INT8_MATMUL_VNNI_INT8_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* avx512 vnni, the packed layouts are the same as the ones of the arm64 sdot kernels */
+/* row4x4-major * row4x16-major => (int8)row-major, same as MatMulInt8_4x16_r */
+void MatMulDpInt8Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                      size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                      const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                      int32_t maxi, size_t per_channel, const int32_t *filter_zp);
+
+/* row8x4-major * row4x8-major => (int8)row-major, same as MatMulInt8_8x8_r */
+void MatMulRInt8Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                     size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                     const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                     int32_t maxi, size_t per_channel);
+
+/* row4x4-major * row4x16-major => (fp32)row-major, same as DynamicMatmul4x4x16AIWI */
+void DynamicMatmulVnni4x4x16AIWI(const int8_t *a, const int8_t *b, float *out, size_t deep4, const float *multi_scales,
+                                 const float *bias, size_t row, size_t col, size_t stride, const int32_t *a_sums,
+                                 const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum, int64_t act_type);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_INT8_MATMUL_VNNI_INT8_H_
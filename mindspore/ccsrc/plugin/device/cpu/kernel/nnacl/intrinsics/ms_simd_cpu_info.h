@@ -48,6 +48,10 @@ const bool X86_Fma_Support(void);
 const bool X86_Sse_Support(void);
 const bool X86_Avx_Support(void);
 const bool X86_Avx512_Support(void);
+// avx512 vnni with the avx512bw/avx512vl extensions, which the int8 vpdpbusd kernels need.
+const bool X86_Avx512Vnni_Support(void);
+// avx512 bf16 with the avx512bw/avx512vl extensions, which the bf16 vdpbf16ps kernels need.
+const bool X86_Avx512Bf16_Support(void);
 
 bool IsIntelX86Platform(void);
 X86CpuInfoErrorCodeEnum IntelX86InstructionSetSupportCheck(void);
@@ -43,6 +43,8 @@ typedef enum MatmulType {
   kMatmulDynamicSdotInt8Cpu,
   kMatmulFp32BaseCpu,
   kMatmulFp32Arm64Cpu,
+  kMatmulWeightQuantFp32Cpu,
+  kMatmulBf16Cpu,
 } MatmulType;
 
 typedef struct MatMulParameter {
@@ -551,6 +551,8 @@ enum PrimType {
   PrimType_Inner_GraphKernel = 10004,
   PrimType_Inner_SplitReduceConcatFusion = 10005,
   PrimType_Inner_EncoderLayer = 10006,
+  PrimType_Inner_FlashAttention = 10007,
+  PrimType_Inner_KVCacheAttention = 10008,
   PrimType_InnerOpMax,
   PrimType_InnerOpMin = PrimType_Inner_ToFormat
 };
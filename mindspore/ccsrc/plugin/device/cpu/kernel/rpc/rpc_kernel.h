@@ -21,17 +21,37 @@
 
 namespace mindspore {
 namespace kernel {
+// The magic header of the dynamic shape data whose meta info is in the fixed layout below instead of protobuf, so the
+// sender writes it and the receiver reads it in place without serializing. The format of one input is shown below:
+// |--------22 bytes------|----------8 bytes----------|--8 bytes * dim_num--| data size bytes |
+// |RPC_DYNAMIC_SHAPE_FIXD|RpcDynamicShapeMeta of input|     shape vector     |    real data    |
+constexpr char kRpcDynamicShapeFixedData[] = "RPC_DYNAMIC_SHAPE_FIXD";
+
+struct RpcDynamicShapeMeta {
+  int32_t type_id;
+  uint32_t dim_num;
+};
+
+// The size of the fixed layout dynamic shape header of the input with dim_num dims, not including the real data.
+inline size_t GetRpcDynamicShapeHeaderSize(size_t dim_num) {
+  return sizeof(kRpcDynamicShapeFixedData) - 1 + sizeof(RpcDynamicShapeMeta) + dim_num * sizeof(int64_t);
+}
+
 class RpcKernelMod : public NativeCpuKernelMod {
  public:
-  RpcKernelMod() : remote_input_(nullptr), is_dynamic_shape_(false) {}
+  RpcKernelMod() : remote_input_(nullptr), remote_input_in_place_(false), is_dynamic_shape_(false) {}
   ~RpcKernelMod() override = default;
 
   // Set and get remote data as input.
   void SetRemoteInput(MessageBase *const msg) { remote_input_ = msg; }
   MessageBase *GetRemoteInput() { return remote_input_; }
 
+  // Set whether the remote data is received into the memory of the inputs already, which needs no copying.
+  void set_remote_input_in_place(bool in_place) { remote_input_in_place_ = in_place; }
+
  protected:
   MessageBase *remote_input_;
+  bool remote_input_in_place_;
 
   // Whether this kernel sends or receives dynamic shape data.
   bool is_dynamic_shape_;
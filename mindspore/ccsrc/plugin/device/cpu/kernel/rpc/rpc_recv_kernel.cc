@@ -30,6 +30,12 @@ bool RpcRecvKernelMod::Launch(const std::vector<AddressPtr> &inputs, const std::
   }
 
   MS_EXCEPTION_IF_NULL(remote_input_);
+  if (remote_input_in_place_) {
+    MS_LOG(DEBUG) << "The remote data is received into the inputs of RpcRecv, no need to copy it.";
+    delete remote_input_;
+    return true;
+  }
+
   // If the string body is not empty, it means we need to copy data from 'body' instead of raw pointer 'data'.
   bool use_string_msg = !remote_input_->Body().empty();
   auto data_ptr = use_string_msg ? (remote_input_->Body().data()) : (static_cast<char *>(remote_input_->data));
@@ -15,6 +15,7 @@
  */
 
 #include "plugin/device/cpu/kernel/rpc/rpc_send_kernel.h"
+#include <algorithm>
 #include <string>
 #include "runtime/device/ms_device_shape_transfer.h"
 #include "proto/rpc.pb.h"
@@ -61,9 +62,10 @@ size_t RpcSendKernelMod::GetDynamicShapeMsgSize(const KernelTensorPtr &dynamic_s
   *pb_msg.mutable_shape_vector() = {shapes.begin(), shapes.end()};
   std::string pb_msg_str = pb_msg.SerializeAsString();
 
-  msg_size += strlen(kRpcDynamicShapeData);
-  msg_size += sizeof(size_t);
-  msg_size += pb_msg_str.size();
+  // The meta info is serialized in the fixed layout if the message is sent without copying the inputs, or in protobuf
+  // otherwise. So the workspace fits the larger one.
+  msg_size += std::max(strlen(kRpcDynamicShapeData) + sizeof(size_t) + pb_msg_str.size(),
+                       GetRpcDynamicShapeHeaderSize(shapes.size()));
   msg_size += input_size;
   return msg_size;
 }
@@ -29,6 +29,51 @@ namespace mindspore {
 namespace kernel {
 constexpr size_t kScatterArithmeticInputsNum = 3;
 constexpr size_t kScatterArithmeticOutputsNum = 1;
+// The rows of input are divided into stripes by the index, and the updates of each stripe are applied by one thread.
+constexpr size_t kScatterStripeNum = 64;
+// The minimum element number of updates to apply in parallel.
+constexpr size_t kScatterParallelDataNum = 32 * 1024;
+
+namespace {
+enum class ScatterRowOp { kUpdate, kAdd, kSub, kMul, kMax, kMin };
+
+// Apply the updates to one row of the input, the loops are simple enough to be vectorized by the compiler.
+template <typename T>
+void ScatterRow(ScatterRowOp op, T *input, const T *updates, size_t size) {
+  switch (op) {
+    case ScatterRowOp::kUpdate:
+      (void)std::copy(updates, updates + size, input);
+      break;
+    case ScatterRowOp::kAdd:
+      for (size_t j = 0; j < size; j++) {
+        input[j] += updates[j];
+      }
+      break;
+    case ScatterRowOp::kSub:
+      for (size_t j = 0; j < size; j++) {
+        input[j] -= updates[j];
+      }
+      break;
+    case ScatterRowOp::kMul:
+      for (size_t j = 0; j < size; j++) {
+        input[j] *= updates[j];
+      }
+      break;
+    case ScatterRowOp::kMax:
+      for (size_t j = 0; j < size; j++) {
+        input[j] = input[j] > updates[j] ? input[j] : updates[j];
+      }
+      break;
+    case ScatterRowOp::kMin:
+      for (size_t j = 0; j < size; j++) {
+        input[j] = input[j] > updates[j] ? updates[j] : input[j];
+      }
+      break;
+    default:
+      break;
+  }
+}
+}  // namespace
 
 bool ScatterArithmeticCpuKernelMod::Init(const BaseOperatorPtr &base_operator,
                                          const std::vector<KernelTensorPtr> &inputs,
@@ -117,6 +162,7 @@ bool ScatterArithmeticCpuKernelMod::LaunchKernel(const std::vector<kernel::Addre
       }
     }
   } else {
+    // The embedding storage applies the whole batch under its own lock, so the rows are not striped on this path.
     if (enable_embedding_storage_) {
       auto embedding_storage = embedding_storage_manager.Get(parameter_key_);
       MS_ERROR_IF_NULL(embedding_storage);
@@ -130,16 +176,38 @@ bool ScatterArithmeticCpuKernelMod::LaunchKernel(const std::vector<kernel::Addre
 
     for (size_t i = 0; i < indices_size_; i++) {
       auto idx = static_cast<int>(*(indices + i));
-      auto base_index_updates = i * inner_size_;
-      auto base_index_input = idx * inner_size_;
       if (idx < 0 || idx >= first_dim_size_) {
         MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the value of indices should be in [0, " << first_dim_size_
                           << "), but got '" << idx << "' in indices.";
       }
-      for (size_t j = 0; j < inner_size_; j++) {
-        func_iter->second((input + base_index_input + j), (updates + base_index_updates + j));
-      }
     }
+
+    static const mindspore::HashMap<std::string, ScatterRowOp> scatter_row_op_map{
+      {prim::kPrimScatterUpdate->name(), ScatterRowOp::kUpdate}, {prim::kPrimScatterAdd->name(), ScatterRowOp::kAdd},
+      {prim::kPrimScatterSub->name(), ScatterRowOp::kSub},       {prim::kPrimScatterMul->name(), ScatterRowOp::kMul},
+      {prim::kPrimScatterMax->name(), ScatterRowOp::kMax},       {prim::kPrimScatterMin->name(), ScatterRowOp::kMin},
+    };
+    auto op_iter = scatter_row_op_map.find(kernel_name_);
+    if (op_iter == scatter_row_op_map.end()) {
+      MS_LOG(ERROR) << "For '" << kernel_name_ << "', the current operator does not support this operation.";
+      return false;
+    }
+    ScatterRowOp op = op_iter->second;
+
+    // The updates of the same row are always applied by the same thread in order, so the rows need no lock and the
+    // result is the same as the serial one even if the indices are duplicated.
+    size_t stripe_num = (indices_size_ * inner_size_ < kScatterParallelDataNum) ? 1 : kScatterStripeNum;
+    auto task = [this, op, input, indices, updates, stripe_num](size_t start, size_t end) {
+      for (size_t i = 0; i < indices_size_; i++) {
+        auto idx = static_cast<size_t>(*(indices + i));
+        size_t stripe = idx % stripe_num;
+        if (stripe < start || stripe >= end) {
+          continue;
+        }
+        ScatterRow(op, input + idx * inner_size_, updates + i * inner_size_, inner_size_);
+      }
+    };
+    ParallelLaunch(task, stripe_num, 1.0, this);
   }
 
   // Scatter ops are registered as a ref type operator. The new runtime supports the ref mechanism with the same input
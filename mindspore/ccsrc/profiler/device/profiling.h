@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_PROFILER_DEVICE_PROFILING_H
 #define MINDSPORE_CCSRC_PROFILER_DEVICE_PROFILING_H
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <map>
 #include <memory>
@@ -69,10 +70,25 @@ class BACKEND_EXPORT ProfilerManager {
   std::string GetProfilingOptions() const;
   bool GetNetDynamicShapeStatus() const { return is_dynamic_shape_net_; }
   void SetNetDynamicShapeStatus() { is_dynamic_shape_net_ = true; }
+  // The statistics of the infer shape and resize cache of the dynamic shape kernels.
+  void RecordInferCacheAccess(bool is_hit) {
+    if (is_hit) {
+      infer_cache_hit_count_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      infer_cache_miss_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  void RecordResizeSkipped() { resize_skipped_count_.fetch_add(1, std::memory_order_relaxed); }
+  uint64_t GetInferCacheHitCount() const { return infer_cache_hit_count_.load(std::memory_order_relaxed); }
+  uint64_t GetInferCacheMissCount() const { return infer_cache_miss_count_.load(std::memory_order_relaxed); }
+  uint64_t GetResizeSkippedCount() const { return resize_skipped_count_.load(std::memory_order_relaxed); }
 
  private:
   inline static std::shared_ptr<ProfilerManager> profiler_manager_inst_ = std::make_shared<ProfilerManager>();
   bool is_dynamic_shape_net_ = 0;
+  std::atomic<uint64_t> infer_cache_hit_count_{0};
+  std::atomic<uint64_t> infer_cache_miss_count_{0};
+  std::atomic<uint64_t> resize_skipped_count_{0};
 };
 
 class BACKEND_EXPORT Profiler {
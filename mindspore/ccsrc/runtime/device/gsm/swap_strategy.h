@@ -18,6 +18,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <string>
 #include "ir/anf.h"
 
 namespace mindspore {
@@ -64,6 +65,9 @@ struct TensorAction {
 
 struct SwapAction {
   std::vector<std::shared_ptr<TensorAction>> actions_;
+  // The estimated execution time(us) of the kernels which the prefetched swap in can be overlapped with, zero means the
+  // action blocks the next kernel.
+  float overlap_time_{0};
 };
 
 struct SwapLink {
@@ -92,6 +96,18 @@ class SwapContext {
   bool offload_param_to_disk_{false};
   bool offload_checkpoint_to_ddr_{false};
   bool offload_checkpoint_to_disk_{false};
+  // The cost model of swap in prefetch: issue the swap in early enough to hide the transfer time under the execution of
+  // the kernels before the consumer kernel. It is enabled by the kernel time profile 'MS_DEV_SWAP_KERNEL_PROFILE'.
+  bool enable_prefetch_{false};
+  // The bandwidth of ddr to hbm and disk to hbm, in bytes per microsecond, which can be set by 'MS_DEV_SWAP_BANDWIDTH'.
+  // The defaults are the conservative effective bandwidth of PCIe 3.0 x16 host to device copy(about 10GB/s) and the
+  // sequential read of NVMe SSD(about 1GB/s).
+  float ddr_bandwidth_{10000.0f};
+  float disk_bandwidth_{1000.0f};
+  // The execution time(us) of kernels by the full name, the default time is used for the kernel not profiled, which is
+  // set to the average time of the profiled kernels.
+  std::map<std::string, float> kernel_time_;
+  float default_kernel_time_{10.0f};
 };
 }  // namespace device
 }  // namespace mindspore
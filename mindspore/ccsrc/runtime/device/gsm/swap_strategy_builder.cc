@@ -18,6 +18,7 @@
 #include <queue>
 #include <set>
 #include <functional>
+#include <utility>
 #include "runtime/device/gsm/swap_strategy.h"
 #include "runtime/device/gsm/mem_usage_analyzer.h"
 #include "include/backend/kernel_graph.h"
@@ -33,6 +34,7 @@ void CheckVectorIndex(const std::vector<T> &input, size_t index) {
 }
 }  // namespace
 const size_t kSwapVirtualNodeNum = 2;  // Mark graph start and end node as virtual node
+const size_t kSwapOutActionOffset = 1;  // The swap out is issued after the last kernel using the tensor
 void SwapStrategyBuilder::ResetState(const KernelGraphPtr &graph, const std::shared_ptr<SwapContext> &context) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(context);
@@ -57,6 +59,20 @@ void SwapStrategyBuilder::ResetState(const KernelGraphPtr &graph, const std::sha
 
   kernel_actions_.clear();
   kernel_actions_.resize(kernel_num_ + kSwapVirtualNodeNum);
+  prefetch_actions_.clear();
+  InitKernelTime(graph);
+}
+
+void SwapStrategyBuilder::InitKernelTime(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(context_);
+  kernel_time_.clear();
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    const auto &iter = context_->kernel_time_.find(kernel->fullname_with_scope());
+    (void)kernel_time_.emplace_back(iter == context_->kernel_time_.end() ? context_->default_kernel_time_
+                                                                         : iter->second);
+  }
 }
 
 void SwapStrategyBuilder::AnalyzeGraph(const KernelGraphPtr &graph) {
@@ -327,11 +343,70 @@ void SwapStrategyBuilder::HandleFusedTensor() {
   }
 }
 
+void SwapStrategyBuilder::AddPrefetchTensorAction(SwapActionType action_type, const std::shared_ptr<Span> &span) {
+  MS_EXCEPTION_IF_NULL(span);
+  auto action = std::make_shared<TensorAction>();
+  action->action_ = action_type;
+  action->tensor_id_ = span->tensor_id_;
+
+  auto &swap_action = prefetch_actions_[std::make_pair(span->prefetch_index_, span->current_index_)];
+  if (swap_action == nullptr) {
+    swap_action = std::make_shared<SwapAction>();
+    swap_action->overlap_time_ = span->overlap_time_;
+  }
+  (void)swap_action->actions_.emplace_back(action);
+}
+
+void SwapStrategyBuilder::PlanPrefetch(const std::vector<std::shared_ptr<Span>> &spans, float bandwidth) {
+  MS_EXCEPTION_IF_NULL(context_);
+  for (const auto &span : spans) {
+    MS_EXCEPTION_IF_NULL(span);
+    span->prefetch_index_ = span->current_index_;
+    // The swap in of graph input span is across the steps, and the graph output span doesn't need swap in.
+    if (!context_->enable_prefetch_ || span->output_span_ || span->current_index_ >= kernel_num_ ||
+        bandwidth <= 0) {
+      continue;
+    }
+
+    const float transfer_time = static_cast<float>(span->tensor_size_) / bandwidth;
+    float overlap_time = 0;
+    size_t index = span->current_index_;
+    // Move the swap in forward kernel by kernel until the transfer time is hidden, the swap in must be after the swap
+    // out at last_index_ + 1, and the tensor occupies the hbm during the overlapped kernels.
+    while (index > span->last_index_ + kSwapOutActionOffset + 1 && overlap_time < transfer_time) {
+      const size_t kernel_index = index - 1;
+      CheckVectorIndex(mem_used_level0_, kernel_index);
+      if (mem_used_level0_[kernel_index] + span->tensor_size_ > total_mem_level0_) {
+        break;
+      }
+      mem_used_level0_[kernel_index] += span->tensor_size_;
+      overlap_time += kernel_time_[kernel_index];
+      index = kernel_index;
+    }
+    span->prefetch_index_ = index;
+    span->overlap_time_ = overlap_time;
+    MS_LOG(DEBUG) << "Prefetch tensor " << span->tensor_id_ << " at " << index << " for kernel "
+                  << span->current_index_ << ", transfer time: " << transfer_time
+                  << "us, overlap time: " << overlap_time << "us.";
+  }
+}
+
+void SwapStrategyBuilder::PlanPrefetch() {
+  MS_EXCEPTION_IF_NULL(context_);
+  PlanPrefetch(span_level1_, context_->ddr_bandwidth_);
+  PlanPrefetch(span_level2_, context_->disk_bandwidth_);
+}
+
 void SwapStrategyBuilder::SpanToTensorAction() {
   for (auto span : span_level1_) {
     MS_EXCEPTION_IF_NULL(span);
     AddTensorAction(SwapActionType::kHBM2DDR, span->tensor_id_, span->last_index_ + 1);
-    if (!span->output_span_) {
+    if (span->output_span_) {
+      continue;
+    }
+    if (span->prefetch_index_ < span->current_index_) {
+      AddPrefetchTensorAction(SwapActionType::kDDR2HBM, span);
+    } else {
       AddTensorAction(SwapActionType::kDDR2HBM, span->tensor_id_, span->current_index_ % kernel_num_);
     }
   }
@@ -339,7 +414,12 @@ void SwapStrategyBuilder::SpanToTensorAction() {
   for (auto span : span_level2_) {
     MS_EXCEPTION_IF_NULL(span);
     AddTensorAction(SwapActionType::kHBM2DISK, span->tensor_id_, span->last_index_ + 1);
-    if (!span->output_span_) {
+    if (span->output_span_) {
+      continue;
+    }
+    if (span->prefetch_index_ < span->current_index_) {
+      AddPrefetchTensorAction(SwapActionType::kDISK2HBM, span);
+    } else {
       AddTensorAction(SwapActionType::kDISK2HBM, span->tensor_id_, span->current_index_ % kernel_num_);
     }
   }
@@ -376,6 +456,17 @@ std::shared_ptr<SwapStrategy> SwapStrategyBuilder::BuildStrategy(const KernelGra
     ++action_id;
   }
 
+  // The prefetched swap in is issued after the kernel at issue index, and only blocks the consumer kernel, so that the
+  // transfer can be overlapped with the kernels between them.
+  for (const auto &iter : prefetch_actions_) {
+    const auto issue_index = iter.first.first;
+    const auto consumer_index = iter.first.second;
+    strategy->actions_[action_id] = iter.second;
+    (void)strategy->links_.emplace_back(std::make_shared<SwapLink>(issue_index, action_id));
+    (void)strategy->links_.emplace_back(std::make_shared<SwapLink>(action_id, consumer_index + 1));
+    ++action_id;
+  }
+
   strategy->kernel_infos_ = analyzer_->GetMemUsageKernelInfos();
   strategy->tensor_infos_ = analyzer_->GetMemUsageTensorInfos();
   return strategy;
@@ -395,6 +486,8 @@ std::shared_ptr<SwapStrategy> SwapStrategyBuilder::Build(const KernelGraphPtr &g
 
   ClassifySpanLevel();
 
+  PlanPrefetch();
+
   SpanToTensorAction();
 
   return BuildStrategy(graph);
@@ -15,7 +15,9 @@
  */
 #ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_SWAP_STRATEGY_BUILDER_H_
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_GSM_SWAP_STRATEGY_BUILDER_H_
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <queue>
 #include "runtime/device/gsm/swap_strategy.h"
@@ -37,6 +39,9 @@ class BACKEND_EXPORT SwapStrategyBuilder {
     size_t current_index_{0};
     size_t weight_{0};
     bool output_span_{false};
+    // The index to issue the swap in, which is equal to current_index_ when the swap in is not prefetched.
+    size_t prefetch_index_{0};
+    float overlap_time_{0};
   };
 
   struct SpanCmp {
@@ -61,6 +66,10 @@ class BACKEND_EXPORT SwapStrategyBuilder {
   size_t total_mem_level0_{0};
   size_t total_mem_level1_{0};
   std::vector<std::vector<std::shared_ptr<TensorAction>>> kernel_actions_;
+  // The execution time(us) of each kernel in execution order.
+  std::vector<float> kernel_time_;
+  // The prefetched swap in actions: (issue index, consumer index) - actions.
+  std::map<std::pair<size_t, size_t>, std::shared_ptr<SwapAction>> prefetch_actions_;
 
   void ResetState(const KernelGraphPtr &graph, const std::shared_ptr<SwapContext> &context);
   void AnalyzeGraph(const KernelGraphPtr &graph);
@@ -70,12 +79,16 @@ class BACKEND_EXPORT SwapStrategyBuilder {
   void AddFusedTensorSpan(const std::shared_ptr<MemUsageTensorInfo> &info, size_t start_index,
                           size_t current_kernel_id);
   void HandleFusedTensor();
+  void InitKernelTime(const KernelGraphPtr &graph);
+  void PlanPrefetch(const std::vector<std::shared_ptr<Span>> &spans, float bandwidth);
+  void PlanPrefetch();
   void SpanToTensorAction();
   void RecordSpan(const std::shared_ptr<MemUsageTensorInfo> &info, size_t last_index, size_t current_index,
                   bool output_span = false);
   bool EnoughSpaceForSpan(const std::shared_ptr<Span> &span, std::vector<size_t> *mem_used,
                           size_t total_mem_size) const;
   void AddTensorAction(SwapActionType action_type, size_t tensor_id, size_t kernel_id);
+  void AddPrefetchTensorAction(SwapActionType action_type, const std::shared_ptr<Span> &span);
   std::shared_ptr<SwapStrategy> BuildStrategy(const KernelGraphPtr &graph);
 };
 }  // namespace device
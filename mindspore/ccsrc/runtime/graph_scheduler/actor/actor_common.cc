@@ -19,6 +19,7 @@
 #include "runtime/graph_scheduler/device_tensor_store.h"
 #include "utils/ms_context.h"
 #include "include/common/utils/anfalgo.h"
+#include "include/common/utils/parallel_context.h"
 #include "ps/ps_context.h"
 
 namespace mindspore {
@@ -28,6 +29,7 @@ bool ActorDispatcher::is_memory_allocation_sync_ = true;
 bool ActorDispatcher::is_memory_free_sync_ = true;
 
 constexpr char kLaunchSkippedEnv[] = "MS_KERNEL_LAUNCH_SKIP";
+constexpr char kCommunicationOverlapEnv[] = "MS_CPU_COMM_OVERLAP";
 
 bool IsRunningFailed(const OpContext<DeviceTensor> *context) {
   MS_EXCEPTION_IF_NULL(context);
@@ -60,6 +62,12 @@ void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread
     *actor_and_kernel_thread_num = runtime_num_threads_min + *actor_thread_num;
   }
 
+  // The communication thread takes a core, so the kernel threads give up one core to avoid the oversubscription.
+  if (EnableCommunicationOverlap() && (context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kCPUDevice) &&
+      (*actor_and_kernel_thread_num >= cpu_core_num) && (*actor_and_kernel_thread_num > *actor_thread_num + 1)) {
+    --(*actor_and_kernel_thread_num);
+  }
+
   if (*actor_and_kernel_thread_num > cpu_core_num) {
     MS_LOG(WARNING) << "The total num of thread pool is " << *actor_and_kernel_thread_num
                     << ", but the num of cpu core is " << cpu_core_num
@@ -67,6 +75,20 @@ void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread
   }
 }
 
+bool EnableCommunicationOverlap() {
+  static const bool enable_communication_overlap = (common::GetEnv(kCommunicationOverlapEnv) == "1");
+  return enable_communication_overlap;
+}
+
+bool EnablePipelineBubbleRecord() {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  return (context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kCPUDevice) &&
+         (parallel_context->pipeline_stage_split_num() > 1);
+}
+
 bool IsDeviceQueueDSActor(const AnfNodePtr &node, GraphExecutionStrategy strategy) {
   MS_EXCEPTION_IF_NULL(node);
   if (strategy == GraphExecutionStrategy::kStep) {
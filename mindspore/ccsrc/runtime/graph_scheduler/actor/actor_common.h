@@ -253,6 +253,13 @@ bool IsRunningFailed(const OpContext<DeviceTensor> *context);
 
 void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread_num);
 
+// Judge whether launch the cpu communication kernels in the communication thread to overlap with the computation by the
+// env MS_CPU_COMM_OVERLAP.
+bool EnableCommunicationOverlap();
+
+// Judge whether record the idle time of the cpu pipeline stage, in which no computation kernel is running.
+bool EnablePipelineBubbleRecord();
+
 bool IsDeviceQueueDSActor(const AnfNodePtr &node, GraphExecutionStrategy strategy = GraphExecutionStrategy::kPipeline);
 
 // Host parameters are parameters of root funcgraph, in control flow, only the parameters of the root funcgraph are
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/communication_launcher.h"
+#include <algorithm>
+#include "utils/log_adapter.h"
+#include "utils/profile.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr double kSecondsToMilliseconds = 1000;
+
+// Sort the intervals and merge the overlapped ones, the intervals are clipped to [begin_time, end_time].
+std::vector<std::pair<double, double>> MergeIntervals(std::vector<std::pair<double, double>> *intervals,
+                                                      double begin_time, double end_time) {
+  MS_EXCEPTION_IF_NULL(intervals);
+  std::sort(intervals->begin(), intervals->end());
+  std::vector<std::pair<double, double>> merged_intervals;
+  for (const auto &interval : *intervals) {
+    double interval_begin = std::max(interval.first, begin_time);
+    double interval_end = std::min(interval.second, end_time);
+    if (interval_end <= interval_begin) {
+      continue;
+    }
+    if (!merged_intervals.empty() && interval_begin <= merged_intervals.back().second) {
+      merged_intervals.back().second = std::max(merged_intervals.back().second, interval_end);
+      continue;
+    }
+    (void)merged_intervals.emplace_back(interval_begin, interval_end);
+  }
+  return merged_intervals;
+}
+}  // namespace
+
+CommunicationLauncher &CommunicationLauncher::GetInstance() {
+  static CommunicationLauncher instance;
+  return instance;
+}
+
+CommunicationLauncher::~CommunicationLauncher() { Finalize(); }
+
+void CommunicationLauncher::Push(std::function<void()> &&task) {
+  std::unique_lock<std::mutex> lock(task_mutex_);
+  if (!thread_.joinable()) {
+    stopped_ = false;
+    thread_ = std::thread(&CommunicationLauncher::Run, this);
+    MS_LOG(INFO) << "The communication thread is created.";
+  }
+  tasks_.push(std::move(task));
+  task_cond_var_.notify_one();
+}
+
+void CommunicationLauncher::Finalize() {
+  {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    stopped_ = true;
+    task_cond_var_.notify_one();
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void CommunicationLauncher::Run() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(task_mutex_);
+      task_cond_var_.wait(lock, [this]() { return stopped_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+
+    task();
+  }
+}
+
+void CommunicationLauncher::StepBegin() { StepBegin(GetTime()); }
+
+void CommunicationLauncher::StepBegin(double begin_time) {
+  std::unique_lock<std::mutex> lock(interval_mutex_);
+  communication_intervals_.clear();
+  computation_intervals_.clear();
+  step_begin_time_ = begin_time;
+}
+
+StepTimeBreakdown CommunicationLauncher::StepEnd() { return StepEnd(GetTime()); }
+
+StepTimeBreakdown CommunicationLauncher::StepEnd(double step_end_time) {
+  StepTimeBreakdown breakdown;
+  std::unique_lock<std::mutex> lock(interval_mutex_);
+  breakdown.step_time_ = (step_end_time - step_begin_time_) * kSecondsToMilliseconds;
+  // The computation kernels run in several actor threads, and the communication kernels run in turn in the
+  // communication thread, so the communication is overlapped where it intersects the merged computation intervals.
+  const auto &busy_intervals = MergeIntervals(&computation_intervals_, step_begin_time_, step_end_time);
+  const auto &communication_intervals = MergeIntervals(&communication_intervals_, step_begin_time_, step_end_time);
+  size_t busy_index = 0;
+  for (const auto &interval : communication_intervals) {
+    breakdown.communication_time_ += (interval.second - interval.first) * kSecondsToMilliseconds;
+    while (busy_index < busy_intervals.size() && busy_intervals[busy_index].second <= interval.first) {
+      ++busy_index;
+    }
+    for (size_t i = busy_index; i < busy_intervals.size() && busy_intervals[i].first < interval.second; ++i) {
+      double overlapped_begin_time = std::max(interval.first, busy_intervals[i].first);
+      double overlapped_end_time = std::min(interval.second, busy_intervals[i].second);
+      breakdown.overlapped_communication_time_ +=
+        (overlapped_end_time - overlapped_begin_time) * kSecondsToMilliseconds;
+    }
+  }
+  breakdown.exposed_communication_time_ = breakdown.communication_time_ - breakdown.overlapped_communication_time_;
+  MS_LOG(INFO) << "The step time: " << breakdown.step_time_ << "ms, communication time: "
+               << breakdown.communication_time_ << "ms of " << communication_intervals_.size()
+               << " kernels, overlapped communication time: " << breakdown.overlapped_communication_time_
+               << "ms, exposed communication time: " << breakdown.exposed_communication_time_ << "ms.";
+  return breakdown;
+}
+
+void CommunicationLauncher::RecordComputation(double begin_time, double end_time) {
+  std::unique_lock<std::mutex> lock(interval_mutex_);
+  (void)computation_intervals_.emplace_back(begin_time, end_time);
+}
+
+void CommunicationLauncher::RecordCommunication(double begin_time, double end_time) {
+  std::unique_lock<std::mutex> lock(interval_mutex_);
+  (void)communication_intervals_.emplace_back(begin_time, end_time);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_COMMUNICATION_LAUNCHER_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_COMMUNICATION_LAUNCHER_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace runtime {
+// The breakdown of the step time when the communication overlaps with the computation, the time unit is millisecond.
+struct StepTimeBreakdown {
+  double step_time_{0};
+  // The total time of launching the communication kernels in the communication thread.
+  double communication_time_{0};
+  // The communication time hidden by the computation, i.e. while at least one computation kernel is running.
+  double overlapped_communication_time_{0};
+  // The communication time when no computation kernel is running.
+  double exposed_communication_time_{0};
+};
+
+// CommunicationLauncher launches the communication kernels in a dedicated thread in the pushing order, which is the
+// same on all the ranks, so that the actor threads go on the computation while the communication is running.
+class CommunicationLauncher {
+ public:
+  static CommunicationLauncher &GetInstance();
+
+  // Push the launch task which is run in the communication thread, the thread is created at the first pushing.
+  void Push(std::function<void()> &&task);
+
+  // Run the remaining tasks and join the communication thread.
+  void Finalize();
+
+  // Record the step time breakdown between the step beginning and the step ending. The overloads with the time are
+  // used to record the given time instead of the current time, the time unit is second.
+  void StepBegin();
+  void StepBegin(double begin_time);
+  StepTimeBreakdown StepEnd();
+  StepTimeBreakdown StepEnd(double end_time);
+  // Record the interval of launching a computation kernel, the time unit is second.
+  void RecordComputation(double begin_time, double end_time);
+  // Record the interval of launching a communication kernel, the time unit is second.
+  void RecordCommunication(double begin_time, double end_time);
+
+ private:
+  CommunicationLauncher() = default;
+  ~CommunicationLauncher();
+  DISABLE_COPY_AND_ASSIGN(CommunicationLauncher);
+
+  // The loop of the communication thread.
+  void Run();
+
+  std::thread thread_;
+  std::mutex task_mutex_;
+  std::condition_variable task_cond_var_;
+  std::queue<std::function<void()>> tasks_;
+  bool stopped_{false};
+
+  // The beginning and the end time of the kernels in the current step, the time unit is second.
+  std::mutex interval_mutex_;
+  std::vector<std::pair<double, double>> communication_intervals_;
+  std::vector<std::pair<double, double>> computation_intervals_;
+  double step_begin_time_{0};
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_COMMUNICATION_LAUNCHER_H_
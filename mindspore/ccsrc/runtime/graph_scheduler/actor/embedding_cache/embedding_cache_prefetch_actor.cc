@@ -620,21 +620,39 @@ bool EmbeddingCachePrefetchActor::PushEmbeddingsToRemote(int32_t param_key, cons
     PartitionIdsAndEmbeddings(ids, ids_num, embeddings, embeddings_len, &slice_ids_list, &slice_embeddings_list),
     "Partition ids and embeddings failed.");
 
+  // 2. Send embeddings to all the remotes synchronously in parallel, so that the sends to different remotes are in
+  // flight together, and all of them are done before pulling the missing embeddings.
   size_t embedding_dim = (embeddings_len / ids_num) / sizeof(float);
+  std::vector<uint8_t> send_success(server_num_, 1);
+  std::vector<std::thread> send_threads;
   for (size_t i = 0; i < server_num_; i++) {
-    auto &slice_ids = slice_ids_list[i];
-    if (slice_ids.empty()) {
+    if (slice_ids_list[i].empty()) {
       continue;
     }
-
-    // 2. Send embeddings to remote.
-    auto &slice_embeddings = slice_embeddings_list[i];
-    RETURN_IF_FALSE_WITH_LOG(
-      SendToRemote(distributed::kUpdateEmbeddingCache, param_key, i, embedding_dim, slice_ids.data(),
-                   slice_ids.size() * sizeof(int), slice_embeddings.data(), slice_embeddings.size() * sizeof(float)),
-      "Send ids and embeddings to server failed.");
+    (void)send_threads.emplace_back([this, &slice_ids_list, &slice_embeddings_list, &send_success, param_key,
+                                     embedding_dim, i]() {
+      const auto &slice_ids = slice_ids_list[i];
+      const auto &slice_embeddings = slice_embeddings_list[i];
+      try {
+        send_success[i] = SendToRemote(distributed::kUpdateEmbeddingCache, param_key, i, embedding_dim,
+                                       slice_ids.data(), slice_ids.size() * sizeof(int), slice_embeddings.data(),
+                                       slice_embeddings.size() * sizeof(float));
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << "Send ids and embeddings to server " << i << " failed: " << e.what();
+        send_success[i] = 0;
+      }
+    });
+  }
+  for (auto &send_thread : send_threads) {
+    send_thread.join();
   }
 
+  for (size_t i = 0; i < server_num_; i++) {
+    if (send_success[i] == 0) {
+      MS_LOG(ERROR) << "Send ids and embeddings to server " << i << " failed.";
+      return false;
+    }
+  }
   return true;
 }
 
@@ -664,24 +682,37 @@ void EmbeddingCachePrefetchActor::GetRemoteEmbeddingSliceBound() {
   }
 }
 
+size_t EmbeddingCachePrefetchActor::GetRemoteServerIndex(int id) const {
+  if (id < 0) {
+    return server_num_;
+  }
+  // The slice bounds are in ascending order, find the first slice whose end is not less than the id.
+  auto iter = std::lower_bound(
+    remote_embedding_slice_bounds_.begin(), remote_embedding_slice_bounds_.end(), IntToSize(id),
+    [](const std::pair<size_t, size_t> &bound, size_t value) { return bound.second < value; });
+  if (iter == remote_embedding_slice_bounds_.end() || IntToSize(id) < iter->first) {
+    return server_num_;
+  }
+  return LongToSize(std::distance(remote_embedding_slice_bounds_.begin(), iter));
+}
+
 bool EmbeddingCachePrefetchActor::PartitionIds(const int *ids, size_t ids_num,
                                                std::vector<std::vector<int>> *slice_ids_list) {
   MS_ERROR_IF_NULL(ids);
   MS_ERROR_IF_NULL(slice_ids_list);
 
-  for (size_t i = 0; i < slice_ids_list->size(); i++) {
-    int begin = SizeToInt(remote_embedding_slice_bounds_[i].first);
-    int end = SizeToInt(remote_embedding_slice_bounds_[i].second);
-
-    mindspore::HashSet<int> unique_ids;
-    (void)std::for_each(ids, ids + ids_num, [&](int id) {
-      if (id >= begin && id <= end) {
-        (void)unique_ids.insert(id);
-      }
-    });
-
-    std::vector<int> &slice_ids = slice_ids_list->at(i);
-    (void)std::for_each(unique_ids.begin(), unique_ids.end(), [&](int id) { slice_ids.push_back(id); });
+  // Deduplicate the ids and coalesce them by the remote in one pass, so each unique id is sent only once.
+  mindspore::HashSet<int> unique_ids;
+  unique_ids.reserve(ids_num);
+  for (size_t i = 0; i < ids_num; i++) {
+    int id = ids[i];
+    if (!unique_ids.insert(id).second) {
+      continue;
+    }
+    size_t server_index = GetRemoteServerIndex(id);
+    if (server_index < slice_ids_list->size()) {
+      (void)slice_ids_list->at(server_index).emplace_back(id);
+    }
   }
 
   return true;
@@ -703,21 +734,17 @@ bool EmbeddingCachePrefetchActor::PartitionIdsAndEmbeddings(const int *ids, size
 
   size_t embedding_dim = (embeddings_len / ids_num) / sizeof(float);
   size_t partition_num = slice_ids_list->size();
-  for (size_t i = 0; i < partition_num; i++) {
-    int begin = SizeToInt(remote_embedding_slice_bounds_[i].first);
-    int end = SizeToInt(remote_embedding_slice_bounds_[i].second);
-
-    std::vector<int> &slice_ids = slice_ids_list->at(i);
-    std::vector<float> &slice_embeddings = slice_embeddings_list->at(i);
-    // Ids range offset for multi server.
-    int offset = SizeToInt(remote_embedding_slice_bounds_.at(i).first);
-    for (size_t j = 0; j < ids_num; j++) {
-      if (ids[j] >= begin && ids[j] <= end) {
-        slice_ids.push_back(ids[j] - offset);
-        (void)slice_embeddings.insert(slice_embeddings.end(), embeddings + (j * embedding_dim),
-                                      embeddings + (j * embedding_dim) + embedding_dim);
-      }
+  for (size_t j = 0; j < ids_num; j++) {
+    size_t server_index = GetRemoteServerIndex(ids[j]);
+    if (server_index >= partition_num) {
+      continue;
     }
+    // Ids range offset for multi server.
+    int offset = SizeToInt(remote_embedding_slice_bounds_.at(server_index).first);
+    (void)slice_ids_list->at(server_index).emplace_back(ids[j] - offset);
+    std::vector<float> &slice_embeddings = slice_embeddings_list->at(server_index);
+    (void)slice_embeddings.insert(slice_embeddings.end(), embeddings + (j * embedding_dim),
+                                  embeddings + (j * embedding_dim) + embedding_dim);
   }
   return true;
 }
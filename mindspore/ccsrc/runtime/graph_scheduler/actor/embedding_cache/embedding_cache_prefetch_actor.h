@@ -143,6 +143,8 @@ class EmbeddingCachePrefetchActor : public ActorBase {
 
   // Get the id range of each server's embedding table slice.
   void GetRemoteEmbeddingSliceBound();
+  // Get the index of the server whose embedding table slice contains the id, return server_num_ if there is not.
+  size_t GetRemoteServerIndex(int id) const;
 
   // In a multi-server scenario, the embeddings need to be segmented, and each server saves the embeddings of
   // different feature id ranges. Therefore, when the local side performs the push or pull embeddings operation, the
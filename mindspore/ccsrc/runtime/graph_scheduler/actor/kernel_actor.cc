@@ -19,11 +19,14 @@
 #include "runtime/graph_scheduler/actor/output_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
 #include "runtime/graph_scheduler/actor/debug_actor.h"
+#include "runtime/graph_scheduler/actor/communication_launcher.h"
+#include "runtime/graph_scheduler/actor/pipeline_bubble_recorder.h"
 #include "mindrt/include/async/async.h"
 #include "utils/log_adapter.h"
 #include "distributed/recovery/recovery_context.h"
 #include "distributed/collective/collective_manager.h"
 #include "kernel/common_utils.h"
+#include "utils/profile.h"
 
 namespace mindspore {
 namespace runtime {
@@ -55,6 +58,9 @@ void KernelActor::Init() {
   if (is_dynamic_shape_ && IsSomasEnable(somas_info_)) {
     MS_LOG(EXCEPTION) << "Not support the somas for the dynamic shape: " << GetAID().Name();
   }
+  // The communication kernels wait for the other pipeline stages, so they are not recorded as the computation.
+  is_pipeline_bubble_recorded_ = EnablePipelineBubbleRecord() && !common::AnfAlgo::IsCommunicationOp(kernel_);
+  is_overlap_computation_recorded_ = EnableCommunicationOverlap() && !common::AnfAlgo::IsCommunicationOp(kernel_);
 
   // Init the device tensors and kernel launch info.
   InitInputInfo();
@@ -390,12 +396,25 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
       // especially the collective communication operators.
       MS_LOG(WARNING) << "Collective communication need reinitialize, skip launch kernel: "
                       << kernel_->fullname_with_scope();
+    } else if (is_communication_async_ && !IsSkippedLaunch(kernel_, nullptr)) {
+      // The actor goes on in OnCommunicationFinish after the communication thread finishes launching.
+      LaunchCommunicationAsync(context);
+      return;
     } else if (!IsSkippedLaunch(kernel_, nullptr)) {
+      bool is_launch_time_recorded = is_pipeline_bubble_recorded_ || is_overlap_computation_recorded_;
+      double launch_begin_time = is_launch_time_recorded ? GetTime() : 0;
       auto ret = LaunchKernel(context);
       if (!ret) {
         std::string error_info = "#umsg#Kernel error:#umsg#Launch kernel failed: " + kernel_->fullname_with_scope();
         SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context), error_info);
       }
+      double launch_end_time = is_launch_time_recorded ? GetTime() : 0;
+      if (is_overlap_computation_recorded_) {
+        CommunicationLauncher::GetInstance().RecordComputation(launch_begin_time, launch_end_time);
+      }
+      if (is_pipeline_bubble_recorded_) {
+        PipelineBubbleRecorder::GetInstance().RecordComputation(launch_begin_time, launch_end_time);
+      }
     }
   } catch (const std::exception &e) {
     if (strategy_ == GraphExecutionStrategy::kPipeline) {
@@ -414,6 +433,39 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   PostLaunchKernel(context);
 }
 
+void KernelActor::LaunchCommunicationAsync(OpContext<DeviceTensor> *const context) {
+  running_dependent_msg_num_ = 1;
+  CommunicationLauncher::GetInstance().Push([this, context]() {
+    bool launch_success = false;
+    double launch_begin_time = GetTime();
+    try {
+      launch_success = LaunchKernel(context);
+    } catch (const std::exception &e) {
+      MsException::Instance().SetException();
+      MS_LOG(ERROR) << "Launch communication kernel exception: " << kernel_->fullname_with_scope();
+    }
+    // Record before the actor goes on, otherwise the step may end before the interval is recorded.
+    CommunicationLauncher::GetInstance().RecordCommunication(launch_begin_time, GetTime());
+    ActorDispatcher::Send(GetAID(), &KernelActor::OnCommunicationFinish, context, launch_success);
+  });
+}
+
+void KernelActor::OnCommunicationFinish(OpContext<DeviceTensor> *const context, bool launch_success) {
+  MS_EXCEPTION_IF_NULL(context);
+  if (!launch_success) {
+    std::string error_info = "#umsg#Kernel error:#umsg#Launch kernel failed: " + kernel_->fullname_with_scope();
+    SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+  }
+
+  // Debug actor is blocked, must wait debug actor callback message to process continue.
+  if (debug_aid_ != nullptr) {
+    SendDebugReq(context);
+    return;
+  }
+
+  PostLaunchKernel(context);
+}
+
 void KernelActor::SendDebugReq(OpContext<DeviceTensor> *const context) {
   running_dependent_msg_num_ = 1;
   ActorDispatcher::SendSync(*debug_aid_, &DebugActor::Debug, kernel_, &launch_info_, device_contexts_[0], context,
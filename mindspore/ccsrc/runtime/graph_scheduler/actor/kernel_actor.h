@@ -70,6 +70,9 @@ class KernelActor : public DebugAwareActor {
         modifiable_ref_output_indexes_(modifiable_ref_output_indexes),
         is_launch_skipped_(false),
         inputs_continuous_memory_(false),
+        is_communication_async_(false),
+        is_pipeline_bubble_recorded_(false),
+        is_overlap_computation_recorded_(false),
         somas_info_(nullptr) {
     (void)device_contexts_.emplace_back(device_context);
   }
@@ -92,6 +95,7 @@ class KernelActor : public DebugAwareActor {
   bool is_dynamic_shape() const { return is_dynamic_shape_; }
   bool is_launch_skipped() const { return is_launch_skipped_; }
   bool inputs_continuous_memory() const { return inputs_continuous_memory_; }
+  bool is_communication_async() const { return is_communication_async_; }
   SomasInfo *somas_info() const { return somas_info_; }
 
  protected:
@@ -154,6 +158,9 @@ class KernelActor : public DebugAwareActor {
   void PreLaunchKernel(OpContext<DeviceTensor> *const context);
   // The processing after kernel launch: 1.erase input, 2.free memory, 3.send output.
   void PostLaunchKernel(OpContext<DeviceTensor> *const context);
+  // Launch the communication kernel in the communication thread, and the callback after launch finished.
+  void LaunchCommunicationAsync(OpContext<DeviceTensor> *const context);
+  void OnCommunicationFinish(OpContext<DeviceTensor> *const context, bool launch_success);
   // Back refresh the dynamic device tensor stores that have been triggered copy.
   void RefreshDeviceTensorCopyStore(OpContext<DeviceTensor> *const context);
 
@@ -179,6 +186,15 @@ class KernelActor : public DebugAwareActor {
   // Whether the inputs need continuous memory, used to check the inputs legitimacy.
   bool inputs_continuous_memory_;
 
+  // Whether the communication kernel is launched in the communication thread to overlap with the computation.
+  bool is_communication_async_;
+
+  // Whether record the launch interval of the computation kernel to get the idle time of the pipeline stage.
+  bool is_pipeline_bubble_recorded_;
+
+  // Whether record the launch interval of the computation kernel to get the communication time overlapped with it.
+  bool is_overlap_computation_recorded_;
+
   // The information used for integration of dynamic and static memory.
   SomasInfo *somas_info_;
 };
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/pipeline_bubble_recorder.h"
+#include <algorithm>
+#include "utils/log_adapter.h"
+#include "utils/profile.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr double kSecondsToMilliseconds = 1000;
+}  // namespace
+
+PipelineBubbleRecorder &PipelineBubbleRecorder::GetInstance() {
+  static PipelineBubbleRecorder instance;
+  return instance;
+}
+
+void PipelineBubbleRecorder::StepBegin() { StepBegin(GetTime()); }
+
+void PipelineBubbleRecorder::StepBegin(double begin_time) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  computation_intervals_.clear();
+  step_begin_time_ = begin_time;
+}
+
+StageIdleTime PipelineBubbleRecorder::StepEnd() { return StepEnd(GetTime()); }
+
+StageIdleTime PipelineBubbleRecorder::StepEnd(double step_end_time) {
+  StageIdleTime idle_time;
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_time.step_time_ = (step_end_time - step_begin_time_) * kSecondsToMilliseconds;
+  // The computation kernels run in several actor threads, so merge the overlapped intervals.
+  std::sort(computation_intervals_.begin(), computation_intervals_.end());
+  double busy_end_time = step_begin_time_;
+  for (const auto &interval : computation_intervals_) {
+    double begin_time = std::max(interval.first, busy_end_time);
+    double end_time = std::min(interval.second, step_end_time);
+    if (end_time > begin_time) {
+      idle_time.busy_time_ += (end_time - begin_time) * kSecondsToMilliseconds;
+      busy_end_time = end_time;
+    }
+  }
+  idle_time.idle_time_ = std::max(idle_time.step_time_ - idle_time.busy_time_, 0.0);
+  if (idle_time.step_time_ > 0) {
+    idle_time.bubble_fraction_ = idle_time.idle_time_ / idle_time.step_time_;
+  }
+  ++step_num_;
+  total_bubble_fraction_ += idle_time.bubble_fraction_;
+  MS_LOG(INFO) << "The pipeline stage step time: " << idle_time.step_time_ << "ms, busy time: " << idle_time.busy_time_
+               << "ms of " << computation_intervals_.size() << " computation kernels, idle time: "
+               << idle_time.idle_time_ << "ms, bubble fraction: " << idle_time.bubble_fraction_
+               << ", average bubble fraction of " << step_num_ << " steps: " << total_bubble_fraction_ / step_num_;
+  return idle_time;
+}
+
+void PipelineBubbleRecorder::RecordComputation(double begin_time, double end_time) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  (void)computation_intervals_.emplace_back(begin_time, end_time);
+}
+
+double PipelineBubbleRecorder::average_bubble_fraction() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return step_num_ == 0 ? 0 : total_bubble_fraction_ / step_num_;
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_PIPELINE_BUBBLE_RECORDER_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_PIPELINE_BUBBLE_RECORDER_H_
+
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace runtime {
+// The idle time of the pipeline stage in a step, the time unit is millisecond.
+struct StageIdleTime {
+  double step_time_{0};
+  // The time when at least one computation kernel is running.
+  double busy_time_{0};
+  // The time when the stage waits for the other stages, e.g. in the receive kernels.
+  double idle_time_{0};
+  // The idle time divided by the step time.
+  double bubble_fraction_{0};
+};
+
+// PipelineBubbleRecorder records the launch intervals of the computation kernels of the pipeline stage in each step,
+// and the time when no computation kernel is running is the pipeline bubble of the stage.
+class PipelineBubbleRecorder {
+ public:
+  static PipelineBubbleRecorder &GetInstance();
+
+  // The overloads with the time are used to record the given time instead of the current time, the time unit is
+  // second.
+  void StepBegin();
+  void StepBegin(double begin_time);
+  StageIdleTime StepEnd();
+  StageIdleTime StepEnd(double step_end_time);
+  // Record the interval of launching a computation kernel, the time unit is second.
+  void RecordComputation(double begin_time, double end_time);
+
+  // The average bubble fraction of the recorded steps.
+  double average_bubble_fraction() const;
+
+ private:
+  PipelineBubbleRecorder() = default;
+  ~PipelineBubbleRecorder() = default;
+  DISABLE_COPY_AND_ASSIGN(PipelineBubbleRecorder);
+
+  mutable std::mutex mutex_;
+  std::vector<std::pair<double, double>> computation_intervals_;
+  double step_begin_time_{0};
+  size_t step_num_{0};
+  double total_bubble_fraction_{0};
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_PIPELINE_BUBBLE_RECORDER_H_
@@ -60,6 +60,9 @@ class MuxRecvActor : public RecvActor {
   // Parse finalize command message from received message.
   void ParseFinalizeReqData(size_t data_len, const MessageBase *const msg, bool *need_finalize) override;
 
+  // The messages from multiple peers may arrive at the same time, so they can't be received into the same inputs.
+  bool ReceiveInPlace(size_t, std::vector<distributed::MemSegment> *) override { return false; }
+
   // Record the from actor aid when receive a message;
   AID from_actor_aid_;
 
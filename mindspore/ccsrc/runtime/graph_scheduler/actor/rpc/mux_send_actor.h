@@ -52,6 +52,10 @@ class MuxSendActor : public SendActor {
   // MuxRecvActor to response request.
   bool LaunchKernel(OpContext<DeviceTensor> *const context) override;
 
+  // The responses are parsed by the embedding cache which only knows the protobuf dynamic shape format, so they are
+  // serialized into the workspace as before.
+  bool IsZeroCopyEnabled() const override { return false; }
+
   // MuxSendActor and MuxRecvActor of the server are used in pairs, and the MuxSendActor
   // needs to obtain the information(ip and port) of peer from the corresponding MuxRecvActor.
   MuxRecvActorPtr mux_recv_actor_;
@@ -92,6 +92,9 @@ bool RecvActor::StartServer() {
     if (!server_->Initialize(allocate_callback)) {
       MS_LOG(EXCEPTION) << "Failed to initialize rpc server for recv actor";
     }
+    static_cast<TCPServer *>(server_.get())
+      ->SetScatterCallback(
+        std::bind(&RecvActor::ReceiveInPlace, this, std::placeholders::_1, std::placeholders::_2));
   }
 #else
   server_ = std::make_unique<TCPServer>();
@@ -102,6 +105,8 @@ bool RecvActor::StartServer() {
   if (!server_->Initialize(allocate_callback)) {
     MS_LOG(EXCEPTION) << "Failed to initialize rpc server for recv actor";
   }
+  static_cast<TCPServer *>(server_.get())
+    ->SetScatterCallback(std::bind(&RecvActor::ReceiveInPlace, this, std::placeholders::_1, std::placeholders::_2));
 #endif
 
   // Step 2: Set the message handler of the server.
@@ -161,6 +166,7 @@ void RecvActor::RunOpInterProcessData(MessageBase *const msg, OpContext<DeviceTe
 
   // We set remote data by the interface of the rpc kernel, because currently there's no remote input for a kernel mod.
   recv_kernel_mod->SetRemoteInput(msg);
+  recv_kernel_mod->set_remote_input_in_place(dynamic_cast<distributed::ScatterMessage *>(msg) != nullptr);
   if (common::GetEnv(kEnableRDMA) == "1") {
     rdma_buf_ = msg->data;
   }
@@ -204,8 +210,8 @@ void RecvActor::EraseInput(const OpContext<DeviceTensor> *context) {
   if (input_op_inter_process_.count(context->sequential_num_) != 0) {
     (void)input_op_inter_process_.erase(context->sequential_num_);
   }
-  // Release data allocated by AllocateMessage.
-  if (recv_data_ != nullptr) {
+  // Release data allocated by AllocateMessage, which is not allocated if the message is received in place.
+  if (recv_data_ != nullptr && recv_data_->GetPtr() != nullptr) {
     device_contexts_[0]->device_res_manager_->FreeMemory(recv_data_.get());
   }
 
@@ -236,6 +242,31 @@ void RecvActor::Run(OpContext<DeviceTensor> *const context) {
   KernelActor::Run(context);
 }
 
+bool RecvActor::LaunchKernel(OpContext<DeviceTensor> *const context) {
+  if (!KernelActor::LaunchKernel(context)) {
+    return false;
+  }
+
+  // The inputs of RpcRecv are in device tensor store and keep the same memory, unless the shape is dynamic or they
+  // are copied to another device.
+  std::vector<distributed::MemSegment> segments;
+  for (size_t i = 0; i < launch_info_.inputs_.size() && !is_dynamic_shape_; ++i) {
+    const auto &input = launch_info_.inputs_[i];
+    const auto &device_tensor = input_device_tensors_[i];
+    if (input == nullptr || device_tensor == nullptr || input->addr != device_tensor->GetMutablePtr() ||
+        device_tensor->original_ref_count() != SIZE_MAX || device_tensor->dynamic_ref_count() != INT32_MAX) {
+      segments.clear();
+      break;
+    }
+    if (input->size != 0) {
+      (void)segments.emplace_back(input->addr, input->size);
+    }
+  }
+  std::unique_lock<std::mutex> lock(context_mtx_);
+  in_place_segments_.swap(segments);
+  return true;
+}
+
 void *RecvActor::AllocateMessage(size_t size) {
   // Block this method until the context is valid.
   std::unique_lock<std::mutex> lock(context_mtx_);
@@ -245,6 +276,38 @@ void *RecvActor::AllocateMessage(size_t size) {
   return AllocateMemByDeviceRes(size);
 }
 
+bool RecvActor::ReceiveInPlace(size_t size, std::vector<distributed::MemSegment> *segments) {
+  MS_ERROR_IF_NULL_W_RET_VAL(segments, false);
+  // Block this method until the context is valid, the inputs are not used by the last step since then.
+  std::unique_lock<std::mutex> lock(context_mtx_);
+  context_cv_.wait(lock, [this] { return is_context_valid_ || is_exception_thrown_; });
+  if (is_exception_thrown_) {
+    return false;
+  }
+
+  // The messages of multiple inter-process inputs can't be received into the same inputs.
+  if (input_inter_process_num_ != 1) {
+    return false;
+  }
+
+  // Like RpcRecv kernel, the inputs not sent from remote at the end are skipped, e.g., the 'umonad' inputs.
+  size_t total_size = 0;
+  segments->clear();
+  for (const auto &segment : in_place_segments_) {
+    if (total_size == size) {
+      break;
+    }
+    (void)segments->emplace_back(segment);
+    total_size += segment.second;
+  }
+  if (total_size != size || segments->empty()) {
+    segments->clear();
+    return false;
+  }
+  MS_LOG(DEBUG) << "Receive the message of size " << size << " in place for " << GetAID();
+  return true;
+}
+
 void *RecvActor::AllocateMemByDeviceRes(size_t size) {
   // Only need to create recv_data_ once.
   // The real data is allocated and freed multiple times as recv_data_->ptr_.
@@ -327,32 +390,57 @@ size_t RecvActor::ParseDynamicShapeData(const RpcDataPtr &dynamic_shape_data, si
   // So traverse each input and parse the dynamic shape data.
   size_t offset = 0;
   for (size_t i = 0; i < count; i++) {
-    if (data_to_be_parsed >= dynamic_shape_data + data_size) {
+    if (data_to_be_parsed + strlen(kRpcDynamicShapeData) > dynamic_shape_data + data_size) {
       MS_LOG(EXCEPTION) << "The dynamic shape data size is invalid.";
     }
+    size_t remaining_size = data_size - LongToSize(data_to_be_parsed - dynamic_shape_data);
     // Step 1: parse the magic header which indicates the dynamic shape.
     std::string dynamic_shape_magic_header(data_to_be_parsed, strlen(kRpcDynamicShapeData));
-    if (dynamic_shape_magic_header != kRpcDynamicShapeData) {
-      MS_LOG(EXCEPTION) << "The dynamie shape data must have the magic header RPC_DYNAMIC_SHAPE_DATA. But got "
-                        << dynamic_shape_magic_header;
+    ShapeVector shapes;
+    TypeId data_type;
+    size_t header_size = 0;
+    if (dynamic_shape_magic_header == kernel::kRpcDynamicShapeFixedData) {
+      // Step 2: parse the fixed layout meta info and the shape vector in place.
+      data_to_be_parsed += strlen(kernel::kRpcDynamicShapeFixedData);
+      kernel::RpcDynamicShapeMeta meta;
+      MS_EXCEPTION_IF_CHECK_FAIL(memcpy_s(&meta, sizeof(meta), data_to_be_parsed, sizeof(meta)) == EOK,
+                                 "memcpy_s dynamic shape meta info failed.");
+      header_size = kernel::GetRpcDynamicShapeHeaderSize(meta.dim_num);
+      if (header_size > remaining_size) {
+        MS_LOG(EXCEPTION) << "The dim number " << meta.dim_num << " of the dynamic shape data is invalid.";
+      }
+      data_to_be_parsed += sizeof(meta);
+      shapes.resize(meta.dim_num);
+      if (meta.dim_num != 0) {
+        MS_EXCEPTION_IF_CHECK_FAIL(memcpy_s(shapes.data(), shapes.size() * sizeof(int64_t), data_to_be_parsed,
+                                            shapes.size() * sizeof(int64_t)) == EOK,
+                                   "memcpy_s dynamic shape vector failed.");
+      }
+      data_to_be_parsed += shapes.size() * sizeof(int64_t);
+      data_type = static_cast<TypeId>(meta.type_id);
+    } else if (dynamic_shape_magic_header == kRpcDynamicShapeData) {
+      // Step 2: parse the size of serialized protobuf message.
+      data_to_be_parsed += strlen(kRpcDynamicShapeData);
+      size_t pb_msg_size = 0;
+      MS_EXCEPTION_IF_CHECK_FAIL(
+        memcpy_s(&pb_msg_size, sizeof(pb_msg_size), data_to_be_parsed, sizeof(size_t)) == EOK,
+        "memcpy_s protobuf message size failed.");
+
+      // Step 3: deserialize the protobuf message.
+      data_to_be_parsed += sizeof(pb_msg_size);
+      rpc::DynamicShapeMessage pb_msg;
+      (void)pb_msg.ParseFromArray(data_to_be_parsed, SizeToInt(pb_msg_size));
+
+      // Step 4: parse the data shape and
+      shapes.assign(pb_msg.shape_vector().begin(), pb_msg.shape_vector().end());
+      data_type = static_cast<TypeId>(pb_msg.type_id());
+      data_to_be_parsed += pb_msg_size;
+      header_size = strlen(kRpcDynamicShapeData) + sizeof(pb_msg_size) + pb_msg_size;
+    } else {
+      MS_LOG(EXCEPTION) << "The dynamie shape data must have the magic header RPC_DYNAMIC_SHAPE_DATA or "
+                        << "RPC_DYNAMIC_SHAPE_FIXD. But got " << dynamic_shape_magic_header;
     }
 
-    // Step 2: parse the size of serialized protobuf message.
-    data_to_be_parsed += strlen(kRpcDynamicShapeData);
-    size_t pb_msg_size = 0;
-    MS_EXCEPTION_IF_CHECK_FAIL(memcpy_s(&pb_msg_size, sizeof(pb_msg_size), data_to_be_parsed, sizeof(size_t)) == EOK,
-                               "memcpy_s protobuf message size failed.");
-
-    // Step 3: deserialize the protobuf message.
-    data_to_be_parsed += sizeof(pb_msg_size);
-    rpc::DynamicShapeMessage pb_msg;
-    (void)pb_msg.ParseFromArray(data_to_be_parsed, SizeToInt(pb_msg_size));
-
-    // Step 4: parse the data shape and
-    ShapeVector shapes(pb_msg.shape_vector().begin(), pb_msg.shape_vector().end());
-    TypeId data_type = static_cast<TypeId>(pb_msg.type_id());
-    data_to_be_parsed += pb_msg_size;
-
     // Step 5: get the size of real data as recv's input.
     int64_t real_data_size = 1;
     if (!kernel::GetShapeSize(shapes, TypeIdToType(data_type), &real_data_size)) {
@@ -363,7 +451,7 @@ size_t RecvActor::ParseDynamicShapeData(const RpcDataPtr &dynamic_shape_data, si
     // Step 6: update the abstract.
     AddArgSpecForInput(args_spec_list, shapes, data_type, i);
 
-    offset += strlen(kRpcDynamicShapeData) + sizeof(pb_msg_size) + pb_msg_size;
+    offset += header_size;
     real_data_offsets.push_back(offset);
     offset += LongToSize(real_data_size);
   }
@@ -377,6 +465,10 @@ size_t RecvActor::ParseDynamicShapeData(const RpcDataPtr &dynamic_shape_data, si
 void RecvActor::PreprocessRemoteInput(const MessageBase *const msg, bool *need_finalize) {
   MS_EXCEPTION_IF_NULL(msg);
   MS_EXCEPTION_IF_NULL(need_finalize);
+  if (dynamic_cast<const distributed::ScatterMessage *>(msg) != nullptr) {
+    MS_LOG(DEBUG) << "The data is received in place, which is not dynamic shape. No need to preprocess.";
+    return;
+  }
 
   // Parse the void * data.
   size_t data_size = msg->size;
@@ -388,7 +480,7 @@ void RecvActor::PreprocessRemoteInput(const MessageBase *const msg, bool *need_f
     MS_LOG(DEBUG) << "This is not a dynamic shape data. No need to preprocess.";
     return;
   }
-  if (msg_magic_header != kRpcDynamicShapeData) {
+  if (msg_magic_header != kRpcDynamicShapeData && msg_magic_header != kernel::kRpcDynamicShapeFixedData) {
     MS_LOG(DEBUG) << "This is not a dynamic shape data. No need to preprocess.";
     return;
   }
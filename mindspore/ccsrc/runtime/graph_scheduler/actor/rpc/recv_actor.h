@@ -83,6 +83,9 @@ class RecvActor : public RpcActor {
   // Run method.
   void Run(OpContext<DeviceTensor> *const context) override;
 
+  // Record the memory of the inputs after launching, which the next message could be received into.
+  bool LaunchKernel(OpContext<DeviceTensor> *const context) override;
+
   // Set the message handler of the server.
   virtual void SetMessageHandler();
 
@@ -103,6 +106,16 @@ class RecvActor : public RpcActor {
    */
   void *AllocateMemByDeviceRes(size_t size);
 
+  /**
+   * @description: The callback set to tcp server to receive the message into the memory of the inputs directly, so
+   * RpcRecv kernel needs no copying. It's only possible for the static shape inputs in device tensor store, whose
+   * memory is recorded after the first launch and is the same afterwards.
+   * @param {size_t} size: The message size.
+   * @param {std::vector<MemSegment>} *segments: The memory of the inputs the message is received into.
+   * @return {bool}: Whether the message size matches the inputs and could be received in place.
+   */
+  virtual bool ReceiveInPlace(size_t size, std::vector<distributed::MemSegment> *segments);
+
   std::unique_ptr<RPCServerBase> server_;
 
   // The variables used to ensure thread-safe of op context visited by recv actor.
@@ -114,6 +127,9 @@ class RecvActor : public RpcActor {
   // It will be used for copying the buffer from the kernel function.
   std::shared_ptr<CPUDeviceAddress> recv_data_;
 
+  // The memory of the inputs recorded by LaunchKernel for ReceiveInPlace, which is guarded by context_mtx_.
+  std::vector<distributed::MemSegment> in_place_segments_;
+
  private:
   // Create abstract and add to the abstract list.
   void AddArgSpecForInput(AbstractBasePtrList *args_spec_list, const ShapeVector &shapes, TypeId data_type,
@@ -122,6 +138,9 @@ class RecvActor : public RpcActor {
   // Parse the protobuf message from the given buffer. The format is as below.
   // |--------22 bytes------|---4 bytes--|PB data size bytes| data size bytes |
   // |RPC_DYNAMIC_SHAPE_DATA|PB data size|      PB data     | real data       |
+  // Or the fixed layout header without protobuf sent by the zero copy SendActor as below.
+  // |--------22 bytes------|-------8 bytes-------|--8 bytes * dim num--| data size bytes |
+  // |RPC_DYNAMIC_SHAPE_FIXD| RpcDynamicShapeMeta |     shape vector     | real data       |
   // Return dynamic shape data length.
   size_t ParseDynamicShapeData(const RpcDataPtr &dynamic_shape_data, size_t data_size,
                                AbstractBasePtrList *args_spec_list, size_t count);
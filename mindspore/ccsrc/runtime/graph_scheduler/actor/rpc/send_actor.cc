@@ -18,6 +18,7 @@
 
 #include <utility>
 #include "runtime/graph_scheduler/actor/memory_manager_actor.h"
+#include "plugin/device/cpu/kernel/rpc/rpc_kernel.h"
 
 namespace mindspore {
 namespace runtime {
@@ -45,9 +46,11 @@ bool SendActor::ConnectServer() {
     client_ = std::make_unique<RDMAClient>();
   } else {
     client_ = std::make_unique<TCPClient>();
+    zero_copy_enabled_ = true;
   }
 #else
   client_ = std::make_unique<TCPClient>();
+  zero_copy_enabled_ = true;
 #endif
   MS_EXCEPTION_IF_NULL(client_);
 
@@ -77,9 +80,8 @@ bool SendActor::ConnectServer() {
 }
 
 void SendActor::FlushData() {
-  if (!client_->Flush(server_url_)) {
-    MS_LOG(EXCEPTION) << "Failed to flush client for server " << server_url_;
-  }
+  // The memory of the messages is freed after they are sent, so flush the messages to all the peers.
+  Flush();
 }
 
 void SendActor::Clear() {
@@ -125,13 +127,29 @@ void SendActor::EraseInput(const OpContext<DeviceTensor> *context) {
   }
 }
 
+void SendActor::SendMemoryFreeReq(OpContext<DeviceTensor> *const context) {
+  if (!launch_zero_copy_) {
+    KernelActor::SendMemoryFreeReq(context);
+  } else {
+    // The inputs are at the front of memory_free_list_, and they are freed in FreeMessage along with the workspace.
+    launch_free_list_.assign(memory_free_list_.begin() + input_device_tensors_.size(), memory_free_list_.end());
+    if (ActorDispatcher::is_memory_free_sync()) {
+      ActorDispatcher::SendSync(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &launch_free_list_,
+                                device_contexts_[0], context, GetAID());
+    } else {
+      ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &launch_free_list_,
+                            device_contexts_[0], context, GetAID());
+    }
+  }
+
+  // All the messages of this launch are built, so release the reference held by the launch.
+  ReleaseInFlightMessage(launch_key_);
+  launch_key_ = nullptr;
+  launch_zero_copy_ = false;
+}
+
 std::unique_ptr<MessageBase> SendActor::BuildRpcMessage(const kernel::AddressPtrList &data_list,
                                                         const std::string &server_url) {
-  std::unique_ptr<MessageBase> message = std::make_unique<MessageBase>();
-  MS_ERROR_IF_NULL_W_RET_VAL(message, nullptr);
-  message->to = AID("", server_url);
-  message->func_id_ = remote_func_id_;
-
   // To reach optimal performance, we use workspace memory as the data sent to the remote. So the size must be
   // strictly checked to avoid illegal memory access.
   auto send_workspace = launch_info_.workspaces_;
@@ -140,22 +158,107 @@ std::unique_ptr<MessageBase> SendActor::BuildRpcMessage(const kernel::AddressPtr
   }
   // Only use one piece of workspace memory to avoid extra memory copying and serialize inputs data to one message.
   auto workspace_addr = send_workspace[kIndex0];
-  if (is_dynamic_shape_) {
-    MS_LOG(INFO) << "This send actor builds message with dynamic shape.";
-    SerializeDynamicShapeMessage(message.get(), data_list, workspace_addr);
+  MS_ERROR_IF_NULL_W_RET_VAL(workspace_addr, nullptr);
+
+  // The first message of this launch is serialized, and the messages to the other peers reuse it.
+  bool first_message = (launch_key_ != workspace_addr->addr);
+  if (first_message) {
+    launch_key_ = workspace_addr->addr;
+    launch_zero_copy_ = CanSendZeroCopy(data_list);
+  }
+
+  std::unique_ptr<MessageBase> message;
+  if (launch_zero_copy_) {
+    auto scatter_message = std::make_unique<distributed::ScatterMessage>();
+    MS_ERROR_IF_NULL_W_RET_VAL(scatter_message, nullptr);
+    if (first_message) {
+      SerializeZeroCopyMessage(scatter_message.get(), data_list, workspace_addr);
+      launch_segments_ = scatter_message->segments;
+      launch_message_size_ = scatter_message->size;
+    } else {
+      scatter_message->segments = launch_segments_;
+    }
+    message = std::move(scatter_message);
   } else {
-    SerializeCommonMessage(message.get(), data_list, workspace_addr);
+    message = std::make_unique<MessageBase>();
+    MS_ERROR_IF_NULL_W_RET_VAL(message, nullptr);
+    if (first_message) {
+      if (is_dynamic_shape_) {
+        MS_LOG(INFO) << "This send actor builds message with dynamic shape.";
+        SerializeDynamicShapeMessage(message.get(), data_list, workspace_addr);
+      } else {
+        SerializeCommonMessage(message.get(), data_list, workspace_addr);
+      }
+      launch_message_size_ = message->size;
+    }
   }
+  message->to = AID("", server_url);
+  message->func_id_ = remote_func_id_;
+  message->data = workspace_addr->addr;
+  message->size = launch_message_size_;
+  HoldInFlightMessage(workspace_addr);
 
-  MS_LOG(DEBUG) << "RpcSend message size is " << message->size;
+  MS_LOG(DEBUG) << "RpcSend message size is " << message->size << ", zero copy: " << launch_zero_copy_;
   return message;
 }
 
 bool SendActor::FreeMessage(void *data) {
-  auto memory_free_list = FindDeviceTensorNeedsFree(data);
+  ReleaseInFlightMessage(data);
+  return true;
+}
+
+bool SendActor::CanSendZeroCopy(const kernel::AddressPtrList &data_list) const {
+  // Each input may take one segment for the dynamic shape header and one for the data.
+  if (!IsZeroCopyEnabled() || data_list.size() != input_device_tensors_.size() ||
+      data_list.size() * kSizeTwo > distributed::kMaxMemSegmentNum) {
+    return false;
+  }
+  for (size_t i = 0; i < data_list.size(); ++i) {
+    const auto &device_tensor = input_device_tensors_[i];
+    if (data_list[i] == nullptr || device_tensor == nullptr || data_list[i]->addr != device_tensor->GetMutablePtr()) {
+      // The input is copied from another device and the copy is freed right after launching.
+      return false;
+    }
+    if (device_tensor->original_ref_count() == SIZE_MAX && device_tensor->dynamic_ref_count() == INT32_MAX) {
+      // The input is not freed by the reference count, like the weights, so it may be written before it's sent.
+      return false;
+    }
+  }
+  return true;
+}
+
+void SendActor::HoldInFlightMessage(const kernel::AddressPtr &workspace_addr) {
+  MS_EXCEPTION_IF_NULL(workspace_addr);
+  std::lock_guard<std::mutex> lock(in_flight_mutex_);
+  auto &in_flight_message = in_flight_messages_[workspace_addr->addr];
+  if (in_flight_message.ref_count == 0) {
+    // The reference of the launch itself.
+    in_flight_message.ref_count = 1;
+    in_flight_message.free_list = FindDeviceTensorNeedsFree(workspace_addr->addr);
+    if (launch_zero_copy_) {
+      (void)in_flight_message.free_list.insert(in_flight_message.free_list.end(), memory_free_list_.begin(),
+                                               memory_free_list_.begin() + input_device_tensors_.size());
+    }
+  }
+  ++in_flight_message.ref_count;
+}
+
+void SendActor::ReleaseInFlightMessage(const void *key) {
+  std::vector<DeviceTensor *> memory_free_list;
+  {
+    std::lock_guard<std::mutex> lock(in_flight_mutex_);
+    auto iter = in_flight_messages_.find(key);
+    if (iter == in_flight_messages_.end()) {
+      return;
+    }
+    if (--iter->second.ref_count > 0) {
+      return;
+    }
+    memory_free_list = std::move(iter->second.free_list);
+    (void)in_flight_messages_.erase(iter);
+  }
   ActorDispatcher::SendSync(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list,
                             device_contexts_[0], context_, GetAID());
-  return true;
 }
 
 void SendActor::Flush() {
@@ -242,11 +345,67 @@ void SendActor::SerializeDynamicShapeMessage(MessageBase *message, const kernel:
     offset += serialized_data_size;
   }
 
-  if (workspace_addr->size != offset) {
-    MS_LOG(EXCEPTION) << "Send void data size is not the same as workspace size.";
+  // The workspace fits both the protobuf and the fixed layout headers, so it may be larger than the data.
+  if (workspace_addr->size < offset) {
+    MS_LOG(EXCEPTION) << "Send void data size " << offset << " is larger than workspace size " << workspace_addr->size;
   }
   message->data = workspace_addr->addr;
-  message->size = workspace_addr->size;
+  message->size = offset;
+}
+
+size_t SendActor::SerializeDynamicShapeHeader(RpcDataPtr rpc_data, const ShapeVector &shape_vec,
+                                              const TypeId &data_type) const {
+  MS_EXCEPTION_IF_NULL(rpc_data);
+  // Part 1. Magic header for the fixed layout dynamic shape.
+  if (!CopyRpcDataWithOffset(&rpc_data, kernel::kRpcDynamicShapeFixedData, strlen(kernel::kRpcDynamicShapeFixedData))) {
+    MS_LOG(EXCEPTION) << "Failed to copy data for kRpcDynamicShapeFixedData.";
+  }
+
+  // Part 2. The data type and the dim number.
+  kernel::RpcDynamicShapeMeta meta{static_cast<int32_t>(data_type), SizeToUint(shape_vec.size())};
+  if (!CopyRpcDataWithOffset(&rpc_data, &meta, sizeof(meta))) {
+    MS_LOG(EXCEPTION) << "Failed to copy data for the meta info of dynamic shape.";
+  }
+
+  // Part 3. The shape vector.
+  if (!shape_vec.empty() && !CopyRpcDataWithOffset(&rpc_data, shape_vec.data(), shape_vec.size() * sizeof(int64_t))) {
+    MS_LOG(EXCEPTION) << "Failed to copy data for the shape vector of dynamic shape.";
+  }
+  return kernel::GetRpcDynamicShapeHeaderSize(shape_vec.size());
+}
+
+void SendActor::SerializeZeroCopyMessage(distributed::ScatterMessage *message, const kernel::AddressPtrList &data_list,
+                                         const kernel::AddressPtr &workspace_addr) const {
+  MS_EXCEPTION_IF_NULL(message);
+  MS_EXCEPTION_IF_NULL(workspace_addr);
+  RpcDataPtr header_data = static_cast<RpcDataPtr>(workspace_addr->addr);
+  MS_EXCEPTION_IF_NULL(header_data);
+  size_t header_offset = 0;
+  size_t total_size = 0;
+  for (size_t i = 0; i < data_list.size(); i++) {
+    MS_EXCEPTION_IF_NULL(data_list[i]);
+    if (is_dynamic_shape_) {
+      auto input_node_with_index = common::AnfAlgo::GetPrevNodeOutput(kernel_, i, false);
+      MS_EXCEPTION_IF_NULL(input_node_with_index.first);
+      auto shapes = trans::GetRuntimePaddingShape(input_node_with_index.first, input_node_with_index.second);
+      TypeId data_type =
+        common::AnfAlgo::GetOutputInferDataType(input_node_with_index.first, input_node_with_index.second);
+      if (header_offset + kernel::GetRpcDynamicShapeHeaderSize(shapes.size()) > workspace_addr->size) {
+        MS_LOG(EXCEPTION) << "The dynamic shape header of rpc send input " << i << " exceeds the workspace size "
+                          << workspace_addr->size;
+      }
+      size_t header_size = SerializeDynamicShapeHeader(header_data + header_offset, shapes, data_type);
+      (void)message->segments.emplace_back(header_data + header_offset, header_size);
+      header_offset += header_size;
+      total_size += header_size;
+    }
+    if (data_list[i]->size != 0) {
+      (void)message->segments.emplace_back(data_list[i]->addr, data_list[i]->size);
+      total_size += data_list[i]->size;
+    }
+  }
+  message->data = workspace_addr->addr;
+  message->size = total_size;
 }
 
 void SendActor::SerializeCommonMessage(MessageBase *message, const kernel::AddressPtrList &data_list,
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_RPC_SEND_ACTOR_H_
 
 #include <set>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <memory>
@@ -36,7 +37,11 @@ class SendActor : public RpcActor {
                  modifiable_ref_input_indexes, modifiable_ref_output_indexes, KernelTransformType::kSendActor),
         client_(nullptr),
         context_(nullptr),
-        server_url_("") {}
+        server_url_(""),
+        zero_copy_enabled_(false),
+        launch_key_(nullptr),
+        launch_zero_copy_(false),
+        launch_message_size_(0) {}
   ~SendActor() override;
 
   // Set send actor's destination peer info, in another word, send actor's output.
@@ -59,6 +64,9 @@ class SendActor : public RpcActor {
   // Erase inter-process inputs for this sequential number.
   void EraseInput(const OpContext<DeviceTensor> *context) override;
 
+  // The inputs sent without copying are not freed until the messages are sent, see FreeMessage.
+  void SendMemoryFreeReq(OpContext<DeviceTensor> *const context) override;
+
   // Client only supports to send MessageBase, so build MessageBase with data and url.
   std::unique_ptr<MessageBase> BuildRpcMessage(const kernel::AddressPtrList &data_list, const std::string &server_url);
 
@@ -76,6 +84,10 @@ class SendActor : public RpcActor {
    */
   virtual void Flush();
 
+  // Whether the inputs could be sent without copying them into the message. The inputs and the fixed layout dynamic
+  // shape headers are sent as the segments of ScatterMessage by the tcp connection in this case.
+  virtual bool IsZeroCopyEnabled() const { return zero_copy_enabled_; }
+
   // The rpc client connection to multiple servers.
   std::unique_ptr<RPCClientBase> client_;
 
@@ -88,6 +100,39 @@ class SendActor : public RpcActor {
    */
   std::vector<DeviceTensor *> FindDeviceTensorNeedsFree(const void *data) const;
 
+  // Whether the inputs of this launch could be sent without copying, which needs the memory of the inputs is not freed
+  // or written until the messages are sent.
+  bool CanSendZeroCopy(const kernel::AddressPtrList &data_list) const;
+
+  // Hold the memory of the messages of this launch until the messages are sent. The launch itself holds one reference
+  // which is released in SendMemoryFreeReq, so the memory isn't freed before all the messages of the launch are built.
+  void HoldInFlightMessage(const kernel::AddressPtr &workspace_addr);
+  // Release one reference of the memory of the messages of the key, which is freed if it's not referenced any more.
+  void ReleaseInFlightMessage(const void *key);
+
+  /**
+   * @description: Serialize the meta info of one dynamic shape input in the fixed layout without protobuf.
+   * The format is shown below:
+   * |--------22 bytes------|-------8 bytes-------|--8 bytes * dim num--|
+   * |RPC_DYNAMIC_SHAPE_FIXD| RpcDynamicShapeMeta |     shape vector     |
+   * @param {RpcDataPtr} &rpc_data: A piece of memory which is allocated by the caller for serialized data to copy to.
+   * @param {ShapeVector} &shape_vec: Input data's shape vector.
+   * @param {TypeId} &data_type: Input data's type.
+   * @return {size_t}: Size of the serialized header.
+   */
+  size_t SerializeDynamicShapeHeader(RpcDataPtr rpc_data, const ShapeVector &shape_vec, const TypeId &data_type) const;
+
+  /**
+   * @description: Build the message whose segments are the inputs themselves, along with the fixed layout header of
+   * each input in the workspace if it's dynamic shape, so no input is copied.
+   * @param {ScatterMessage} *message: ScatterMessage object.
+   * @param {AddressPtrList} &data_list: The inputs data of rpc send kernel.
+   * @param {AddressPtr} &workspace_addr: The workspace which the headers are serialized to.
+   * @return {void}
+   */
+  void SerializeZeroCopyMessage(distributed::ScatterMessage *message, const kernel::AddressPtrList &data_list,
+                                const kernel::AddressPtr &workspace_addr) const;
+
   /**
    * @description: Serialize one dynamic shape input data to a piece of memory and returns the serialized data
    * size for accessing memory by offset.
@@ -141,6 +186,25 @@ class SendActor : public RpcActor {
 
   // The remote function id this client will call.
   uint32_t remote_func_id_;
+
+  // Only the tcp client supports sending ScatterMessage.
+  bool zero_copy_enabled_;
+
+  // The memory of the messages being sent, keyed by the workspace address of the launch.
+  struct InFlightMessage {
+    size_t ref_count{0};
+    std::vector<DeviceTensor *> free_list;
+  };
+  std::mutex in_flight_mutex_;
+  mindspore::HashMap<const void *, InFlightMessage> in_flight_messages_;
+
+  // The messages of the current launch to all the peers share the serialized workspace and the segments. The launch key
+  // is the workspace address, and it's reset in SendMemoryFreeReq.
+  void *launch_key_;
+  bool launch_zero_copy_;
+  size_t launch_message_size_;
+  std::vector<distributed::MemSegment> launch_segments_;
+  std::vector<DeviceTensor *> launch_free_list_;
 };
 
 using SendActorPtr = std::shared_ptr<SendActor>;
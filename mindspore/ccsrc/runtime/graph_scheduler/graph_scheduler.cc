@@ -20,6 +20,8 @@
 #include "runtime/graph_scheduler/actor/memory_manager_actor.h"
 #include "runtime/graph_scheduler/actor/debug_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
+#include "runtime/graph_scheduler/actor/communication_launcher.h"
+#include "runtime/graph_scheduler/actor/pipeline_bubble_recorder.h"
 #include "runtime/graph_scheduler/optimizer/optimizer.h"
 #include "runtime/graph_scheduler/optimizer/memory_actor_insert.h"
 #include "runtime/graph_scheduler/optimizer/invalid_data_arrow_elimination.h"
@@ -346,6 +348,7 @@ void GraphScheduler::Clear() {
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
   actor_manager->Finalize();
+  CommunicationLauncher::GetInstance().Finalize();
 
   // Clear the member of DeviceTensorStore.
   DeviceTensorStore::GetInstance().Clear();
@@ -638,6 +641,13 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<std::vecto
     thread_pool->SetSpinCountMaxValue();
   }
   ActorDispatcher::set_is_multi_thread_execution(actor_set->is_multi_thread_execution_);
+  if (EnableCommunicationOverlap()) {
+    CommunicationLauncher::GetInstance().StepBegin();
+  }
+  bool is_pipeline_bubble_recorded = EnablePipelineBubbleRecord();
+  if (is_pipeline_bubble_recorded) {
+    PipelineBubbleRecorder::GetInstance().StepBegin();
+  }
   double start_time = GetTime();
   ActorDispatcher::Send(actor_set->data_prepare_actor_->GetAID(), &DataPrepareActor::PrepareData, input_tensors,
                         &op_context, GraphExecutionStrategy::kPipeline);
@@ -666,6 +676,12 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<std::vecto
 
   MsException::Instance().CheckException();
   double end_time = GetTime();
+  if (EnableCommunicationOverlap()) {
+    (void)CommunicationLauncher::GetInstance().StepEnd();
+  }
+  if (is_pipeline_bubble_recorded) {
+    (void)PipelineBubbleRecorder::GetInstance().StepEnd();
+  }
   const size_t kSecondsToMilliseconds = 1000;
   SetActorExecutionStrategy(actor_set, strategy, (end_time - start_time) * kSecondsToMilliseconds);
 
@@ -692,6 +708,14 @@ bool GraphScheduler::CheckSingleThreadRunningCondition(ActorSet *const actor_set
     return false;
   }
 
+  // The callbacks of the communication thread are multi-thread.
+  if (std::any_of(actor_set->kernel_actors_.begin(), actor_set->kernel_actors_.end(),
+                  [](const KernelActorPtr &kernel_actor) {
+                    return (kernel_actor != nullptr) && kernel_actor->is_communication_async();
+                  })) {
+    return false;
+  }
+
 #ifdef ENABLE_RPC_ACTOR
   // If there're rpc actors, do not use single thread execution because the callbacks of recv actors are
   // multi-thread.
@@ -2247,6 +2271,20 @@ void GraphScheduler::LinkControlArrowByExecutionOrder(const KernelGraphPtr &grap
 void GraphScheduler::LinkControlArrowByCommunicationNode(const std::vector<CNodePtr> &communication_nodes,
                                                          const std::vector<KernelGraphPtr> &graphs,
                                                          const GraphCompilerInfo &graph_compiler_info) const {
+  // The cpu communication kernels are launched in the communication thread as soon as their inputs are ready in the
+  // overlapped communication mode, such as the gradient buckets become ready during the backward, so they don't need
+  // to wait for all the actors in front of them in the execution order.
+  bool is_communication_overlapped = false;
+  if (EnableCommunicationOverlap() && (!execution_order_running_) &&
+      (graph_compiler_info.strategy_ == GraphExecutionStrategy::kPipeline)) {
+    std::vector<AbstractActor *> communication_actors;
+    for (const auto &communication_node : communication_nodes) {
+      MS_EXCEPTION_IF_NULL(communication_node);
+      (void)communication_actors.emplace_back(FetchActor(communication_node->fullname_with_scope()));
+    }
+    is_communication_overlapped = SchedulerHelper::SetCommunicationAsync(communication_actors);
+  }
+
   const size_t kCommunicationNodesMinNum = 2;
   if (communication_nodes.size() < kCommunicationNodesMinNum) {
     return;
@@ -2263,7 +2301,7 @@ void GraphScheduler::LinkControlArrowByCommunicationNode(const std::vector<CNode
 
   // Ensure all actors execute orderly to optimize the execution performance in the multi device scenario currently.
   // Using the multi stream to optimize the performance in the future.
-  if (!execution_order_running_) {
+  if (!execution_order_running_ && !is_communication_overlapped) {
     for (const auto &graph : graphs) {
       LinkControlArrowByExecutionOrder(graph, graph_compiler_info);
     }
@@ -16,6 +16,7 @@
 #include "runtime/graph_scheduler/mem_swap_scheduler.h"
 
 #include <algorithm>
+#include <fstream>
 #include <map>
 #include <memory>
 #include <string>
@@ -27,12 +28,88 @@
 #include "runtime/device/memory_offload_strategy.h"
 #include "runtime/graph_scheduler/control_node_parser.h"
 #include "include/backend/anf_runtime_algorithm.h"
+#include "utils/file_utils.h"
 
 namespace mindspore {
 namespace runtime {
 constexpr size_t kFirstVirtualNode = 0;
 constexpr size_t kSecondVirtualNodeOffset = 1;
 namespace {
+// The kernel execution time profile used by the swap in prefetch, each line is 'kernel full name,time(us)'. The
+// prefetch is only enabled with the profile, since the cost model needs the measured kernel time.
+constexpr char kSwapKernelProfileEnv[] = "MS_DEV_SWAP_KERNEL_PROFILE";
+// The bandwidth(GB/s) of ddr to hbm and disk to hbm used by the swap in prefetch, in the format of 'ddr,disk'.
+constexpr char kSwapBandwidthEnv[] = "MS_DEV_SWAP_BANDWIDTH";
+// 1GB/s is 1000 bytes/us.
+constexpr float kGBPerSecondToBytesPerMicrosecond = 1000.0f;
+
+void LoadSwapBandwidth(const std::shared_ptr<device::SwapContext> &swap_context) {
+  MS_EXCEPTION_IF_NULL(swap_context);
+  const auto &bandwidth = common::GetEnv(kSwapBandwidthEnv);
+  if (bandwidth.empty()) {
+    return;
+  }
+  const auto pos = bandwidth.find(',');
+  float ddr_bandwidth = 0;
+  float disk_bandwidth = 0;
+  try {
+    if (pos != std::string::npos) {
+      ddr_bandwidth = std::stof(bandwidth.substr(0, pos));
+      disk_bandwidth = std::stof(bandwidth.substr(pos + 1));
+    }
+  } catch (const std::exception &e) {
+    ddr_bandwidth = 0;
+  }
+  if (ddr_bandwidth <= 0 || disk_bandwidth <= 0) {
+    MS_LOG(WARNING) << "The environment variable " << kSwapBandwidthEnv << " should be 'ddr,disk' in GB/s, but got "
+                    << bandwidth << ", use the default bandwidth.";
+    return;
+  }
+  swap_context->ddr_bandwidth_ = ddr_bandwidth * kGBPerSecondToBytesPerMicrosecond;
+  swap_context->disk_bandwidth_ = disk_bandwidth * kGBPerSecondToBytesPerMicrosecond;
+}
+
+// Return true if any kernel time is loaded.
+bool LoadKernelTimeProfile(const std::shared_ptr<device::SwapContext> &swap_context) {
+  MS_EXCEPTION_IF_NULL(swap_context);
+  const auto &profile_path = common::GetEnv(kSwapKernelProfileEnv);
+  if (profile_path.empty()) {
+    return false;
+  }
+  const auto &real_path = FileUtils::GetRealPath(profile_path.c_str());
+  if (!real_path.has_value()) {
+    MS_LOG(WARNING) << "Invalid kernel time profile path: " << profile_path;
+    return false;
+  }
+  std::ifstream ifs(real_path.value());
+  if (!ifs.is_open()) {
+    MS_LOG(WARNING) << "Open kernel time profile failed: " << real_path.value();
+    return false;
+  }
+  std::string line;
+  float total_kernel_time = 0;
+  while (std::getline(ifs, line)) {
+    const auto pos = line.rfind(',');
+    if (pos == std::string::npos) {
+      continue;
+    }
+    try {
+      auto kernel_time = std::stof(line.substr(pos + 1));
+      swap_context->kernel_time_[line.substr(0, pos)] = kernel_time;
+      total_kernel_time += kernel_time;
+    } catch (const std::exception &e) {
+      MS_LOG(WARNING) << "Invalid kernel time profile line: " << line;
+    }
+  }
+  MS_LOG(INFO) << "Load " << swap_context->kernel_time_.size() << " kernel time from " << real_path.value();
+  if (swap_context->kernel_time_.empty()) {
+    return false;
+  }
+  // The kernel not in the profile is estimated by the average time of the profiled kernels.
+  swap_context->default_kernel_time_ = total_kernel_time / swap_context->kernel_time_.size();
+  return true;
+}
+
 AbstractActor *GetCtrlActor(const ControlNodeParserPtr &parser, const KernelGraph *graph, const string &actor_suffix) {
   MS_EXCEPTION_IF_NULL(parser);
   MS_EXCEPTION_IF_NULL(graph);
@@ -169,6 +246,10 @@ void MemSwapScheduler::BuildSwapActorForGraph(const KernelGraphPtr &graph, const
   }
   device::SwapStrategyBuilder builder;
   const auto &swap_context = std::make_shared<device::SwapContext>();
+  swap_context->enable_prefetch_ = LoadKernelTimeProfile(swap_context);
+  if (swap_context->enable_prefetch_) {
+    LoadSwapBandwidth(swap_context);
+  }
   auto swap_strategy = builder.Build(graph, swap_context);
   MS_EXCEPTION_IF_NULL(swap_strategy);
   graph_strategy_map_[graph->graph_id()] = swap_strategy;
@@ -840,6 +840,27 @@ void CheckControlActorValid(const ActorSet *actor_set) {
 }
 }  // namespace
 
+bool SchedulerHelper::SetCommunicationAsync(const std::vector<AbstractActor *> &communication_actors) {
+  std::vector<KernelActor *> kernel_actors;
+  for (const auto &actor : communication_actors) {
+    if ((actor == nullptr) || (actor->type() != KernelTransformType::kKernelActor)) {
+      return false;
+    }
+    auto kernel_actor = dynamic_cast<KernelActor *>(actor);
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    if (kernel_actor->device_contexts_.empty() || (kernel_actor->device_contexts_[0] == nullptr) ||
+        (kernel_actor->device_contexts_[0]->GetDeviceType() != device::DeviceType::kCPU)) {
+      return false;
+    }
+    (void)kernel_actors.emplace_back(kernel_actor);
+  }
+  for (auto &kernel_actor : kernel_actors) {
+    kernel_actor->is_communication_async_ = true;
+  }
+  MS_LOG(INFO) << "The communication of " << kernel_actors.size() << " kernels overlaps with computation.";
+  return true;
+}
+
 void SchedulerHelper::CheckActorValid(const ActorSet *actor_set) {
   MS_EXCEPTION_IF_NULL(actor_set);
   auto actors = SchedulerHelper::CollectActors(actor_set);
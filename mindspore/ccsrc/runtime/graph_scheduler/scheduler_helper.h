@@ -94,6 +94,11 @@ class SchedulerHelper {
                                 const KernelGraphPtr &from_graph);
   static void AddSomasInfo(AbstractActor *const actor);
 
+  // The interface of overlapping the communication with the computation. Mark the communication actors to launch in
+  // the communication thread if all of them are cpu kernel actors, and return whether they are marked. The marked
+  // actors don't need the control arrows by the execution order.
+  static bool SetCommunicationAsync(const std::vector<AbstractActor *> &communication_actors);
+
   // Check whether the actor set is valid.
   static void CheckActorValid(const ActorSet *actor_set);
 
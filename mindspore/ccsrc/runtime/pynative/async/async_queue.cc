@@ -17,15 +17,88 @@
 #include "runtime/pynative/async/async_queue.h"
 
 #include <utility>
+#include <stdexcept>
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
 #include "include/common/utils/signal_util.h"
 #endif
+#include "pybind_api/gil_scoped_long_running.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_exception.h"
 
 namespace mindspore {
 namespace pynative {
-AsyncQueue::~AsyncQueue() { WorkerJoin(); }
+namespace {
+// Spin a while before the worker sleeps, since the ops are usually dispatched continuously.
+constexpr size_t kWorkerSpinCount = 128;
+
+// Hold the task created by the caller in the slot.
+class SharedTask : public AsyncTask {
+ public:
+  explicit SharedTask(const std::shared_ptr<AsyncTask> &task) : AsyncTask(task->task_type()), task_(task) {}
+  ~SharedTask() override = default;
+  void Run() override { task_->Run(); }
+  void SetException(const std::exception_ptr &e) override { task_->SetException(e); }
+
+ private:
+  std::shared_ptr<AsyncTask> task_;
+};
+}  // namespace
+
+AsyncQueue::AsyncQueue() : slots_(kTaskSlotNum), slot_mask_(kTaskSlotNum - 1) {
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    slots_[i].sequence_.store(i, std::memory_order_relaxed);
+  }
+}
+
+AsyncQueue::~AsyncQueue() {
+  WorkerJoin();
+  // Destroy the tasks which are never run.
+  for (auto &slot : slots_) {
+    if (slot.task_ != nullptr) {
+      slot.task_->~AsyncTask();
+      slot.task_ = nullptr;
+    }
+  }
+}
+
+bool AsyncQueue::HasReadyTask() const {
+  const auto &slot = slots_[head_ & slot_mask_];
+  return slot.sequence_.load(std::memory_order_acquire) == head_ + 1;
+}
+
+void AsyncQueue::ReleaseHeadSlot() {
+  auto &slot = slots_[head_ & slot_mask_];
+  slot.task_->~AsyncTask();
+  slot.task_ = nullptr;
+  // Release the slot to the producers of next round.
+  slot.sequence_.store(head_ + slots_.size(), std::memory_order_release);
+  ++head_;
+}
+
+void AsyncQueue::WaitForTask() {
+  for (size_t i = 0; i < kWorkerSpinCount; ++i) {
+    if (HasReadyTask()) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+  std::unique_lock<std::mutex> lock(task_mutex_);
+  worker_sleeping_.store(true);
+  task_cond_var_.wait(lock, [this]() { return HasReadyTask(); });
+  worker_sleeping_.store(false);
+}
+
+void AsyncQueue::FinishTasks(size_t task_num) {
+  if (task_num == 0 || pending_num_.fetch_sub(task_num) != task_num) {
+    return;
+  }
+  if (waiter_num_.load() > 0) {
+    // cppcheck-suppress unreadVariable
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    MS_LOG(DEBUG) << "Task queue empty";
+    wait_cond_var_.notify_all();
+  }
+}
 
 void AsyncQueue::WorkerLoop() {
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
@@ -37,65 +110,117 @@ void AsyncQueue::WorkerLoop() {
   });
 #endif
 
+  // The ready tasks are run back to back in their slots, and the worker only sleeps when the ring is drained.
   while (true) {
-    std::shared_ptr<AsyncTask> task;
-    {
-      std::unique_lock<std::mutex> lock(task_mutex_);
-      task_cond_var_.wait(lock, [this]() { return !tasks_.empty(); });
-      task = tasks_.front();
+    if (!HasReadyTask()) {
+      WaitForTask();
+      continue;
     }
 
-    MS_LOG(DEBUG) << "Get task";
+    auto task = slots_[head_ & slot_mask_].task_;
     MS_EXCEPTION_IF_NULL(task);
     if (task->task_type() == kExitTask) {
       MS_LOG(DEBUG) << "Thread exit";
+      ReleaseHeadSlot();
+      FinishTasks(1);
       return;
     }
 
+    // The task is cleared by Clear or Reset before running.
+    if (head_ < clear_position_.load()) {
+      task->SetException(std::make_exception_ptr(std::runtime_error("Clean up tasks that are not yet running")));
+      ReleaseHeadSlot();
+      FinishTasks(1);
+      continue;
+    }
+
+    std::exception_ptr e_ptr = nullptr;
     try {
       task->Run();
-      std::unique_lock<std::mutex> lock(task_mutex_);
-      if (!tasks_.empty()) {
-        tasks_.pop();
-      }
-
-      if (tasks_.empty()) {
-        MS_LOG(DEBUG) << "Task queue empty";
-        task_cond_var_.notify_all();
-      }
     } catch (const std::exception &e) {
       MS_LOG(INFO) << "Run task failed, error msg:" << e.what();
-      {
-        // cppcheck-suppress unreadVariable
-        std::unique_lock<std::mutex> lock(task_mutex_);
-
-        MsException::Instance().SetException();
-        // MsException is unreliable because it gets modified everywhere.
-        auto e_ptr = std::current_exception();
-        task->SetException(e_ptr);
-        while (!tasks_.empty()) {
-          auto &t = tasks_.front();
-          if (t->task_type() == kExitTask) {
-            break;
-          }
-          t->SetException(e_ptr);
-          tasks_.pop();
-        }
-
-        task_cond_var_.notify_all();
-      }
+      MsException::Instance().SetException();
+      // MsException is unreliable because it gets modified everywhere.
+      e_ptr = std::current_exception();
+      task->SetException(e_ptr);
+    }
+    ReleaseHeadSlot();
+    FinishTasks(1);
+    if (e_ptr != nullptr && ClearTaskWithException(e_ptr)) {
+      MS_LOG(DEBUG) << "Thread exit";
+      return;
     }
   }
 }
 
-void AsyncQueue::Push(const std::shared_ptr<AsyncTask> &task) {
+bool AsyncQueue::ClearTaskWithException(const std::exception_ptr &e_ptr) {
+  size_t cleared_num = 0;
+  while (HasReadyTask()) {
+    auto task = slots_[head_ & slot_mask_].task_;
+    MS_EXCEPTION_IF_NULL(task);
+    if (task->task_type() == kExitTask) {
+      ReleaseHeadSlot();
+      FinishTasks(cleared_num + 1);
+      return true;
+    }
+    task->SetException(e_ptr);
+    ReleaseHeadSlot();
+    ++cleared_num;
+  }
+  FinishTasks(cleared_num);
+  return false;
+}
+
+size_t AsyncQueue::ClaimSlot() {
   if (worker_ == nullptr) {
     worker_ = std::make_shared<std::thread>(&AsyncQueue::WorkerLoop, this);
   }
-  // cppcheck-suppress unreadVariable
-  std::lock_guard<std::mutex> lock(task_mutex_);
-  tasks_.push(task);
-  task_cond_var_.notify_all();
+  (void)pending_num_.fetch_add(1);
+
+  // Claim a free slot by moving the tail forward.
+  std::unique_ptr<GilReleaseWithCheck> gil_release = nullptr;
+  size_t position = tail_.load(std::memory_order_relaxed);
+  while (true) {
+    auto &slot = slots_[position & slot_mask_];
+    const size_t sequence = slot.sequence_.load(std::memory_order_acquire);
+    if (sequence == position) {
+      if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        return position;
+      }
+    } else if (sequence < position) {
+      // The ring is full, wait for the worker to drain the tasks.
+      // The worker can't drain the tasks while it is pushing, so the task is failed instead of deadlock.
+      if (worker_->get_id() == std::this_thread::get_id()) {
+        (void)pending_num_.fetch_sub(1);
+        MS_LOG(EXCEPTION) << "The async queue is full, and the task is pushed by the worker thread itself.";
+      }
+      // The tasks may acquire the GIL, so the producer releases the GIL while waiting for the worker.
+      if (gil_release == nullptr) {
+        gil_release = std::make_unique<GilReleaseWithCheck>();
+      }
+      std::this_thread::yield();
+      position = tail_.load(std::memory_order_relaxed);
+    } else {
+      position = tail_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void AsyncQueue::PublishSlot(size_t position) {
+  slots_[position & slot_mask_].sequence_.store(position + 1, std::memory_order_release);
+
+  // Only wake up the worker when it is sleeping.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (worker_sleeping_.load()) {
+    // cppcheck-suppress unreadVariable
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    task_cond_var_.notify_one();
+  }
+}
+
+void AsyncQueue::Push(const std::shared_ptr<AsyncTask> &task) {
+  MS_EXCEPTION_IF_NULL(task);
+  Emplace<SharedTask>(task);
 }
 
 void AsyncQueue::Wait() {
@@ -106,58 +231,35 @@ void AsyncQueue::Wait() {
   if (worker_->get_id() == std::this_thread::get_id()) {
     return;
   }
-  std::unique_lock<std::mutex> lock(task_mutex_);
-  task_cond_var_.wait(lock, [this]() { return tasks_.empty(); });
+  if (pending_num_.load() != 0) {
+    (void)waiter_num_.fetch_add(1);
+    {
+      std::unique_lock<std::mutex> lock(task_mutex_);
+      wait_cond_var_.wait(lock, [this]() { return pending_num_.load() == 0; });
+    }
+    (void)waiter_num_.fetch_sub(1);
+  }
   MsException::Instance().CheckException();
 }
 
-bool AsyncQueue::Empty() {
-  // cppcheck-suppress unreadVariable
-  std::lock_guard<std::mutex> lock(task_mutex_);
-  return tasks_.empty();
-}
+bool AsyncQueue::Empty() { return pending_num_.load() == 0; }
 
 void AsyncQueue::Clear() {
-  {
-    // cppcheck-suppress unreadVariable
-    std::lock_guard<std::mutex> lock(task_mutex_);
-    if (tasks_.empty()) {
-      return;
-    }
-
-    ClearTaskWithException();
-
-    // Avoid to push task after WorkerJoin.
-    if (worker_ != nullptr && worker_->joinable()) {
-      auto task = std::make_shared<WaitTask>();
-      tasks_.push(task);
-    }
-
-    task_cond_var_.notify_all();
+  if (Empty()) {
+    return;
   }
+  // The tasks pushed before will be dropped with exception by the worker.
+  clear_position_.store(tail_.load());
   // There is still one task in progress
   Wait();
 }
 
 void AsyncQueue::Reset() {
-  {
-    // cppcheck-suppress unreadVariable
-    std::lock_guard<std::mutex> lock(task_mutex_);
-    if (tasks_.empty()) {
-      return;
-    }
-
-    ClearTaskWithException();
-    MS_LOG(DEBUG) << "Reset AsyncQueue";
-  }
-}
-
-void AsyncQueue::ClearTaskWithException() {
-  while (!tasks_.empty()) {
-    auto &t = tasks_.front();
-    t->SetException(std::make_exception_ptr(std::runtime_error("Clean up tasks that are not yet running")));
-    tasks_.pop();
+  if (Empty()) {
+    return;
   }
+  clear_position_.store(tail_.load());
+  MS_LOG(DEBUG) << "Reset AsyncQueue";
 }
 
 void AsyncQueue::WorkerJoin() {
@@ -167,14 +269,8 @@ void AsyncQueue::WorkerJoin() {
     }
     // Avoid worker thread join itself which will cause deadlock
     if (worker_->joinable() && worker_->get_id() != std::this_thread::get_id()) {
-      {
-        // cppcheck-suppress unreadVariable
-        std::lock_guard<std::mutex> lock(task_mutex_);
-        auto task = std::make_shared<ExitTask>();
-        tasks_.push(task);
-        task_cond_var_.notify_all();
-        MS_LOG(DEBUG) << "Push exit task and notify all";
-      }
+      Emplace<ExitTask>();
+      MS_LOG(DEBUG) << "Push exit task and notify all";
       worker_->join();
       MS_LOG(DEBUG) << "Worker join finish";
       MsException::Instance().CheckException();
@@ -17,11 +17,16 @@
 #ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_ASYNC_QUEUE_H_
 #define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_ASYNC_ASYNC_QUEUE_H_
 
-#include <queue>
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <new>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "include/backend/visible.h"
 #include "runtime/pynative/async/task.h"
@@ -29,14 +34,45 @@
 namespace mindspore {
 namespace pynative {
 // Create a new thread to execute the tasks in the queue sequentially.
+// The tasks are constructed in a ring of preallocated slots, the producers push the task without lock and the worker
+// runs the ready tasks back to back. The mutex and condition variables are only used when the worker or the waiter goes
+// to sleep.
 class BACKEND_EXPORT AsyncQueue {
  public:
-  AsyncQueue() = default;
+  AsyncQueue();
   ~AsyncQueue();
 
-  // Add task to the end of the queue.
+  // The slot number of the ring, which must be a power of 2.
+  static constexpr size_t kTaskSlotNum = 8192;
+  // The task not larger than it is constructed in the slot instead of the heap.
+  static constexpr size_t kTaskStorageSize = 128;
+
+  // Add task to the end of the queue. The producer waits with the GIL released when the ring is full, but the worker
+  // thread itself can't wait, so an exception is thrown when the worker pushes to the full ring.
   void Push(const std::shared_ptr<AsyncTask> &task);
 
+  // Construct the task in the slot at the end of the queue, so the task is not allocated for each op. The task larger
+  // than the slot storage is allocated and pushed as Push does.
+  template <typename T, typename... Args>
+  void Emplace(Args &&... args) {
+    static_assert(std::is_base_of_v<AsyncTask, T>, "The task should be derived from AsyncTask.");
+    if constexpr (sizeof(T) > kTaskStorageSize || alignof(T) > alignof(std::max_align_t)) {
+      Push(std::make_shared<T>(std::forward<Args>(args)...));
+    } else {
+      size_t position = ClaimSlot();
+      auto &slot = slots_[position & slot_mask_];
+      try {
+        slot.task_ = new (slot.storage_) T(std::forward<Args>(args)...);
+      } catch (...) {
+        // The claimed slot is filled with an empty task, otherwise the worker waits for it forever.
+        slot.task_ = new (slot.storage_) WaitTask();
+        PublishSlot(position);
+        throw;
+      }
+      PublishSlot(position);
+    }
+  }
+
   // Wait for all async task finish executing.
   void Wait();
 
@@ -46,21 +82,54 @@ class BACKEND_EXPORT AsyncQueue {
   // clear tasks of queue, and wait last task.
   void Clear();
 
-  // When an exception occurs, the state needs to be reset.
+  // When an exception occurs, the state needs to be reset. It doesn't wait: the tasks pushed before and not yet running
+  // are dropped with exception by the worker, and Wait returns after they are dropped.
   void Reset();
 
   // Thread join before the process exit.
   void WorkerJoin();
 
  private:
+  struct TaskSlot {
+    // The sequence is equal to the position when the slot is free to push, and position + 1 when the task is ready.
+    std::atomic<size_t> sequence_{0};
+    // The task constructed in the storage.
+    AsyncTask *task_{nullptr};
+    alignas(std::max_align_t) unsigned char storage_[kTaskStorageSize];
+  };
+
   void WorkerLoop();
 
-  void ClearTaskWithException();
+  // Claim a free slot for pushing, return the position of the slot.
+  size_t ClaimSlot();
+  // Make the task in the claimed slot ready to run.
+  void PublishSlot(size_t position);
+  // Destroy the task of the head slot and release the slot to the producers, only called by the worker.
+  void ReleaseHeadSlot();
+  bool HasReadyTask() const;
+  void WaitForTask();
+  // Finish the tasks which have been run or dropped, and wake up the waiters if there is no pending task.
+  void FinishTasks(size_t task_num);
+
+  // Set exception to the ready tasks after the failed task, return true if the exit task is met.
+  bool ClearTaskWithException(const std::exception_ptr &e_ptr);
+
+  std::vector<TaskSlot> slots_;
+  size_t slot_mask_;
+  alignas(64) std::atomic<size_t> tail_{0};
+  // Only accessed by the worker.
+  alignas(64) size_t head_{0};
+  // The number of pushed tasks which are not finished.
+  alignas(64) std::atomic<size_t> pending_num_{0};
+  // The tasks whose position is before it will be dropped with exception instead of running.
+  std::atomic<size_t> clear_position_{0};
+  std::atomic<bool> worker_sleeping_{false};
+  std::atomic<size_t> waiter_num_{0};
 
-  std::queue<std::shared_ptr<AsyncTask>> tasks_;
   std::shared_ptr<std::thread> worker_{nullptr};
   std::mutex task_mutex_;
   std::condition_variable task_cond_var_;
+  std::condition_variable wait_cond_var_;
 };
 using AsyncQueuePtr = std::shared_ptr<AsyncQueue>;
 }  // namespace pynative
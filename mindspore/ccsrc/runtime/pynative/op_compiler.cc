@@ -18,6 +18,8 @@
 
 #include <memory>
 #include <algorithm>
+#include <iterator>
+#include <string>
 #include <vector>
 #include "include/backend/anf_runtime_algorithm.h"
 #include "runtime/pynative/op_executor.h"
@@ -29,6 +31,45 @@ namespace mindspore {
 using runtime::DeviceAddressUtils;
 namespace pynative {
 namespace {
+constexpr char kOpCacheMemSizeEnv[] = "MS_DEV_OP_CACHE_MEM_SIZE";
+constexpr size_t kDefaultOpCacheMemSize = 2048;
+constexpr size_t kMBToByte = 1024 * 1024;
+// The estimated host memory of one kernel in the cached graph, including the anf nodes, kernel mod and runtime info.
+constexpr size_t kKernelCacheBytes = 64 * 1024;
+
+size_t GetOpCacheBytesLimit() {
+  size_t mem_size = kDefaultOpCacheMemSize;
+  const auto &env = common::GetEnv(kOpCacheMemSizeEnv);
+  if (!env.empty()) {
+    try {
+      mem_size = std::stoul(env);
+    } catch (const std::exception &e) {
+      MS_LOG(WARNING) << "Invalid value of " << kOpCacheMemSizeEnv << ": " << env << ", use the default value "
+                      << kDefaultOpCacheMemSize << "MB.";
+    }
+  }
+  return mem_size * kMBToByte;
+}
+
+size_t EstimateCacheBytes(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  size_t cache_bytes = graph->execution_order().size() * kKernelCacheBytes;
+  // The device memory of value nodes is held by the cached graph.
+  for (const auto &value_node : graph->graph_value_nodes()) {
+    MS_EXCEPTION_IF_NULL(value_node);
+    for (size_t i = 0; i < AnfAlgo::GetOutputAddressNum(value_node); ++i) {
+      if (!AnfAlgo::OutputAddrExist(value_node, i)) {
+        continue;
+      }
+      const auto &device_address = AnfAlgo::GetMutableOutputAddr(value_node, i, false);
+      if (device_address != nullptr) {
+        cache_bytes += device_address->GetSize();
+      }
+    }
+  }
+  return cache_bytes;
+}
+
 void UpdateRefInfoBeforeCreateKernel(const session::BackendOpRunInfoPtr &op_run_info, const KernelGraphPtr &graph) {
   // Building Graph and Create Kernel is async, under pynative mode.Ref info is bind with kernel.
   // So need to get ref info to generate output addr, before create kernel.
@@ -51,7 +92,9 @@ void CreateDeviceAddressWithoutWorkspace(const KernelGraphPtr &graph, const Devi
 }
 }  // namespace
 
-OpCompiler::OpCompiler() { session_ = session::SessionFactory::Get().Create(kSessionBasic); }
+OpCompiler::OpCompiler() : op_cache_lru_(GetOpCacheBytesLimit()) {
+  session_ = session::SessionFactory::Get().Create(kSessionBasic);
+}
 
 OpCompiler &OpCompiler::GetInstance() {
   static OpCompiler instance;
@@ -70,9 +113,11 @@ OpCompilerInfoPtr OpCompiler::Compile(const session::BackendOpRunInfoPtr &op_run
     const auto &op_compiler_info = iter->second;
     MS_EXCEPTION_IF_NULL(op_compiler_info);
     *single_op_cache_hit = true;
+    op_cache_lru_.Hit(graph_info);
     return iter->second;
   }
   MS_LOG(INFO) << "Run Op cache miss " << op_run_info->base_op_run_info.graph_info;
+  op_cache_lru_.Miss();
 
   *single_op_cache_hit = false;
   // Generate kernel graph.
@@ -113,10 +158,86 @@ OpCompilerInfoPtr OpCompiler::Compile(const session::BackendOpRunInfoPtr &op_run
     std::make_shared<OpCompilerInfo>(graph_info, graph->graph_id(), graph, outputs_with_index, device_context,
                                      op_run_info->base_op_run_info.need_earse_cache);
 
-  op_compiler_infos_[graph_info] = op_compiler_info;
+  op_compiler_info->cache_bytes_ = EstimateCacheBytes(graph);
+  InsertOpCache(graph_info, op_compiler_info);
   return op_compiler_info;
 }
 
+void OpCacheLru::Hit(const GraphInfo &graph_info) {
+  ++hit_count_;
+  const auto &iter = entries_.find(graph_info);
+  if (iter == entries_.end()) {
+    return;
+  }
+  lru_.splice(lru_.begin(), lru_, iter->second.first);
+}
+
+void OpCacheLru::Insert(const GraphInfo &graph_info, size_t bytes) {
+  Erase(graph_info);
+  lru_.push_front(graph_info);
+  entries_[graph_info] = {lru_.begin(), bytes};
+  bytes_ += bytes;
+}
+
+void OpCacheLru::Erase(const GraphInfo &graph_info) {
+  const auto &iter = entries_.find(graph_info);
+  if (iter == entries_.end()) {
+    return;
+  }
+  bytes_ -= std::min(bytes_, iter->second.second);
+  (void)lru_.erase(iter->second.first);
+  (void)entries_.erase(iter);
+}
+
+void OpCacheLru::Clear() {
+  lru_.clear();
+  entries_.clear();
+  bytes_ = 0;
+}
+
+std::vector<GraphInfo> OpCacheLru::Evict(const std::function<bool(const GraphInfo &)> &can_evict) {
+  std::vector<GraphInfo> evict_graphs;
+  if (lru_.size() <= 1) {
+    return evict_graphs;
+  }
+  // Keep the most recently used one which has just been compiled.
+  auto lru_iter = lru_.end();
+  while (bytes_ > bytes_limit_ && lru_iter != std::next(lru_.begin())) {
+    --lru_iter;
+    if (can_evict != nullptr && !can_evict(*lru_iter)) {
+      continue;
+    }
+    const GraphInfo evict_graph_info = *lru_iter;
+    ++lru_iter;
+    Erase(evict_graph_info);
+    ++evict_count_;
+    (void)evict_graphs.emplace_back(evict_graph_info);
+  }
+  return evict_graphs;
+}
+
+void OpCompiler::InsertOpCache(const GraphInfo &graph_info, const OpCompilerInfoPtr &op_compiler_info) {
+  MS_EXCEPTION_IF_NULL(op_compiler_info);
+  // The cache may exist when the build queue is not empty.
+  ClearOpCache(graph_info);
+  op_compiler_infos_[graph_info] = op_compiler_info;
+  op_cache_lru_.Insert(graph_info, op_compiler_info->cache_bytes_);
+
+  auto &op_executor = runtime::OpExecutor::GetInstance();
+  const auto &can_evict = [this, &op_executor](const GraphInfo &evict_graph_info) {
+    const auto &info_iter = op_compiler_infos_.find(evict_graph_info);
+    if (info_iter == op_compiler_infos_.end() || info_iter->second == nullptr) {
+      return false;
+    }
+    // The graph can't be evicted while its op is waiting to run.
+    return !op_executor.ActorInQueue(info_iter->second->graph_id_);
+  };
+  for (const auto &evict_graph_info : op_cache_lru_.Evict(can_evict)) {
+    MS_LOG(DEBUG) << "Evict op cache " << evict_graph_info;
+    (void)op_compiler_infos_.erase(evict_graph_info);
+  }
+}
+
 void OpCompiler::BatchBuild(const std::vector<KernelGraphPtr> &graphs, const DeviceContext *device_context,
                             bool is_dynamic) {
   MS_EXCEPTION_IF_NULL(device_context);
@@ -142,8 +263,16 @@ void OpCompiler::BatchBuild(const std::vector<KernelGraphPtr> &graphs, const Dev
   }
 }
 
-void OpCompiler::ClearOpCache(const GraphInfo &graph_info) { (void)op_compiler_infos_.erase(graph_info); }
+void OpCompiler::ClearOpCache(const GraphInfo &graph_info) {
+  (void)op_compiler_infos_.erase(graph_info);
+  op_cache_lru_.Erase(graph_info);
+}
 
-void OpCompiler::ClearAllCache() { op_compiler_infos_.clear(); }
+void OpCompiler::ClearAllCache() {
+  MS_LOG(INFO) << "Op cache hit count: " << op_cache_lru_.hit_count() << ", miss count: " << op_cache_lru_.miss_count()
+               << ", evict count: " << op_cache_lru_.evict_count() << ", cache bytes: " << op_cache_lru_.bytes();
+  op_compiler_infos_.clear();
+  op_cache_lru_.Clear();
+}
 }  // namespace pynative
 }  // namespace mindspore
@@ -16,6 +16,8 @@
 #ifndef MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_COMPILER_H_
 #define MINDSPORE_MINDSPORE_CCSRC_RUNTIME_PYNATIVE_OP_COMPILER_H_
 
+#include <functional>
+#include <list>
 #include <utility>
 #include <vector>
 #include <memory>
@@ -45,9 +47,45 @@ struct OpCompilerInfo {
   std::vector<KernelWithIndex> graph_output_nodes_;
   DeviceContext *device_context_;
   bool need_erase_;
+  // The estimated memory held by the cached graph, used to bound the op cache.
+  size_t cache_bytes_{0};
 };
 using OpCompilerInfoPtr = std::shared_ptr<OpCompilerInfo>;
 
+// The least recently used order, the memory usage and the statistics of the op cache.
+class BACKEND_EXPORT OpCacheLru {
+ public:
+  explicit OpCacheLru(size_t bytes_limit) : bytes_limit_(bytes_limit) {}
+  ~OpCacheLru() = default;
+
+  // Record a cache hit and move the graph to the most recently used.
+  void Hit(const GraphInfo &graph_info);
+  void Miss() { ++miss_count_; }
+  // Insert the graph as the most recently used.
+  void Insert(const GraphInfo &graph_info, size_t bytes);
+  void Erase(const GraphInfo &graph_info);
+  void Clear();
+  // Evict the least recently used graphs until the memory budget is met, and return the evicted graphs. The most
+  // recently used one is always kept, and the graphs which can't be evicted are skipped.
+  std::vector<GraphInfo> Evict(const std::function<bool(const GraphInfo &)> &can_evict);
+
+  // The graphs from the most recently used to the least recently used.
+  const std::list<GraphInfo> &lru() const { return lru_; }
+  size_t bytes() const { return bytes_; }
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+  size_t evict_count() const { return evict_count_; }
+
+ private:
+  std::list<GraphInfo> lru_;
+  mindspore::HashMap<GraphInfo, std::pair<std::list<GraphInfo>::iterator, size_t>> entries_;
+  size_t bytes_limit_;
+  size_t bytes_{0};
+  size_t hit_count_{0};
+  size_t miss_count_{0};
+  size_t evict_count_{0};
+};
+
 // FuncGraph, Backend and GraphCompiler correspond one-to-one,
 // and GraphCompiler stores the compilation cache of operators.
 // When the graph structure changes, the front-end will send multiple graphs,
@@ -73,14 +111,26 @@ class BACKEND_EXPORT OpCompiler {
   // Clear anf resources before process exit.
   void ClearAllCache();
 
+  // The statistics of op cache.
+  size_t cache_hit_count() const { return op_cache_lru_.hit_count(); }
+  size_t cache_miss_count() const { return op_cache_lru_.miss_count(); }
+  size_t cache_evict_count() const { return op_cache_lru_.evict_count(); }
+  size_t cache_bytes() const { return op_cache_lru_.bytes(); }
+
  private:
   OpCompiler();
   ~OpCompiler() = default;
   DISABLE_COPY_AND_ASSIGN(OpCompiler);
 
+  // Insert the op compiler info as the most recently used, and evict the least recently used ones which exceed the
+  // memory budget of op cache.
+  void InsertOpCache(const GraphInfo &graph_info, const OpCompilerInfoPtr &op_compiler_info);
+
   // All operators shared the same session.
   session::SessionPtr session_;
   mindspore::HashMap<GraphInfo, OpCompilerInfoPtr> op_compiler_infos_;
+  // The memory budget of op cache is set by the environment variable 'MS_DEV_OP_CACHE_MEM_SIZE' in MB.
+  OpCacheLru op_cache_lru_;
 };
 }  // namespace pynative
 using OpCompilerInfoPtr = pynative::OpCompilerInfoPtr;
@@ -83,9 +83,13 @@ void OpExecutor::PushOpBuildTask(const std::shared_ptr<pynative::BackendOpBuildT
   op_build_tasks_.push_back(op_build_task);
 }
 
-void OpExecutor::PushOpRunTask(const std::shared_ptr<pynative::BackendOpRunTask> &op_run_task) {
-  async_queue_.Push(op_run_task);
-  (void)actor_in_queue_.insert(op_run_task->context()->graph_id());
+void OpExecutor::PushOpRunTask(const std::shared_ptr<pynative::OpTaskContext> &context,
+                               std::function<void(const std::shared_ptr<pynative::OpTaskContext> &context)> run_func,
+                               std::future<bool> future) {
+  MS_EXCEPTION_IF_NULL(context);
+  auto graph_id = context->graph_id();
+  async_queue_.Emplace<pynative::BackendOpRunTask>(context, std::move(run_func), std::move(future));
+  (void)actor_in_queue_.insert(graph_id);
 }
 
 std::vector<std::shared_ptr<pynative::BackendOpBuildTask>> OpExecutor::PopOpBuildTasks() {
@@ -51,7 +51,10 @@ class BACKEND_EXPORT OpExecutor {
 
   void PushOpBuildTask(const std::shared_ptr<pynative::BackendOpBuildTask> &op_build_task);
 
-  void PushOpRunTask(const std::shared_ptr<pynative::BackendOpRunTask> &op_run_task);
+  // The run task is constructed in the async queue to avoid allocating it for each op.
+  void PushOpRunTask(const std::shared_ptr<pynative::OpTaskContext> &context,
+                     std::function<void(const std::shared_ptr<pynative::OpTaskContext> &context)> run_func,
+                     std::future<bool> future);
 
   const std::vector<std::shared_ptr<pynative::BackendOpBuildTask>> &GetOpBuildTasks() const { return op_build_tasks_; }
 
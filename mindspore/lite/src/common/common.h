@@ -71,6 +71,15 @@ static const char *const kSharedThreadPoolSection = "shared_thread_pool";
 static const char *const kEnableSharedThreadPoolKey = "enable_shared_thread_pool";
 static const char *const kThreadNumLimitPerWorkerKey = "thread_num_limit_per_worker";
 static const char *const kThreadNumRemainingPerWorkerKey = "thread_num_remaining_per_worker";
+// cpu bf16 compute
+static const char *const kCpuContextSection = "cpu_context";
+static const char *const kEnableBf16Key = "enable_bf16";
+// sidecar file of the weights packed by the cpu kernels
+static const char *const kPackedWeightFileKey = "packed_weight_file";
+// profile file of the thread num tuned for the kernels on the machine
+static const char *const kThreadNumProfileKey = "thread_num_profile";
+// run the independent branches of the cpu subgraph at the same time
+static const char *const kEnableInterOpParallelKey = "enable_inter_op_parallel";
 // model pool inner section and key
 static const char *const kInnerModelParallelRunnerSection = "inner_model_parallel_runner";
 static const char *const kInnerSharingWeightCopyBufKey = "sharing_weight_copy_buf";
@@ -18,6 +18,7 @@
 #include "src/tensor.h"
 #include "nnacl/custom_parameter.h"
 #include "nnacl/split_parameter.h"
+#include "nnacl/attention_parameter.h"
 using mindspore::schema::PrimitiveType_Custom;
 
 namespace mindspore {
@@ -36,6 +37,79 @@ bool GetDataFromPrim(void *dst, size_t len, const schema::Custom *custom_prim, s
   return true;
 }
 
+OpParameter *PopulateFlashAttentionParameter(const schema::Custom *custom_prim) {
+  auto *param = static_cast<FlashAttentionParameter *>(malloc(sizeof(FlashAttentionParameter)));
+  if (param == nullptr) {
+    MS_LOG(ERROR) << "malloc FlashAttentionParameter failed.";
+    return nullptr;
+  }
+  memset(param, 0, sizeof(FlashAttentionParameter));
+  param->op_parameter_.type_ = PrimType_Inner_FlashAttention;
+  param->scale_ = 1.0f;
+  auto attrs = custom_prim->attr();
+  if (attrs == nullptr) {
+    return reinterpret_cast<OpParameter *>(param);
+  }
+  for (size_t i = 0; i < attrs->size(); ++i) {
+    auto attr = attrs->Get(i);
+    if (attr == nullptr || attr->name() == nullptr) {
+      continue;
+    }
+    std::string name = attr->name()->str();
+    bool ret = true;
+    if (name == "scale") {
+      ret = GetDataFromPrim(&param->scale_, sizeof(float), custom_prim, i);
+    } else if (name == "causal") {
+      ret = GetDataFromPrim(&param->causal_, sizeof(bool), custom_prim, i);
+    } else if (name == "key_transpose") {
+      ret = GetDataFromPrim(&param->key_transpose_, sizeof(bool), custom_prim, i);
+    }
+    if (!ret) {
+      MS_LOG(ERROR) << "Get " << name << " of FlashAttention from prim failed.";
+      free(param);
+      return nullptr;
+    }
+  }
+  return reinterpret_cast<OpParameter *>(param);
+}
+
+OpParameter *PopulateKVCacheAttentionParameter(const schema::Custom *custom_prim) {
+  auto *param = static_cast<KVCacheAttentionParameter *>(malloc(sizeof(KVCacheAttentionParameter)));
+  if (param == nullptr) {
+    MS_LOG(ERROR) << "malloc KVCacheAttentionParameter failed.";
+    return nullptr;
+  }
+  memset(param, 0, sizeof(KVCacheAttentionParameter));
+  param->op_parameter_.type_ = PrimType_Inner_KVCacheAttention;
+  param->scale_ = 1.0f;
+  auto attrs = custom_prim->attr();
+  if (attrs == nullptr) {
+    return reinterpret_cast<OpParameter *>(param);
+  }
+  for (size_t i = 0; i < attrs->size(); ++i) {
+    auto attr = attrs->Get(i);
+    if (attr == nullptr || attr->name() == nullptr) {
+      continue;
+    }
+    std::string name = attr->name()->str();
+    bool ret = true;
+    if (name == "scale") {
+      ret = GetDataFromPrim(&param->scale_, sizeof(float), custom_prim, i);
+    } else if (name == "max_pages") {
+      ret = GetDataFromPrim(&param->max_pages_, sizeof(int), custom_prim, i);
+    } else if (name == "cache_name") {
+      // Keep the last char as the terminator.
+      ret = GetDataFromPrim(param->cache_name_, sizeof(param->cache_name_) - 1, custom_prim, i);
+    }
+    if (!ret) {
+      MS_LOG(ERROR) << "Get " << name << " of KVCacheAttention from prim failed.";
+      free(param);
+      return nullptr;
+    }
+  }
+  return reinterpret_cast<OpParameter *>(param);
+}
+
 OpParameter *PopulateCustomParameter(const void *prim) {
   MS_CHECK_TRUE_RET(prim != nullptr, nullptr);
   auto primitive = static_cast<const schema::Primitive *>(prim);
@@ -97,6 +171,10 @@ OpParameter *PopulateCustomParameter(const void *prim) {
 
     param->op_parameter_.type_ = PrimType_Inner_SplitReduceConcatFusion;
     return reinterpret_cast<OpParameter *>(param);
+  } else if (type == "FlashAttention") {
+    return PopulateFlashAttentionParameter(value);
+  } else if (type == "KVCacheAttention") {
+    return PopulateKVCacheAttentionParameter(value);
   } else if (type == "EncoderLayer") {
     std::cout << "EncoderLayer populate" << std::endl;
     auto *param = reinterpret_cast<OpParameter *>(malloc(sizeof(OpParameter)));
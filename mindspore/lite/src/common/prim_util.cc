@@ -28,9 +28,10 @@ static std::set<schema::PrimitiveType> kTensorListOps = {
   schema::PrimitiveType_TensorListReserve, schema::PrimitiveType_TensorListSetItem,
   schema::PrimitiveType_TensorListStack};
 
-static const char *const kInnerOpNames[6] = {
-  "Inner_ToFormat",    "Inner_GltextureToOpencl", "Inner_Identity",
-  "Inner_ShapeFusion", "Inner_GraphKernel",       "Inner_SplitReduceConcatFusion",
+static const char *const kInnerOpNames[PrimType_InnerOpMax - PrimType_InnerOpMin] = {
+  "Inner_ToFormat",    "Inner_GltextureToOpencl",       "Inner_Identity",     "Inner_ShapeFusion",
+  "Inner_GraphKernel", "Inner_SplitReduceConcatFusion", "Inner_EncoderLayer", "Inner_FlashAttention",
+  "Inner_KVCacheAttention",
 };
 int GetPrimitiveType(const void *primitive, int schema_version) {
   if (primitive == nullptr) {
@@ -264,6 +264,11 @@ Status Model::Predict(const MSKernelCallBack &before, const MSKernelCallBack &af
   return kLiteNotSupport;
 }
 
+Status Model::ReleaseKVCacheSequence(int seq_id) {
+  MS_LOG(ERROR) << "Unsupported Feature.";
+  return kLiteNotSupport;
+}
+
 Status Model::PredictWithPreprocess(const std::vector<std::vector<MSTensor>> &inputs, std::vector<MSTensor> *outputs,
                                     const MSKernelCallBack &before, const MSKernelCallBack &after) {
   MS_LOG(ERROR) << "Unsupported Feature.";
@@ -359,6 +359,14 @@ Status Model::Predict(const MSKernelCallBack &before, const MSKernelCallBack &af
   return impl_->Predict(before, after);
 }
 
+Status Model::ReleaseKVCacheSequence(int seq_id) {
+  if (impl_ == nullptr) {
+    MS_LOG(ERROR) << "Model implement is null.";
+    return kLiteNullptr;
+  }
+  return impl_->ReleaseKVCacheSequence(seq_id);
+}
+
 Status Model::PredictWithPreprocess(const std::vector<std::vector<MSTensor>> &inputs, std::vector<MSTensor> *outputs,
                                     const MSKernelCallBack &before, const MSKernelCallBack &after) {
   MS_LOG(ERROR) << "Unsupported Feature.";
@@ -39,6 +39,7 @@
 #include "src/common/config_file.h"
 #include "src/litert/cpu_info.h"
 #include "src/litert/pack_weight_manager.h"
+#include "src/litert/kernel/cpu/base/kv_cache.h"
 namespace mindspore {
 namespace {
 const char *const kExecutionPlan = "execution_plan";
@@ -519,6 +520,17 @@ Status ModelImpl::Predict(const MSKernelCallBack &before, const MSKernelCallBack
   return kSuccess;
 }
 
+Status ModelImpl::ReleaseKVCacheSequence(int seq_id) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  if (session_ == nullptr) {
+    MS_LOG(ERROR) << "Model has not been called Build, or Model Build has failed";
+    return kLiteNullptr;
+  }
+  // The caches may be shared among the models by the cache name, so the sequence is dropped from all the caches.
+  kernel::KVCacheManager::GetInstance()->EraseSequence(seq_id);
+  return kSuccess;
+}
+
 std::vector<MSTensor> ModelImpl::GetInputs() {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   if (session_ == nullptr) {
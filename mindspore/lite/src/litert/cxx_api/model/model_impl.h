@@ -74,6 +74,8 @@ class ModelImpl {
 
   Status Predict(const MSKernelCallBack &before, const MSKernelCallBack &after);
 
+  Status ReleaseKVCacheSequence(int seq_id);
+
 #if defined(ENABLE_PRE_INFERENCE) && defined(__linux__) && !defined(Debug)
   // note that: BuildAndRun interface is used for pre-build and pre-inferenence in child process.
   Status BuildAndRun(const void *model_data, size_t data_size, ModelType model_type,
@@ -34,6 +34,7 @@
 #endif
 #include "include/lite_types.h"
 #include "src/litert/infer_manager.h"
+#include "src/litert/thread_num_tuner.h"
 
 namespace mindspore {
 class DeviceInfoContext;
@@ -132,6 +133,9 @@ struct MS_API InnerContext {
   bool float_mode = false; /**< convert full quant model to float model */
 
   bool device_and_pkg_support_fp16_ = false;
+  bool enable_bf16_ = false; /**< compute the fp32 matmul and conv1x1 in bf16, only set on the cpu of avx512 bf16 */
+  std::shared_ptr<ThreadNumTuner> thread_num_tuner_ = nullptr; /**< tune the thread num of the kernels by measuring */
+  bool enable_inter_op_parallel_ = false; /**< run the kernels of the independent branches of cpu subgraph at once */
   ThreadPool *thread_pool_ = nullptr;
   InferChecker infer_checker_{InferCheckerOutput};
   // key is the precursor tensor's pointer, value is the group of successors' pointer.
@@ -0,0 +1,226 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/inter_op_parallel_executor.h"
+#include <algorithm>
+#include <unordered_map>
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+namespace {
+// the operations worth one intra-op thread, a kernel of less operations runs with the kernels of other branches.
+constexpr int64_t kInterOpThreadCost = 1 << 18;
+
+int64_t KernelCost(const kernel::KernelExec *kernel) {
+  int64_t out_num = 0;
+  for (auto tensor : kernel->out_tensors()) {
+    out_num += std::max<int64_t>(tensor->ElementsNum(), 0);
+  }
+  auto type = kernel->type();
+  if ((type == schema::PrimitiveType_Conv2DFusion || type == schema::PrimitiveType_MatMulFusion ||
+       type == schema::PrimitiveType_FullConnection) &&
+      kernel->in_tensors().size() > 1 && !kernel->out_tensors().empty() &&
+      !kernel->out_tensors().front()->shape().empty()) {
+    // every output of the conv or matmul reduces weight_num / out_channel inputs.
+    int64_t out_channel = std::max(kernel->out_tensors().front()->shape().back(), 1);
+    int64_t depth = std::max<int64_t>(kernel->in_tensors()[1]->ElementsNum(), 0) / out_channel;
+    return out_num * std::max<int64_t>(depth, 1);
+  }
+  return out_num;
+}
+}  // namespace
+
+InterOpParallelExecutor::~InterOpParallelExecutor() {
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    exit_ = true;
+  }
+  ready_cond_.notify_all();
+  for (auto &thread : branch_threads_) {
+    thread.join();
+  }
+}
+
+int InterOpParallelExecutor::Prepare(const std::vector<kernel::KernelExec *> &kernels,
+                                     const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                                     lite::InnerContext *ctx) {
+  CHECK_NULL_RETURN(ctx);
+  ctx_ = ctx;
+  kernels_ = kernels;
+  thread_budget_ = std::max(ctx->thread_num_, 1);
+  std::unordered_map<Tensor *, size_t> producers;
+  for (size_t i = 0; i < kernels_.size(); i++) {
+    CHECK_NULL_RETURN(kernels_[i]);
+    for (auto tensor : kernels_[i]->out_tensors()) {
+      producers[tensor] = i;
+    }
+  }
+  successors_.assign(kernels_.size(), {});
+  in_degrees_.assign(kernels_.size(), 0);
+  for (size_t i = 0; i < kernels_.size(); i++) {
+    std::set<size_t> predecessors;
+    for (auto tensor : kernels_[i]->in_tensors()) {
+      auto iter = producers.find(tensor);
+      if (iter != producers.end() && iter->second != i) {
+        (void)predecessors.insert(iter->second);
+      }
+    }
+    for (auto predecessor : predecessors) {
+      successors_[predecessor].push_back(i);
+    }
+    in_degrees_[i] = predecessors.size();
+  }
+
+  // the width of the graph is the max kernel num of the same depth.
+  std::vector<size_t> depths(kernels_.size(), 0);
+  std::vector<size_t> pending = in_degrees_;
+  std::vector<size_t> queue;
+  for (size_t i = 0; i < kernels_.size(); i++) {
+    if (pending[i] == 0) {
+      queue.push_back(i);
+    }
+  }
+  std::unordered_map<size_t, size_t> depth_widths;
+  size_t width = 0;
+  for (size_t head = 0; head < queue.size(); head++) {
+    auto index = queue[head];
+    width = std::max(width, ++depth_widths[depths[index]]);
+    for (auto successor : successors_[index]) {
+      depths[successor] = std::max(depths[successor], depths[index] + 1);
+      if (--pending[successor] == 0) {
+        queue.push_back(successor);
+      }
+    }
+  }
+  if (queue.size() != kernels_.size()) {
+    MS_LOG(ERROR) << "The kernels have a cycle, inter-op parallel is not supported.";
+    return RET_ERROR;
+  }
+  branch_num_ = std::min(width, static_cast<size_t>(thread_budget_));
+  if (branch_num_ <= 1) {
+    MS_LOG(INFO) << "The kernels have no parallel branch, they run one by one.";
+    return RET_NOT_SUPPORT;
+  }
+  for (size_t i = 1; i < branch_num_; i++) {
+    branch_threads_.emplace_back(&InterOpParallelExecutor::BranchThreadLoop, this);
+  }
+  MS_LOG(INFO) << "Run " << kernels_.size() << " kernels in " << branch_num_ << " branches.";
+  return RET_OK;
+}
+
+void InterOpParallelExecutor::UpdateWeights() {
+  weights_.resize(kernels_.size());
+  for (size_t i = 0; i < kernels_.size(); i++) {
+    auto threads = UP_DIV(KernelCost(kernels_[i]), kInterOpThreadCost);
+    weights_[i] = static_cast<int>(std::min<int64_t>(std::max<int64_t>(threads, 1), thread_budget_));
+  }
+}
+
+int InterOpParallelExecutor::PopReadyKernel() {
+  for (auto index : ready_) {
+    if (running_weight_ == 0 || running_weight_ + weights_[index] <= thread_budget_) {
+      (void)ready_.erase(index);
+      return static_cast<int>(index);
+    }
+  }
+  return -1;
+}
+
+void InterOpParallelExecutor::RunKernels() {
+  std::unique_lock<std::mutex> l(mutex_);
+  while (status_ == RET_OK && remaining_ > 0) {
+    auto index = PopReadyKernel();
+    if (index < 0) {
+      ready_cond_.wait(l);
+      continue;
+    }
+    auto weight = weights_[index];
+    running_weight_ += weight;
+    l.unlock();
+    auto kernel = kernels_[index];
+    auto ret = kernel->Execute(nullptr, nullptr);
+    l.lock();
+    running_weight_ -= weight;
+    remaining_--;
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
+      status_ = ret;
+    }
+    for (auto successor : successors_[index]) {
+      if (--pending_[successor] == 0) {
+        (void)ready_.insert(successor);
+      }
+    }
+    ready_cond_.notify_all();
+  }
+}
+
+void InterOpParallelExecutor::BranchThreadLoop() {
+  size_t epoch = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> l(mutex_);
+      ready_cond_.wait(l, [this, epoch] { return exit_ || epoch_ != epoch; });
+      if (exit_) {
+        return;
+      }
+      epoch = epoch_;
+    }
+    RunKernels();
+    {
+      std::unique_lock<std::mutex> l(mutex_);
+      busy_branch_num_--;
+    }
+    done_cond_.notify_all();
+  }
+}
+
+int InterOpParallelExecutor::Run(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                                 const std::vector<kernel::KernelExec *> &kernels, const KernelCallBack &before,
+                                 const KernelCallBack &after) {
+  if (before != nullptr || after != nullptr || kernels != kernels_) {
+    for (auto *kernel : kernels) {
+      MS_ASSERT(kernel != nullptr);
+      auto ret = kernel->Execute(before, after);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
+        return ret;
+      }
+    }
+    return RET_OK;
+  }
+  UpdateWeights();
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    pending_ = in_degrees_;
+    ready_.clear();
+    for (size_t i = 0; i < kernels_.size(); i++) {
+      if (pending_[i] == 0) {
+        (void)ready_.insert(i);
+      }
+    }
+    remaining_ = kernels_.size();
+    running_weight_ = 0;
+    status_ = RET_OK;
+    busy_branch_num_ = branch_threads_.size();
+    epoch_++;
+  }
+  ready_cond_.notify_all();
+  RunKernels();
+  std::unique_lock<std::mutex> l(mutex_);
+  done_cond_.wait(l, [this] { return busy_branch_num_ == 0; });
+  return status_;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_INTER_OP_PARALLEL_EXECUTOR_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_INTER_OP_PARALLEL_EXECUTOR_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "src/litert/executor.h"
+
+namespace mindspore::lite {
+// InterOpParallelExecutor runs the kernels of a cpu subgraph in the order of their data dependency, the kernels in the
+// independent branches run at the same time on the branch threads. Every kernel is weighted by the threads its
+// computation is worth, a ready kernel is started only if the weight of the running kernels and it doesn't exceed the
+// thread num of the context, so the big kernels run alone with all the intra-op threads and the small kernels of
+// different branches share the cores.
+class InterOpParallelExecutor : public Executor {
+ public:
+  InterOpParallelExecutor() = default;
+  ~InterOpParallelExecutor() override;
+
+  // Build the dependency of the kernels, return RET_NOT_SUPPORT if the kernels are a chain without any branch.
+  int Prepare(const std::vector<kernel::KernelExec *> &kernels, const std::vector<Tensor *> &inputs,
+              const std::vector<Tensor *> &outputs, lite::InnerContext *ctx) override;
+
+  // The kernels must be the ones prepared. The callbacks are not thread-safe, so the kernels run one by one if any
+  // callback is set.
+  int Run(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+          const std::vector<kernel::KernelExec *> &kernels, const KernelCallBack &before = nullptr,
+          const KernelCallBack &after = nullptr) override;
+
+  size_t branch_num() const { return branch_num_; }
+
+ private:
+  void UpdateWeights();
+  // Pop a ready kernel whose weight fits, the lock is held. Return -1 if no kernel can be run now.
+  int PopReadyKernel();
+  void RunKernels();
+  void BranchThreadLoop();
+
+  std::vector<kernel::KernelExec *> kernels_;
+  std::vector<std::vector<size_t>> successors_;
+  std::vector<size_t> in_degrees_;
+  std::vector<int> weights_;
+  size_t branch_num_ = 1;
+  int thread_budget_ = 1;
+
+  // the state of one run, guarded by mutex_.
+  std::mutex mutex_;
+  std::condition_variable ready_cond_;
+  std::condition_variable done_cond_;
+  std::vector<size_t> pending_;
+  std::set<size_t> ready_;  // ordered by the index, so the kernels run close to the sequential order
+  size_t remaining_ = 0;
+  int running_weight_ = 0;
+  int status_ = RET_OK;
+  size_t busy_branch_num_ = 0;
+  size_t epoch_ = 0;
+  bool exit_ = false;
+  std::vector<std::thread> branch_threads_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_INTER_OP_PARALLEL_EXECUTOR_H_
@@ -26,6 +26,11 @@ using mindspore::lite::RET_OK;
 using mindspore::schema::ActivationType;
 
 namespace mindspore::kernel {
+namespace {
+// The same alignment as the tensors planned by the runtime allocator.
+constexpr size_t kRunBufferAlign = 64;
+}  // namespace
+
 void *ConvolutionBaseCPUKernel::MallocAlignedData(size_t alignment, size_t size) {
   MS_CHECK_TRUE_RET(size + alignment < MAX_MALLOC_SIZE, nullptr);
   auto ptr = malloc(size + alignment);
@@ -46,6 +51,36 @@ void ConvolutionBaseCPUKernel::FreeAlignedData(void **ptr) {
   }
 }
 
+size_t ConvolutionBaseCPUKernel::RunBufferSize(const std::vector<size_t> &sizes) {
+  size_t total_size = 0;
+  for (auto size : sizes) {
+    total_size += UP_ROUND(size, kRunBufferAlign);
+  }
+  return total_size;
+}
+
+void *ConvolutionBaseCPUKernel::MallocRunBuffer(size_t size) {
+  auto aligned_size = UP_ROUND(size, kRunBufferAlign);
+  if (!UseRunWorkspace() || run_buffer_offset_ + aligned_size > workspace_size()) {
+    return ctx_->allocator->Malloc(size);
+  }
+  auto buffer = reinterpret_cast<int8_t *>(workspace()) + run_buffer_offset_;
+  run_buffer_offset_ += aligned_size;
+  return buffer;
+}
+
+void ConvolutionBaseCPUKernel::FreeRunBuffer(void *buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  auto begin = reinterpret_cast<int8_t *>(workspace());
+  auto addr = reinterpret_cast<int8_t *>(buffer);
+  if (begin != nullptr && addr >= begin && addr < begin + workspace_size()) {
+    return;
+  }
+  ctx_->allocator->Free(buffer);
+}
+
 ConvolutionBaseCPUKernel::~ConvolutionBaseCPUKernel() {
   if (addr_map.find(reinterpret_cast<uintptr_t>(packed_weight_)) != addr_map.end()) {
     FreeAlignedData(reinterpret_cast<void **>(&packed_weight_));
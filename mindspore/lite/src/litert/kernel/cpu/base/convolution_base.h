@@ -79,6 +79,14 @@ class ConvolutionBaseCPUKernel : public LiteKernel {
 
   virtual int MallocWeightBiasData() { return RET_OK; }
   virtual void PackWeight() {}
+  // In inference, the per-run buffers are carved from the workspace planned by the session, and they fall back to the
+  // allocator of the context when there is no plan or the plan is outdated. The offset is reset before the buffers of
+  // a run are malloced.
+  static size_t RunBufferSize(const std::vector<size_t> &sizes);
+  bool UseRunWorkspace() const { return !op_parameter_->is_train_session_ && workspace() != nullptr; }
+  void *MallocRunBuffer(size_t size);
+  void FreeRunBuffer(void *buffer);
+  size_t run_buffer_offset_ = 0;
   bool IsRepack() const { return is_repack_; }
   std::unordered_map<uintptr_t, void *> addr_map;
   void *packed_weight_ = nullptr;
@@ -0,0 +1,244 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/kernel/cpu/base/kv_cache.h"
+#include <algorithm>
+#include <new>
+#include <utility>
+#include "src/common/log_adapter.h"
+#include "include/errorcode.h"
+#include "nnacl/op_base.h"
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+// The sequences not released by the user are evicted when the pages exceed the cap.
+constexpr size_t kDefaultCacheBytes = 1UL << 30;
+}  // namespace
+
+bool KVCacheBudget::Reserve(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (used_bytes_ + bytes > max_bytes_) {
+    return false;
+  }
+  used_bytes_ += bytes;
+  return true;
+}
+
+void KVCacheBudget::Free(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  used_bytes_ -= std::min(bytes, used_bytes_);
+}
+
+KVCache::KVCache(const KVCachePageShape &shape, size_t max_pages, std::shared_ptr<KVCacheBudget> budget)
+    : shape_(shape), max_pages_(max_pages), budget_(std::move(budget)) {
+  page_floats_ = static_cast<size_t>(shape.page_size) * shape.head_num * (shape.head_size + shape.v_head_size);
+  if (max_pages_ == 0) {
+    auto page_bytes = std::max(page_floats_ * sizeof(float), sizeof(float));
+    auto max_bytes = budget_ != nullptr ? budget_->max_bytes() : kDefaultCacheBytes;
+    max_pages_ = std::max(max_bytes / page_bytes, static_cast<size_t>(1));
+  } else {
+    // The explicit max_pages bounds the cache by itself.
+    budget_ = nullptr;
+  }
+}
+
+KVCache::~KVCache() {
+  if (budget_ != nullptr) {
+    budget_->Free(pages_.size() * page_floats_ * sizeof(float));
+  }
+}
+
+int KVCache::Acquire(const std::vector<int> &seq_ids, const std::vector<int> &past_lens, int new_tokens,
+                     std::vector<KVCacheSequence> *sequences) {
+  MS_CHECK_TRUE_RET(sequences != nullptr && seq_ids.size() == past_lens.size() && new_tokens >= 0, RET_ERROR);
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<int> pinned_ids;
+  std::vector<int> created_ids;
+  // Drop the pages reserved for the first grown_num sequences, and the sequences created by this call.
+  auto rollback = [this, &seq_ids, &past_lens, &pinned_ids, &created_ids](size_t grown_num) {
+    for (size_t i = 0; i < grown_num; ++i) {
+      auto &sequence = sequences_[seq_ids[i]];
+      ShrinkPages(&sequence, UP_DIV(past_lens[i], shape_.page_size));
+      sequence.length = past_lens[i];
+    }
+    for (auto seq_id : pinned_ids) {
+      sequences_[seq_id].pin_count--;
+    }
+    for (auto seq_id : created_ids) {
+      EraseSequence(sequences_.find(seq_id));
+    }
+  };
+  // Pin all the sequences first, so they are not evicted by the page allocation of each other.
+  for (size_t i = 0; i < seq_ids.size(); ++i) {
+    auto iter = sequences_.find(seq_ids[i]);
+    if (iter == sequences_.end()) {
+      if (past_lens[i] != 0) {
+        MS_LOG(ERROR) << "The sequence " << seq_ids[i] << " is not in the kv cache, it may have been evicted.";
+        rollback(0);
+        return RET_ERROR;
+      }
+      lru_.push_front(seq_ids[i]);
+      auto &sequence = sequences_[seq_ids[i]];
+      sequence.lru_iter = lru_.begin();
+      iter = sequences_.find(seq_ids[i]);
+      created_ids.push_back(seq_ids[i]);
+    } else {
+      if (iter->second.pin_count > 0 || past_lens[i] < 0 || past_lens[i] > iter->second.length) {
+        MS_LOG(ERROR) << "The sequence " << seq_ids[i] << " is in use or its past length " << past_lens[i]
+                      << " is invalid, the cached length is " << iter->second.length;
+        rollback(0);
+        return RET_ERROR;
+      }
+      lru_.splice(lru_.begin(), lru_, iter->second.lru_iter);
+    }
+    iter->second.pin_count++;
+    pinned_ids.push_back(seq_ids[i]);
+  }
+
+  sequences->resize(seq_ids.size());
+  for (size_t i = 0; i < seq_ids.size(); ++i) {
+    auto &sequence = sequences_[seq_ids[i]];
+    // The tokens after the past length are dropped, e.g. the sequence is restarted or rolled back.
+    ShrinkPages(&sequence, UP_DIV(past_lens[i], shape_.page_size));
+    size_t page_num = UP_DIV(past_lens[i] + new_tokens, shape_.page_size);
+    while (sequence.pages.size() < page_num) {
+      size_t page;
+      if (!AllocPage(&page)) {
+        MS_LOG(ERROR) << "The pages of kv cache are used up, max pages: " << max_pages_;
+        rollback(i + 1);
+        return RET_ERROR;
+      }
+      sequence.pages.push_back(page);
+    }
+    sequence.length = past_lens[i] + new_tokens;
+    auto &acquired = sequences->at(i);
+    acquired.past_len = past_lens[i];
+    acquired.pages.resize(page_num);
+    for (size_t p = 0; p < page_num; ++p) {
+      acquired.pages[p] = pages_[sequence.pages[p]].get();
+    }
+  }
+  return RET_OK;
+}
+
+void KVCache::Release(const std::vector<int> &seq_ids) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto seq_id : seq_ids) {
+    auto iter = sequences_.find(seq_id);
+    if (iter != sequences_.end() && iter->second.pin_count > 0) {
+      iter->second.pin_count--;
+    }
+  }
+}
+
+void KVCache::Erase(int seq_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = sequences_.find(seq_id);
+  if (iter == sequences_.end()) {
+    return;
+  }
+  if (iter->second.pin_count > 0) {
+    MS_LOG(WARNING) << "The sequence " << seq_id << " is in use and can't be erased.";
+    return;
+  }
+  EraseSequence(iter);
+}
+
+bool KVCache::AllocPage(size_t *page) {
+  if (!free_pages_.empty()) {
+    *page = free_pages_.back();
+    free_pages_.pop_back();
+    return true;
+  }
+  auto page_bytes = page_floats_ * sizeof(float);
+  if (pages_.size() < max_pages_ && (budget_ == nullptr || budget_->Reserve(page_bytes))) {
+    std::unique_ptr<float[]> buffer(new (std::nothrow) float[page_floats_]);
+    if (buffer == nullptr) {
+      if (budget_ != nullptr) {
+        budget_->Free(page_bytes);
+      }
+      return false;
+    }
+    pages_.push_back(std::move(buffer));
+    *page = pages_.size() - 1;
+    return true;
+  }
+  for (auto iter = lru_.rbegin(); iter != lru_.rend(); ++iter) {
+    auto seq_iter = sequences_.find(*iter);
+    if (seq_iter != sequences_.end() && seq_iter->second.pin_count == 0 && !seq_iter->second.pages.empty()) {
+      MS_LOG(INFO) << "Evict the sequence " << *iter << " from the kv cache.";
+      EraseSequence(seq_iter);
+      return AllocPage(page);
+    }
+  }
+  return false;
+}
+
+void KVCache::ShrinkPages(Sequence *sequence, size_t page_num) {
+  while (sequence->pages.size() > page_num) {
+    free_pages_.push_back(sequence->pages.back());
+    sequence->pages.pop_back();
+  }
+}
+
+void KVCache::EraseSequence(std::unordered_map<int, Sequence>::iterator iter) {
+  ShrinkPages(&iter->second, 0);
+  (void)lru_.erase(iter->second.lru_iter);
+  (void)sequences_.erase(iter);
+}
+
+KVCacheManager *KVCacheManager::GetInstance() {
+  static KVCacheManager instance;
+  return &instance;
+}
+
+std::shared_ptr<KVCache> KVCacheManager::GetCache(const std::string &model_name, const std::string &node_name,
+                                                  const KVCachePageShape &shape, size_t max_pages) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto name = model_name + "/" + node_name;
+  auto cache = caches_[name].lock();
+  if (cache != nullptr) {
+    if (!(cache->page_shape() == shape)) {
+      MS_LOG(ERROR) << "The kv cache " << name << " is shared by the kernels of different shapes.";
+      return nullptr;
+    }
+    return cache;
+  }
+  std::shared_ptr<KVCacheBudget> budget = nullptr;
+  if (max_pages == 0) {
+    budget = budgets_[model_name].lock();
+    if (budget == nullptr) {
+      budget = std::make_shared<KVCacheBudget>(kDefaultCacheBytes);
+      budgets_[model_name] = budget;
+    }
+  }
+  cache = std::make_shared<KVCache>(shape, max_pages, budget);
+  caches_[name] = cache;
+  return cache;
+}
+
+void KVCacheManager::EraseSequence(int seq_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &item : caches_) {
+    auto cache = item.second.lock();
+    if (cache != nullptr) {
+      cache->Erase(seq_id);
+    }
+  }
+}
+}  // namespace mindspore::kernel
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BASE_KV_CACHE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BASE_KV_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mindspore::kernel {
+// The geometry of the key and value of one token, one page holds the tokens of one sequence for all the heads.
+struct KVCachePageShape {
+  int page_size = 0;  // number of tokens of one page
+  int head_num = 0;
+  int head_size = 0;
+  int v_head_size = 0;
+
+  bool operator==(const KVCachePageShape &other) const {
+    return page_size == other.page_size && head_num == other.head_num && head_size == other.head_size &&
+           v_head_size == other.v_head_size;
+  }
+};
+
+// The pages of one sequence acquired for one step, which are valid until the sequence is released.
+struct KVCacheSequence {
+  int past_len = 0;  // the number of tokens cached before this step
+  std::vector<float *> pages;
+};
+
+// The memory budget shared by the caches of all the layers of one model.
+class KVCacheBudget {
+ public:
+  explicit KVCacheBudget(size_t max_bytes) : max_bytes_(max_bytes) {}
+  ~KVCacheBudget() = default;
+
+  bool Reserve(size_t bytes);
+  void Free(size_t bytes);
+  size_t max_bytes() const { return max_bytes_; }
+
+ private:
+  size_t max_bytes_ = 0;
+  size_t used_bytes_ = 0;
+  std::mutex mutex_;
+};
+
+// The key/value cache of the incremental decoding. The tokens of each sequence are stored in fixed size pages, which
+// are allocated when the sequence grows and recycled when the sequence is truncated, erased or evicted. The pages stay
+// resident across the Predict calls, so one step only computes the key/value of the new tokens.
+class KVCache {
+ public:
+  // The pages are bounded by max_pages, 0 to bound them by the budget, or by the default memory cap of the cache
+  // without the budget.
+  KVCache(const KVCachePageShape &shape, size_t max_pages, std::shared_ptr<KVCacheBudget> budget = nullptr);
+  ~KVCache();
+
+  // Keep the first past_lens[i] tokens of the sequence seq_ids[i] and reserve the pages for new_tokens more tokens.
+  // The sequence is created if it is not cached and its past_len is 0. The acquired sequences are pinned and never
+  // evicted until they are released. On failure, no sequence is pinned, created or grown.
+  int Acquire(const std::vector<int> &seq_ids, const std::vector<int> &past_lens, int new_tokens,
+              std::vector<KVCacheSequence> *sequences);
+  void Release(const std::vector<int> &seq_ids);
+  // Drop the finished sequence and recycle its pages.
+  void Erase(int seq_id);
+
+  const KVCachePageShape &page_shape() const { return shape_; }
+  size_t page_floats() const { return page_floats_; }
+  size_t max_pages() const { return max_pages_; }
+
+ private:
+  struct Sequence {
+    std::vector<size_t> pages;
+    int length = 0;
+    int pin_count = 0;
+    std::list<int>::iterator lru_iter;
+  };
+
+  // Get a free page, or allocate a new one within max_pages_, or evict the least recently used sequence.
+  bool AllocPage(size_t *page);
+  void ShrinkPages(Sequence *sequence, size_t page_num);
+  void EraseSequence(std::unordered_map<int, Sequence>::iterator iter);
+
+  KVCachePageShape shape_;
+  size_t page_floats_ = 0;
+  size_t max_pages_ = 0;
+  std::shared_ptr<KVCacheBudget> budget_;
+  std::vector<std::unique_ptr<float[]>> pages_;
+  std::vector<size_t> free_pages_;
+  std::unordered_map<int, Sequence> sequences_;
+  // The front is the most recently used sequence.
+  std::list<int> lru_;
+  std::mutex mutex_;
+};
+
+// The caches are keyed by the model and the node, so the workers of one ModelParallelRunner, which load the same model
+// by the same model name, serve the concurrent sequences of each layer from one page pool. The caches of one model
+// without max_pages share the default memory budget of the model.
+class KVCacheManager {
+ public:
+  static KVCacheManager *GetInstance();
+  ~KVCacheManager() = default;
+
+  // The cache is created by the first kernel and destroyed after all the kernels using it are released.
+  std::shared_ptr<KVCache> GetCache(const std::string &model_name, const std::string &node_name,
+                                    const KVCachePageShape &shape, size_t max_pages);
+  // Drop the sequence from all the caches after it is finished, which is called by Model::ReleaseKVCacheSequence.
+  void EraseSequence(int seq_id);
+
+ private:
+  KVCacheManager() = default;
+
+  std::unordered_map<std::string, std::weak_ptr<KVCache>> caches_;
+  std::unordered_map<std::string, std::weak_ptr<KVCacheBudget>> budgets_;
+  std::mutex mutex_;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_BASE_KV_CACHE_H_
@@ -25,6 +25,7 @@
 #include "src/litert/kernel/cpu/base/group_convolution_creator.h"
 #include "src/litert/kernel/cpu/fp32/group_convolution_fp32.h"
 #include "src/litert/kernel/cpu/fp32/convolution_sw_1x1_fp32.h"
+#include "src/litert/kernel/cpu/fp32/matmul_bf16_fp32.h"
 #include "nnacl/base/conv_common_base.h"
 #include "schema/model_generated.h"
 #include "include/errorcode.h"
@@ -233,7 +234,15 @@ bool ConvolutionDelegateCPUKernel::CheckAvxUseSWConv(const ConvParameter *conv_p
   return false;
 }
 
-kernel::LiteKernel *ConvolutionDelegateCPUKernel::CreateConv1x1MatmulKernel() {
+bool ConvolutionDelegateCPUKernel::CheckUseBf16Conv1x1(const ConvParameter *conv_param) {
+  auto ctx = static_cast<const lite::InnerContext *>(this->ms_context_);
+  if (ctx == nullptr || !ctx->enable_bf16_ || !weight_const_ || origin_weight_ == nullptr) {
+    return false;
+  }
+  return in_tensors_.at(kWeightIndex)->data_type() == kNumberTypeFloat32 && CheckAvxUseSW1x1Conv(conv_param);
+}
+
+kernel::LiteKernel *ConvolutionDelegateCPUKernel::CreateConv1x1MatmulKernel(bool use_bf16) {
   auto conv_param = reinterpret_cast<ConvParameter *>(op_parameter_);
 
   matmul_param_ = reinterpret_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
@@ -253,6 +262,13 @@ kernel::LiteKernel *ConvolutionDelegateCPUKernel::CreateConv1x1MatmulKernel() {
   matmul_param_->b_transpose_ = true;
   matmul_param_->a_const_ = input_const_;
   matmul_param_->b_const_ = weight_const_;
+#ifdef ENABLE_AVX512
+  if (use_bf16) {
+    return new (std::nothrow) kernel::MatmulBf16CPUKernel(
+      reinterpret_cast<OpParameter *>(matmul_param_), in_tensors_, out_tensors_,
+      static_cast<const lite::InnerContext *>(this->ms_context_), origin_weight_, origin_bias_);
+  }
+#endif
   auto kernel = new (std::nothrow) kernel::ConvolutionSW1x1CPUKernel(
     reinterpret_cast<OpParameter *>(matmul_param_), in_tensors_, out_tensors_,
     static_cast<const lite::InnerContext *>(this->ms_context_), origin_weight_, origin_bias_);
@@ -270,6 +286,12 @@ kernel::LiteKernel *ConvolutionDelegateCPUKernel::CpuConvFp32NHWCKernelSelect()
                                                 origin_weight_, origin_bias_);
   }
 
+#ifdef ENABLE_AVX512
+  if (kernel == nullptr && CheckUseBf16Conv1x1(conv_param)) {
+    kernel = CreateConv1x1MatmulKernel(true);
+  }
+#endif
+
 #ifdef ENABLE_AVX
   if (kernel == nullptr && CheckAvxUseSW1x1Conv(conv_param)) {
     kernel = CreateConv1x1MatmulKernel();
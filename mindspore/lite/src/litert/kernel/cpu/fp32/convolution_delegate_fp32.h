@@ -91,7 +91,8 @@ class ConvolutionDelegateCPUKernel : public LiteKernel {
   kernel::LiteKernel *CpuConvFp32KernelSelect();
   kernel::LiteKernel *CpuConvFp32NC4KernelSelect();
   kernel::LiteKernel *CpuConvFp32NHWCKernelSelect();
-  kernel::LiteKernel *CreateConv1x1MatmulKernel();
+  kernel::LiteKernel *CreateConv1x1MatmulKernel(bool use_bf16 = false);
+  bool CheckUseBf16Conv1x1(const ConvParameter *conv_param);
   bool CheckAvxUseSW1x1Conv(const ConvParameter *conv_param);
   bool CheckAvxUseSWConv(const ConvParameter *conv_param);
   // If inferShape process can't complete in Init part, initialization of weight and bis will be implemented in runtime
@@ -36,10 +36,7 @@ namespace mindspore::kernel {
 #else
 #define OC_BLOCK C8NUM
 #endif
-int ConvolutionCPUKernel::InitTmpBuffer() {
-  MS_ASSERT(ctx_->allocator != nullptr);
-  CHECK_NULL_RETURN(out_tensors_[0]);
-  CHECK_NULL_RETURN(out_tensors_[0]->MutableData());
+int ConvolutionCPUKernel::GetPackedInputUnitSize(int *unit_size) const {
   MS_CHECK_INT_MUL_NOT_OVERFLOW(conv_param_->kernel_h_, conv_param_->kernel_w_, RET_ERROR);
   int kernel_hw = conv_param_->kernel_h_ * conv_param_->kernel_w_;
   MS_CHECK_INT_MUL_NOT_OVERFLOW(kernel_hw, conv_param_->input_channel_, RET_ERROR);
@@ -48,21 +45,33 @@ int ConvolutionCPUKernel::InitTmpBuffer() {
   int total_kernel_chw = kernel_chw * thread_count_;
 #ifdef ENABLE_AVX
   MS_CHECK_INT_MUL_NOT_OVERFLOW(total_kernel_chw, C6NUM, RET_ERROR);
-  int unit_size = total_kernel_chw * C6NUM;
+  *unit_size = total_kernel_chw * C6NUM;
 #elif defined(ENABLE_SSE)
   MS_CHECK_INT_MUL_NOT_OVERFLOW(total_kernel_chw, C4NUM, RET_ERROR);
-  int unit_size = total_kernel_chw * C4NUM;
+  *unit_size = total_kernel_chw * C4NUM;
 #else
   MS_CHECK_INT_MUL_NOT_OVERFLOW(total_kernel_chw, C12NUM, RET_ERROR);
-  int unit_size = total_kernel_chw * C12NUM;
+  *unit_size = total_kernel_chw * C12NUM;
 #endif
-  packed_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(unit_size * sizeof(float)));
+  return RET_OK;
+}
+
+int ConvolutionCPUKernel::InitTmpBuffer() {
+  MS_ASSERT(ctx_->allocator != nullptr);
+  CHECK_NULL_RETURN(out_tensors_[0]);
+  CHECK_NULL_RETURN(out_tensors_[0]->MutableData());
+  int unit_size = 0;
+  if (GetPackedInputUnitSize(&unit_size) != RET_OK) {
+    return RET_ERROR;
+  }
+  run_buffer_offset_ = 0;
+  packed_input_ = reinterpret_cast<float *>(MallocRunBuffer(unit_size * sizeof(float)));
   if (packed_input_ == nullptr) {
     MS_LOG(ERROR) << "malloc packed input failed.";
     return RET_ERROR;
   }
 
-  col_major_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(unit_size * sizeof(float)));
+  col_major_input_ = reinterpret_cast<float *>(MallocRunBuffer(unit_size * sizeof(float)));
   if (col_major_input_ == nullptr) {
     MS_LOG(ERROR) << "malloc col_major_input_ failed.";
     return RET_ERROR;
@@ -159,6 +168,15 @@ int ConvolutionCPUKernel::ReSize() {
   if (UpdateThreadNumPass(TC_PTYPE(type_), 0, 0, 0) != RET_OK) {
     return RET_ERROR;
   }
+  if (!op_parameter_->is_train_session_) {
+    // The packed inputs are planned as the workspace in the runtime memory of the session if it's enabled.
+    int unit_size = 0;
+    if (GetPackedInputUnitSize(&unit_size) != RET_OK) {
+      return RET_ERROR;
+    }
+    size_t input_size = static_cast<size_t>(unit_size) * sizeof(float);
+    set_workspace_size(RunBufferSize({input_size, input_size}));
+  }
   return RET_OK;
 }
 
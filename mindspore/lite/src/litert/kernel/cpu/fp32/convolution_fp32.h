@@ -40,15 +40,12 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
  protected:
   int MallocWeightBiasData() override;
   void PackWeight() override;
+  int GetPackedInputUnitSize(int *unit_size) const;
   void FreeTmpBuffer() {
-    if (packed_input_ != nullptr) {
-      ctx_->allocator->Free(packed_input_);
-      packed_input_ = nullptr;
-    }
-    if (col_major_input_ != nullptr) {
-      ctx_->allocator->Free(col_major_input_);
-      col_major_input_ = nullptr;
-    }
+    FreeRunBuffer(packed_input_);
+    packed_input_ = nullptr;
+    FreeRunBuffer(col_major_input_);
+    col_major_input_ = nullptr;
     if (output_need_align_ && tmp_output_ != nullptr) {
       ctx_->allocator->Free(tmp_output_);
       tmp_output_ = nullptr;
@@ -34,32 +34,11 @@ int ConvolutionIm2ColAVXCPUKernel::InitTmpBuffer() {
   CHECK_NULL_RETURN(out_tensors_[0]);
   CHECK_NULL_RETURN(out_tensors_[0]->MutableData());
 
-  MS_CHECK_INT_MUL_NOT_OVERFLOW(conv_param_->kernel_h_, conv_param_->kernel_w_, RET_ERROR);
-  int kernel_hw = conv_param_->kernel_h_ * conv_param_->kernel_w_;
-  MS_CHECK_INT_MUL_NOT_OVERFLOW(kernel_hw, conv_param_->input_channel_, RET_ERROR);
-  int kernel_chw = kernel_hw * conv_param_->input_channel_;
-  MS_CHECK_INT_MUL_NOT_OVERFLOW(kernel_chw, thread_count_, RET_ERROR);
-  int total_kernel_chw = kernel_chw * thread_count_;
-  MS_CHECK_INT_MUL_NOT_OVERFLOW(total_kernel_chw, row_tile_, RET_ERROR);
-  int unit_size = total_kernel_chw * row_tile_;
-
-  if (packed_input_ != nullptr) {
-    ctx_->allocator->Free(packed_input_);
-    packed_input_ = nullptr;
-  }
-  packed_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(unit_size * sizeof(float)));
-  if (packed_input_ == nullptr) {
-    MS_LOG(ERROR) << "malloc packed input failed.";
+  int unit_size = 0;
+  if (GetPackedInputUnitSize(&unit_size) != RET_OK) {
     return RET_ERROR;
   }
-
-  if (col_major_input_ != nullptr) {
-    ctx_->allocator->Free(col_major_input_);
-    col_major_input_ = nullptr;
-  }
-  col_major_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(unit_size * sizeof(float)));
-  if (col_major_input_ == nullptr) {
-    MS_LOG(ERROR) << "malloc col_major_input_ failed.";
+  if (MallocPackedInput(unit_size) != RET_OK) {
     return RET_ERROR;
   }
 
@@ -38,11 +38,7 @@ void ConvolutionIm2ColBaseCPUKernel::InitGlobalVariable() {
   rowMajor2ColNMajorFunc = RowMajor2Col8Major;
 }
 
-int ConvolutionIm2ColBaseCPUKernel::InitTmpBuffer() {
-  MS_ASSERT(ctx_->allocator != nullptr);
-  CHECK_NULL_RETURN(out_tensors_[0]);
-  CHECK_NULL_RETURN(out_tensors_[0]->MutableData());
-
+int ConvolutionIm2ColBaseCPUKernel::GetPackedInputUnitSize(int *unit_size) const {
   MS_CHECK_INT_MUL_NOT_OVERFLOW(conv_param_->kernel_h_, conv_param_->kernel_w_, RET_ERROR);
   int kernel_hw = conv_param_->kernel_h_ * conv_param_->kernel_w_;
   MS_CHECK_INT_MUL_NOT_OVERFLOW(kernel_hw, conv_param_->input_channel_, RET_ERROR);
@@ -50,30 +46,43 @@ int ConvolutionIm2ColBaseCPUKernel::InitTmpBuffer() {
   MS_CHECK_INT_MUL_NOT_OVERFLOW(kernel_chw, thread_count_, RET_ERROR);
   int total_kernel_chw = kernel_chw * thread_count_;
   MS_CHECK_INT_MUL_NOT_OVERFLOW(total_kernel_chw, row_tile_, RET_ERROR);
-  int unit_size = total_kernel_chw * row_tile_;
-  if (packed_input_ != nullptr) {
-    ctx_->allocator->Free(packed_input_);
-    packed_input_ = nullptr;
-  }
-  packed_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(unit_size * sizeof(float)));
+  *unit_size = total_kernel_chw * row_tile_;
+  return RET_OK;
+}
+
+int ConvolutionIm2ColBaseCPUKernel::MallocPackedInput(int unit_size) {
+  run_buffer_offset_ = 0;
+  FreeRunBuffer(packed_input_);
+  packed_input_ = reinterpret_cast<float *>(MallocRunBuffer(unit_size * sizeof(float)));
   if (packed_input_ == nullptr) {
     MS_LOG(ERROR) << "malloc packed input failed.";
     return RET_ERROR;
   }
-
-  if (col_major_input_ != nullptr) {
-    ctx_->allocator->Free(col_major_input_);
-    col_major_input_ = nullptr;
+  if (!need_col_major_input_) {
+    return RET_OK;
   }
-  col_major_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(unit_size * sizeof(float)));
+
+  FreeRunBuffer(col_major_input_);
+  col_major_input_ = reinterpret_cast<float *>(MallocRunBuffer(unit_size * sizeof(float)));
   if (col_major_input_ == nullptr) {
     MS_LOG(ERROR) << "malloc col_major_input_ failed.";
     return RET_ERROR;
   }
-
   return RET_OK;
 }
 
+int ConvolutionIm2ColBaseCPUKernel::InitTmpBuffer() {
+  MS_ASSERT(ctx_->allocator != nullptr);
+  CHECK_NULL_RETURN(out_tensors_[0]);
+  CHECK_NULL_RETURN(out_tensors_[0]->MutableData());
+
+  int unit_size = 0;
+  if (GetPackedInputUnitSize(&unit_size) != RET_OK) {
+    return RET_ERROR;
+  }
+  return MallocPackedInput(unit_size);
+}
+
 int ConvolutionIm2ColBaseCPUKernel::Prepare() {
   CHECK_LESS_RETURN(in_tensors_.size(), C2NUM);
   CHECK_LESS_RETURN(out_tensors_.size(), 1);
@@ -131,6 +140,16 @@ int ConvolutionIm2ColBaseCPUKernel::ReSize() {
   if (UpdateThreadNumPass(TC_PTYPE(type_), 0, 0, 0) != RET_OK) {
     return RET_ERROR;
   }
+  if (!op_parameter_->is_train_session_) {
+    // The packed inputs are planned as the workspace in the runtime memory of the session if it's enabled.
+    int unit_size = 0;
+    if (GetPackedInputUnitSize(&unit_size) != RET_OK) {
+      return RET_ERROR;
+    }
+    size_t input_size = static_cast<size_t>(unit_size) * sizeof(float);
+    set_workspace_size(RunBufferSize(need_col_major_input_ ? std::vector<size_t>{input_size, input_size}
+                                                           : std::vector<size_t>{input_size}));
+  }
   return RET_OK;
 }
 
@@ -44,15 +44,13 @@ class ConvolutionIm2ColBaseCPUKernel : public ConvolutionBaseCPUKernel {
  protected:
   int MallocWeightBiasData() override;
   void PackWeight() override;
+  int GetPackedInputUnitSize(int *unit_size) const;
+  int MallocPackedInput(int unit_size);
   void FreeTmpBuffer() {
-    if (packed_input_ != nullptr) {
-      ctx_->allocator->Free(packed_input_);
-      packed_input_ = nullptr;
-    }
-    if (col_major_input_ != nullptr) {
-      ctx_->allocator->Free(col_major_input_);
-      col_major_input_ = nullptr;
-    }
+    FreeRunBuffer(packed_input_);
+    packed_input_ = nullptr;
+    FreeRunBuffer(col_major_input_);
+    col_major_input_ = nullptr;
     if (output_need_align_ && tmp_output_ != nullptr) {
       ctx_->allocator->Free(tmp_output_);
       tmp_output_ = nullptr;
@@ -67,6 +65,7 @@ class ConvolutionIm2ColBaseCPUKernel : public ConvolutionBaseCPUKernel {
   float *packed_input_ = nullptr;
   float *col_major_input_ = nullptr;
   bool output_need_align_ = false;
+  bool need_col_major_input_ = true;
 
   int oc_tile_ = C8NUM;    // oc tile is C8NUM in C
   int row_tile_ = C12NUM;  // oc tile is C12NUM in C
@@ -44,49 +44,59 @@ int ConvolutionWinogradBaseCPUKernel::WinogradFilterTransform(const float *weigh
                                  true);
 }
 
-int ConvolutionWinogradBaseCPUKernel::InitTmpBuffer() {
-  MS_ASSERT(ctx_->allocator != nullptr);
+int ConvolutionWinogradBaseCPUKernel::GetTmpBufferSizes(std::vector<size_t> *sizes) const {
   int input_plane = input_unit_ * input_unit_;
   MS_CHECK_INT_MUL_NOT_OVERFLOW(thread_count_, input_plane, RET_ERROR);
   int thread_input_plane = thread_count_ * input_plane;
   MS_CHECK_INT_MUL_NOT_OVERFLOW(tile_num_, thread_input_plane, RET_ERROR);
   int total_thread_input_plane = tile_num_ * thread_input_plane;
   MS_CHECK_INT_MUL_NOT_OVERFLOW(total_thread_input_plane, conv_param_->input_channel_, RET_ERROR);
-  size_t tile_buffer_size = static_cast<size_t>(total_thread_input_plane * conv_param_->input_channel_) * sizeof(float);
-  trans_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(tile_buffer_size));
+  int oc8 = UP_ROUND(conv_param_->output_channel_, C8NUM);
+  MS_CHECK_INT_MUL_NOT_OVERFLOW(total_thread_input_plane, oc8, RET_ERROR);
+  MS_CHECK_INT_MUL_NOT_OVERFLOW(tmp_data_tile_, thread_input_plane, RET_ERROR);
+  auto tile = UP_ROUND(conv_param_->input_channel_, tmp_data_tile_);
+  MS_CHECK_INT_MUL_NOT_OVERFLOW(total_thread_input_plane, tile, RET_ERROR);
+  // The sizes of trans_input_, gemm_out_, tmp_data_, col_buffer_ and opt_input_trans_ in order.
+  *sizes = {static_cast<size_t>(total_thread_input_plane * conv_param_->input_channel_) * sizeof(float),
+            static_cast<size_t>(total_thread_input_plane * oc8) * sizeof(float),
+            static_cast<size_t>(tmp_data_tile_ * thread_input_plane) * sizeof(float),
+            static_cast<size_t>(thread_count_ * tile_num_ * conv_param_->input_channel_) * sizeof(float),
+            static_cast<size_t>(total_thread_input_plane * tile) * sizeof(float)};
+  return RET_OK;
+}
+
+int ConvolutionWinogradBaseCPUKernel::InitTmpBuffer() {
+  MS_ASSERT(ctx_->allocator != nullptr);
+  std::vector<size_t> sizes;
+  if (GetTmpBufferSizes(&sizes) != RET_OK) {
+    return RET_ERROR;
+  }
+  run_buffer_offset_ = 0;
+  trans_input_ = reinterpret_cast<float *>(MallocRunBuffer(sizes[C0NUM]));
   if (trans_input_ == nullptr) {
     MS_LOG(ERROR) << "malloc trans_input_ failed.";
     return RET_MEMORY_FAILED;
   }
 
-  int oc8 = UP_ROUND(conv_param_->output_channel_, C8NUM);
-  MS_CHECK_INT_MUL_NOT_OVERFLOW(total_thread_input_plane, oc8, RET_ERROR);
-  gemm_out_ = reinterpret_cast<float *>(
-    ctx_->allocator->Malloc(static_cast<size_t>(total_thread_input_plane * oc8) * sizeof(float)));
+  gemm_out_ = reinterpret_cast<float *>(MallocRunBuffer(sizes[C1NUM]));
   if (gemm_out_ == nullptr) {
     MS_LOG(ERROR) << "malloc gemm_out_ failed.";
     return RET_ERROR;
   }
 
-  MS_CHECK_INT_MUL_NOT_OVERFLOW(tmp_data_tile_, thread_input_plane, RET_ERROR);
-  tmp_data_ = reinterpret_cast<float *>(
-    ctx_->allocator->Malloc(static_cast<size_t>(tmp_data_tile_ * thread_input_plane) * sizeof(float)));
+  tmp_data_ = reinterpret_cast<float *>(MallocRunBuffer(sizes[C2NUM]));
   if (tmp_data_ == nullptr) {
     MS_LOG(ERROR) << "malloc tmp_data_ failed.";
     return RET_MEMORY_FAILED;
   }
 
-  col_buffer_ = reinterpret_cast<float *>(
-    ctx_->allocator->Malloc(thread_count_ * tile_num_ * conv_param_->input_channel_ * sizeof(float)));
+  col_buffer_ = reinterpret_cast<float *>(MallocRunBuffer(sizes[C3NUM]));
   if (col_buffer_ == nullptr) {
     MS_LOG(ERROR) << "malloc col_buffer_ failed.";
     return RET_ERROR;
   }
 
-  auto tile = UP_ROUND(conv_param_->input_channel_, tmp_data_tile_);
-  MS_CHECK_INT_MUL_NOT_OVERFLOW(total_thread_input_plane, tile, RET_ERROR);
-  opt_input_trans_ = reinterpret_cast<float *>(
-    ctx_->allocator->Malloc(static_cast<size_t>(total_thread_input_plane * tile) * sizeof(float)));
+  opt_input_trans_ = reinterpret_cast<float *>(MallocRunBuffer(sizes[C4NUM]));
   if (opt_input_trans_ == nullptr) {
     MS_LOG(ERROR) << "malloc opt_input_trans_ failed.";
     return RET_ERROR;
@@ -185,6 +195,14 @@ int ConvolutionWinogradBaseCPUKernel::ReSize() {
     return RET_ERROR;
   }
   conv_param_->out_format_ = out_tensors_[0]->format();
+  if (!op_parameter_->is_train_session_) {
+    // The tmp buffers are planned as the workspace in the runtime memory of the session if it's enabled.
+    std::vector<size_t> sizes;
+    if (GetTmpBufferSizes(&sizes) != RET_OK) {
+      return RET_ERROR;
+    }
+    set_workspace_size(RunBufferSize(sizes));
+  }
   return RET_OK;
 }
 
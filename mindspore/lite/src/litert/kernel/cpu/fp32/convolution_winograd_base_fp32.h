@@ -40,6 +40,7 @@ class ConvolutionWinogradBaseCPUKernel : public ConvolutionBaseCPUKernel {
   int Run() override;
   int RunImpl(int task_id);
   int InitTmpBuffer();
+  int GetTmpBufferSizes(std::vector<size_t> *sizes) const;
   virtual int ConfigInputOutput();
   int WinogradFilterTransform(const float *weight_data, float *matrix_g, const float *matrix_gt, int oc_block);
 
@@ -51,26 +52,16 @@ class ConvolutionWinogradBaseCPUKernel : public ConvolutionBaseCPUKernel {
   int MallocWeightBiasData() override;
   void PackWeight() override;
   void FreeTmpBuffer() {
-    if (trans_input_ != nullptr) {
-      ctx_->allocator->Free(trans_input_);
-      trans_input_ = nullptr;
-    }
-    if (tmp_data_ != nullptr) {
-      ctx_->allocator->Free(tmp_data_);
-      tmp_data_ = nullptr;
-    }
-    if (gemm_out_ != nullptr) {
-      ctx_->allocator->Free(gemm_out_);
-      gemm_out_ = nullptr;
-    }
-    if (col_buffer_ != nullptr) {
-      ctx_->allocator->Free(col_buffer_);
-      col_buffer_ = nullptr;
-    }
-    if (opt_input_trans_ != nullptr) {
-      ctx_->allocator->Free(opt_input_trans_);
-      opt_input_trans_ = nullptr;
-    }
+    FreeRunBuffer(trans_input_);
+    trans_input_ = nullptr;
+    FreeRunBuffer(tmp_data_);
+    tmp_data_ = nullptr;
+    FreeRunBuffer(gemm_out_);
+    gemm_out_ = nullptr;
+    FreeRunBuffer(col_buffer_);
+    col_buffer_ = nullptr;
+    FreeRunBuffer(opt_input_trans_);
+    opt_input_trans_ = nullptr;
   }
 
  protected:
@@ -0,0 +1,202 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/kernel/cpu/fp32/flash_attention_fp32.h"
+#include <algorithm>
+#include "nnacl/fp32/flash_attention_fp32.h"
+#include "src/litert/kernel_registry.h"
+#include "include/errorcode.h"
+
+using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+constexpr size_t kFlashAttentionMinInputNum = 3;
+constexpr size_t kQueryIndex = 0;
+constexpr size_t kKeyIndex = 1;
+constexpr size_t kValueIndex = 2;
+constexpr size_t kMaskIndex = 3;
+constexpr size_t kMatrixDims = 2;
+}  // namespace
+
+int FlashAttentionCPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), kFlashAttentionMinInputNum);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  CHECK_NULL_RETURN(param_);
+  for (auto in_tensor : in_tensors_) {
+    CHECK_NULL_RETURN(in_tensor);
+    if (in_tensor->data_type() != kNumberTypeFloat32) {
+      MS_LOG(ERROR) << "FlashAttention only supports float32 inputs, but got " << in_tensor->data_type();
+      return RET_ERROR;
+    }
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int FlashAttentionCPUKernel::CheckInputShapes() {
+  auto q_shape = in_tensors_[kQueryIndex]->shape();
+  auto k_shape = in_tensors_[kKeyIndex]->shape();
+  auto v_shape = in_tensors_[kValueIndex]->shape();
+  auto rank = q_shape.size();
+  if (rank < kMatrixDims || k_shape.size() != rank || v_shape.size() != rank) {
+    MS_LOG(ERROR) << "The ranks of query, key and value should be same and not less than 2.";
+    return RET_ERROR;
+  }
+  param_->batch_ = 1;
+  for (size_t i = 0; i < rank - kMatrixDims; ++i) {
+    if (k_shape[i] != q_shape[i] || v_shape[i] != q_shape[i]) {
+      MS_LOG(ERROR) << "The batch dims of query, key and value should be same.";
+      return RET_ERROR;
+    }
+    param_->batch_ *= q_shape[i];
+  }
+  param_->q_seq_ = q_shape[rank - kMatrixDims];
+  param_->head_size_ = q_shape[rank - 1];
+  param_->k_seq_ = param_->key_transpose_ ? k_shape[rank - 1] : k_shape[rank - kMatrixDims];
+  auto k_head_size = param_->key_transpose_ ? k_shape[rank - kMatrixDims] : k_shape[rank - 1];
+  param_->v_head_size_ = v_shape[rank - 1];
+  if (k_head_size != param_->head_size_ || v_shape[rank - kMatrixDims] != param_->k_seq_) {
+    MS_LOG(ERROR) << "The shapes of query, key and value mismatch.";
+    return RET_ERROR;
+  }
+  MS_CHECK_TRUE_RET(param_->batch_ > 0 && param_->q_seq_ > 0 && param_->k_seq_ > 0 && param_->head_size_ > 0 &&
+                      param_->v_head_size_ > 0,
+                    RET_ERROR);
+  return RET_OK;
+}
+
+int FlashAttentionCPUKernel::InitMaskOffsets() {
+  mask_batch_offsets_.clear();
+  if (in_tensors_.size() <= kMaskIndex) {
+    return RET_OK;
+  }
+  // The mask is broadcast to [batch dims..., q_seq, k_seq] from the right.
+  auto q_shape = in_tensors_[kQueryIndex]->shape();
+  auto mask_shape = in_tensors_[kMaskIndex]->shape();
+  auto rank = q_shape.size();
+  if (mask_shape.empty() || mask_shape.size() > rank || mask_shape.back() != param_->k_seq_) {
+    MS_LOG(ERROR) << "The last dim of mask should be equal to the sequence length of key.";
+    return RET_ERROR;
+  }
+  mask_shape.insert(mask_shape.begin(), rank - mask_shape.size(), 1);
+  auto mask_rows = mask_shape[rank - kMatrixDims];
+  if (mask_rows != 1 && mask_rows != param_->q_seq_) {
+    MS_LOG(ERROR) << "The mask can't be broadcast to the logits of attention.";
+    return RET_ERROR;
+  }
+  param_->mask_row_stride_ = mask_rows == 1 ? 0 : param_->k_seq_;
+
+  std::vector<int> strides(rank - kMatrixDims, 0);
+  int stride = mask_rows * param_->k_seq_;
+  for (int i = static_cast<int>(rank - kMatrixDims) - 1; i >= 0; --i) {
+    if (mask_shape[i] != 1 && mask_shape[i] != q_shape[i]) {
+      MS_LOG(ERROR) << "The mask can't be broadcast to the logits of attention.";
+      return RET_ERROR;
+    }
+    strides[i] = mask_shape[i] == 1 ? 0 : stride;
+    stride *= mask_shape[i];
+  }
+  mask_batch_offsets_.resize(param_->batch_, 0);
+  for (int b = 0; b < param_->batch_; ++b) {
+    int index = b;
+    for (int i = static_cast<int>(rank - kMatrixDims) - 1; i >= 0; --i) {
+      mask_batch_offsets_[b] += (index % q_shape[i]) * strides[i];
+      index /= q_shape[i];
+    }
+  }
+  return RET_OK;
+}
+
+int FlashAttentionCPUKernel::ReSize() {
+  auto ret = CheckInputShapes();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = InitMaskOffsets();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  row_block_num_ = UP_DIV(param_->q_seq_, FLASH_ATTENTION_ROW_BLOCK);
+  thread_num_ = MSMIN(op_parameter_->thread_num_, param_->batch_ * row_block_num_);
+  workspace_size_ = FlashAttentionWorkspaceSize(param_);
+  return RET_OK;
+}
+
+int FlashAttentionCPUKernel::DoAttention(int task_id) {
+  auto q = reinterpret_cast<const float *>(in_tensors_[kQueryIndex]->data());
+  auto k = reinterpret_cast<const float *>(in_tensors_[kKeyIndex]->data());
+  auto v = reinterpret_cast<const float *>(in_tensors_[kValueIndex]->data());
+  auto out = reinterpret_cast<float *>(out_tensors_.front()->data());
+  CHECK_NULL_RETURN(q);
+  CHECK_NULL_RETURN(k);
+  CHECK_NULL_RETURN(v);
+  CHECK_NULL_RETURN(out);
+  const float *mask = nullptr;
+  if (!mask_batch_offsets_.empty()) {
+    mask = reinterpret_cast<const float *>(in_tensors_[kMaskIndex]->data());
+    CHECK_NULL_RETURN(mask);
+  }
+  float *workspace = workspace_ + task_id * workspace_size_;
+  int q_seq = param_->q_seq_;
+  int k_seq = param_->k_seq_;
+  // The row blocks are dealt to the tasks in turn, so the causal rows of different lengths are balanced.
+  for (int unit = task_id; unit < param_->batch_ * row_block_num_; unit += thread_num_) {
+    int b = unit / row_block_num_;
+    int row_start = (unit % row_block_num_) * FLASH_ATTENTION_ROW_BLOCK;
+    int row_end = MSMIN(row_start + FLASH_ATTENTION_ROW_BLOCK, q_seq);
+    const float *mask_batch = mask == nullptr ? nullptr : mask + mask_batch_offsets_[b];
+    FlashAttention(q + b * q_seq * param_->head_size_, k + b * k_seq * param_->head_size_,
+                   v + b * k_seq * param_->v_head_size_, mask_batch, out + b * q_seq * param_->v_head_size_, workspace,
+                   param_, row_start, row_end);
+  }
+  return RET_OK;
+}
+
+int FlashAttentionRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<FlashAttentionCPUKernel *>(cdata);
+  auto ret = kernel->DoAttention(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "FlashAttention error task_id[" << task_id << "] error_code[" << ret << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int FlashAttentionCPUKernel::Run() {
+  CHECK_NULL_RETURN(ms_context_->allocator);
+  workspace_ = reinterpret_cast<float *>(
+    ms_context_->allocator->Malloc(static_cast<size_t>(thread_num_) * workspace_size_ * sizeof(float)));
+  if (workspace_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc workspace of FlashAttention failed.";
+    return RET_ERROR;
+  }
+  auto ret = ParallelLaunch(this->ms_context_, FlashAttentionRun, this, thread_num_);
+  ms_context_->allocator->Free(workspace_);
+  workspace_ = nullptr;
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "FlashAttention run failed, ret: " << ret;
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimType_Inner_FlashAttention, LiteKernelCreator<FlashAttentionCPUKernel>)
+}  // namespace mindspore::kernel
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_FLASH_ATTENTION_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_FLASH_ATTENTION_FP32_H_
+
+#include <vector>
+#include "src/litert/lite_kernel.h"
+#include "nnacl/attention_parameter.h"
+
+namespace mindspore::kernel {
+// The fused attention of softmax(scale * query * key^T + mask) * value, the inputs are query, key, value and the
+// optional additive mask which is broadcast to [batch, q_seq, k_seq].
+class FlashAttentionCPUKernel : public LiteKernel {
+ public:
+  FlashAttentionCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                          const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    param_ = reinterpret_cast<FlashAttentionParameter *>(op_parameter_);
+  }
+  ~FlashAttentionCPUKernel() override = default;
+
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+  int DoAttention(int task_id);
+
+ private:
+  int CheckInputShapes();
+  int InitMaskOffsets();
+
+  FlashAttentionParameter *param_ = nullptr;
+  int row_block_num_ = 0;
+  int workspace_size_ = 0;
+  float *workspace_ = nullptr;
+  // The offset of the mask of each batch, the broadcast dims of mask have zero stride.
+  std::vector<int> mask_batch_offsets_;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_FLASH_ATTENTION_FP32_H_
@@ -15,6 +15,11 @@
  */
 
 #include "src/litert/kernel/cpu/fp32/fullconnection_fp32.h"
+#include "src/litert/kernel/cpu/fp32/matmul_weight_quant_fp32.h"
+#include "src/litert/kernel/cpu/fp32/matmul_bf16_fp32.h"
+#ifdef ENABLE_SPARSE_COMPUTE
+#include "src/litert/kernel/cpu/fp32_sparse/matmul_compressed_sparse_fp32.h"
+#endif
 #include "src/litert/kernel_registry.h"
 
 using mindspore::kernel::KERNEL_ARCH;
@@ -43,5 +48,24 @@ int FullconnectionCPUKernel::Run() {
   return matmul_base_->Run();
 }
 
-REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_FullConnection, LiteKernelCreator<FullconnectionCPUKernel>)
+LiteKernel *FullconnectionFp32CPUKernelCreator(const std::vector<lite::Tensor *> &inputs,
+                                               const std::vector<lite::Tensor *> &outputs, OpParameter *parameter,
+                                               const lite::InnerContext *ctx, const kernel::KernelKey &desc) {
+  if (IsWeightQuantMatmul(inputs)) {
+    return LiteKernelCreator<MatmulWeightQuantCPUKernel>(inputs, outputs, parameter, ctx, desc);
+  }
+#ifdef ENABLE_AVX512
+  if (IsBf16Matmul(inputs, parameter, ctx)) {
+    return LiteKernelCreator<MatmulBf16CPUKernel>(inputs, outputs, parameter, ctx, desc);
+  }
+#endif
+#ifdef ENABLE_SPARSE_COMPUTE
+  if (IsSparseMatmul(inputs, parameter)) {
+    return LiteKernelCreator<MatmulCompressedSparseCPUKernel>(inputs, outputs, parameter, ctx, desc);
+  }
+#endif
+  return LiteKernelCreator<FullconnectionCPUKernel>(inputs, outputs, parameter, ctx, desc);
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_FullConnection, FullconnectionFp32CPUKernelCreator)
 }  // namespace mindspore::kernel
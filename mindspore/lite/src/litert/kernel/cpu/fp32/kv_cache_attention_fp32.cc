@@ -0,0 +1,237 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/kernel/cpu/fp32/kv_cache_attention_fp32.h"
+#include <cstdint>
+#include <string>
+#include "nnacl/fp32/flash_attention_fp32.h"
+#include "src/litert/kernel_registry.h"
+#include "include/errorcode.h"
+
+using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+constexpr size_t kKVCacheAttentionInputNum = 5;
+constexpr size_t kQueryIndex = 0;
+constexpr size_t kKeyIndex = 1;
+constexpr size_t kValueIndex = 2;
+constexpr size_t kSeqIdsIndex = 3;
+constexpr size_t kPastLensIndex = 4;
+constexpr size_t kMinRank = 3;
+constexpr size_t kMatrixDims = 2;
+}  // namespace
+
+int KVCacheAttentionCPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), kKVCacheAttentionInputNum);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  CHECK_NULL_RETURN(param_);
+  for (size_t i = 0; i < kKVCacheAttentionInputNum; ++i) {
+    CHECK_NULL_RETURN(in_tensors_[i]);
+    auto expect_type = i < kSeqIdsIndex ? kNumberTypeFloat32 : kNumberTypeInt32;
+    if (in_tensors_[i]->data_type() != expect_type) {
+      MS_LOG(ERROR) << "The data type of input " << i << " of KVCacheAttention should be " << expect_type << ", but got "
+                    << in_tensors_[i]->data_type();
+      return RET_ERROR;
+    }
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int KVCacheAttentionCPUKernel::CheckInputShapes() {
+  auto q_shape = in_tensors_[kQueryIndex]->shape();
+  auto v_shape = in_tensors_[kValueIndex]->shape();
+  auto rank = q_shape.size();
+  if (rank < kMinRank || in_tensors_[kKeyIndex]->shape() != q_shape || v_shape.size() != rank) {
+    MS_LOG(ERROR) << "The query and key should be in the same shape whose rank is not less than 3.";
+    return RET_ERROR;
+  }
+  seq_num_ = q_shape.front();
+  page_shape_.page_size = FLASH_ATTENTION_COL_BLOCK;
+  page_shape_.head_num = 1;
+  for (size_t i = 0; i < rank - 1; ++i) {
+    if (v_shape[i] != q_shape[i]) {
+      MS_LOG(ERROR) << "The value should be in the same shape as the query except the last dim.";
+      return RET_ERROR;
+    }
+    if (i > 0 && i < rank - kMatrixDims) {
+      page_shape_.head_num *= q_shape[i];
+    }
+  }
+  q_seq_ = q_shape[rank - kMatrixDims];
+  page_shape_.head_size = q_shape[rank - 1];
+  page_shape_.v_head_size = v_shape[rank - 1];
+  MS_CHECK_TRUE_RET(seq_num_ > 0 && page_shape_.head_num > 0 && q_seq_ > 0 && page_shape_.head_size > 0 &&
+                      page_shape_.v_head_size > 0,
+                    RET_ERROR);
+  if (in_tensors_[kSeqIdsIndex]->ElementsNum() != seq_num_ || in_tensors_[kPastLensIndex]->ElementsNum() != seq_num_) {
+    MS_LOG(ERROR) << "The numbers of the sequence ids and past lengths should be equal to the number of sequences.";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int KVCacheAttentionCPUKernel::ReSize() {
+  auto ret = CheckInputShapes();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  row_block_num_ = UP_DIV(q_seq_, FLASH_ATTENTION_ROW_BLOCK);
+  FlashAttentionParameter attention_param = {};
+  attention_param.head_size_ = page_shape_.head_size;
+  attention_param.v_head_size_ = page_shape_.v_head_size;
+  workspace_size_ = FlashAttentionWorkspaceSize(&attention_param);
+  return RET_OK;
+}
+
+void KVCacheAttentionCPUKernel::InitPageTables() {
+  int head_num = page_shape_.head_num;
+  size_t page_size = static_cast<size_t>(page_shape_.page_size);
+  // One page holds the keys of all the heads in [head_num, head_size, page_size] and then the values of all the heads
+  // in [head_num, page_size, v_head_size].
+  size_t k_head_floats = static_cast<size_t>(page_shape_.head_size) * page_size;
+  size_t v_head_floats = static_cast<size_t>(page_shape_.v_head_size) * page_size;
+  page_offsets_.resize(seq_num_ * head_num);
+  k_pages_.clear();
+  v_pages_.clear();
+  for (int s = 0; s < seq_num_; ++s) {
+    for (int h = 0; h < head_num; ++h) {
+      page_offsets_[s * head_num + h] = k_pages_.size();
+      for (auto page : sequences_[s].pages) {
+        k_pages_.push_back(page + h * k_head_floats);
+        v_pages_.push_back(page + head_num * k_head_floats + h * v_head_floats);
+      }
+    }
+  }
+}
+
+int KVCacheAttentionCPUKernel::DoAppend(int task_id) {
+  auto k = reinterpret_cast<const float *>(in_tensors_[kKeyIndex]->data());
+  auto v = reinterpret_cast<const float *>(in_tensors_[kValueIndex]->data());
+  CHECK_NULL_RETURN(k);
+  CHECK_NULL_RETURN(v);
+  int head_size = page_shape_.head_size;
+  int v_head_size = page_shape_.v_head_size;
+  for (int b = task_id; b < seq_num_ * page_shape_.head_num; b += thread_num_) {
+    int s = b / page_shape_.head_num;
+    FlashAttentionAppendKV(k + b * q_seq_ * head_size, v + b * q_seq_ * v_head_size, &k_pages_[page_offsets_[b]],
+                           &v_pages_[page_offsets_[b]], sequences_[s].past_len, q_seq_, head_size, v_head_size);
+  }
+  return RET_OK;
+}
+
+int KVCacheAttentionCPUKernel::DoAttention(int task_id) {
+  auto q = reinterpret_cast<const float *>(in_tensors_[kQueryIndex]->data());
+  auto out = reinterpret_cast<float *>(out_tensors_.front()->data());
+  CHECK_NULL_RETURN(q);
+  CHECK_NULL_RETURN(out);
+  float *workspace = workspace_ + task_id * workspace_size_;
+  FlashAttentionParameter attention_param = {};
+  attention_param.scale_ = param_->scale_;
+  attention_param.causal_ = true;
+  attention_param.batch_ = 1;
+  attention_param.q_seq_ = q_seq_;
+  attention_param.head_size_ = page_shape_.head_size;
+  attention_param.v_head_size_ = page_shape_.v_head_size;
+  for (int unit = task_id; unit < seq_num_ * page_shape_.head_num * row_block_num_; unit += thread_num_) {
+    int b = unit / row_block_num_;
+    int row_start = (unit % row_block_num_) * FLASH_ATTENTION_ROW_BLOCK;
+    int row_end = MSMIN(row_start + FLASH_ATTENTION_ROW_BLOCK, q_seq_);
+    // The new tokens attend to all the cached tokens and the new tokens before them.
+    attention_param.k_seq_ = sequences_[b / page_shape_.head_num].past_len + q_seq_;
+    FlashAttentionPaged(q + b * q_seq_ * page_shape_.head_size, &k_pages_[page_offsets_[b]],
+                        &v_pages_[page_offsets_[b]], out + b * q_seq_ * page_shape_.v_head_size, workspace,
+                        &attention_param, row_start, row_end);
+  }
+  return RET_OK;
+}
+
+int KVCacheAppendRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<KVCacheAttentionCPUKernel *>(cdata);
+  auto ret = kernel->DoAppend(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "KVCacheAppend error task_id[" << task_id << "] error_code[" << ret << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int KVCacheAttentionRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<KVCacheAttentionCPUKernel *>(cdata);
+  auto ret = kernel->DoAttention(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "KVCacheAttention error task_id[" << task_id << "] error_code[" << ret << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int KVCacheAttentionCPUKernel::Run() {
+  CHECK_NULL_RETURN(ms_context_->allocator);
+  auto seq_ids = reinterpret_cast<const int *>(in_tensors_[kSeqIdsIndex]->data());
+  auto past_lens = reinterpret_cast<const int *>(in_tensors_[kPastLensIndex]->data());
+  CHECK_NULL_RETURN(seq_ids);
+  CHECK_NULL_RETURN(past_lens);
+  // The cache is bound at the first run when the kernel has been named. Without the cache name, the cache is only
+  // shared in the session, which is identified by its context.
+  if (cache_ == nullptr || !(cache_->page_shape() == page_shape_)) {
+    std::string model_name = param_->cache_name_[0] != '\0'
+                               ? std::string(param_->cache_name_)
+                               : "session_" + std::to_string(reinterpret_cast<uintptr_t>(ms_context_));
+    cache_ = KVCacheManager::GetInstance()->GetCache(model_name, this->name(), page_shape_,
+                                                     static_cast<size_t>(param_->max_pages_));
+    CHECK_NULL_RETURN(cache_);
+  }
+  seq_ids_.assign(seq_ids, seq_ids + seq_num_);
+  auto ret = cache_->Acquire(seq_ids_, std::vector<int>(past_lens, past_lens + seq_num_), q_seq_, &sequences_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Acquire the kv cache of " << this->name() << " failed.";
+    return RET_ERROR;
+  }
+  InitPageTables();
+
+  int batch = seq_num_ * page_shape_.head_num;
+  thread_num_ = MSMIN(op_parameter_->thread_num_, batch);
+  ret = ParallelLaunch(this->ms_context_, KVCacheAppendRun, this, thread_num_);
+  if (ret == RET_OK) {
+    thread_num_ = MSMIN(op_parameter_->thread_num_, batch * row_block_num_);
+    workspace_ = reinterpret_cast<float *>(
+      ms_context_->allocator->Malloc(static_cast<size_t>(thread_num_) * workspace_size_ * sizeof(float)));
+    if (workspace_ == nullptr) {
+      MS_LOG(ERROR) << "Malloc workspace of KVCacheAttention failed.";
+      ret = RET_ERROR;
+    } else {
+      ret = ParallelLaunch(this->ms_context_, KVCacheAttentionRun, this, thread_num_);
+      ms_context_->allocator->Free(workspace_);
+      workspace_ = nullptr;
+    }
+  }
+  cache_->Release(seq_ids_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "KVCacheAttention run failed, ret: " << ret;
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimType_Inner_KVCacheAttention, LiteKernelCreator<KVCacheAttentionCPUKernel>)
+}  // namespace mindspore::kernel
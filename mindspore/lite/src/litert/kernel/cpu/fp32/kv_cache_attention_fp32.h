@@ -0,0 +1,66 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_KV_CACHE_ATTENTION_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_KV_CACHE_ATTENTION_FP32_H_
+
+#include <memory>
+#include <vector>
+#include "src/litert/lite_kernel.h"
+#include "src/litert/kernel/cpu/base/kv_cache.h"
+#include "nnacl/attention_parameter.h"
+
+namespace mindspore::kernel {
+// The causal attention of the incremental decoding. The inputs are the query, key and value of the new tokens in shape
+// [seq_num, heads..., new_tokens, head_size], the int32 ids of the sequences and the int32 numbers of the cached tokens
+// to keep. The key and value are appended to the kv cache in place, and the query attends to all the cached tokens.
+class KVCacheAttentionCPUKernel : public LiteKernel {
+ public:
+  KVCacheAttentionCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                            const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    param_ = reinterpret_cast<KVCacheAttentionParameter *>(op_parameter_);
+  }
+  ~KVCacheAttentionCPUKernel() override = default;
+
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+  int DoAppend(int task_id);
+  int DoAttention(int task_id);
+
+ private:
+  int CheckInputShapes();
+  // Fill the pages of each head of the acquired sequences.
+  void InitPageTables();
+
+  KVCacheAttentionParameter *param_ = nullptr;
+  std::shared_ptr<KVCache> cache_ = nullptr;
+  KVCachePageShape page_shape_;
+  int seq_num_ = 0;
+  int q_seq_ = 0;
+  int row_block_num_ = 0;
+  int workspace_size_ = 0;
+  float *workspace_ = nullptr;
+  std::vector<int> seq_ids_;
+  std::vector<KVCacheSequence> sequences_;
+  // The pages of the batch b = seq * head_num + head start from page_offsets_[b].
+  std::vector<size_t> page_offsets_;
+  std::vector<float *> k_pages_;
+  std::vector<float *> v_pages_;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_KV_CACHE_ATTENTION_FP32_H_
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_AVX512
+#include "src/litert/kernel/cpu/fp32/matmul_bf16_fp32.h"
+#include "nnacl/fp32/matmul_avx512_bf16_fp32.h"
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+constexpr int kBiasIndex = 2;
+
+int MatmulBf16Run(void *cdata, int task_id, float, float) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<MatmulBf16CPUKernel *>(cdata);
+  auto ret = kernel->DoMatmul(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "MatmulBf16Run error task_id[" << task_id << "] error_code[" << ret << "]";
+  }
+  return ret;
+}
+}  // namespace
+
+bool IsBf16Matmul(const std::vector<lite::Tensor *> &inputs, const OpParameter *parameter,
+                  const lite::InnerContext *ctx) {
+  if (ctx == nullptr || !ctx->enable_bf16_ || parameter == nullptr || parameter->is_train_session_ ||
+      inputs.size() <= kWeightIndex) {
+    return false;
+  }
+  auto input = inputs.at(kInputIndex);
+  auto weight = inputs.at(kWeightIndex);
+  if (input == nullptr || weight == nullptr || input->data_type() != kNumberTypeFloat32 ||
+      weight->data_type() != kNumberTypeFloat32 || !weight->IsConst() || weight->data() == nullptr ||
+      weight->shape().size() != DIMENSION_2D) {
+    return false;
+  }
+  return !reinterpret_cast<const MatMulParameter *>(parameter)->a_transpose_;
+}
+
+MatmulBf16CPUKernel::~MatmulBf16CPUKernel() { FreeBuffer(); }
+
+void MatmulBf16CPUKernel::FreeBuffer() {
+  if (packed_weight_ != nullptr) {
+    free(packed_weight_);
+    packed_weight_ = nullptr;
+  }
+  if (bias_ != nullptr) {
+    free(bias_);
+    bias_ = nullptr;
+  }
+}
+
+int MatmulBf16CPUKernel::PackWeight() {
+  auto weight_data =
+    origin_weight_ != nullptr ? origin_weight_ : reinterpret_cast<const float *>(in_tensors_.at(kWeightIndex)->data());
+  CHECK_NULL_RETURN(weight_data);
+  size_t pack_size = static_cast<size_t>(col_tile_num_) * MATMUL_BF16_COL_TILE * deep_align_ * sizeof(uint16_t);
+  packed_weight_ = reinterpret_cast<uint16_t *>(malloc(pack_size));
+  if (packed_weight_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight of " << name_ << " failed.";
+    return RET_MEMORY_FAILED;
+  }
+  PackMatmulWeightBf16(weight_data, packed_weight_, deep_, col_, params_->b_transpose_);
+  return RET_OK;
+}
+
+int MatmulBf16CPUKernel::PackBias() {
+  if (in_tensors_.size() <= kBiasIndex) {
+    return RET_OK;
+  }
+  auto bias = in_tensors_.at(kBiasIndex);
+  if (bias->data_type() != kNumberTypeFloat32 || bias->ElementsNum() != col_) {
+    MS_LOG(ERROR) << "The bias of " << name_ << " should be float32 of " << col_ << " elements.";
+    return RET_ERROR;
+  }
+  // The non-constant bias is read when running, the constant one is copied since it's freed after the kernel prepared.
+  if (!bias->IsConst()) {
+    return RET_OK;
+  }
+  auto bias_data = origin_bias_ != nullptr ? origin_bias_ : reinterpret_cast<const float *>(bias->data());
+  CHECK_NULL_RETURN(bias_data);
+  bias_ = reinterpret_cast<float *>(malloc(col_ * sizeof(float)));
+  if (bias_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc bias of " << name_ << " failed.";
+    return RET_MEMORY_FAILED;
+  }
+  memcpy(bias_, bias_data, col_ * sizeof(float));
+  return RET_OK;
+}
+
+int MatmulBf16CPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), C2NUM);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  auto weight = in_tensors_.at(kWeightIndex);
+  auto shape = weight->shape();
+  if (!weight->IsConst() || shape.empty()) {
+    MS_LOG(ERROR) << "The weight of " << name_ << " should be a constant tensor.";
+    return RET_ERROR;
+  }
+  // The weight of conv1x1 is [col, 1, 1, deep], which is the same as the transposed 2D weight.
+  col_ = params_->b_transpose_ ? shape.front() : shape.back();
+  MS_CHECK_TRUE_MSG(col_ > 0, RET_ERROR, "The shape of weight is invalid.");
+  deep_ = weight->ElementsNum() / col_;
+  MS_CHECK_TRUE_MSG(deep_ > 0 && deep_ * col_ == weight->ElementsNum(), RET_ERROR, "The shape of weight is invalid.");
+  deep_align_ = UP_ROUND(deep_, C2NUM);
+  col_tile_num_ = UP_DIV(col_, MATMUL_BF16_COL_TILE);
+  FreeBuffer();
+  auto ret = PackWeight();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = PackBias();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int MatmulBf16CPUKernel::ReSize() {
+  auto input_num = in_tensors_.at(0)->ElementsNum();
+  if (input_num % deep_ != 0) {
+    MS_LOG(ERROR) << "The input of " << name_ << " has " << input_num << " elements, which is not divided by " << deep_;
+    return RET_ERROR;
+  }
+  row_ = input_num / deep_;
+  if (out_tensors_.at(0)->ElementsNum() != row_ * col_) {
+    MS_LOG(ERROR) << "The output of " << name_ << " doesn't match the shape of [" << row_ << ", " << col_ << "]";
+    return RET_ERROR;
+  }
+  // The rows are split when each thread gets a full row tile at least, else the column tiles are split.
+  int thread_num = MSMAX(op_parameter_->thread_num_, 1);
+  split_row_ = row_ >= thread_num * MATMUL_BF16_ROW_TILE;
+  if (split_row_) {
+    thread_stride_ = UP_ROUND(UP_DIV(row_, thread_num), MATMUL_BF16_ROW_TILE);
+    thread_count_ = UP_DIV(row_, thread_stride_);
+  } else {
+    thread_count_ = MSMAX(MSMIN(thread_num, col_tile_num_), 1);
+    thread_stride_ = UP_DIV(col_tile_num_, thread_count_);
+  }
+  // The packed input is planned in the runtime memory of the session if it's enabled.
+  set_workspace_size(static_cast<size_t>(row_) * deep_align_ * sizeof(uint16_t));
+  return RET_OK;
+}
+
+int MatmulBf16CPUKernel::DoMatmul(int task_id) {
+  if (split_row_) {
+    int row_start = task_id * thread_stride_;
+    if (row_start >= row_) {
+      return RET_OK;
+    }
+    int cur_row = MSMIN(row_ - row_start, thread_stride_);
+    uint16_t *cur_input = packed_input_ + static_cast<size_t>(row_start) * deep_align_;
+    PackMatmulInputBf16(a_ptr_ + static_cast<size_t>(row_start) * deep_, cur_input, cur_row, deep_);
+    MatmulBf16Fp32(cur_input, packed_weight_, bias_ptr_, c_ptr_ + static_cast<size_t>(row_start) * col_, cur_row,
+                   deep_, col_, 0, col_, params_->act_type_);
+    return RET_OK;
+  }
+  int col_start = task_id * thread_stride_ * MATMUL_BF16_COL_TILE;
+  if (col_start >= col_) {
+    return RET_OK;
+  }
+  int col_end = MSMIN(col_, col_start + thread_stride_ * MATMUL_BF16_COL_TILE);
+  MatmulBf16Fp32(packed_input_, packed_weight_, bias_ptr_, c_ptr_, row_, deep_, col_, col_start, col_end,
+                 params_->act_type_);
+  return RET_OK;
+}
+
+int MatmulBf16CPUKernel::Run() {
+  a_ptr_ = reinterpret_cast<const float *>(in_tensors_.at(0)->data());
+  c_ptr_ = reinterpret_cast<float *>(out_tensors_.at(0)->data());
+  CHECK_NULL_RETURN(a_ptr_);
+  CHECK_NULL_RETURN(c_ptr_);
+  bias_ptr_ = bias_;
+  if (bias_ptr_ == nullptr && in_tensors_.size() > kBiasIndex) {
+    bias_ptr_ = reinterpret_cast<const float *>(in_tensors_.at(kBiasIndex)->data());
+    CHECK_NULL_RETURN(bias_ptr_);
+  }
+  packed_input_ = reinterpret_cast<uint16_t *>(workspace());
+  if (packed_input_ == nullptr) {
+    packed_input_ = reinterpret_cast<uint16_t *>(ms_context_->allocator->Malloc(workspace_size()));
+  }
+  if (packed_input_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed input of " << name_ << " failed.";
+    return RET_MEMORY_FAILED;
+  }
+  // The whole input is needed by all the threads when the columns are split, so it's rounded once here.
+  if (!split_row_) {
+    PackMatmulInputBf16(a_ptr_, packed_input_, row_, deep_);
+  }
+  auto ret = ParallelLaunch(this->ms_context_, MatmulBf16Run, this, thread_count_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << name_ << " run failed: " << ret;
+  }
+  if (packed_input_ != workspace()) {
+    ms_context_->allocator->Free(packed_input_);
+  }
+  packed_input_ = nullptr;
+  return ret;
+}
+}  // namespace mindspore::kernel
+#endif  // ENABLE_AVX512
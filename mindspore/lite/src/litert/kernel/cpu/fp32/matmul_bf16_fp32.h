@@ -0,0 +1,72 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_BF16_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_BF16_FP32_H_
+#ifdef ENABLE_AVX512
+#include <vector>
+#include "include/errorcode.h"
+#include "src/litert/lite_kernel.h"
+#include "nnacl/matmul_parameter.h"
+
+namespace mindspore::kernel {
+// The constant fp32 weight of MatMul/FullConnection can be computed in bf16 when it's enabled by the context.
+bool IsBf16Matmul(const std::vector<lite::Tensor *> &inputs, const OpParameter *parameter,
+                  const lite::InnerContext *ctx);
+
+// Fp32 MatMul/FullConnection/Conv1x1 computed by the avx512 bf16 dot product, the constant weight is stored in bf16
+// and the input is rounded to bf16 when running, the output is accumulated and kept in fp32.
+class MatmulBf16CPUKernel : public LiteKernel {
+ public:
+  MatmulBf16CPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                      const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx,
+                      const float *origin_weight = nullptr, const float *origin_bias = nullptr)
+      : LiteKernel(parameter, inputs, outputs, ctx), origin_weight_(origin_weight), origin_bias_(origin_bias) {
+    params_ = reinterpret_cast<MatMulParameter *>(op_parameter_);
+    params_->matmul_type_ = MatmulType::kMatmulBf16Cpu;
+  }
+  ~MatmulBf16CPUKernel() override;
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+  int DoMatmul(int task_id);
+
+ private:
+  int PackWeight();
+  int PackBias();
+  void FreeBuffer();
+
+  MatMulParameter *params_ = nullptr;
+  const float *origin_weight_ = nullptr;
+  const float *origin_bias_ = nullptr;
+  uint16_t *packed_weight_ = nullptr;
+  uint16_t *packed_input_ = nullptr;
+  float *bias_ = nullptr;
+  const float *a_ptr_ = nullptr;
+  const float *bias_ptr_ = nullptr;
+  float *c_ptr_ = nullptr;
+  int row_ = 0;
+  int col_ = 0;
+  int deep_ = 0;
+  int deep_align_ = 0;
+  int col_tile_num_ = 0;
+  int thread_count_ = 1;
+  int thread_stride_ = 0;
+  bool split_row_ = false;
+};
+}  // namespace mindspore::kernel
+#endif  // ENABLE_AVX512
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_BF16_FP32_H_
@@ -20,6 +20,11 @@
 #include "nnacl/fp32/matmul_fp32.h"
 #include "src/litert/kernel_registry.h"
 #include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/litert/kernel/cpu/fp32/matmul_weight_quant_fp32.h"
+#include "src/litert/kernel/cpu/fp32/matmul_bf16_fp32.h"
+#ifdef ENABLE_SPARSE_COMPUTE
+#include "src/litert/kernel/cpu/fp32_sparse/matmul_compressed_sparse_fp32.h"
+#endif
 #if defined(ENABLE_AVX512)
 #include "src/litert/kernel/cpu/fp32/matmul_fp32_avx512.h"
 #endif
@@ -116,5 +121,24 @@ int MatmulCPUKernel::PreparePackedWeight(const lite::Tensor *tensor) {
   return RET_OK;
 }
 
-REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_MatMulFusion, LiteKernelCreator<MatmulCPUKernel>)
+LiteKernel *MatmulFp32CPUKernelCreator(const std::vector<lite::Tensor *> &inputs,
+                                       const std::vector<lite::Tensor *> &outputs, OpParameter *parameter,
+                                       const lite::InnerContext *ctx, const kernel::KernelKey &desc) {
+  if (IsWeightQuantMatmul(inputs)) {
+    return LiteKernelCreator<MatmulWeightQuantCPUKernel>(inputs, outputs, parameter, ctx, desc);
+  }
+#ifdef ENABLE_AVX512
+  if (IsBf16Matmul(inputs, parameter, ctx)) {
+    return LiteKernelCreator<MatmulBf16CPUKernel>(inputs, outputs, parameter, ctx, desc);
+  }
+#endif
+#ifdef ENABLE_SPARSE_COMPUTE
+  if (IsSparseMatmul(inputs, parameter)) {
+    return LiteKernelCreator<MatmulCompressedSparseCPUKernel>(inputs, outputs, parameter, ctx, desc);
+  }
+#endif
+  return LiteKernelCreator<MatmulCPUKernel>(inputs, outputs, parameter, ctx, desc);
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_MatMulFusion, MatmulFp32CPUKernelCreator)
 }  // namespace mindspore::kernel
@@ -174,7 +174,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixA() {
       matrix_a_.pack_ptr = reinterpret_cast<float *>(in_tensors_[FIRST_INPUT]->data());
       return RET_OK;
     }
-    if (op_parameter_->is_train_session_) {
+    // In inference, the workspace is planned in the runtime memory of the session if it's enabled.
+    if (op_parameter_->is_train_session_ || workspace() != nullptr) {
       matrix_a_.pack_ptr = reinterpret_cast<float *>(workspace());
     } else {
       matrix_a_.pack_ptr =
@@ -223,7 +224,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixAImpl() {
 }
 
 void MatmulFp32BaseCPUKernel::FreePackedMatrixA() {
-  if (matrix_a_.need_pack && !op_parameter_->is_train_session_ && matrix_a_.pack_ptr != nullptr) {
+  if (matrix_a_.need_pack && !op_parameter_->is_train_session_ && workspace() == nullptr &&
+      matrix_a_.pack_ptr != nullptr) {
     ms_context_->allocator->Free(matrix_a_.pack_ptr);
   }
   matrix_a_.pack_ptr = nullptr;
@@ -237,6 +239,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixB() {
     }
     if (op_parameter_->is_train_session_) {
       matrix_b_.pack_ptr = reinterpret_cast<float *>(workspace()) + matrix_a_.pack_size;
+    } else if (workspace() != nullptr) {
+      matrix_b_.pack_ptr = reinterpret_cast<float *>(workspace()) + (NeedPackMatrixAInRun() ? matrix_a_.pack_size : 0);
     } else {
       matrix_b_.pack_ptr =
         reinterpret_cast<float *>(ms_context_->allocator->Malloc(matrix_b_.pack_size * sizeof(float)));
@@ -315,7 +319,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixBImpl() {
 }
 
 void MatmulFp32BaseCPUKernel::FreePackedMatrixB() {
-  if (matrix_b_.need_pack && !op_parameter_->is_train_session_ && matrix_b_.pack_ptr != nullptr) {
+  if (matrix_b_.need_pack && !op_parameter_->is_train_session_ && workspace() == nullptr &&
+      matrix_b_.pack_ptr != nullptr) {
     ms_context_->allocator->Free(matrix_b_.pack_ptr);
   }
   matrix_b_.pack_ptr = nullptr;
@@ -548,6 +553,11 @@ int MatmulFp32BaseCPUKernel::ReSize() {
   MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "Init parameters failed.");
   if (op_parameter_->is_train_session_) {
     set_workspace_size((matrix_a_.pack_size + matrix_b_.pack_size) * static_cast<int>(sizeof(float)));
+  } else {
+    // The non-const matrices are packed in every run, the packed buffers are reported as the workspace.
+    size_t pack_size = (NeedPackMatrixAInRun() ? static_cast<size_t>(matrix_a_.pack_size) : 0) +
+                       (NeedPackMatrixBInRun() ? static_cast<size_t>(matrix_b_.pack_size) : 0);
+    set_workspace_size(pack_size * sizeof(float));
   }
   thread_num_ = op_parameter_->thread_num_;
   ret = GetThreadCuttingPolicy();
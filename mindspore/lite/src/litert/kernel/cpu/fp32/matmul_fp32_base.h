@@ -104,6 +104,8 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   int PackBiasMatrix();
   void FreePackedMatrixA();
   void FreePackedMatrixB();
+  bool NeedPackMatrixAInRun() const { return !params_->a_const_ && matrix_a_.need_pack; }
+  bool NeedPackMatrixBInRun() const { return !params_->b_const_ && matrix_b_.need_pack; }
   virtual int InitParameter();
   int InitTmpOutBuffer();
   virtual bool CheckThreadCuttingByRow();
@@ -0,0 +1,234 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/fp32/matmul_weight_quant_fp32.h"
+#include <algorithm>
+#include "nnacl/fp32/matmul_weight_quant_fp32.h"
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+constexpr int kBiasIndex = 2;
+constexpr float kMaxWeightVarCorr = 10.0f;
+constexpr int kInt4Min = -8;
+constexpr int kInt4Max = 7;
+
+int MatmulWeightQuantRun(void *cdata, int task_id, float, float) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<MatmulWeightQuantCPUKernel *>(cdata);
+  auto ret = kernel->DoMatmul(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "MatmulWeightQuantRun error task_id[" << task_id << "] error_code[" << ret << "]";
+  }
+  return ret;
+}
+}  // namespace
+
+bool IsWeightQuantMatmul(const std::vector<lite::Tensor *> &inputs) {
+  return inputs.size() > kWeightIndex && inputs.at(kWeightIndex) != nullptr &&
+         inputs.at(kWeightIndex)->data_type() == kNumberTypeInt8 && !inputs.at(kWeightIndex)->quant_params().empty();
+}
+
+MatmulWeightQuantCPUKernel::~MatmulWeightQuantCPUKernel() { FreeBuffer(); }
+
+void MatmulWeightQuantCPUKernel::FreeBuffer() {
+  if (packed_weight_ != nullptr) {
+    free(packed_weight_);
+    packed_weight_ = nullptr;
+  }
+  if (scales_ != nullptr) {
+    free(scales_);
+    scales_ = nullptr;
+  }
+  if (offsets_ != nullptr) {
+    free(offsets_);
+    offsets_ = nullptr;
+  }
+  if (bias_ != nullptr) {
+    free(bias_);
+    bias_ = nullptr;
+  }
+}
+
+int MatmulWeightQuantCPUKernel::InitQuantParam() {
+  auto weight = in_tensors_.at(kWeightIndex);
+  const auto &quant_params = weight->quant_params();
+  int param_num = static_cast<int>(quant_params.size());
+  group_num_ = param_num == 1 ? 1 : param_num / col_;
+  if ((param_num != 1 && param_num != col_ * group_num_) || deep_ % group_num_ != 0) {
+    MS_LOG(ERROR) << weight->tensor_name() << " quant params size " << param_num << " doesn't match col " << col_
+                  << " and deep " << deep_;
+    return RET_ERROR;
+  }
+  group_size_ = deep_ / group_num_;
+
+  size_t param_size = static_cast<size_t>(col_tile_num_) * group_num_ * WEIGHT_QUANT_COL_TILE * sizeof(float);
+  scales_ = reinterpret_cast<float *>(malloc(param_size));
+  offsets_ = reinterpret_cast<float *>(malloc(param_size));
+  if (scales_ == nullptr || offsets_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc quant param of " << name_ << " failed.";
+    return RET_MEMORY_FAILED;
+  }
+  memset(scales_, 0, param_size);
+  memset(offsets_, 0, param_size);
+  for (int c = 0; c < col_; c++) {
+    for (int g = 0; g < group_num_; g++) {
+      const auto &quant_param = param_num == 1 ? quant_params.front() : quant_params.at(c * group_num_ + g);
+      // Same as the dequantization of the weight decoder, the correction is only valid for the per channel params.
+      float var_corr = param_num == 1 ? 1.0f : quant_param.var_corr;
+      float mean_corr = param_num == 1 ? 0.0f : quant_param.mean_corr;
+      if (var_corr < 0 || var_corr > kMaxWeightVarCorr) {
+        MS_LOG(WARNING) << "unexpected var_corr: " << var_corr;
+        var_corr = 1.0f;
+      }
+      float scale = static_cast<float>(quant_param.scale) * var_corr;
+      int index = ((c / WEIGHT_QUANT_COL_TILE) * group_num_ + g) * WEIGHT_QUANT_COL_TILE + c % WEIGHT_QUANT_COL_TILE;
+      scales_[index] = scale;
+      offsets_[index] = mean_corr - quant_param.zeroPoint * scale;
+    }
+  }
+  return RET_OK;
+}
+
+int MatmulWeightQuantCPUKernel::PackWeight() {
+  auto weight = in_tensors_.at(kWeightIndex);
+  auto weight_data = reinterpret_cast<const int8_t *>(weight->data());
+  CHECK_NULL_RETURN(weight_data);
+  // The weight of no more than 4 bits is packed in nibbles, which halves the memory again.
+  bit_num_ = C8NUM;
+  int quant_bit = weight->quant_params().front().bitNum;
+  if (quant_bit > 0 && quant_bit <= WEIGHT_QUANT_INT4_BIT) {
+    auto element_num = weight->ElementsNum();
+    bool in_range = std::all_of(weight_data, weight_data + element_num,
+                                [](int8_t value) { return value >= kInt4Min && value <= kInt4Max; });
+    bit_num_ = in_range ? WEIGHT_QUANT_INT4_BIT : C8NUM;
+  }
+  size_t tile_size = static_cast<size_t>(deep_) * (bit_num_ == WEIGHT_QUANT_INT4_BIT ? C8NUM : C16NUM);
+  packed_weight_ = reinterpret_cast<int8_t *>(malloc(col_tile_num_ * tile_size));
+  if (packed_weight_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight of " << name_ << " failed.";
+    return RET_MEMORY_FAILED;
+  }
+  if (bit_num_ == WEIGHT_QUANT_INT4_BIT) {
+    PackWeightQuantInt4(weight_data, packed_weight_, deep_, col_, params_->b_transpose_);
+  } else {
+    PackWeightQuantInt8(weight_data, packed_weight_, deep_, col_, params_->b_transpose_);
+  }
+  return RET_OK;
+}
+
+int MatmulWeightQuantCPUKernel::PackBias() {
+  if (in_tensors_.size() <= kBiasIndex) {
+    return RET_OK;
+  }
+  auto bias = in_tensors_.at(kBiasIndex);
+  if (bias->data_type() != kNumberTypeFloat32 || bias->ElementsNum() != col_) {
+    MS_LOG(ERROR) << "The bias of " << name_ << " should be float32 of " << col_ << " elements.";
+    return RET_ERROR;
+  }
+  // The non-constant bias is read when running, the constant one is copied since it's freed after the kernel prepared.
+  if (!bias->IsConst()) {
+    return RET_OK;
+  }
+  CHECK_NULL_RETURN(bias->data());
+  bias_ = reinterpret_cast<float *>(malloc(col_ * sizeof(float)));
+  if (bias_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc bias of " << name_ << " failed.";
+    return RET_MEMORY_FAILED;
+  }
+  memcpy(bias_, bias->data(), col_ * sizeof(float));
+  return RET_OK;
+}
+
+int MatmulWeightQuantCPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), C2NUM);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  auto weight = in_tensors_.at(kWeightIndex);
+  auto shape = weight->shape();
+  if (!weight->IsConst() || shape.size() != DIMENSION_2D || weight->quant_params().empty()) {
+    MS_LOG(ERROR) << "The weight of " << name_ << " should be a constant 2D tensor with quant params.";
+    return RET_ERROR;
+  }
+  col_ = params_->b_transpose_ ? shape.front() : shape.back();
+  deep_ = params_->b_transpose_ ? shape.back() : shape.front();
+  MS_CHECK_TRUE_MSG(col_ > 0 && deep_ > 0, RET_ERROR, "The shape of weight is invalid.");
+  col_tile_num_ = UP_DIV(col_, WEIGHT_QUANT_COL_TILE);
+  FreeBuffer();
+  auto ret = InitQuantParam();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = PackWeight();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = PackBias();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int MatmulWeightQuantCPUKernel::ReSize() {
+  auto input_num = in_tensors_.at(0)->ElementsNum();
+  if (input_num % deep_ != 0) {
+    MS_LOG(ERROR) << "The input of " << name_ << " has " << input_num << " elements, which is not divided by " << deep_;
+    return RET_ERROR;
+  }
+  row_ = input_num / deep_;
+  if (out_tensors_.at(0)->ElementsNum() != row_ * col_) {
+    MS_LOG(ERROR) << "The output of " << name_ << " doesn't match the shape of [" << row_ << ", " << col_ << "]";
+    return RET_ERROR;
+  }
+  thread_count_ = MSMAX(MSMIN(op_parameter_->thread_num_, col_tile_num_), 1);
+  thread_stride_ = UP_DIV(col_tile_num_, thread_count_);
+  return RET_OK;
+}
+
+int MatmulWeightQuantCPUKernel::DoMatmul(int task_id) {
+  int col_start = task_id * thread_stride_ * WEIGHT_QUANT_COL_TILE;
+  if (col_start >= col_) {
+    return RET_OK;
+  }
+  int col_end = MSMIN(col_, col_start + thread_stride_ * WEIGHT_QUANT_COL_TILE);
+  MatmulWeightQuantFp32(a_ptr_, packed_weight_, scales_, offsets_, bias_ptr_, c_ptr_, row_, deep_, col_, group_size_,
+                        bit_num_, col_start, col_end, params_->act_type_);
+  return RET_OK;
+}
+
+int MatmulWeightQuantCPUKernel::Run() {
+  a_ptr_ = reinterpret_cast<const float *>(in_tensors_.at(0)->data());
+  c_ptr_ = reinterpret_cast<float *>(out_tensors_.at(0)->data());
+  CHECK_NULL_RETURN(a_ptr_);
+  CHECK_NULL_RETURN(c_ptr_);
+  bias_ptr_ = bias_;
+  if (bias_ptr_ == nullptr && in_tensors_.size() > kBiasIndex) {
+    bias_ptr_ = reinterpret_cast<const float *>(in_tensors_.at(kBiasIndex)->data());
+    CHECK_NULL_RETURN(bias_ptr_);
+  }
+  auto ret = ParallelLaunch(this->ms_context_, MatmulWeightQuantRun, this, thread_count_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << name_ << " run failed: " << ret;
+  }
+  return ret;
+}
+}  // namespace mindspore::kernel
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
+
+#include <vector>
+#include "include/errorcode.h"
+#include "src/litert/lite_kernel.h"
+#include "nnacl/matmul_parameter.h"
+
+namespace mindspore::kernel {
+// The weight of MatMul/FullConnection kept in int8 by the weight decoder.
+bool IsWeightQuantMatmul(const std::vector<lite::Tensor *> &inputs);
+
+// Fp32 MatMul/FullConnection whose constant weight stays int8 (or int4 packed in nibbles) in memory, the weight tiles
+// are dequantized in registers inside the gemm with the per tensor, per channel or group-wise scales.
+class MatmulWeightQuantCPUKernel : public LiteKernel {
+ public:
+  MatmulWeightQuantCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                             const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    params_ = reinterpret_cast<MatMulParameter *>(op_parameter_);
+    params_->matmul_type_ = MatmulType::kMatmulWeightQuantFp32Cpu;
+  }
+  ~MatmulWeightQuantCPUKernel() override;
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+  int DoMatmul(int task_id);
+
+ private:
+  int InitQuantParam();
+  int PackWeight();
+  int PackBias();
+  void FreeBuffer();
+
+  MatMulParameter *params_ = nullptr;
+  int8_t *packed_weight_ = nullptr;
+  float *scales_ = nullptr;
+  float *offsets_ = nullptr;
+  float *bias_ = nullptr;
+  const float *a_ptr_ = nullptr;
+  const float *bias_ptr_ = nullptr;
+  float *c_ptr_ = nullptr;
+  int row_ = 0;
+  int col_ = 0;
+  int deep_ = 0;
+  int group_num_ = 1;
+  int group_size_ = 0;
+  int bit_num_ = 8;
+  int col_tile_num_ = 0;
+  int thread_count_ = 1;
+  int thread_stride_ = 0;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_WEIGHT_QUANT_FP32_H_
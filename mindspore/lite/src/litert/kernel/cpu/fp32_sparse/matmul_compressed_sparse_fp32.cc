@@ -0,0 +1,282 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/kernel/cpu/fp32_sparse/matmul_compressed_sparse_fp32.h"
+#include "nnacl/fp32/pack_fp32.h"
+#include "nnacl/fp32_sparse/matmul_sparse_fp32.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+constexpr int kBiasIndex = 2;
+// The ratio of zero is measured by the kernels with avx2/avx512 against the dense ones: the block kernel is faster when
+// half of the [1, 16] blocks are zero, the csc kernel is faster when 70% of the elements are zero.
+constexpr float kBlockSparseThreshold = 0.5f;
+constexpr float kCscSparseThreshold = 0.7f;
+
+int MatmulCompressedSparseRun(void *cdata, int task_id, float, float) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<MatmulCompressedSparseCPUKernel *>(cdata);
+  auto ret = kernel->DoMatmul(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "MatmulCompressedSparseRun error task_id[" << task_id << "] error_code[" << ret << "]";
+  }
+  return ret;
+}
+
+SparseWeightFormat SelectSparseWeightFormat(int deep, int col, int nnz, int block_nnz) {
+  auto block_num = static_cast<float>(deep) * UP_DIV(col, SPARSE_COL_TILE);
+  if (1.0f - block_nnz / block_num >= kBlockSparseThreshold) {
+    return SparseWeightFormat::kBlock;
+  }
+  if (1.0f - nnz / (static_cast<float>(deep) * col) >= kCscSparseThreshold) {
+    return SparseWeightFormat::kCsc;
+  }
+  return SparseWeightFormat::kNone;
+}
+}  // namespace
+
+SparseWeightFormat GetSparseWeightFormat(const float *weight, int deep, int col, bool transpose) {
+  if (weight == nullptr || deep <= 0 || col <= 0) {
+    return SparseWeightFormat::kNone;
+  }
+  int nnz = 0;
+  int block_nnz = 0;
+  SparseWeightCount(weight, deep, col, transpose, &nnz, &block_nnz);
+  return SelectSparseWeightFormat(deep, col, nnz, block_nnz);
+}
+
+bool IsSparseMatmul(const std::vector<lite::Tensor *> &inputs, const OpParameter *parameter) {
+#ifndef ENABLE_AVX
+  // The sparse kernels are only vectorized with avx, the scalar ones are slower than the dense kernels of the other
+  // platforms, e.g. the arm64 assembly, at the thresholds measured on x86.
+  return false;
+#else
+  if (parameter == nullptr || parameter->is_train_session_ || inputs.size() <= kWeightIndex) {
+    return false;
+  }
+  auto input = inputs.at(kInputIndex);
+  auto weight = inputs.at(kWeightIndex);
+  if (input == nullptr || weight == nullptr || input->data_type() != kNumberTypeFloat32 ||
+      weight->data_type() != kNumberTypeFloat32 || !weight->IsConst() || weight->data() == nullptr ||
+      weight->shape().size() != DIMENSION_2D) {
+    return false;
+  }
+  auto matmul_param = reinterpret_cast<const MatMulParameter *>(parameter);
+  if (matmul_param->a_transpose_) {
+    return false;
+  }
+  auto shape = weight->shape();
+  int deep = matmul_param->b_transpose_ ? shape.back() : shape.front();
+  int col = matmul_param->b_transpose_ ? shape.front() : shape.back();
+  return GetSparseWeightFormat(reinterpret_cast<const float *>(weight->data()), deep, col,
+                               matmul_param->b_transpose_) != SparseWeightFormat::kNone;
+#endif
+}
+
+MatmulCompressedSparseCPUKernel::~MatmulCompressedSparseCPUKernel() { FreeBuffer(); }
+
+void MatmulCompressedSparseCPUKernel::FreeBuffer() {
+  if (values_ != nullptr) {
+    free(values_);
+    values_ = nullptr;
+  }
+  if (indices_ != nullptr) {
+    free(indices_);
+    indices_ = nullptr;
+  }
+  if (offsets_ != nullptr) {
+    free(offsets_);
+    offsets_ = nullptr;
+  }
+  if (bias_ != nullptr) {
+    free(bias_);
+    bias_ = nullptr;
+  }
+}
+
+int MatmulCompressedSparseCPUKernel::PackWeight(const float *weight, int nnz, int block_nnz) {
+  // One more element is kept for the weight of all zero.
+  size_t value_num = format_ == SparseWeightFormat::kBlock ? static_cast<size_t>(block_nnz) * SPARSE_COL_TILE : nnz;
+  size_t index_num = format_ == SparseWeightFormat::kBlock ? block_nnz : nnz;
+  size_t offset_num = format_ == SparseWeightFormat::kBlock ? col_tile_num_ + 1 : col_ + 1;
+  values_ = reinterpret_cast<float *>(malloc((value_num + 1) * sizeof(float)));
+  indices_ = reinterpret_cast<int *>(malloc((index_num + 1) * sizeof(int)));
+  offsets_ = reinterpret_cast<int *>(malloc(offset_num * sizeof(int)));
+  if (values_ == nullptr || indices_ == nullptr || offsets_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc compressed weight of " << name_ << " failed.";
+    return RET_MEMORY_FAILED;
+  }
+  if (format_ == SparseWeightFormat::kBlock) {
+    PackBlockSparseWeight(weight, deep_, col_, params_->b_transpose_, values_, indices_, offsets_);
+  } else {
+    PackCscSparseWeight(weight, deep_, col_, params_->b_transpose_, values_, indices_, offsets_);
+  }
+  MS_LOG(INFO) << name_ << " is computed in the " << (format_ == SparseWeightFormat::kBlock ? "block" : "csc")
+               << " sparse format, " << nnz << " of " << deep_ * col_ << " elements are non-zero.";
+  return RET_OK;
+}
+
+int MatmulCompressedSparseCPUKernel::PackBias() {
+  if (in_tensors_.size() <= kBiasIndex) {
+    return RET_OK;
+  }
+  auto bias = in_tensors_.at(kBiasIndex);
+  if (bias->data_type() != kNumberTypeFloat32 || bias->ElementsNum() != col_) {
+    MS_LOG(ERROR) << "The bias of " << name_ << " should be float32 of " << col_ << " elements.";
+    return RET_ERROR;
+  }
+  // The kernels read the bias in tiles, so it's padded with zero. The non-constant bias is copied when running.
+  size_t bias_size = static_cast<size_t>(col_tile_num_) * SPARSE_COL_TILE * sizeof(float);
+  bias_ = reinterpret_cast<float *>(malloc(bias_size));
+  if (bias_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc bias of " << name_ << " failed.";
+    return RET_MEMORY_FAILED;
+  }
+  memset(bias_, 0, bias_size);
+  bias_const_ = bias->IsConst();
+  if (bias_const_) {
+    CHECK_NULL_RETURN(bias->data());
+    memcpy(bias_, bias->data(), col_ * sizeof(float));
+  }
+  return RET_OK;
+}
+
+int MatmulCompressedSparseCPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), C2NUM);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  auto weight = in_tensors_.at(kWeightIndex);
+  auto shape = weight->shape();
+  if (!weight->IsConst() || shape.size() != DIMENSION_2D || weight->data_type() != kNumberTypeFloat32) {
+    MS_LOG(ERROR) << "The weight of " << name_ << " should be a constant 2D float32 tensor.";
+    return RET_ERROR;
+  }
+  auto weight_data = reinterpret_cast<const float *>(weight->data());
+  CHECK_NULL_RETURN(weight_data);
+  deep_ = params_->b_transpose_ ? shape.back() : shape.front();
+  col_ = params_->b_transpose_ ? shape.front() : shape.back();
+  MS_CHECK_TRUE_MSG(deep_ > 0 && col_ > 0, RET_ERROR, "The shape of weight is invalid.");
+  col_tile_num_ = UP_DIV(col_, SPARSE_COL_TILE);
+  // The weight is scanned once to count the non-zero, which selects the format and sizes the buffers, and once more to
+  // fill the buffers.
+  int nnz = 0;
+  int block_nnz = 0;
+  SparseWeightCount(weight_data, deep_, col_, params_->b_transpose_, &nnz, &block_nnz);
+  format_ = SelectSparseWeightFormat(deep_, col_, nnz, block_nnz);
+  // The kernel may be created for the weight which is not sparse enough, the csc format is always right.
+  if (format_ == SparseWeightFormat::kNone) {
+    format_ = SparseWeightFormat::kCsc;
+  }
+  FreeBuffer();
+  auto ret = PackWeight(weight_data, nnz, block_nnz);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = PackBias();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int MatmulCompressedSparseCPUKernel::ReSize() {
+  auto input_num = in_tensors_.at(0)->ElementsNum();
+  if (input_num % deep_ != 0) {
+    MS_LOG(ERROR) << "The input of " << name_ << " has " << input_num << " elements, which is not divided by " << deep_;
+    return RET_ERROR;
+  }
+  row_ = input_num / deep_;
+  if (out_tensors_.at(0)->ElementsNum() != row_ * col_) {
+    MS_LOG(ERROR) << "The output of " << name_ << " doesn't match the shape of [" << row_ << ", " << col_ << "]";
+    return RET_ERROR;
+  }
+  thread_count_ = MSMAX(MSMIN(op_parameter_->thread_num_, col_tile_num_), 1);
+  thread_stride_ = UP_DIV(col_tile_num_, thread_count_);
+  // The packed input of the csc kernel is planned in the runtime memory of the session if it's enabled.
+  int row_tile_end = row_ / SPARSE_ROW_TILE * SPARSE_ROW_TILE;
+  set_workspace_size(format_ == SparseWeightFormat::kCsc ? static_cast<size_t>(row_tile_end) * deep_ * sizeof(float)
+                                                         : 0);
+  return RET_OK;
+}
+
+int MatmulCompressedSparseCPUKernel::DoMatmul(int task_id) {
+  int col_start = task_id * thread_stride_ * SPARSE_COL_TILE;
+  if (col_start >= col_) {
+    return RET_OK;
+  }
+  int col_end = MSMIN(col_, col_start + thread_stride_ * SPARSE_COL_TILE);
+  auto act_type = params_->act_type_;
+#ifdef ENABLE_AVX512
+  if (X86_Avx512_Support()) {
+    if (format_ == SparseWeightFormat::kBlock) {
+      MatmulBlockSparseAvx512Fp32(a_ptr_, values_, indices_, offsets_, bias_, c_ptr_, row_, deep_, col_, col_start,
+                                  col_end, act_type);
+    } else {
+      MatmulCscSparseAvx512Fp32(a_ptr_, packed_input_, values_, indices_, offsets_, bias_, c_ptr_, row_, deep_, col_,
+                                col_start, col_end, act_type);
+    }
+    return RET_OK;
+  }
+#endif
+  if (format_ == SparseWeightFormat::kBlock) {
+    MatmulBlockSparseFp32(a_ptr_, values_, indices_, offsets_, bias_, c_ptr_, row_, deep_, col_, col_start, col_end,
+                          act_type);
+  } else {
+    MatmulCscSparseFp32(a_ptr_, packed_input_, values_, indices_, offsets_, bias_, c_ptr_, row_, deep_, col_,
+                        col_start, col_end, act_type);
+  }
+  return RET_OK;
+}
+
+int MatmulCompressedSparseCPUKernel::Run() {
+  a_ptr_ = reinterpret_cast<const float *>(in_tensors_.at(0)->data());
+  c_ptr_ = reinterpret_cast<float *>(out_tensors_.at(0)->data());
+  CHECK_NULL_RETURN(a_ptr_);
+  CHECK_NULL_RETURN(c_ptr_);
+  if (bias_ != nullptr && !bias_const_) {
+    CHECK_NULL_RETURN(in_tensors_.at(kBiasIndex)->data());
+    memcpy(bias_, in_tensors_.at(kBiasIndex)->data(), col_ * sizeof(float));
+  }
+  // The csc kernel computes 16 rows in a vector, the full row tiles of the input are packed to col16-major.
+  int row_tile_end = row_ / SPARSE_ROW_TILE * SPARSE_ROW_TILE;
+  if (format_ == SparseWeightFormat::kCsc && row_tile_end > 0) {
+    packed_input_ = reinterpret_cast<float *>(workspace());
+    if (packed_input_ == nullptr) {
+      packed_input_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(workspace_size()));
+    }
+    if (packed_input_ == nullptr) {
+      MS_LOG(ERROR) << "Malloc packed input of " << name_ << " failed.";
+      return RET_MEMORY_FAILED;
+    }
+    RowMajor2Col16Major(a_ptr_, packed_input_, row_tile_end, deep_);
+  }
+  auto ret = ParallelLaunch(this->ms_context_, MatmulCompressedSparseRun, this, thread_count_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << name_ << " run failed: " << ret;
+  }
+  if (packed_input_ != nullptr && packed_input_ != workspace()) {
+    ms_context_->allocator->Free(packed_input_);
+  }
+  packed_input_ = nullptr;
+  return ret;
+}
+}  // namespace mindspore::kernel
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_COMPRESSED_SPARSE_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_COMPRESSED_SPARSE_FP32_H_
+
+#include <vector>
+#include "include/errorcode.h"
+#include "src/litert/lite_kernel.h"
+#include "nnacl/matmul_parameter.h"
+
+namespace mindspore::kernel {
+enum class SparseWeightFormat { kNone, kBlock, kCsc };
+
+// The format which the constant fp32 weight of MatMul/FullConnection is compressed in, kNone if the weight is not
+// sparse enough to be faster than the dense kernel.
+SparseWeightFormat GetSparseWeightFormat(const float *weight, int deep, int col, bool transpose);
+bool IsSparseMatmul(const std::vector<lite::Tensor *> &inputs, const OpParameter *parameter);
+
+// Fp32 MatMul/FullConnection whose constant weight is pruned, the weight is kept compressed and only the non-zero are
+// computed: the weight with the zero [1, 16] blocks is stored in blocks, and the rest ones (including the N:M pruned
+// weight) are stored in csc.
+class MatmulCompressedSparseCPUKernel : public LiteKernel {
+ public:
+  MatmulCompressedSparseCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                                  const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    params_ = reinterpret_cast<MatMulParameter *>(op_parameter_);
+  }
+  ~MatmulCompressedSparseCPUKernel() override;
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+  int DoMatmul(int task_id);
+
+ private:
+  int PackWeight(const float *weight, int nnz, int block_nnz);
+  int PackBias();
+  void FreeBuffer();
+
+  MatMulParameter *params_ = nullptr;
+  SparseWeightFormat format_ = SparseWeightFormat::kNone;
+  float *values_ = nullptr;
+  int *indices_ = nullptr;  // block_deep of the block format or deep_index of csc
+  int *offsets_ = nullptr;  // tile_offset of the block format or col_offset of csc
+  float *bias_ = nullptr;   // padded to the multiple of SPARSE_COL_TILE
+  bool bias_const_ = true;
+  float *packed_input_ = nullptr;
+  const float *a_ptr_ = nullptr;
+  float *c_ptr_ = nullptr;
+  int row_ = 0;
+  int col_ = 0;
+  int deep_ = 0;
+  int col_tile_num_ = 0;
+  int thread_count_ = 1;
+  int thread_stride_ = 0;
+};
+}  // namespace mindspore::kernel
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_COMPRESSED_SPARSE_FP32_H_
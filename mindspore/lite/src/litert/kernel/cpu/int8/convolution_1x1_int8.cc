@@ -17,6 +17,10 @@
 #include "src/litert/kernel/cpu/int8/convolution_1x1_int8.h"
 #include "src/common/file_utils.h"
 #include "src/litert/kernel/cpu/int8/opt_op_handler.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "nnacl/int8/matmul_vnni_int8.h"
+#endif
 
 using mindspore::lite::RET_ERROR;
 using mindspore::lite::RET_MEMORY_FAILED;
@@ -151,6 +155,11 @@ void Convolution1x1Int8CPUKernel::CheckSupportOptimize() {
 #if !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && !defined(MACHINE_LINUX_ARM64) && !defined(USE_AOS_GCC_TOOLCHAIN)
   }
 #endif
+#elif defined(ENABLE_AVX512)
+  if (X86_Avx512Vnni_Support()) {
+    support_optimize_ = true;
+    matmul_func_ = MatMulDpInt8Vnni;
+  }
 #endif
   return;
 }  // namespace mindspore::kernel
@@ -22,6 +22,10 @@
 #ifdef ENABLE_ARM64
 #include "src/litert/kernel/cpu/int8/opt_op_handler.h"
 #endif
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "nnacl/int8/matmul_vnni_int8.h"
+#endif
 
 using mindspore::lite::RET_ERROR;
 using mindspore::lite::RET_OK;
@@ -46,6 +50,10 @@ void ConvolutionInt8CPUKernel::CheckSupportOptimize() {
 #if !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && !defined(MACHINE_LINUX_ARM64) && !defined(USE_AOS_GCC_TOOLCHAIN)
   }
 #endif
+#elif defined(ENABLE_AVX512)
+  if (X86_Avx512Vnni_Support()) {
+    matmul_func_ = MatMulRInt8Vnni;
+  }
 #endif
   conv_param_->tile_num_ = tile_num_;
 }
@@ -17,6 +17,10 @@
 #include "src/litert/kernel/cpu/int8/matmul_base_int8.h"
 #include "src/litert/kernel/cpu/int8/opt_op_handler.h"
 #include "src/litert/kernel/cpu/fp32/matmul_fp32_base.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "nnacl/int8/matmul_vnni_int8.h"
+#endif
 
 using mindspore::lite::RET_ERROR;
 using mindspore::lite::RET_MEMORY_FAILED;
@@ -34,8 +38,9 @@ int MatmulBaseInt8Run(void *cdata, int task_id, float, float) {
   return RET_OK;
 }
 
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64)) && \
-  !defined(USE_AOS_GCC_TOOLCHAIN)
+#if (defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64)) && \
+     !defined(USE_AOS_GCC_TOOLCHAIN)) ||                                                                             \
+  defined(ENABLE_AVX512)
 int Arm64SdotPreRun(void *cdata, int task_id, float, float) {
   CHECK_NULL_RETURN(cdata);
   auto op = reinterpret_cast<MatmulBaseInt8CPUKernel *>(cdata);
@@ -117,10 +122,17 @@ int MatmulBaseInt8CPUKernel::Arm64SdotImpl(int task_id) {
     filter_per_channel_ ? quant_param_->quant_multiplier_ + cur_stride : quant_param_->quant_multiplier_;
   int32_t *cur_zp = filter_per_channel_ ? quant_param_->filter_zp_ + cur_stride : quant_param_->filter_zp_;
 
+#ifdef ENABLE_AVX512
+  MatMulDpInt8Vnni(pack_a_ptr_, batch_b_ptr_ + cur_stride * param_->deep_align_, batch_c_ptr_ + cur_stride,
+                   param_->row_, cur_oc, param_->deep_align_, param_->col_, input_sums_, batch_sums_ + cur_stride,
+                   cur_left, cur_right, cur_mul, quant_param_->output_.zp_, quant_param_->out_act_min_,
+                   quant_param_->out_act_max_, filter_per_channel_, cur_zp);
+#else
   MatmulInt8DpOpt(pack_a_ptr_, batch_b_ptr_ + cur_stride * param_->deep_align_, batch_c_ptr_ + cur_stride, param_->row_,
                   cur_oc, param_->deep_align_, input_sums_, batch_sums_ + cur_stride, quant_param_->out_act_min_,
                   quant_param_->out_act_max_, quant_param_->output_.zp_, cur_mul, cur_left, cur_right, param_->col_,
                   filter_per_channel_, cur_zp);
+#endif
 
   return RET_OK;
 }
@@ -273,8 +285,12 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
   row_tile_ = C4NUM;
   col_tile_ = C2NUM;
   deep_tile_ = C16NUM;
-#elif ENABLE_ARM64
+#elif defined(ENABLE_ARM64) || defined(ENABLE_AVX512)
+#ifdef ENABLE_AVX512
+  support_sdot_ = X86_Avx512Vnni_Support();
+#else
   support_sdot_ = mindspore::lite::IsSupportSDot();
+#endif
   row_tile_ = C4NUM;
   if (support_sdot_) {
     col_tile_ = C16NUM;
@@ -296,7 +312,7 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
   if (param_->b_transpose_) {
 #ifdef ENABLE_ARM32
     b_pack_func_ = RowMajor2Row2x16MajorInt8;
-#elif ENABLE_ARM64
+#elif defined(ENABLE_ARM64) || defined(ENABLE_AVX512)
     if (support_sdot_) {
       b_pack_func_ = RowMajor2Row4x16MajorInt8;
     } else {
@@ -308,7 +324,7 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
   } else {
 #ifdef ENABLE_ARM32
     b_pack_func_ = RowMajor2Col16x2MajorInt8;
-#elif ENABLE_ARM64
+#elif defined(ENABLE_ARM64) || defined(ENABLE_AVX512)
     if (support_sdot_) {
       b_pack_func_ = RowMajor2Col4x16MajorInt8;
     } else {
@@ -488,8 +504,9 @@ int MatmulBaseInt8CPUKernel::ReSize() {
   return RET_OK;
 }
 
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64)) && \
-  !defined(USE_AOS_GCC_TOOLCHAIN)
+#if (defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64)) && \
+     !defined(USE_AOS_GCC_TOOLCHAIN)) ||                                                                             \
+  defined(ENABLE_AVX512)
 int MatmulBaseInt8CPUKernel::RunArm64Sdot() {
   int8_t *a_ptr = reinterpret_cast<int8_t *>(in_tensors_.at(0)->data());
   int8_t *b_ptr = reinterpret_cast<int8_t *>(in_tensors_.at(1)->data());
@@ -522,8 +539,9 @@ int MatmulBaseInt8CPUKernel::RunArm64Sdot() {
 #endif
 
 int MatmulBaseInt8CPUKernel::Run() {
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64)) && \
-  !defined(USE_AOS_GCC_TOOLCHAIN)
+#if (defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64)) && \
+     !defined(USE_AOS_GCC_TOOLCHAIN)) ||                                                                             \
+  defined(ENABLE_AVX512)
   if (support_sdot_) {
     return RunArm64Sdot();
   }
@@ -45,7 +45,7 @@ class MatmulBaseInt8CPUKernel : public LiteKernel {
 
  public:
   int RunImpl(int task_id);
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && (!defined(MACHINE_LINUX_ARM64))
+#if (defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && (!defined(MACHINE_LINUX_ARM64))) || defined(ENABLE_AVX512)
   int RunArm64Sdot();
   int Arm64SdotImpl(int task_id);
   int Arm64SdotPre(int task_id);
@@ -89,6 +89,7 @@ class MatmulBaseInt8CPUKernel : public LiteKernel {
   int col_tile_ = C4NUM;
   int deep_tile_ = C16NUM;
   int channel_num_ = 0;
+  // sdot of arm64 or avx512 vnni of x86, both of which run on the row4x4-major lhs and row4x16-major rhs.
   bool support_sdot_ = false;
   PackFunc a_pack_func_{nullptr};
   PackFunc b_pack_func_{nullptr};
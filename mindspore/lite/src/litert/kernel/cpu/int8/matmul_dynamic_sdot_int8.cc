@@ -18,6 +18,10 @@
 #include <vector>
 #include "nnacl/int8/dynamic_matmul_int8.h"
 #include "nnacl/int8/matmul_int8.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "nnacl/int8/matmul_vnni_int8.h"
+#endif
 
 using mindspore::lite::RET_ERROR;
 using mindspore::lite::RET_MEMORY_FAILED;
@@ -117,6 +121,17 @@ int MatMulDynamicSdotInt8Kernel::MatMulDynamicArm64SdotImpl(int task_id) {
   auto out_stride_fp16 = param_->col_ * sizeof(float16_t);
 #endif
   int64_t act_type = static_cast<int64_t>(param_->act_type_);
+#ifdef ENABLE_AVX512
+  // the vnni kernel blocks the rows and columns itself, so the whole slice of the columns is computed at once.
+  if (!enable_fp16_ && X86_Avx512Vnni_Support()) {
+    auto bias = fp32_bias_ptr_ == nullptr ? nullptr : fp32_bias_ptr_ + cur_stride;
+    DynamicMatmulVnni4x4x16AIWI(pack_a_ptr_, batch_b_ptr_ + cur_stride * param_->deep_align_,
+                                fp32_batch_c_ptr_ + cur_stride, param_->deep_align_, multi_scale.data(), bias,
+                                param_->row_, cur_oc, out_stride, input_sums_, current_sums, quant_param_->input_zp_,
+                                quant_param_->filter_zp_[0] * param_->deep_, act_type);
+    return RET_OK;
+  }
+#endif
   for (int r = 0; r < param_->row_; r += C4NUM) {
     size_t row = MSMIN(C4NUM, param_->row_ - r);
     auto a_ptr = pack_a_ptr_ + r * param_->deep_align_;
@@ -19,6 +19,9 @@
 #include "src/litert/kernel/cpu/int8/matmul_dynamic_sdot_int8.h"
 #include "nnacl/int8/matmul_int8.h"
 #include "nnacl/common_func.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
 #include "include/errorcode.h"
 #include "src/litert/kernel_registry.h"
 
@@ -94,7 +97,11 @@ kernel::LiteKernel *MatmulInt8CPUKernelCreator(const std::vector<lite::Tensor *>
       MS_LOG(ERROR) << "kernel: " << parameter->name_ << " is unsupported A is const.";
       return nullptr;
     }
-    if (lite::IsSupportSDot() || ctx->instructions_ctx_.support_sdot) {
+    bool support_dot = lite::IsSupportSDot() || ctx->instructions_ctx_.support_sdot;
+#ifdef ENABLE_AVX512
+    support_dot = support_dot || X86_Avx512Vnni_Support();
+#endif
+    if (support_dot) {
       kernel = new (std::nothrow) MatMulDynamicSdotInt8Kernel(parameter, inputs, outputs, ctx);
     } else {
       kernel = new (std::nothrow) MatmulDynamicInt8CPUKernel(parameter, inputs, outputs, ctx);
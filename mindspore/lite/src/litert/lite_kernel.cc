@@ -16,6 +16,7 @@
 
 #include "src/litert/lite_kernel.h"
 #include <algorithm>
+#include <chrono>
 #include "src/tensor.h"
 #include "src/common/utils.h"
 #include "src/litert/infer_manager.h"
@@ -84,6 +85,13 @@ int LiteKernel::UpdateThreadNumProcess(int32_t kernel_type, int64_t per_unit_loa
                                        int64_t unit_num) {
   thread_num_ =
     lite::UpdateThreadNum(kernel_type, per_unit_load_num, per_unit_store_num, unit_num, op_parameter_->thread_num_);
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
+  if (ms_context_ != nullptr && ms_context_->thread_num_tuner_ != nullptr) {
+    thread_num_key_ = {kernel_type, per_unit_load_num, per_unit_store_num, unit_num, op_parameter_->thread_num_};
+    thread_num_ = ms_context_->thread_num_tuner_->GetThreadNum(thread_num_key_, thread_num_, &tuning_thread_num_);
+    tuned_thread_num_ = thread_num_;
+  }
+#endif
   return lite::RET_OK;
 }
 
@@ -101,6 +109,30 @@ int LiteKernel::UpdateThreadNumPass(int32_t kernel_type, int64_t per_unit_load_n
   return lite::RET_OK;
 }
 
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
+int LiteKernel::RunWithThreadNumTuning() {
+  auto start = std::chrono::steady_clock::now();
+  auto ret = Run();
+  if (ret != lite::RET_OK) {
+    return ret;
+  }
+  auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  // report the candidate rather than thread_num_, the candidate is measured even if the kernel clamps it, and the
+  // decision is clamped in the same way when it's applied.
+  auto next_thread_num =
+    ms_context_->thread_num_tuner_->Report(thread_num_key_, tuned_thread_num_, cost, &tuning_thread_num_);
+  if (next_thread_num == tuned_thread_num_) {
+    return lite::RET_OK;
+  }
+  // the kernels split their task by the thread num in ReSize, which gets the next thread num from the tuner.
+  ret = ReSize();
+  if (ret != lite::RET_OK) {
+    MS_LOG(ERROR) << "resize kernel " << name() << " with thread num " << next_thread_num << " failed.";
+  }
+  return ret;
+}
+#endif
+
 int LiteKernel::Execute() {
   auto ret = PreProcess();
   if (lite::RET_OK != ret) {
@@ -110,7 +142,11 @@ int LiteKernel::Execute() {
 
   /* op_parameter_ is null : run in kernel mod */
   if (op_parameter_ == nullptr || op_parameter_->is_zero_shape_ == false) {
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
+    ret = MS_UNLIKELY(tuning_thread_num_) ? RunWithThreadNumTuning() : Run();
+#else
     ret = Run();
+#endif
     if (lite::RET_OK != ret) {
       MS_LOG(ERROR) << "run kernel failed, name: " << this->name();
       return ret;
@@ -188,6 +188,9 @@ class MS_API LiteKernel : public Abstractkernel {
   virtual int UpdateThreadNumProcess(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num,
                                      int64_t unit_num);
   int UpdateThreadNumPass(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num, int64_t unit_num);
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
+  int RunWithThreadNumTuning();
+#endif
 
  protected:
   OpParameter *op_parameter_ = nullptr;
@@ -202,6 +205,12 @@ class MS_API LiteKernel : public Abstractkernel {
   const lite::InnerContext *ms_context_ = nullptr;
 
   int thread_num_ = 1;
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
+  bool tuning_thread_num_ = false;
+  lite::ThreadNumKey thread_num_key_;
+  // The thread num given by the tuner, some kernels clamp thread_num_ by their task after ReSize.
+  int tuned_thread_num_ = 1;
+#endif
 };
 }  // namespace mindspore::kernel
 
@@ -585,6 +585,14 @@ int LiteSession::CompileGraph(Model *model) {
     MS_LOG(ERROR) << "StoreOriginTensorData failed.";
     return RET_ERROR;
   }
+  if (!is_train_session_) {
+    ret = lite::PackWeightManager::GetInstance()->InitPackedWeightFile(model, tensors_, config_info_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "InitPackedWeightFile failed.";
+      return RET_ERROR;
+    }
+    packed_weight_model_ = model;
+  }
   InitGraphInputTensors(model);
   InitGraphOutputTensors(model);
 
@@ -603,6 +611,8 @@ int LiteSession::CompileGraph(Model *model) {
     return ret;
   }
   infer_along_running_ = infer_along_running_ && !is_control_flow_ && !is_train_session_ && (is_infershape_ != RET_OK);
+  // the kernels of the control flow or inferring along running depend on the order of execution.
+  context_->enable_inter_op_parallel_ = context_->enable_inter_op_parallel_ && !is_control_flow_ && !infer_along_running_;
   InitGraphInOutTensorsMap(model);
 
   non_tail_call_kernels_ = scheduler.NonTailCallNodes();
@@ -882,6 +892,10 @@ int LiteSession::RunGraph(const KernelCallBack &before, const KernelCallBack &af
   ret = executor_->Run(this->inputs_, this->outputs_, this->kernels_, before, after);
   if (MS_UNLIKELY(ret != RET_OK)) {
     MS_LOG(ERROR) << "RunGraph failed : " << ret;
+  } else if (MS_UNLIKELY(!packed_weight_saved_)) {
+    // the kernels which pack the weight in runtime have packed it after the first run.
+    (void)lite::PackWeightManager::GetInstance()->SavePackedWeightFile(packed_weight_model_);
+    packed_weight_saved_ = true;
   }
   if (infer_along_running_) {
     this->context_->set_infer_checker(InferCheckerInput);
@@ -948,6 +962,33 @@ int LiteSession::ContextInit(const std::shared_ptr<InnerContext> &context) {
     return RET_NULL_PTR;
   }
 
+  context_->enable_bf16_ = false;
+  context_->enable_inter_op_parallel_ = false;
+  if (config_info_ != nullptr) {
+    auto cpu_context_item = config_info_->find(kCpuContextSection);
+    if (cpu_context_item != config_info_->end()) {
+      auto bf16_item = cpu_context_item->second.find(kEnableBf16Key);
+      if (bf16_item != cpu_context_item->second.end() && bf16_item->second == "true") {
+#ifdef ENABLE_AVX512
+        context_->enable_bf16_ = X86_Avx512Bf16_Support();
+#endif
+        MS_LOG(INFO) << "enable bf16: " << context_->enable_bf16_;
+      }
+      auto inter_op_item = cpu_context_item->second.find(kEnableInterOpParallelKey);
+      if (inter_op_item != cpu_context_item->second.end() && inter_op_item->second == "true") {
+        context_->enable_inter_op_parallel_ = !is_train_session_;
+        MS_LOG(INFO) << "enable inter-op parallel: " << context_->enable_inter_op_parallel_;
+      }
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
+      auto profile_item = cpu_context_item->second.find(kThreadNumProfileKey);
+      if (profile_item != cpu_context_item->second.end() && !profile_item->second.empty()) {
+        context_->thread_num_tuner_ = std::make_shared<ThreadNumTuner>(profile_item->second);
+        (void)context_->thread_num_tuner_->Load();
+      }
+#endif
+    }
+  }
+
 #ifdef MS_COMPILE_IOS
   context_->thread_pool_->SetMaxSpinCount(kDefaulLiteIosSpinCount);
   context_->thread_pool_->SetMinSpinCount(kDefaulLiteIosSpinCount);
@@ -1238,6 +1279,7 @@ LiteSession::~LiteSession() {
   ParallelThreadPoolManager::GetInstance()->ResetParallelThreadPoolManager(runner_id_);
 #endif
   lite::PackWeightManager::GetInstance()->FreePackWeight(runner_id_, model_id_);
+  lite::PackWeightManager::GetInstance()->FreePackedWeightFile(packed_weight_model_);
   if (model_ != nullptr && is_shared_weight_) {
     model_->buf = nullptr;
   }
@@ -1576,6 +1618,10 @@ int LiteSession::RuntimeAllocatorValid() {
     MS_LOG(DEBUG) << "Not support runtime allocator in subgraph parallel.";
     return RET_ERROR;
   }
+  if (context_->enable_inter_op_parallel_) {
+    MS_LOG(DEBUG) << "Not support runtime allocator in inter-op parallel, the lifetime of tensors is not sequential.";
+    return RET_ERROR;
+  }
   if (is_train_session_ == true) {
     MS_LOG(DEBUG) << "Not support runtime allocator in train session.";
     return RET_ERROR;
@@ -1588,11 +1634,14 @@ int LiteSession::RuntimeAllocatorValid() {
     MS_LOG(DEBUG) << "Not support runtime allocator in random subgraph sort";
     return RET_ERROR;
   }
-#ifdef ENABLE_ARM64
+#if defined(ENABLE_ARM64) || defined(__x86_64__)
+  // The offsets are aligned to 64 bytes, so the planned memory is valid for the simd kernels of arm64 and x86_64.
   MS_LOG(DEBUG) << "support runtime allocator.";
   return RET_OK;
-#endif
+#else
+  MS_LOG(DEBUG) << "Not support runtime allocator on this platform, only arm64 and x86_64 are supported.";
   return RET_ERROR;
+#endif
 }
 
 void LiteSession::RuntimeAllocatorInitGraphOutput() {
@@ -1626,15 +1675,15 @@ void RuntimeAllocatorInitSubgraphInputs(const kernel::KernelExec *subgraph, cons
       in_tensor->set_allocator(src_t->allocator());
       if (src_t->allocator() == runtime_allocator) {
         (*tensor_ref_count)[in_tensor] = in_tensor->init_ref_count();
-        (*data_ref_count)[runtime_allocator->GetOffsetMap().at(src_t)] += in_tensor->init_ref_count();
-        runtime_allocator->SetDataOffset(in_tensor, runtime_allocator->GetOffsetMap().at(src_t));
+        (*data_ref_count)[runtime_allocator->GetBlockMap().at(src_t)] += in_tensor->init_ref_count();
+        runtime_allocator->ShareTensorData(in_tensor, src_t);
       }
     } else {
       if (in_tensor->allocator() == default_allocator) {
         in_tensor->set_allocator(runtime_allocator);
         runtime_allocator->MallocTensorData(in_tensor);
         (*tensor_ref_count)[in_tensor] = in_tensor->init_ref_count();
-        (*data_ref_count)[runtime_allocator->GetOffsetMap().at(in_tensor)] = in_tensor->init_ref_count();
+        (*data_ref_count)[runtime_allocator->GetBlockMap().at(in_tensor)] = in_tensor->init_ref_count();
       }
     }
 
@@ -1643,10 +1692,10 @@ void RuntimeAllocatorInitSubgraphInputs(const kernel::KernelExec *subgraph, cons
     }
 
     (*tensor_ref_count)[src_t]--;
-    (*data_ref_count)[runtime_allocator->GetOffsetMap().at(src_t)]--;
+    (*data_ref_count)[runtime_allocator->GetBlockMap().at(src_t)]--;
 
     if ((*tensor_ref_count)[src_t] <= 0) {
-      if ((*data_ref_count)[runtime_allocator->GetOffsetMap().at(src_t)] <= 0) {
+      if ((*data_ref_count)[runtime_allocator->GetBlockMap().at(src_t)] <= 0) {
         runtime_allocator->FreeTensorData(src_t);
       }
     }
@@ -1676,7 +1725,18 @@ void LiteSession::RuntimeAllocatorInitSubgraph() {
         tensor->set_allocator(runtime_allocator_);
         runtime_allocator_->MallocTensorData(tensor);
         tensor_ref_count[tensor] = tensor->init_ref_count();
-        data_ref_count[runtime_allocator_->GetOffsetMap().at(tensor)] = tensor->init_ref_count();
+        data_ref_count[runtime_allocator_->GetBlockMap().at(tensor)] = tensor->init_ref_count();
+      }
+
+      /* workspace only lives when the kernel is running */
+      if (kernel->IsBuiltin()) {
+        auto lite_kernel = static_cast<kernel::LiteKernel *>(kernel->kernel());
+        auto workspace_size = lite_kernel->workspace_size();
+        if (workspace_size > 0 && lite_kernel->workspace() == nullptr) {
+          auto block_id = runtime_allocator_->MallocBlock(workspace_size);
+          runtime_allocator_->FreeBlock(block_id);
+          runtime_workspace_map_[lite_kernel] = block_id;
+        }
       }
 
       /* free input after run */
@@ -1685,10 +1745,10 @@ void LiteSession::RuntimeAllocatorInitSubgraph() {
           continue;
         }
         tensor_ref_count[tensor]--;
-        data_ref_count[runtime_allocator_->GetOffsetMap().at(tensor)]--;
+        data_ref_count[runtime_allocator_->GetBlockMap().at(tensor)]--;
 
         if (tensor_ref_count[tensor] <= 0 && tensor->allocator() == runtime_allocator_) {
-          if (data_ref_count[runtime_allocator_->GetOffsetMap().at(tensor)] <= 0) {
+          if (data_ref_count[runtime_allocator_->GetBlockMap().at(tensor)] <= 0) {
             runtime_allocator_->FreeTensorData(tensor);
           }
         }
@@ -1699,6 +1759,11 @@ void LiteSession::RuntimeAllocatorInitSubgraph() {
 }
 
 int LiteSession::RuntimeAllocatorInit() {
+  // The workspace may be resized, it's planned again with the tensors.
+  for (auto &iter : runtime_workspace_map_) {
+    iter.first->set_workspace(nullptr);
+  }
+  runtime_workspace_map_.clear();
   if (RuntimeAllocatorValid() != RET_OK) {
     return RET_OK;
   }
@@ -1734,14 +1799,15 @@ int LiteSession::RuntimeAllocatorSetData() {
     return RET_ERROR;
   }
   int8_t *int8_data = reinterpret_cast<int8_t *>(data);
-  auto offset_map = runtime_allocator_->GetOffsetMap();
-
-  for (auto &iter : offset_map) {
+  for (auto &iter : runtime_allocator_->GetBlockMap()) {
     auto tensor = iter.first;
     if (tensor->allocator() != runtime_allocator_) {
       return RET_ERROR;
     }
-    tensor->set_data(int8_data + iter.second);
+    tensor->set_data(int8_data + runtime_allocator_->GetBlockOffset(iter.second));
+  }
+  for (auto &iter : runtime_workspace_map_) {
+    iter.first->set_workspace(int8_data + runtime_allocator_->GetBlockOffset(iter.second));
   }
   return RET_OK;
 }
@@ -192,6 +192,7 @@ class MS_API LiteSession {
   void RuntimeAllocatorInitSubgraph();
   virtual int RuntimeAllocatorValid();
   RuntimeAllocatorPtr runtime_allocator_ = nullptr;
+  std::unordered_map<kernel::LiteKernel *, size_t> runtime_workspace_map_; /* <kernel, block of its workspace> */
 
  private:
   int AscendInit(const std::shared_ptr<InnerContext> &context);
@@ -249,6 +250,8 @@ class MS_API LiteSession {
   std::string runner_id_;
   int worker_id_;
   bool is_shared_weight_ = false;
+  const Model *packed_weight_model_ = nullptr; /* the model whose packed weights are kept in the packed weight file */
+  bool packed_weight_saved_ = false;
 };
 }  // namespace lite
 }  // namespace mindspore
@@ -17,6 +17,8 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <utility>
+#include "src/common/common.h"
 #include "src/common/graph_util.h"
 namespace mindspore::lite {
 namespace {
@@ -221,17 +223,114 @@ void *PackWeightManager::MallocData(size_t size) {
   return data;
 }
 
+STATUS PackWeightManager::InitPackedWeightFile(
+  const Model *model, const std::vector<Tensor *> &all_tensors,
+  const std::map<std::string, std::map<std::string, std::string>> *config_info) {
+  if (model == nullptr || config_info == nullptr) {
+    return RET_OK;
+  }
+  auto section = config_info->find(kCpuContextSection);
+  if (section == config_info->end()) {
+    return RET_OK;
+  }
+  auto item = section->second.find(kPackedWeightFileKey);
+  if (item == section->second.end() || item->second.empty()) {
+    return RET_OK;
+  }
+  if (model->buf == nullptr || model->buf_size_ == 0) {
+    MS_LOG(WARNING) << "model buf is released, packed weight file is not used.";
+    return RET_OK;
+  }
+  // the packed layout depends on the cpu context too, so the config is hashed with the model.
+  std::string cpu_config;
+  for (const auto &config : section->second) {
+    cpu_config += config.first + "=" + config.second + ";";
+  }
+  auto config_hash = PackedWeightFile::Hash(cpu_config.data(), cpu_config.size(), 0);
+  auto model_hash = PackedWeightFile::Hash(model->buf, model->buf_size_, config_hash);
+  auto file = std::make_shared<PackedWeightFile>(item->second, model_hash, model->buf_size_);
+  if (file->Load() != RET_OK) {
+    return RET_OK;
+  }
+  std::unique_lock<std::mutex> l(file_mutex_);
+  packed_weight_files_[model] = file;
+  for (size_t i = 0; i < all_tensors.size(); i++) {
+    auto tensor = all_tensors[i];
+    if (tensor != nullptr && tensor->IsConst() && tensor->data() != nullptr) {
+      file_tensors_[tensor->data()] = std::make_pair(file.get(), static_cast<uint32_t>(i));
+    }
+  }
+  return RET_OK;
+}
+
+STATUS PackWeightManager::SavePackedWeightFile(const Model *model) {
+  std::unique_lock<std::mutex> l(file_mutex_);
+  auto iter = packed_weight_files_.find(model);
+  if (iter == packed_weight_files_.end()) {
+    return RET_OK;
+  }
+  return iter->second->Save();
+}
+
+void PackWeightManager::FreePackedWeightFile(const Model *model) {
+  std::unique_lock<std::mutex> l(file_mutex_);
+  auto iter = packed_weight_files_.find(model);
+  if (iter == packed_weight_files_.end()) {
+    return;
+  }
+  auto file = iter->second.get();
+  for (auto tensor_iter = file_tensors_.begin(); tensor_iter != file_tensors_.end();) {
+    if (tensor_iter->second.first == file) {
+      tensor_iter = file_tensors_.erase(tensor_iter);
+    } else {
+      ++tensor_iter;
+    }
+  }
+  (void)packed_weight_files_.erase(iter);
+}
+
+void *PackWeightManager::GetFilePackData(const void *tensor_data, const size_t size, bool *is_packed) {
+  std::unique_lock<std::mutex> l(file_mutex_);
+  auto iter = file_tensors_.find(tensor_data);
+  if (iter == file_tensors_.end()) {
+    return nullptr;
+  }
+  auto data = iter->second.first->GetPackData(iter->second.second, size);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  // the mapped data is read-only, the kernels never write the packed weight when it is packed.
+  *is_packed = true;
+  return const_cast<void *>(data);
+}
+
+void PackWeightManager::RecordFilePackData(const void *tensor_data, const size_t size, const void *pack_data) {
+  std::unique_lock<std::mutex> l(file_mutex_);
+  auto iter = file_tensors_.find(tensor_data);
+  if (iter != file_tensors_.end()) {
+    iter->second.first->Record(iter->second.second, size, pack_data);
+  }
+}
+
 void *PackWeightManager::GetPackData(const void *tensor_data, const size_t size, bool *is_packed) {
+  auto file_data = GetFilePackData(tensor_data, size, is_packed);
+  if (file_data != nullptr) {
+    return file_data;
+  }
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     void *data = MallocData(size);
     *is_packed = false;
+    RecordFilePackData(tensor_data, size, data);
     return data;
   }
-  return pack_weight_->GetPackData(tensor_data, size, is_packed);
+  auto shared_data = pack_weight_->GetPackData(tensor_data, size, is_packed);
+  RecordFilePackData(tensor_data, size, shared_data);
+  return shared_data;
 #endif
   void *data = MallocData(size);
   *is_packed = false;
+  RecordFilePackData(tensor_data, size, data);
   return data;
 }
 
@@ -247,6 +346,15 @@ void PackWeightManager::FreeData(void *tensor_data) {
 }
 
 void PackWeightManager::Free(void *tensor_data) {
+  {
+    std::unique_lock<std::mutex> l(file_mutex_);
+    for (const auto &file : packed_weight_files_) {
+      if (file.second->IsMappedData(tensor_data)) {
+        return;
+      }
+      file.second->Erase(tensor_data);
+    }
+  }
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     FreeData(tensor_data);
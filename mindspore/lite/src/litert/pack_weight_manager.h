@@ -17,13 +17,16 @@
 #ifndef MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_MANAGER_H_
 #define MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_MANAGER_H_
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <map>
 #include <string>
+#include <utility>
 #include "include/model.h"
 #include "include/errorcode.h"
 #include "src/tensor.h"
+#include "src/litert/packed_weight_file.h"
 #ifdef SHARING_MODEL_WEIGHT
 #include "src/litert/pack_weight.h"
 #endif
@@ -38,6 +41,12 @@ class PackWeightManager {
                           const std::map<std::string, std::map<std::string, std::string>> *config_info,
                           bool *is_shared);
   STATUS StoreOriginTensorData(Model *model, std::vector<Tensor *> *all_tensors);
+  // The packed weight file of the model is mapped if it is valid, otherwise the packed weights of the model are
+  // recorded and saved by SavePackedWeightFile.
+  STATUS InitPackedWeightFile(const Model *model, const std::vector<Tensor *> &all_tensors,
+                              const std::map<std::string, std::map<std::string, std::string>> *config_info);
+  STATUS SavePackedWeightFile(const Model *model);
+  void FreePackedWeightFile(const Model *model);
   void *GetPackData(const void *tensor_data, const size_t size, bool *is_packed);
   void Free(void *tensor_data);
   bool IsCopyTensor(int op_type);
@@ -48,6 +57,8 @@ class PackWeightManager {
  private:
   void *MallocData(size_t size);
   void FreeData(void *tensor_data);
+  void *GetFilePackData(const void *tensor_data, const size_t size, bool *is_packed);
+  void RecordFilePackData(const void *tensor_data, const size_t size, const void *pack_data);
   PackWeightManager() = default;
   bool is_parallel_ = false;
 #ifdef SHARING_MODEL_WEIGHT
@@ -56,6 +67,10 @@ class PackWeightManager {
   std::mutex manager_mutex_;
   std::vector<std::string> model_ids_;
   size_t model_id_ = 1;
+  std::mutex file_mutex_;
+  std::unordered_map<const Model *, std::shared_ptr<PackedWeightFile>> packed_weight_files_;
+  // <origin data of the const tensor, <packed weight file of its model, tensor index>>
+  std::unordered_map<const void *, std::pair<PackedWeightFile *, uint32_t>> file_tensors_;
 };
 }  // namespace mindspore::lite
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_PACK_WEIGHT_MANAGER_H_
@@ -0,0 +1,237 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/packed_weight_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <unistd.h>
+#endif
+#include "src/common/log_adapter.h"
+#include "src/common/mmap_utils.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+namespace mindspore::lite {
+namespace {
+constexpr char kPackedWeightMagic[8] = "MSPACKW";
+constexpr uint32_t kPackedWeightVersion = 1;
+constexpr size_t kPackedWeightAlign = 64;
+constexpr size_t kIsaTagLen = 32;
+constexpr uint64_t kHashPrime = 0x100000001b3ULL;
+
+struct PackedWeightHeader {
+  char magic[sizeof(kPackedWeightMagic)];
+  uint32_t version;
+  uint32_t entry_num;
+  uint64_t model_size;
+  uint64_t model_hash;
+  char isa[kIsaTagLen];
+};
+
+struct PackedWeightEntry {
+  uint32_t tensor_index;
+  uint32_t reserved;
+  uint64_t size;
+  uint64_t offset;
+};
+
+size_t AlignUp(size_t size) { return (size + kPackedWeightAlign - 1) / kPackedWeightAlign * kPackedWeightAlign; }
+}  // namespace
+
+PackedWeightFile::PackedWeightFile(std::string path, uint64_t model_hash, uint64_t model_size)
+    : path_(std::move(path)), model_hash_(model_hash), model_size_(model_size) {}
+
+PackedWeightFile::~PackedWeightFile() {
+  if (mmap_buf_ != nullptr) {
+    UnmapMmapBuffer(mmap_buf_, mmap_size_);
+    mmap_buf_ = nullptr;
+  }
+}
+
+std::string PackedWeightFile::IsaTag() {
+#if defined(ENABLE_AVX512)
+  return X86_Avx512_Support() ? "x86_avx512" : "x86_avx";
+#elif defined(ENABLE_AVX)
+  return "x86_avx";
+#elif defined(ENABLE_SSE)
+  return "x86_sse";
+#elif defined(ENABLE_ARM64)
+  return "arm64";
+#elif defined(ENABLE_ARM32)
+  return "arm32";
+#else
+  return "generic";
+#endif
+}
+
+uint64_t PackedWeightFile::Hash(const void *buf, size_t size, uint64_t seed) {
+  // fnv-1a on 8-byte words, the whole model is hashed at load time so it has to run at memory bandwidth.
+  auto data = reinterpret_cast<const uint8_t *>(buf);
+  uint64_t hash = seed ^ size;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(uint64_t));
+    hash = (hash ^ word) * kHashPrime;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ data[i]) * kHashPrime;
+  }
+  return hash;
+}
+
+int PackedWeightFile::Load() {
+#if defined(_WIN32) || defined(_WIN64) || defined(MS_COMPILE_IOS)
+  MS_LOG(WARNING) << "Packed weight file is unsupported on this platform.";
+  return RET_NOT_SUPPORT;
+#else
+  if (access(path_.c_str(), R_OK) != 0) {
+    MS_LOG(INFO) << "Packed weight file " << path_ << " doesn't exist, it will be saved after the first run.";
+    return RET_OK;
+  }
+  mmap_buf_ = ReadFileByMmap(path_, &mmap_size_);
+  if (mmap_buf_ == nullptr) {
+    MS_LOG(WARNING) << "Map packed weight file " << path_ << " failed, it will be saved again.";
+    return RET_OK;
+  }
+  auto invalid = [this](const std::string &reason) {
+    MS_LOG(WARNING) << "Packed weight file " << path_ << " is invalid: " << reason << ", it will be saved again.";
+    UnmapMmapBuffer(mmap_buf_, mmap_size_);
+    mmap_buf_ = nullptr;
+    mmap_size_ = 0;
+    offsets_.clear();
+    return RET_OK;
+  };
+  if (mmap_size_ < sizeof(PackedWeightHeader)) {
+    return invalid("file is too small");
+  }
+  auto header = reinterpret_cast<const PackedWeightHeader *>(mmap_buf_);
+  if (memcmp(header->magic, kPackedWeightMagic, sizeof(kPackedWeightMagic)) != 0 ||
+      header->version != kPackedWeightVersion) {
+    return invalid("magic or version mismatches");
+  }
+  if (header->model_size != model_size_ || header->model_hash != model_hash_) {
+    return invalid("it is saved for another model or config");
+  }
+  if (strncmp(header->isa, IsaTag().c_str(), kIsaTagLen) != 0) {
+    return invalid("it is saved for isa " + std::string(header->isa, strnlen(header->isa, kIsaTagLen)));
+  }
+  size_t entries_end = sizeof(PackedWeightHeader) + static_cast<size_t>(header->entry_num) * sizeof(PackedWeightEntry);
+  if (header->entry_num > mmap_size_ / sizeof(PackedWeightEntry) || entries_end > mmap_size_) {
+    return invalid("entries are out of range");
+  }
+  auto entries = reinterpret_cast<const PackedWeightEntry *>(header + 1);
+  for (uint32_t i = 0; i < header->entry_num; i++) {
+    const auto &entry = entries[i];
+    if (entry.offset < entries_end || entry.offset % kPackedWeightAlign != 0 || entry.size > mmap_size_ ||
+        entry.offset > mmap_size_ - entry.size) {
+      return invalid("packed data is out of range");
+    }
+    offsets_[{entry.tensor_index, static_cast<size_t>(entry.size)}] = static_cast<size_t>(entry.offset);
+  }
+  MS_LOG(INFO) << "Map packed weight file " << path_ << ", packed weight num: " << offsets_.size();
+  return RET_OK;
+#endif
+}
+
+const void *PackedWeightFile::GetPackData(uint32_t tensor_index, size_t size) const {
+  if (mmap_buf_ == nullptr) {
+    return nullptr;
+  }
+  auto iter = offsets_.find({tensor_index, size});
+  if (iter == offsets_.end()) {
+    return nullptr;
+  }
+  return reinterpret_cast<const uint8_t *>(mmap_buf_) + iter->second;
+}
+
+void PackedWeightFile::Record(uint32_t tensor_index, size_t size, const void *data) {
+  if (mmap_buf_ != nullptr || data == nullptr || size == 0) {
+    return;
+  }
+  records_[{tensor_index, size}] = data;
+}
+
+void PackedWeightFile::Erase(const void *data) {
+  for (auto iter = records_.begin(); iter != records_.end();) {
+    if (iter->second == data) {
+      iter = records_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+int PackedWeightFile::Save() {
+#if defined(_WIN32) || defined(_WIN64) || defined(MS_COMPILE_IOS)
+  return RET_NOT_SUPPORT;
+#else
+  if (mmap_buf_ != nullptr || records_.empty()) {
+    records_.clear();
+    return RET_OK;
+  }
+  PackedWeightHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kPackedWeightMagic, sizeof(kPackedWeightMagic));
+  header.version = kPackedWeightVersion;
+  header.entry_num = static_cast<uint32_t>(records_.size());
+  header.model_size = model_size_;
+  header.model_hash = model_hash_;
+  auto isa = IsaTag();
+  memcpy(header.isa, isa.c_str(), std::min(isa.size(), kIsaTagLen - 1));
+
+  std::vector<PackedWeightEntry> entries;
+  size_t offset = AlignUp(sizeof(PackedWeightHeader) + records_.size() * sizeof(PackedWeightEntry));
+  for (const auto &record : records_) {
+    entries.push_back({record.first.first, 0, record.first.second, offset});
+    offset = AlignUp(offset + record.first.second);
+  }
+
+  auto tmp_path = path_ + ".tmp" + std::to_string(getpid());
+  std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+  if (!ofs.good()) {
+    MS_LOG(WARNING) << "Open packed weight file " << tmp_path << " failed.";
+    records_.clear();
+    return RET_ERROR;
+  }
+  const std::vector<char> padding(kPackedWeightAlign, 0);
+  (void)ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  (void)ofs.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(PackedWeightEntry));
+  size_t written = sizeof(header) + entries.size() * sizeof(PackedWeightEntry);
+  size_t i = 0;
+  for (const auto &record : records_) {
+    (void)ofs.write(padding.data(), entries[i].offset - written);
+    (void)ofs.write(reinterpret_cast<const char *>(record.second), record.first.second);
+    written = entries[i].offset + record.first.second;
+    i++;
+  }
+  ofs.close();
+  records_.clear();
+  if (ofs.fail() || rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    MS_LOG(WARNING) << "Write packed weight file " << path_ << " failed.";
+    (void)remove(tmp_path.c_str());
+    return RET_ERROR;
+  }
+  MS_LOG(INFO) << "Save packed weight file " << path_ << ", size: " << written;
+  return RET_OK;
+#endif
+}
+}  // namespace mindspore::lite
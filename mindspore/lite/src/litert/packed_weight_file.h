@@ -0,0 +1,68 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_FILE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_FILE_H_
+#include <map>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+// The sidecar file of a model which keeps the weights packed by the cpu kernels for one isa. The first load of the model
+// records the packed weights and saves them to the file, the later loads map the file read-only, so the processes
+// loading the same model share the packed weights in the page cache and skip the packing.
+//
+// File layout: header | entries | packed data, the packed data of every entry is aligned to kPackedWeightAlign.
+class PackedWeightFile {
+ public:
+  PackedWeightFile(std::string path, uint64_t model_hash, uint64_t model_size);
+  ~PackedWeightFile();
+
+  // Map the file if it is saved for the same model and isa, otherwise the packed weights are recorded to be saved.
+  int Load();
+  bool IsMapped() const { return mmap_buf_ != nullptr; }
+  // Return the packed data of the tensor in the mapped file, nullptr if the file doesn't contain it.
+  const void *GetPackData(uint32_t tensor_index, size_t size) const;
+  bool IsMappedData(const void *data) const {
+    auto addr = reinterpret_cast<const uint8_t *>(data);
+    auto base = reinterpret_cast<const uint8_t *>(mmap_buf_);
+    return mmap_buf_ != nullptr && addr >= base && addr < base + mmap_size_;
+  }
+  // Record the packed data of the tensor, the data must be alive until the file is saved.
+  void Record(uint32_t tensor_index, size_t size, const void *data);
+  void Erase(const void *data);
+  // Write the recorded packed data to a temporary file and rename it to the path, so that the processes loading the
+  // model at the same time never see a partial file.
+  int Save();
+
+  static std::string IsaTag();
+  static uint64_t Hash(const void *buf, size_t size, uint64_t seed);
+
+ private:
+  using EntryKey = std::pair<uint32_t, size_t>;  // <tensor index, packed size>
+
+  std::string path_;
+  uint64_t model_hash_;
+  uint64_t model_size_;
+  void *mmap_buf_ = nullptr;
+  size_t mmap_size_ = 0;
+  std::map<EntryKey, size_t> offsets_;  // offset of the packed data in the mapped file
+  std::map<EntryKey, const void *> records_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_PACKED_WEIGHT_FILE_H_
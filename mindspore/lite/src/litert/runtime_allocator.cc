@@ -15,109 +15,200 @@
  */
 
 #include "src/litert/runtime_allocator.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#include "src/common/log_adapter.h"
 
 namespace mindspore {
+namespace {
+constexpr size_t kBlockAlive = std::numeric_limits<size_t>::max();
+constexpr size_t kNoOffset = std::numeric_limits<size_t>::max();
+#if defined(__linux__)
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+#endif
+
+size_t AlignUp(size_t size, size_t align) { return (size + align - 1) / align * align; }
+}  // namespace
+
 RuntimeAllocator::RuntimeAllocator(size_t aligned_size) {
   aligned_size_ = aligned_size;
   return;
 }
 
-RuntimeAllocator::~RuntimeAllocator() {
-  if (data_ != nullptr) {
-    free(data_);
-    data_ = nullptr;
+RuntimeAllocator::~RuntimeAllocator() { FreeArena(); }
+
+size_t RuntimeAllocator::MallocBlock(size_t size) {
+  // The empty tensor gets a block as well, so that its data is not null.
+  blocks_.push_back({AlignUp(std::max<size_t>(size, 1), aligned_size_), step_++, kBlockAlive, 0});
+  return blocks_.size() - 1;
+}
+
+void RuntimeAllocator::FreeBlock(size_t block_id) {
+  if (block_id < blocks_.size() && blocks_[block_id].end == kBlockAlive) {
+    blocks_[block_id].end = step_++;
   }
 }
 
-void *RuntimeAllocator::MallocOptData() {
-  if (data_ == nullptr) {
-    data_ = malloc(total_size_);
+void RuntimeAllocator::MallocTensorData(lite::Tensor *tensor) { block_map_[tensor] = MallocBlock(tensor->Size()); }
+
+void RuntimeAllocator::FreeTensorData(lite::Tensor *tensor) {
+  auto iter = block_map_.find(tensor);
+  if (iter != block_map_.end()) {
+    FreeBlock(iter->second);
   }
-  return data_;
 }
 
-size_t RuntimeAllocator::FindMinFree(size_t size) {
-  size_t min_size = total_size_ + 1;
-  size_t min_addr = total_size_ + 1;
-  for (auto const &itr : free_list_) {
-    if (itr.second >= size && min_size > itr.second) {
-      min_size = itr.second;
-      min_addr = itr.first;
-    }
+void RuntimeAllocator::ShareTensorData(lite::Tensor *tensor, lite::Tensor *src) {
+  auto iter = block_map_.find(src);
+  if (iter != block_map_.end()) {
+    block_map_[tensor] = iter->second;
   }
-  return min_addr;
 }
 
-void RuntimeAllocator::FreeTensorData(lite::Tensor *tensor) {
-  size_t offset = offset_map_[tensor];
-  free_list_[offset] = used_list_[offset];
-  used_list_.erase(offset);
-
-  size_t length = free_list_[offset];
-
-  size_t post_offset = offset + length;
-  auto post_iter = free_list_.find(post_offset);
-  if (post_iter != free_list_.end()) {
-    size_t post_length = post_iter->second;
-    free_list_[offset] = length + post_length;
-    free_list_.erase(post_offset);
+size_t RuntimeAllocator::blocks_size() const {
+  size_t size = 0;
+  for (auto &block : blocks_) {
+    size += block.size;
   }
+  return size;
+}
 
-  auto pre_iter = free_list_.lower_bound(offset);
-  if (pre_iter != free_list_.begin()) {
-    pre_iter--;
-    size_t pre_offset = pre_iter->first;
-    if ((pre_offset + free_list_[pre_offset]) == offset) {
-      free_list_[pre_offset] = free_list_[pre_offset] + length;
-      free_list_.erase(offset);
+size_t RuntimeAllocator::PlaceBlocks(const std::vector<size_t> &order, std::vector<size_t> *offsets) const {
+  offsets->assign(blocks_.size(), kNoOffset);
+  std::vector<size_t> placed;  // sorted by the offset
+  size_t peak = 0;
+  for (auto id : order) {
+    auto &block = blocks_[id];
+    size_t best_offset = kNoOffset;
+    size_t best_gap = kNoOffset;
+    size_t cur = 0;
+    for (auto placed_id : placed) {
+      auto &other = blocks_[placed_id];
+      if (block.start > other.end || other.start > block.end) {
+        continue;
+      }
+      auto other_offset = offsets->at(placed_id);
+      if (other_offset >= cur && other_offset - cur >= block.size && other_offset - cur < best_gap) {
+        best_gap = other_offset - cur;
+        best_offset = cur;
+      }
+      cur = std::max(cur, other_offset + other.size);
+    }
+    if (best_offset == kNoOffset) {
+      best_offset = cur;
     }
+    offsets->at(id) = best_offset;
+    auto pos = std::upper_bound(placed.begin(), placed.end(), best_offset,
+                                [offsets](size_t offset, size_t placed_id) { return offset < offsets->at(placed_id); });
+    (void)placed.insert(pos, id);
+    peak = std::max(peak, best_offset + block.size);
   }
+  return peak;
 }
 
-void RuntimeAllocator::SetDataOffset(lite::Tensor *tensor, size_t offset) {
-  offset_map_[tensor] = offset;
-  return;
+void RuntimeAllocator::PlanOffsets() {
+  // Several orders are tried as SOMAS does, and the one of the least peak is kept: the larger blocks first, the longer
+  // lived blocks of the same size first, and the order of malloc which is what the first fit does.
+  auto lifetime = [this](const MemBlock &block) { return std::min(block.end, step_) - block.start + 1; };
+  std::vector<size_t> by_size(blocks_.size());
+  for (size_t i = 0; i < blocks_.size(); i++) {
+    by_size[i] = i;
+  }
+  std::vector<size_t> by_malloc = by_size;
+  std::vector<size_t> by_area = by_size;
+  std::stable_sort(by_size.begin(), by_size.end(), [this, &lifetime](size_t a, size_t b) {
+    return blocks_[a].size != blocks_[b].size ? blocks_[a].size > blocks_[b].size
+                                              : lifetime(blocks_[a]) > lifetime(blocks_[b]);
+  });
+  std::stable_sort(by_area.begin(), by_area.end(), [this, &lifetime](size_t a, size_t b) {
+    return static_cast<double>(blocks_[a].size) * lifetime(blocks_[a]) >
+           static_cast<double>(blocks_[b].size) * lifetime(blocks_[b]);
+  });
+  std::vector<size_t> best_offsets;
+  total_size_ = kNoOffset;
+  for (auto &order : {by_size, by_area, by_malloc}) {
+    std::vector<size_t> offsets;
+    auto peak = PlaceBlocks(order, &offsets);
+    if (peak < total_size_) {
+      total_size_ = peak;
+      best_offsets.swap(offsets);
+    }
+  }
+  for (size_t i = 0; i < blocks_.size(); i++) {
+    blocks_[i].offset = best_offsets[i];
+  }
+  if (blocks_.empty()) {
+    total_size_ = 0;
+  }
 }
 
-void RuntimeAllocator::Clear(AllocatorPtr default_allocator) {
-  total_size_ = 0;
-  for (auto iter : offset_map_) {
-    iter.first->set_allocator(default_allocator);
-    iter.first->set_data(nullptr);
-  }
+void *RuntimeAllocator::MallocOptData() {
   if (data_ != nullptr) {
-    free(data_);
-    data_ = nullptr;
+    return data_;
+  }
+  PlanOffsets();
+  MS_LOG(INFO) << "The runtime memory of " << blocks_.size() << " blocks is planned in " << total_size_
+               << " bytes, the sum of the blocks is " << blocks_size() << " bytes.";
+  auto size = std::max(total_size_, aligned_size_);
+#if defined(__linux__)
+  // The big arena is backed by the huge pages, the pages are touched here so that the first run doesn't fault.
+  if (size >= kHugePageSize) {
+    arena_size_ = AlignUp(size, kHugePageSize) + kHugePageSize;
+    auto addr = mmap(nullptr, arena_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr != MAP_FAILED) {
+      arena_ = addr;
+      arena_mapped_ = true;
+      data_ = reinterpret_cast<void *>(AlignUp(reinterpret_cast<uintptr_t>(addr), kHugePageSize));
+#ifdef MADV_HUGEPAGE
+      (void)madvise(data_, AlignUp(size, kHugePageSize), MADV_HUGEPAGE);
+#endif
+      (void)memset(data_, 0, size);
+      return data_;
+    }
+    MS_LOG(WARNING) << "Mmap the runtime memory of " << size << " bytes failed, malloc it instead.";
+  }
+#endif
+  arena_size_ = size + aligned_size_;
+  arena_ = malloc(arena_size_);
+  if (arena_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc the runtime memory of " << size << " bytes failed.";
+    return nullptr;
   }
-  offset_map_.clear();
-  free_list_.clear();
-  used_list_.clear();
+  data_ = reinterpret_cast<void *>(AlignUp(reinterpret_cast<uintptr_t>(arena_), aligned_size_));
+  return data_;
 }
 
-void RuntimeAllocator::MallocTensorData(lite::Tensor *tensor) {
-  size_t size = tensor->Size();
-  size_t offset = FindMinFree(size);
-
-  if (offset > total_size_) {
-    if (free_list_.empty()) {
-      offset = total_size_;
+void RuntimeAllocator::FreeArena() {
+  if (arena_ != nullptr) {
+#if defined(__linux__)
+    if (arena_mapped_) {
+      (void)munmap(arena_, arena_size_);
     } else {
-      offset = free_list_.rbegin()->first;
-      if (offset + free_list_[offset] < total_size_) {
-        offset = total_size_;
-      } else {
-        free_list_.erase(offset);
-      }
+      free(arena_);
     }
-    total_size_ = offset + size;
-  } else {
-    if (free_list_[offset] > size) {
-      free_list_[offset + size] = free_list_[offset] - size;
-    }
-    free_list_.erase(offset);
+#else
+    free(arena_);
+#endif
   }
+  arena_ = nullptr;
+  data_ = nullptr;
+  arena_size_ = 0;
+  arena_mapped_ = false;
+}
 
-  used_list_[offset] = size;
-  offset_map_[tensor] = offset;
+void RuntimeAllocator::Clear(AllocatorPtr default_allocator) {
+  total_size_ = 0;
+  step_ = 0;
+  for (auto iter : block_map_) {
+    iter.first->set_allocator(default_allocator);
+    iter.first->set_data(nullptr);
+  }
+  FreeArena();
+  block_map_.clear();
+  blocks_.clear();
 }
 }  // namespace mindspore
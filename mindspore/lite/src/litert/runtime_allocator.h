@@ -18,16 +18,20 @@
 #define MINDSPORE_LITE_SRC_RUNTIME_RUNTIME_ALLOCATOR_H_
 
 #include <memory>
-#include <map>
 #include <unordered_map>
+#include <vector>
 #include "include/api/allocator.h"
 #include "include/errorcode.h"
 #include "src/tensor.h"
 
 namespace mindspore {
+// Plan the memory of the tensors and the kernel workspaces of the graph in one arena. The session replays the malloc
+// and free of the kernels in the running order, every block lives from the step of its malloc to the step of its free,
+// and the offsets are solved like the SOMAS of ccsrc when the arena is allocated: the blocks are placed one by one in
+// the best fit gap between the placed blocks whose lifetime overlaps. The arena is kept and reused by all the runs.
 class RuntimeAllocator : public Allocator {
  public:
-  explicit RuntimeAllocator(size_t aligned_size = 32);
+  explicit RuntimeAllocator(size_t aligned_size = 64);
   ~RuntimeAllocator() override;
 
  public:
@@ -39,22 +43,43 @@ class RuntimeAllocator : public Allocator {
   int DecRefCount(void *ptr, int ref_count) override { return 0; }
 
  public:
-  void SetDataOffset(lite::Tensor *tensor, size_t offset);
+  // The blocks are identified by the order of malloc.
+  size_t MallocBlock(size_t size);
+  void FreeBlock(size_t block_id);
   void MallocTensorData(lite::Tensor *tensor);
   void FreeTensorData(lite::Tensor *tensor);
+  // The tensor shares the block of the source tensor.
+  void ShareTensorData(lite::Tensor *tensor, lite::Tensor *src);
+  const std::unordered_map<lite::Tensor *, size_t> &GetBlockMap() const { return block_map_; }
+  // Solve the offsets of the blocks and allocate the arena.
   void *MallocOptData();
-  const std::unordered_map<lite::Tensor *, size_t> &GetOffsetMap() const { return offset_map_; }
+  size_t GetBlockOffset(size_t block_id) const { return blocks_.at(block_id).offset; }
+  // The peak memory of the planned arena and the sum of all the blocks without reusing.
+  size_t total_size() const { return total_size_; }
+  size_t blocks_size() const;
   void Clear(AllocatorPtr default_allocator);
 
  private:
-  size_t FindMinFree(size_t size);
+  struct MemBlock {
+    size_t size;
+    size_t start;
+    size_t end;
+    size_t offset;
+  };
+  // Place the blocks in the given order, return the peak memory.
+  size_t PlaceBlocks(const std::vector<size_t> &order, std::vector<size_t> *offsets) const;
+  void PlanOffsets();
+  void FreeArena();
 
  private:
   void *data_ = nullptr;
+  void *arena_ = nullptr;
+  size_t arena_size_ = 0;
+  bool arena_mapped_ = false;
   size_t total_size_ = 0;
-  std::unordered_map<lite::Tensor *, size_t> offset_map_;
-  std::map<size_t, size_t> free_list_; /* offset, size */
-  std::map<size_t, size_t> used_list_; /* offset, size */
+  size_t step_ = 0;
+  std::vector<MemBlock> blocks_;
+  std::unordered_map<lite::Tensor *, size_t> block_map_;
 };
 
 using RuntimeAllocatorPtr = std::shared_ptr<RuntimeAllocator>;
@@ -990,8 +990,9 @@ int Scheduler::FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std:
     }
     cpu_desc.data_type = kNumberTypeFloat16;
   }
+  // The quantized weight of MatMul is kept to save the memory of inference, the fp32 kernel dequantizes it in the gemm.
   auto ret = WeightDecoder::DequantNode(op_parameter, in_tensors, kernel_data_type, src_model_->graph_.version_,
-                                        context_->float_mode);
+                                        context_->float_mode, !is_train_session_);
   if (ret != RET_OK) {
     MS_LOG(DEBUG) << "Dequant input tensors failed: " << ret;
     return RET_NOT_SUPPORT;
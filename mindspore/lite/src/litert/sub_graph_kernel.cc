@@ -28,6 +28,7 @@
 #include "src/common/utils.h"
 #include "src/common/prim_inner.h"
 #include "src/litert/kernel_exec_util.h"
+#include "src/litert/inter_op_parallel_executor.h"
 
 namespace mindspore::kernel {
 using mindspore::lite::RET_ERROR;
@@ -495,11 +496,29 @@ int CpuSubGraph::Prepare() {
       out->set_allocator(this->Context()->allocator);
     }
   }
+  if (this->Context()->enable_inter_op_parallel_ && this->executor_ == nullptr) {
+    auto executor = new (std::nothrow) lite::InterOpParallelExecutor();
+    MS_CHECK_TRUE_MSG(executor != nullptr, RET_ERROR, "new inter-op parallel executor failed.");
+    ret = executor->Prepare(nodes_, this->in_tensors(), this->out_tensors(),
+                            const_cast<lite::InnerContext *>(this->Context()));
+    if (ret != RET_OK) {
+      delete executor;
+      if (ret != lite::RET_NOT_SUPPORT) {
+        MS_LOG(ERROR) << "Prepare inter-op parallel executor of " << this->name() << " failed.";
+        return ret;
+      }
+    } else {
+      this->executor_ = executor;
+    }
+  }
   return RET_OK;
 }
 
 int CpuSubGraph::Execute(const KernelCallBack &before, const KernelCallBack &after) {
   MS_ASSERT(this->Context()->allocator.get() != nullptr);
+  if (this->executor_ != nullptr) {
+    return this->executor_->Run(this->in_tensors(), this->out_tensors(), nodes_, before, after);
+  }
   for (auto *kernel : nodes_) {
     MS_ASSERT(kernel != nullptr);
     auto ret = kernel->Execute(before, after);
@@ -0,0 +1,191 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/litert/thread_num_tuner.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <unistd.h>
+#endif
+#include "src/common/log_adapter.h"
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+namespace {
+// the first run of a candidate is not measured, the threads may be woken up or the cache may be cold.
+constexpr int kSkipSampleNum = 1;
+constexpr int kTuneSampleNum = 3;
+const char kProfileCpuNumTag[] = "cpu_num";
+
+int CpuNum() { return static_cast<int>(std::thread::hardware_concurrency()); }
+}  // namespace
+
+ThreadNumTuner::~ThreadNumTuner() {
+  std::unique_lock<std::mutex> l(mutex_);
+  if (dirty_) {
+    (void)SaveProfile();
+  }
+}
+
+int ThreadNumTuner::Load() {
+  std::unique_lock<std::mutex> l(mutex_);
+  std::ifstream ifs(profile_path_);
+  if (!ifs.good()) {
+    MS_LOG(INFO) << "Thread num profile " << profile_path_ << " doesn't exist, the thread num will be tuned.";
+    return RET_OK;
+  }
+  std::string tag;
+  int cpu_num = 0;
+  if (!(ifs >> tag >> cpu_num) || tag != kProfileCpuNumTag || cpu_num != CpuNum()) {
+    MS_LOG(WARNING) << "Thread num profile " << profile_path_ << " is saved on another machine, it is ignored.";
+    return RET_OK;
+  }
+  ThreadNumKey key;
+  int thread_num = 0;
+  while (ifs >> key.kernel_type_ >> key.per_unit_load_num_ >> key.per_unit_store_num_ >> key.unit_num_ >>
+         key.max_thread_num_ >> thread_num) {
+    if (thread_num < 1 || thread_num > key.max_thread_num_) {
+      continue;
+    }
+    states_[key].best_ = thread_num;
+  }
+  MS_LOG(INFO) << "Load thread num profile " << profile_path_ << ", decided kernel num: " << states_.size();
+  return RET_OK;
+}
+
+int ThreadNumTuner::Save() {
+  std::unique_lock<std::mutex> l(mutex_);
+  return SaveProfile();
+}
+
+int ThreadNumTuner::SaveProfile() {
+  std::ostringstream oss;
+  oss << kProfileCpuNumTag << " " << CpuNum() << "\n";
+  for (const auto &item : states_) {
+    if (item.second.best_ == 0) {
+      continue;
+    }
+    const auto &key = item.first;
+    oss << key.kernel_type_ << " " << key.per_unit_load_num_ << " " << key.per_unit_store_num_ << " " << key.unit_num_
+        << " " << key.max_thread_num_ << " " << item.second.best_ << "\n";
+  }
+  // write to a temporary file and rename it, the processes loading the profile never see a partial file.
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto tmp_path = profile_path_ + ".tmp" + std::to_string(getpid());
+#else
+  auto tmp_path = profile_path_ + ".tmp";
+#endif
+  std::ofstream ofs(tmp_path, std::ios::trunc);
+  if (!ofs.good()) {
+    MS_LOG(WARNING) << "Open thread num profile " << tmp_path << " failed.";
+    return RET_ERROR;
+  }
+  ofs << oss.str();
+  ofs.close();
+  if (ofs.fail() || std::rename(tmp_path.c_str(), profile_path_.c_str()) != 0) {
+    MS_LOG(WARNING) << "Write thread num profile " << profile_path_ << " failed.";
+    (void)std::remove(tmp_path.c_str());
+    return RET_ERROR;
+  }
+  dirty_ = false;
+  MS_LOG(INFO) << "Save thread num profile " << profile_path_;
+  return RET_OK;
+}
+
+int ThreadNumTuner::GetThreadNum(const ThreadNumKey &key, int default_thread_num, bool *tuning) {
+  std::unique_lock<std::mutex> l(mutex_);
+  *tuning = false;
+  auto iter = states_.find(key);
+  if (iter != states_.end()) {
+    if (iter->second.best_ > 0) {
+      return iter->second.best_;
+    }
+    *tuning = true;
+    return iter->second.candidates_[iter->second.current_];
+  }
+  // the task can't be split into more parts than its units.
+  int max_thread_num = static_cast<int>(std::min<int64_t>(key.max_thread_num_, std::max<int64_t>(key.unit_num_, 1)));
+  if (max_thread_num <= 1) {
+    return std::max(std::min(default_thread_num, max_thread_num), 1);
+  }
+  auto &state = states_[key];
+  for (int thread_num = 1; thread_num < max_thread_num; thread_num *= 2) {
+    state.candidates_.push_back(thread_num);
+  }
+  state.candidates_.push_back(max_thread_num);
+  state.candidates_.push_back(std::max(std::min(default_thread_num, max_thread_num), 1));
+  std::sort(state.candidates_.begin(), state.candidates_.end());
+  state.candidates_.erase(std::unique(state.candidates_.begin(), state.candidates_.end()), state.candidates_.end());
+  state.min_costs_.assign(state.candidates_.size(), INT64_MAX);
+  state.sample_nums_.assign(state.candidates_.size(), 0);
+  tuning_num_++;
+  *tuning = true;
+  return state.candidates_[state.current_];
+}
+
+int ThreadNumTuner::Report(const ThreadNumKey &key, int thread_num, int64_t cost_ns, bool *tuning) {
+  std::unique_lock<std::mutex> l(mutex_);
+  *tuning = false;
+  auto iter = states_.find(key);
+  if (iter == states_.end()) {
+    return thread_num;
+  }
+  auto &state = iter->second;
+  if (state.best_ > 0) {
+    return state.best_;
+  }
+  auto candidate = std::find(state.candidates_.begin(), state.candidates_.end(), thread_num);
+  if (candidate == state.candidates_.end()) {
+    // the kernel doesn't run with the candidates, the measurement never ends, so the key is not tuned any more.
+    MS_LOG(WARNING) << "Thread num " << thread_num << " is not a candidate of the kernel type " << key.kernel_type_
+                    << ", stop tuning it.";
+    state.candidates_ = {thread_num};
+    state.min_costs_ = {cost_ns};
+    state.sample_nums_ = {kSkipSampleNum + kTuneSampleNum};
+    Decide(&state);
+    return state.best_;
+  }
+  auto index = static_cast<size_t>(candidate - state.candidates_.begin());
+  if (state.sample_nums_[index]++ >= kSkipSampleNum) {
+    state.min_costs_[index] = std::min(state.min_costs_[index], cost_ns);
+  }
+  while (state.current_ < state.candidates_.size() &&
+         state.sample_nums_[state.current_] >= kSkipSampleNum + kTuneSampleNum) {
+    state.current_++;
+  }
+  if (state.current_ < state.candidates_.size()) {
+    *tuning = true;
+    return state.candidates_[state.current_];
+  }
+  Decide(&state);
+  return state.best_;
+}
+
+void ThreadNumTuner::Decide(TuneState *state) {
+  auto best = std::min_element(state->min_costs_.begin(), state->min_costs_.end()) - state->min_costs_.begin();
+  state->best_ = state->candidates_[best];
+  state->candidates_.clear();
+  state->min_costs_.clear();
+  state->sample_nums_.clear();
+  dirty_ = true;
+  if (--tuning_num_ == 0) {
+    // all the kernels are tuned after the warm-up, save the decisions at once.
+    (void)SaveProfile();
+  }
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_THREAD_NUM_TUNER_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_THREAD_NUM_TUNER_H_
+
+#include <stdint.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mindspore::lite {
+// The kernel and shape which the thread num is tuned for, it is the thread cost context of the kernel.
+struct ThreadNumKey {
+  int32_t kernel_type_ = 0;
+  int64_t per_unit_load_num_ = 0;
+  int64_t per_unit_store_num_ = 0;
+  int64_t unit_num_ = 0;
+  int max_thread_num_ = 1;
+
+  bool operator<(const ThreadNumKey &other) const {
+    return std::tie(kernel_type_, per_unit_load_num_, per_unit_store_num_, unit_num_, max_thread_num_) <
+           std::tie(other.kernel_type_, other.per_unit_load_num_, other.per_unit_store_num_, other.unit_num_,
+                    other.max_thread_num_);
+  }
+};
+
+// ThreadNumTuner measures the candidate thread nums of the kernels in the warm-up runs and keeps the fastest one,
+// which replaces the thread num estimated by the ThreadCostModel. The kernels split their task by the thread num, so
+// the split size is tuned with it. The decisions are saved to a profile file of the machine and applied by the later
+// loads without measuring.
+class ThreadNumTuner {
+ public:
+  explicit ThreadNumTuner(std::string profile_path) : profile_path_(std::move(profile_path)) {}
+  ~ThreadNumTuner();
+
+  int Load();
+  int Save();
+
+  // Return the thread num of the kernel, which is the decided one or the candidate to be measured in the next run.
+  // *tuning is set to true if the thread num is a candidate.
+  int GetThreadNum(const ThreadNumKey &key, int default_thread_num, bool *tuning);
+  // Report the cost of one run of the kernel with the thread num, return the thread num of the next run.
+  int Report(const ThreadNumKey &key, int thread_num, int64_t cost_ns, bool *tuning);
+
+ private:
+  struct TuneState {
+    std::vector<int> candidates_;
+    std::vector<int64_t> min_costs_;
+    std::vector<int> sample_nums_;
+    size_t current_ = 0;
+    int best_ = 0;  // 0 if not decided
+  };
+  void Decide(TuneState *state);
+  int SaveProfile();
+
+  std::mutex mutex_;
+  std::string profile_path_;
+  std::map<ThreadNumKey, TuneState> states_;
+  size_t tuning_num_ = 0;
+  bool dirty_ = false;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_THREAD_NUM_TUNER_H_
@@ -447,6 +447,31 @@ bool WeightDecoder::IsChannelFirst(int index, const OpParameter *op_parameter) {
   return true;
 }
 
+bool WeightDecoder::CanKeepQuantWeight(const OpParameter *op_parameter, const Tensor *tensor, int index) {
+  MS_ASSERT(op_parameter != nullptr && tensor != nullptr);
+  if (index != kWeightIndex || (op_parameter->type_ != schema::PrimitiveType_MatMulFusion &&
+                                op_parameter->type_ != schema::PrimitiveType_FullConnection)) {
+    return false;
+  }
+  const auto *param = reinterpret_cast<const MatMulParameter *>(op_parameter);
+  if (param->a_transpose_ || !tensor->IsConst() || tensor->data_type() != kNumberTypeInt8 ||
+      tensor->shape().size() != DIMENSION_2D || !tensor->quant_clusters().empty()) {
+    return false;
+  }
+  const auto &quant_params = tensor->quant_params();
+  if (quant_params.empty() || !quant_params.front().inited || quant_params.front().bitNum > kBitNum8) {
+    return false;
+  }
+  // The quant params are per tensor, per channel or in shape of [col, group_num] for the group-wise quantization.
+  auto col = param->b_transpose_ ? tensor->shape().front() : tensor->shape().back();
+  auto deep = param->b_transpose_ ? tensor->shape().back() : tensor->shape().front();
+  if (col <= 0 || deep <= 0) {
+    return false;
+  }
+  auto param_num = static_cast<int>(quant_params.size());
+  return param_num == 1 || (param_num % col == 0 && deep % (param_num / col) == 0);
+}
+
 // A * stride_a + bucket_index * stride_b + C
 int WeightDecoder::GetDataIndex(const std::vector<int> &dims, int preferred_dim, int bucket_index,
                                 int bucket_in_index) {
@@ -484,7 +509,8 @@ bool NeedBitUppackCheck(const SchemaTensorWrapper &src_tensor) {
 }
 
 int WeightDecoder::DequantNode(const OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors,
-                               TypeId dst_data_type, const std::string &model_version, bool float_mode) {
+                               TypeId dst_data_type, const std::string &model_version, bool float_mode,
+                               bool keep_quant_weight) {
 #ifndef WEIGHT_DECODE_CLIP
   if (op_parameter->quant_type_ != static_cast<int>(schema::QuantType_QUANT_WEIGHT) &&
       !(op_parameter->quant_type_ == static_cast<int>(schema::QuantType_QUANT_ALL) && float_mode)) {
@@ -493,6 +519,10 @@ int WeightDecoder::DequantNode(const OpParameter *op_parameter, const std::vecto
   int index = 0;
   for (auto &tensor : in_tensors) {
     MS_CHECK_TRUE_RET(tensor != nullptr, RET_ERROR);
+    if (keep_quant_weight && dst_data_type == kNumberTypeFloat32 && CanKeepQuantWeight(op_parameter, tensor, index)) {
+      index++;
+      continue;
+    }
     auto preferred_dim = GetPreferredDim(in_tensors, op_parameter, index++, tensor->shape(), model_version);
     auto ret = WeightDecoder::DequantTensor(tensor, preferred_dim, dst_data_type);
     if (ret != RET_OK && ret != RET_NO_CHANGE) {
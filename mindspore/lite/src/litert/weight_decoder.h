@@ -44,8 +44,10 @@ namespace mindspore::lite {
 
 class MS_API WeightDecoder {
  public:
+  // If keep_quant_weight is true, the int8/int4 weight of MatMul/FullConnection stays quantized and is dequantized
+  // inside the gemm of the fp32 kernel.
   static int DequantNode(const OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors, TypeId dst_data_type,
-                         const std::string &model_version, bool float_mode);
+                         const std::string &model_version, bool float_mode, bool keep_quant_weight = false);
   static int DecompressTensor(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor);
 
   static int CompareVersion(const std::string &version1, const std::string &version2) {
@@ -132,6 +134,8 @@ class MS_API WeightDecoder {
 
   static bool IsChannelFirst(int index, const OpParameter *op_parameter);
 
+  static bool CanKeepQuantWeight(const OpParameter *op_parameter, const Tensor *tensor, int index);
+
   // A * stride_a + bucket_index * stride_b + C
   static int GetDataIndex(const std::vector<int> &dims, int preferred_dim, int bucket_index, int bucket_in_index);
 
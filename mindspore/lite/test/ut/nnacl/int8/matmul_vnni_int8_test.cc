@@ -0,0 +1,193 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/dynamic_matmul_int8.h"
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "nnacl/int8/matmul_vnni_int8.h"
+#endif
+
+namespace mindspore {
+#ifdef ENABLE_AVX512
+class TestMatmulVnniInt8 : public mindspore::CommonTest {
+ public:
+  TestMatmulVnniInt8() = default;
+  void SetUp() override { (void)IntelX86CpuInfoInit(); }
+};
+
+namespace {
+template <typename T>
+std::vector<T> RandomVector(size_t size, int low, int high, std::mt19937 *gen) {
+  std::uniform_int_distribution<int> dist(low, high);
+  std::vector<T> data(size);
+  for (auto &value : data) {
+    value = static_cast<T>(dist(*gen));
+  }
+  return data;
+}
+
+struct RequantArgs {
+  std::vector<int32_t> left_shift;
+  std::vector<int32_t> right_shift;
+  std::vector<int32_t> multiplier;
+};
+
+RequantArgs RandomRequantArgs(size_t col, std::mt19937 *gen) {
+  RequantArgs args;
+  args.left_shift = RandomVector<int32_t>(col, 0, 1, gen);
+  args.right_shift = RandomVector<int32_t>(col, -14, 0, gen);
+  args.multiplier = RandomVector<int32_t>(col, 1 << 30, INT32_MAX, gen);
+  return args;
+}
+}  // namespace
+
+TEST_F(TestMatmulVnniInt8, DpMatchesReference) {
+  if (!X86_Avx512Vnni_Support()) {
+    return;
+  }
+  std::mt19937 gen(1);
+  for (size_t row : {1, 4, 7, 33}) {
+    for (size_t col : {3, 16, 40, 130}) {
+      for (size_t deep : {5, 64, 100}) {
+        for (size_t per_channel : {0, 1}) {
+          size_t deep_4 = UP_ROUND(deep, C4NUM);
+          auto a = RandomVector<int8_t>(UP_ROUND(row, C4NUM) * deep_4, INT8_MIN, INT8_MAX, &gen);
+          auto b = RandomVector<int8_t>(UP_ROUND(col, C16NUM) * deep_4, INT8_MIN, INT8_MAX, &gen);
+          auto input_sum = RandomVector<int32_t>(UP_ROUND(row, C4NUM), -100000, 100000, &gen);
+          auto bias = RandomVector<int32_t>(UP_ROUND(col, C16NUM), -100000, 100000, &gen);
+          auto filter_zp = RandomVector<int32_t>(col, -5, 5, &gen);
+          auto args = RandomRequantArgs(col, &gen);
+          std::vector<int8_t> expect(row * col);
+          std::vector<int8_t> output(row * col);
+          MatMulInt8_4x16_r(a.data(), b.data(), expect.data(), row, col, deep_4, col, input_sum.data(), bias.data(),
+                            args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), 3, -128, 127,
+                            per_channel, filter_zp.data());
+          MatMulDpInt8Vnni(a.data(), b.data(), output.data(), row, col, deep_4, col, input_sum.data(), bias.data(),
+                           args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), 3, -128, 127,
+                           per_channel, filter_zp.data());
+          ASSERT_EQ(expect, output);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestMatmulVnniInt8, RMatchesReference) {
+  if (!X86_Avx512Vnni_Support()) {
+    return;
+  }
+  std::mt19937 gen(2);
+  for (size_t row : {1, 8, 13}) {
+    for (size_t col : {3, 24, 40, 65}) {
+      for (size_t deep : {9, 64, 100}) {
+        for (size_t per_channel : {0, 1}) {
+          size_t deep_4 = UP_ROUND(deep, C4NUM);
+          size_t row8 = UP_ROUND(row, C8NUM);
+          size_t col8 = UP_ROUND(col, C8NUM);
+          auto a = RandomVector<int8_t>(row8 * deep_4, INT8_MIN, INT8_MAX, &gen);
+          auto b = RandomVector<int8_t>(col8 * deep_4, INT8_MIN, INT8_MAX, &gen);
+          auto input_sum = RandomVector<int32_t>(row8 * col8, -100000, 100000, &gen);
+          auto bias = RandomVector<int32_t>(col8, -100000, 100000, &gen);
+          auto args = RandomRequantArgs(col, &gen);
+          std::vector<int8_t> expect(row * col);
+          std::vector<int8_t> output(row * col);
+          MatMulInt8_8x8_r(a.data(), b.data(), expect.data(), row, col, deep_4, col, input_sum.data(), bias.data(),
+                           args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), -2, -100, 120,
+                           per_channel);
+          MatMulRInt8Vnni(a.data(), b.data(), output.data(), row, col, deep_4, col, input_sum.data(), bias.data(),
+                          args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), -2, -100, 120,
+                          per_channel);
+          ASSERT_EQ(expect, output);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestMatmulVnniInt8, DynamicMatchesReference) {
+  if (!X86_Avx512Vnni_Support()) {
+    return;
+  }
+  std::mt19937 gen(3);
+  for (size_t row : {1, 4, 9}) {
+    for (size_t col : {5, 16, 70}) {
+      for (int64_t act_type : {ActType_No, ActType_Relu, ActType_Relu6}) {
+        size_t deep_4 = UP_ROUND(77, C4NUM);
+        auto a = RandomVector<int8_t>(UP_ROUND(row, C4NUM) * deep_4, INT8_MIN, INT8_MAX, &gen);
+        auto b = RandomVector<int8_t>(UP_ROUND(col, C16NUM) * deep_4, INT8_MIN, INT8_MAX, &gen);
+        auto a_sums = RandomVector<int32_t>(UP_ROUND(row, C4NUM), -10000, 10000, &gen);
+        auto b_sums = RandomVector<int32_t>(UP_ROUND(col, C16NUM), -10000, 10000, &gen);
+        std::vector<float> scales(col, 0.003f);
+        std::vector<float> bias(col, 1.5f);
+        std::vector<float> expect(row * col);
+        std::vector<float> output(row * col);
+        DynamicMatmul4x4x16AIWI(a.data(), b.data(), expect.data(), deep_4, scales.data(), bias.data(), row, col,
+                                col * sizeof(float), a_sums.data(), b_sums.data(), 7, 21, act_type);
+        DynamicMatmulVnni4x4x16AIWI(a.data(), b.data(), output.data(), deep_4, scales.data(), bias.data(), row, col,
+                                    col * sizeof(float), a_sums.data(), b_sums.data(), 7, 21, act_type);
+        ASSERT_EQ(0, CompareOutputData(output.data(), expect.data(), row * col, 1e-5));
+      }
+    }
+  }
+}
+
+// The vnni kernels match the reference kernels at the transformer and cnn shapes, the throughput of the int8 matmul
+// is measured with the quantized models by the benchmark tool.
+TEST_F(TestMatmulVnniInt8, ModelShapesMatchReference) {
+  if (!X86_Avx512Vnni_Support()) {
+    return;
+  }
+  struct GemmShape {
+    size_t row;
+    size_t col;
+    size_t deep;
+  };
+  // bert-base projection with 128 tokens, one decoding token, and the 1x1/3x3 convolutions of resnet-50 stages.
+  const std::vector<GemmShape> shapes = {{128, 2304, 768}, {1, 3072, 768}, {3136, 256, 64}, {784, 128, 1152}};
+  std::mt19937 gen(4);
+  for (const auto &shape : shapes) {
+    size_t deep_4 = UP_ROUND(shape.deep, C4NUM);
+    size_t row8 = UP_ROUND(shape.row, C8NUM);
+    size_t col16 = UP_ROUND(shape.col, C16NUM);
+    auto a = RandomVector<int8_t>(row8 * deep_4, INT8_MIN, INT8_MAX, &gen);
+    auto b = RandomVector<int8_t>(col16 * deep_4, INT8_MIN, INT8_MAX, &gen);
+    auto input_sum = RandomVector<int32_t>(row8 * col16, -100000, 100000, &gen);
+    auto bias = RandomVector<int32_t>(col16, -100000, 100000, &gen);
+    auto filter_zp = RandomVector<int32_t>(shape.col, -5, 5, &gen);
+    auto args = RandomRequantArgs(shape.col, &gen);
+    std::vector<int8_t> expect(shape.row * shape.col);
+    std::vector<int8_t> output(shape.row * shape.col);
+    MatMulInt8_4x16_r(a.data(), b.data(), expect.data(), shape.row, shape.col, deep_4, shape.col, input_sum.data(),
+                      bias.data(), args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), 1, -128,
+                      127, true, filter_zp.data());
+    MatMulDpInt8Vnni(a.data(), b.data(), output.data(), shape.row, shape.col, deep_4, shape.col, input_sum.data(),
+                     bias.data(), args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), 1, -128,
+                     127, true, filter_zp.data());
+    ASSERT_EQ(expect, output);
+    MatMulInt8_8x8_r(a.data(), b.data(), expect.data(), shape.row, shape.col, deep_4, shape.col, input_sum.data(),
+                     bias.data(), args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), 1, -128,
+                     127, true);
+    MatMulRInt8Vnni(a.data(), b.data(), output.data(), shape.row, shape.col, deep_4, shape.col, input_sum.data(),
+                    bias.data(), args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), 1, -128,
+                    127, true);
+    ASSERT_EQ(expect, output);
+  }
+}
+#endif
+}  // namespace mindspore
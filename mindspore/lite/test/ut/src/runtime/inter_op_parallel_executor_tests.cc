@@ -0,0 +1,169 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <memory>
+#include "common/common_test.h"
+#include "src/litert/inter_op_parallel_executor.h"
+#include "src/litert/lite_kernel.h"
+
+namespace mindspore {
+namespace {
+constexpr int kBranchNum = 4;
+constexpr int kChainLength = 3;
+
+// the clock of the events, a kernel records the ticks when it starts and ends.
+std::atomic<int> g_tick{0};
+
+class TickKernel : public kernel::LiteKernel {
+ public:
+  TickKernel(std::vector<lite::Tensor *> in_tensors, std::vector<lite::Tensor *> out_tensors,
+              const lite::InnerContext *ctx)
+      : LiteKernel(nullptr, std::move(in_tensors), std::move(out_tensors), ctx) {}
+  int Prepare() override { return lite::RET_OK; }
+  int ReSize() override { return lite::RET_OK; }
+  int Execute() override {
+    start_ = g_tick++;
+    end_ = g_tick++;
+    return lite::RET_OK;
+  }
+  int start_ = -1;
+  int end_ = -1;
+};
+}  // namespace
+
+class InterOpParallelExecutorTest : public mindspore::CommonTest {
+ public:
+  InterOpParallelExecutorTest() = default;
+  void SetUp() override {
+    ctx_.thread_num_ = kBranchNum;
+    g_tick = 0;
+  }
+  void TearDown() override {
+    for (auto kernel : kernels_) {
+      delete kernel;
+    }
+    for (auto tensor : tensors_) {
+      delete tensor;
+    }
+  }
+
+ protected:
+  lite::Tensor *NewTensor(int element_num) {
+    auto tensor = new lite::Tensor(kNumberTypeFloat32, {element_num});
+    tensors_.push_back(tensor);
+    return tensor;
+  }
+  TickKernel *NewKernel(const std::vector<lite::Tensor *> &in_tensors, lite::Tensor *out_tensor) {
+    auto kernel = std::make_shared<TickKernel>(in_tensors, std::vector<lite::Tensor *>{out_tensor}, &ctx_);
+    kernels_.push_back(new kernel::KernelExec(kernel));
+    return kernel.get();
+  }
+  // input -> kBranchNum chains of kChainLength kernels -> merge
+  void BuildMultiBranchGraph(int element_num) {
+    auto head_out = NewTensor(element_num);
+    (void)NewKernel({NewTensor(element_num)}, head_out);
+    std::vector<lite::Tensor *> branch_outs;
+    for (int i = 0; i < kBranchNum; i++) {
+      auto in = head_out;
+      for (int j = 0; j < kChainLength; j++) {
+        auto out = NewTensor(element_num);
+        (void)NewKernel({in}, out);
+        in = out;
+      }
+      branch_outs.push_back(in);
+    }
+    (void)NewKernel(branch_outs, NewTensor(element_num));
+  }
+  void CheckDependency() {
+    for (auto successor : kernels_) {
+      auto successor_kernel = static_cast<TickKernel *>(successor->kernel());
+      ASSERT_GE(successor_kernel->start_, 0);
+      for (auto predecessor : kernels_) {
+        auto predecessor_kernel = static_cast<TickKernel *>(predecessor->kernel());
+        for (auto tensor : successor->in_tensors()) {
+          if (tensor == predecessor->out_tensors().front()) {
+            ASSERT_LT(predecessor_kernel->end_, successor_kernel->start_);
+          }
+        }
+      }
+    }
+  }
+
+  // the kernels run one by one, their intervals don't overlap.
+  void CheckSequential() {
+    for (size_t i = 0; i < kernels_.size(); i++) {
+      auto kernel_i = static_cast<TickKernel *>(kernels_[i]->kernel());
+      for (size_t j = i + 1; j < kernels_.size(); j++) {
+        auto kernel_j = static_cast<TickKernel *>(kernels_[j]->kernel());
+        ASSERT_TRUE(kernel_i->end_ < kernel_j->start_ || kernel_j->end_ < kernel_i->start_);
+      }
+    }
+  }
+
+  lite::InnerContext ctx_;
+  std::vector<lite::Tensor *> tensors_;
+  std::vector<kernel::KernelExec *> kernels_;
+};
+
+/// Feature: Inter-op parallel executor of the lite cpu subgraph.
+/// Description: Run a graph of 4 branches with small kernels, then run it with a callback.
+/// Expectation: The kernels run after their dependency, and they run one by one if any callback is set.
+TEST_F(InterOpParallelExecutorTest, test_multi_branch) {
+  BuildMultiBranchGraph(1);
+  lite::InterOpParallelExecutor executor;
+  ASSERT_EQ(executor.Prepare(kernels_, {}, {}, &ctx_), lite::RET_OK);
+  ASSERT_EQ(executor.branch_num(), static_cast<size_t>(kBranchNum));
+
+  constexpr int kLoop = 10;
+  for (int i = 0; i < kLoop; i++) {
+    ASSERT_EQ(executor.Run({}, {}, kernels_), lite::RET_OK);
+    CheckDependency();
+  }
+
+  auto callback = [](std::vector<lite::Tensor *>, std::vector<lite::Tensor *>, const MSCallBackParam &) {
+    return true;
+  };
+  ASSERT_EQ(executor.Run({}, {}, kernels_, callback, nullptr), lite::RET_OK);
+  CheckDependency();
+  CheckSequential();
+}
+
+/// Feature: Inter-op parallel executor of the lite cpu subgraph.
+/// Description: Run a graph of 4 branches whose kernels are worth all the threads of the context.
+/// Expectation: The big kernels run one by one after their dependency, the cores are not oversubscribed.
+TEST_F(InterOpParallelExecutorTest, test_big_kernels) {
+  BuildMultiBranchGraph(1 << 20);
+  lite::InterOpParallelExecutor executor;
+  ASSERT_EQ(executor.Prepare(kernels_, {}, {}, &ctx_), lite::RET_OK);
+  ASSERT_EQ(executor.Run({}, {}, kernels_), lite::RET_OK);
+  CheckDependency();
+  CheckSequential();
+}
+
+/// Feature: Inter-op parallel executor of the lite cpu subgraph.
+/// Description: Prepare a chain of kernels.
+/// Expectation: RET_NOT_SUPPORT is returned, the chain runs by the default executor.
+TEST_F(InterOpParallelExecutorTest, test_chain) {
+  auto in = NewTensor(1);
+  for (int i = 0; i < kChainLength; i++) {
+    auto out = NewTensor(1);
+    (void)NewKernel({in}, out);
+    in = out;
+  }
+  lite::InterOpParallelExecutor executor;
+  ASSERT_EQ(executor.Prepare(kernels_, {}, {}, &ctx_), lite::RET_NOT_SUPPORT);
+}
+}  // namespace mindspore
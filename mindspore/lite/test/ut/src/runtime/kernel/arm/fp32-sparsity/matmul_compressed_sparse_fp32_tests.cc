@@ -0,0 +1,197 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include "src/common/log_adapter.h"
+#include "common/common_test.h"
+#include "src/litert/kernel/cpu/fp32_sparse/matmul_compressed_sparse_fp32.h"
+#include "src/litert/tensor_category.h"
+
+namespace mindspore {
+class TestMatmulCompressedSparseFp32 : public mindspore::CommonTest {
+ public:
+  TestMatmulCompressedSparseFp32() {}
+};
+
+namespace {
+enum class PruneMode { kDense, kElement, kBlock, kNM };
+
+struct SparseCase {
+  int row;
+  int deep;
+  int col;
+  bool b_transpose;
+  bool has_bias;
+  ActType act_type;
+  PruneMode mode;
+  float sparsity;
+};
+
+class SparseMatmulTester {
+ public:
+  explicit SparseMatmulTester(const SparseCase &test_case) : case_(test_case) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> data_dis(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> prune_dis(0.0f, 1.0f);
+    a_ = new lite::Tensor(kNumberTypeFloat32, {case_.row, case_.deep}, NHWC, lite::Category::VAR);
+    std::vector<int> b_shape = case_.b_transpose ? std::vector<int>{case_.col, case_.deep}
+                                                 : std::vector<int>{case_.deep, case_.col};
+    b_ = new lite::Tensor(kNumberTypeFloat32, b_shape, NHWC, lite::Category::CONST_TENSOR);
+    c_ = new lite::Tensor(kNumberTypeFloat32, {case_.row, case_.col}, NHWC, lite::Category::VAR);
+    (void)a_->MallocData();
+    (void)b_->MallocData();
+    (void)c_->MallocData();
+    auto a_data = reinterpret_cast<float *>(a_->data());
+    for (int i = 0; i < a_->ElementsNum(); i++) {
+      a_data[i] = data_dis(gen);
+    }
+    for (int d = 0; d < case_.deep; d++) {
+      for (int c = 0; c < case_.col; c++) {
+        WeightAt(d, c) = data_dis(gen);
+      }
+    }
+    Prune(&gen, &prune_dis);
+    inputs_ = {a_, b_};
+    if (case_.has_bias) {
+      bias_ = new lite::Tensor(kNumberTypeFloat32, {case_.col}, NHWC, lite::Category::CONST_TENSOR);
+      (void)bias_->MallocData();
+      auto bias_data = reinterpret_cast<float *>(bias_->data());
+      for (int i = 0; i < case_.col; i++) {
+        bias_data[i] = data_dis(gen);
+      }
+      inputs_.push_back(bias_);
+    }
+  }
+  ~SparseMatmulTester() {
+    for (auto tensor : inputs_) {
+      delete tensor;
+    }
+    delete c_;
+  }
+
+  float &WeightAt(int d, int c) {
+    auto data = reinterpret_cast<float *>(b_->data());
+    return case_.b_transpose ? data[c * case_.deep + d] : data[d * case_.col + c];
+  }
+
+  void Prune(std::mt19937 *gen, std::uniform_real_distribution<float> *dis) {
+    constexpr int kBlock = 16;
+    constexpr int kN = 2;
+    constexpr int kM = 4;
+    for (int d = 0; d < case_.deep; d++) {
+      for (int c = 0; c < case_.col; c++) {
+        bool zero = false;
+        if (case_.mode == PruneMode::kElement) {
+          zero = (*dis)(*gen) < case_.sparsity;
+        } else if (case_.mode == PruneMode::kBlock && c % kBlock == 0) {
+          zero = (*dis)(*gen) < case_.sparsity;
+          for (int j = c; zero && j < std::min(c + kBlock, case_.col); j++) {
+            WeightAt(d, j) = 0.0f;
+          }
+        } else if (case_.mode == PruneMode::kNM) {
+          // keep the first kN of every kM elements along the deep, shifted by the column.
+          zero = (d + c) % kM >= kN;
+        }
+        if (zero) {
+          WeightAt(d, c) = 0.0f;
+        }
+      }
+    }
+  }
+
+  std::vector<float> Expect() {
+    auto a_data = reinterpret_cast<const float *>(a_->data());
+    std::vector<float> expect(case_.row * case_.col);
+    for (int r = 0; r < case_.row; r++) {
+      for (int c = 0; c < case_.col; c++) {
+        double sum = case_.has_bias ? reinterpret_cast<const float *>(bias_->data())[c] : 0.0;
+        for (int d = 0; d < case_.deep; d++) {
+          sum += static_cast<double>(a_data[r * case_.deep + d]) * WeightAt(d, c);
+        }
+        if (case_.act_type == ActType_Relu || case_.act_type == ActType_Relu6) {
+          sum = std::max(sum, 0.0);
+        }
+        if (case_.act_type == ActType_Relu6) {
+          sum = std::min(sum, 6.0);
+        }
+        expect[r * case_.col + c] = static_cast<float>(sum);
+      }
+    }
+    return expect;
+  }
+
+  MatMulParameter *NewParameter() const {
+    auto param = reinterpret_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+    memset(param, 0, sizeof(MatMulParameter));
+    param->op_parameter_.thread_num_ = 1;
+    param->b_transpose_ = case_.b_transpose;
+    param->has_bias_ = case_.has_bias;
+    param->act_type_ = case_.act_type;
+    return param;
+  }
+
+  SparseCase case_;
+  lite::Tensor *a_ = nullptr;
+  lite::Tensor *b_ = nullptr;
+  lite::Tensor *bias_ = nullptr;
+  lite::Tensor *c_ = nullptr;
+  std::vector<lite::Tensor *> inputs_;
+};
+
+void RunSparseCase(const SparseCase &test_case, kernel::SparseWeightFormat expect_format, int thread_num) {
+  SparseMatmulTester tester(test_case);
+  auto param = tester.NewParameter();
+  bool transpose = test_case.b_transpose;
+  ASSERT_EQ(expect_format, kernel::GetSparseWeightFormat(reinterpret_cast<float *>(tester.b_->data()), test_case.deep,
+                                                         test_case.col, transpose));
+#ifdef ENABLE_AVX
+  bool expect_sparse = expect_format != kernel::SparseWeightFormat::kNone;
+#else
+  // The sparse kernel is only selected with avx.
+  bool expect_sparse = false;
+#endif
+  ASSERT_EQ(expect_sparse, kernel::IsSparseMatmul(tester.inputs_, reinterpret_cast<OpParameter *>(param)));
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = thread_num;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+  auto kernel = new kernel::MatmulCompressedSparseCPUKernel(reinterpret_cast<OpParameter *>(param), tester.inputs_,
+                                                            {tester.c_}, ctx.get());
+  ASSERT_EQ(lite::RET_OK, kernel->Prepare());
+  ASSERT_EQ(lite::RET_OK, kernel->Run());
+  auto expect = tester.Expect();
+  ASSERT_EQ(0, CommonTest::CompareOutputData(reinterpret_cast<float *>(tester.c_->data()), expect.data(),
+                                             static_cast<int>(expect.size())));
+  delete kernel;
+}
+}  // namespace
+
+/// Feature: MatMul of fp32 with the compressed sparse weight.
+/// Description: The weight pruned in blocks, elements and N:M, with the tails of the row and column tiles.
+/// Expectation: The format is chosen by the sparsity and the output is the same as the dense matmul.
+TEST_F(TestMatmulCompressedSparseFp32, Accuracy) {
+  using kernel::SparseWeightFormat;
+  RunSparseCase({1, 64, 40, true, true, ActType_No, PruneMode::kBlock, 0.8f}, SparseWeightFormat::kBlock, C2NUM);
+  RunSparseCase({37, 48, 70, false, true, ActType_Relu6, PruneMode::kBlock, 0.8f}, SparseWeightFormat::kBlock, C2NUM);
+  RunSparseCase({7, 96, 40, false, false, ActType_Relu, PruneMode::kElement, 0.9f}, SparseWeightFormat::kCsc, C2NUM);
+  RunSparseCase({35, 128, 33, true, true, ActType_No, PruneMode::kElement, 0.9f}, SparseWeightFormat::kCsc, C4NUM);
+  RunSparseCase({16, 64, 48, true, true, ActType_No, PruneMode::kNM, 0.0f}, SparseWeightFormat::kNone, 1);
+  RunSparseCase({5, 64, 24, false, true, ActType_No, PruneMode::kDense, 0.0f}, SparseWeightFormat::kNone, 1);
+}
+}  // namespace mindspore
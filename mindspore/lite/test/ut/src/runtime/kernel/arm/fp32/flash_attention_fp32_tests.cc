@@ -0,0 +1,150 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/attention_parameter.h"
+#include "mindspore/lite/src/litert/kernel_registry.h"
+
+namespace mindspore {
+class TestFlashAttentionFp32 : public mindspore::CommonTest {
+ public:
+  TestFlashAttentionFp32() {}
+};
+
+namespace {
+std::vector<float> RandomData(size_t size) {
+  std::vector<float> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<float>(i * 37 % 101) / 50.0f - 1.0f;
+  }
+  return data;
+}
+
+// The attention computed by MatMul -> Softmax -> MatMul.
+std::vector<float> RefAttention(const std::vector<float> &q, const std::vector<float> &k, const std::vector<float> &v,
+                                const float *mask, const FlashAttentionParameter &param) {
+  int q_seq = param.q_seq_;
+  int k_seq = param.k_seq_;
+  int head_size = param.head_size_;
+  int v_head_size = param.v_head_size_;
+  std::vector<float> out(param.batch_ * q_seq * v_head_size);
+  std::vector<float> logits(k_seq);
+  for (int b = 0; b < param.batch_; ++b) {
+    for (int i = 0; i < q_seq; ++i) {
+      float max = -INFINITY;
+      for (int j = 0; j < k_seq; ++j) {
+        float dot = 0.0f;
+        for (int d = 0; d < head_size; ++d) {
+          float key = param.key_transpose_ ? k[(b * head_size + d) * k_seq + j] : k[(b * k_seq + j) * head_size + d];
+          dot += q[(b * q_seq + i) * head_size + d] * key;
+        }
+        logits[j] = dot * param.scale_ + (mask == nullptr ? 0.0f : mask[i * k_seq + j]);
+        if (param.causal_ && j > i + k_seq - q_seq) {
+          logits[j] = -INFINITY;
+        }
+        max = std::max(max, logits[j]);
+      }
+      float sum = 0.0f;
+      for (int j = 0; j < k_seq; ++j) {
+        logits[j] = std::exp(logits[j] - max);
+        sum += logits[j];
+      }
+      for (int d = 0; d < v_head_size; ++d) {
+        float acc = 0.0f;
+        for (int j = 0; j < k_seq; ++j) {
+          acc += logits[j] * v[(b * k_seq + j) * v_head_size + d];
+        }
+        out[(b * q_seq + i) * v_head_size + d] = acc / sum;
+      }
+    }
+  }
+  return out;
+}
+
+void RunFlashAttention(FlashAttentionParameter *param, const std::vector<int> &k_shape, bool with_mask) {
+  int batch = param->batch_;
+  int q_seq = param->q_seq_;
+  int k_seq = param->k_seq_;
+  auto q = RandomData(batch * q_seq * param->head_size_);
+  auto k = RandomData(batch * k_seq * param->head_size_);
+  auto v = RandomData(batch * k_seq * param->v_head_size_);
+  auto mask = RandomData(q_seq * k_seq);
+  std::vector<float> out(batch * q_seq * param->v_head_size_);
+
+  lite::Tensor q_tensor(kNumberTypeFloat32, {batch, q_seq, param->head_size_});
+  lite::Tensor k_tensor(kNumberTypeFloat32, k_shape);
+  lite::Tensor v_tensor(kNumberTypeFloat32, {batch, k_seq, param->v_head_size_});
+  lite::Tensor mask_tensor(kNumberTypeFloat32, {q_seq, k_seq});
+  lite::Tensor out_tensor(kNumberTypeFloat32, {batch, q_seq, param->v_head_size_});
+  q_tensor.set_data(q.data());
+  k_tensor.set_data(k.data());
+  v_tensor.set_data(v.data());
+  mask_tensor.set_data(mask.data());
+  out_tensor.set_data(out.data());
+  std::vector<lite::Tensor *> inputs = {&q_tensor, &k_tensor, &v_tensor};
+  if (with_mask) {
+    inputs.push_back(&mask_tensor);
+  }
+  std::vector<lite::Tensor *> outputs = {&out_tensor};
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, PrimType_Inner_FlashAttention};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+  auto kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx.get(), desc);
+  ASSERT_NE(kernel, nullptr);
+  EXPECT_EQ(lite::RET_OK, kernel->Prepare());
+  EXPECT_EQ(lite::RET_OK, kernel->Run());
+
+  auto expect = RefAttention(q, k, v, with_mask ? mask.data() : nullptr, *param);
+  ASSERT_EQ(0, CompareOutputData(out.data(), expect.data(), out.size(), 1e-4));
+  for (auto tensor : {&q_tensor, &k_tensor, &v_tensor, &mask_tensor, &out_tensor}) {
+    tensor->set_data(nullptr);
+  }
+  delete kernel;
+}
+}  // namespace
+
+TEST_F(TestFlashAttentionFp32, WithMask) {
+  FlashAttentionParameter param = {};
+  param.scale_ = 0.125f;
+  param.batch_ = 2;
+  param.q_seq_ = 20;
+  param.k_seq_ = 70;
+  param.head_size_ = 16;
+  param.v_head_size_ = 24;
+  RunFlashAttention(&param, {param.batch_, param.k_seq_, param.head_size_}, true);
+}
+
+TEST_F(TestFlashAttentionFp32, CausalKeyTranspose) {
+  FlashAttentionParameter param = {};
+  param.scale_ = 0.25f;
+  param.causal_ = true;
+  param.key_transpose_ = true;
+  param.batch_ = 3;
+  param.q_seq_ = 33;
+  param.k_seq_ = 90;
+  param.head_size_ = 8;
+  param.v_head_size_ = 8;
+  RunFlashAttention(&param, {param.batch_, param.head_size_, param.k_seq_}, false);
+}
+}  // namespace mindspore
@@ -0,0 +1,261 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/attention_parameter.h"
+#include "mindspore/lite/src/litert/kernel_registry.h"
+#include "mindspore/lite/src/litert/kernel/cpu/base/kv_cache.h"
+
+namespace mindspore {
+class TestKVCacheAttentionFp32 : public mindspore::CommonTest {
+ public:
+  TestKVCacheAttentionFp32() {}
+};
+
+namespace {
+constexpr int kHeadNum = 2;
+constexpr int kHeadSize = 8;
+
+std::vector<float> RandomData(size_t size, int seed) {
+  std::vector<float> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<float>((i + seed) * 37 % 101) / 50.0f - 1.0f;
+  }
+  return data;
+}
+
+// The causal attention of the last q_seq tokens of one head over all the k_seq tokens.
+void RefAttention(const float *q, const float *k, const float *v, float *out, int q_seq, int k_seq, float scale) {
+  std::vector<float> logits(k_seq);
+  for (int i = 0; i < q_seq; ++i) {
+    int visible = k_seq - q_seq + i + 1;
+    float max = -INFINITY;
+    for (int j = 0; j < visible; ++j) {
+      float dot = 0.0f;
+      for (int d = 0; d < kHeadSize; ++d) {
+        dot += q[i * kHeadSize + d] * k[j * kHeadSize + d];
+      }
+      logits[j] = dot * scale;
+      max = std::max(max, logits[j]);
+    }
+    float sum = 0.0f;
+    for (int j = 0; j < visible; ++j) {
+      logits[j] = std::exp(logits[j] - max);
+      sum += logits[j];
+    }
+    for (int d = 0; d < kHeadSize; ++d) {
+      float acc = 0.0f;
+      for (int j = 0; j < visible; ++j) {
+        acc += logits[j] * v[j * kHeadSize + d];
+      }
+      out[i * kHeadSize + d] = acc / sum;
+    }
+  }
+}
+
+class KVCacheAttentionRunner {
+ public:
+  explicit KVCacheAttentionRunner(int max_pages) {
+    param_ = static_cast<KVCacheAttentionParameter *>(malloc(sizeof(KVCacheAttentionParameter)));
+    memset(param_, 0, sizeof(KVCacheAttentionParameter));
+    param_->op_parameter_.type_ = PrimType_Inner_KVCacheAttention;
+    param_->op_parameter_.thread_num_ = 2;
+    param_->scale_ = 0.35f;
+    param_->max_pages_ = max_pages;
+    (void)strcpy(param_->cache_name_, max_pages == 0 ? "test_cache" : "test_limited_cache");
+    ctx_ = std::make_shared<lite::InnerContext>();
+    ctx_->thread_num_ = 2;
+  }
+  ~KVCacheAttentionRunner() {
+    delete kernel_;
+    for (auto tensor : tensors_) {
+      tensor->set_data(nullptr);
+      delete tensor;
+    }
+  }
+
+  // Run one step of the sequences with new_tokens tokens, q/k/v are in [seq_num, kHeadNum, new_tokens, kHeadSize].
+  int Step(std::vector<int> seq_ids, std::vector<int> past_lens, int new_tokens, std::vector<float> *q,
+           std::vector<float> *k, std::vector<float> *v, std::vector<float> *out) {
+    int seq_num = static_cast<int>(seq_ids.size());
+    std::vector<int> shape = {seq_num, kHeadNum, new_tokens, kHeadSize};
+    out->resize(q->size());
+    if (kernel_ == nullptr) {
+      for (size_t i = 0; i < 4; ++i) {
+        tensors_.push_back(new lite::Tensor(kNumberTypeFloat32, shape));
+      }
+      tensors_.push_back(new lite::Tensor(kNumberTypeInt32, {seq_num}));
+      tensors_.push_back(new lite::Tensor(kNumberTypeInt32, {seq_num}));
+    }
+    for (size_t i = 0; i < 4; ++i) {
+      tensors_[i]->set_shape(shape);
+    }
+    tensors_[4]->set_shape({seq_num});
+    tensors_[5]->set_shape({seq_num});
+    tensors_[0]->set_data(q->data());
+    tensors_[1]->set_data(k->data());
+    tensors_[2]->set_data(v->data());
+    tensors_[3]->set_data(out->data());
+    tensors_[4]->set_data(seq_ids.data());
+    tensors_[5]->set_data(past_lens.data());
+    std::vector<lite::Tensor *> inputs = {tensors_[0], tensors_[1], tensors_[2], tensors_[4], tensors_[5]};
+    std::vector<lite::Tensor *> outputs = {tensors_[3]};
+    if (kernel_ == nullptr) {
+      if (ctx_->Init() != lite::RET_OK) {
+        return lite::RET_ERROR;
+      }
+      kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, PrimType_Inner_KVCacheAttention};
+      auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+      if (creator == nullptr) {
+        return lite::RET_ERROR;
+      }
+      kernel_ = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param_), ctx_.get(), desc);
+      if (kernel_ == nullptr || kernel_->Prepare() != lite::RET_OK) {
+        return lite::RET_ERROR;
+      }
+    } else if (kernel_->ReSize() != lite::RET_OK) {
+      return lite::RET_ERROR;
+    }
+    return kernel_->Run();
+  }
+
+ private:
+  KVCacheAttentionParameter *param_ = nullptr;
+  std::shared_ptr<lite::InnerContext> ctx_;
+  kernel::LiteKernel *kernel_ = nullptr;
+  std::vector<lite::Tensor *> tensors_;
+};
+}  // namespace
+
+TEST_F(TestKVCacheAttentionFp32, PrefillAndDecode) {
+  // The prompt is longer than one page, and then two tokens are decoded one by one.
+  constexpr int kPromptLen = 70;
+  constexpr int kTotalLen = kPromptLen + 2;
+  auto q = RandomData(kHeadNum * kTotalLen * kHeadSize, 1);
+  auto k = RandomData(kHeadNum * kTotalLen * kHeadSize, 2);
+  auto v = RandomData(kHeadNum * kTotalLen * kHeadSize, 3);
+  KVCacheAttentionRunner runner(0);
+  int past_len = 0;
+  for (int new_tokens : {kPromptLen, 1, 1}) {
+    std::vector<float> step_q, step_k, step_v, out;
+    for (int h = 0; h < kHeadNum; ++h) {
+      auto offset = (h * kTotalLen + past_len) * kHeadSize;
+      step_q.insert(step_q.end(), q.begin() + offset, q.begin() + offset + new_tokens * kHeadSize);
+      step_k.insert(step_k.end(), k.begin() + offset, k.begin() + offset + new_tokens * kHeadSize);
+      step_v.insert(step_v.end(), v.begin() + offset, v.begin() + offset + new_tokens * kHeadSize);
+    }
+    ASSERT_EQ(lite::RET_OK, runner.Step({7}, {past_len}, new_tokens, &step_q, &step_k, &step_v, &out));
+    std::vector<float> expect(out.size());
+    for (int h = 0; h < kHeadNum; ++h) {
+      auto head_offset = h * kTotalLen * kHeadSize;
+      RefAttention(step_q.data() + h * new_tokens * kHeadSize, k.data() + head_offset, v.data() + head_offset,
+                   expect.data() + h * new_tokens * kHeadSize, new_tokens, past_len + new_tokens, 0.35f);
+    }
+    ASSERT_EQ(0, CompareOutputData(out.data(), expect.data(), out.size(), 1e-4));
+    past_len += new_tokens;
+  }
+}
+
+TEST_F(TestKVCacheAttentionFp32, EvictLeastRecentlyUsed) {
+  // Each sequence of 3 tokens takes one page, so the third sequence evicts the first one.
+  KVCacheAttentionRunner runner(2);
+  auto data = RandomData(kHeadNum * 3 * kHeadSize, 4);
+  std::vector<float> out;
+  for (int seq_id : {1, 2, 3}) {
+    auto q = data;
+    auto k = data;
+    auto v = data;
+    ASSERT_EQ(lite::RET_OK, runner.Step({seq_id}, {0}, 3, &q, &k, &v, &out));
+  }
+  auto q = RandomData(kHeadNum * kHeadSize, 5);
+  auto k = q;
+  auto v = q;
+  ASSERT_EQ(lite::RET_OK, runner.Step({3}, {3}, 1, &q, &k, &v, &out));
+  ASSERT_NE(lite::RET_OK, runner.Step({1}, {3}, 1, &q, &k, &v, &out));
+  // The sequence is restarted from the empty cache.
+  auto new_q = data;
+  auto new_k = data;
+  auto new_v = data;
+  ASSERT_EQ(lite::RET_OK, runner.Step({1}, {0}, 3, &new_q, &new_k, &new_v, &out));
+}
+
+TEST_F(TestKVCacheAttentionFp32, ReleaseSequence) {
+  KVCacheAttentionRunner runner(0);
+  auto data = RandomData(kHeadNum * 3 * kHeadSize, 6);
+  std::vector<float> out;
+  auto q = data;
+  auto k = data;
+  auto v = data;
+  ASSERT_EQ(lite::RET_OK, runner.Step({9}, {0}, 3, &q, &k, &v, &out));
+  // The released sequence can't be continued, and it can be restarted.
+  kernel::KVCacheManager::GetInstance()->EraseSequence(9);
+  auto step_q = RandomData(kHeadNum * kHeadSize, 7);
+  auto step_k = step_q;
+  auto step_v = step_q;
+  ASSERT_NE(lite::RET_OK, runner.Step({9}, {3}, 1, &step_q, &step_k, &step_v, &out));
+  ASSERT_EQ(lite::RET_OK, runner.Step({9}, {0}, 3, &q, &k, &v, &out));
+}
+
+TEST_F(TestKVCacheAttentionFp32, DefaultMaxPages) {
+  // The pages are bounded by the default memory cap when max_pages isn't set.
+  kernel::KVCachePageShape shape{64, 32, 128, 128};
+  kernel::KVCache cache(shape, 0);
+  ASSERT_EQ(cache.max_pages(), (1UL << 30) / (cache.page_floats() * sizeof(float)));
+  ASSERT_EQ(kernel::KVCache(shape, 10).max_pages(), 10);
+}
+
+TEST_F(TestKVCacheAttentionFp32, AcquireRollback) {
+  // Each page holds 4 tokens, the sequences 1 and 2 take one page each of the 4 pages.
+  kernel::KVCache cache({4, 1, 2, 2}, 4);
+  std::vector<kernel::KVCacheSequence> sequences;
+  ASSERT_EQ(lite::RET_OK, cache.Acquire({1, 2}, {0, 0}, 4, &sequences));
+  cache.Release({1, 2});
+  // The sequences 1 and 5 get the last 2 pages, and then the sequence 2 fails to grow.
+  ASSERT_NE(lite::RET_OK, cache.Acquire({1, 5, 2}, {4, 0, 4}, 4, &sequences));
+  // The sequence 1 isn't grown, the sequence 5 isn't created, and their pages are recycled.
+  ASSERT_NE(lite::RET_OK, cache.Acquire({1}, {8}, 0, &sequences));
+  ASSERT_NE(lite::RET_OK, cache.Acquire({5}, {4}, 0, &sequences));
+  ASSERT_EQ(lite::RET_OK, cache.Acquire({2, 1}, {4, 4}, 4, &sequences));
+  cache.Release({2, 1});
+}
+
+TEST_F(TestKVCacheAttentionFp32, ModelBudget) {
+  kernel::KVCachePageShape shape{4, 1, 2, 2};
+  auto manager = kernel::KVCacheManager::GetInstance();
+  // The caches are keyed by the model and the node.
+  auto cache = manager->GetCache("budget_model", "layer_0", shape, 0);
+  ASSERT_NE(cache, nullptr);
+  ASSERT_EQ(cache, manager->GetCache("budget_model", "layer_0", shape, 0));
+  ASSERT_NE(cache, manager->GetCache("other_model", "layer_0", shape, 0));
+  // The caches of all the layers share the budget of 2 pages.
+  auto budget = std::make_shared<kernel::KVCacheBudget>(2 * 16 * sizeof(float));
+  kernel::KVCache layer_0(shape, 0, budget);
+  kernel::KVCache layer_1(shape, 0, budget);
+  std::vector<kernel::KVCacheSequence> sequences;
+  ASSERT_EQ(lite::RET_OK, layer_0.Acquire({1}, {0}, 4, &sequences));
+  ASSERT_EQ(lite::RET_OK, layer_1.Acquire({1}, {0}, 4, &sequences));
+  ASSERT_NE(lite::RET_OK, layer_1.Acquire({2}, {0}, 4, &sequences));
+  layer_0.Release({1});
+  layer_0.Erase(1);
+  // The page of the erased sequence is still held by the layer 0 for its next sequences.
+  ASSERT_NE(lite::RET_OK, layer_1.Acquire({2}, {0}, 4, &sequences));
+  ASSERT_EQ(lite::RET_OK, layer_0.Acquire({2}, {0}, 4, &sequences));
+}
+}  // namespace mindspore
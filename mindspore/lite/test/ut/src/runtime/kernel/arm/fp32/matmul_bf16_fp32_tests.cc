@@ -0,0 +1,169 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include "src/common/log_adapter.h"
+#include "common/common_test.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/litert/kernel/cpu/fp32/matmul_bf16_fp32.h"
+#include "src/litert/tensor_category.h"
+
+namespace mindspore {
+class TestMatmulBf16Fp32 : public mindspore::CommonTest {
+ public:
+  TestMatmulBf16Fp32() {}
+};
+
+namespace {
+struct Bf16Case {
+  int row;
+  int deep;
+  int col;
+  bool b_transpose;
+  bool has_bias;
+  ActType act_type;
+};
+
+// Round to nearest even as vcvtneps2bf16, the result is still kept in fp32.
+float RoundToBf16(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  bits += 0x7FFF + ((bits >> 16) & 1);
+  bits &= 0xFFFF0000u;
+  memcpy(&value, &bits, sizeof(bits));
+  return value;
+}
+
+bool SupportBf16() { return IntelX86CpuInfoInit() == 0 && X86_Avx512Bf16_Support(); }
+
+class Bf16MatmulTester {
+ public:
+  explicit Bf16MatmulTester(const Bf16Case &test_case) : case_(test_case) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> data_dis(-1.0f, 1.0f);
+    a_ = new lite::Tensor(kNumberTypeFloat32, {case_.row, case_.deep}, NHWC, lite::Category::VAR);
+    std::vector<int> b_shape = case_.b_transpose ? std::vector<int>{case_.col, case_.deep}
+                                                 : std::vector<int>{case_.deep, case_.col};
+    b_ = new lite::Tensor(kNumberTypeFloat32, b_shape, NHWC, lite::Category::CONST_TENSOR);
+    c_ = new lite::Tensor(kNumberTypeFloat32, {case_.row, case_.col}, NHWC, lite::Category::VAR);
+    (void)a_->MallocData();
+    (void)b_->MallocData();
+    (void)c_->MallocData();
+    for (auto tensor : {a_, b_}) {
+      auto data = reinterpret_cast<float *>(tensor->data());
+      for (int i = 0; i < tensor->ElementsNum(); i++) {
+        data[i] = data_dis(gen);
+      }
+    }
+    inputs_ = {a_, b_};
+    if (case_.has_bias) {
+      bias_ = new lite::Tensor(kNumberTypeFloat32, {case_.col}, NHWC, lite::Category::CONST_TENSOR);
+      (void)bias_->MallocData();
+      auto bias_data = reinterpret_cast<float *>(bias_->data());
+      for (int i = 0; i < case_.col; i++) {
+        bias_data[i] = data_dis(gen);
+      }
+      inputs_.push_back(bias_);
+    }
+  }
+  ~Bf16MatmulTester() {
+    for (auto tensor : inputs_) {
+      delete tensor;
+    }
+    delete c_;
+  }
+
+  // The matmul of the operands rounded to bf16, which is what the kernel computes except the order of the sum.
+  std::vector<float> Expect() const {
+    auto a_data = reinterpret_cast<const float *>(a_->data());
+    auto b_data = reinterpret_cast<const float *>(b_->data());
+    std::vector<float> expect(case_.row * case_.col);
+    for (int r = 0; r < case_.row; r++) {
+      for (int c = 0; c < case_.col; c++) {
+        double sum = case_.has_bias ? reinterpret_cast<const float *>(bias_->data())[c] : 0.0;
+        for (int d = 0; d < case_.deep; d++) {
+          int index = case_.b_transpose ? c * case_.deep + d : d * case_.col + c;
+          sum += static_cast<double>(RoundToBf16(a_data[r * case_.deep + d])) * RoundToBf16(b_data[index]);
+        }
+        if (case_.act_type == ActType_Relu || case_.act_type == ActType_Relu6) {
+          sum = std::max(sum, 0.0);
+        }
+        if (case_.act_type == ActType_Relu6) {
+          sum = std::min(sum, 6.0);
+        }
+        expect[r * case_.col + c] = static_cast<float>(sum);
+      }
+    }
+    return expect;
+  }
+
+  MatMulParameter *NewParameter() const {
+    auto param = reinterpret_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+    memset(param, 0, sizeof(MatMulParameter));
+    param->op_parameter_.thread_num_ = 1;
+    param->b_transpose_ = case_.b_transpose;
+    param->has_bias_ = case_.has_bias;
+    param->act_type_ = case_.act_type;
+    return param;
+  }
+
+  Bf16Case case_;
+  lite::Tensor *a_ = nullptr;
+  lite::Tensor *b_ = nullptr;
+  lite::Tensor *bias_ = nullptr;
+  lite::Tensor *c_ = nullptr;
+  std::vector<lite::Tensor *> inputs_;
+};
+
+void RunBf16Case(const Bf16Case &test_case, int thread_num) {
+  Bf16MatmulTester tester(test_case);
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = thread_num;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  ctx->enable_bf16_ = true;
+  auto param = tester.NewParameter();
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+  ASSERT_TRUE(kernel::IsBf16Matmul(tester.inputs_, reinterpret_cast<OpParameter *>(param), ctx.get()));
+  auto kernel = new kernel::MatmulBf16CPUKernel(reinterpret_cast<OpParameter *>(param), tester.inputs_, {tester.c_},
+                                                ctx.get());
+  ASSERT_EQ(lite::RET_OK, kernel->Prepare());
+  ASSERT_EQ(lite::RET_OK, kernel->Run());
+  auto expect = tester.Expect();
+  ASSERT_EQ(0, CommonTest::CompareOutputData(reinterpret_cast<float *>(tester.c_->data()), expect.data(),
+                                             static_cast<int>(expect.size())));
+  delete kernel;
+}
+}  // namespace
+
+/// Feature: Bf16 MatMul of fp32.
+/// Description: The row and the column are split by the threads, with the tails of the row and column tiles.
+/// Expectation: The output is the same as the matmul of the operands rounded to bf16.
+TEST_F(TestMatmulBf16Fp32, Accuracy) {
+  if (!SupportBf16()) {
+    MS_LOG(WARNING) << "The cpu doesn't support avx512 bf16, skip the test.";
+    return;
+  }
+  RunBf16Case({1, 64, 40, true, true, ActType_No}, C2NUM);
+  RunBf16Case({7, 33, 17, false, false, ActType_Relu}, C2NUM);
+  RunBf16Case({37, 48, 70, true, true, ActType_Relu6}, C2NUM);
+  RunBf16Case({16, 1, 3, false, true, ActType_No}, 1);
+}
+}  // namespace mindspore
+#endif  // ENABLE_AVX512
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <random>
+#include <vector>
+#include "src/common/log_adapter.h"
+#include "common/common_test.h"
+#include "src/litert/kernel/cpu/fp32/matmul_weight_quant_fp32.h"
+#include "src/litert/tensor_category.h"
+
+namespace mindspore {
+class TestMatmulWeightQuantFp32 : public mindspore::CommonTest {
+ public:
+  TestMatmulWeightQuantFp32() {}
+};
+
+namespace {
+struct WeightQuantCase {
+  int row;
+  int deep;
+  int col;
+  int group_num;  // 0 for per tensor
+  int bit_num;
+  bool b_transpose;
+  bool has_bias;
+  bool has_corr = false;  // the per channel params have the var/mean correction
+};
+
+class WeightQuantMatmulTester {
+ public:
+  explicit WeightQuantMatmulTester(const WeightQuantCase &test_case) : case_(test_case) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> data_dis(-1.0f, 1.0f);
+    int quant_max = (1 << (case_.bit_num - 1)) - 1;
+    std::uniform_int_distribution<int> quant_dis(-quant_max - 1, quant_max);
+    std::uniform_int_distribution<int> zp_dis(-2, 2);
+
+    a_ = new lite::Tensor(kNumberTypeFloat32, {case_.row, case_.deep}, NHWC, lite::Category::VAR);
+    std::vector<int> b_shape = case_.b_transpose ? std::vector<int>{case_.col, case_.deep}
+                                                 : std::vector<int>{case_.deep, case_.col};
+    b_ = new lite::Tensor(kNumberTypeInt8, b_shape, NHWC, lite::Category::CONST_TENSOR);
+    c_ = new lite::Tensor(kNumberTypeFloat32, {case_.row, case_.col}, NHWC, lite::Category::VAR);
+    (void)a_->MallocData();
+    (void)b_->MallocData();
+    (void)c_->MallocData();
+    auto a_data = reinterpret_cast<float *>(a_->data());
+    for (int i = 0; i < a_->ElementsNum(); i++) {
+      a_data[i] = data_dis(gen);
+    }
+    auto b_data = reinterpret_cast<int8_t *>(b_->data());
+    for (int i = 0; i < b_->ElementsNum(); i++) {
+      b_data[i] = static_cast<int8_t>(quant_dis(gen));
+    }
+    int param_num = case_.group_num == 0 ? 1 : case_.col * case_.group_num;
+    for (int i = 0; i < param_num; i++) {
+      lite::LiteQuantParam param;
+      param.scale = (std::abs(data_dis(gen)) + 0.1f) / quant_max;
+      param.zeroPoint = zp_dis(gen);
+      param.bitNum = case_.bit_num;
+      param.inited = true;
+      if (case_.has_corr && param_num > 1) {
+        // The var correction out of range of the first param is ignored by the dequantization.
+        param.var_corr = i == 0 ? kInvalidVarCorr : data_dis(gen) * 0.2f + 1.0f;
+        param.mean_corr = data_dis(gen) * 0.1f;
+      }
+      b_->AddQuantParam(param);
+    }
+    inputs_ = {a_, b_};
+    if (case_.has_bias) {
+      bias_ = new lite::Tensor(kNumberTypeFloat32, {case_.col}, NHWC, lite::Category::CONST_TENSOR);
+      (void)bias_->MallocData();
+      auto bias_data = reinterpret_cast<float *>(bias_->data());
+      for (int i = 0; i < case_.col; i++) {
+        bias_data[i] = data_dis(gen);
+      }
+      inputs_.push_back(bias_);
+    }
+  }
+  ~WeightQuantMatmulTester() {
+    for (auto tensor : inputs_) {
+      delete tensor;
+    }
+    delete c_;
+  }
+
+  static constexpr float kInvalidVarCorr = 20.0f;
+
+  // The weight dequantized as the weight decoder does.
+  std::vector<float> DequantWeight() const {
+    auto b_data = reinterpret_cast<const int8_t *>(b_->data());
+    auto quant_params = b_->quant_params();
+    int group_size = case_.group_num == 0 ? case_.deep : case_.deep / case_.group_num;
+    std::vector<float> weight(case_.deep * case_.col);
+    for (int d = 0; d < case_.deep; d++) {
+      for (int c = 0; c < case_.col; c++) {
+        int index = case_.b_transpose ? c * case_.deep + d : d * case_.col + c;
+        const auto &param =
+          case_.group_num == 0 ? quant_params.front() : quant_params.at(c * case_.group_num + d / group_size);
+        float var_corr = param.var_corr == kInvalidVarCorr ? 1.0f : param.var_corr;
+        weight[index] =
+          static_cast<float>((b_data[index] - param.zeroPoint) * param.scale * var_corr + param.mean_corr);
+      }
+    }
+    return weight;
+  }
+
+  std::vector<float> Expect() const {
+    auto weight = DequantWeight();
+    auto a_data = reinterpret_cast<const float *>(a_->data());
+    std::vector<float> expect(case_.row * case_.col);
+    for (int r = 0; r < case_.row; r++) {
+      for (int c = 0; c < case_.col; c++) {
+        double sum = case_.has_bias ? reinterpret_cast<const float *>(bias_->data())[c] : 0.0;
+        for (int d = 0; d < case_.deep; d++) {
+          int index = case_.b_transpose ? c * case_.deep + d : d * case_.col + c;
+          sum += static_cast<double>(a_data[r * case_.deep + d]) * weight[index];
+        }
+        expect[r * case_.col + c] = static_cast<float>(sum);
+      }
+    }
+    return expect;
+  }
+
+  MatMulParameter *NewParameter() const {
+    auto param = reinterpret_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+    memset(param, 0, sizeof(MatMulParameter));
+    param->op_parameter_.thread_num_ = 1;
+    param->b_transpose_ = case_.b_transpose;
+    param->has_bias_ = case_.has_bias;
+    param->act_type_ = ActType_No;
+    return param;
+  }
+
+  WeightQuantCase case_;
+  lite::Tensor *a_ = nullptr;
+  lite::Tensor *b_ = nullptr;
+  lite::Tensor *bias_ = nullptr;
+  lite::Tensor *c_ = nullptr;
+  std::vector<lite::Tensor *> inputs_;
+};
+
+void RunWeightQuantCase(const WeightQuantCase &test_case) {
+  WeightQuantMatmulTester tester(test_case);
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  auto param = tester.NewParameter();
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+  ASSERT_TRUE(kernel::IsWeightQuantMatmul(tester.inputs_));
+  auto kernel = new kernel::MatmulWeightQuantCPUKernel(reinterpret_cast<OpParameter *>(param), tester.inputs_,
+                                                       {tester.c_}, ctx.get());
+  ASSERT_EQ(lite::RET_OK, kernel->Prepare());
+  ASSERT_EQ(lite::RET_OK, kernel->Run());
+  auto expect = tester.Expect();
+  ASSERT_EQ(0, CommonTest::CompareOutputData(reinterpret_cast<float *>(tester.c_->data()), expect.data(),
+                                             static_cast<int>(expect.size())));
+  delete kernel;
+}
+}  // namespace
+
+/// Feature: Weight quantized MatMul of fp32.
+/// Description: Int8 weight with per channel and per tensor quant params, the weight is transposed or not.
+/// Expectation: The output is the same as the matmul of the dequantized weight.
+TEST_F(TestMatmulWeightQuantFp32, Int8) {
+  RunWeightQuantCase({1, 64, 40, 1, 8, true, true});
+  RunWeightQuantCase({7, 33, 17, 1, 8, false, false});
+  RunWeightQuantCase({9, 48, 32, 0, 8, true, false});
+}
+
+/// Feature: Weight quantized MatMul of fp32.
+/// Description: Int4 weight with group-wise quant params.
+/// Expectation: The weight is packed in nibbles and the output is the same as the matmul of the dequantized weight.
+TEST_F(TestMatmulWeightQuantFp32, Int4GroupWise) {
+  RunWeightQuantCase({1, 128, 48, 4, 4, true, true});
+  RunWeightQuantCase({6, 96, 21, 3, 4, false, true});
+}
+
+/// Feature: Weight quantized MatMul of fp32.
+/// Description: Int8 and int4 weight with the var/mean correction of the per channel and group-wise quant params.
+/// Expectation: The output is the same as the matmul of the weight dequantized by the weight decoder, and the var
+/// correction out of range is ignored.
+TEST_F(TestMatmulWeightQuantFp32, VarMeanCorrection) {
+  RunWeightQuantCase({5, 64, 40, 1, 8, true, true, true});
+  RunWeightQuantCase({1, 768, 48, 6, 4, true, false, true});
+  RunWeightQuantCase({6, 96, 21, 3, 4, false, true, true});
+}
+}  // namespace mindspore
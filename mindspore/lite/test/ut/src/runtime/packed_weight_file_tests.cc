@@ -0,0 +1,87 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "src/litert/packed_weight_file.h"
+
+namespace mindspore {
+class PackedWeightFileTest : public mindspore::CommonTest {
+ public:
+  PackedWeightFileTest() = default;
+  void TearDown() override { (void)remove(kPath); }
+
+ protected:
+  const char *kPath = "./packed_weight_file_test.bin";
+};
+
+/// Feature: Packed weight file of the lite session.
+/// Description: The first load records and saves the packed weights, the second load maps them.
+/// Expectation: The mapped packed weights are equal to the recorded ones and aligned.
+TEST_F(PackedWeightFileTest, test_save_and_map) {
+  std::vector<float> weight0(100, 1.0f);
+  std::vector<float> weight1(37, 2.0f);
+  std::vector<char> model(1000, 3);
+  auto model_hash = lite::PackedWeightFile::Hash(model.data(), model.size(), 0);
+  {
+    lite::PackedWeightFile file(kPath, model_hash, model.size());
+    ASSERT_EQ(file.Load(), lite::RET_OK);
+    ASSERT_FALSE(file.IsMapped());
+    file.Record(1, weight0.size() * sizeof(float), weight0.data());
+    file.Record(5, weight1.size() * sizeof(float), weight1.data());
+    ASSERT_EQ(file.Save(), lite::RET_OK);
+  }
+  lite::PackedWeightFile file(kPath, model_hash, model.size());
+  ASSERT_EQ(file.Load(), lite::RET_OK);
+  ASSERT_TRUE(file.IsMapped());
+  auto data0 = file.GetPackData(1, weight0.size() * sizeof(float));
+  auto data1 = file.GetPackData(5, weight1.size() * sizeof(float));
+  ASSERT_NE(data0, nullptr);
+  ASSERT_NE(data1, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(data1) % 64, 0);
+  ASSERT_EQ(memcmp(data0, weight0.data(), weight0.size() * sizeof(float)), 0);
+  ASSERT_EQ(memcmp(data1, weight1.data(), weight1.size() * sizeof(float)), 0);
+  ASSERT_TRUE(file.IsMappedData(data1));
+  ASSERT_FALSE(file.IsMappedData(weight1.data()));
+  // the packed size of another kernel doesn't match.
+  ASSERT_EQ(file.GetPackData(1, sizeof(float)), nullptr);
+  ASSERT_EQ(file.GetPackData(2, weight0.size() * sizeof(float)), nullptr);
+}
+
+/// Feature: Packed weight file of the lite session.
+/// Description: Load the packed weight file with another model.
+/// Expectation: The file is not mapped and the packed weights are recorded again.
+TEST_F(PackedWeightFileTest, test_model_mismatch) {
+  std::vector<float> weight(64, 1.0f);
+  std::vector<char> model(1000, 3);
+  auto model_hash = lite::PackedWeightFile::Hash(model.data(), model.size(), 0);
+  {
+    lite::PackedWeightFile file(kPath, model_hash, model.size());
+    ASSERT_EQ(file.Load(), lite::RET_OK);
+    file.Record(0, weight.size() * sizeof(float), weight.data());
+    ASSERT_EQ(file.Save(), lite::RET_OK);
+  }
+  model[10] = 4;
+  auto new_hash = lite::PackedWeightFile::Hash(model.data(), model.size(), 0);
+  ASSERT_NE(new_hash, model_hash);
+  lite::PackedWeightFile file(kPath, new_hash, model.size());
+  ASSERT_EQ(file.Load(), lite::RET_OK);
+  ASSERT_FALSE(file.IsMapped());
+  ASSERT_EQ(file.GetPackData(0, weight.size() * sizeof(float)), nullptr);
+}
+}  // namespace mindspore
@@ -0,0 +1,151 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "src/litert/runtime_allocator.h"
+
+namespace mindspore {
+class RuntimeAllocatorTest : public mindspore::CommonTest {
+ public:
+  RuntimeAllocatorTest() = default;
+};
+
+/// Feature: Runtime allocator of the lite session.
+/// Description: The tensors of a chain of kernels, each kernel frees its input after its output is malloced.
+/// Expectation: The tensors whose lifetime doesn't overlap share the memory, the peak is two adjacent tensors.
+TEST_F(RuntimeAllocatorTest, test_chain) {
+  constexpr size_t kAlign = 64;
+  std::vector<int> sizes = {100, 200, 100, 200};
+  std::vector<std::unique_ptr<lite::Tensor>> tensors;
+  auto allocator = std::make_shared<RuntimeAllocator>(kAlign);
+  for (size_t i = 0; i < sizes.size(); i++) {
+    tensors.emplace_back(std::make_unique<lite::Tensor>(kNumberTypeInt8, std::vector<int>{sizes[i]}));
+    tensors.back()->set_allocator(allocator);
+    allocator->MallocTensorData(tensors.back().get());
+    if (i > 0) {
+      allocator->FreeTensorData(tensors[i - 1].get());
+    }
+  }
+  auto data = reinterpret_cast<int8_t *>(allocator->MallocOptData());
+  ASSERT_NE(data, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(data) % kAlign, 0);
+  constexpr size_t kPeak = 128 + 256;
+  ASSERT_EQ(allocator->total_size(), kPeak);
+  ASSERT_EQ(allocator->blocks_size(), 128 + 256 + 128 + 256);
+  auto &block_map = allocator->GetBlockMap();
+  ASSERT_EQ(allocator->GetBlockOffset(block_map.at(tensors[1].get())),
+            allocator->GetBlockOffset(block_map.at(tensors[3].get())));
+  allocator->Clear(nullptr);
+  ASSERT_EQ(allocator->GetBlockMap().size(), 0);
+}
+
+/// Feature: Runtime allocator of the lite session.
+/// Description: A chain of 2 kernels with workspaces, the workspace of a kernel lives only while the kernel runs, as
+/// the session plans it between the malloc of the outputs and the free of the inputs.
+/// Expectation: The workspaces don't overlap the live tensors of their kernels, and they share the memory.
+TEST_F(RuntimeAllocatorTest, test_kernel_workspace) {
+  constexpr size_t kAlign = 64;
+  constexpr int kTensorSize = 64;
+  constexpr size_t kWorkspaceSize = 256;
+  std::vector<std::unique_ptr<lite::Tensor>> tensors;
+  auto allocator = std::make_shared<RuntimeAllocator>(kAlign);
+  tensors.emplace_back(std::make_unique<lite::Tensor>(kNumberTypeInt8, std::vector<int>{kTensorSize}));
+  tensors.back()->set_allocator(allocator);
+  allocator->MallocTensorData(tensors.back().get());
+  std::vector<size_t> workspaces;
+  for (size_t i = 1; i <= 2; i++) {
+    tensors.emplace_back(std::make_unique<lite::Tensor>(kNumberTypeInt8, std::vector<int>{kTensorSize}));
+    tensors.back()->set_allocator(allocator);
+    allocator->MallocTensorData(tensors.back().get());
+    workspaces.push_back(allocator->MallocBlock(kWorkspaceSize));
+    allocator->FreeBlock(workspaces.back());
+    allocator->FreeTensorData(tensors[i - 1].get());
+  }
+  ASSERT_NE(allocator->MallocOptData(), nullptr);
+  // Two tensors and a workspace are alive in each kernel.
+  ASSERT_EQ(allocator->total_size(), kTensorSize * 2 + kWorkspaceSize);
+  ASSERT_EQ(allocator->blocks_size(), kTensorSize * 3 + kWorkspaceSize * 2);
+  auto &block_map = allocator->GetBlockMap();
+  auto overlap = [&allocator](size_t offset, size_t size, size_t block_id, size_t block_size) {
+    auto block_offset = allocator->GetBlockOffset(block_id);
+    return offset < block_offset + block_size && block_offset < offset + size;
+  };
+  for (size_t i = 0; i < workspaces.size(); i++) {
+    auto offset = allocator->GetBlockOffset(workspaces[i]);
+    ASSERT_FALSE(overlap(offset, kWorkspaceSize, block_map.at(tensors[i].get()), kTensorSize));
+    ASSERT_FALSE(overlap(offset, kWorkspaceSize, block_map.at(tensors[i + 1].get()), kTensorSize));
+  }
+  ASSERT_TRUE(overlap(allocator->GetBlockOffset(workspaces[0]), kWorkspaceSize, workspaces[1], kWorkspaceSize));
+}
+
+/// Feature: Runtime allocator of the lite session.
+/// Description: Blocks of random size and lifetime.
+/// Expectation: The blocks alive at the same time don't overlap, the peak is not less than the live size of any step.
+TEST_F(RuntimeAllocatorTest, test_random_lifetime) {
+  constexpr size_t kAlign = 64;
+  constexpr size_t kBlockNum = 300;
+  constexpr int kMaxSize = 1 << 16;
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> size_dis(1, kMaxSize);
+  std::uniform_int_distribution<int> op_dis(0, 2);
+  RuntimeAllocator allocator(kAlign);
+  std::vector<size_t> alive;
+  std::vector<std::pair<size_t, size_t>> lifetime;  // [malloc step, free step]
+  std::vector<size_t> sizes;
+  size_t step = 0;
+  size_t live_size = 0;
+  size_t max_live_size = 0;
+  while (sizes.size() < kBlockNum || !alive.empty()) {
+    if (sizes.size() < kBlockNum && (alive.empty() || op_dis(gen) != 0)) {
+      auto size = static_cast<size_t>(size_dis(gen));
+      auto id = allocator.MallocBlock(size);
+      ASSERT_EQ(id, sizes.size());
+      sizes.push_back((size + kAlign - 1) / kAlign * kAlign);
+      lifetime.emplace_back(step, SIZE_MAX);
+      alive.push_back(id);
+      live_size += sizes.back();
+      max_live_size = std::max(max_live_size, live_size);
+    } else {
+      auto index = std::uniform_int_distribution<size_t>(0, alive.size() - 1)(gen);
+      auto id = alive[index];
+      alive.erase(alive.begin() + index);
+      allocator.FreeBlock(id);
+      lifetime[id].second = step;
+      live_size -= sizes[id];
+    }
+    step++;
+  }
+  ASSERT_NE(allocator.MallocOptData(), nullptr);
+  ASSERT_GE(allocator.total_size(), max_live_size);
+  ASSERT_LE(allocator.total_size(), allocator.blocks_size());
+  for (size_t i = 0; i < kBlockNum; i++) {
+    auto offset_i = allocator.GetBlockOffset(i);
+    ASSERT_LE(offset_i + sizes[i], allocator.total_size());
+    for (size_t j = i + 1; j < kBlockNum; j++) {
+      if (lifetime[i].first > lifetime[j].second || lifetime[j].first > lifetime[i].second) {
+        continue;
+      }
+      auto offset_j = allocator.GetBlockOffset(j);
+      ASSERT_TRUE(offset_i + sizes[i] <= offset_j || offset_j + sizes[j] <= offset_i);
+    }
+  }
+  MS_LOG(INFO) << "Planned " << allocator.total_size() << " bytes, the max live size is " << max_live_size
+               << " bytes, the sum is " << allocator.blocks_size() << " bytes.";
+}
+}  // namespace mindspore
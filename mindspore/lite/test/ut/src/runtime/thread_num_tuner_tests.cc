@@ -0,0 +1,99 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <set>
+#include "common/common_test.h"
+#include "src/litert/thread_num_tuner.h"
+
+namespace mindspore {
+class ThreadNumTunerTest : public mindspore::CommonTest {
+ public:
+  ThreadNumTunerTest() = default;
+  void TearDown() override { (void)remove(kPath); }
+
+ protected:
+  const char *kPath = "./thread_num_tuner_test.profile";
+};
+
+namespace {
+// the cost is the least when the kernel runs with the best thread num.
+int TuneToEnd(lite::ThreadNumTuner *tuner, const lite::ThreadNumKey &key, int best, std::set<int> *measured) {
+  bool tuning = false;
+  auto thread_num = tuner->GetThreadNum(key, 1, &tuning);
+  constexpr int kMaxRunNum = 100;
+  for (int i = 0; i < kMaxRunNum && tuning; i++) {
+    (void)measured->insert(thread_num);
+    int64_t cost = 1000 + 100 * (thread_num > best ? thread_num - best : best - thread_num);
+    thread_num = tuner->Report(key, thread_num, cost, &tuning);
+  }
+  return thread_num;
+}
+}  // namespace
+
+/// Feature: Thread num tuner of the lite kernels.
+/// Description: Tune the thread num of a kernel whose best thread num is 4 of 8.
+/// Expectation: The candidates are measured and 4 is decided, the later load gets it from the profile.
+TEST_F(ThreadNumTunerTest, test_tune_and_load) {
+  lite::ThreadNumKey key{1, 1, 1, 1000, 8};
+  {
+    lite::ThreadNumTuner tuner(kPath);
+    ASSERT_EQ(tuner.Load(), lite::RET_OK);
+    std::set<int> measured;
+    ASSERT_EQ(TuneToEnd(&tuner, key, 4, &measured), 4);
+    ASSERT_EQ(measured, std::set<int>({1, 2, 4, 8}));
+    bool tuning = true;
+    ASSERT_EQ(tuner.GetThreadNum(key, 1, &tuning), 4);
+    ASSERT_FALSE(tuning);
+  }
+  lite::ThreadNumTuner tuner(kPath);
+  ASSERT_EQ(tuner.Load(), lite::RET_OK);
+  bool tuning = true;
+  ASSERT_EQ(tuner.GetThreadNum(key, 1, &tuning), 4);
+  ASSERT_FALSE(tuning);
+  // another shape of the kernel is tuned.
+  key.unit_num_ = 2;
+  ASSERT_EQ(tuner.GetThreadNum(key, 1, &tuning), 1);
+  ASSERT_TRUE(tuning);
+}
+
+/// Feature: Thread num tuner of the lite kernels.
+/// Description: The kernel whose units are less than the threads.
+/// Expectation: The thread num is not more than the unit num.
+TEST_F(ThreadNumTunerTest, test_small_kernel) {
+  lite::ThreadNumTuner tuner(kPath);
+  std::set<int> measured;
+  ASSERT_EQ(TuneToEnd(&tuner, {1, 1, 1, 3, 8}, 8, &measured), 3);
+  ASSERT_EQ(measured, std::set<int>({1, 2, 3}));
+  bool tuning = true;
+  ASSERT_EQ(tuner.GetThreadNum({1, 1, 1, 1, 8}, 8, &tuning), 1);
+  ASSERT_FALSE(tuning);
+}
+
+/// Feature: Thread num tuner of the lite kernels.
+/// Description: The kernel reports a thread num which is not the candidate, as a kernel clamping its thread num.
+/// Expectation: The tuning of the kernel stops with the reported thread num instead of waiting for the candidate.
+TEST_F(ThreadNumTunerTest, test_report_not_candidate) {
+  lite::ThreadNumTuner tuner(kPath);
+  lite::ThreadNumKey key{1, 1, 1, 1000, 8};
+  bool tuning = false;
+  ASSERT_EQ(tuner.GetThreadNum(key, 8, &tuning), 1);
+  ASSERT_TRUE(tuning);
+  ASSERT_EQ(tuner.Report(key, 3, 1000, &tuning), 3);
+  ASSERT_FALSE(tuning);
+  ASSERT_EQ(tuner.GetThreadNum(key, 8, &tuning), 3);
+  ASSERT_FALSE(tuning);
+}
+}  // namespace mindspore
@@ -429,6 +429,7 @@ int BenchmarkBase::Init() {
   MS_LOG(INFO) << "InterOpParallelNum = " << this->flags_->inter_op_parallel_num_;
   MS_LOG(INFO) << "Fp16Priority = " << this->flags_->enable_fp16_;
   MS_LOG(INFO) << "EnableParallel = " << this->flags_->enable_parallel_;
+  MS_LOG(INFO) << "EnableInterOpParallel = " << this->flags_->enable_inter_op_parallel_;
   MS_LOG(INFO) << "calibDataPath = " << this->flags_->benchmark_data_file_;
   MS_LOG(INFO) << "EnableGLTexture = " << this->flags_->enable_gl_texture_;
 
@@ -446,6 +447,7 @@ int BenchmarkBase::Init() {
   std::cout << "InterOpParallelNum = " << this->flags_->inter_op_parallel_num_ << std::endl;
   std::cout << "Fp16Priority = " << this->flags_->enable_fp16_ << std::endl;
   std::cout << "EnableParallel = " << this->flags_->enable_parallel_ << std::endl;
+  std::cout << "EnableInterOpParallel = " << this->flags_->enable_inter_op_parallel_ << std::endl;
   std::cout << "calibDataPath = " << this->flags_->benchmark_data_file_ << std::endl;
   std::cout << "EnableGLTexture = " << this->flags_->enable_gl_texture_ << std::endl;
   if (this->flags_->loop_count_ < 1) {
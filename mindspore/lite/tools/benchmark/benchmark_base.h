@@ -129,6 +129,10 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::num_threads_, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::enable_fp16_, "enableFp16", "Enable float16", false);
     AddFlag(&BenchmarkFlags::enable_parallel_, "enableParallel", "Enable subgraph parallel : true | false", false);
+    AddFlag(&BenchmarkFlags::enable_inter_op_parallel_, "enableInterOpParallel",
+            "Run the independent branches of cpu subgraph at the same time, the kernels run one by one with "
+            "timeProfiling : true | false",
+            false);
     AddFlag(&BenchmarkFlags::warm_up_loop_count_, "warmUpLoopCount", "Run warm up loop", 3);
     AddFlag(&BenchmarkFlags::time_profiling_, "timeProfiling", "Run time profiling", false);
     AddFlag(&BenchmarkFlags::perf_profiling_, "perfProfiling",
@@ -196,6 +200,7 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   bool enable_fp16_ = false;
   bool enable_gl_texture_ = false;
   bool enable_parallel_ = false;
+  bool enable_inter_op_parallel_ = false;
   int warm_up_loop_count_ = 3;
   // MarkAccuracy
   std::string benchmark_data_file_;
@@ -1273,6 +1273,9 @@ int BenchmarkUnifiedApi::RunBenchmark() {
   }
 
   UpdateConfigInfo();
+  if (flags_->enable_inter_op_parallel_) {
+    ms_model_.UpdateConfig(kCpuContextSection, std::make_pair(kEnableInterOpParallelKey, "true"));
+  }
 #ifdef PARALLEL_INFERENCE
   if (flags_->enable_parallel_predict_) {
     MS_CHECK_FALSE_MSG(flags_->resize_dims_.empty(), RET_ERROR, "use parallel predict, inputShapes can not use empty.");
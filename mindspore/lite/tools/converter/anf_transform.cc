@@ -54,6 +54,7 @@
 #include "tools/optimizer/fusion/encoder_layer_fusion.h"
 #include "tools/optimizer/fusion/glu_fusion.h"
 #include "tools/optimizer/fusion/tflite_rel_pos_multi_head_attention_fusion.h"
+#include "tools/optimizer/fusion/flash_attention_fusion.h"
 #include "tools/optimizer/fusion/matmul_add_fusion.h"
 #include "tools/optimizer/fusion/matmul_mul_fusion.h"
 #include "tools/optimizer/fusion/mul_add_fusion.h"
@@ -303,6 +304,7 @@ int AnfTransform::RunFusionPass(const FuncGraphPtr &old_graph, const std::shared
                                     std::make_shared<opt::TfGeLUFusion>(),
                                     std::make_shared<opt::OnnxGeLUFusion>(),
                                     std::make_shared<opt::TfliteRelPosMultiHeadAttentionFusion>(),
+                                    std::make_shared<opt::FlashAttentionFusion>(param),
                                     std::make_shared<opt::GLUFusion>(),
                                     std::make_shared<opt::ResizeFusion1>(),
                                     std::make_shared<opt::ResizeFusion2>(),
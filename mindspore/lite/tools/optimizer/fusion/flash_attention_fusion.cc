@@ -0,0 +1,295 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define USE_DEPRECATED_API
+#include "tools/optimizer/fusion/flash_attention_fusion.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+#include "ops/custom.h"
+#include "ops/softmax.h"
+#include "ops/fusion/mat_mul_fusion.h"
+#include "ops/fusion/add_fusion.h"
+#include "ops/op_utils.h"
+#include "tools/optimizer/common/gllo_utils.h"
+#include "nnacl/op_base.h"
+
+namespace mindspore::opt {
+namespace {
+constexpr auto kFlashAttentionType = "FlashAttention";
+constexpr size_t kMatrixDims = 2;
+// The logits added by the mask not larger than it are regarded as masked out.
+constexpr float kMaskedValue = -10000.0f;
+
+bool IsPlainMatMul(const AnfNodePtr &node) {
+  if (!CheckPrimitiveType(node, prim::kPrimMatMulFusion)) {
+    return false;
+  }
+  auto matmul_cnode = node->cast<CNodePtr>();
+  // The matmul with bias is not a part of the attention.
+  if (matmul_cnode == nullptr || matmul_cnode->size() != kInputSizeThree || IsMarkedTrainOp(matmul_cnode)) {
+    return false;
+  }
+  auto matmul_prim = ops::GetOperator<ops::MatMulFusion>(matmul_cnode->input(0));
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, false);
+  if (matmul_prim->GetAttr(ops::kActivationType) != nullptr &&
+      matmul_prim->get_activation_type() != ActivationType::NO_ACTIVATION) {
+    return false;
+  }
+  if (IsQuantParameterNode(matmul_prim->GetPrim())) {
+    return false;
+  }
+  return matmul_prim->GetAttr(ops::kTransposeA) == nullptr || !matmul_prim->get_transpose_a();
+}
+
+bool IsTransposeB(const CNodePtr &matmul_cnode) {
+  auto matmul_prim = ops::GetOperator<ops::MatMulFusion>(matmul_cnode->input(0));
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, false);
+  return matmul_prim->GetAttr(ops::kTransposeB) != nullptr && matmul_prim->get_transpose_b();
+}
+
+bool IsWithoutActivation(const CNodePtr &cnode) {
+  auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+  MS_CHECK_TRUE_RET(prim != nullptr, false);
+  auto act = prim->GetAttr(ops::kActivationType);
+  return act == nullptr || GetValue<int64_t>(act) == static_cast<int64_t>(ActivationType::NO_ACTIVATION);
+}
+
+bool GetScalarValue(const AnfNodePtr &node, float *value) {
+  if (!IsParamNode(node)) {
+    return false;
+  }
+  auto tensor = GetTensorInfo(node);
+  if (tensor == nullptr || tensor->data_type() != kNumberTypeFloat32 || tensor->DataSize() != 1 ||
+      tensor->data_c() == nullptr) {
+    return false;
+  }
+  *value = *reinterpret_cast<float *>(tensor->data_c());
+  return true;
+}
+
+bool IsFloat32(const AnfNodePtr &node) {
+  TypeId type_id = kTypeUnknown;
+  return GetDataTypeFromAnfNode(node, &type_id) == RET_OK && type_id == kNumberTypeFloat32;
+}
+
+// Whether the const mask only masks out the keys after the diagonal, so the kernel can skip them instead of reading
+// the mask.
+bool IsCausalMask(const AnfNodePtr &mask, int64_t q_seq, int64_t k_seq) {
+  if (!IsParamNode(mask)) {
+    return false;
+  }
+  auto tensor = GetTensorInfo(mask);
+  if (tensor == nullptr || tensor->data_type() != kNumberTypeFloat32 || tensor->data_c() == nullptr) {
+    return false;
+  }
+  auto shape = tensor->shape();
+  if (shape.size() < kMatrixDims || shape[shape.size() - kMatrixDims] != q_seq || shape.back() != k_seq ||
+      q_seq <= 1) {
+    return false;
+  }
+  if (std::any_of(shape.begin(), shape.end() - kMatrixDims, [](int64_t dim) { return dim != 1; })) {
+    return false;
+  }
+  auto data = reinterpret_cast<float *>(tensor->data_c());
+  for (int64_t i = 0; i < q_seq; ++i) {
+    for (int64_t j = 0; j < k_seq; ++j) {
+      float value = data[i * k_seq + j];
+      bool visible = j <= i + k_seq - q_seq;
+      if ((visible && value != 0.0f) || (!visible && value > kMaskedValue)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CheckShapes(const AnfNodePtr &query, const AnfNodePtr &key, const AnfNodePtr &value, const AnfNodePtr &mask,
+                 bool key_transpose) {
+  auto q_shape = GetAnfNodeOutputShape(query, 0);
+  auto k_shape = GetAnfNodeOutputShape(key, 0);
+  auto v_shape = GetAnfNodeOutputShape(value, 0);
+  auto rank = q_shape.size();
+  if (rank < kMatrixDims || k_shape.size() != rank || v_shape.size() != rank) {
+    return false;
+  }
+  // The kernel doesn't broadcast the batch dims of query, key and value like the matmul.
+  for (size_t i = 0; i < rank - kMatrixDims; ++i) {
+    if (q_shape[i] <= 0 || k_shape[i] != q_shape[i] || v_shape[i] != q_shape[i]) {
+      return false;
+    }
+  }
+  auto k_head_size = key_transpose ? k_shape[rank - kMatrixDims] : k_shape[rank - 1];
+  if (q_shape[rank - 1] <= 0 || k_head_size != q_shape[rank - 1]) {
+    return false;
+  }
+  if (mask == nullptr) {
+    return true;
+  }
+  // Keep the same with the mask broadcast of the kernel: [batch dims..., 1 or q_seq, k_seq] from the right.
+  auto mask_shape = GetAnfNodeOutputShape(mask, 0);
+  if (mask_shape.empty() || mask_shape.size() > rank) {
+    return false;
+  }
+  auto k_seq = key_transpose ? k_shape[rank - 1] : k_shape[rank - kMatrixDims];
+  if (k_seq <= 0 || mask_shape.back() != k_seq) {
+    return false;
+  }
+  (void)mask_shape.insert(mask_shape.begin(), rank - mask_shape.size(), 1);
+  auto mask_rows = mask_shape[rank - kMatrixDims];
+  if (mask_rows != 1 && mask_rows != q_shape[rank - kMatrixDims]) {
+    return false;
+  }
+  for (size_t i = 0; i < rank - kMatrixDims; ++i) {
+    if (mask_shape[i] != 1 && mask_shape[i] != q_shape[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<uint8_t> ToBytes(const void *data, size_t size) {
+  auto bytes = static_cast<const uint8_t *>(data);
+  return std::vector<uint8_t>(bytes, bytes + size);
+}
+}  // namespace
+
+const BaseRef FlashAttentionFusion::DefinePattern() const {
+  auto is_matmul = std::make_shared<CondVar>(IsSpecifiedNode<&prim::kPrimMatMulFusion>);
+  MS_CHECK_TRUE_RET(is_matmul != nullptr, {});
+  auto is_softmax = std::make_shared<CondVar>(IsSpecifiedNode<&prim::kPrimSoftmax>);
+  MS_CHECK_TRUE_RET(is_softmax != nullptr, {});
+  auto logits = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(logits != nullptr, {});
+  auto value = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(value != nullptr, {});
+  auto softmax = VectorRef({is_softmax, logits});
+  return VectorRef({is_matmul, softmax, value});
+}
+
+const AnfNodePtr FlashAttentionFusion::Process(const FuncGraphPtr &func_graph, const AnfNodePtr &node,
+                                               const EquivPtr &) const {
+  if (func_graph == nullptr || node == nullptr) {
+    return nullptr;
+  }
+  // The attention of transformer is fused by MultiHeadAttentionFusion for the cloud inference.
+  if (param_->optimize_transformer || param_->device.find("Ascend") != std::string::npos) {
+    return nullptr;
+  }
+  auto pv_matmul = node->cast<CNodePtr>();
+  if (!IsPlainMatMul(pv_matmul) || IsTransposeB(pv_matmul)) {
+    return nullptr;
+  }
+  auto softmax = pv_matmul->input(kInputIndexOne)->cast<CNodePtr>();
+  MS_CHECK_TRUE_RET(softmax != nullptr, nullptr);
+  if (IsMarkedTrainOp(softmax) || IsMultiOutputTensors(func_graph, softmax)) {
+    return nullptr;
+  }
+  auto softmax_prim = ops::GetOperator<ops::Softmax>(softmax->input(0));
+  MS_CHECK_TRUE_RET(softmax_prim != nullptr, nullptr);
+  auto softmax_shape = GetAnfNodeOutputShape(softmax, 0);
+  if (softmax_prim->GetAttr(ops::kAxis) == nullptr || softmax_prim->get_axis().size() != 1) {
+    return nullptr;
+  }
+  auto axis = softmax_prim->get_axis().front();
+  if (axis != -1 && axis != static_cast<int64_t>(softmax_shape.size()) - 1) {
+    return nullptr;
+  }
+
+  // Walk up from the softmax to the matmul of query and key.
+  auto logits = softmax->input(kInputIndexOne);
+  AnfNodePtr mask = nullptr;
+  float scale = 1.0f;
+  auto is_logits = [](const AnfNodePtr &input) {
+    return CheckPrimitiveType(input, prim::kPrimMatMulFusion) || CheckPrimitiveType(input, prim::kPrimMulFusion) ||
+           CheckPrimitiveType(input, prim::kPrimDivFusion);
+  };
+  if (CheckPrimitiveType(logits, prim::kPrimAddFusion)) {
+    auto add = logits->cast<CNodePtr>();
+    if (add->size() != kInputSizeThree || !IsWithoutActivation(add) || IsMultiOutputTensors(func_graph, add)) {
+      return nullptr;
+    }
+    size_t logits_index = is_logits(add->input(kInputIndexOne)) ? kInputIndexOne : kInputIndexTwo;
+    logits = add->input(logits_index);
+    mask = add->input(logits_index == kInputIndexOne ? kInputIndexTwo : kInputIndexOne);
+  }
+  if (CheckPrimitiveType(logits, prim::kPrimMulFusion) || CheckPrimitiveType(logits, prim::kPrimDivFusion)) {
+    auto scale_cnode = logits->cast<CNodePtr>();
+    if (scale_cnode->size() != kInputSizeThree || !IsWithoutActivation(scale_cnode) ||
+        IsMultiOutputTensors(func_graph, scale_cnode)) {
+      return nullptr;
+    }
+    float scale_value = 0.0f;
+    bool is_mul = CheckPrimitiveType(logits, prim::kPrimMulFusion);
+    if (GetScalarValue(scale_cnode->input(kInputIndexTwo), &scale_value)) {
+      logits = scale_cnode->input(kInputIndexOne);
+    } else if (is_mul && GetScalarValue(scale_cnode->input(kInputIndexOne), &scale_value)) {
+      logits = scale_cnode->input(kInputIndexTwo);
+    } else {
+      return nullptr;
+    }
+    if (!is_mul && scale_value == 0.0f) {
+      return nullptr;
+    }
+    scale = is_mul ? scale_value : 1.0f / scale_value;
+  }
+  if (!IsPlainMatMul(logits) || IsMultiOutputTensors(func_graph, logits)) {
+    return nullptr;
+  }
+  auto qk_matmul = logits->cast<CNodePtr>();
+  auto query = qk_matmul->input(kInputIndexOne);
+  auto key = qk_matmul->input(kInputIndexTwo);
+  auto value = pv_matmul->input(kInputIndexTwo);
+  bool key_transpose = !IsTransposeB(qk_matmul);
+  if (!IsFloat32(query) || !IsFloat32(key) || !IsFloat32(value) || (mask != nullptr && !IsFloat32(mask))) {
+    return nullptr;
+  }
+  if (!CheckShapes(query, key, value, mask, key_transpose)) {
+    MS_LOG(INFO) << "The shapes of attention " << node->fullname_with_scope() << " are not supported by fusion.";
+    return nullptr;
+  }
+  bool causal = false;
+  if (mask != nullptr && softmax_shape.size() >= kMatrixDims &&
+      IsCausalMask(mask, softmax_shape[softmax_shape.size() - kMatrixDims], softmax_shape.back())) {
+    causal = true;
+    mask = nullptr;
+  }
+
+  auto attention_prim = std::make_shared<ops::Custom>();
+  MS_CHECK_TRUE_RET(attention_prim != nullptr, nullptr);
+  std::map<std::string, std::vector<uint8_t>> attrs;
+  attrs["scale"] = ToBytes(&scale, sizeof(float));
+  attrs["causal"] = ToBytes(&causal, sizeof(bool));
+  attrs["key_transpose"] = ToBytes(&key_transpose, sizeof(bool));
+  attention_prim->set_type(kFlashAttentionType);
+  attention_prim->set_attr(attrs);
+  auto attention_prim_c = attention_prim->GetPrim();
+  MS_CHECK_TRUE_RET(attention_prim_c != nullptr, nullptr);
+  std::vector<AnfNodePtr> inputs = {query, key, value};
+  if (mask != nullptr) {
+    inputs.push_back(mask);
+  }
+  auto attention = func_graph->NewCNode(attention_prim_c, inputs);
+  MS_CHECK_TRUE_RET(attention != nullptr, nullptr);
+  attention->set_fullname_with_scope(node->fullname_with_scope() + "_flash_attention");
+  if (node->abstract() != nullptr) {
+    attention->set_abstract(node->abstract()->Clone());
+  }
+  MS_LOG(INFO) << "Fuse attention " << attention->fullname_with_scope() << ", causal: " << causal
+               << ", has mask: " << (mask != nullptr);
+  return attention;
+}
+}  // namespace mindspore::opt
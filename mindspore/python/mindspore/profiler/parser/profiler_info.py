@@ -92,6 +92,17 @@ class ProfilerInfo:
         """Set is it heterogeneous."""
         ProfilerInfo._profiler_info_dict["is_heterogeneous"] = is_heterogeneous
 
+    @staticmethod
+    def set_infer_cache_info(hit_count, miss_count, resize_skipped_count):
+        """Set the hit rate of the infer shape and resize cache of the dynamic shape kernels."""
+        info = dict()
+        info["infer_cache_hit_count"] = hit_count
+        info["infer_cache_miss_count"] = miss_count
+        total = hit_count + miss_count
+        info["infer_cache_hit_rate"] = hit_count / total if total else 0.0
+        info["resize_skipped_count"] = resize_skipped_count
+        ProfilerInfo._profiler_info_dict["infer_cache"] = info
+
     @staticmethod
     def get_profiler_info():
         """Get the profiler info."""
@@ -366,6 +366,10 @@ class Profiler:
         ProfilerInfo.set_analyse_end_time(time.strftime("%Y-%m-%d %H:%M:%S", time.localtime()))
         ProfilerInfo.set_rank_size(self._rank_size)
         ProfilerInfo.set_heterogeneous(self._is_heterogeneous)
+        if self._dynamic_status:
+            ProfilerInfo.set_infer_cache_info(self._profiler_manager.infer_cache_hit_count(),
+                                              self._profiler_manager.infer_cache_miss_count(),
+                                              self._profiler_manager.resize_skipped_count())
         ProfilerInfo.save(self._output_path)
 
     def start(self):
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <gtest/gtest.h>
+#include "distributed/cluster/actor_route_table_proxy.h"
+#include "distributed/cluster/topology/compute_graph_node.h"
+#include "distributed/cluster/topology/meta_server_node.h"
+#include "distributed/recovery/recovery_context.h"
+#include "utils/ms_utils.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace distributed {
+namespace cluster {
+class TestActorRouteTableProxy : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  topology::ActorAddress MakeAddress(const std::string &actor_id, uint32_t port) {
+    topology::ActorAddress address;
+    address.set_actor_id(actor_id);
+    address.set_ip("127.0.0.1");
+    address.set_port(port);
+    return address;
+  }
+};
+
+/// Feature: test the cache of the actor routes in the actor route table proxy.
+/// Description: register 2 routes and look them up, then delete one route, re-register the other one with a new port,
+/// and look up a new route which makes the proxy fetch the changes.
+/// Expectation: the deleted route is dropped from the cache, and the re-registered route is updated in the cache.
+TEST_F(TestActorRouteTableProxy, DropDeletedRoutes) {
+  std::string server_host = "127.0.0.1";
+  std::string server_port = "8090";
+  common::SetEnv(topology::kEnvMetaServerHost, server_host.c_str());
+  common::SetEnv(topology::kEnvMetaServerPort, server_port.c_str());
+  common::SetEnv(recovery::kEnvEnableRecovery, "0");
+
+  size_t total_node_num = 1;
+  topology::MetaServerNode msn("meta_server_node", "scheduler", total_node_num);
+  ASSERT_TRUE(msn.Initialize());
+  auto cgn = std::make_shared<topology::ComputeGraphNode>("compute_graph_node", "worker");
+  ASSERT_TRUE(cgn->Initialize());
+
+  size_t interval = 1;
+  size_t retry = 30;
+  while (((msn.GetAliveNodeNum() != total_node_num) || (msn.TopologyState() != topology::TopoState::kInitialized)) &&
+         (retry-- > 0)) {
+    sleep(interval);
+  }
+  ASSERT_EQ(topology::TopoState::kInitialized, msn.TopologyState());
+
+  // The lookup of a missing route fails without waiting for the registration.
+  ActorRouteTableProxy proxy(cgn, 0);
+  ASSERT_TRUE(proxy.RegisterRoute("actor_a", MakeAddress("actor_a", 1000)));
+  ASSERT_TRUE(proxy.RegisterRoute("actor_b", MakeAddress("actor_b", 1001)));
+  EXPECT_EQ(proxy.LookupRoute("actor_a").port(), 1000);
+  EXPECT_EQ(proxy.LookupRoute("actor_b").port(), 1001);
+
+  ASSERT_TRUE(cgn->DeleteMetadata(std::string(kActorRoutePrefix) + "actor_a"));
+  ASSERT_TRUE(proxy.RegisterRoute("actor_b", MakeAddress("actor_b", 2001)));
+  ASSERT_TRUE(proxy.RegisterRoute("actor_c", MakeAddress("actor_c", 1002)));
+  EXPECT_EQ(proxy.LookupRoute("actor_c").port(), 1002);
+  EXPECT_EQ(proxy.LookupRoute("actor_b").port(), 2001);
+  EXPECT_ANY_THROW(proxy.LookupRoute("actor_a"));
+
+  cgn->Finalize();
+  retry = 30;
+  while ((msn.GetAliveNodeNum() > 0 || msn.TopologyState() != topology::TopoState::kFinished) && retry-- > 0) {
+    sleep(interval);
+  }
+  msn.Finalize();
+}
+}  // namespace cluster
+}  // namespace distributed
+}  // namespace mindspore
@@ -14,8 +14,14 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
 #include <gtest/gtest.h>
+#include "proto/topology.pb.h"
+#include "distributed/rpc/tcp/tcp_client.h"
+#include "distributed/cluster/topology/utils.h"
 #include "distributed/cluster/topology/compute_graph_node.h"
 #include "distributed/cluster/topology/meta_server_node.h"
 #include "distributed/recovery/recovery_context.h"
@@ -532,6 +538,116 @@ TEST_F(TestDynamicNetworking, GetHostNames) {
 
   msn.Finalize();
 }
+
+/// Feature: test the meta server node with a synthetic cluster of thousands of compute graph nodes.
+/// Description: simulate 2000 nodes over localhost by 8 tcp clients concurrently, which register the nodes, write the
+/// metadata of the nodes and send several rounds of heartbeats of all the nodes, then read the metadata delta.
+/// Expectation: all the nodes are registered and alive, all the requests are responded, and the metadata delta only
+/// contains the metadata written after the given version.
+TEST_F(TestDynamicNetworking, SyntheticClusterBenchmark) {
+  std::string server_host = "127.0.0.1";
+  std::string server_port = "8090";
+  common::SetEnv(kEnvMetaServerHost, server_host.c_str());
+  common::SetEnv(kEnvMetaServerPort, server_port.c_str());
+  common::SetEnv(recovery::kEnvEnableRecovery, "0");
+  std::string server_url = server_host + ":" + server_port;
+  std::string meta_prefix = "synthetic_meta:";
+
+  const size_t client_num = 8;
+  const size_t node_num_per_client = 250;
+  const size_t total_node_num = client_num * node_num_per_client;
+  const size_t heartbeat_round_num = 5;
+  const uint32_t timeout = 30;
+  MetaServerNode msn("meta_server_node", "scheduler", total_node_num);
+  ASSERT_TRUE(msn.Initialize());
+
+  std::atomic<size_t> responded_num(0);
+  auto run_client = [&](size_t client_index) {
+    auto client = std::make_unique<rpc::TCPClient>();
+    if (!client->Initialize() || !client->Connect(server_url)) {
+      return;
+    }
+    // The round 0 registers the nodes and writes their metadata, the other rounds send heartbeats.
+    for (size_t round = 0; round <= heartbeat_round_num; ++round) {
+      for (size_t i = 0; i < node_num_per_client; ++i) {
+        auto node_id = "synthetic_node_" + std::to_string(client_index * node_num_per_client + i);
+        std::unique_ptr<MessageBase> message;
+        if (round == 0) {
+          RegistrationMessage reg_msg;
+          reg_msg.set_node_id(node_id);
+          reg_msg.set_host_name(server_host);
+          reg_msg.set_role("worker");
+          message = CreateMessage(server_url, MessageName::kRegistration, reg_msg.SerializeAsString());
+        } else {
+          HeartbeatMessage hb_msg;
+          hb_msg.set_node_id(node_id);
+          message = CreateMessage(server_url, MessageName::kHeartbeat, hb_msg.SerializeAsString());
+        }
+        auto response = client->ReceiveSync(std::move(message), timeout);
+        if (response != rpc::NULL_MSG) {
+          ++responded_num;
+          delete response;
+        }
+        if (round == 0) {
+          MetadataMessage meta_msg;
+          meta_msg.set_name(meta_prefix + node_id);
+          meta_msg.set_value(node_id);
+          (void)client->SendSync(CreateMessage(server_url, MessageName::kWriteMetadata, meta_msg.SerializeAsString()));
+        }
+      }
+    }
+    (void)client->Disconnect(server_url);
+    client->Finalize();
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> clients;
+  for (size_t i = 0; i < client_num; ++i) {
+    (void)clients.emplace_back(run_client, i);
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  MS_LOG(WARNING) << "The registration and " << heartbeat_round_num << " rounds of heartbeats of " << total_node_num
+                  << " simulated nodes cost " << elapsed.count() << "ms.";
+  EXPECT_EQ(total_node_num * (heartbeat_round_num + 1), responded_num.load());
+
+  size_t interval = 1;
+  size_t retry = 30;
+  while (((msn.GetAliveNodeNum() != total_node_num) || (msn.TopologyState() != TopoState::kInitialized)) &&
+         (retry-- > 0)) {
+    sleep(interval);
+  }
+  ASSERT_EQ(total_node_num, msn.GetAliveNodeNum());
+  ASSERT_EQ(TopoState::kInitialized, msn.TopologyState());
+
+  // Read the metadata delta from the version 0, and then from the returned version.
+  auto client = std::make_unique<rpc::TCPClient>();
+  ASSERT_TRUE(client->Initialize());
+  ASSERT_TRUE(client->Connect(server_url));
+  auto read_delta = [&](uint64_t version, MetadataDeltaRespMessage *resp_msg) {
+    MetadataDeltaMessage delta_msg;
+    delta_msg.set_prefix(meta_prefix);
+    delta_msg.set_version(version);
+    auto response = client->ReceiveSync(
+      CreateMessage(server_url, MessageName::kReadMetadataDelta, delta_msg.SerializeAsString()), timeout);
+    ASSERT_NE(response, rpc::NULL_MSG);
+    (void)resp_msg->ParseFromArray(response->body.c_str(), SizeToInt(response->body.length()));
+    delete response;
+  };
+  MetadataDeltaRespMessage resp_msg;
+  read_delta(0, &resp_msg);
+  ASSERT_EQ(total_node_num, resp_msg.entries_size());
+  MetadataDeltaRespMessage next_resp_msg;
+  read_delta(resp_msg.version(), &next_resp_msg);
+  ASSERT_EQ(0, next_resp_msg.entries_size());
+  ASSERT_EQ(resp_msg.version(), next_resp_msg.version());
+  (void)client->Disconnect(server_url);
+  client->Finalize();
+
+  msn.Finalize(true);
+}
 }  // namespace topology
 }  // namespace cluster
 }  // namespace distributed
@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <string>
+#include <thread>
 
 #include "common/common_test.h"
 #include "distributed/embedding_cache/embedding_storage/dense_embedding_storage.h"
@@ -98,6 +99,54 @@ TEST_F(TestDenseEmbeddingStorage, test_dense_embedding_storage) {
 
   EXPECT_NO_THROW(embed_storage.Finalize());
 }
+
+/// Feature: test dense embedding storage accessed concurrently.
+/// Description: multiple threads put and get the embeddings of different keys at the same time, and the cache capacity
+/// is less than the total key number.
+/// Expectation: every thread gets the embeddings it puts.
+TEST_F(TestDenseEmbeddingStorage, test_dense_embedding_storage_concurrently) {
+  int32_t embedding_key = 1;
+  size_t embedding_dim = 8;
+  size_t capacity = 32;
+  DenseEmbeddingStorage<int, float, std::allocator<uint8_t>> embed_storage(embedding_key, embedding_dim, capacity);
+  std::unique_ptr<float[]> embedding_table = std::make_unique<float[]>(capacity * embedding_dim);
+  DeviceAddressPtr device_address =
+    std::make_shared<CPUDeviceAddress>(embedding_table.get(), capacity * embedding_dim * sizeof(float));
+  EXPECT_NE(device_address, nullptr);
+  EXPECT_NO_THROW(embed_storage.Initialize(device_address.get()));
+
+  size_t thread_num = 4;
+  size_t key_num = 10;
+  size_t round_num = 20;
+  std::vector<uint8_t> results(thread_num, 1);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      std::vector<int> keys(key_num);
+      std::iota(keys.begin(), keys.end(), t * key_num);
+      std::vector<float> embeddings_to_put(key_num * embedding_dim);
+      std::vector<float> embeddings_to_get(key_num * embedding_dim);
+      for (size_t r = 0; r < round_num; r++) {
+        for (size_t i = 0; i < embeddings_to_put.size(); i++) {
+          embeddings_to_put[i] = static_cast<float>(t * round_num + r);
+        }
+        bool ret = embed_storage.Put({keys.data(), key_num * sizeof(int)},
+                                     {embeddings_to_put.data(), embeddings_to_put.size() * sizeof(float)}) &&
+                   embed_storage.Get({keys.data(), key_num * sizeof(int)},
+                                     {embeddings_to_get.data(), embeddings_to_get.size() * sizeof(float)});
+        if (!ret || embeddings_to_get != embeddings_to_put) {
+          results[t] = 0;
+          return;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(results, std::vector<uint8_t>(thread_num, 1));
+  EXPECT_NO_THROW(embed_storage.Finalize());
+}
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
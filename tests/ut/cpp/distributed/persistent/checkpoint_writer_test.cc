@@ -0,0 +1,153 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+
+#include <ftw.h>
+#include <map>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "distributed/persistent/storage/checkpoint_writer.h"
+#include "distributed/persistent/storage/constants.h"
+#include "distributed/persistent/storage/file_io_utils.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+namespace {
+constexpr char kStorageFilePath[] = "./checkpoint_writer_storage";
+constexpr int kMaxOpenFds = 16;
+
+int RemoveFile(const char *path, const struct stat *, int, struct FTW *) { return remove(path); }
+}  // namespace
+
+class TestCheckpointWriter : public UT::Common {
+ public:
+  TestCheckpointWriter() = default;
+  virtual ~TestCheckpointWriter() = default;
+
+  void SetUp() override {}
+  void TearDown() override { (void)nftw(kStorageFilePath, RemoveFile, kMaxOpenFds, FTW_DEPTH | FTW_PHYS); }
+};
+
+/// Feature: Test the asynchronous incremental checkpoint writer.
+/// Description: Save 2 tensors in blocks, change one block and save again incrementally, then load them.
+/// Expectation: Only the changed block is written to the files of a new version by the incremental save, the files of
+/// the old version are removed, and the loaded tensors are the latest ones.
+TEST_F(TestCheckpointWriter, test_incremental_checkpoint) {
+  std::string storage_file_path = kStorageFilePath;
+  FileIOUtils::CreateDirRecursive(storage_file_path);
+  std::map<std::string, std::string> config_map;
+  config_map.emplace(kFileStoragePath, storage_file_path);
+  // The max block length 64 bytes, i.e. 16 floats.
+  config_map.emplace(kMaxBlockLength, "64");
+  config_map.emplace(kWriterThreadNum, "2");
+
+  std::vector<float> weight(100);
+  std::vector<float> bias(10);
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<float>(i);
+  }
+  for (size_t i = 0; i < bias.size(); ++i) {
+    bias[i] = static_cast<float>(i) * 0.5f;
+  }
+  std::vector<CheckpointInput> inputs = {{"weight", {weight.data(), weight.size() * sizeof(float)}},
+                                         {"bias", {bias.data(), bias.size() * sizeof(float)}}};
+
+  auto writer = std::make_unique<CheckpointWriter>(config_map);
+  EXPECT_NO_THROW(writer->Initialize());
+  // The weight is in 7 blocks, and the bias is in 1 block.
+  EXPECT_EQ(writer->Save(1, inputs), 8);
+  // The tensors could be changed right after saving.
+  weight[20] = -1.0f;
+  EXPECT_EQ(writer->Save(2, inputs), 1);
+  EXPECT_TRUE(writer->Wait());
+  std::string weight_dir = storage_file_path + "/" + kTensorDirPrefix + "0/";
+  EXPECT_TRUE(FileIOUtils::IsFileOrDirExist(weight_dir + kBlockFilePrefix + "0_v1"));
+  EXPECT_TRUE(FileIOUtils::IsFileOrDirExist(weight_dir + kBlockFilePrefix + "1_v2"));
+  EXPECT_FALSE(FileIOUtils::IsFileOrDirExist(weight_dir + kBlockFilePrefix + "1_v1"));
+  EXPECT_FALSE(FileIOUtils::IsFileOrDirExist(weight_dir + kBlockMetaFilePrefix + "1_v1" + kJsonSuffix));
+  EXPECT_EQ(writer->Save(3, inputs), 0);
+  EXPECT_EQ(writer->Save(4, inputs, false), 8);
+  EXPECT_TRUE(writer->Wait());
+
+  std::vector<float> loaded_weight(weight.size());
+  std::vector<float> loaded_bias(bias.size());
+  int64_t step = 0;
+  EXPECT_TRUE(writer->Load({{"bias", {loaded_bias.data(), loaded_bias.size() * sizeof(float)}},
+                            {"weight", {loaded_weight.data(), loaded_weight.size() * sizeof(float)}}},
+                           &step));
+  EXPECT_EQ(step, 4);
+  EXPECT_EQ(loaded_weight, weight);
+  EXPECT_EQ(loaded_bias, bias);
+
+  // The tensor which is not in the checkpoint or of the different size could not be loaded.
+  EXPECT_FALSE(writer->Load({{"moment", {loaded_bias.data(), loaded_bias.size() * sizeof(float)}}}, &step));
+  EXPECT_FALSE(writer->Load({{"bias", {loaded_bias.data(), sizeof(float)}}}, &step));
+
+  // The tampered block is detected by sha256, the bias is written by the save of version 4 at last.
+  std::ofstream block_file(storage_file_path + "/" + kTensorDirPrefix + "1/" + kBlockFilePrefix + "0_v4",
+                           std::ios::binary | std::ios::out);
+  block_file << "tampered";
+  block_file.close();
+  EXPECT_FALSE(writer->Load({{"bias", {loaded_bias.data(), loaded_bias.size() * sizeof(float)}}}, &step));
+  EXPECT_NO_THROW(writer->Finalize());
+}
+
+/// Feature: Test the asynchronous incremental checkpoint writer.
+/// Description: Save a tensor, then fail the incremental save by occupying the file name of its changed block with a
+/// directory, and load the tensor with a new writer.
+/// Expectation: The failed save leaves the last checkpoint loadable, and the next save rewrites all the blocks.
+TEST_F(TestCheckpointWriter, test_failed_incremental_checkpoint) {
+  std::string storage_file_path = kStorageFilePath;
+  std::map<std::string, std::string> config_map;
+  config_map.emplace(kFileStoragePath, storage_file_path);
+  config_map.emplace(kMaxBlockLength, "64");
+
+  std::vector<float> weight(32, 1.0f);
+  std::vector<CheckpointInput> inputs = {{"weight", {weight.data(), weight.size() * sizeof(float)}}};
+  auto writer = std::make_unique<CheckpointWriter>(config_map);
+  EXPECT_NO_THROW(writer->Initialize());
+  EXPECT_EQ(writer->Save(1, inputs), 2);
+  EXPECT_TRUE(writer->Wait());
+
+  FileIOUtils::CreateDir(storage_file_path + "/" + kTensorDirPrefix + "0/" + kBlockFilePrefix + "1_v2");
+  weight[20] = -1.0f;
+  EXPECT_EQ(writer->Save(2, inputs), 1);
+  EXPECT_FALSE(writer->Wait());
+  EXPECT_NO_THROW(writer->Finalize());
+
+  auto reader = std::make_unique<CheckpointWriter>(config_map);
+  EXPECT_NO_THROW(reader->Initialize());
+  std::vector<float> loaded_weight(weight.size());
+  int64_t step = 0;
+  EXPECT_TRUE(reader->Load({{"weight", {loaded_weight.data(), loaded_weight.size() * sizeof(float)}}}, &step));
+  EXPECT_EQ(step, 1);
+  EXPECT_EQ(loaded_weight, std::vector<float>(weight.size(), 1.0f));
+
+  EXPECT_EQ(reader->Save(3, inputs), 2);
+  EXPECT_TRUE(reader->Wait());
+  EXPECT_TRUE(reader->Load({{"weight", {loaded_weight.data(), loaded_weight.size() * sizeof(float)}}}, &step));
+  EXPECT_EQ(step, 3);
+  EXPECT_EQ(loaded_weight, weight);
+  EXPECT_NO_THROW(reader->Finalize());
+}
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
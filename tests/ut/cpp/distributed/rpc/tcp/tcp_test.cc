@@ -17,9 +17,11 @@
 #include <sys/resource.h>
 #include <sys/types.h>
 #include <dirent.h>
+#include <algorithm>
 #include <atomic>
 #include <string>
 #include <thread>
+#include <vector>
 #include <csignal>
 
 #include <gtest/gtest.h>
@@ -27,6 +29,7 @@
 #include "distributed/rpc/tcp/tcp_server.h"
 #include "distributed/rpc/tcp/tcp_client.h"
 #include "distributed/rpc/tcp/constants.h"
+#include "utils/ms_utils.h"
 #include "common/common_test.h"
 
 namespace mindspore {
@@ -395,6 +398,177 @@ TEST_F(TCPTest, DeleteInvalidConnectionForTcpClient) {
     ASSERT_TRUE(disconnected);
   }
 }
+
+/// Feature: test the task queue of the event loop.
+/// Description: add tasks to one event loop from several threads concurrently.
+/// Expectation: all the tasks are run once and the tasks of each thread are run in the order of adding.
+TEST_F(TCPTest, EventLoopRunsTasksInOrder) {
+  EventLoop event_loop;
+  ASSERT_TRUE(event_loop.Initialize("UT_EVENT_LOOP"));
+
+  const size_t thread_num = 4;
+  const size_t task_num = 10000;
+  // Only the event loop thread touches the next sequences.
+  std::vector<size_t> next_seqs(thread_num, 0);
+  std::atomic<size_t> run_num{0};
+  std::atomic<bool> in_order{true};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&, i]() {
+      for (size_t seq = 0; seq < task_num; ++seq) {
+        (void)event_loop.AddTask([&, i, seq]() {
+          if (next_seqs[i]++ != seq) {
+            in_order = false;
+          }
+          ++run_num;
+          return RPC_OK;
+        });
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  size_t retry = 50;
+  while (run_num < thread_num * task_num && retry-- > 0) {
+    usleep(100000);
+  }
+  EXPECT_EQ(thread_num * task_num, run_num.load());
+  EXPECT_TRUE(in_order.load());
+  EXPECT_EQ(0, event_loop.RemainingTaskNum());
+  EXPECT_EQ(thread_num * task_num, event_loop.metrics()->task_count.load());
+  event_loop.Finalize();
+}
+
+/// Feature: test the tcp server with multiple event loops.
+/// Description: start a socket server with 4 pairs of event loops and send messages to it from 3 clients.
+/// Expectation: the server received all the messages and counted them in the metrics of its event loops.
+TEST_F(TCPTest, SendMessagesOverMultipleEventLoops) {
+  Init();
+  (void)common::SetEnv(kEnvRpcEventLoopNum, "4");
+
+  // Start the tcp server.
+  auto server_url = "127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+  ASSERT_EQ(4, server->tcp_comm_->recv_event_loops_.size());
+
+  server->SetMessageHandler([](MessageBase *const message) -> MessageBase *const {
+    IncrDataMsgNum(1);
+    return NULL_MSG;
+  });
+
+  // Start the tcp clients and send two messages from each one.
+  const size_t client_num = 3;
+  std::vector<std::unique_ptr<TCPClient>> clients;
+  for (size_t i = 0; i < client_num; ++i) {
+    auto client_url = "127.0.0.1:" + std::to_string(1234 + i);
+    auto client = std::make_unique<TCPClient>();
+    ret = client->Initialize();
+    ASSERT_TRUE(ret);
+    client->Connect(server_url);
+    client->SendAsync(CreateMessage(server_url, client_url));
+    client->SendAsync(CreateMessage(server_url, client_url));
+    clients.push_back(std::move(client));
+  }
+
+  // Wait timeout: 5s
+  WaitForDataMsg(client_num * 2, 5);
+
+  // Check result
+  EXPECT_EQ(client_num * 2, GetDataMsgNum());
+  size_t recv_msg_num = 0;
+  for (auto event_loop : server->tcp_comm_->recv_event_loops_) {
+    recv_msg_num += event_loop->metrics()->recv_msg_count;
+  }
+  EXPECT_EQ(client_num * 2, recv_msg_num);
+
+  // Destroy
+  for (auto &client : clients) {
+    client->Disconnect(server_url);
+    client->Finalize();
+  }
+  server->Finalize();
+  (void)unsetenv(kEnvRpcEventLoopNum);
+}
+
+/// Feature: test sending and receiving the message in memory segments without copying.
+/// Description: send a ScatterMessage whose body is in 2 segments to the server which receives it into 3 segments.
+/// Expectation: the body is received into the segments of the server in order, and the data of the message is freed.
+TEST_F(TCPTest, SendScatterMessage) {
+  Init();
+  const size_t body_size = 9000;
+  std::vector<std::vector<char>> recv_buffers = {std::vector<char>(1000), std::vector<char>(3000),
+                                                 std::vector<char>(5000)};
+  std::atomic<bool> recv_in_place(false);
+
+  // Start the tcp server.
+  auto server_url = "127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+  server->SetScatterCallback([&recv_buffers, body_size](size_t size, std::vector<MemSegment> *segments) {
+    if (size != body_size) {
+      return false;
+    }
+    for (auto &buffer : recv_buffers) {
+      segments->emplace_back(buffer.data(), buffer.size());
+    }
+    return true;
+  });
+  server->SetMessageHandler([&recv_in_place](MessageBase *const message) -> MessageBase *const {
+    recv_in_place = dynamic_cast<ScatterMessage *>(message) != nullptr;
+    IncrDataMsgNum(1);
+    return NULL_MSG;
+  });
+
+  // Start the tcp client.
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+  std::vector<char> send_buffer(body_size);
+  for (size_t i = 0; i < body_size; ++i) {
+    send_buffer[i] = static_cast<char>(i % 127);
+  }
+  std::atomic<size_t> free_num(0);
+  client->Connect(server_url, 60, [&free_num, &send_buffer](void *data) {
+    if (data == send_buffer.data()) {
+      ++free_num;
+    }
+    return true;
+  });
+
+  // Send the message.
+  auto message = std::make_unique<ScatterMessage>();
+  message->name = "testname";
+  message->from = AID("client", client_url);
+  message->to = AID("server", server_url);
+  message->segments = {{send_buffer.data(), 4000}, {send_buffer.data() + 4000, 5000}};
+  message->data = send_buffer.data();
+  message->size = body_size;
+  client->SendAsync(std::move(message));
+
+  // Wait timeout: 5s
+  WaitForDataMsg(1, 5);
+
+  // Check result
+  EXPECT_EQ(1, GetDataMsgNum());
+  EXPECT_TRUE(recv_in_place);
+  size_t offset = 0;
+  for (const auto &buffer : recv_buffers) {
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), send_buffer.begin() + offset));
+    offset += buffer.size();
+  }
+
+  // Destroy
+  client->Disconnect(server_url);
+  EXPECT_EQ(1, free_num);
+  client->Finalize();
+  server->Finalize();
+}
 }  // namespace rpc
 }  // namespace distributed
 }  // namespace mindspore
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/common/graph_kernel/model/graph_builder.h"
+#include "backend/common/graph_kernel/interpreter_kernel_filter.h"
+#include "plugin/device/cpu/kernel/interpreter/fused_graph_interpreter.h"
+
+namespace mindspore {
+namespace kernel {
+using graphkernel::inner::DAttrs;
+using graphkernel::inner::GraphBuilder;
+using graphkernel::inner::NodeBase;
+
+class FusedGraphInterpreterTest : public UT::Common {
+ public:
+  FusedGraphInterpreterTest() = default;
+
+  std::vector<float *> AllocWorkspaces(const FusedGraphInterpreter &interpreter) {
+    workspaces_.clear();
+    std::vector<float *> addrs;
+    for (auto size : interpreter.workspace_size_list()) {
+      (void)workspaces_.emplace_back(size / sizeof(float));
+    }
+    (void)std::transform(workspaces_.begin(), workspaces_.end(), std::back_inserter(addrs),
+                         [](std::vector<float> &workspace) { return workspace.data(); });
+    return addrs;
+  }
+
+ private:
+  std::vector<std::vector<float>> workspaces_;
+};
+
+/// Feature: Builtin cpu interpreter of graph kernel.
+/// Description: Run the fused softmax, which is divided into stages by the reduce ops.
+/// Expectation: The results are the same with the unfused computation.
+TEST_F(FusedGraphInterpreterTest, test_softmax) {
+  constexpr int64_t kRow = 5;
+  constexpr int64_t kCol = 3001;
+  GraphBuilder gb("softmax");
+  auto x = gb.Parameter(NodeBase({{kRow, kCol}, kNumberTypeFloat32, kOpFormat_DEFAULT}));
+  DAttrs reduce_attrs = {{"axis", MakeValue(std::vector<int64_t>{-1})}, {"keep_dims", MakeValue(true)}};
+  NodeBase full_info({{kRow, kCol}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  NodeBase reduced_info({{kRow, 1}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  auto max = gb.Op("ReduceMax", reduced_info, {x}, reduce_attrs);
+  auto sub = gb.Op("Sub", full_info, {x, max});
+  auto exp = gb.Op("Exp", full_info, {sub});
+  auto sum = gb.Op("ReduceSum", reduced_info, {exp}, reduce_attrs);
+  auto out = gb.Op("RealDiv", full_info, {exp, sum});
+  gb.SetOutputs({out, sum});
+  auto lite_graph = gb.Get();
+  ASSERT_TRUE(graphkernel::InterpreterSupported(lite_graph));
+
+  FusedGraphInterpreter interpreter;
+  interpreter.Compile(lite_graph);
+  // The stages end at ReduceMax and ReduceSum, and the max and exp are materialized.
+  ASSERT_EQ(interpreter.stage_num(), 3);
+  ASSERT_EQ(interpreter.workspace_size_list().size(), 2);
+
+  std::vector<float> input(kRow * kCol);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = std::sin(static_cast<float>(i) * 0.37f) * 3;
+  }
+  std::vector<float> output(kRow * kCol);
+  std::vector<float> output_sum(kRow);
+  interpreter.Run({input.data()}, AllocWorkspaces(interpreter), {output.data(), output_sum.data()});
+
+  for (int64_t r = 0; r < kRow; ++r) {
+    auto row = input.begin() + r * kCol;
+    auto row_max = *std::max_element(row, row + kCol);
+    float row_sum = 0;
+    for (int64_t c = 0; c < kCol; ++c) {
+      row_sum += std::exp(row[c] - row_max);
+    }
+    ASSERT_NEAR(output_sum[r], row_sum, row_sum * 1e-5);
+    for (int64_t c = 0; c < kCol; ++c) {
+      ASSERT_NEAR(output[r * kCol + c], std::exp(row[c] - row_max) / row_sum, 1e-6);
+    }
+  }
+}
+
+/// Feature: Builtin cpu interpreter of graph kernel.
+/// Description: Run the fused graph with broadcast, constant, reshape and reduce.
+/// Expectation: The results are the same with the unfused computation.
+TEST_F(FusedGraphInterpreterTest, test_broadcast_and_reshape) {
+  GraphBuilder gb("broadcast_reshape");
+  auto a = gb.Parameter(NodeBase({{4, 6, 5}, kNumberTypeFloat32, kOpFormat_DEFAULT}));
+  auto b = gb.Parameter(NodeBase({{5}, kNumberTypeFloat32, kOpFormat_DEFAULT}));
+  auto two = gb.Value(std::make_shared<tensor::Tensor>(2.0f, kFloat32));
+  auto add = gb.Op("Add", NodeBase({{4, 6, 5}, kNumberTypeFloat32, kOpFormat_DEFAULT}), {a, b});
+  auto mul = gb.Op("Mul", NodeBase({{4, 6, 5}, kNumberTypeFloat32, kOpFormat_DEFAULT}), {add, two});
+  auto reshape = gb.Op("Reshape", NodeBase({{24, 5}, kNumberTypeFloat32, kOpFormat_DEFAULT}), {mul});
+  auto broadcast = gb.Op("BroadcastTo", NodeBase({{24, 5}, kNumberTypeFloat32, kOpFormat_DEFAULT}), {b});
+  auto max = gb.Op("Maximum", NodeBase({{24, 5}, kNumberTypeFloat32, kOpFormat_DEFAULT}), {reshape, broadcast});
+  auto min = gb.Op("ReduceMin", NodeBase({{4, 5}, kNumberTypeFloat32, kOpFormat_DEFAULT}), {add},
+                   {{"axis", MakeValue(std::vector<int64_t>{1})}, {"keep_dims", MakeValue(false)}});
+  gb.SetOutputs({max, min, reshape});
+  auto lite_graph = gb.Get();
+  ASSERT_TRUE(graphkernel::InterpreterSupported(lite_graph));
+
+  FusedGraphInterpreter interpreter;
+  interpreter.Compile(lite_graph);
+  std::vector<float> input_a(120);
+  std::vector<float> input_b(5);
+  for (size_t i = 0; i < input_a.size(); ++i) {
+    input_a[i] = std::cos(static_cast<float>(i) * 1.3f);
+  }
+  for (size_t i = 0; i < input_b.size(); ++i) {
+    input_b[i] = static_cast<float>(i) * 0.5f - 1;
+  }
+  std::vector<float> output_max(120);
+  std::vector<float> output_min(20);
+  std::vector<float> output_reshape(120);
+  interpreter.Run({input_a.data(), input_b.data()}, AllocWorkspaces(interpreter),
+                  {output_max.data(), output_min.data(), output_reshape.data()});
+
+  std::vector<float> expect_min(20, INFINITY);
+  for (size_t i = 0; i < input_a.size(); ++i) {
+    auto sum = input_a[i] + input_b[i % 5];
+    ASSERT_FLOAT_EQ(output_reshape[i], sum * 2);
+    ASSERT_FLOAT_EQ(output_max[i], std::max(sum * 2, input_b[i % 5]));
+    auto &min_value = expect_min[(i / 30) * 5 + i % 5];
+    min_value = std::min(min_value, sum);
+  }
+  for (size_t i = 0; i < expect_min.size(); ++i) {
+    ASSERT_FLOAT_EQ(output_min[i], expect_min[i]);
+  }
+}
+
+/// Feature: Builtin cpu interpreter of graph kernel.
+/// Description: Run the fused Log, Sqrt, Rsqrt and Reciprocal with the inputs out of the domain.
+/// Expectation: The results are NaN or inf the same as the single op kernels, and the valid inputs are computed.
+TEST_F(FusedGraphInterpreterTest, test_input_out_of_domain) {
+  constexpr int64_t kSize = 37;
+  GraphBuilder gb("out_of_domain");
+  NodeBase info({{kSize}, kNumberTypeFloat32, kOpFormat_DEFAULT});
+  auto x = gb.Parameter(info);
+  gb.SetOutputs({gb.Op("Log", info, {x}), gb.Op("Sqrt", info, {x}), gb.Op("Rsqrt", info, {x}),
+                 gb.Op("Reciprocal", info, {x})});
+  auto lite_graph = gb.Get();
+  ASSERT_TRUE(graphkernel::InterpreterSupported(lite_graph));
+
+  FusedGraphInterpreter interpreter;
+  interpreter.Compile(lite_graph);
+  std::vector<float> input(kSize);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i) - 3;
+  }
+  std::vector<std::vector<float>> outputs(4, std::vector<float>(kSize));
+  interpreter.Run({input.data()}, AllocWorkspaces(interpreter),
+                  {outputs[0].data(), outputs[1].data(), outputs[2].data(), outputs[3].data()});
+
+  for (size_t i = 0; i < input.size(); ++i) {
+    if (input[i] < 0) {
+      ASSERT_TRUE(std::isnan(outputs[0][i]));
+      ASSERT_TRUE(std::isnan(outputs[1][i]));
+      ASSERT_TRUE(std::isnan(outputs[2][i]));
+      ASSERT_FLOAT_EQ(outputs[3][i], 1.0f / input[i]);
+    } else if (input[i] == 0) {
+      ASSERT_TRUE(std::isinf(outputs[0][i]));
+      ASSERT_FLOAT_EQ(outputs[1][i], 0);
+      ASSERT_TRUE(std::isinf(outputs[2][i]));
+      ASSERT_TRUE(std::isinf(outputs[3][i]));
+    } else {
+      ASSERT_FLOAT_EQ(outputs[0][i], std::log(input[i]));
+      ASSERT_FLOAT_EQ(outputs[1][i], std::sqrt(input[i]));
+      ASSERT_FLOAT_EQ(outputs[2][i], 1.0f / std::sqrt(input[i]));
+      ASSERT_FLOAT_EQ(outputs[3][i], 1.0f / input[i]);
+    }
+  }
+}
+
+/// Feature: Builtin cpu interpreter of graph kernel.
+/// Description: Check the fused graph with the op not supported by the interpreter.
+/// Expectation: The graph is not supported.
+TEST_F(FusedGraphInterpreterTest, test_unsupported_op) {
+  GraphBuilder gb("unsupported");
+  auto x = gb.Parameter(NodeBase({{16}, kNumberTypeFloat32, kOpFormat_DEFAULT}));
+  auto cast = gb.Op("Cast", NodeBase({{16}, kNumberTypeFloat16, kOpFormat_DEFAULT}), {x});
+  gb.SetOutputs({cast});
+  ASSERT_FALSE(graphkernel::InterpreterSupported(gb.Get()));
+}
+}  // namespace kernel
+}  // namespace mindspore
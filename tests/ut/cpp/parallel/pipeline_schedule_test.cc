@@ -0,0 +1,97 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/graph_util/pipeline_schedule.h"
+#include "utils/convert_utils_base.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace parallel {
+class TestPipelineSchedule : public UT::Common {
+ public:
+  TestPipelineSchedule() {}
+};
+
+/// Feature: Pipeline schedule.
+/// Description: Generate the 1F1B schedule of the first stage and the last stage of 4 stages with 6 micros.
+/// Expectation: The first stage warms up with 3 forward tasks, and the last stage runs forward and backward in turn.
+TEST_F(TestPipelineSchedule, test_1f1b_schedule) {
+  auto first_stage = GeneratePipelineSchedule(PipelineScheduleType::k1F1B, 4, 0, 6);
+  auto last_stage = GeneratePipelineSchedule(PipelineScheduleType::k1F1B, 4, 3, 6);
+  ASSERT_EQ(first_stage.size(), 12);
+  ASSERT_EQ(last_stage.size(), 12);
+  std::vector<PipelineTaskType> first_stage_types;
+  for (const auto &task : first_stage) {
+    first_stage_types.push_back(task.type);
+  }
+  auto kF = PipelineTaskType::kForward;
+  auto kB = PipelineTaskType::kBackward;
+  EXPECT_EQ(first_stage_types, std::vector<PipelineTaskType>({kF, kF, kF, kF, kB, kF, kB, kF, kB, kB, kB, kB}));
+  for (size_t i = 0; i < last_stage.size(); ++i) {
+    EXPECT_EQ(last_stage[i].type, i % 2 == 0 ? kF : kB);
+    EXPECT_EQ(last_stage[i].micro, SizeToLong(i / 2));
+  }
+}
+
+/// Feature: Pipeline schedule.
+/// Description: Generate the GPipe schedule of 4 stages with 3 micros, and the schedule with invalid arguments.
+/// Expectation: All the forward tasks run before the backward tasks, and the invalid arguments are rejected.
+TEST_F(TestPipelineSchedule, test_gpipe_schedule) {
+  auto schedule = GeneratePipelineSchedule(PipelineScheduleType::kGPipe, 4, 1, 3);
+  ASSERT_EQ(schedule.size(), 6);
+  for (size_t i = 0; i < schedule.size(); ++i) {
+    EXPECT_EQ(schedule[i].type, i < 3 ? PipelineTaskType::kForward : PipelineTaskType::kBackward);
+    EXPECT_EQ(schedule[i].micro, SizeToLong(i % 3));
+  }
+  EXPECT_ANY_THROW(GeneratePipelineSchedule(PipelineScheduleType::kGPipe, 4, 4, 3));
+  EXPECT_ANY_THROW(GeneratePipelineSchedule(PipelineScheduleType::k1F1B, 4, 0, 0));
+}
+
+/// Feature: Pipeline bubble estimation.
+/// Description: Estimate the bubble of the schedules of 4 stages with 8 micros, the backward costs twice the forward.
+/// Expectation: The bubble is (stage_num - 1) * 3 of each stage in both schedules, GPipe only differs from 1F1B in
+/// the activation memory.
+TEST_F(TestPipelineSchedule, test_estimate_pipeline_bubble) {
+  auto gpipe = EstimatePipelineBubble(PipelineScheduleType::kGPipe, 4, 8);
+  auto one_f_one_b = EstimatePipelineBubble(PipelineScheduleType::k1F1B, 4, 8);
+  EXPECT_DOUBLE_EQ(one_f_one_b.makespan, 33);
+  EXPECT_EQ(one_f_one_b.stage_idle_time, std::vector<double>({9, 9, 9, 9}));
+  EXPECT_DOUBLE_EQ(one_f_one_b.bubble_fraction, 9.0 / 33);
+  EXPECT_DOUBLE_EQ(gpipe.makespan, one_f_one_b.makespan);
+  EXPECT_EQ(gpipe.stage_idle_time, one_f_one_b.stage_idle_time);
+
+  // There is no bubble in a single stage.
+  EXPECT_DOUBLE_EQ(EstimatePipelineBubble(PipelineScheduleType::k1F1B, 1, 8).bubble_fraction, 0);
+}
+
+/// Feature: Pipeline schedule.
+/// Description: Select the pipeline schedule by the environment variable MS_PIPELINE_SCHEDULE.
+/// Expectation: The 1F1B and GPipe schedules are selected, and the unknown schedules are rejected.
+TEST_F(TestPipelineSchedule, test_get_pipeline_schedule_type) {
+  common::SetEnv(kPipelineScheduleEnv, "");
+  EXPECT_EQ(GetPipelineScheduleType(), PipelineScheduleType::k1F1B);
+  common::SetEnv(kPipelineScheduleEnv, "gpipe");
+  EXPECT_EQ(GetPipelineScheduleType(), PipelineScheduleType::kGPipe);
+  common::SetEnv(kPipelineScheduleEnv, "interleaved_1f1b");
+  EXPECT_ANY_THROW(GetPipelineScheduleType());
+  common::SetEnv(kPipelineScheduleEnv, "zero_bubble");
+  EXPECT_ANY_THROW(GetPipelineScheduleType());
+  common::SetEnv(kPipelineScheduleEnv, "");
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/graph_util/pipeline_split_utils.h"
+#include "frontend/operator/ops.h"
+#include "include/common/utils/utils.h"
+#include "ir/func_graph.h"
+#include "ir/graph_utils.h"
+#include "ir/manager.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+enum class StagePosition { kFirst, kMiddle, kLast };
+
+// The border nodes of the micros of a stage split by the pipeline parallel.
+struct StageGraph {
+  FuncGraphPtr graph;
+  PipelinePair forward_start_pair;
+  PipelinePair forward_end_pair;
+  PipelinePair backward_start_pair;
+  PipelinePair backward_end_pair;
+  PipelinePair forward_end_before_pair;
+};
+
+CNodePtr NewNode(const FuncGraphPtr &graph, const PrimitivePtr &prim, const AnfNodePtr &input, bool is_backward) {
+  auto node = graph->NewCNode({NewValueNode(prim), input});
+  if (is_backward) {
+    node->AddPrimalAttr(kPrimalAttrForwardNodeName, MakeValue("forward_op"));
+  }
+  return node;
+}
+
+// The stages except the first one receive the forward input, and the stages except the last one send the forward
+// output. The backward is the other way round.
+StageGraph MakeStageGraph(StagePosition position, size_t micro_num) {
+  StageGraph stage;
+  stage.graph = std::make_shared<FuncGraph>();
+  auto &graph = stage.graph;
+  auto input = graph->add_parameter();
+  std::vector<AnfNodePtr> outputs = {NewValueNode(prim::kPrimMakeTuple)};
+  for (size_t micro = 0; micro < micro_num; ++micro) {
+    auto forward_start = NewNode(graph, position == StagePosition::kFirst ? prim::kPrimReLU : prim::kPrimReceive,
+                                 input, false);
+    auto forward_compute = NewNode(graph, prim::kPrimReLU, forward_start, false);
+    AnfNodePtr forward_end = forward_compute;
+    if (position != StagePosition::kLast) {
+      forward_end = NewNode(graph, prim::kPrimSend, forward_compute, false);
+    }
+    auto backward_start = NewNode(graph, position == StagePosition::kLast ? prim::kPrimReLU : prim::kPrimReceive,
+                                  position == StagePosition::kLast ? forward_end : input, true);
+    auto backward_compute = NewNode(graph, prim::kPrimReLU, backward_start, true);
+    AnfNodePtr backward_end = backward_compute;
+    if (position != StagePosition::kFirst) {
+      backward_end = NewNode(graph, prim::kPrimSend, backward_compute, true);
+    }
+    stage.forward_start_pair.first.push_back(forward_start);
+    stage.forward_end_pair.first.push_back(forward_end);
+    stage.backward_start_pair.first.push_back(backward_start);
+    stage.backward_end_pair.first.push_back(backward_end);
+    // The same as Reorder, the node before the send is used to start the backward on the stages except the last one.
+    stage.forward_end_before_pair.first.push_back(forward_compute);
+    outputs.push_back(forward_end);
+    outputs.push_back(backward_end);
+  }
+  stage.forward_start_pair.second = stage.forward_start_pair.first;
+  stage.forward_end_pair.second = stage.forward_end_pair.first;
+  stage.backward_start_pair.second = stage.backward_start_pair.first;
+  stage.backward_end_pair.second = stage.backward_end_pair.first;
+  stage.forward_end_before_pair.second = stage.forward_end_before_pair.first;
+  graph->set_output(graph->NewCNode(outputs));
+  (void)Manage(graph, true);
+  return stage;
+}
+
+// Check the post node runs after the prior node, through the depend inserted before the first input of the post node.
+void ExpectRunAfter(const AnfNodePtr &post_node, const AnfNodePtr &prior_node, const std::vector<AnfNodePtr> &order) {
+  auto depend = post_node->cast<CNodePtr>()->input(1);
+  ASSERT_TRUE(IsPrimitiveCNode(depend, prim::kPrimDepend));
+  EXPECT_EQ(depend->cast<CNodePtr>()->input(2), prior_node);
+  EXPECT_LT(std::find(order.begin(), order.end(), prior_node), std::find(order.begin(), order.end(), post_node));
+}
+
+void CheckGPipeOrder(StagePosition position) {
+  constexpr size_t kMicroNum = 3;
+  auto stage = MakeStageGraph(position, kMicroNum);
+  ReorderForGPipe(stage.forward_start_pair, stage.forward_end_pair, stage.backward_start_pair,
+                  stage.backward_end_pair, stage.forward_end_before_pair, stage.graph);
+  auto order = TopoSort(stage.graph->get_return());
+  const auto &forward_start = stage.forward_start_pair.first;
+  const auto &forward_end = stage.forward_end_pair.first;
+  const auto &backward_start = stage.backward_start_pair.first;
+  const auto &backward_end = stage.backward_end_pair.first;
+  EXPECT_FALSE(IsPrimitiveCNode(forward_start[0]->cast<CNodePtr>()->input(1), prim::kPrimDepend));
+  for (size_t micro = 1; micro < kMicroNum; ++micro) {
+    ExpectRunAfter(forward_start[micro], forward_end[micro - 1], order);
+    ExpectRunAfter(backward_start[micro], backward_end[micro - 1], order);
+  }
+  // The backward of the first micro starts after the forward of all the micros.
+  const auto &forward_end_before = stage.forward_end_before_pair.second;
+  ExpectRunAfter(backward_start[0], forward_end_before.back(), order);
+  for (const auto &node : forward_end_before) {
+    EXPECT_LT(std::find(order.begin(), order.end(), node), std::find(order.begin(), order.end(), backward_start[0]));
+  }
+}
+}  // namespace
+
+class TestPipelineSplitUtils : public UT::Common {
+ public:
+  TestPipelineSplitUtils() {}
+};
+
+/// Feature: Pipeline GPipe schedule.
+/// Description: Reorder the first stage split by the pipeline parallel with the GPipe schedule.
+/// Expectation: The forward of the micros run in turn, and then the backward of the micros run in turn.
+TEST_F(TestPipelineSplitUtils, test_reorder_for_gpipe_first_stage) { CheckGPipeOrder(StagePosition::kFirst); }
+
+/// Feature: Pipeline GPipe schedule.
+/// Description: Reorder the middle stage split by the pipeline parallel with the GPipe schedule.
+/// Expectation: The forward of the micros run in turn, and then the backward of the micros run in turn.
+TEST_F(TestPipelineSplitUtils, test_reorder_for_gpipe_middle_stage) { CheckGPipeOrder(StagePosition::kMiddle); }
+
+/// Feature: Pipeline GPipe schedule.
+/// Description: Reorder the last stage split by the pipeline parallel with the GPipe schedule.
+/// Expectation: The forward of the micros run in turn, and then the backward of the micros run in turn.
+TEST_F(TestPipelineSplitUtils, test_reorder_for_gpipe_last_stage) { CheckGPipeOrder(StagePosition::kLast); }
+}  // namespace parallel
+}  // namespace mindspore
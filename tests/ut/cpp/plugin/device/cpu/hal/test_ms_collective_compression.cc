@@ -0,0 +1,115 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "plugin/device/cpu/hal/hardware/ms_collective_compression.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestMSCollectiveCompression : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() { (void)unsetenv(kEnvCollectiveCompression); }
+};
+
+/// Feature: test the compression of the cpu collective communication.
+/// Description: parse the compression of the parameter and the environment variable.
+/// Expectation: the valid ones are parsed, and the compression of a group is rejected.
+TEST_F(TestMSCollectiveCompression, ParseConfig) {
+  CompressionConfig config;
+  ASSERT_TRUE(ParseCompressionConfig("bf16", &config));
+  ASSERT_EQ(config.type, CompressionType::kBf16);
+  ASSERT_TRUE(ParseCompressionConfig("topk=0.01", &config));
+  ASSERT_EQ(config.type, CompressionType::kTopK);
+  ASSERT_FLOAT_EQ(config.ratio, 0.01f);
+  ASSERT_TRUE(ParseCompressionConfig("threshold=1e-3", &config));
+  ASSERT_EQ(config.type, CompressionType::kThreshold);
+  ASSERT_FALSE(ParseCompressionConfig("topk=2", &config));
+  ASSERT_FALSE(ParseCompressionConfig("fp16=1", &config));
+  ASSERT_FALSE(ParseCompressionConfig("int8", &config));
+
+  (void)setenv(kEnvCollectiveCompression, "topk=0.1", 1);
+  ASSERT_EQ(GlobalCompressionConfig().type, CompressionType::kTopK);
+  (void)setenv(kEnvCollectiveCompression, "mccl_world_group:fp16", 1);
+  ASSERT_ANY_THROW(GlobalCompressionConfig());
+  (void)unsetenv(kEnvCollectiveCompression);
+  ASSERT_EQ(GlobalCompressionConfig().type, CompressionType::kNone);
+}
+
+/// Feature: test the compression of the cpu collective communication.
+/// Description: encode the float32 data in fp16 and bf16, decode and accumulate it.
+/// Expectation: the error is within the precision of the half type.
+TEST_F(TestMSCollectiveCompression, HalfCodec) {
+  const size_t count = 1000;
+  std::vector<float> input(count);
+  for (size_t i = 0; i < count; ++i) {
+    input[i] = std::sin(static_cast<float>(i)) * 100.0f;
+  }
+  std::vector<uint16_t> wire(count);
+  for (auto type : {CompressionType::kFp16, CompressionType::kBf16}) {
+    const float relative_error = type == CompressionType::kFp16 ? 1e-3f : 1e-2f;
+    EncodeHalf(type, input.data(), count, wire.data());
+    std::vector<float> output(count, 1.0f);
+    DecodeHalf(type, wire.data(), count, output.data(), true);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_NEAR(output[i], input[i] + 1.0f, std::fabs(input[i]) * relative_error + 1e-6f);
+    }
+  }
+}
+
+/// Feature: test the compression of the cpu collective communication.
+/// Description: sparsify the gradients of several steps by topk with error feedback.
+/// Expectation: the largest elements are selected and nothing is lost, the passed values and the residual sum up to
+/// the gradients.
+TEST_F(TestMSCollectiveCompression, TopKErrorFeedback) {
+  const size_t count = 100;
+  const size_t step_num = 5;
+  CompressionConfig config;
+  ASSERT_TRUE(ParseCompressionConfig("topk=0.1", &config));
+  ErrorFeedbackSparsifier sparsifier;
+  std::vector<float> gradient_sum(count, 0.0f);
+  std::vector<float> passed_sum(count, 0.0f);
+  for (size_t step = 0; step < step_num; ++step) {
+    std::vector<float> gradients(count);
+    for (size_t i = 0; i < count; ++i) {
+      gradients[i] = static_cast<float>((i * 7 + step * 13) % 17) - 8.0f;
+      gradient_sum[i] += gradients[i];
+    }
+    std::vector<uint32_t> indices;
+    std::vector<float> values;
+    sparsifier.Sparsify(gradients.data(), count, config, &indices, &values);
+    ASSERT_EQ(indices.size(), count / 10);
+    float min_passed = INFINITY;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      passed_sum[indices[i]] += values[i];
+      min_passed = std::min(min_passed, std::fabs(values[i]));
+    }
+    for (auto residual : sparsifier.residual()) {
+      ASSERT_LE(std::fabs(residual), min_passed);
+    }
+  }
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_FLOAT_EQ(passed_sum[i] + sparsifier.residual()[i], gradient_sum[i]);
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
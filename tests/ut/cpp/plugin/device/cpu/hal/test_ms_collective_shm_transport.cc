@@ -0,0 +1,185 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include "plugin/device/cpu/hal/hardware/ms_collective_shm_transport.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestMSCollectiveShmTransport : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  // Run the function on every rank in a thread, the threads share memory just like the processes on one host.
+  void RunRanks(uint32_t rank_size, size_t ring_size,
+                const std::function<bool(uint32_t, ShmCollectiveOpsImpl *)> &rank_func) {
+    std::string name = "/ms_shm_ut_" + std::to_string(getpid());
+    std::atomic<uint32_t> success_num{0};
+    std::vector<std::thread> threads;
+    for (uint32_t rank = 0; rank < rank_size; ++rank) {
+      threads.emplace_back([&, rank]() {
+        auto transport = std::make_shared<ShmTransport>(name, rank, rank_size, ring_size);
+        if (!transport->Initialize()) {
+          return;
+        }
+        ShmCollectiveOpsImpl ops(transport);
+        if (rank_func(rank, &ops)) {
+          ++success_num;
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(rank_size, success_num.load());
+  }
+};
+
+/// Feature: test the collective communication over shared memory.
+/// Description: AllReduce and ReduceScatter the data much larger than the ring buffer on 4 ranks.
+/// Expectation: the data is reduced correctly.
+TEST_F(TestMSCollectiveShmTransport, AllReduceAndReduceScatter) {
+  const uint32_t rank_size = 4;
+  const size_t count = 100003;
+  const size_t ring_size = 4096;
+  const std::vector<uint32_t> group_ranks = {0, 1, 2, 3};
+  RunRanks(rank_size, ring_size, [&](uint32_t rank, ShmCollectiveOpsImpl *ops) {
+    std::vector<float> input(count);
+    std::vector<float> output(count);
+    for (size_t i = 0; i < count; ++i) {
+      input[i] = static_cast<float>(rank + i % 7);
+    }
+    if (!ops->AllReduce<float>(input.data(), output.data(), count, group_ranks)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (output[i] != static_cast<float>(6 + 4 * (i % 7))) {
+        return false;
+      }
+    }
+
+    const size_t recv_count = count / rank_size;
+    std::vector<float> scattered(recv_count);
+    if (!ops->ReduceScatter<float>(input.data(), scattered.data(), recv_count, group_ranks)) {
+      return false;
+    }
+    for (size_t i = 0; i < recv_count; ++i) {
+      if (scattered[i] != static_cast<float>(6 + 4 * ((rank * recv_count + i) % 7))) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+/// Feature: test the collective communication over shared memory.
+/// Description: ReduceScatter and AllGather in place on 3 ranks, which are the halves of the hierarchical AllReduce.
+/// Expectation: the rank r reduces the chunk r after ReduceScatter, and all the ranks get the sum after AllGather.
+TEST_F(TestMSCollectiveShmTransport, InPlaceHalvesOfAllReduce) {
+  const uint32_t rank_size = 3;
+  const size_t count = 10001;
+  const size_t ring_size = 1024;
+  const std::vector<uint32_t> group_ranks = {0, 1, 2};
+  RunRanks(rank_size, ring_size, [&](uint32_t rank, ShmCollectiveOpsImpl *ops) {
+    std::vector<float> data(count);
+    for (size_t i = 0; i < count; ++i) {
+      data[i] = static_cast<float>(rank + i % 5);
+    }
+    if (!ops->ReduceScatterInPlace<float>(data.data(), count, group_ranks)) {
+      return false;
+    }
+    std::vector<size_t> chunk_offsets;
+    std::vector<size_t> chunk_sizes;
+    SplitChunks(count, rank_size, &chunk_offsets, &chunk_sizes);
+    for (size_t i = chunk_offsets[rank]; i < chunk_offsets[rank] + chunk_sizes[rank]; ++i) {
+      if (data[i] != static_cast<float>(3 + 3 * (i % 5))) {
+        return false;
+      }
+    }
+    if (!ops->AllGatherInPlace<float>(data.data(), count, group_ranks)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (data[i] != static_cast<float>(3 + 3 * (i % 5))) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+/// Feature: test the collective communication over shared memory.
+/// Description: AllGather in the world group and Broadcast in a sub group whose ranks are out of order.
+/// Expectation: every rank gets the same data.
+TEST_F(TestMSCollectiveShmTransport, AllGatherAndBroadcast) {
+  const uint32_t rank_size = 4;
+  const size_t ring_size = 4096;
+  RunRanks(rank_size, ring_size, [&](uint32_t rank, ShmCollectiveOpsImpl *ops) {
+    const size_t send_count = 13;
+    std::vector<char> input(send_count, static_cast<char>('a' + rank));
+    std::vector<char> output(send_count * rank_size);
+    if (!ops->AllGather<char>(input.data(), output.data(), send_count, {0, 1, 2, 3})) {
+      return false;
+    }
+    for (size_t i = 0; i < output.size(); ++i) {
+      if (output[i] != static_cast<char>('a' + i / send_count)) {
+        return false;
+      }
+    }
+
+    // The rank 0 is not in the group, the root is the group rank 2 which is the global rank 2.
+    if (rank == 0) {
+      return true;
+    }
+    const size_t count = 30001;
+    const int value = 42;
+    std::vector<int> data(count, rank == 2 ? value : 0);
+    std::vector<int> result(count, 0);
+    if (!ops->Broadcast<int>(data.data(), result.data(), count, 2, {3, 1, 2})) {
+      return false;
+    }
+    return std::all_of(result.begin(), result.end(), [value](int v) { return v == value; });
+  });
+}
+
+/// Feature: test the collective communication over shared memory.
+/// Description: initialize the transport whose segment is larger than the free space of /dev/shm.
+/// Expectation: the initialization fails at once and the segment is removed, so the caller falls back to tcp.
+TEST_F(TestMSCollectiveShmTransport, SegmentLargerThanShm) {
+  struct statvfs shm_stat = {};
+  ASSERT_EQ(statvfs("/dev/shm", &shm_stat), 0);
+  const size_t kAlignment = 8;
+  size_t ring_size = (static_cast<size_t>(shm_stat.f_bavail) * shm_stat.f_frsize / kAlignment + 1) * kAlignment;
+  std::string name = "/ms_shm_ut_nospc_" + std::to_string(getpid());
+  ShmTransport transport(name, 0, 1, ring_size);
+  ASSERT_FALSE(transport.Initialize(1));
+  auto fd = shm_open((name + "_0").c_str(), O_RDONLY, 0);
+  ASSERT_LT(fd, 0);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "ir/primitive.h"
+#include "abstract/abstract_value.h"
+#include "backend/common/optimizer/dynamic_shape/infer_resize_cache.h"
+
+namespace mindspore {
+namespace opt::dynamic_shape {
+class TestInferResizeCache : public UT::Common {
+ public:
+  TestInferResizeCache() = default;
+
+  // The infer of one launch, the cache is used only when the node isn't fed by PyExecute.
+  void Infer(const InferResizeCachePtr &cache, const CNodePtr &cnode, const ShapeVector &shape, bool is_py_execute) {
+    auto abs = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+    if (is_py_execute) {
+      cache->ClearCurrentKey();
+      cnode->set_abstract(abs);
+      return;
+    }
+    auto key = InferResizeCache::GenerateKey({abs}, std::map<uint32_t, tensor::TensorPtr>());
+    if (!cache->FetchInferResult(key, cnode)) {
+      cnode->set_abstract(abs);
+      cache->SaveInferResult(key, cnode);
+    }
+  }
+
+  // The resize of one launch, return whether the kernel mod is resized.
+  bool Resize(const InferResizeCachePtr &cache) {
+    if (cache->IsResized()) {
+      return false;
+    }
+    cache->SetResized();
+    return true;
+  }
+};
+
+/// Feature: Memoize the infer shape and resize of dynamic shape kernels.
+/// Description: Launch the kernel with the same shape, a changed shape, and the changed shapes fed by PyExecute.
+/// Expectation: The resize is skipped only when the latest memoized infer has the same key as the latest resize.
+TEST_F(TestInferResizeCache, test_resize_after_shape_changed) {
+  auto func_graph = std::make_shared<FuncGraph>();
+  auto cnode = func_graph->NewCNode({NewValueNode(std::make_shared<Primitive>("Abs")), func_graph->add_parameter()});
+  auto cache = std::make_shared<InferResizeCache>(2);
+
+  Infer(cache, cnode, {2, 3}, false);
+  EXPECT_TRUE(Resize(cache));
+  Infer(cache, cnode, {2, 3}, false);
+  EXPECT_FALSE(Resize(cache));
+  Infer(cache, cnode, {4, 3}, false);
+  EXPECT_TRUE(Resize(cache));
+
+  // The PyExecute-fed node changes the shape in two launches, the kernel mod is resized in both launches.
+  Infer(cache, cnode, {5, 3}, true);
+  EXPECT_TRUE(Resize(cache));
+  Infer(cache, cnode, {6, 3}, true);
+  EXPECT_TRUE(Resize(cache));
+  // The latest resize is for the PyExecute shape, so the memoized shape needs resize again.
+  Infer(cache, cnode, {4, 3}, false);
+  EXPECT_TRUE(Resize(cache));
+  EXPECT_EQ(cnode->abstract()->BuildShape()->ToString(), "(4, 3)");
+}
+}  // namespace opt::dynamic_shape
+}  // namespace mindspore
@@ -0,0 +1,273 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/pynative/async/async_queue.h"
+#include "utils/ms_exception.h"
+
+namespace mindspore {
+namespace pynative {
+class TestAsyncQueue : public UT::Common {
+ public:
+  TestAsyncQueue() = default;
+};
+
+namespace {
+class CountTask : public AsyncTask {
+ public:
+  CountTask(std::atomic<size_t> *counter, size_t expect) : AsyncTask(kOpRunTask), counter_(counter), expect_(expect) {}
+  ~CountTask() override = default;
+  // The tasks are run in the push order, so the counter is equal to the push index when the task is run.
+  void Run() override {
+    if (counter_->load() != expect_) {
+      disordered_ = true;
+    }
+    (void)counter_->fetch_add(1);
+  }
+  void SetException(const std::exception_ptr &) override { has_exception_ = true; }
+
+  bool disordered_{false};
+  bool has_exception_{false};
+
+ private:
+  std::atomic<size_t> *counter_;
+  size_t expect_;
+};
+
+class ThrowTask : public AsyncTask {
+ public:
+  ThrowTask() : AsyncTask(kOpRunTask) {}
+  ~ThrowTask() override = default;
+  void Run() override { throw std::runtime_error("Run task failed."); }
+};
+
+class EmptyTask : public AsyncTask {
+ public:
+  EmptyTask() : AsyncTask(kOpRunTask) {}
+  ~EmptyTask() override = default;
+  void Run() override {}
+};
+
+// Block the worker until the future is ready, so the tasks pushed after it are queued before running.
+class BlockTask : public AsyncTask {
+ public:
+  explicit BlockTask(const std::shared_future<void> &release) : AsyncTask(kOpRunTask), release_(release) {}
+  ~BlockTask() override = default;
+  void Run() override { release_.wait(); }
+
+ private:
+  std::shared_future<void> release_;
+};
+
+// Push tasks to the queue which runs this task.
+class SelfPushTask : public AsyncTask {
+ public:
+  SelfPushTask(AsyncQueue *queue, size_t push_num) : AsyncTask(kOpRunTask), queue_(queue), push_num_(push_num) {}
+  ~SelfPushTask() override = default;
+  void Run() override {
+    for (size_t i = 0; i < push_num_; ++i) {
+      queue_->Push(std::make_shared<EmptyTask>());
+    }
+  }
+
+ private:
+  AsyncQueue *queue_;
+  size_t push_num_;
+};
+}  // namespace
+
+/// Feature: Async queue of PyNative.
+/// Description: Push more tasks than the ring slots and wait for them.
+/// Expectation: All the tasks are run once in the push order.
+TEST_F(TestAsyncQueue, test_push_and_wait) {
+  AsyncQueue queue;
+  std::atomic<size_t> counter{0};
+  constexpr size_t kTaskNum = 20000;
+  std::vector<std::shared_ptr<CountTask>> tasks;
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    auto task = std::make_shared<CountTask>(&counter, i);
+    tasks.push_back(task);
+    queue.Push(task);
+  }
+  queue.Wait();
+  ASSERT_TRUE(queue.Empty());
+  ASSERT_EQ(counter.load(), kTaskNum);
+  for (const auto &task : tasks) {
+    ASSERT_FALSE(task->disordered_);
+  }
+  queue.WorkerJoin();
+}
+
+/// Feature: Async queue of PyNative.
+/// Description: Push tasks from several threads at the same time.
+/// Expectation: All the tasks are run once.
+TEST_F(TestAsyncQueue, test_multi_producer) {
+  AsyncQueue queue;
+  // Create the worker before the producers start.
+  queue.Push(std::make_shared<EmptyTask>());
+  queue.Wait();
+
+  std::atomic<size_t> run_num{0};
+  class AddTask : public AsyncTask {
+   public:
+    explicit AddTask(std::atomic<size_t> *num) : AsyncTask(kOpRunTask), num_(num) {}
+    ~AddTask() override = default;
+    void Run() override { (void)num_->fetch_add(1); }
+
+   private:
+    std::atomic<size_t> *num_;
+  };
+
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kTaskNumPerThread = 10000;
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    (void)producers.emplace_back([&queue, &run_num]() {
+      for (size_t j = 0; j < kTaskNumPerThread; ++j) {
+        queue.Push(std::make_shared<AddTask>(&run_num));
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  queue.Wait();
+  ASSERT_EQ(run_num.load(), kThreadNum * kTaskNumPerThread);
+  queue.WorkerJoin();
+}
+
+/// Feature: Async queue of PyNative.
+/// Description: One task throws exception and the tasks after it are not run.
+/// Expectation: Wait throws the exception and the tasks after the failed task get the exception.
+TEST_F(TestAsyncQueue, test_task_exception) {
+  AsyncQueue queue;
+  std::atomic<size_t> counter{0};
+  std::promise<void> release;
+  queue.Push(std::make_shared<BlockTask>(release.get_future().share()));
+  queue.Push(std::make_shared<ThrowTask>());
+  std::vector<std::shared_ptr<CountTask>> tasks;
+  for (size_t i = 0; i < 100; ++i) {
+    auto task = std::make_shared<CountTask>(&counter, i);
+    tasks.push_back(task);
+    queue.Push(task);
+  }
+  release.set_value();
+  ASSERT_ANY_THROW(queue.Wait());
+  ASSERT_TRUE(queue.Empty());
+  ASSERT_EQ(counter.load(), 0);
+  for (const auto &task : tasks) {
+    ASSERT_TRUE(task->has_exception_);
+  }
+  queue.WorkerJoin();
+}
+
+/// Feature: Async queue of PyNative.
+/// Description: Reset the queue while the worker is running a task, then release the worker.
+/// Expectation: Reset returns without waiting, and the tasks not yet running are dropped with exception.
+TEST_F(TestAsyncQueue, test_reset) {
+  AsyncQueue queue;
+  std::atomic<size_t> counter{0};
+  std::promise<void> release;
+  queue.Push(std::make_shared<BlockTask>(release.get_future().share()));
+  std::vector<std::shared_ptr<CountTask>> tasks;
+  for (size_t i = 0; i < 100; ++i) {
+    auto task = std::make_shared<CountTask>(&counter, i);
+    tasks.push_back(task);
+    queue.Push(task);
+  }
+  queue.Reset();
+  ASSERT_FALSE(queue.Empty());
+  release.set_value();
+  queue.Wait();
+  ASSERT_TRUE(queue.Empty());
+  ASSERT_EQ(counter.load(), 0);
+  for (const auto &task : tasks) {
+    ASSERT_TRUE(task->has_exception_);
+  }
+
+  // The tasks pushed after Reset are run.
+  auto task = std::make_shared<CountTask>(&counter, 0);
+  queue.Push(task);
+  queue.Wait();
+  ASSERT_EQ(counter.load(), 1);
+  ASSERT_FALSE(task->has_exception_);
+  queue.WorkerJoin();
+}
+
+/// Feature: Async queue of PyNative.
+/// Description: The worker thread pushes more tasks than the ring slots to its own queue.
+/// Expectation: The push to the full ring throws instead of deadlock, and Wait returns with the exception.
+TEST_F(TestAsyncQueue, test_push_full_from_worker) {
+  AsyncQueue queue;
+  queue.Push(std::make_shared<SelfPushTask>(&queue, AsyncQueue::kTaskSlotNum + 1));
+  ASSERT_ANY_THROW(queue.Wait());
+  ASSERT_TRUE(queue.Empty());
+  queue.WorkerJoin();
+}
+
+/// Feature: Async queue of PyNative.
+/// Description: Emplace the tasks which fit in the slot and the tasks which are larger than the slot storage.
+/// Expectation: All the tasks are run in the emplace order, and each task is destroyed once after running.
+TEST_F(TestAsyncQueue, test_emplace) {
+  class RecordTask : public AsyncTask {
+   public:
+    RecordTask(std::vector<size_t> *records, std::atomic<size_t> *destroy_num, size_t index)
+        : AsyncTask(kOpRunTask), records_(records), destroy_num_(destroy_num), index_(index) {}
+    ~RecordTask() override { (void)destroy_num_->fetch_add(1); }
+    void Run() override { records_->push_back(index_); }
+
+   private:
+    std::vector<size_t> *records_;
+    std::atomic<size_t> *destroy_num_;
+    size_t index_;
+  };
+  class LargeRecordTask : public RecordTask {
+   public:
+    using RecordTask::RecordTask;
+    ~LargeRecordTask() override = default;
+
+   private:
+    char padding_[AsyncQueue::kTaskStorageSize]{};
+  };
+  static_assert(sizeof(RecordTask) <= AsyncQueue::kTaskStorageSize, "The task should fit in the slot.");
+
+  AsyncQueue queue;
+  std::vector<size_t> records;
+  std::atomic<size_t> destroy_num{0};
+  constexpr size_t kTaskNum = AsyncQueue::kTaskSlotNum + 100;
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    if (i % 2 == 0) {
+      queue.Emplace<RecordTask>(&records, &destroy_num, i);
+    } else {
+      queue.Emplace<LargeRecordTask>(&records, &destroy_num, i);
+    }
+  }
+  queue.Wait();
+  ASSERT_TRUE(queue.Empty());
+  ASSERT_EQ(records.size(), kTaskNum);
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    ASSERT_EQ(records[i], i);
+  }
+  ASSERT_EQ(destroy_num.load(), kTaskNum);
+  queue.WorkerJoin();
+}
+}  // namespace pynative
+}  // namespace mindspore
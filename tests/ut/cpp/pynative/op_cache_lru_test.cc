@@ -0,0 +1,79 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <list>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/pynative/op_compiler.h"
+
+namespace mindspore {
+namespace pynative {
+class TestOpCacheLru : public UT::Common {
+ public:
+  TestOpCacheLru() = default;
+};
+
+/// Feature: Bounded op cache of PyNative.
+/// Description: Insert 3 graphs, hit the oldest one, and insert a graph which exceeds the memory budget.
+/// Expectation: The hit graph becomes the most recently used, and the least recently used graph is evicted.
+TEST_F(TestOpCacheLru, test_lru_order_and_budget) {
+  OpCacheLru cache(300);
+  cache.Insert("a", 100);
+  cache.Insert("b", 100);
+  cache.Miss();
+  cache.Insert("c", 100);
+  cache.Miss();
+  EXPECT_EQ(cache.lru(), std::list<GraphInfo>({"c", "b", "a"}));
+  EXPECT_TRUE(cache.Evict(nullptr).empty());
+
+  cache.Hit("a");
+  EXPECT_EQ(cache.lru(), std::list<GraphInfo>({"a", "c", "b"}));
+  cache.Insert("d", 150);
+  EXPECT_EQ(cache.Evict(nullptr), std::vector<GraphInfo>({"b", "c"}));
+  EXPECT_EQ(cache.lru(), std::list<GraphInfo>({"d", "a"}));
+  EXPECT_EQ(cache.bytes(), 250);
+  EXPECT_EQ(cache.hit_count(), 1);
+  EXPECT_EQ(cache.miss_count(), 2);
+  EXPECT_EQ(cache.evict_count(), 2);
+
+  cache.Erase("a");
+  EXPECT_EQ(cache.bytes(), 150);
+  cache.Clear();
+  EXPECT_TRUE(cache.lru().empty());
+  EXPECT_EQ(cache.bytes(), 0);
+}
+
+/// Feature: Bounded op cache of PyNative.
+/// Description: Insert a graph larger than the memory budget while the older graphs can't be evicted.
+/// Expectation: The just inserted graph is kept even if the budget is exceeded, and the older graphs are kept.
+TEST_F(TestOpCacheLru, test_keep_most_recently_used) {
+  OpCacheLru cache(100);
+  cache.Insert("a", 50);
+  cache.Insert("b", 50);
+  cache.Insert("c", 200);
+  EXPECT_TRUE(cache.Evict([](const GraphInfo &) { return false; }).empty());
+  EXPECT_EQ(cache.lru(), std::list<GraphInfo>({"c", "b", "a"}));
+
+  EXPECT_EQ(cache.Evict([](const GraphInfo &graph_info) { return graph_info != "a"; }),
+            std::vector<GraphInfo>({"b"}));
+  EXPECT_EQ(cache.Evict(nullptr), std::vector<GraphInfo>({"a"}));
+  EXPECT_EQ(cache.lru(), std::list<GraphInfo>({"c"}));
+  EXPECT_EQ(cache.bytes(), 200);
+  EXPECT_EQ(cache.evict_count(), 2);
+}
+}  // namespace pynative
+}  // namespace mindspore
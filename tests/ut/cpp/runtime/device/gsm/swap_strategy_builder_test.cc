@@ -135,4 +135,54 @@ TEST_F(TestSwapStrategyBuilder, test_swap_strategy_with_all_reduce_nodes) {
   }
   EXPECT_EQ(all_actions.size(), 12);
 }
+
+/// Feature: SwapStrategyBuilder
+/// Description: Test SwapStrategyBuilder with swap in prefetch
+/// Expectation: The tensor actions are the same as without prefetch, and the prefetched swap in only blocks the
+/// consumer kernel
+TEST_F(TestSwapStrategyBuilder, test_swap_strategy_with_prefetch) {
+  auto builder = std::make_shared<SwapStrategyBuilder>();
+  auto context = std::make_shared<SwapContext>();
+  auto kernel_graph = kernel_graph_add_with_all_reduce_net_;
+  EXPECT_NE(kernel_graph, nullptr);
+
+  context->ddr_mem_size_ = 100;
+  context->hbm_mem_size_ = 250;
+  auto get_action_num = [](const std::shared_ptr<SwapStrategy> &strategy) {
+    size_t action_num = 0;
+    for (auto const &item : strategy->actions_) {
+      action_num += item.second->actions_.size();
+    }
+    return action_num;
+  };
+  auto strategy = builder->Build(kernel_graph, context);
+  EXPECT_NE(strategy, nullptr);
+  auto action_num = get_action_num(strategy);
+
+  context->enable_prefetch_ = true;
+  context->default_kernel_time_ = 1.0f;
+  context->ddr_bandwidth_ = 1.0f;
+  context->disk_bandwidth_ = 1.0f;
+  auto prefetch_strategy = builder->Build(kernel_graph, context);
+  EXPECT_NE(prefetch_strategy, nullptr);
+  EXPECT_EQ(prefetch_strategy->kernel_num_, 9);
+  EXPECT_EQ(get_action_num(prefetch_strategy), action_num);
+  for (auto const &item : prefetch_strategy->actions_) {
+    if (item.second->overlap_time_ <= 0) {
+      continue;
+    }
+    size_t issue_index = SIZE_MAX;
+    size_t consumer_index = SIZE_MAX;
+    for (const auto &link : prefetch_strategy->links_) {
+      if (link->to_ == item.first) {
+        issue_index = link->from_;
+      }
+      if (link->from_ == item.first) {
+        consumer_index = link->to_;
+      }
+    }
+    EXPECT_LT(issue_index + 1, consumer_index);
+    EXPECT_LE(consumer_index, prefetch_strategy->kernel_num_);
+  }
+}
 }  // namespace mindspore::device
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <future>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/graph_scheduler/actor/communication_launcher.h"
+
+namespace mindspore {
+namespace runtime {
+class CommunicationLauncherTest : public UT::Common {
+ public:
+  CommunicationLauncherTest() {}
+};
+
+/// Feature: Overlap the communication with the computation.
+/// Description: Push 2 communication tasks to the communication thread.
+/// Expectation: The tasks run in the pushing order.
+TEST_F(CommunicationLauncherTest, LaunchInPushingOrder) {
+  auto &launcher = CommunicationLauncher::GetInstance();
+  std::vector<int> launch_order;
+  std::promise<void> finished;
+  launcher.Push([&launch_order]() { launch_order.push_back(1); });
+  launcher.Push([&launch_order, &finished]() {
+    launch_order.push_back(2);
+    finished.set_value();
+  });
+  finished.get_future().wait();
+  launcher.Finalize();
+  EXPECT_EQ(launch_order, std::vector<int>({1, 2}));
+}
+
+/// Feature: Overlap the communication with the computation.
+/// Description: Record 2 communication intervals of 20ms in a step of 60ms. The computation kernels run in
+/// [0ms, 10ms], [25ms, 30ms] and [28ms, 35ms] in several threads, and the optimizer runs in [45ms, 55ms] after the
+/// communication.
+/// Expectation: Only the communication time intersecting the computation is overlapped, and the computation after the
+/// communication doesn't hide it.
+TEST_F(CommunicationLauncherTest, StepTimeBreakdown) {
+  const double kBeginTime = 100;
+  auto &launcher = CommunicationLauncher::GetInstance();
+  launcher.StepBegin(kBeginTime);
+  launcher.RecordCommunication(kBeginTime, kBeginTime + 0.02);
+  launcher.RecordCommunication(kBeginTime + 0.02, kBeginTime + 0.04);
+  launcher.RecordComputation(kBeginTime + 0.028, kBeginTime + 0.035);
+  launcher.RecordComputation(kBeginTime, kBeginTime + 0.01);
+  launcher.RecordComputation(kBeginTime + 0.025, kBeginTime + 0.03);
+  launcher.RecordComputation(kBeginTime + 0.045, kBeginTime + 0.055);
+
+  auto breakdown = launcher.StepEnd(kBeginTime + 0.06);
+  EXPECT_NEAR(breakdown.step_time_, 60, 1e-6);
+  EXPECT_NEAR(breakdown.communication_time_, 40, 1e-6);
+  EXPECT_NEAR(breakdown.overlapped_communication_time_, 20, 1e-6);
+  EXPECT_NEAR(breakdown.exposed_communication_time_, 20, 1e-6);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,45 @@
+/**
+ * Copyright 2023 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+#include "runtime/graph_scheduler/actor/pipeline_bubble_recorder.h"
+
+namespace mindspore {
+namespace runtime {
+class PipelineBubbleRecorderTest : public UT::Common {
+ public:
+  PipelineBubbleRecorderTest() {}
+};
+
+/// Feature: Record the pipeline bubble.
+/// Description: Record 2 overlapped computation intervals in a step of 60ms, and the stage waits after the computation.
+/// Expectation: The overlapped intervals are merged into the busy time, and the rest of the step is the idle time.
+TEST_F(PipelineBubbleRecorderTest, RecordStageIdleTime) {
+  auto &recorder = PipelineBubbleRecorder::GetInstance();
+  double begin_time = 100.0;
+  recorder.StepBegin(begin_time);
+  recorder.RecordComputation(begin_time, begin_time + 0.02);
+  recorder.RecordComputation(begin_time + 0.01, begin_time + 0.03);
+
+  auto idle_time = recorder.StepEnd(begin_time + 0.06);
+  EXPECT_NEAR(idle_time.step_time_, 60, 1e-6);
+  EXPECT_NEAR(idle_time.busy_time_, 30, 1e-6);
+  EXPECT_NEAR(idle_time.idle_time_, 30, 1e-6);
+  EXPECT_NEAR(idle_time.bubble_fraction_, 0.5, 1e-6);
+  EXPECT_GT(recorder.average_bubble_fraction(), 0);
+}
+}  // namespace runtime
+}  // namespace mindspore
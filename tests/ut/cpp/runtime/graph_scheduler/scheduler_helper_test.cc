@@ -17,6 +17,7 @@
 #include "common/common_test.h"
 #include "abstract/abstract_function.h"
 #include "runtime/graph_scheduler/scheduler_helper.h"
+#include "tests/ut/cpp/common/device_common_test.h"
 
 namespace mindspore {
 namespace runtime {
@@ -158,5 +159,44 @@ TEST_F(SchedulerHelperTest, AddMemoryFreeSign) {
   ASSERT_NE(from_actor->memory_free_insert_position(), nullptr);
   ASSERT_EQ(from_actor->memory_free_insert_position(), to_actor.get());
 }
+
+/// Feature: Overlap the cpu communication with the computation.
+/// Description: Set the communication actors async when one of them has no device context, and when all of them are
+/// cpu kernel actors.
+/// Expectation: The actors are set async only when all of them are cpu kernel actors, which makes the scheduler skip
+/// the control arrows by the execution order.
+TEST_F(SchedulerHelperTest, SetCommunicationAsync) {
+  auto memory_manager_actor = std::make_shared<MemoryManagerActor>();
+  MS_EXCEPTION_IF_NULL(memory_manager_actor);
+  auto kernel_graph = std::make_shared<KernelGraph>();
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  std::vector<AnfNodePtr> inputs{NewValueNode(prim::kPrimLess)};
+  auto backend_node1 = kernel_graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(backend_node1);
+  auto backend_node2 = kernel_graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(backend_node2);
+  std::set<size_t> ref_input_indexes;
+  std::set<size_t> ref_output_indexes;
+  auto device_context = std::make_shared<test::TestDeviceContext>(device::DeviceContextKey{"CPU", 0});
+
+  auto cpu_actor1 = std::make_shared<KernelActor>("cpu_actor1", backend_node1, device_context.get(),
+                                                  memory_manager_actor->GetAID(), nullptr, nullptr,
+                                                  GraphExecutionStrategy::kPipeline, ref_input_indexes,
+                                                  ref_output_indexes);
+  auto cpu_actor2 = std::make_shared<KernelActor>("cpu_actor2", backend_node2, device_context.get(),
+                                                  memory_manager_actor->GetAID(), nullptr, nullptr,
+                                                  GraphExecutionStrategy::kPipeline, ref_input_indexes,
+                                                  ref_output_indexes);
+  auto no_device_actor =
+    std::make_shared<KernelActor>("no_device_actor", backend_node2, nullptr, memory_manager_actor->GetAID(), nullptr,
+                                  nullptr, GraphExecutionStrategy::kPipeline, ref_input_indexes, ref_output_indexes);
+
+  ASSERT_FALSE(SchedulerHelper::SetCommunicationAsync({cpu_actor1.get(), no_device_actor.get()}));
+  ASSERT_FALSE(cpu_actor1->is_communication_async());
+
+  ASSERT_TRUE(SchedulerHelper::SetCommunicationAsync({cpu_actor1.get(), cpu_actor2.get()}));
+  ASSERT_TRUE(cpu_actor1->is_communication_async());
+  ASSERT_TRUE(cpu_actor2->is_communication_async());
+}
 }  // namespace runtime
 }  // namespace mindspore